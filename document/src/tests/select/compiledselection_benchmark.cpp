@@ -0,0 +1,106 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Compares selection tree evaluation with compiled selections over a synthetic corpus.
+
+#include <vespa/document/base/testdocrepo.h>
+#include <vespa/document/bucket/bucketidfactory.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/fieldvalues.h>
+#include <vespa/document/select/compiledselection.h>
+#include <vespa/document/select/parser.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <random>
+
+using namespace document;
+using namespace document::select;
+
+namespace {
+
+const char *selections[] = {
+    "testdoctype1",
+    "testdoctype1.headerval > 500",
+    "testdoctype1.hstringval == \"foo7\"",
+    "testdoctype1.hstringval = \"foo1*\"",
+    "id.user == 17",
+    "id = \"userdoc:space:1*\"",
+    "testdoctype1 and testdoctype1.headerval >= 100 and testdoctype1.headerval < 200",
+    "testdoctype1.headerval < 100 or testdoctype1.hfloatval > 0.9 or testdoctype1.hstringval = \"*9\"",
+    "not (testdoctype1.headerval == null) and testdoctype1.headerval % 3 == 1 and (true or false)",
+};
+
+std::vector<Document::UP>
+makeCorpus(const DocumentTypeRepo &repo, uint32_t numDocs)
+{
+    const DocumentType &type = *repo.getDocumentType("testdoctype1");
+    std::mt19937 rnd(42);
+    std::vector<Document::UP> docs;
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        DocumentId id(vespalib::make_string("userdoc:space:%u:%u", uint32_t(rnd() % 100), i));
+        auto doc = std::make_unique<Document>(type, id);
+        if ((i % 10) != 0) {
+            doc->setValue("headerval", IntFieldValue(rnd() % 1000));
+        }
+        doc->setValue("hfloatval", FloatFieldValue(float(rnd() % 1000) / 1000));
+        doc->setValue("hstringval", StringFieldValue(vespalib::make_string("foo%u", uint32_t(rnd() % 100))));
+        doc->setValue("content", StringFieldValue(vespalib::string(rnd() % 200, 'x')));
+        docs.push_back(std::move(doc));
+    }
+    return docs;
+}
+
+size_t
+runTree(const Node &node, const std::vector<Document::UP> &docs)
+{
+    size_t hits = 0;
+    for (const auto &doc : docs) {
+        if (node.contains(Context(*doc)).combineResults() == Result::True) {
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+size_t
+runCompiled(const CompiledSelection &compiled, const std::vector<Document::UP> &docs)
+{
+    size_t hits = 0;
+    for (const auto &doc : docs) {
+        if (compiled.evaluate(Context(*doc)) == Result::True) {
+            ++hits;
+        }
+    }
+    return hits;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t numDocs = (argc > 1) ? strtoul(argv[1], NULL, 0) : 10000;
+    double budget = (argc > 2) ? strtod(argv[2], NULL) : 1.0;
+    TestDocRepo testRepo;
+    const DocumentTypeRepo &repo = testRepo.getTypeRepo();
+    BucketIdFactory bucketIdFactory;
+    Parser parser(repo, bucketIdFactory);
+    std::vector<Document::UP> docs = makeCorpus(repo, numDocs);
+    printf("Evaluating selections over %u documents\n", numDocs);
+    for (const char *selection : selections) {
+        std::unique_ptr<Node> root = parser.parse(selection);
+        CompiledSelection compiled(*root, repo);
+        size_t treeHits = 0;
+        size_t compiledHits = 0;
+        double treeTime = vespalib::BenchmarkTimer::benchmark([&]() { treeHits = runTree(*root, docs); }, budget);
+        double compiledTime = vespalib::BenchmarkTimer::benchmark([&]() { compiledHits = runCompiled(compiled, docs); },
+                                                                  budget);
+        printf("%s\n", selection);
+        printf("    hits: %zu/%zu, compiled: %s\n", treeHits, compiledHits, compiled.isCompiled() ? "yes" : "no");
+        printf("    tree: %.1f ns/doc, compiled: %.1f ns/doc, speedup: %.2f\n",
+               treeTime * 1e9 / numDocs, compiledTime * 1e9 / numDocs, treeTime / compiledTime);
+        if (treeHits != compiledHits) {
+            fprintf(stderr, "Hit count mismatch for '%s'\n", selection);
+            return 1;
+        }
+    }
+    return 0;
+}
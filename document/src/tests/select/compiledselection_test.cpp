@@ -0,0 +1,203 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for compiledselection.
+
+#include <vespa/document/base/testdocrepo.h>
+#include <vespa/document/bucket/bucketidfactory.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/fieldvalues.h>
+#include <vespa/document/select/compiledselection.h>
+#include <vespa/document/select/parser.h>
+#include <vespa/document/serialization/serializeddocumentview.h>
+#include <vespa/document/update/assignvalueupdate.h>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <cinttypes>
+#include <sstream>
+
+using vespalib::nbostream;
+using namespace document;
+using namespace document::select;
+
+namespace {
+
+struct Fixture {
+    TestDocRepo                               testRepo;
+    const DocumentTypeRepo                   &repo;
+    BucketIdFactory                           bucketIdFactory;
+    Parser                                    parser;
+    std::vector<Document::UP>                 docs;
+    std::vector<nbostream>                    streams;
+    std::vector<SerializedDocumentView::UP>   views;
+    std::vector<DocumentId>                   ids;
+    std::vector<DocumentUpdate::UP>           updates;
+
+    Fixture()
+        : testRepo(),
+          repo(testRepo.getTypeRepo()),
+          bucketIdFactory(),
+          parser(repo, bucketIdFactory),
+          docs(),
+          streams(),
+          views(),
+          ids(),
+          updates()
+    {
+        addDoc("testdoctype1", "doc:myspace:anything", 24, 2.0, "foo", "bar");
+        addDoc("testdoctype1", "userdoc:myspace:1234:footype1", 15, 1.0, "some", "some");
+        addDoc("testdoctype1", "groupdoc:myspace:yahoo:bar", 14, 2.4, "Yet", "");
+        addDoc("testdoctype2", "doc:myspace:inheriteddoc", 10, 1.4, "inherited", "");
+        addDoc("testdoctype1", "id:ns:testdoctype1::unset", 0, 0.0, "", "");
+        docs.back()->remove("headerval");
+        docs.back()->remove("hfloatval");
+        docs.back()->remove("hstringval");
+        docs.back()->remove("content");
+        docs.back()->setValue("headerlongval", LongFieldValue(1234567890123LL));
+
+        streams.resize(docs.size());
+        for (size_t i = 0; i < docs.size(); ++i) {
+            docs[i]->serialize(streams[i]);
+            views.push_back(std::make_unique<SerializedDocumentView>(
+                    repo, vespalib::ConstBufferRef(streams[i].peek(), streams[i].size())));
+            ids.push_back(docs[i]->getId());
+        }
+        const DocumentType &type = *repo.getDocumentType("testdoctype1");
+        updates.push_back(std::make_unique<DocumentUpdate>(type, DocumentId("doc:myspace:anything")));
+        updates.back()->addUpdate(FieldUpdate(type.getField("headerval"))
+                                  .addUpdate(AssignValueUpdate(IntFieldValue(24))));
+    }
+    ~Fixture();
+
+    void addDoc(const vespalib::string &type, const vespalib::string &id, int32_t headerval,
+                float hfloatval, const vespalib::string &hstringval, const vespalib::string &content)
+    {
+        docs.push_back(std::make_unique<Document>(*repo.getDocumentType(type), DocumentId(id)));
+        Document &doc = *docs.back();
+        doc.setValue("headerval", IntFieldValue(headerval));
+        doc.setValue("hfloatval", FloatFieldValue(hfloatval));
+        doc.setValue("hstringval", StringFieldValue(hstringval));
+        doc.setValue("content", StringFieldValue(content));
+    }
+
+    void assertSameResult(const CompiledSelection &compiled, const Context &context) {
+        EXPECT_EQUAL(compiled.getRoot().contains(context).combineResults(), compiled.evaluate(context));
+        EXPECT_EQUAL(compiled.getRoot().contains(context).combineResults(),
+                     compiled.contains(context).combineResults());
+    }
+
+    void assertSameResults(const vespalib::string &selection, bool expCompiled) {
+        TEST_STATE(selection.c_str());
+        std::unique_ptr<Node> root = parser.parse(selection);
+        CompiledSelection compiled(*root, repo);
+        EXPECT_EQUAL(expCompiled, compiled.isCompiled());
+        for (size_t i = 0; i < docs.size(); ++i) {
+            TEST_DO(assertSameResult(compiled, Context(*docs[i])));
+            TEST_DO(assertSameResult(compiled, Context(*views[i])));
+            TEST_DO(assertSameResult(compiled, Context(ids[i])));
+        }
+        for (const auto &update : updates) {
+            TEST_DO(assertSameResult(compiled, Context(*update)));
+        }
+    }
+};
+
+Fixture::~Fixture() = default;
+
+}  // namespace
+
+TEST_F("require that compiled document type and constant selections match tree", Fixture) {
+    f.assertSameResults("testdoctype1", true);
+    f.assertSameResults("testdoctype2", true);
+    f.assertSameResults("notandor", true);
+    f.assertSameResults("true", true);
+    f.assertSameResults("false", true);
+    f.assertSameResults("1 + 2 == 3", true);
+    f.assertSameResults("\"FOO\".lowercase() == \"foo\"", true);
+    f.assertSameResults("null == 3", true);
+    f.assertSameResults("3 < null", true);
+    f.assertSameResults("\"bar\" =~ \"^a$\"", true);
+}
+
+TEST_F("require that compiled field comparisons match tree", Fixture) {
+    for (const char *op : {"==", "!=", "<", "<=", ">", ">="}) {
+        f.assertSameResults(vespalib::make_string("testdoctype1.headerval %s 15", op), true);
+        f.assertSameResults(vespalib::make_string("15 %s testdoctype1.headerval", op), true);
+        f.assertSameResults(vespalib::make_string("testdoctype1.hfloatval %s 1.4", op), true);
+        f.assertSameResults(vespalib::make_string("testdoctype1.hstringval %s \"some\"", op), true);
+        f.assertSameResults(vespalib::make_string("testdoctype1.headerval %s null", op), true);
+        f.assertSameResults(vespalib::make_string("testdoctype1.headerval %s \"foo\"", op), true);
+        f.assertSameResults(vespalib::make_string("testdoctype1.hfloatval %s testdoctype1.headerval", op), true);
+    }
+    f.assertSameResults("testdoctype1.headerlongval == 1234567890123", true);
+    f.assertSameResults("testdoctype1.hstringval = \"*o*\"", true);
+    f.assertSameResults("testdoctype1.hstringval = \"\"", true);
+    f.assertSameResults("testdoctype1.hstringval =~ \"^s.m\"", true);
+    f.assertSameResults("testdoctype1.hstringval =~ \"\"", true);
+    f.assertSameResults("testdoctype1.headerval = \"1*\"", true);
+    f.assertSameResults("testdoctype1.content == \"bar\"", true);
+    f.assertSameResults("testdoctype1.hstringval.lowercase() == \"yet\"", true);
+    f.assertSameResults("testdoctype1.headerval + 1 == 25", true);
+    f.assertSameResults("testdoctype1.headerval < now()", true);
+    f.assertSameResults("testdoctype2.headerval == 10", true);
+    f.assertSameResults("testdoctype2.onlyinchild == null", true);
+}
+
+TEST_F("require that compiled document id comparisons match tree", Fixture) {
+    f.assertSameResults("id == \"doc:myspace:anything\"", true);
+    f.assertSameResults("id = \"*space*\"", true);
+    f.assertSameResults("id.namespace == \"myspace\"", true);
+    f.assertSameResults("id.scheme == \"userdoc\"", true);
+    f.assertSameResults("id.user == 1234", true);
+    f.assertSameResults("id.group == \"yahoo\"", true);
+    f.assertSameResults("id.specific.hash() % 10 = 8", true);
+    f.assertSameResults(vespalib::make_string("id.bucket == %" PRIu64, document::BucketId(16, 1234).getId()), true);
+    f.assertSameResults(vespalib::make_string("id.bucket != %" PRIu64, document::BucketId(16, 1234).getId()), true);
+    f.assertSameResults("id.bucket == \"foo\"", true);
+}
+
+TEST_F("require that compiled branches match tree", Fixture) {
+    f.assertSameResults("testdoctype1 and testdoctype1.headerval > 10", true);
+    f.assertSameResults("testdoctype1.headerval > 10 and testdoctype1.hstringval == \"foo\"", true);
+    f.assertSameResults("testdoctype1.headerval == 24 or id.user == 1234", true);
+    f.assertSameResults("not testdoctype2 and (testdoctype1.headerval < 15 or testdoctype1.hfloatval > 2.0)", true);
+    f.assertSameResults("not (testdoctype1.headerval == null or testdoctype1.hstringval = \"s*\")", true);
+    f.assertSameResults("testdoctype1.headerval == null and testdoctype1.headerlongval != null", true);
+    f.assertSameResults("testdoctype1.headerval < 20 or testdoctype1.headerval > 20", true);
+    f.assertSameResults("true and testdoctype1.headerval == 24", true);
+    f.assertSameResults("false or testdoctype1.headerval == 24", true);
+    f.assertSameResults("testdoctype1.headerval == 24 and true", true);
+    f.assertSameResults("testdoctype1.headerval == 24 or false", true);
+    f.assertSameResults("testdoctype1.headerval == 24 and false", true);
+    f.assertSameResults("testdoctype1.headerval == 24 or true", true);
+    f.assertSameResults("null == 1 and testdoctype1.headerval == 24", true);
+    f.assertSameResults("(true or testdoctype1) and (false or testdoctype1.headerval == 24) and not false", true);
+}
+
+TEST_F("require that selections that cannot be compiled are evaluated by tree", Fixture) {
+    f.assertSameResults("testdoctype1.mystruct.key == 14", false);
+    f.assertSameResults("testdoctype1.tags == \"foo\"", false);
+    f.assertSameResults("testdoctype1.structarray.key == 15", false);
+    f.assertSameResults("testdoctype1.headerval == 24 and testdoctype1.tags == \"foo\"", false);
+    f.assertSameResults("true or testdoctype1.tags == \"foo\"", false);
+    f.assertSameResults("testdoctype1.mymap{3} == \"a\"", false);
+}
+
+TEST_F("require that compiled selection prints and clones as original tree", Fixture) {
+    std::unique_ptr<Node> root = f.parser.parse("testdoctype1.headerval > 10 and id.user == 1234");
+    CompiledSelection compiled(*root, f.repo);
+    std::ostringstream expected;
+    std::ostringstream actual;
+    root->print(expected, false, "");
+    compiled.print(actual, false, "");
+    EXPECT_EQUAL(expected.str(), actual.str());
+
+    std::unique_ptr<Node> clone = compiled.clone();
+    const CompiledSelection *compiledClone = dynamic_cast<const CompiledSelection *>(clone.get());
+    ASSERT_TRUE(compiledClone != nullptr);
+    EXPECT_TRUE(compiledClone->isCompiled());
+    TEST_DO(f.assertSameResult(*compiledClone, Context(*f.docs[0])));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,140 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for serializeddocumentview.
+
+#include <vespa/document/base/exceptions.h>
+#include <vespa/document/bucket/bucketidfactory.h>
+#include <vespa/document/config/config-documenttypes.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/intfieldvalue.h>
+#include <vespa/document/fieldvalue/stringfieldvalue.h>
+#include <vespa/document/repo/configbuilder.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/select/parser.h>
+#include <vespa/document/serialization/serializeddocumentview.h>
+#include <vespa/document/util/serializableexceptions.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/testkit/testapp.h>
+
+using document::config_builder::DocumenttypesConfigBuilderHelper;
+using document::config_builder::Struct;
+using vespalib::ConstBufferRef;
+using vespalib::nbostream;
+using vespalib::compression::CompressionConfig;
+using namespace document;
+
+namespace {
+
+const int doc_type_id = 1234;
+const vespalib::string doc_name = "mydoc";
+
+DocumenttypesConfig getDocTypesConfig() {
+    DocumenttypesConfigBuilderHelper builder;
+    builder.document(doc_type_id, doc_name,
+                     Struct(doc_name + ".header")
+                     .addField("header_field", DataType::T_INT),
+                     Struct(doc_name + ".body")
+                     .addField("body_field", DataType::T_STRING)
+                     .addField("unset_field", DataType::T_INT));
+    return builder.config();
+}
+
+struct Fixture {
+    DocumentTypeRepo repo;
+    const DocumentType &type;
+    Document doc;
+    nbostream stream;
+
+    Fixture()
+        : repo(getDocTypesConfig()),
+          type(*repo.getDocumentType(doc_type_id)),
+          doc(type, DocumentId("doc::testdoc")),
+          stream()
+    {
+        doc.setValue("header_field", IntFieldValue(42));
+        doc.setValue("body_field", StringFieldValue(vespalib::string(200, 'x')));
+    }
+
+    void enableCompression() {
+        const_cast<StructDataType &>(type.getFieldsType())
+            .setCompressionConfig(CompressionConfig(CompressionConfig::LZ4, 0, 95));
+    }
+
+    ConstBufferRef serialize() {
+        doc.serialize(stream);
+        return ConstBufferRef(stream.peek(), stream.size());
+    }
+};
+
+void
+assertFieldValues(const Fixture &f, const SerializedDocumentView &view)
+{
+    EXPECT_EQUAL(f.doc.getId(), view.getId());
+    EXPECT_EQUAL(f.type, view.getType());
+    EXPECT_TRUE(view.hasValue(view.getField("header_field")));
+    EXPECT_TRUE(view.hasValue(view.getField("body_field")));
+    EXPECT_FALSE(view.hasValue(view.getField("unset_field")));
+    EXPECT_EQUAL(*f.doc.getValue("header_field"), *view.getValue("header_field"));
+    EXPECT_EQUAL(*f.doc.getValue("body_field"), *view.getValue("body_field"));
+    EXPECT_FALSE(view.getValue("unset_field"));
+    EXPECT_EQUAL(f.doc, *view.createDocument());
+}
+
+}  // namespace
+
+TEST_F("require that fields can be read from uncompressed document", Fixture) {
+    SerializedDocumentView view(f.repo, f.serialize());
+    TEST_DO(assertFieldValues(f, view));
+}
+
+TEST_F("require that fields can be read from compressed document", Fixture) {
+    f.enableCompression();
+    SerializedDocumentView view(f.repo, f.serialize());
+    TEST_DO(assertFieldValues(f, view));
+}
+
+TEST_F("require that view can own serialized buffer", Fixture) {
+    ConstBufferRef serialized = f.serialize();
+    auto buffer = std::make_unique<vespalib::DataBuffer>(serialized.size());
+    buffer->writeBytes(serialized.c_str(), serialized.size());
+    SerializedDocumentView view(f.repo, std::move(buffer));
+    f.stream.clear();
+    TEST_DO(assertFieldValues(f, view));
+}
+
+TEST_F("require that document without body can be read", Fixture) {
+    f.doc.remove("body_field");
+    SerializedDocumentView view(f.repo, f.serialize());
+    EXPECT_EQUAL(*f.doc.getValue("header_field"), *view.getValue("header_field"));
+    EXPECT_FALSE(view.hasValue(view.getField("body_field")));
+    EXPECT_EQUAL(f.doc, *view.createDocument());
+}
+
+TEST_F("require that document selection can be evaluated on view", Fixture) {
+    SerializedDocumentView view(f.repo, f.serialize());
+    BucketIdFactory bucketIdFactory;
+    select::Parser parser(f.repo, bucketIdFactory);
+    select::Context context(view);
+    EXPECT_TRUE(parser.parse("mydoc")->contains(context) == select::Result::True);
+    EXPECT_TRUE(parser.parse("mydoc.header_field == 42")->contains(context) == select::Result::True);
+    EXPECT_TRUE(parser.parse("mydoc.header_field == 43")->contains(context) == select::Result::False);
+    EXPECT_TRUE(parser.parse("mydoc.unset_field == null")->contains(context) == select::Result::True);
+    EXPECT_TRUE(parser.parse("id == \"doc::testdoc\"")->contains(context) == select::Result::True);
+}
+
+TEST_F("require that unknown serialization version is rejected", Fixture) {
+    f.serialize();
+    uint16_t badVersion = 0;
+    memcpy(const_cast<char *>(f.stream.peek()), &badVersion, sizeof(badVersion));
+    EXPECT_EXCEPTION(SerializedDocumentView view(f.repo, ConstBufferRef(f.stream.peek(), f.stream.size())),
+                     DeserializeException, "Unrecognized serialization version");
+}
+
+TEST_F("require that unknown document type is rejected", Fixture) {
+    ConstBufferRef serialized = f.serialize();
+    DocumentTypeRepo otherRepo;
+    EXPECT_EXCEPTION(SerializedDocumentView view(otherRepo, serialized),
+                     DocumentTypeNotFoundException, doc_name);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
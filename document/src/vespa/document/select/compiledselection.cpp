@@ -0,0 +1,559 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "compiledselection.h"
+#include "branch.h"
+#include "compare.h"
+#include "constant.h"
+#include "doctype.h"
+#include "invalidconstant.h"
+#include "operator.h"
+#include "valuenodes.h"
+#include "visitor.h"
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/fieldvalue/fieldvalues.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/serialization/serializeddocumentview.h>
+#include <vespa/document/update/documentupdate.h>
+#include <vespa/vespalib/util/regexp.h>
+
+namespace document::select {
+
+namespace {
+
+enum class OpCode : uint8_t {
+    RESULT,        // acc = Result::fromEnum(arg)
+    DOC_TYPE,      // acc = document type check number arg
+    COMPARE,       // acc = comparison number arg
+    NOT,           // acc = !acc
+    PUSH,          // push acc
+    AND,           // acc = pop() && acc
+    OR,            // acc = pop() || acc
+    JUMP_IF_FALSE, // if acc is False, continue at instruction arg
+    JUMP_IF_TRUE   // if acc is True, continue at instruction arg
+};
+
+struct Instruction {
+    OpCode   op;
+    uint32_t arg;
+
+    Instruction(OpCode op_, uint32_t arg_) : op(op_), arg(arg_) {}
+};
+
+// Evaluation state lives on the stack, which bounds the program.
+const uint32_t MAX_STACK_DEPTH = 32;
+const uint32_t MAX_FIELD_SLOTS = 16;
+
+bool documentTypeEqualsName(const DocumentType& type, const vespalib::stringref& name)
+{
+    if (type.getName() == name) return true;
+    for (const DocumentType *inherited : type.getInheritedTypes()) {
+        if (documentTypeEqualsName(*inherited, name)) return true;
+    }
+    return false;
+}
+
+const Result&
+checkDocType(const Context& context, const vespalib::string& name)
+{
+    if (context._doc != NULL) {
+        return Result::get(documentTypeEqualsName(context._doc->getType(), name));
+    }
+    if (context._docView != NULL) {
+        return Result::get(documentTypeEqualsName(context._docView->getType(), name));
+    }
+    if (context._docId != NULL) {
+        return Result::False;
+    }
+    return Result::get(documentTypeEqualsName(context._docUpdate->getType(), name));
+}
+
+// Fields for which FieldValueNode always yields a single value.
+bool isSingleValueField(const Field& field)
+{
+    switch (field.getDataType().getId()) {
+    case DataType::T_INT:
+    case DataType::T_BYTE:
+    case DataType::T_LONG:
+    case DataType::T_FLOAT:
+    case DataType::T_DOUBLE:
+    case DataType::T_STRING:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Same conversion as FieldValueNode does. Returns null for other classes.
+std::unique_ptr<Value>
+toValue(const FieldValue& value)
+{
+    switch (value.getClass().id()) {
+    case IntFieldValue::classId:
+        return std::make_unique<IntegerValue>(static_cast<const IntFieldValue&>(value).getAsInt(), false);
+    case ByteFieldValue::classId:
+        return std::make_unique<IntegerValue>(static_cast<const ByteFieldValue&>(value).getAsByte(), false);
+    case LongFieldValue::classId:
+        return std::make_unique<IntegerValue>(static_cast<const LongFieldValue&>(value).getAsLong(), false);
+    case FloatFieldValue::classId:
+        return std::make_unique<FloatValue>(static_cast<const FloatFieldValue&>(value).getAsFloat());
+    case DoubleFieldValue::classId:
+        return std::make_unique<FloatValue>(static_cast<const DoubleFieldValue&>(value).getAsDouble());
+    case StringFieldValue::classId:
+        return std::make_unique<StringValue>(static_cast<const StringFieldValue&>(value).getAsString());
+    }
+    return std::unique_ptr<Value>();
+}
+
+// Same semantics as the bucket handling in Compare.
+const Result&
+compareBuckets(const Value& left, const Value& right, const Operator& op)
+{
+    const Value& bVal(left.getType() == Value::Bucket ? left : right);
+    const Value& nVal(left.getType() == Value::Bucket ? right : left);
+    if (nVal.getType() != Value::Integer
+        || !(op == FunctionOperator::EQ || op == FunctionOperator::NE || op == GlobOperator::GLOB))
+    {
+        return Result::Invalid;
+    }
+    document::BucketId b(static_cast<const IntegerValue&>(bVal).getValue());
+    document::BucketId s(static_cast<const IntegerValue&>(nVal).getValue());
+    const Result& result = Result::get(s.contains(b));
+    return (op == FunctionOperator::NE) ? !result : result;
+}
+
+}
+
+class CompiledSelection::Program
+{
+public:
+    struct FieldSlot {
+        const FieldValueNode* node;
+        const DocumentType*   type;
+        const Field*          field;
+    };
+    struct Operand {
+        enum Kind { CONSTANT, FIELD, DYNAMIC };
+
+        Kind             kind = DYNAMIC;
+        uint32_t         index = 0; // Into constants or fields
+        const ValueNode* node = nullptr;
+    };
+    struct Comparison {
+        Operand                           left;
+        Operand                           right;
+        const Operator*                   op;
+        std::unique_ptr<vespalib::Regexp> pattern; // Precompiled constant right hand side
+    };
+
+    std::vector<Instruction>            code;
+    std::vector<vespalib::string>       docTypes;
+    std::vector<std::unique_ptr<Value>> constants;
+    std::vector<FieldSlot>              fields;
+    std::vector<Comparison>             comparisons;
+
+    const Result& evaluate(const Context& context) const;
+
+private:
+    using FieldValues = std::unique_ptr<Value>[MAX_FIELD_SLOTS];
+
+    std::unique_ptr<Value> loadField(const FieldSlot& slot, const Context& context) const;
+    const Value& resolve(const Operand& operand, const Context& context,
+                         FieldValues& fieldValues, std::unique_ptr<Value>& holder) const;
+    const Result& compare(const Comparison& comparison, const Context& context,
+                          FieldValues& fieldValues) const;
+};
+
+std::unique_ptr<Value>
+CompiledSelection::Program::loadField(const FieldSlot& slot, const Context& context) const
+{
+    // Documents of other types, including subtypes, take the generic path.
+    FieldValue::UP value;
+    if (context._doc != NULL && &context._doc->getType() == slot.type) {
+        value = context._doc->getValue(*slot.field);
+    } else if (context._docView != NULL && &context._docView->getType() == slot.type) {
+        value = context._docView->getValue(*slot.field);
+    } else {
+        return slot.node->getValue(context);
+    }
+    if (!value) {
+        return std::make_unique<NullValue>();
+    }
+    std::unique_ptr<Value> result = toValue(*value);
+    return result ? std::move(result) : slot.node->getValue(context);
+}
+
+const Value&
+CompiledSelection::Program::resolve(const Operand& operand, const Context& context,
+                                    FieldValues& fieldValues, std::unique_ptr<Value>& holder) const
+{
+    switch (operand.kind) {
+    case Operand::CONSTANT:
+        return *constants[operand.index];
+    case Operand::FIELD:
+        if (!fieldValues[operand.index]) {
+            fieldValues[operand.index] = loadField(fields[operand.index], context);
+        }
+        return *fieldValues[operand.index];
+    case Operand::DYNAMIC:
+        break;
+    }
+    holder = operand.node->getValue(context);
+    return *holder;
+}
+
+const Result&
+CompiledSelection::Program::compare(const Comparison& comparison, const Context& context,
+                                    FieldValues& fieldValues) const
+{
+    std::unique_ptr<Value> leftHolder;
+    std::unique_ptr<Value> rightHolder;
+    const Value& left = resolve(comparison.left, context, fieldValues, leftHolder);
+    const Value& right = resolve(comparison.right, context, fieldValues, rightHolder);
+    if (left.getType() == Value::Bucket || right.getType() == Value::Bucket) {
+        return compareBuckets(left, right, *comparison.op);
+    }
+    if (comparison.pattern && left.getType() == Value::String) {
+        return Result::get(comparison.pattern->match(static_cast<const StringValue&>(left).getValue()));
+    }
+    return comparison.op->compare(left, right).combineResults();
+}
+
+const Result&
+CompiledSelection::Program::evaluate(const Context& context) const
+{
+    FieldValues fieldValues;
+    const Result* stack[MAX_STACK_DEPTH];
+    uint32_t depth = 0;
+    const Result* acc = &Result::Invalid;
+    const uint32_t end = code.size();
+    uint32_t pc = 0;
+    while (pc < end) {
+        const Instruction& insn = code[pc++];
+        switch (insn.op) {
+        case OpCode::RESULT:
+            acc = &Result::fromEnum(insn.arg);
+            break;
+        case OpCode::DOC_TYPE:
+            acc = &checkDocType(context, docTypes[insn.arg]);
+            break;
+        case OpCode::COMPARE:
+            acc = &compare(comparisons[insn.arg], context, fieldValues);
+            break;
+        case OpCode::NOT:
+            acc = &(!*acc);
+            break;
+        case OpCode::PUSH:
+            stack[depth++] = acc;
+            break;
+        case OpCode::AND:
+            acc = &(*stack[--depth] && *acc);
+            break;
+        case OpCode::OR:
+            acc = &(*stack[--depth] || *acc);
+            break;
+        case OpCode::JUMP_IF_FALSE:
+            if (*acc == Result::False) pc = insn.arg;
+            break;
+        case OpCode::JUMP_IF_TRUE:
+            if (*acc == Result::True) pc = insn.arg;
+            break;
+        }
+    }
+    return *acc;
+}
+
+/**
+ * Emits code for selection nodes and classifies value nodes as operands.
+ * Clears the ok flag when it meets anything it cannot compile exactly.
+ */
+class CompiledSelection::Compiler : public Visitor
+{
+    using Operand = Program::Operand;
+
+    Program&                _program;
+    const DocumentTypeRepo& _repo;
+    bool                    _ok;
+    uint32_t                _depth;
+    Operand                 _operand;
+
+    std::vector<Instruction>& code() { return _program.code; }
+
+    void emit(OpCode op, uint32_t arg = 0) { code().emplace_back(op, arg); }
+    void emitResult(const Result& result) { emit(OpCode::RESULT, result.toEnum()); }
+    void truncate(size_t pos) { code().erase(code().begin() + pos, code().end()); }
+
+    void eraseInstruction(size_t pos) {
+        code().erase(code().begin() + pos);
+        for (size_t i = pos; i < code().size(); ++i) {
+            Instruction& insn = code()[i];
+            if (insn.op == OpCode::JUMP_IF_FALSE || insn.op == OpCode::JUMP_IF_TRUE) {
+                --insn.arg;
+            }
+        }
+    }
+
+    // Returns the result if the code from pos on was folded into a constant.
+    const Result* getConstant(size_t pos) const {
+        const std::vector<Instruction>& c = _program.code;
+        if (c.size() == pos + 1 && c[pos].op == OpCode::RESULT) {
+            return &Result::fromEnum(c[pos].arg);
+        }
+        return nullptr;
+    }
+
+    /**
+     * And and Or are the same apart from which result decides the outcome
+     * on its own (False for And, True for Or).
+     */
+    void compileBranch(const Node& left, const Node& right, const Result& dominant,
+                       OpCode jump, OpCode combine)
+    {
+        const size_t start = code().size();
+        left.visit(*this);
+        const Result* leftConstant = getConstant(start);
+        if (leftConstant == &dominant || leftConstant == &!dominant) {
+            // The right side must compile even when folded away; the tree
+            // gives False rather than the constant for an empty result list.
+            const size_t rightStart = code().size();
+            right.visit(*this);
+            if (leftConstant == &dominant) {
+                truncate(rightStart);
+            } else {
+                eraseInstruction(start);
+            }
+            return;
+        }
+        const size_t jumpPos = code().size();
+        emit(jump);
+        emit(OpCode::PUSH);
+        if (++_depth > MAX_STACK_DEPTH) {
+            _ok = false;
+        }
+        const size_t rightStart = code().size();
+        right.visit(*this);
+        --_depth;
+        const Result* rightConstant = getConstant(rightStart);
+        if (rightConstant == &dominant) {
+            truncate(start);
+            emitResult(dominant);
+        } else if (rightConstant == &!dominant) {
+            truncate(jumpPos);
+        } else {
+            emit(combine);
+            code()[jumpPos].arg = code().size();
+        }
+    }
+
+    Operand compileOperand(const ValueNode& node) {
+        node.visit(*this);
+        return _operand;
+    }
+
+    void setConstant(const ValueNode& node) {
+        _operand.kind = Operand::CONSTANT;
+        _operand.index = _program.constants.size();
+        _operand.node = &node;
+        _program.constants.push_back(node.getValue(Context()));
+    }
+
+    void setDynamic(const ValueNode& node) {
+        _operand.kind = Operand::DYNAMIC;
+        _operand.index = 0;
+        _operand.node = &node;
+    }
+
+    // Folds the node if all its operands are constant.
+    void setDerived(const ValueNode& node, const Operand& left, const Operand& right, size_t constantsStart) {
+        if (left.kind == Operand::CONSTANT && right.kind == Operand::CONSTANT) {
+            _program.constants.resize(constantsStart);
+            setConstant(node);
+        } else {
+            setDynamic(node);
+        }
+    }
+
+    void setField(const FieldValueNode& node) {
+        setDynamic(node);
+        if (node.getFieldName() != node.getRealFieldName()) {
+            _ok = false; // Nested field expressions may give several values.
+            return;
+        }
+        const DocumentType* type = _repo.getDocumentType(node.getDocType());
+        if (type == nullptr || !type->hasField(node.getRealFieldName())) {
+            _ok = false;
+            return;
+        }
+        const Field& field = type->getField(node.getRealFieldName());
+        if (!isSingleValueField(field)) {
+            _ok = false;
+            return;
+        }
+        std::vector<Program::FieldSlot>& fields = _program.fields;
+        uint32_t slot = 0;
+        while (slot < fields.size() && !(fields[slot].type == type && fields[slot].field->getId() == field.getId())) {
+            ++slot;
+        }
+        if (slot == fields.size()) {
+            if (slot == MAX_FIELD_SLOTS) {
+                return;
+            }
+            fields.push_back(Program::FieldSlot{&node, type, &field});
+        }
+        _operand.kind = Operand::FIELD;
+        _operand.index = slot;
+    }
+
+public:
+    Compiler(Program& program, const DocumentTypeRepo& repo)
+        : _program(program),
+          _repo(repo),
+          _ok(true),
+          _depth(0),
+          _operand()
+    {
+    }
+
+    bool succeeded() const { return _ok; }
+
+    void visitAndBranch(const And& node) override {
+        compileBranch(node.getLeft(), node.getRight(), Result::False, OpCode::JUMP_IF_FALSE, OpCode::AND);
+    }
+
+    void visitOrBranch(const Or& node) override {
+        compileBranch(node.getLeft(), node.getRight(), Result::True, OpCode::JUMP_IF_TRUE, OpCode::OR);
+    }
+
+    void visitNotBranch(const Not& node) override {
+        const size_t start = code().size();
+        node.getChild().visit(*this);
+        const Result* constant = getConstant(start);
+        if (constant != nullptr) {
+            code()[start].arg = (!*constant).toEnum();
+        } else {
+            emit(OpCode::NOT);
+        }
+    }
+
+    void visitConstant(const Constant& node) override {
+        emitResult(Result::get(node.getConstantValue()));
+    }
+
+    void visitInvalidConstant(const InvalidConstant&) override {
+        emitResult(Result::Invalid);
+    }
+
+    void visitDocumentType(const DocType& node) override {
+        emit(OpCode::DOC_TYPE, _program.docTypes.size());
+        _program.docTypes.push_back(node.getDocType());
+    }
+
+    void visitComparison(const Compare& node) override {
+        const size_t constantsStart = _program.constants.size();
+        Operand left = compileOperand(node.getLeft());
+        Operand right = compileOperand(node.getRight());
+        if (left.kind == Operand::CONSTANT && right.kind == Operand::CONSTANT) {
+            _program.constants.resize(constantsStart);
+            emitResult(node.contains(Context()).combineResults());
+            return;
+        }
+        Program::Comparison comparison{left, right, &node.getOperator(), std::unique_ptr<vespalib::Regexp>()};
+        if (right.kind == Operand::CONSTANT && _program.constants[right.index]->getType() == Value::String) {
+            const vespalib::string& expr = static_cast<const StringValue&>(*_program.constants[right.index]).getValue();
+            if (node.getOperator() == GlobOperator::GLOB) {
+                comparison.pattern = std::make_unique<vespalib::Regexp>(GlobOperator::GLOB.convertToRegex(expr));
+            } else if (node.getOperator() == RegexOperator::REGEX && !expr.empty()) {
+                comparison.pattern = std::make_unique<vespalib::Regexp>(expr);
+            }
+        }
+        emit(OpCode::COMPARE, _program.comparisons.size());
+        _program.comparisons.push_back(std::move(comparison));
+    }
+
+    void visitArithmeticValueNode(const ArithmeticValueNode& node) override {
+        const size_t constantsStart = _program.constants.size();
+        Operand left = compileOperand(node.getLeft());
+        Operand right = compileOperand(node.getRight());
+        setDerived(node, left, right, constantsStart);
+    }
+
+    void visitFunctionValueNode(const FunctionValueNode& node) override {
+        const size_t constantsStart = _program.constants.size();
+        Operand child = compileOperand(node.getChild());
+        setDerived(node, child, child, constantsStart);
+    }
+
+    void visitIdValueNode(const IdValueNode& node) override { setDynamic(node); }
+    void visitFieldValueNode(const FieldValueNode& node) override { setField(node); }
+    void visitFloatValueNode(const FloatValueNode& node) override { setConstant(node); }
+    void visitVariableValueNode(const VariableValueNode& node) override {
+        setDynamic(node);
+        _ok = false; // Variables may hold values of any kind.
+    }
+    void visitIntegerValueNode(const IntegerValueNode& node) override { setConstant(node); }
+    void visitCurrentTimeValueNode(const CurrentTimeValueNode& node) override { setDynamic(node); }
+    void visitStringValueNode(const StringValueNode& node) override { setConstant(node); }
+    void visitNullValueNode(const NullValueNode& node) override { setConstant(node); }
+    void visitInvalidValueNode(const InvalidValueNode& node) override { setConstant(node); }
+};
+
+CompiledSelection::CompiledSelection(const Node& root, const DocumentTypeRepo& repo)
+    : Node("CompiledSelection"),
+      _repo(repo),
+      _root(root.clone()),
+      _program()
+{
+    // The program refers to nodes in the tree, so compile our own copy.
+    auto program = std::make_unique<Program>();
+    Compiler compiler(*program, repo);
+    _root->visit(compiler);
+    if (compiler.succeeded()) {
+        _program = std::move(program);
+    }
+}
+
+CompiledSelection::~CompiledSelection() = default;
+
+const Result&
+CompiledSelection::evaluate(const Context& context) const
+{
+    if (_program) {
+        return _program->evaluate(context);
+    }
+    return _root->contains(context).combineResults();
+}
+
+ResultList
+CompiledSelection::contains(const Context& context) const
+{
+    if (_program) {
+        return ResultList(_program->evaluate(context));
+    }
+    return _root->contains(context);
+}
+
+ResultList
+CompiledSelection::trace(const Context& context, std::ostream& trace) const
+{
+    return _root->trace(context, trace);
+}
+
+void
+CompiledSelection::visit(Visitor& v) const
+{
+    _root->visit(v);
+}
+
+void
+CompiledSelection::print(std::ostream& out, bool verbose, const std::string& indent) const
+{
+    _root->print(out, verbose, indent);
+}
+
+Node::UP
+CompiledSelection::clone() const
+{
+    return std::make_unique<CompiledSelection>(*_root, _repo);
+}
+
+}
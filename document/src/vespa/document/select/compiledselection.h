@@ -0,0 +1,68 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+/**
+ * @class document::select::CompiledSelection
+ * @ingroup select
+ *
+ * @brief Document selection compiled to a flat program.
+ *
+ * The selection tree is translated once into a linear sequence of
+ * instructions that is run without walking the tree or building
+ * intermediate result lists. During compilation, constant sub-expressions
+ * are folded, regular expressions and glob patterns with constant patterns
+ * are compiled up front, and plain field references are resolved against
+ * the document type repo. Each referenced field is fetched from the
+ * document at most once per evaluation.
+ *
+ * Only selections where every sub-expression yields a single result can be
+ * compiled, as this is where the result list semantics of the tree reduce
+ * to plain three-valued logic. This excludes variables and field
+ * expressions that may produce several values (arrays, maps, structs). For
+ * other selections, isCompiled() returns false and evaluation is delegated
+ * to the original tree. Tracing, printing and visiting always use the
+ * original tree.
+ */
+
+#pragma once
+
+#include "node.h"
+
+namespace document {
+
+class DocumentTypeRepo;
+
+namespace select {
+
+class CompiledSelection : public Node
+{
+public:
+    CompiledSelection(const Node& root, const DocumentTypeRepo& repo);
+    ~CompiledSelection() override;
+
+    bool isCompiled() const { return bool(_program); }
+    const Node& getRoot() const { return *_root; }
+
+    /**
+     * Evaluates the selection, returning the same result as
+     * contains(context).combineResults() without allocating a result list.
+     */
+    const Result& evaluate(const Context& context) const;
+
+    ResultList contains(const Context& context) const override;
+    ResultList trace(const Context& context, std::ostream& trace) const override;
+    bool isLeafNode() const override { return _root->isLeafNode(); }
+    void visit(Visitor& v) const override;
+    void print(std::ostream& out, bool verbose, const std::string& indent) const override;
+
+    Node::UP clone() const override;
+
+private:
+    class Program;
+    class Compiler;
+
+    const DocumentTypeRepo&  _repo;
+    Node::UP                 _root;
+    std::unique_ptr<Program> _program;
+};
+
+} // select
+} // document
@@ -10,6 +10,7 @@ Context::Context()
     : _doc(NULL),
       _docId(NULL),
       _docUpdate(NULL),
+      _docView(NULL),
       _variables()
 { }
 
@@ -17,6 +18,7 @@ Context::Context(const Document& doc)
     : _doc(&doc),
       _docId(NULL),
       _docUpdate(NULL),
+      _docView(NULL),
       _variables()
 { }
 
@@ -24,6 +26,7 @@ Context::Context(const DocumentId& docId)
     : _doc(NULL),
       _docId(&docId),
       _docUpdate(NULL),
+      _docView(NULL),
       _variables()
 { }
 
@@ -31,6 +34,15 @@ Context::Context(const DocumentUpdate& docUpdate)
     : _doc(NULL),
       _docId(NULL),
       _docUpdate(&docUpdate),
+      _docView(NULL),
+      _variables()
+{ }
+
+Context::Context(const SerializedDocumentView& docView)
+    : _doc(NULL),
+      _docId(NULL),
+      _docUpdate(NULL),
+      _docView(&docView),
       _variables()
 { }
 
@@ -9,6 +9,7 @@ namespace document {
 class Document;
 class DocumentId;
 class DocumentUpdate;
+class SerializedDocumentView;
 
 namespace select {
 
@@ -21,6 +22,7 @@ public:
     Context(const Document & doc);
     Context(const DocumentId & docId);
     Context(const DocumentUpdate & docUpdate);
+    Context(const SerializedDocumentView & docView);
     virtual ~Context();
 
     void setVariableMap(std::unique_ptr<VariableMap> map);
@@ -29,6 +31,7 @@ public:
     const Document *_doc;
     const DocumentId *_docId;
     const DocumentUpdate *_docUpdate;
+    const SerializedDocumentView *_docView;
 private:
     std::unique_ptr<VariableMap> _variables;
 };
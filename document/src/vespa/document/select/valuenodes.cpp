@@ -8,6 +8,7 @@
 #include <vespa/document/fieldvalue/fieldvalues.h>
 #include <vespa/document/fieldvalue/iteratorhandler.h>
 #include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/serialization/serializeddocumentview.h>
 #include <vespa/vespalib/util/md5.h>
 #include <vespa/document/util/stringutil.h>
 #include <vespa/vespalib/text/lowercase.h>
@@ -36,6 +37,13 @@ namespace {
         }
         return false;
     }
+
+    const DocumentType *getDocumentType(const Context &context)
+    {
+        if (context._doc != NULL) return &context._doc->getType();
+        if (context._docView != NULL) return &context._docView->getType();
+        return NULL;
+    }
 }
 
 InvalidValueNode::InvalidValueNode(const vespalib::stringref & name)
@@ -330,6 +338,17 @@ IteratorHandler::getInternalValue(const FieldValue& fval) const
     return std::make_unique<InvalidValue>();
 }
 
+// Only deserializes the fields in the path when the context holds a serialized document.
+void
+iterateNested(const Context &context, FieldValue::PathRange nested, IteratorHandler &handler)
+{
+    if (context._doc != NULL) {
+        context._doc->iterateNested(nested, handler);
+    } else {
+        context._docView->iterateNested(nested, handler);
+    }
+}
+
 }
 
 void
@@ -342,20 +361,19 @@ FieldValueNode::initFieldPath(const DocumentType& type) const {
 std::unique_ptr<Value>
 FieldValueNode::getValue(const Context& context) const
 {
-    if (context._doc == NULL) {
+    const DocumentType *docType = getDocumentType(context);
+    if (docType == NULL) {
         return std::unique_ptr<Value>(new InvalidValue());
     }
 
-    const Document& doc = *context._doc;
-
-    if (!documentTypeEqualsName(doc.getType(), _doctype)) {
+    if (!documentTypeEqualsName(*docType, _doctype)) {
         return std::unique_ptr<Value>(new InvalidValue());
     }
     try{
-        initFieldPath(doc.getType());
+        initFieldPath(*docType);
 
         IteratorHandler handler;
-        doc.iterateNested(_fieldPath.getFullRange(), handler);
+        iterateNested(context, _fieldPath.getFullRange(), handler);
 
         if (handler.hasSingleValue()) {
             return handler.getSingleValue();
@@ -398,20 +416,20 @@ FieldValueNode::print(std::ostream& out, bool verbose,
 std::unique_ptr<Value>
 FieldValueNode::traceValue(const Context &context, std::ostream& out) const
 {
-    if (context._doc == NULL) {
+    const DocumentType *docType = getDocumentType(context);
+    if (docType == NULL) {
         return defaultTrace(getValue(context), out);
     }
-    const Document &doc(*context._doc);
-    if (!documentTypeEqualsName(doc.getType(), _doctype)) {
-        out << "Document is of type " << doc.getType() << " which isn't a "
+    if (!documentTypeEqualsName(*docType, _doctype)) {
+        out << "Document is of type " << *docType << " which isn't a "
             << _doctype << " document, thus resolving invalid.\n";
         return std::unique_ptr<Value>(new InvalidValue());
     }
     try{
-        initFieldPath(doc.getType());
+        initFieldPath(*docType);
 
         IteratorHandler handler;
-        doc.iterateNested(_fieldPath.getFullRange(), handler);
+        iterateNested(context, _fieldPath.getFullRange(), handler);
 
         if (handler.hasSingleValue()) {
             return handler.getSingleValue();
@@ -427,7 +445,7 @@ FieldValueNode::traceValue(const Context &context, std::ostream& out) const
     } catch (FieldNotFoundException& e) {
         LOG(warning, "Tried to compare to field %s, not found in document type",
                      _fieldExpression.c_str());
-        out << "Field not found in document type " << doc.getType()
+        out << "Field not found in document type " << *docType
             << ". Returning invalid.\n";
         return std::unique_ptr<Value>(new InvalidValue());
     }
@@ -477,6 +495,8 @@ IdValueNode::getValue(const Context& context) const
 {
     if (context._doc != NULL) {
         return getValue(context._doc->getId());
+    } else if (context._docView != NULL) {
+        return getValue(context._docView->getId());
     } else if (context._docId != NULL) {
         return getValue(*context._docId);
     } else {
@@ -556,6 +576,8 @@ IdValueNode::traceValue(const Context& context,
 {
     if (context._doc != NULL) {
         return traceValue(context._doc->getId(), out);
+    } else if (context._docView != NULL) {
+        return traceValue(context._docView->getId(), out);
     } else if (context._docId != NULL) {
         return traceValue(*context._docId, out);
     } else {
@@ -0,0 +1,256 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "serializeddocumentview.h"
+#include "util.h"
+#include "vespadocumentdeserializer.h"
+#include <vespa/document/base/exceptions.h>
+#include <vespa/document/datatype/documenttype.h>
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/repo/documenttyperepo.h>
+#include <vespa/document/repo/fixedtyperepo.h>
+#include <vespa/document/util/serializableexceptions.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+
+using vespalib::ConstBufferRef;
+using vespalib::DataBuffer;
+using vespalib::asciistream;
+using vespalib::nbostream;
+using vespalib::stringref;
+using vespalib::compression::CompressionConfig;
+
+namespace document {
+
+namespace {
+
+uint32_t
+getChunkCount(uint8_t contentCode)
+{
+    uint8_t chunks = 0;
+    if (contentCode & 0x02) {
+        ++chunks;
+    }
+    if (contentCode & 0x04) {
+        ++chunks;
+    }
+    return chunks;
+}
+
+stringref
+readCString(nbostream &stream)
+{
+    stringref s(stream.peek());
+    stream.adjustReadPos(s.size() + 1);
+    return s;
+}
+
+}  // namespace
+
+SerializedDocumentView::Chunk::Chunk(CompressionType compression, uint32_t uncompressedSize, ConstBufferRef data)
+    : _compression(compression),
+      _uncompressedSize(uncompressedSize),
+      _data(data),
+      _uncompressed()
+{
+}
+
+SerializedDocumentView::Chunk::~Chunk() = default;
+
+const char *
+SerializedDocumentView::Chunk::getUncompressed() const
+{
+    if (!CompressionConfig::isCompressed(_compression)) {
+        return _data.c_str();
+    }
+    if (!_uncompressed) {
+        auto uncompressed = std::make_unique<DataBuffer>(_uncompressedSize);
+        try {
+            vespalib::compression::decompress(_compression, _uncompressedSize, _data, *uncompressed, false);
+        } catch (const std::runtime_error &e) {
+            throw DeserializeException(vespalib::make_string("Failed decompressing struct data: %s", e.what()),
+                                       VESPA_STRLOC);
+        }
+        if (uncompressed->getDataLen() != _uncompressedSize) {
+            throw DeserializeException("Decompressed struct data has wrong size.", VESPA_STRLOC);
+        }
+        _uncompressed = std::move(uncompressed);
+    }
+    return _uncompressed->getData();
+}
+
+SerializedDocumentView::SerializedDocumentView(const DocumentTypeRepo &repo, ConstBufferRef buffer)
+    : _ownedBuffer(),
+      _repo(repo),
+      _buffer(buffer),
+      _version(0),
+      _id(),
+      _type(nullptr),
+      _chunks(),
+      _fields()
+{
+    parse();
+}
+
+SerializedDocumentView::SerializedDocumentView(const DocumentTypeRepo &repo, DataBuffer::UP buffer)
+    : _ownedBuffer(std::move(buffer)),
+      _repo(repo),
+      _buffer(_ownedBuffer->getData(), _ownedBuffer->getDataLen()),
+      _version(0),
+      _id(),
+      _type(nullptr),
+      _chunks(),
+      _fields()
+{
+    parse();
+}
+
+SerializedDocumentView::~SerializedDocumentView() = default;
+
+void
+SerializedDocumentView::parse()
+{
+    nbostream stream(_buffer.c_str(), _buffer.size());
+    _version = readValue<uint16_t>(stream);
+    if (_version < 6 || _version > 8) {
+        asciistream msg;
+        msg << "Unrecognized serialization version " << _version;
+        throw DeserializeException(msg.str(), VESPA_STRLOC);
+    }
+    if (_version >= 7) {
+        readValue<uint32_t>(stream);  // Skip data size.
+    } else {
+        getInt2_4_8Bytes(stream);  // Skip document length.
+    }
+    _id.set(readCString(stream));
+    uint8_t contentCode = readValue<uint8_t>(stream);
+    stringref typeName = readCString(stream);
+    readValue<uint16_t>(stream);  // Skip type version.
+    _type = _repo.getDocumentType(typeName);
+    if (_type == nullptr) {
+        throw DocumentTypeNotFoundException(typeName, VESPA_STRLOC);
+    }
+
+    uint32_t chunkCount = getChunkCount(contentCode);
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        parseChunk(stream);
+    }
+    // A field set in a later chunk overrides the same field in earlier ones.
+    std::stable_sort(_fields.begin(), _fields.end());
+    auto last = std::unique(_fields.rbegin(), _fields.rend(),
+                            [](const FieldEntry &lhs, const FieldEntry &rhs) { return lhs._id == rhs._id; });
+    _fields.erase(_fields.begin(), last.base());
+}
+
+void
+SerializedDocumentView::parseChunk(nbostream &stream)
+{
+    size_t startSize = stream.size();
+    size_t dataSize;
+    if (_version < 7) {
+        dataSize = getInt2_4_8Bytes(stream);
+    } else {
+        dataSize = readValue<uint32_t>(stream);
+    }
+    auto compression = CompressionType(readValue<uint8_t>(stream));
+    bool compressed = CompressionConfig::isCompressed(compression);
+    size_t uncompressedSize = 0;
+    if (compressed) {
+        uncompressedSize = getInt2_4_8Bytes(stream);
+    }
+
+    std::vector<FieldEntry> fields;
+    const uint32_t chunkId = _chunks.size();
+    size_t fieldCount = getInt1_4Bytes(stream);
+    fields.reserve(fieldCount);
+    uint32_t offset = 0;
+    for (size_t i = 0; i < fieldCount; ++i) {
+        const uint32_t id = getInt1_4Bytes(stream);
+        const uint32_t size = getInt2_4_8Bytes(stream);
+        fields.emplace_back(id, chunkId, offset, size);
+        offset += size;
+    }
+    if (_version < 7) {
+        dataSize -= (startSize - stream.size());
+    }
+    if (compressed && (compression != CompressionConfig::LZ4)) {
+        throw DeserializeException("Unsupported compression type.", VESPA_STRLOC);
+    }
+    if (dataSize > stream.size()) {
+        throw DeserializeException("Invalid struct data.", VESPA_STRLOC);
+    }
+    if (dataSize == 0) {
+        return;
+    }
+    if (!compressed) {
+        uncompressedSize = dataSize;
+    }
+    if (offset > uncompressedSize) {
+        throw DeserializeException("Struct field sizes exceed struct data size.", VESPA_STRLOC);
+    }
+    _chunks.emplace_back(compression, uncompressedSize, ConstBufferRef(stream.peek(), dataSize));
+    _fields.insert(_fields.end(), fields.begin(), fields.end());
+    stream.adjustReadPos(dataSize);
+}
+
+const SerializedDocumentView::FieldEntry *
+SerializedDocumentView::findField(int32_t fieldId) const
+{
+    auto itr = std::lower_bound(_fields.begin(), _fields.end(), FieldEntry(fieldId, 0, 0, 0));
+    if (itr != _fields.end() && itr->_id == fieldId) {
+        return &*itr;
+    }
+    return nullptr;
+}
+
+const Field &
+SerializedDocumentView::getField(const stringref &name) const
+{
+    return _type->getField(name);
+}
+
+bool
+SerializedDocumentView::hasValue(const Field &field) const
+{
+    return (findField(field.getId()) != nullptr);
+}
+
+FieldValue::UP
+SerializedDocumentView::getValue(const Field &field) const
+{
+    const FieldEntry *entry = findField(field.getId());
+    if ((entry == nullptr) || (entry->_size == 0)) {
+        return FieldValue::UP();
+    }
+    const char *data = _chunks[entry->_chunk].getUncompressed() + entry->_offset;
+    nbostream stream(data, entry->_size);
+    FieldValue::UP value(field.getDataType().createFieldValue());
+    FixedTypeRepo repo(_repo, *_type);
+    VespaDocumentDeserializer deserializer(repo, stream, _version);
+    deserializer.read(*value);
+    return value;
+}
+
+void
+SerializedDocumentView::iterateNested(FieldValue::PathRange nested, fieldvalue::IteratorHandler &handler) const
+{
+    if (!nested.atEnd() && (nested.cur().getType() == FieldPathEntry::STRUCT_FIELD)) {
+        FieldValue::UP value = getValue(nested.cur().getFieldRef());
+        if (value) {
+            value->iterateNested(nested.next(), handler);
+        }
+    } else {
+        createDocument()->iterateNested(nested, handler);
+    }
+}
+
+std::unique_ptr<Document>
+SerializedDocumentView::createDocument() const
+{
+    nbostream stream(_buffer.c_str(), _buffer.size());
+    return std::make_unique<Document>(_repo, stream);
+}
+
+}  // namespace document
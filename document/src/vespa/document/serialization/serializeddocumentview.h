@@ -0,0 +1,117 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/document/base/documentid.h>
+#include <vespa/document/fieldvalue/fieldvalue.h>
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/buffer.h>
+#include <vespa/vespalib/util/compressionconfig.h>
+#include <memory>
+#include <vector>
+
+namespace vespalib { class nbostream; }
+
+namespace document {
+
+class Document;
+class DocumentType;
+class DocumentTypeRepo;
+class Field;
+
+/**
+ * Read-only view of a serialized document. Only the document id, the
+ * document type and the offsets of the fields are decoded up front; field
+ * values are deserialized from the buffer when they are asked for. This is
+ * cheaper than deserializing a full Document when only a few fields are
+ * used, e.g. when evaluating a document selection.
+ *
+ * Uncompressed field data is read directly from the serialized buffer,
+ * which must outlive the view unless ownership is handed to it.
+ * Compressed chunks are decompressed once, on first access to a field
+ * stored in them. The view is not thread safe.
+ *
+ * Subclasses may supply field values that are not part of the serialized
+ * document by overriding hasValue, getValue and createDocument.
+ */
+class SerializedDocumentView {
+public:
+    using UP = std::unique_ptr<SerializedDocumentView>;
+    using CompressionType = vespalib::compression::CompressionConfig::Type;
+
+    /**
+     * Indexes the given serialized document, which must stay valid for
+     * the lifetime of the view.
+     *
+     * @throws DeserializeException if the serialization is invalid.
+     * @throws DocumentTypeNotFoundException if the document type is unknown.
+     */
+    SerializedDocumentView(const DocumentTypeRepo &repo, vespalib::ConstBufferRef buffer);
+    /** As above, but the view takes ownership of the buffer. */
+    SerializedDocumentView(const DocumentTypeRepo &repo, vespalib::DataBuffer::UP buffer);
+    SerializedDocumentView(const SerializedDocumentView &) = delete;
+    SerializedDocumentView &operator=(const SerializedDocumentView &) = delete;
+    virtual ~SerializedDocumentView();
+
+    const DocumentId &getId() const { return _id; }
+    const DocumentType &getType() const { return *_type; }
+    const DocumentTypeRepo &getRepo() const { return _repo; }
+    uint16_t getVersion() const { return _version; }
+    vespalib::ConstBufferRef getSerialized() const { return _buffer; }
+
+    /** Returns the field with the given name in the document type. Throws if not found. */
+    const Field &getField(const vespalib::stringref &name) const;
+
+    virtual bool hasValue(const Field &field) const;
+    /** Deserializes the value of the given field. Returns null if the field is not set. */
+    virtual FieldValue::UP getValue(const Field &field) const;
+    FieldValue::UP getValue(const vespalib::stringref &name) const { return getValue(getField(name)); }
+
+    /**
+     * Iterates the given field path, deserializing only the first field of
+     * the path. Paths not starting with a struct field are iterated on a
+     * fully deserialized document.
+     */
+    void iterateNested(FieldValue::PathRange nested, fieldvalue::IteratorHandler &handler) const;
+
+    /** Deserializes the full document. */
+    virtual std::unique_ptr<Document> createDocument() const;
+
+private:
+    struct Chunk {
+        CompressionType                  _compression;
+        uint32_t                         _uncompressedSize;
+        vespalib::ConstBufferRef         _data;
+        mutable vespalib::DataBuffer::UP _uncompressed;
+
+        Chunk(CompressionType compression, uint32_t uncompressedSize, vespalib::ConstBufferRef data);
+        Chunk(Chunk &&) = default;
+        ~Chunk();
+        const char *getUncompressed() const;
+    };
+    struct FieldEntry {
+        int32_t  _id;
+        uint32_t _chunk;
+        uint32_t _offset;
+        uint32_t _size;
+
+        FieldEntry(int32_t id, uint32_t chunk, uint32_t offset, uint32_t size)
+            : _id(id), _chunk(chunk), _offset(offset), _size(size) {}
+        bool operator<(const FieldEntry &rhs) const { return _id < rhs._id; }
+    };
+
+    void parse();
+    void parseChunk(vespalib::nbostream &stream);
+    const FieldEntry *findField(int32_t fieldId) const;
+
+    vespalib::DataBuffer::UP  _ownedBuffer;
+    const DocumentTypeRepo   &_repo;
+    vespalib::ConstBufferRef  _buffer;
+    uint16_t                  _version;
+    DocumentId                _id;
+    const DocumentType       *_type;
+    std::vector<Chunk>        _chunks;
+    std::vector<FieldEntry>   _fields; // Sorted on field id
+};
+
+}  // namespace document
@@ -56,6 +56,27 @@ TEST("require that different strings give different function keys") {
                      gen_key(Function::parse("\"b\""), PassParams::ARRAY));
 }
 
+TEST("require that tensor operation details give different function keys") {
+    EXPECT_NOT_EQUAL(gen_key(Function::parse("map(a,f(x)(x+1))"), PassParams::ARRAY),
+                     gen_key(Function::parse("map(a,f(x)(x+2))"), PassParams::ARRAY));
+    EXPECT_NOT_EQUAL(gen_key(Function::parse("reduce(a,sum,x)"), PassParams::ARRAY),
+                     gen_key(Function::parse("reduce(a,max,x)"), PassParams::ARRAY));
+    EXPECT_NOT_EQUAL(gen_key(Function::parse("reduce(a,sum,x)"), PassParams::ARRAY),
+                     gen_key(Function::parse("reduce(a,sum,y)"), PassParams::ARRAY));
+    EXPECT_NOT_EQUAL(gen_key(Function::parse("rename(a,x,y)"), PassParams::ARRAY),
+                     gen_key(Function::parse("rename(a,x,z)"), PassParams::ARRAY));
+}
+
+TEST("require that parameter types affect function key") {
+    auto function = Function::parse("reduce(a*b,sum)");
+    auto type_3 = ValueType::from_spec("tensor(x[3])");
+    auto type_5 = ValueType::from_spec("tensor(x[5])");
+    EXPECT_EQUAL(gen_key(function, PassParams::CELLS, {type_3, type_3}),
+                 gen_key(function, PassParams::CELLS, {type_3, type_3}));
+    EXPECT_NOT_EQUAL(gen_key(function, PassParams::CELLS, {type_3, type_3}),
+                     gen_key(function, PassParams::CELLS, {type_5, type_5}));
+}
+
 //-----------------------------------------------------------------------------
 
 struct CheckKeys : test::EvalSpec::EvalTest {
@@ -229,4 +229,86 @@ TEST("require that function issues can be detected") {
 
 //-----------------------------------------------------------------------------
 
+struct TensorFixture {
+    std::vector<ValueType> types;
+    std::vector<std::vector<double>> cells;
+    TensorFixture() : types(), cells() {}
+    TensorFixture &add(const vespalib::string &type_spec, const std::vector<double> &cells_in) {
+        types.push_back(ValueType::from_spec(type_spec));
+        cells.push_back(cells_in);
+        return *this;
+    }
+    double eval(const vespalib::string &expr) const {
+        std::vector<vespalib::string> names({"a", "b", "c"});
+        names.resize(types.size());
+        Function function = Function::parse(names, expr);
+        EXPECT_FALSE(function.has_error());
+        Function::Issues issues = CompiledFunction::detect_issues(function, types);
+        EXPECT_FALSE(issues);
+        if (issues) {
+            std::cerr << "unexpected issues: " << issues.list << std::endl;
+            return std::nan("");
+        }
+        CompiledFunction cf(function, types);
+        EXPECT_TRUE(cf.pass_params() == PassParams::CELLS);
+        std::vector<const double *> params;
+        for (const auto &param_cells: cells) {
+            params.push_back(&param_cells[0]);
+        }
+        return cf.get_cells_function()(&params[0]);
+    }
+};
+
+TEST_F("require that dense tensor parameters can be compiled", TensorFixture()) {
+    f1.add("tensor(x[3])", {1.0, 2.0, 3.0})
+      .add("tensor(x[3])", {4.0, 6.0, 8.0})
+      .add("double", {0.5});
+    EXPECT_EQUAL(40.0, f1.eval("reduce(a*b,sum)"));
+    EXPECT_EQUAL(50.0, f1.eval("reduce((a-b)*(a-b),sum)"));
+    EXPECT_EQUAL(50.0, f1.eval("reduce(join(a,b,f(x,y)((x-y)*(x-y))),sum)"));
+    EXPECT_EQUAL(50.0, f1.eval("reduce(map(a-b,f(x)(x*x)),sum)"));
+    EXPECT_EQUAL(3.0, f1.eval("reduce(a*c,sum)"));
+    EXPECT_EQUAL(6.0, f1.eval("reduce(a,prod)"));
+    EXPECT_EQUAL(2.0, f1.eval("reduce(a,avg)"));
+    EXPECT_EQUAL(3.0, f1.eval("reduce(a,count)"));
+    EXPECT_EQUAL(8.0, f1.eval("reduce(b,max)"));
+    EXPECT_EQUAL(1.0, f1.eval("reduce(a,min)"));
+    EXPECT_EQUAL(9.0, f1.eval("reduce(max(a,b-c*6),sum)"));
+}
+
+TEST_F("require that dense tensors with multiple dimensions can be compiled", TensorFixture()) {
+    f1.add("tensor(x[2],y[3])", {1.0, 2.0, 3.0, 4.0, 5.0, 6.0})
+      .add("tensor(y[3])", {1.0, 10.0, 100.0})
+      .add("tensor(z[2])", {2.0, 3.0});
+    EXPECT_EQUAL(975.0, f1.eval("reduce(a*b,sum)"));
+    EXPECT_EQUAL(321.0, f1.eval("reduce(reduce(a*b,sum,y),min)"));
+    EXPECT_EQUAL(654.0, f1.eval("reduce(reduce(a*b,max,x),sum)"));
+    EXPECT_EQUAL(57.0, f1.eval("reduce(reduce(a,sum,y)*rename(c,z,x),sum)"));
+    EXPECT_EQUAL(105.0, f1.eval("reduce(a*c,sum)"));
+    EXPECT_EQUAL(40.0, f1.eval("reduce(a*tensor(x[2],y[3])(x+y),sum)"));
+}
+
+TEST("require that tensor function issues can be detected") {
+    auto dense_3 = ValueType::from_spec("tensor(x[3])");
+    auto dense_5 = ValueType::from_spec("tensor(x[5])");
+    auto abstract = ValueType::from_spec("tensor(x[])");
+    auto sparse = ValueType::from_spec("tensor(x{})");
+    auto huge = ValueType::from_spec("tensor(x[1000],y[1000])");
+    auto number = ValueType::double_type();
+    auto fun = Function::parse("reduce(a*b,sum)");
+    EXPECT_FALSE(CompiledFunction::detect_issues(fun, {dense_3, dense_3}));
+    EXPECT_FALSE(CompiledFunction::detect_issues(fun, {dense_3, number}));
+    EXPECT_TRUE(CompiledFunction::detect_issues(fun, {dense_3}));
+    EXPECT_TRUE(CompiledFunction::detect_issues(fun, {abstract, abstract}));
+    EXPECT_TRUE(CompiledFunction::detect_issues(fun, {sparse, sparse}));
+    EXPECT_TRUE(CompiledFunction::detect_issues(fun, {huge, huge}));
+    EXPECT_TRUE(CompiledFunction::detect_issues(fun, {ValueType::any_type(), number}));
+    EXPECT_TRUE(CompiledFunction::detect_issues(Function::parse("a*b"), {dense_3, dense_3}));
+    EXPECT_TRUE(CompiledFunction::detect_issues(Function::parse("reduce(concat(a,b,x),sum)"), {dense_3, dense_5}));
+    EXPECT_TRUE(CompiledFunction::detect_issues(Function::parse({"a", "b", "c"}, "reduce(if(c,a,b),sum)"), {dense_3, dense_3, number}));
+    EXPECT_FALSE(CompiledFunction::detect_issues(Function::parse({"a", "b", "c"}, "if(c,reduce(a,sum),reduce(b,sum))"), {dense_3, dense_3, number}));
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,147 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/tensor_spec.h>
+#include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_fused_reduce_function.h>
+#include <vespa/vespalib/util/stash.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace vespalib;
+using namespace vespalib::eval;
+using namespace vespalib::eval::operation;
+using namespace vespalib::eval::tensor_function;
+using namespace vespalib::tensor;
+
+double square(double a) { return (a * a); }
+double my_join(double a, double b) { return ((a * a) + b); }
+
+const TensorEngine &engine = DefaultTensorEngine::ref();
+
+// Cell values are never zero, so PROD is sensitive to every cell
+Value::UP
+makeTensor(size_t xSize, size_t ySize, double cellBias)
+{
+    TensorSpec spec(make_string("tensor(x[%zu],y[%zu])", xSize, ySize));
+    for (size_t x = 0; x < xSize; ++x) {
+        for (size_t y = 0; y < ySize; ++y) {
+            spec.add({{"x", x}, {"y", y}}, ((x * ySize + y) * 0.5) + 0.25 - cellBias);
+        }
+    }
+    return engine.from_spec(spec);
+}
+
+struct Fixture
+{
+    Value::UP lhs;
+    Value::UP rhs;
+    std::vector<Value::CREF> params;
+    Stash stash;
+    Fixture(size_t xSize, size_t ySize)
+        : lhs(makeTensor(xSize, ySize, 3.0)),
+          rhs(makeTensor(xSize, ySize, 5.0)),
+          params(),
+          stash()
+    {
+        params.emplace_back(*lhs);
+        params.emplace_back(*rhs);
+    }
+    ~Fixture();
+    const Node &makeExpr(join_fun_t joinFun, map_fun_t mapFun, Aggr aggr) {
+        const Node &joinNode = join(inject(lhs->type(), 0, stash), inject(rhs->type(), 1, stash), joinFun, stash);
+        if (mapFun == nullptr) {
+            return reduce(joinNode, aggr, {}, stash);
+        }
+        return reduce(map(joinNode, mapFun, stash), aggr, {}, stash);
+    }
+    double eval(const TensorFunction &function) const {
+        InterpretedFunction ifun(engine, function);
+        InterpretedFunction::Context ictx(ifun);
+        const Value &result = ifun.eval(ictx, SimpleObjectParams(params));
+        ASSERT_TRUE(result.is_double());
+        return result.as_double();
+    }
+    void verify(join_fun_t joinFun, map_fun_t mapFun, Aggr aggr) {
+        const Node &expr = makeExpr(joinFun, mapFun, aggr);
+        const TensorFunction &optimized = DenseFusedReduceFunction::optimize(expr, stash);
+        const DenseFusedReduceFunction *fused = as<DenseFusedReduceFunction>(optimized);
+        ASSERT_TRUE(fused);
+        EXPECT_TRUE(fused->aggr() == aggr);
+        EXPECT_EQUAL(fused->hasMap(), (mapFun != nullptr));
+        double expect = eval(expr);
+        // The fused loop may be compiled differently than the unfused
+        // operations, so results are only expected to be close.
+        EXPECT_APPROX(expect, eval(optimized), std::max(std::abs(expect), 1.0) * 1e-12);
+    }
+};
+
+Fixture::~Fixture() = default;
+
+const std::vector<Aggr> aggrs({Aggr::AVG, Aggr::COUNT, Aggr::PROD, Aggr::SUM, Aggr::MAX, Aggr::MIN});
+
+TEST_F("require that fused reduce of join gives same result as unfused evaluation", Fixture(3, 5)) {
+    for (join_fun_t joinFun : {Mul::f, Add::f, Sub::f, my_join}) {
+        for (Aggr aggr : aggrs) {
+            TEST_DO(f.verify(joinFun, nullptr, aggr));
+        }
+    }
+}
+
+TEST_F("require that fused reduce of map of join gives same result as unfused evaluation", Fixture(3, 5)) {
+    for (join_fun_t joinFun : {Mul::f, Add::f, Sub::f, my_join}) {
+        for (Aggr aggr : aggrs) {
+            TEST_DO(f.verify(joinFun, square, aggr));
+        }
+    }
+}
+
+TEST_F("require that fused reduce handles single cell tensors", Fixture(1, 1)) {
+    for (Aggr aggr : aggrs) {
+        TEST_DO(f.verify(Sub::f, square, aggr));
+    }
+}
+
+TEST_F("require that squared euclidean distance is calculated", Fixture(2, 2)) {
+    const Node &expr = f.makeExpr(Sub::f, square, Aggr::SUM);
+    const TensorFunction &optimized = DenseFusedReduceFunction::optimize(expr, f.stash);
+    // every cell differs by 2.0
+    EXPECT_EQUAL(16.0, f.eval(optimized));
+}
+
+TEST("require that join between different dense types is not fused") {
+    Stash stash;
+    ValueType lhsType = ValueType::from_spec("tensor(x[3])");
+    ValueType rhsType = ValueType::from_spec("tensor(x[5])");
+    const Node &expr = reduce(join(inject(lhsType, 0, stash), inject(rhsType, 1, stash), Mul::f, stash),
+                              Aggr::MAX, {}, stash);
+    EXPECT_TRUE(as<Reduce>(DenseFusedReduceFunction::optimize(expr, stash)));
+}
+
+TEST("require that join between abstract dense types is not fused") {
+    Stash stash;
+    ValueType type = ValueType::from_spec("tensor(x[])");
+    const Node &expr = reduce(join(inject(type, 0, stash), inject(type, 1, stash), Mul::f, stash),
+                              Aggr::MAX, {}, stash);
+    EXPECT_TRUE(as<Reduce>(DenseFusedReduceFunction::optimize(expr, stash)));
+}
+
+TEST("require that join between sparse tensors is not fused") {
+    Stash stash;
+    ValueType type = ValueType::from_spec("tensor(x{})");
+    const Node &expr = reduce(join(inject(type, 0, stash), inject(type, 1, stash), Mul::f, stash),
+                              Aggr::SUM, {}, stash);
+    EXPECT_TRUE(as<Reduce>(DenseFusedReduceFunction::optimize(expr, stash)));
+}
+
+TEST("require that partial reduce is not fused") {
+    Stash stash;
+    ValueType type = ValueType::from_spec("tensor(x[3],y[5])");
+    const Node &expr = reduce(join(inject(type, 0, stash), inject(type, 1, stash), Mul::f, stash),
+                              Aggr::SUM, {"x"}, stash);
+    EXPECT_TRUE(as<Reduce>(DenseFusedReduceFunction::optimize(expr, stash)));
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -2,6 +2,8 @@
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/eval/eval/function.h>
 #include <vespa/eval/eval/interpreted_function.h>
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/tensor_function.h>
 #include <vespa/eval/eval/tensor_nodes.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/tensor/sparse/sparse_tensor.h>
@@ -81,6 +83,17 @@ double benchmark_expression_us(const vespalib::string &expression, const Params
     return BenchmarkTimer::benchmark(ranking, baseline, 5.0) * 1000.0 * 1000.0;
 }
 
+double benchmark_tensor_function_us(const TensorFunction &function, const std::vector<Value::CREF> &params) {
+    const InterpretedFunction interpreted(tensor::DefaultTensorEngine::ref(), function);
+    InterpretedFunction::Context context(interpreted);
+    SimpleObjectParams fun_params(params);
+    auto ranking = [&](){ interpreted.eval(context, fun_params); };
+    auto baseline = [&](){ dummy_ranking(context, fun_params); };
+    return BenchmarkTimer::benchmark(ranking, baseline, 5.0) * 1000.0 * 1000.0;
+}
+
+double square(double a) { return (a * a); }
+
 //-----------------------------------------------------------------------------
 
 Value::UP make_tensor(TensorSpec spec) {
@@ -363,6 +376,23 @@ TEST("benchmark matrix product") {
     }
 }
 
+TEST("benchmark fused vs unfused dense squared euclidean distance") {
+    using namespace tensor_function;
+    for (size_t size: {10, 25, 50, 100, 250}) {
+        Value::UP query = make_tensor(DENSE, {DimensionSpec("x", size)});
+        Value::UP document = make_tensor(DENSE, {DimensionSpec("x", size)});
+        Stash stash;
+        const Node &plain = reduce(map(join(inject(query->type(), 0, stash), inject(document->type(), 1, stash),
+                                            operation::Sub::f, stash),
+                                       square, stash),
+                                   Aggr::SUM, {}, stash);
+        const TensorFunction &fused = tensor::DefaultTensorEngine::ref().optimize(plain, stash);
+        double plain_us = benchmark_tensor_function_us(plain, {*query, *document});
+        double fused_us = benchmark_tensor_function_us(fused, {*query, *document});
+        fprintf(stderr, "-- squared euclidean distance %zu vs %zu: unfused %g us, fused %g us\n", size, size, plain_us, fused_us);
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 TEST_MAIN() { TEST_RUN_ALL(); }
@@ -14,7 +14,7 @@
 namespace vespalib {
 namespace eval {
 
-enum class PassParams : uint8_t { SEPARATE, ARRAY, LAZY };
+enum class PassParams : uint8_t { SEPARATE, ARRAY, LAZY, CELLS };
 
 /**
  * Interface used to perform custom symbol extraction. This is
@@ -3,6 +3,7 @@
 #include "key_gen.h"
 #include "node_visitor.h"
 #include "node_traverser.h"
+#include "value_type.h"
 
 namespace vespalib {
 namespace eval {
@@ -20,6 +21,18 @@ struct KeyGen : public NodeVisitor, public NodeTraverser {
     void add_int(int value) { key.append(&value, sizeof(value)); }
     void add_hash(uint32_t value) { key.append(&value, sizeof(value)); }
     void add_byte(uint8_t value) { key.append(&value, sizeof(value)); }
+    void add_string(const vespalib::string &value) { add_size(value.size()); key.append(value); }
+    void add_strings(const std::vector<vespalib::string> &values) {
+        add_size(values.size());
+        for (const auto &value: values) {
+            add_string(value);
+        }
+    }
+    void add_lambda(const Function &lambda) {
+        add_size(lambda.num_params());
+        lambda.root().traverse(*this);
+        add_byte(0);
+    }
 
     // visit
     void visit(const Number   &node) override { add_byte( 1); add_double(node.value()); }
@@ -35,12 +48,12 @@ struct KeyGen : public NodeVisitor, public NodeTraverser {
     void visit(const Not          &) override { add_byte( 6); }
     void visit(const If       &node) override { add_byte( 7); add_double(node.p_true()); }
     void visit(const Error        &) override { add_byte( 9); }
-    void visit(const TensorMap    &) override { add_byte(11); } // lambda should be part of key
-    void visit(const TensorJoin   &) override { add_byte(12); } // lambda should be part of key
-    void visit(const TensorReduce &) override { add_byte(13); } // aggr/dimensions should be part of key
-    void visit(const TensorRename &) override { add_byte(14); } // dimensions should be part of key
-    void visit(const TensorLambda &) override { add_byte(15); } // type/lambda should be part of key
-    void visit(const TensorConcat &) override { add_byte(16); } // dimension should be part of key
+    void visit(const TensorMap    &node) override { add_byte(11); add_lambda(node.lambda()); }
+    void visit(const TensorJoin   &node) override { add_byte(12); add_lambda(node.lambda()); }
+    void visit(const TensorReduce &node) override { add_byte(13); add_byte(uint8_t(node.aggr())); add_strings(node.dimensions()); }
+    void visit(const TensorRename &node) override { add_byte(14); add_strings(node.from()); add_strings(node.to()); }
+    void visit(const TensorLambda &node) override { add_byte(15); add_string(node.type().to_spec()); add_lambda(node.lambda()); }
+    void visit(const TensorConcat &node) override { add_byte(16); add_string(node.dimension()); }
     void visit(const Add          &) override { add_byte(20); }
     void visit(const Sub          &) override { add_byte(21); }
     void visit(const Mul          &) override { add_byte(22); }
@@ -99,5 +112,15 @@ vespalib::string gen_key(const Function &function, PassParams pass_params)
     return key_gen.key;
 }
 
+vespalib::string gen_key(const Function &function, PassParams pass_params, const std::vector<ValueType> &param_types)
+{
+    vespalib::string key = gen_key(function, pass_params);
+    for (const ValueType &type: param_types) {
+        key.append(type.to_spec());
+        key.append(";");
+    }
+    return key;
+}
+
 } // namespace vespalib::eval
 } // namespace vespalib
@@ -3,11 +3,13 @@
 #pragma once
 
 #include <vespa/vespalib/stllike/string.h>
+#include <vector>
 
 namespace vespalib {
 namespace eval {
 
 class Function;
+class ValueType;
 enum class PassParams : uint8_t;
 
 /**
@@ -16,6 +18,12 @@ enum class PassParams : uint8_t;
  **/
 vespalib::string gen_key(const Function &function, PassParams pass_params);
 
+/**
+ * Same as above, but the key also covers the types of the function
+ * parameters. Used for functions compiled for specific tensor types.
+ **/
+vespalib::string gen_key(const Function &function, PassParams pass_params, const std::vector<ValueType> &param_types);
+
 } // namespace vespalib::eval
 } // namespace vespalib
 
@@ -23,7 +23,17 @@ CompileCache::Token::UP
 CompileCache::compile(const Function &function, PassParams pass_params)
 {
     std::lock_guard<std::mutex> guard(_lock);
-    CompileContext compile_ctx(function, pass_params);
+    CompileContext compile_ctx(function, pass_params, nullptr);
+    std::thread thread(do_compile, std::ref(compile_ctx));
+    thread.join();
+    return std::move(compile_ctx.token);
+}
+
+CompileCache::Token::UP
+CompileCache::compile(const Function &function, const std::vector<ValueType> &param_types)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    CompileContext compile_ctx(function, PassParams::CELLS, &param_types);
     std::thread thread(do_compile, std::ref(compile_ctx));
     thread.join();
     return std::move(compile_ctx.token);
@@ -49,11 +59,17 @@ CompileCache::count_refs()
 
 void
 CompileCache::do_compile(CompileContext &ctx) {
-    vespalib::string key = gen_key(ctx.function, ctx.pass_params);
+    vespalib::string key = (ctx.param_types != nullptr)
+                           ? gen_key(ctx.function, ctx.pass_params, *ctx.param_types)
+                           : gen_key(ctx.function, ctx.pass_params);
     auto pos = _cached.find(key);
     if (pos != _cached.end()) {
         ++(pos->second.num_refs);
         ctx.token.reset(new Token(pos));
+    } else if (ctx.param_types != nullptr) {
+        auto res = _cached.emplace(std::move(key), Value(CompiledFunction(ctx.function, *ctx.param_types)));
+        assert(res.second);
+        ctx.token.reset(new Token(res.first));
     } else {
         auto res = _cached.emplace(std::move(key), Value(CompiledFunction(ctx.function, ctx.pass_params)));
         assert(res.second);
@@ -45,6 +45,7 @@ public:
         ~Token() { CompileCache::release(entry); }
     };
     static Token::UP compile(const Function &function, PassParams pass_params);
+    static Token::UP compile(const Function &function, const std::vector<ValueType> &param_types);
     static size_t num_cached();
     static size_t count_refs();
 
@@ -52,11 +53,14 @@ private:
     struct CompileContext {
         const Function &function;
         PassParams pass_params;
+        const std::vector<ValueType> *param_types;
         Token::UP token;
         CompileContext(const Function &function_in,
-                       PassParams pass_params_in)
+                       PassParams pass_params_in,
+                       const std::vector<ValueType> *param_types_in)
             : function(function_in),
               pass_params(pass_params_in),
+              param_types(param_types_in),
               token() {}
     };
 
@@ -3,6 +3,7 @@
 #include "compiled_function.h"
 #include <vespa/eval/eval/param_usage.h>
 #include <vespa/eval/eval/gbdt.h>
+#include <vespa/eval/eval/node_types.h>
 #include <vespa/eval/eval/node_traverser.h>
 #include <vespa/eval/eval/check_type.h>
 #include <vespa/eval/eval/tensor_nodes.h>
@@ -26,6 +27,17 @@ double empty_lazy_function(CompiledFunction::resolve_function, void *) { return
 
 double my_resolve(void *ctx, size_t idx) { return ((double *)ctx)[idx]; }
 
+// all tensor operations are unrolled; avoid generating huge functions
+constexpr size_t max_unrolled_cells = 16384;
+
+size_t count_cells(const ValueType &type) {
+    size_t cells = 1;
+    for (const auto &dim: type.dimensions()) {
+        cells *= dim.size;
+    }
+    return cells;
+}
+
 } // namespace vespalib::eval::<unnamed>
 
 CompiledFunction::CompiledFunction(const Function &function_in, PassParams pass_params_in,
@@ -43,6 +55,23 @@ CompiledFunction::CompiledFunction(const Function &function_in, PassParams pass_
     _address = _llvm_wrapper.get_function_address(id);
 }
 
+CompiledFunction::CompiledFunction(const Function &function_in, const std::vector<ValueType> &param_types)
+    : _llvm_wrapper(),
+      _address(nullptr),
+      _num_params(function_in.num_params()),
+      _pass_params(PassParams::CELLS)
+{
+    assert(param_types.size() == function_in.num_params());
+    NodeTypes types(function_in, param_types);
+    size_t id = _llvm_wrapper.make_function(function_in.num_params(),
+                                            _pass_params,
+                                            function_in.root(),
+                                            gbdt::Optimize::none,
+                                            types);
+    _llvm_wrapper.compile();
+    _address = _llvm_wrapper.get_function_address(id);
+}
+
 CompiledFunction::CompiledFunction(CompiledFunction &&rhs)
     : _llvm_wrapper(std::move(rhs._llvm_wrapper)),
       _address(rhs._address),
@@ -138,6 +167,65 @@ CompiledFunction::detect_issues(const Function &function)
     return Function::Issues(std::move(checker.issues));
 }
 
+Function::Issues
+CompiledFunction::detect_issues(const Function &function, const std::vector<ValueType> &param_types)
+{
+    if (param_types.size() != function.num_params()) {
+        return Function::Issues({"wrong number of parameter types"});
+    }
+    NodeTypes types(function, param_types);
+    struct NotSupported : NodeTraverser {
+        const NodeTypes &types;
+        size_t cells;
+        std::vector<vespalib::string> issues;
+        NotSupported(const NodeTypes &types_in) : types(types_in), cells(0), issues() {}
+        bool open(const nodes::Node &) override { return true; }
+        void close(const nodes::Node &node) override {
+            const ValueType &type = types.get_type(node);
+            if (type.is_error() || type.is_any()) {
+                issues.push_back(make_string("unresolved type for node: %s",
+                                getClassName(node).c_str()));
+            } else if (type.is_tensor() && (!type.is_dense() || type.is_abstract())) {
+                issues.push_back(make_string("unsupported tensor type: %s",
+                                type.to_spec().c_str()));
+            } else if (type.is_tensor()) {
+                cells += count_cells(type);
+            }
+            if (nodes::check_type<nodes::TensorConcat>(node)) {
+                issues.push_back(make_string("unsupported node type: %s",
+                                getClassName(node).c_str()));
+            }
+            if (nodes::check_type<nodes::If>(node)) {
+                for (size_t i = 0; i < node.num_children(); ++i) {
+                    if (types.get_type(node.get_child(i)).is_tensor()) {
+                        issues.push_back("unsupported tensor value in if");
+                    }
+                }
+            }
+            if (auto map = nodes::as<nodes::TensorMap>(node)) {
+                check_lambda(map->lambda());
+            } else if (auto join = nodes::as<nodes::TensorJoin>(node)) {
+                check_lambda(join->lambda());
+            } else if (auto lambda = nodes::as<nodes::TensorLambda>(node)) {
+                check_lambda(lambda->lambda());
+            }
+        }
+        void check_lambda(const Function &lambda) {
+            for (auto &issue: CompiledFunction::detect_issues(lambda).list) {
+                issues.push_back(issue);
+            }
+        }
+    } checker(types);
+    function.root().traverse(checker);
+    if (!types.get_type(function.root()).is_double()) {
+        checker.issues.push_back("result is not a number");
+    }
+    if (checker.cells > max_unrolled_cells) {
+        checker.issues.push_back(make_string("too many tensor cells to unroll: %zu", checker.cells));
+    }
+    return Function::Issues(std::move(checker.issues));
+}
+
 bool
 CompiledFunction::should_use_lazy_params(const Function &function)
 {
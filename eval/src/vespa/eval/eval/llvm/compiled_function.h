@@ -12,7 +12,11 @@ namespace eval {
 
 /**
  * A Function that has been compiled to machine code using LLVM. Note
- * that tensors are currently not supported for compiled functions.
+ * that tensors are only supported when the types of all parameters
+ * are given up front (PassParams::CELLS). In that case the function
+ * takes a pointer to the cells of each parameter (a number is a
+ * single cell), and all dense tensor operations are unrolled and
+ * vectorized. The result must be a number.
  **/
 class CompiledFunction
 {
@@ -30,6 +34,8 @@ public:
     using resolve_function = LazyParams::resolve_function;
     using lazy_function = double (*)(resolve_function, void *ctx);
 
+    using cells_function = double (*)(const double * const *);
+
 private:
     LLVMWrapper _llvm_wrapper;
     void       *_address;
@@ -42,6 +48,7 @@ public:
                      const gbdt::Optimize::Chain &forest_optimizers);
     CompiledFunction(const Function &function_in, PassParams pass_params_in)
         : CompiledFunction(function_in, pass_params_in, gbdt::Optimize::best) {}
+    CompiledFunction(const Function &function_in, const std::vector<ValueType> &param_types);
     CompiledFunction(CompiledFunction &&rhs);
     size_t num_params() const { return _num_params; }
     PassParams pass_params() const { return _pass_params; }
@@ -59,11 +66,16 @@ public:
         assert(_pass_params == PassParams::LAZY);
         return ((lazy_function)_address);
     }
+    cells_function get_cells_function() const {
+        assert(_pass_params == PassParams::CELLS);
+        return ((cells_function)_address);
+    }
     const std::vector<gbdt::Forest::UP> &get_forests() const {
         return _llvm_wrapper.get_forests();
     }
     double estimate_cost_us(const std::vector<double> &params, double budget = 5.0) const;
     static Function::Issues detect_issues(const Function &function);
+    static Function::Issues detect_issues(const Function &function, const std::vector<ValueType> &param_types);
     static bool should_use_lazy_params(const Function &function);
 };
 
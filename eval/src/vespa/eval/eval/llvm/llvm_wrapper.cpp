@@ -11,10 +11,15 @@
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
 #include <llvm/Analysis/Passes.h>
 #include <llvm/IR/DataLayout.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Support/Host.h>
 #include <llvm/Transforms/Scalar.h>
 #include <llvm/LinkAllPasses.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #include <vespa/eval/eval/check_type.h>
+#include <vespa/eval/eval/tensor_nodes.h>
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/vespalib/util/approx.h>
 
@@ -68,6 +73,57 @@ struct SetMemberHash : PluginState {
     }
 };
 
+size_t num_cells(const ValueType &type) {
+    size_t cells = 1;
+    for (const auto &dim: type.dimensions()) {
+        cells *= dim.size;
+    }
+    return cells;
+}
+
+bool step_labels(std::vector<size_t> &labels, const ValueType &type) {
+    for (size_t i = labels.size(); i-- > 0; ) {
+        if (++labels[i] < type.dimensions()[i].size) {
+            return true;
+        }
+        labels[i] = 0;
+    }
+    return false;
+}
+
+/**
+ * For each cell in 'from', calculate the index of the cell in 'to'
+ * having the same labels. 'names' gives the name in 'from' of each
+ * dimension in 'to'. Dimensions in 'from' not found in 'to' are
+ * ignored. Cells are ordered with the last dimension varying fastest,
+ * as in dense tensors.
+ **/
+std::vector<size_t> map_cells(const ValueType &from, const ValueType &to,
+                              const std::vector<vespalib::string> &names)
+{
+    assert(names.size() == to.dimensions().size());
+    std::vector<size_t> strides(from.dimensions().size(), 0);
+    size_t stride = 1;
+    for (size_t i = names.size(); i-- > 0; ) {
+        size_t idx = from.dimension_index(names[i]);
+        assert(idx != ValueType::Dimension::npos);
+        assert(from.dimensions()[idx].size <= to.dimensions()[i].size);
+        strides[idx] = stride;
+        stride *= to.dimensions()[i].size;
+    }
+    std::vector<size_t> result;
+    result.reserve(num_cells(from));
+    std::vector<size_t> labels(from.dimensions().size(), 0);
+    do {
+        size_t cell = 0;
+        for (size_t i = 0; i < labels.size(); ++i) {
+            cell += labels[i] * strides[i];
+        }
+        result.push_back(cell);
+    } while (step_labels(labels, from));
+    return result;
+}
+
 struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
 
     llvm::LLVMContext        &context;
@@ -83,6 +139,9 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
     const gbdt::Optimize::Chain &forest_optimizers;
     std::vector<gbdt::Forest::UP> &forests;
     std::vector<PluginState::UP> &plugin_state;
+    const NodeTypes          &types;
+    std::vector<std::vector<llvm::Value*>> tensors;
+    const std::vector<llvm::Value*> *lambda_params;
 
     llvm::PointerType *make_eval_forest_funptr_t() {
         std::vector<llvm::Type*> param_types;
@@ -126,7 +185,8 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
                     PassParams pass_params_in,
                     const gbdt::Optimize::Chain &forest_optimizers_in,
                     std::vector<gbdt::Forest::UP> &forests_out,
-                    std::vector<PluginState::UP> &plugin_state_out)
+                    std::vector<PluginState::UP> &plugin_state_out,
+                    const NodeTypes &types_in)
         : context(context_in),
           module(module_in),
           builder(context),
@@ -139,13 +199,18 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
           forest_end(nullptr),
           forest_optimizers(forest_optimizers_in),
           forests(forests_out),
-          plugin_state(plugin_state_out)
+          plugin_state(plugin_state_out),
+          types(types_in),
+          tensors(),
+          lambda_params(nullptr)
     {
         std::vector<llvm::Type*> param_types;
         if (pass_params == PassParams::SEPARATE) {
             param_types.resize(num_params_in, builder.getDoubleTy());
         } else if (pass_params == PassParams::ARRAY) {
             param_types.push_back(builder.getDoubleTy()->getPointerTo());
+        } else if (pass_params == PassParams::CELLS) {
+            param_types.push_back(builder.getDoubleTy()->getPointerTo()->getPointerTo());
         } else {
             assert(pass_params == PassParams::LAZY);
             param_types.push_back(make_resolve_param_funptr_t());
@@ -165,7 +230,14 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
     //-------------------------------------------------------------------------
 
     llvm::Value *get_param(size_t idx) {
+        if (lambda_params != nullptr) {
+            assert(idx < lambda_params->size());
+            return (*lambda_params)[idx];
+        }
         assert(idx < num_params);
+        if (pass_params == PassParams::CELLS) {
+            return load_cell(get_param_cells(idx), 0);
+        }
         if (pass_params == PassParams::SEPARATE) {
             assert(idx < params.size());
             return params[idx];
@@ -180,6 +252,18 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
         return builder.CreateCall(params[0], {params[1], builder.getInt64(idx)}, "resolve_param");
     }
 
+    llvm::Value *get_param_cells(size_t idx) {
+        assert(pass_params == PassParams::CELLS);
+        assert(params.size() == 1);
+        llvm::Value *addr = builder.CreateGEP(params[0], builder.getInt64(idx));
+        return builder.CreateLoad(addr, "param_cells");
+    }
+
+    llvm::Value *load_cell(llvm::Value *cells, size_t idx) {
+        llvm::Value *addr = builder.CreateGEP(cells, builder.getInt64(idx));
+        return builder.CreateLoad(addr, "cell");
+    }
+
     //-------------------------------------------------------------------------
 
     void push(llvm::Value *value) {
@@ -246,7 +330,7 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
             push_double(node.get_const_value());
             return false;
         }
-        if (!inside_forest && (pass_params != PassParams::SEPARATE) && node.is_forest()) {
+        if (!inside_forest && ((pass_params == PassParams::ARRAY) || (pass_params == PassParams::LAZY)) && node.is_forest()) {
             if (try_optimize_forest(node)) {
                 return false;
             }
@@ -261,7 +345,9 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
     }
 
     void close(const Node &node) override {
-        node.accept(*this);
+        if (!try_make_tensor_op(node)) {
+            node.accept(*this);
+        }
         if (inside_forest && (forest_end == &node)) {
             inside_forest = false;
             forest_end = nullptr;
@@ -292,12 +378,225 @@ struct FunctionBuilder : public NodeVisitor, public NodeTraverser {
     llvm::Function *build() {
         builder.CreateRet(pop_double());
         assert(values.empty());
+        assert(tensors.empty());
         llvm::verifyFunction(*function);
         return function;
     }
 
     //-------------------------------------------------------------------------
 
+    // Tensor values are only supported when the types of all nodes
+    // are known (PassParams::CELLS). All dense tensor operations are
+    // unrolled into separate operations on each cell, leaving it to
+    // the optimizer to vectorize the result. Lambdas are inlined.
+
+    bool is_tensor(const Node &node) const {
+        return ((lambda_params == nullptr) && types.get_type(node).is_tensor());
+    }
+
+    std::vector<llvm::Value*> pop_cells(const Node &node) {
+        if (is_tensor(node)) {
+            assert(!tensors.empty());
+            std::vector<llvm::Value*> cells = std::move(tensors.back());
+            tensors.pop_back();
+            return cells;
+        }
+        return {pop_double()};
+    }
+
+    void push_cells(const Node &node, std::vector<llvm::Value*> cells) {
+        if (is_tensor(node)) {
+            tensors.push_back(std::move(cells));
+        } else {
+            assert(cells.size() == 1);
+            push(cells[0]);
+        }
+    }
+
+    llvm::Value *inline_lambda(const Function &lambda, const std::vector<llvm::Value*> &args) {
+        assert(args.size() == lambda.num_params());
+        const std::vector<llvm::Value*> *outer_params = lambda_params;
+        lambda_params = &args;
+        lambda.root().traverse(*this);
+        lambda_params = outer_params;
+        return pop_double();
+    }
+
+    // combine the first and second half of the cells until only one
+    // is left; each step is a single vector operation when vectorized
+    template <typename OP>
+    llvm::Value *make_tree(std::vector<llvm::Value*> cells, OP op) {
+        assert(!cells.empty());
+        while (cells.size() > 1) {
+            size_t half = (cells.size() / 2);
+            std::vector<llvm::Value*> next;
+            for (size_t i = 0; i < half; ++i) {
+                next.push_back(op(cells[i], cells[i + half]));
+            }
+            if ((cells.size() % 2) == 1) {
+                next.push_back(cells.back());
+            }
+            cells.swap(next);
+        }
+        return cells[0];
+    }
+
+    llvm::Value *make_aggr(Aggr aggr, const std::vector<llvm::Value*> &cells) {
+        switch (aggr) {
+        case Aggr::AVG:
+            return builder.CreateFDiv(make_aggr(Aggr::SUM, cells),
+                                      llvm::ConstantFP::get(builder.getDoubleTy(), cells.size()), "avg_res");
+        case Aggr::COUNT:
+            return llvm::ConstantFP::get(builder.getDoubleTy(), cells.size());
+        case Aggr::PROD:
+            return make_tree(cells, [this](llvm::Value *a, llvm::Value *b)
+                             { return builder.CreateFMul(a, b, "prod_res"); });
+        case Aggr::SUM:
+            return make_tree(cells, [this](llvm::Value *a, llvm::Value *b)
+                             { return builder.CreateFAdd(a, b, "sum_res"); });
+        case Aggr::MAX:
+            return make_tree(cells, [this](llvm::Value *a, llvm::Value *b)
+                             { return builder.CreateSelect(builder.CreateFCmpOLT(a, b), b, a, "max_res"); });
+        case Aggr::MIN:
+            return make_tree(cells, [this](llvm::Value *a, llvm::Value *b)
+                             { return builder.CreateSelect(builder.CreateFCmpOLT(b, a), b, a, "min_res"); });
+        }
+        abort();
+    }
+
+    void make_tensor_param(const Symbol &node) {
+        llvm::Value *param_cells = get_param_cells(node.id());
+        std::vector<llvm::Value*> cells;
+        for (size_t i = 0; i < num_cells(types.get_type(node)); ++i) {
+            cells.push_back(load_cell(param_cells, i));
+        }
+        tensors.push_back(std::move(cells));
+    }
+
+    // operator and call nodes applied to each cell, with broadcasting
+    void make_cellwise(const Node &node) {
+        const ValueType &type = types.get_type(node);
+        std::vector<std::vector<llvm::Value*>> args(node.num_children());
+        std::vector<std::vector<size_t>> arg_cells(node.num_children());
+        for (size_t i = node.num_children(); i-- > 0; ) {
+            const Node &child = node.get_child(i);
+            args[i] = pop_cells(child);
+            arg_cells[i] = map_cells(type, types.get_type(child), types.get_type(child).dimension_names());
+        }
+        std::vector<llvm::Value*> cells;
+        for (size_t cell = 0; cell < num_cells(type); ++cell) {
+            for (size_t i = 0; i < args.size(); ++i) {
+                push(args[i][arg_cells[i][cell]]);
+            }
+            node.accept(*this);
+            cells.push_back(pop_double());
+        }
+        push_cells(node, std::move(cells));
+    }
+
+    void make_map(const TensorMap &node) {
+        std::vector<llvm::Value*> cells = pop_cells(node.get_child(0));
+        for (llvm::Value *&cell: cells) {
+            cell = inline_lambda(node.lambda(), {cell});
+        }
+        push_cells(node, std::move(cells));
+    }
+
+    void make_join(const TensorJoin &node) {
+        const ValueType &type = types.get_type(node);
+        const ValueType &lhs_type = types.get_type(node.get_child(0));
+        const ValueType &rhs_type = types.get_type(node.get_child(1));
+        std::vector<llvm::Value*> rhs = pop_cells(node.get_child(1));
+        std::vector<llvm::Value*> lhs = pop_cells(node.get_child(0));
+        std::vector<size_t> lhs_cells = map_cells(type, lhs_type, lhs_type.dimension_names());
+        std::vector<size_t> rhs_cells = map_cells(type, rhs_type, rhs_type.dimension_names());
+        std::vector<llvm::Value*> cells;
+        for (size_t cell = 0; cell < num_cells(type); ++cell) {
+            cells.push_back(inline_lambda(node.lambda(), {lhs[lhs_cells[cell]], rhs[rhs_cells[cell]]}));
+        }
+        push_cells(node, std::move(cells));
+    }
+
+    void make_reduce(const TensorReduce &node) {
+        const ValueType &type = types.get_type(node);
+        const ValueType &child_type = types.get_type(node.get_child(0));
+        std::vector<llvm::Value*> child = pop_cells(node.get_child(0));
+        std::vector<size_t> target = map_cells(child_type, type, type.dimension_names());
+        std::vector<std::vector<llvm::Value*>> groups(num_cells(type));
+        for (size_t i = 0; i < child.size(); ++i) {
+            groups[target[i]].push_back(child[i]);
+        }
+        std::vector<llvm::Value*> cells;
+        for (const auto &group: groups) {
+            cells.push_back(make_aggr(node.aggr(), group));
+        }
+        push_cells(node, std::move(cells));
+    }
+
+    void make_rename(const TensorRename &node) {
+        const ValueType &type = types.get_type(node);
+        const ValueType &child_type = types.get_type(node.get_child(0));
+        std::vector<llvm::Value*> child = pop_cells(node.get_child(0));
+        std::vector<vespalib::string> names;
+        for (const auto &dim: child_type.dimensions()) {
+            auto pos = std::find(node.from().begin(), node.from().end(), dim.name);
+            names.push_back((pos == node.from().end()) ? dim.name : node.to()[pos - node.from().begin()]);
+        }
+        std::vector<llvm::Value*> cells;
+        for (size_t cell: map_cells(type, child_type, names)) {
+            cells.push_back(child[cell]);
+        }
+        push_cells(node, std::move(cells));
+    }
+
+    void make_tensor_lambda(const TensorLambda &node) {
+        const ValueType &type = node.type();
+        std::vector<size_t> labels(type.dimensions().size(), 0);
+        std::vector<llvm::Value*> cells;
+        do {
+            std::vector<llvm::Value*> args;
+            for (size_t label: labels) {
+                args.push_back(llvm::ConstantFP::get(builder.getDoubleTy(), label));
+            }
+            cells.push_back(inline_lambda(node.lambda(), args));
+        } while (step_labels(labels, type));
+        push_cells(node, std::move(cells));
+    }
+
+    bool try_make_tensor_op(const Node &node) {
+        if ((pass_params != PassParams::CELLS) || (lambda_params != nullptr)) {
+            return false;
+        }
+        if (auto map = as<TensorMap>(node)) {
+            make_map(*map);
+        } else if (auto join = as<TensorJoin>(node)) {
+            make_join(*join);
+        } else if (auto reduce = as<TensorReduce>(node)) {
+            make_reduce(*reduce);
+        } else if (auto rename = as<TensorRename>(node)) {
+            make_rename(*rename);
+        } else if (auto lambda = as<TensorLambda>(node)) {
+            make_tensor_lambda(*lambda);
+        } else if (auto symbol = as<Symbol>(node)) {
+            if (!is_tensor(*symbol)) {
+                return false;
+            }
+            make_tensor_param(*symbol);
+        } else {
+            bool has_tensor = is_tensor(node);
+            for (size_t i = 0; i < node.num_children(); ++i) {
+                has_tensor = (has_tensor || is_tensor(node.get_child(i)));
+            }
+            if (!has_tensor) {
+                return false;
+            }
+            make_cellwise(node);
+        }
+        return true;
+    }
+
+    //-------------------------------------------------------------------------
+
     void push_double(double value) {
         push(llvm::ConstantFP::get(builder.getDoubleTy(), value));
     }
@@ -621,7 +920,8 @@ LLVMWrapper::LLVMWrapper()
       _engine(),
       _functions(),
       _forests(),
-      _plugin_state()
+      _plugin_state(),
+      _vectorize(false)
 {
     std::lock_guard<std::recursive_mutex> guard(_global_llvm_lock);
     _context = std::make_unique<llvm::LLVMContext>();
@@ -632,13 +932,24 @@ LLVMWrapper::LLVMWrapper()
 size_t
 LLVMWrapper::make_function(size_t num_params, PassParams pass_params, const Node &root,
                            const gbdt::Optimize::Chain &forest_optimizers)
+{
+    assert(pass_params != PassParams::CELLS);
+    return make_function(num_params, pass_params, root, forest_optimizers, NodeTypes());
+}
+
+size_t
+LLVMWrapper::make_function(size_t num_params, PassParams pass_params, const Node &root,
+                           const gbdt::Optimize::Chain &forest_optimizers, const NodeTypes &types)
 {
     std::lock_guard<std::recursive_mutex> guard(_global_llvm_lock);
     size_t function_id = _functions.size();
     FunctionBuilder builder(*_context, *_module,
                             vespalib::make_string("f%zu", function_id),
                             num_params, pass_params,
-                            forest_optimizers, _forests, _plugin_state);
+                            forest_optimizers, _forests, _plugin_state, types);
+    if (pass_params == PassParams::CELLS) {
+        _vectorize = true;
+    }
     builder.build_root(root);
     _functions.push_back(builder.build());
     return function_id;
@@ -649,23 +960,52 @@ LLVMWrapper::make_forest_fragment(size_t num_params, const std::vector<const Nod
 {
     std::lock_guard<std::recursive_mutex> guard(_global_llvm_lock);
     size_t function_id = _functions.size();
+    NodeTypes no_types;
     FunctionBuilder builder(*_context, *_module,
                             vespalib::make_string("f%zu", function_id),
                             num_params, PassParams::ARRAY,
-                            gbdt::Optimize::none, _forests, _plugin_state);
+                            gbdt::Optimize::none, _forests, _plugin_state, no_types);
     builder.build_forest_fragment(fragment);
     _functions.push_back(builder.build());
     return function_id;
 }
 
+void
+LLVMWrapper::vectorize_module()
+{
+    // The code generated for tensor operations is straight-line code
+    // with one operation per cell. Run the SLP vectorizer (with
+    // information about the host cpu) to pack it into vector
+    // instructions.
+    std::unique_ptr<llvm::TargetMachine> target(llvm::EngineBuilder().setMCPU(llvm::sys::getHostCPUName()).selectTarget());
+    assert(target && "llvm target not available for your platform");
+    _module->setTargetTriple(target->getTargetTriple().str());
+    _module->setDataLayout(target->createDataLayout());
+    llvm::legacy::PassManager pass_manager;
+    pass_manager.add(llvm::createTargetTransformInfoWrapperPass(target->getTargetIRAnalysis()));
+    llvm::PassManagerBuilder pass_builder;
+    pass_builder.OptLevel = 3;
+    pass_builder.SLPVectorize = true;
+    pass_builder.populateModulePassManager(pass_manager);
+    pass_manager.run(*_module);
+}
+
 void
 LLVMWrapper::compile(bool dump_module)
 {
     std::lock_guard<std::recursive_mutex> guard(_global_llvm_lock);
+    if (_vectorize) {
+        vectorize_module();
+    }
     if (dump_module) {
         _module->dump();
     }
-    _engine.reset(llvm::EngineBuilder(std::move(_module)).setOptLevel(llvm::CodeGenOpt::Aggressive).create());
+    llvm::EngineBuilder engine_builder(std::move(_module));
+    engine_builder.setOptLevel(llvm::CodeGenOpt::Aggressive);
+    if (_vectorize) {
+        engine_builder.setMCPU(llvm::sys::getHostCPUName());
+    }
+    _engine.reset(engine_builder.create());
     assert(_engine && "llvm jit not available for your platform");
     _engine->finalizeObject();
 }
@@ -4,6 +4,7 @@
 
 #include <vespa/eval/eval/function.h>
 #include <vespa/eval/eval/gbdt.h>
+#include <vespa/eval/eval/node_types.h>
 
 #include <llvm/IR/LLVMContext.h>
 #include <llvm/IR/Module.h>
@@ -49,15 +50,20 @@ private:
     std::vector<llvm::Function*>           _functions;
     std::vector<gbdt::Forest::UP>          _forests;
     std::vector<PluginState::UP>           _plugin_state;
+    bool                                   _vectorize;
 
     static std::recursive_mutex _global_llvm_lock;
 
+    void vectorize_module();
+
 public:
     LLVMWrapper();
     LLVMWrapper(LLVMWrapper &&rhs) = default;
 
     size_t make_function(size_t num_params, PassParams pass_params, const nodes::Node &root,
                          const gbdt::Optimize::Chain &forest_optimizers);
+    size_t make_function(size_t num_params, PassParams pass_params, const nodes::Node &root,
+                         const gbdt::Optimize::Chain &forest_optimizers, const NodeTypes &types);
     size_t make_forest_fragment(size_t num_params, const std::vector<const nodes::Node *> &fragment);
     const std::vector<gbdt::Forest::UP> &get_forests() const { return _forests; }
     void compile(bool dump_module = false);
@@ -8,6 +8,7 @@
 #include "dense/dense_tensor.h"
 #include "dense/dense_tensor_builder.h"
 #include "dense/dense_dot_product_function.h"
+#include "dense/dense_fused_reduce_function.h"
 #include "dense/dense_xw_product_function.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/tensor_spec.h>
@@ -219,6 +220,7 @@ DefaultTensorEngine::optimize(const TensorFunction &expr, Stash &stash) const
         const Child &child = nodes.back();
         child.set(DenseDotProductFunction::optimize(child.get(), stash));
         child.set(DenseXWProductFunction::optimize(child.get(), stash));
+        child.set(DenseFusedReduceFunction::optimize(child.get(), stash));
         nodes.pop_back();
     }
     return root.get();
@@ -0,0 +1,224 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "dense_fused_reduce_function.h"
+#include "dense_tensor_view.h"
+#include <vespa/eval/eval/operation.h>
+#include <vespa/eval/eval/value.h>
+#include <algorithm>
+#include <cassert>
+#include <cstdlib>
+
+namespace vespalib::tensor {
+
+using CellsRef = DenseTensorView::CellsRef;
+using eval::ValueType;
+using eval::TensorFunction;
+using eval::as;
+using eval::Aggr;
+using eval::InterpretedFunction;
+using namespace eval::tensor_function;
+using namespace eval::operation;
+
+namespace {
+
+struct Params {
+    join_fun_t join;
+    map_fun_t map;
+    Params(join_fun_t join_in, map_fun_t map_in) : join(join_in), map(map_in) {}
+};
+
+// The common join operations are inlined into the cell loop, others
+// are called through the function pointer.
+
+struct CallJoin {
+    join_fun_t fun;
+    CallJoin(const Params &params) : fun(params.join) {}
+    double operator()(double a, double b) const { return fun(a, b); }
+};
+
+struct InlineMul {
+    InlineMul(const Params &) {}
+    double operator()(double a, double b) const { return (a * b); }
+};
+
+struct InlineAdd {
+    InlineAdd(const Params &) {}
+    double operator()(double a, double b) const { return (a + b); }
+};
+
+struct InlineSub {
+    InlineSub(const Params &) {}
+    double operator()(double a, double b) const { return (a - b); }
+};
+
+struct CallMap {
+    map_fun_t fun;
+    CallMap(const Params &params) : fun(params.map) {}
+    double operator()(double a) const { return fun(a); }
+};
+
+struct NoMap {
+    NoMap(const Params &) {}
+    double operator()(double a) const { return a; }
+};
+
+// Same semantics as the generic aggregators in eval/aggr.cpp
+
+struct AvgAggr {
+    double sum;
+    AvgAggr(double first) : sum(first) {}
+    void next(double value) { sum += value; }
+    double result(size_t cnt) const { return (sum / cnt); }
+};
+
+struct CountAggr {
+    CountAggr(double) {}
+    void next(double) {}
+    double result(size_t cnt) const { return cnt; }
+};
+
+struct ProdAggr {
+    double prod;
+    ProdAggr(double first) : prod(first) {}
+    void next(double value) { prod *= value; }
+    double result(size_t) const { return prod; }
+};
+
+struct SumAggr {
+    double sum;
+    SumAggr(double first) : sum(first) {}
+    void next(double value) { sum += value; }
+    double result(size_t) const { return sum; }
+};
+
+struct MaxAggr {
+    double max;
+    MaxAggr(double first) : max(first) {}
+    void next(double value) { max = std::max(max, value); }
+    double result(size_t) const { return max; }
+};
+
+struct MinAggr {
+    double min;
+    MinAggr(double first) : min(first) {}
+    void next(double value) { min = std::min(min, value); }
+    double result(size_t) const { return min; }
+};
+
+CellsRef getCellsRef(const eval::Value &value) {
+    const DenseTensorView &denseTensor = static_cast<const DenseTensorView &>(value);
+    return denseTensor.cellsRef();
+}
+
+template <typename JoinFun, typename MapFun, typename AggrFun>
+double fused_reduce(const double *lhs, const double *rhs, size_t numCells, const Params &params) {
+    if (numCells == 0) {
+        return 0.0;
+    }
+    JoinFun join(params);
+    MapFun map(params);
+    AggrFun aggr(map(join(lhs[0], rhs[0])));
+    for (size_t i = 1; i < numCells; ++i) {
+        aggr.next(map(join(lhs[i], rhs[i])));
+    }
+    return aggr.result(numCells);
+}
+
+template <typename JoinFun, typename MapFun, typename AggrFun>
+void my_op(InterpretedFunction::State &state, uint64_t param) {
+    const Params &params = *((const Params *)(param));
+    CellsRef lhsCells = getCellsRef(state.peek(1));
+    CellsRef rhsCells = getCellsRef(state.peek(0));
+    assert(lhsCells.size() == rhsCells.size());
+    double result = fused_reduce<JoinFun, MapFun, AggrFun>(lhsCells.cbegin(), rhsCells.cbegin(),
+                                                            lhsCells.size(), params);
+    state.pop_pop_push(state.stash.create<eval::DoubleValue>(result));
+}
+
+template <typename JoinFun, typename MapFun>
+InterpretedFunction::op_function select_aggr(Aggr aggr) {
+    switch (aggr) {
+    case Aggr::AVG:   return my_op<JoinFun, MapFun, AvgAggr>;
+    case Aggr::COUNT: return my_op<JoinFun, MapFun, CountAggr>;
+    case Aggr::PROD:  return my_op<JoinFun, MapFun, ProdAggr>;
+    case Aggr::SUM:   return my_op<JoinFun, MapFun, SumAggr>;
+    case Aggr::MAX:   return my_op<JoinFun, MapFun, MaxAggr>;
+    case Aggr::MIN:   return my_op<JoinFun, MapFun, MinAggr>;
+    }
+    abort();
+}
+
+template <typename JoinFun>
+InterpretedFunction::op_function select_map(map_fun_t map, Aggr aggr) {
+    if (map == nullptr) {
+        return select_aggr<JoinFun, NoMap>(aggr);
+    }
+    return select_aggr<JoinFun, CallMap>(aggr);
+}
+
+InterpretedFunction::op_function select_op(join_fun_t join, map_fun_t map, Aggr aggr) {
+    if (join == Mul::f) {
+        return select_map<InlineMul>(map, aggr);
+    } else if (join == Add::f) {
+        return select_map<InlineAdd>(map, aggr);
+    } else if (join == Sub::f) {
+        return select_map<InlineSub>(map, aggr);
+    }
+    return select_map<CallJoin>(map, aggr);
+}
+
+bool isConcreteDenseTensor(const ValueType &type) {
+    return (type.is_dense() && !type.is_abstract());
+}
+
+bool isDenseFusedReduce(const ValueType &res, const ValueType &lhsType, const ValueType &rhsType) {
+    return (res.is_double() &&
+            isConcreteDenseTensor(lhsType) &&
+            (lhsType == rhsType));
+}
+
+} // namespace vespalib::tensor::<unnamed>
+
+DenseFusedReduceFunction::DenseFusedReduceFunction(const eval::TensorFunction &lhs_in,
+                                                   const eval::TensorFunction &rhs_in,
+                                                   join_fun_t join_in,
+                                                   map_fun_t map_in,
+                                                   Aggr aggr_in)
+    : eval::tensor_function::Op2(eval::ValueType::double_type(), lhs_in, rhs_in),
+      _join(join_in),
+      _map(map_in),
+      _aggr(aggr_in)
+{
+}
+
+eval::InterpretedFunction::Instruction
+DenseFusedReduceFunction::compile_self(Stash &stash) const
+{
+    const Params &params = stash.create<Params>(_join, _map);
+    return eval::InterpretedFunction::Instruction(select_op(_join, _map, _aggr), (uint64_t)(&params));
+}
+
+const TensorFunction &
+DenseFusedReduceFunction::optimize(const eval::TensorFunction &expr, Stash &stash)
+{
+    const Reduce *reduce = as<Reduce>(expr);
+    if (reduce) {
+        map_fun_t mapFun = nullptr;
+        const TensorFunction *child = &reduce->child();
+        if (const Map *map = as<Map>(*child)) {
+            mapFun = map->function();
+            child = &map->child();
+        }
+        const Join *join = as<Join>(*child);
+        if (join) {
+            const TensorFunction &lhs = join->lhs();
+            const TensorFunction &rhs = join->rhs();
+            if (isDenseFusedReduce(expr.result_type(), lhs.result_type(), rhs.result_type())) {
+                return stash.create<DenseFusedReduceFunction>(lhs, rhs, join->function(), mapFun, reduce->aggr());
+            }
+        }
+    }
+    return expr;
+}
+
+} // namespace vespalib::tensor
@@ -0,0 +1,37 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/eval/eval/tensor_function.h>
+#include <vespa/eval/eval/aggr.h>
+
+namespace vespalib::tensor {
+
+/**
+ * Tensor function for a full reduce of a join (optionally followed
+ * by a map) between two dense tensors of the same type. All steps
+ * are done in a single pass over the cells, without creating the
+ * intermediate tensors. Example: reduce(map(a*b,f(x)(x*x)),sum).
+ */
+class DenseFusedReduceFunction : public eval::tensor_function::Op2
+{
+private:
+    eval::tensor_function::join_fun_t _join;
+    eval::tensor_function::map_fun_t  _map;
+    eval::Aggr                        _aggr;
+
+public:
+    DenseFusedReduceFunction(const eval::TensorFunction &lhs_in,
+                             const eval::TensorFunction &rhs_in,
+                             eval::tensor_function::join_fun_t join_in,
+                             eval::tensor_function::map_fun_t map_in,
+                             eval::Aggr aggr_in);
+    eval::tensor_function::join_fun_t join() const { return _join; }
+    eval::tensor_function::map_fun_t map() const { return _map; }
+    bool hasMap() const { return (_map != nullptr); }
+    eval::Aggr aggr() const { return _aggr; }
+    eval::InterpretedFunction::Instruction compile_self(Stash &stash) const override;
+    static const eval::TensorFunction &optimize(const eval::TensorFunction &expr, Stash &stash);
+};
+
+} // namespace vespalib::tensor
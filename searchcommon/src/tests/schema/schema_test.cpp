@@ -29,6 +29,7 @@ void assertIndexField(const Schema::IndexField & exp,
     EXPECT_EQUAL(exp.hasPrefix(), act.hasPrefix());
     EXPECT_EQUAL(exp.hasPhrases(), act.hasPhrases());
     EXPECT_EQUAL(exp.hasPositions(), act.hasPositions());
+    EXPECT_EQUAL(exp.hasBlockMaxWeights(), act.hasBlockMaxWeights());
 }
 
 void assertSet(const Schema::FieldSet &exp,
@@ -179,7 +180,8 @@ TEST("testLoadAndSave") {
         assertIndexField(SIF("a", SDT::STRING), s.getIndexField(0));
         assertIndexField(SIF("b", SDT::INT64), s.getIndexField(1));
         assertIndexField(SIF("c", SDT::STRING).setPrefix(true)
-                         .setPhrases(false).setPositions(false),
+                         .setPhrases(false).setPositions(false)
+                         .setBlockMaxWeights(true),
                          s.getIndexField(2));
 
         EXPECT_EQUAL(9u, s.getNumAttributeFields());
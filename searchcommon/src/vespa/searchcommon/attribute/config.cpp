@@ -9,6 +9,7 @@ Config::Config() :
     _type(CollectionType::SINGLE),
     _fastSearch(false),
     _huge(false),
+    _mmapLoad(false),
     _enableBitVectors(false),
     _enableOnlyBitVector(false),
     _isFilter(false),
@@ -28,6 +29,7 @@ Config::Config(BasicType bt,
       _type(ct),
       _fastSearch(fastSearch_),
       _huge(huge_),
+      _mmapLoad(false),
       _enableBitVectors(false),
       _enableOnlyBitVector(false),
       _isFilter(false),
@@ -26,6 +26,7 @@ public:
     CollectionType collectionType()       const { return _type; }
     bool fastSearch()                     const { return _fastSearch; }
     bool huge()                           const { return _huge; }
+    bool mmapLoad()                       const { return _mmapLoad; }
     const PredicateParams &predicateParams() const { return _predicateParams; }
     vespalib::eval::ValueType tensorType() const { return _tensorType; }
 
@@ -53,6 +54,11 @@ public:
     const CompactionStrategy &getCompactionStrategy() const { return _compactionStrategy; }
     void setHuge(bool v)                         { _huge = v; }
     void setFastSearch(bool v)                   { _fastSearch = v; }
+    /**
+     * Load single value numeric attributes by mapping the saved data
+     * copy on write instead of reading it into memory.
+     */
+    void setMMapLoad(bool v)                     { _mmapLoad = v; }
     void setPredicateParams(const PredicateParams &v) { _predicateParams = v; }
     void setTensorType(const vespalib::eval::ValueType &tensorType_in) {
         _tensorType = tensorType_in;
@@ -95,6 +101,7 @@ public:
                _type == b._type &&
                _huge == b._huge &&
                _fastSearch == b._fastSearch &&
+               _mmapLoad == b._mmapLoad &&
                _enableBitVectors == b._enableBitVectors &&
                _enableOnlyBitVector == b._enableOnlyBitVector &&
                _isFilter == b._isFilter &&
@@ -111,6 +118,7 @@ private:
     CollectionType _type;
     bool           _fastSearch;
     bool           _huge;
+    bool           _mmapLoad;
     bool           _enableBitVectors;
     bool           _enableOnlyBitVector;
     bool           _isFilter;
@@ -39,6 +39,20 @@ public:
     virtual std::unique_ptr<queryeval::SearchIterator>
     createIterator(fef::TermFieldMatchData *matchData, bool strict) = 0;
 
+    /**
+     * Creates a strict iterator evaluating the term by scanning the
+     * attribute values a block of documents at a time, instead of
+     * comparing one document per seek.
+     *
+     * @return attribute scan iterator, or an empty pointer if this
+     * search context cannot scan the attribute values
+     *
+     * @param matchData the attribute match data used when
+     * unpacking data for a hit
+     **/
+    virtual std::unique_ptr<queryeval::SearchIterator>
+    createScanIterator(fef::TermFieldMatchData *matchData) = 0;
+
     /*
      * Create temporary posting lists.
      * Should be called before createIterator() is called.
@@ -133,6 +133,7 @@ Schema::IndexField::IndexField(const vespalib::stringref &name, DataType dt)
       _prefix(false),
       _phrases(false),
       _positions(true),
+      _blockMaxWeights(false),
       _avgElemLen(512)
 {
 }
@@ -143,6 +144,7 @@ Schema::IndexField::IndexField(const vespalib::stringref &name, DataType dt,
       _prefix(false),
       _phrases(false),
       _positions(true),
+      _blockMaxWeights(false),
       _avgElemLen(512)
 {
 }
@@ -152,6 +154,7 @@ Schema::IndexField::IndexField(const std::vector<vespalib::string> &lines)
       _prefix(ConfigParser::parse<bool>("prefix", lines)),
       _phrases(ConfigParser::parse<bool>("phrases", lines)),
       _positions(ConfigParser::parse<bool>("positions", lines)),
+      _blockMaxWeights(ConfigParser::parse<bool>("blockmaxweights", lines, false)),
       _avgElemLen(ConfigParser::parse<int32_t>("averageelementlen", lines))
 {
 }
@@ -163,6 +166,7 @@ Schema::IndexField::write(vespalib::asciistream & os, const vespalib::stringref
     os << prefix << "prefix " << (_prefix ? "true" : "false") << "\n";
     os << prefix << "phrases " << (_phrases ? "true" : "false") << "\n";
     os << prefix << "positions " << (_positions ? "true" : "false") << "\n";
+    os << prefix << "blockmaxweights " << (_blockMaxWeights ? "true" : "false") << "\n";
     os << prefix << "averageelementlen " << static_cast<int32_t>(_avgElemLen) << "\n";
 }
 
@@ -173,6 +177,7 @@ Schema::IndexField::operator==(const IndexField &rhs) const
                   _prefix == rhs._prefix &&
                  _phrases == rhs._phrases &&
                _positions == rhs._positions &&
+         _blockMaxWeights == rhs._blockMaxWeights &&
               _avgElemLen == rhs._avgElemLen;
 }
 
@@ -183,6 +188,7 @@ Schema::IndexField::operator!=(const IndexField &rhs) const
                   _prefix != rhs._prefix ||
                  _phrases != rhs._phrases ||
                _positions != rhs._positions ||
+         _blockMaxWeights != rhs._blockMaxWeights ||
               _avgElemLen != rhs._avgElemLen;
 }
 
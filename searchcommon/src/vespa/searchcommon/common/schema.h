@@ -81,6 +81,7 @@ public:
         bool _prefix;
         bool _phrases;
         bool _positions;
+        bool _blockMaxWeights;
         uint32_t _avgElemLen;
 
     public:
@@ -95,6 +96,8 @@ public:
         IndexField &setPhrases(bool value) { _phrases = value; return *this; }
         IndexField &setPositions(bool value)
         { _positions = value; return *this; }
+        IndexField &setBlockMaxWeights(bool value)
+        { _blockMaxWeights = value; return *this; }
         IndexField &setAvgElemLen(uint32_t avgElemLen)
         { _avgElemLen = avgElemLen; return *this; }
 
@@ -105,6 +108,7 @@ public:
         bool hasPrefix() const { return _prefix; }
         bool hasPhrases() const { return _phrases; }
         bool hasPositions() const { return _positions; }
+        bool hasBlockMaxWeights() const { return _blockMaxWeights; }
         uint32_t getAvgElemLen() const { return _avgElemLen; }
 
         bool operator==(const IndexField &rhs) const;
@@ -149,6 +149,7 @@ SchemaBuilder::build(const IndexschemaConfig &cfg, Schema &schema)
                                  setPrefix(f.prefix).
                                  setPhrases(f.phrases).
                                  setPositions(f.positions).
+                                 setBlockMaxWeights(f.blockmaxweights).
                                  setAvgElemLen(f.averageelementlen));
         }
     }
@@ -9,8 +9,10 @@
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchcore/grouping/groupingmanager.h>
 #include <vespa/searchcore/grouping/groupingsession.h>
+#include <vespa/searchcore/grouping/partitionedgroupingmerger.h>
 #include <vespa/searchcore/proton/matching/sessionmanager.h>
 #include <iostream>
+#include <thread>
 
 using namespace search::attribute;
 using namespace search::aggregation;
@@ -508,6 +510,57 @@ TEST_F("test grouping fork/join", DoomFixture()) {
     EXPECT_EQUAL(expect.asString(), list[0]->asString());
 }
 
+vespalib::string
+forkJoin(const DoomFixture &f, MyWorld &world, int64_t maxGroups, bool partitioned)
+{
+    Grouping request;
+    request.setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("attr0"))))
+           .addLevel(createGL(maxGroups, MU<AttributeNode>("attr0")))
+           .setFirstLevel(0)
+           .setLastLevel(1);
+
+    GroupingContext context(f.clock, f.timeOfDoom);
+    context.addGrouping(std::make_shared<Grouping>(request));
+    GroupingSession session(SessionId(), context, world.attributeContext);
+    session.prepareThreadContextCreation(3);
+
+    std::vector<GroupingContext::UP> ctx;
+    for (size_t i = 0; i < 3; ++i) {
+        ctx.push_back(session.createThreadContext(i, world.attributeContext));
+    }
+    doGrouping(*ctx[0], 12, 30.0, 11, 20.0, 10, 10.0);
+    doGrouping(*ctx[1], 22, 150.0, 21, 40.0, 12, 25.0);
+    doGrouping(*ctx[2], 32, 100.0, 22, 15.0, 10, 5.0);
+    if (partitioned) {
+        PartitionedGroupingMerger merger(3);
+        std::vector<std::thread> threads;
+        for (size_t i = 1; i < 3; ++i) {
+            threads.emplace_back([&merger, &ctx, i]() { merger.merge(i, ctx[i].get()); });
+        }
+        merger.merge(0, ctx[0].get());
+        for (auto &thread : threads) {
+            thread.join();
+        }
+    } else {
+        GroupingManager man(*ctx[0]);
+        man.merge(*ctx[1]);
+        man.merge(*ctx[2]);
+    }
+    GroupingManager(*ctx[0]).prune();
+    session.continueExecution(context);
+    GroupingContext::GroupingList list = context.getGroupingList();
+    ASSERT_TRUE(list.size() == 1);
+    return list[0]->asString();
+}
+
+TEST_F("test partitioned grouping fork/join", DoomFixture()) {
+    MyWorld world;
+    world.basicSetup();
+    for (int64_t maxGroups : {1, 3, 5, -1}) {
+        EXPECT_EQUAL(forkJoin(f1, world, maxGroups, false), forkJoin(f1, world, maxGroups, true));
+    }
+}
+
 TEST_F("test session timeout", DoomFixture()) {
     MyWorld world;
     world.basicSetup();
@@ -0,0 +1,117 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchcore/grouping/groupingcontext.h>
+#include <vespa/searchcore/grouping/groupingmanager.h>
+#include <vespa/searchcore/grouping/partitionedgroupingmerger.h>
+#include <vespa/searchlib/aggregation/grouping.h>
+#include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/vespalib/util/clock.h>
+#include <vespa/vespalib/util/dual_merge_director.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <thread>
+
+using namespace search::aggregation;
+using namespace search::expression;
+using namespace search::grouping;
+
+const uint32_t numGroupsPerThread = 200000;
+const int64_t maxGroups = 100;
+
+/**
+ * Grouping contexts as merge sources, like the match threads use them.
+ **/
+struct ContextSource : vespalib::DualMergeDirector::Source {
+    GroupingContext &ctx;
+    ContextSource(GroupingContext &ctx_in) : ctx(ctx_in) {}
+    void merge(Source &rhs) override {
+        GroupingManager man(ctx);
+        man.merge(static_cast<ContextSource &>(rhs).ctx);
+    }
+};
+
+struct NoSource : vespalib::DualMergeDirector::Source {
+    void merge(Source &) override {}
+};
+
+/**
+ * Create the grouping result of a single thread; numGroupsPerThread
+ * top level groups with ids drawn from the given cardinality.
+ **/
+GroupingContext::UP
+makeContext(const vespalib::Clock &clock, uint32_t thread_id, uint32_t cardinality)
+{
+    std::mt19937 rng(thread_id);
+    std::vector<int64_t> ids;
+    for (uint32_t i = 0; i < numGroupsPerThread; ++i) {
+        ids.push_back(rng() % cardinality);
+    }
+    std::sort(ids.begin(), ids.end());
+    ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+    GroupingLevel level;
+    level.setMaxGroups(maxGroups).setExpression(std::make_unique<AttributeNode>("attr"));
+    auto grouping = std::make_shared<Grouping>();
+    grouping->addLevel(std::move(level)).setFirstLevel(0).setLastLevel(1);
+    for (int64_t id : ids) {
+        auto group = std::make_unique<Group>();
+        group->setId(Int64ResultNode(id)).setRank(RawRank(rng()));
+        grouping->root().addChild(std::move(group));
+    }
+    auto ctx = std::make_unique<GroupingContext>(clock, fastos::TimeStamp::FUTURE);
+    ctx->addGrouping(grouping);
+    return ctx;
+}
+
+double
+merge(uint32_t numThreads, uint32_t cardinality, bool partitioned)
+{
+    vespalib::Clock clock;
+    std::vector<GroupingContext::UP> contexts;
+    for (uint32_t i = 0; i < numThreads; ++i) {
+        contexts.push_back(makeContext(clock, i, cardinality));
+    }
+    // sources must outlive the merge, not only the dualMerge call
+    std::vector<ContextSource> sources;
+    std::vector<NoSource> noSources(numThreads);
+    for (uint32_t i = 0; i < numThreads; ++i) {
+        sources.emplace_back(*contexts[i]);
+    }
+    vespalib::DualMergeDirector director(numThreads);
+    PartitionedGroupingMerger merger(numThreads);
+    auto mergeThread = [&](uint32_t thread_id) {
+        if (partitioned) {
+            merger.merge(thread_id, contexts[thread_id].get());
+        } else {
+            director.dualMerge(thread_id, sources[thread_id], noSources[thread_id]);
+        }
+    };
+    auto before = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < numThreads; ++i) {
+        threads.emplace_back(mergeThread, i);
+    }
+    mergeThread(0);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    GroupingManager(*contexts[0]).prune();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - before;
+    EXPECT_EQUAL((size_t)maxGroups, contexts[0]->getGroupingList()[0]->getRoot().getChildrenSize());
+    return elapsed.count();
+}
+
+TEST("benchmark pairwise and partitioned merge of groupings with many unique groups") {
+    fprintf(stderr, "merging %u top level groups per thread, keeping %" PRId64 "\n", numGroupsPerThread, maxGroups);
+    for (uint32_t cardinality : {numGroupsPerThread, numGroupsPerThread * 10}) {
+        for (uint32_t threads : {2, 4, 8, 16}) {
+            double pairwise = merge(threads, cardinality, false);
+            double partitioned = merge(threads, cardinality, true);
+            fprintf(stderr, "cardinality: %8u, threads: %2u, pairwise: %8.2f ms, partitioned: %8.2f ms\n",
+                    cardinality, threads, pairwise * 1000.0, partitioned * 1000.0);
+        }
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -40,6 +40,7 @@ LOG_SETUP("attribute_test");
 #include <vespa/searchlib/test/directory_handler.h>
 #include <vespa/searchlib/util/filekit.h>
 #include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/test/insertion_operators.h>
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchcommon/attribute/iattributevector.h>
@@ -120,9 +121,10 @@ struct Fixture
     SequencedTaskExecutorObserver _attributeFieldWriter;
     HwInfo                   _hwInfo;
     proton::AttributeManager::SP _m;
+    uint32_t                 _batchSize;
     std::unique_ptr<AttributeWriter> _aw;
 
-    Fixture(uint32_t threads)
+    Fixture(uint32_t threads, uint32_t batchSize)
         : _dirHandler(test_dir),
           _fileHeaderContext(),
           _attributeFieldWriterReal(threads),
@@ -131,16 +133,21 @@ struct Fixture
           _m(std::make_shared<proton::AttributeManager>
              (test_dir, "test.subdb", TuneFileAttributes(),
               _fileHeaderContext, _attributeFieldWriter, _hwInfo)),
+          _batchSize(batchSize),
           _aw()
     {
         allocAttributeWriter();
     }
+    Fixture(uint32_t threads)
+        : Fixture(threads, 1)
+    {
+    }
     Fixture()
         : Fixture(1)
     {
     }
     void allocAttributeWriter() {
-        _aw = std::make_unique<AttributeWriter>(_m);
+        _aw = std::make_unique<AttributeWriter>(_m, _batchSize);
     }
     AttributeVector::SP addAttribute(const vespalib::string &name) {
         return addAttribute({name, AVConfig(AVBasicType::INT32)}, createSerialNum);
@@ -743,6 +750,127 @@ TEST_F("require that attribute writer spreads write over 3 write contexts", Fixt
     TEST_DO(putAttributes(f, {0, 1, 2}));
 }
 
+namespace {
+
+Document::UP
+createIntDoc(DocBuilder &idb, uint32_t lid, int64_t a1Value, int64_t a2Value)
+{
+    return idb.startDocument(vespalib::make_string("doc::%u", lid)).
+        startAttributeField("a1").addInt(a1Value).endField().
+        startAttributeField("a2").addInt(a2Value).endField().
+        endDocument();
+}
+
+void
+assertIntValue(AttributeVector &attr, uint32_t lid, int64_t expVal)
+{
+    attribute::IntegerContent ibuf;
+    ibuf.fill(attr, lid);
+    EXPECT_EQUAL(1u, ibuf.size());
+    EXPECT_EQUAL(expVal, ibuf[0]);
+}
+
+Schema
+createIntSchema()
+{
+    Schema s;
+    s.addAttributeField(Schema::AttributeField("a1", schema::DataType::INT32, CollectionType::SINGLE));
+    s.addAttributeField(Schema::AttributeField("a2", schema::DataType::INT32, CollectionType::SINGLE));
+    return s;
+}
+
+}
+
+TEST_F("require that batched puts are applied as one task per write context when batch is full", Fixture(2, 3))
+{
+    AttributeVector::SP a1 = f.addAttribute("a1");
+    AttributeVector::SP a2 = f.addAttribute("a2");
+    DocBuilder idb(createIntSchema());
+    f.put(1, *createIntDoc(idb, 1, 10, 20), 1, false);
+    f.put(2, *createIntDoc(idb, 2, 11, 21), 2, false);
+    TEST_DO(f.assertExecuteHistory({}));
+    EXPECT_EQUAL(1u, a1->getNumDocs());
+    f.put(3, *createIntDoc(idb, 3, 12, 22), 3, false);
+    TEST_DO(f.assertExecuteHistory({0, 1}));
+    EXPECT_EQUAL(4u, a1->getNumDocs());
+    EXPECT_EQUAL(4u, a2->getNumDocs());
+    EXPECT_EQUAL(0u, a1->getStatus().getLastSyncToken());
+    f.commit(3);
+    EXPECT_EQUAL(3u, a1->getStatus().getLastSyncToken());
+    EXPECT_EQUAL(3u, a2->getStatus().getLastSyncToken());
+    TEST_DO(assertIntValue(*a1, 1, 10));
+    TEST_DO(assertIntValue(*a1, 3, 12));
+    TEST_DO(assertIntValue(*a2, 2, 21));
+    TEST_DO(assertIntValue(*a2, 3, 22));
+}
+
+TEST_F("require that immediate commit ends the batch with one commit", Fixture(1, 100))
+{
+    AttributeVector::SP a1 = f.addAttribute("a1");
+    AttributeVector::SP a2 = f.addAttribute("a2");
+    DocBuilder idb(createIntSchema());
+    f.put(1, *createIntDoc(idb, 1, 10, 20), 1, false);
+    f.put(2, *createIntDoc(idb, 2, 11, 21), 2, true);
+    TEST_DO(f.assertExecuteHistory({0}));
+    EXPECT_EQUAL(2u, a1->getStatus().getLastSyncToken());
+    EXPECT_EQUAL(2u, a2->getStatus().getLastSyncToken());
+    TEST_DO(assertIntValue(*a1, 1, 10));
+    TEST_DO(assertIntValue(*a2, 2, 21));
+}
+
+TEST_F("require that batched updates and puts are applied in feed order", Fixture(1, 100))
+{
+    AttributeVector::SP a1 = f.addAttribute("a1");
+    AttributeVector::SP a2 = f.addAttribute("a2");
+    DocBuilder idb(createIntSchema());
+    DocumentUpdate upd(idb.getDocumentType(), DocumentId("doc::1"));
+    upd.addUpdate(FieldUpdate(upd.getType().getField("a1"))
+                  .addUpdate(ArithmeticValueUpdate(ArithmeticValueUpdate::Add, 5)));
+    f.put(1, *createIntDoc(idb, 1, 10, 20), 1, false);
+    f.update(2, upd, 1, false);
+    f.put(3, *createIntDoc(idb, 2, 11, 21), 2, false);
+    TEST_DO(f.assertExecuteHistory({}));
+    f.remove(4, 2, true);
+    TEST_DO(f.assertExecuteHistory({0, 0}));
+    EXPECT_EQUAL(4u, a1->getStatus().getLastSyncToken());
+    TEST_DO(assertIntValue(*a1, 1, 15));
+    TEST_DO(assertIntValue(*a2, 1, 20));
+    EXPECT_TRUE(search::attribute::isUndefined<int32_t>(a1->getInt(2)));
+}
+
+TEST_F("require that batched puts skip operations already applied to an attribute", Fixture(1, 100))
+{
+    AttributeVector::SP a1 = f.addAttribute("a1");
+    AttributeVector::SP a2 = f.addAttribute("a2");
+    fillAttribute(a1, 1, 10, 3);
+    fillAttribute(a2, 1, 20, 1);
+    DocBuilder idb(createIntSchema());
+    f.put(2, *createIntDoc(idb, 1, 11, 21), 1, false);
+    f.put(3, *createIntDoc(idb, 1, 12, 22), 1, false);
+    f.commit(3);
+    TEST_DO(assertIntValue(*a1, 1, 10));
+    TEST_DO(assertIntValue(*a2, 1, 22));
+    EXPECT_EQUAL(3u, a1->getStatus().getLastSyncToken());
+    EXPECT_EQUAL(3u, a2->getStatus().getLastSyncToken());
+}
+
+TEST_F("require that pending batches can be flushed without commit", Fixture(1, 100))
+{
+    AttributeVector::SP a1 = f.addAttribute("a1");
+    DocBuilder idb(createIntSchema());
+    EXPECT_FALSE(f._aw->hasPendingBatches());
+    f.put(1, *createIntDoc(idb, 1, 10, 20), 1, false);
+    EXPECT_TRUE(f._aw->hasPendingBatches());
+    TEST_DO(f.assertExecuteHistory({}));
+    f._aw->flushPendingBatches();
+    EXPECT_FALSE(f._aw->hasPendingBatches());
+    TEST_DO(f.assertExecuteHistory({0}));
+    EXPECT_EQUAL(0u, a1->getStatus().getLastSyncToken());
+    f.commit(1);
+    EXPECT_EQUAL(1u, a1->getStatus().getLastSyncToken());
+    TEST_DO(assertIntValue(*a1, 1, 10));
+}
+
 ImportedAttributeVector::SP
 createImportedAttribute(const vespalib::string &name)
 {
@@ -0,0 +1,119 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/log/log.h>
+LOG_SETUP("attribute_writer_feed_bench");
+
+#include <vespa/document/fieldvalue/document.h>
+#include <vespa/searchcore/proton/attribute/attribute_writer.h>
+#include <vespa/searchcore/proton/attribute/attributemanager.h>
+#include <vespa/searchcore/proton/common/hw_info.h>
+#include <vespa/searchlib/common/adaptivesequencedtaskexecutor.h>
+#include <vespa/searchlib/common/idestructorcallback.h>
+#include <vespa/searchlib/common/sequencedtaskexecutor.h>
+#include <vespa/searchlib/index/docbuilder.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/test/directory_handler.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <chrono>
+
+using namespace document;
+using namespace proton;
+using namespace search::index;
+using namespace search;
+
+using search::index::DummyFileHeaderContext;
+using search::index::schema::CollectionType;
+using search::test::DirectoryHandler;
+
+using AVConfig = search::attribute::Config;
+using AVBasicType = search::attribute::BasicType;
+using AVCollectionType = search::attribute::CollectionType;
+
+const vespalib::string test_dir = "test_output";
+const uint64_t createSerialNum = 42u;
+const uint32_t numDocs = 20000;
+const uint32_t commitInterval = 100;
+const uint32_t numColdAttributes = 15;
+const uint32_t hotElements = 64;
+const std::shared_ptr<IDestructorCallback> emptyCallback;
+
+vespalib::string
+coldName(uint32_t i)
+{
+    return vespalib::make_string("cold%u", i);
+}
+
+/**
+ * One expensive string array attribute and a set of cheap integer
+ * attributes. With a thread pinned executor the cheap attributes that
+ * share a thread with the expensive one wait for it.
+ */
+struct FeedData {
+    Schema docSchema;
+    std::vector<Document::UP> docs;
+    FeedData() : docSchema(), docs() {
+        docSchema.addAttributeField(Schema::AttributeField("hot", schema::DataType::STRING, CollectionType::ARRAY));
+        for (uint32_t i = 0; i < numColdAttributes; ++i) {
+            docSchema.addAttributeField(Schema::AttributeField(coldName(i), schema::DataType::INT32,
+                                                               CollectionType::SINGLE));
+        }
+        DocBuilder builder(docSchema);
+        for (uint32_t lid = 1; lid <= numDocs; ++lid) {
+            builder.startDocument(vespalib::make_string("doc::%u", lid));
+            builder.startAttributeField("hot");
+            for (uint32_t e = 0; e < hotElements; ++e) {
+                builder.startElement().addStr(vespalib::make_string("v%u", (lid * 31 + e) % 5000)).endElement();
+            }
+            builder.endField();
+            for (uint32_t i = 0; i < numColdAttributes; ++i) {
+                builder.startAttributeField(coldName(i)).addInt(lid + i).endField();
+            }
+            docs.push_back(builder.endDocument());
+        }
+    }
+};
+
+double
+feed(const FeedData &data, ISequencedTaskExecutor &executor)
+{
+    DirectoryHandler dirHandler(test_dir);
+    DummyFileHeaderContext fileHeaderContext;
+    HwInfo hwInfo;
+    auto manager = std::make_shared<proton::AttributeManager>(test_dir, "test.subdb", TuneFileAttributes(),
+                                                              fileHeaderContext, executor, hwInfo);
+    manager->addAttribute({"hot", AVConfig(AVBasicType::STRING, AVCollectionType::ARRAY)}, createSerialNum);
+    for (uint32_t i = 0; i < numColdAttributes; ++i) {
+        manager->addAttribute({coldName(i), AVConfig(AVBasicType::INT32)}, createSerialNum);
+    }
+    AttributeWriter writer(manager);
+    auto before = std::chrono::steady_clock::now();
+    SerialNum serialNum = createSerialNum;
+    for (uint32_t lid = 1; lid <= numDocs; ++lid) {
+        ++serialNum;
+        writer.put(serialNum, *data.docs[lid - 1], lid, (lid % commitInterval) == 0, emptyCallback);
+    }
+    writer.forceCommit(serialNum, emptyCallback);
+    executor.sync();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - before;
+    return elapsed.count();
+}
+
+TEST_F("benchmark feed through attribute writer with both sequenced executors", FeedData) {
+    fprintf(stderr, "feeding %u documents with 1 hot and %u cold attributes\n", numDocs, numColdAttributes);
+    for (uint32_t threads : {1, 2, 4, 8, 16, 32}) {
+        double pinned;
+        double adaptive;
+        {
+            SequencedTaskExecutor executor(threads);
+            pinned = feed(f, executor);
+        }
+        {
+            AdaptiveSequencedTaskExecutor executor(threads);
+            adaptive = feed(f, executor);
+        }
+        fprintf(stderr, "threads: %2u, SequencedTaskExecutor: %8.0f docs/s, AdaptiveSequencedTaskExecutor: %8.0f docs/s\n",
+                threads, numDocs / pinned, numDocs / adaptive);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -311,6 +311,9 @@ struct MyAttributeWriter : public IAttributeWriter
     int _heartBeatCount;
     uint32_t _commitCount;
     uint32_t _wantedLidLimit;
+    bool _batching;
+    bool _pendingBatches;
+    uint32_t _flushPendingBatchesCount;
     using AttrMap = std::map<vespalib::string, std::shared_ptr<AttributeVector>>;
     AttrMap _attrMap;
     std::set<vespalib::string> _attrs;
@@ -338,6 +341,7 @@ struct MyAttributeWriter : public IAttributeWriter
         if (immediateCommit) {
             ++_commitCount;
         }
+        _pendingBatches = _batching && !immediateCommit;
     }
     virtual void remove(SerialNum serialNum, DocumentIdT lid,
                         bool immediateCommit, OnWriteDoneType) override {
@@ -372,8 +376,14 @@ struct MyAttributeWriter : public IAttributeWriter
     }
     void forceCommit(SerialNum serialNum, OnWriteDoneType) override {
         (void) serialNum; ++_commitCount;
+        _pendingBatches = false;
         _tracer.traceCommit(attributeAdapterTypeName, serialNum);
     }
+    bool hasPendingBatches() const override { return _pendingBatches; }
+    void flushPendingBatches() override {
+        _pendingBatches = false;
+        ++_flushPendingBatchesCount;
+    }
 
     virtual void onReplayDone(uint32_t docIdLimit) override
     {
@@ -386,6 +396,7 @@ MyAttributeWriter::MyAttributeWriter(MyTracer &tracer)
       _updateSerial(0), _updateDocId(), _updateLid(0),
       _removeSerial(0), _removeLid(0), _heartBeatCount(0),
       _commitCount(0), _wantedLidLimit(0),
+      _batching(false), _pendingBatches(false), _flushPendingBatchesCount(0),
       _attrMap(), _attrs(), _mgr(), _tracer(tracer)
 {
     search::attribute::Config cfg(search::attribute::BasicType::INT32);
@@ -1275,6 +1286,22 @@ TEST_F("require that forceCommit updates docid limit",
                   "commit(adapter=index,serialNum=1)");
 }
 
+TEST_F("require that pending attribute batches are flushed when feed window ends",
+       SearchableFeedViewFixture(LONG_DELAY))
+{
+    f._commitTimeTracker.setReplayDone();
+    f.maw._batching = true;
+    f.putAndWait(f.doc("doc:test:1", 10));
+    f.syncMaster();
+    EXPECT_EQUAL(1u, f.maw._flushPendingBatchesCount);
+    EXPECT_FALSE(f.maw._pendingBatches);
+    EXPECT_EQUAL(0u, f.maw._commitCount);
+    f.maw._batching = false;
+    f.putAndWait(f.doc("doc:test:2", 20));
+    f.syncMaster();
+    EXPECT_EQUAL(1u, f.maw._flushPendingBatchesCount);
+}
+
 TEST_F("require that forceCommit updates docid limit during shrink", SearchableFeedViewFixture(LONG_DELAY))
 {
     f._commitTimeTracker.setReplayDone();
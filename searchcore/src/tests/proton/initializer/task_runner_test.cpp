@@ -4,12 +4,14 @@ LOG_SETUP("task_runner_test");
 #include <vespa/vespalib/testkit/testapp.h>
 #include <vespa/searchcore/proton/initializer/initializer_task.h>
 #include <vespa/searchcore/proton/initializer/task_runner.h>
+#include <vespa/searchcore/proton/initializer/task_timings.h>
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/stllike/string.h>
 #include <mutex>
 
 using proton::initializer::InitializerTask;
 using proton::initializer::TaskRunner;
+using proton::initializer::TaskTimings;
 
 struct TestLog
 {
@@ -44,6 +46,7 @@ public:
     }
 
     virtual void run() override { _log.append(_name); }
+    vespalib::string getName() const override { return _name; }
 };
 
 
@@ -138,6 +141,26 @@ TEST_F("multiple threads, dag graph", Fixture(10))
     LOG(info, "dabc=%d, dbac=%d", dabc_count, dbac_count);
 }
 
+TEST_F("timings are reported for named tasks", Fixture(10))
+{
+    TestJob job = TestJob::setupDiamond();
+    f.run(job._root);
+    TaskTimings timings(*job._root);
+    const auto &list = timings.getTimings();
+    ASSERT_EQUAL(4u, list.size());
+    std::vector<vespalib::string> names;
+    for (const auto &timing : list) {
+        names.push_back(timing.name);
+        EXPECT_LESS_EQUAL(0, timing.startMs);
+        EXPECT_LESS_EQUAL(timing.startMs + timing.durationMs, timings.getWallTimeMs());
+    }
+    // Sorted on start time, D is reported below the first depender found.
+    EXPECT_EQUAL("C.A.D", names[0]);
+    EXPECT_EQUAL("C", names[3]);
+    std::sort(names.begin(), names.end());
+    EXPECT_EQUAL((std::vector<vespalib::string>{"C", "C.A", "C.A.D", "C.B"}), names);
+}
+
 TEST_MAIN()
 {
     TEST_RUN_ALL();
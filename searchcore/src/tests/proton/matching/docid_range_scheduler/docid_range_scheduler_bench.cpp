@@ -5,6 +5,7 @@
 #include <vespa/vespalib/util/rendezvous.h>
 #include <vespa/vespalib/util/benchmark_timer.h>
 #include <vespa/vespalib/util/stringfmt.h>
+#include <chrono>
 
 using namespace proton::matching;
 using namespace vespalib;
@@ -138,6 +139,21 @@ struct AdaptiveSchedulerFactory : public SchedulerFactory {
     }
 };
 
+struct WorkStealingSchedulerFactory : public SchedulerFactory {
+    size_t num_threads;
+    size_t min_task;
+    size_t target_us;
+    WorkStealingSchedulerFactory(size_t num_threads_in, size_t min_task_in, size_t target_us_in)
+        : num_threads(num_threads_in), min_task(min_task_in), target_us(target_us_in) {}
+    vespalib::string desc() const override {
+        return make_string("work-stealing(threads:%zu,min_task:%zu,target:%zuus)", num_threads, min_task, target_us);
+    }
+    DocidRangeScheduler::UP create(uint32_t docid_limit) const override {
+        return std::make_unique<WorkStealingDocidRangeScheduler>(num_threads, min_task, docid_limit,
+                                                                 std::chrono::microseconds(target_us));
+    }
+};
+
 struct SchedulerList {
     std::vector<SchedulerFactory::UP> factory_list;
     SchedulerList(size_t num_threads) : factory_list() {
@@ -151,6 +167,10 @@ struct SchedulerList {
         factory_list.push_back(std::make_unique<AdaptiveSchedulerFactory>(num_threads, 100));
         factory_list.push_back(std::make_unique<AdaptiveSchedulerFactory>(num_threads, 10));
         factory_list.push_back(std::make_unique<AdaptiveSchedulerFactory>(num_threads, 1));
+        factory_list.push_back(std::make_unique<WorkStealingSchedulerFactory>(num_threads, 1, 0));
+        factory_list.push_back(std::make_unique<WorkStealingSchedulerFactory>(num_threads, 1, 100));
+        factory_list.push_back(std::make_unique<WorkStealingSchedulerFactory>(num_threads, 1, 1000));
+        factory_list.push_back(std::make_unique<WorkStealingSchedulerFactory>(num_threads, 10, 1000));
     }
 };
 
@@ -158,6 +178,7 @@ struct SchedulerList {
 
 struct WorkTracker {
     std::vector<DocidRange> ranges;
+    double busy_s = 0.0;
     void track(size_t docid) {
         if (!ranges.empty() && (docid == ranges.back().end)) {
             ++ranges.back().end;
@@ -168,6 +189,9 @@ struct WorkTracker {
 };
 
 void worker(DocidRangeScheduler &scheduler, const Work &work, size_t thread_id, WorkTracker &tracker) {
+    // time spent waiting for the scheduler at the end counts as idle
+    auto start = std::chrono::steady_clock::now();
+    auto done = start;
     IdleObserver observer = scheduler.make_idle_observer();
     if (observer.is_always_zero()) {
         for (DocidRange range = scheduler.first_range(thread_id);
@@ -179,6 +203,7 @@ void worker(DocidRangeScheduler &scheduler, const Work &work, size_t thread_id,
                 work.perform(docid);
                 tracker.track(docid);
             }
+            done = std::chrono::steady_clock::now();
         }
     } else {
         for (DocidRange range = scheduler.first_range(thread_id);
@@ -193,8 +218,10 @@ void worker(DocidRangeScheduler &scheduler, const Work &work, size_t thread_id,
                     range = scheduler.share_range(thread_id, DocidRange(docid, range.end));
                 }
             }
+            done = std::chrono::steady_clock::now();
         }
     }
+    tracker.busy_s = std::chrono::duration<double>(done - start).count();
 }
 
 //-----------------------------------------------------------------------------
@@ -229,11 +256,39 @@ struct RangeChecker : vespalib::Rendezvous<WorkTracker,bool> {
     }
 };
 
+/**
+ * Collects the busy time of each thread across several runs and
+ * reports the skew (busiest thread relative to the average) and the
+ * utilisation of each thread relative to the total wall time.
+ **/
+struct UtilisationTracker {
+    std::vector<double> busy_s;
+    double wall_s;
+    UtilisationTracker(size_t num_threads) : busy_s(num_threads, 0.0), wall_s(0.0) {}
+    void reset() {
+        std::fill(busy_s.begin(), busy_s.end(), 0.0);
+        wall_s = 0.0;
+    }
+    vespalib::string report() const {
+        double sum = 0.0;
+        double max = 0.0;
+        vespalib::string utilisation;
+        for (double busy: busy_s) {
+            sum += busy;
+            max = std::max(max, busy);
+            utilisation.append(make_string("%s%.2f", utilisation.empty() ? "" : ",",
+                                           (wall_s > 0.0) ? (busy / wall_s) : 0.0));
+        }
+        double skew = (sum > 0.0) ? (max / (sum / busy_s.size())) : 1.0;
+        return make_string("skew: %.2f, utilisation: [%s]", skew, utilisation.c_str());
+    }
+};
+
 const size_t my_docid_limit = 100001;
 
-TEST_MT_FFFF("benchmark different combinations of schedulers and work loads", 8,
-             DocidRangeScheduler::UP(), SchedulerList(num_threads), WorkList(),
-             RangeChecker(num_threads, my_docid_limit))
+TEST_MT_FFFFF("benchmark different combinations of schedulers and work loads", 8,
+              DocidRangeScheduler::UP(), SchedulerList(num_threads), WorkList(),
+              RangeChecker(num_threads, my_docid_limit), UtilisationTracker(num_threads))
 {
     if (thread_id == 0) {
         fprintf(stderr, "Benchmarking with %zu threads:\n", num_threads);
@@ -253,17 +308,21 @@ TEST_MT_FFFF("benchmark different combinations of schedulers and work loads", 8,
                     f1 = f2.factory_list[scheduler]->create(my_docid_limit);
                 }
                 TEST_BARRIER();
+                auto start = std::chrono::steady_clock::now();
                 timer.before();
                 worker(*f1, *f3.work_list[work], thread_id, tracker);
                 TEST_BARRIER();
                 timer.after();
+                f5.busy_s[thread_id] += tracker.busy_s;
                 if (thread_id == 0) {
+                    f5.wall_s += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
                     fprintf(stderr, ".");
                 }
                 EXPECT_TRUE(f4.rendezvous(tracker));
             }
             if (thread_id == 0) {
-                fprintf(stderr, " real time: %g ms\n", timer.min_time() * 1000.0);
+                fprintf(stderr, " real time: %g ms, %s\n", timer.min_time() * 1000.0, f5.report().c_str());
+                f5.reset();
             }
         }
     }
@@ -2,6 +2,7 @@
 
 #include <vespa/vespalib/testkit/test_kit.h>
 #include <vespa/searchcore/proton/matching/docid_range_scheduler.h>
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -305,4 +306,108 @@ TEST_MT_FF("require that the adaptive scheduler handles fewer documents than thr
 
 //-----------------------------------------------------------------------------
 
+using WorkStealingScheduler = WorkStealingDocidRangeScheduler;
+const std::chrono::nanoseconds no_target(0);
+
+TEST("require that the work stealing scheduler starts by dividing the docid space equally") {
+    WorkStealingScheduler scheduler(4, 2, 16, no_target);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 15u);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1, 3)));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(5, 7)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(9, 11)));
+    TEST_DO(verify_range(scheduler.first_range(3), DocidRange(13, 15)));
+    EXPECT_EQUAL(scheduler.total_size(0), 2u);
+    EXPECT_EQUAL(scheduler.total_size(3), 2u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 7u);
+}
+
+TEST("require that the work stealing scheduler reports the full span to all threads") {
+    WorkStealingScheduler scheduler(3, 1, 16, no_target);
+    TEST_DO(verify_range(scheduler.total_span(0), DocidRange(1,16)));
+    TEST_DO(verify_range(scheduler.total_span(1), DocidRange(1,16)));
+    TEST_DO(verify_range(scheduler.total_span(2), DocidRange(1,16)));
+}
+
+TEST("require that the work stealing scheduler does not support work sharing") {
+    WorkStealingScheduler scheduler(2, 1, 16, no_target);
+    EXPECT_TRUE(scheduler.make_idle_observer().is_always_zero());
+    TEST_DO(verify_range(scheduler.share_range(0, DocidRange(1,9)), DocidRange(1,9)));
+}
+
+TEST("require that idle threads steal the upper half of remaining work from peers") {
+    WorkStealingScheduler scheduler(2, 2, 11, no_target);
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1,3)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(3,5)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(5,6)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(8,10)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(10,11)));
+    // a range smaller than two tasks is stolen completely
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(6,8)));
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange()));
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange()));
+    EXPECT_EQUAL(scheduler.total_size(0), 10u);
+    EXPECT_EQUAL(scheduler.total_size(1), 0u);
+    EXPECT_EQUAL(scheduler.unassigned_size(), 0u);
+}
+
+TEST("require that idle threads steal from the peer with the most work left") {
+    WorkStealingScheduler scheduler(3, 1, 31, no_target);
+    TEST_DO(verify_range(scheduler.first_range(1), DocidRange(11,12)));
+    TEST_DO(verify_range(scheduler.first_range(2), DocidRange(21,22)));
+    for (size_t i = 0; i < 5; ++i) {
+        (void) scheduler.next_range(2);
+    }
+    EXPECT_EQUAL(scheduler.unassigned_size(), 23u);
+    // thread 0 runs dry after 10 docids and steals from thread 1
+    for (size_t i = 0; i < 10; ++i) {
+        (void) scheduler.next_range(0);
+    }
+    TEST_DO(verify_range(scheduler.next_range(0), DocidRange(16,17)));
+}
+
+TEST("require that the chunk size adapts to the observed cost per docid") {
+    WorkStealingScheduler scheduler(1, 1, 1000001, std::chrono::seconds(1));
+    TEST_DO(verify_range(scheduler.first_range(0), DocidRange(1,2)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    // about 10ms per docid gives about 100 docids per second
+    DocidRange range = scheduler.next_range(0);
+    EXPECT_GREATER(range.size(), 1u);
+    EXPECT_LESS(range.size(), 1000u);
+}
+
+TEST_MT_FF("require that the work stealing scheduler protects against documents underflow",
+           2, WorkStealingScheduler(num_threads, 1, 0, no_target), TimeBomb(60))
+{
+    TEST_DO(verify_range(f1.first_range(thread_id), DocidRange()));
+    EXPECT_EQUAL(f1.total_size(thread_id), 0u);
+    EXPECT_EQUAL(f1.unassigned_size(), 0u);
+}
+
+TEST_MT_FF("require that the work stealing scheduler hands out all docids exactly once",
+           4, WorkStealingScheduler(num_threads, 3, 10001, no_target), TimeBomb(60))
+{
+    std::vector<uint32_t> docids;
+    for (DocidRange docid_range = f1.first_range(thread_id);
+         !docid_range.empty();
+         docid_range = f1.next_range(thread_id))
+    {
+        EXPECT_TRUE(docid_range.size() <= 3u);
+        if (thread_id == 0) {
+            // make sure someone needs to steal from thread 0
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        for (uint32_t docid = docid_range.begin; docid < docid_range.end; ++docid) {
+            docids.push_back(docid);
+        }
+    }
+    EXPECT_EQUAL(f1.total_size(thread_id), docids.size());
+    TEST_BARRIER();
+    EXPECT_EQUAL(f1.unassigned_size(), 0u);
+    EXPECT_EQUAL(f1.total_size(0) + f1.total_size(1) + f1.total_size(2) + f1.total_size(3), 10000u);
+    std::sort(docids.begin(), docids.end());
+    EXPECT_TRUE(std::adjacent_find(docids.begin(), docids.end()) == docids.end());
+}
+
+//-----------------------------------------------------------------------------
+
 TEST_MAIN() { TEST_RUN_ALL(); }
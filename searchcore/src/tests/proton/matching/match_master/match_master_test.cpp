@@ -0,0 +1,39 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchcore/proton/matching/docid_range_scheduler.h>
+#include <vespa/searchcore/proton/matching/match_master.h>
+
+using namespace proton::matching;
+
+template <typename T>
+bool is_a(const DocidRangeScheduler &scheduler) {
+    return (dynamic_cast<const T *>(&scheduler) != nullptr);
+}
+
+TEST("require that adaptive scheduler is used when there are no search partitions") {
+    auto scheduler = MatchMaster::createScheduler(4, 0, 1000, false);
+    EXPECT_TRUE(is_a<AdaptiveDocidRangeScheduler>(*scheduler));
+}
+
+TEST("require that partition scheduler is used when there are no more search partitions than threads") {
+    auto scheduler = MatchMaster::createScheduler(4, 1, 1000, false);
+    EXPECT_TRUE(is_a<PartitionDocidRangeScheduler>(*scheduler));
+    scheduler = MatchMaster::createScheduler(4, 4, 1000, false);
+    EXPECT_TRUE(is_a<PartitionDocidRangeScheduler>(*scheduler));
+}
+
+TEST("require that task scheduler is used when there are more search partitions than threads") {
+    auto scheduler = MatchMaster::createScheduler(4, 5, 1000, false);
+    EXPECT_TRUE(is_a<TaskDocidRangeScheduler>(*scheduler));
+}
+
+TEST("require that work stealing scheduler is used when selected, regardless of search partitions") {
+    for (uint32_t numSearchPartitions : {0u, 1u, 4u, 5u}) {
+        auto scheduler = MatchMaster::createScheduler(4, numSearchPartitions, 1000, true);
+        EXPECT_TRUE(is_a<WorkStealingDocidRangeScheduler>(*scheduler));
+        EXPECT_EQUAL(scheduler->total_span(0).begin, 1u);
+        EXPECT_EQUAL(scheduler->total_span(0).end, 1000u);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -31,6 +31,7 @@
 #include <vespa/searchlib/attribute/integerbase.h>
 #include <vespa/searchlib/attribute/predicate_attribute.h>
 #include <vespa/searchlib/attribute/stringbase.h>
+#include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/testkit/testapp.h>
 
 using document::ArrayFieldValue;
@@ -46,6 +47,7 @@ using document::IntFieldValue;
 using document::LongFieldValue;
 using document::PositionDataType;
 using document::PredicateFieldValue;
+using document::SerializedDocumentView;
 using document::StringFieldValue;
 using document::StructFieldValue;
 using document::WeightedSetFieldValue;
@@ -111,6 +113,10 @@ const int64_t static_zcurve_value = 1118035438880ll;
 const int64_t dynamic_zcurve_value = 6145423666930817152ll;
 
 struct MyDocumentStore : proton::test::DummyDocumentStore {
+    const DocumentTypeRepo &_repo;
+
+    MyDocumentStore(const DocumentTypeRepo &repo) : _repo(repo) {}
+
     virtual Document::UP read(DocumentIdT lid,
                               const DocumentTypeRepo &r) const override {
         if (lid == 0) {
@@ -134,6 +140,18 @@ struct MyDocumentStore : proton::test::DummyDocumentStore {
 
         return doc;
     }
+
+    virtual bool readSerialized(DocumentIdT lid, vespalib::DataBuffer &buffer) const override {
+        buffer.clear();
+        Document::UP doc = read(lid, _repo);
+        if ( ! doc) {
+            return false;
+        }
+        vespalib::nbostream stream;
+        doc->serialize(stream);
+        buffer.writeBytes(stream.peek(), stream.size());
+        return true;
+    }
     
     virtual uint64_t
     initFlush(uint64_t syncToken) override
@@ -262,7 +280,7 @@ struct Fixture {
           bucket_id(gid.convertToBucketId()),
           timestamp(21),
           lid(),
-          doc_store(),
+          doc_store(repo),
           attr_manager(),
           schema(),
           _dtName(doc_type_name),
@@ -436,6 +454,30 @@ TEST_F("require that non-existing lid returns null pointer", Fixture) {
     ASSERT_FALSE(doc.get());
 }
 
+TEST_F("require that document view patches attributes into stored fields", Fixture) {
+    DocumentMetaData meta_data = f._retriever->getDocumentMetaData(doc_id);
+    SerializedDocumentView::UP view = f._retriever->getDocumentView(meta_data.lid);
+    ASSERT_TRUE(view.get());
+    EXPECT_EQUAL(doc_id, view->getId());
+
+    EXPECT_TRUE(checkFieldValue<IntFieldValue>(view->getValue(static_field), static_value));
+    EXPECT_TRUE(checkFieldValue<IntFieldValue>(view->getValue(dyn_field_i), dyn_value_i));
+    EXPECT_TRUE(checkFieldValue<StringFieldValue>(view->getValue(dyn_field_s), dyn_value_s));
+    EXPECT_TRUE(view->hasValue(view->getField(dyn_field_i)));
+    EXPECT_FALSE(view->hasValue(view->getField(dyn_field_nai)));
+    EXPECT_FALSE(view->getValue(dyn_field_nai));
+    checkArray<IntFieldValue>(view->getValue(dyn_arr_field_i), dyn_value_i);
+    checkWset(view->getValue(dyn_wset_field_s), dyn_value_s);
+    checkFieldValue<LongFieldValue>(view->getValue(zcurve_field), dynamic_zcurve_value);
+
+    Document::UP doc = f._retriever->getDocument(meta_data.lid);
+    EXPECT_EQUAL(*doc, *view->createDocument());
+}
+
+TEST_F("require that non-existing lid returns null document view", Fixture) {
+    EXPECT_FALSE(f._retriever->getDocumentView(0));
+}
+
 TEST_F("require that predicate attributes can be retrieved", Fixture) {
     DocumentMetaData meta_data = f._retriever->getDocumentMetaData(doc_id);
     Document::UP doc = f._retriever->getDocument(meta_data.lid);
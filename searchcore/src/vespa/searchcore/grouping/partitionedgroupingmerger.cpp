@@ -0,0 +1,132 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "partitionedgroupingmerger.h"
+#include "groupingcontext.h"
+
+#include <vespa/log/log.h>
+LOG_SETUP(".partitionedgroupingmerger");
+
+namespace search::grouping {
+
+using aggregation::Group;
+using aggregation::Grouping;
+
+PartitionedGroupingMerger::PartitionedGroupingMerger(size_t numThreads)
+    : _numThreads(numThreads),
+      _barrier(numThreads),
+      _contexts(numThreads, nullptr),
+      _limits(),
+      _offsets(numThreads),
+      _partitions(numThreads)
+{
+}
+
+PartitionedGroupingMerger::~PartitionedGroupingMerger() = default;
+
+void
+PartitionedGroupingMerger::selectLimits()
+{
+    GroupingContext::GroupingList &groupingList(_contexts[0]->getGroupingList());
+    _limits.resize(groupingList.size());
+    for (size_t i = 0; i < groupingList.size(); ++i) {
+        const Group &root = groupingList[i]->getRoot();
+        size_t numChildren = root.getChildrenSize();
+        for (size_t p = 1; p < _numThreads; ++p) {
+            size_t idx = (p * numChildren) / _numThreads;
+            if (idx < numChildren) {
+                _limits[i].emplace_back(root.getChild(idx).getId().clone());
+            }
+        }
+    }
+}
+
+void
+PartitionedGroupingMerger::findOffsets(size_t thread_id)
+{
+    GroupingContext::GroupingList &groupingList(_contexts[thread_id]->getGroupingList());
+    LOG_ASSERT(groupingList.size() == _limits.size());
+    Offsets &offsets = _offsets[thread_id];
+    offsets.resize(groupingList.size());
+    for (size_t i = 0; i < groupingList.size(); ++i) {
+        const Group &root = groupingList[i]->getRoot();
+        offsets[i].push_back(0);
+        for (size_t p = 1; p < _numThreads; ++p) {
+            offsets[i].push_back((p <= _limits[i].size())
+                                 ? root.lowerBoundChild(*_limits[i][p - 1])
+                                 : root.getChildrenSize());
+        }
+        offsets[i].push_back(root.getChildrenSize());
+    }
+}
+
+void
+PartitionedGroupingMerger::mergePartition(size_t thread_id)
+{
+    GroupingContext::GroupingList &groupingList(_contexts[thread_id]->getGroupingList());
+    Partition &partition = _partitions[thread_id];
+    partition.resize(groupingList.size());
+    for (size_t i = 0; i < groupingList.size(); ++i) {
+        const Grouping &g = *groupingList[i];
+        // merge the contributions of all threads as a balanced tree
+        std::vector<Group> runs(_numThreads);
+        for (size_t t = 0; t < _numThreads; ++t) {
+            const Grouping &source = *_contexts[t]->getGroupingList()[i];
+            LOG_ASSERT(source.getId() == g.getId());
+            const std::vector<uint32_t> &offsets = _offsets[t][i];
+            Group::GroupList children = source.getRoot().groups();
+            std::vector<Group *> groups(children + offsets[thread_id], children + offsets[thread_id + 1]);
+            g.mergePartition(runs[t], groups);
+        }
+        for (size_t step = 1; step < runs.size(); step *= 2) {
+            for (size_t t = 0; (t + step) < runs.size(); t += (step * 2)) {
+                g.mergePartition(runs[t], runs[t + step]);
+            }
+        }
+        g.mergePartition(partition[i], runs[0]);
+        g.prunePartition(partition[i]);
+    }
+}
+
+void
+PartitionedGroupingMerger::combine()
+{
+    GroupingContext::GroupingList &list_a(_contexts[0]->getGroupingList());
+    for (size_t i = 0; i < list_a.size(); ++i) {
+        std::vector<Grouping *> list_b;
+        for (size_t t = 1; t < _numThreads; ++t) {
+            list_b.push_back(_contexts[t]->getGroupingList()[i].get());
+        }
+        std::vector<Group *> list_p;
+        for (Partition &partition : _partitions) {
+            list_p.push_back(&partition[i]);
+        }
+        list_a[i]->mergePartitions(list_b, list_p);
+    }
+    _limits.clear();
+    _offsets.clear();
+    _partitions.clear();
+}
+
+void
+PartitionedGroupingMerger::merge(size_t thread_id, GroupingContext *ctx)
+{
+    LOG_ASSERT(thread_id < _numThreads);
+    _contexts[thread_id] = ctx;
+    if ((thread_id == 0) && (ctx != nullptr)) {
+        selectLimits();
+    }
+    _barrier.await();
+    if (ctx != nullptr) {
+        findOffsets(thread_id);
+    }
+    _barrier.await();
+    if (ctx != nullptr) {
+        mergePartition(thread_id);
+    }
+    _barrier.await();
+    if ((thread_id == 0) && (ctx != nullptr)) {
+        combine();
+    }
+}
+
+}
@@ -0,0 +1,67 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchlib/aggregation/group.h>
+#include <vespa/vespalib/util/barrier.h>
+#include <vector>
+
+namespace search::grouping {
+
+class GroupingContext;
+
+/**
+ * Merges the grouping contexts produced by a set of threads by
+ * partitioning the top level groups into id ranges, one range per
+ * thread. Each thread merges one range from all contexts in parallel,
+ * keeping only the best ranked groups, before the first thread
+ * combines the ranges into its own context. This replaces the
+ * pairwise merging of whole grouping trees, which scales poorly when
+ * there are many unique top level groups.
+ *
+ * The range limits are sampled from the groups of the first thread.
+ * Ranges are used rather than hashing the ids, since the top level
+ * groups are already ordered by id; each thread then walks a
+ * contiguous part of each context.
+ **/
+class PartitionedGroupingMerger
+{
+private:
+    using ResultNode = expression::ResultNode;
+    // index of the first top level group of each partition, per grouping
+    using Offsets = std::vector<std::vector<uint32_t>>;
+    // merged top level groups of one partition, per grouping
+    using Partition = std::vector<aggregation::Group>;
+
+    size_t                                   _numThreads;
+    vespalib::Barrier                        _barrier;
+    std::vector<GroupingContext*>            _contexts;
+    std::vector<std::vector<ResultNode::CP>> _limits;
+    std::vector<Offsets>                     _offsets;
+    std::vector<Partition>                   _partitions;
+
+    void selectLimits();
+    void findOffsets(size_t thread_id);
+    void mergePartition(size_t thread_id);
+    void combine();
+
+public:
+    PartitionedGroupingMerger(const PartitionedGroupingMerger &) = delete;
+    PartitionedGroupingMerger &operator=(const PartitionedGroupingMerger &) = delete;
+    PartitionedGroupingMerger(size_t numThreads);
+    ~PartitionedGroupingMerger();
+
+    /**
+     * Called by all threads with their grouping context (which must
+     * be nullptr for all threads or none). Blocks until all threads
+     * have contributed. When this function returns in thread 0, its
+     * context holds the merged result. The top level groups of the
+     * other contexts are moved out, but their root level results are
+     * used until thread 0 returns.
+     *
+     * @param thread_id id of the calling thread
+     * @param ctx the grouping context of the calling thread
+     **/
+    void merge(size_t thread_id, GroupingContext *ctx);
+};
+
+}
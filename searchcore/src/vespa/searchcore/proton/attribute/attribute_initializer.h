@@ -54,6 +54,7 @@ public:
 
     AttributeInitializerResult init() const;
     uint64_t getCurrentSerialNum() const { return _currentSerialNum; }
+    const vespalib::string &getAttributeName() const { return _spec.getName(); }
 };
 
 } // namespace proton
@@ -17,29 +17,58 @@ using initializer::InitializerTask;
 
 namespace {
 
-class AttributeInitializerTask : public InitializerTask
+/*
+ * Loads an attribute vector. Loading does not depend on the document
+ * meta store, so attributes are loaded while it is loaded.
+ */
+class AttributeLoadTask : public InitializerTask
 {
 private:
     AttributeInitializer::UP _initializer;
+    std::shared_ptr<AttributeVector> _attr;
+
+public:
+    AttributeLoadTask(AttributeInitializer::UP initializer)
+        : _initializer(std::move(initializer)),
+          _attr()
+    {}
+
+    void run() override {
+        AttributeInitializerResult result = _initializer->init();
+        _attr = result.getAttribute();
+    }
+    vespalib::string getName() const override { return _initializer->getAttributeName(); }
+    const std::shared_ptr<AttributeVector> &getAttribute() const { return _attr; }
+    SerialNum getCurrentSerialNum() const { return _initializer->getCurrentSerialNum(); }
+};
+
+/*
+ * Pads a loaded attribute vector to the doc id limit of the loaded
+ * document meta store.
+ */
+class AttributeInitializerTask : public InitializerTask
+{
+private:
+    std::shared_ptr<AttributeLoadTask> _loadTask;
     DocumentMetaStore::SP _documentMetaStore;
     InitializedAttributesResult &_result;
 
 public:
-    AttributeInitializerTask(AttributeInitializer::UP initializer,
+    AttributeInitializerTask(std::shared_ptr<AttributeLoadTask> loadTask,
                              DocumentMetaStore::SP documentMetaStore,
                              InitializedAttributesResult &result)
-        : _initializer(std::move(initializer)),
+        : _loadTask(std::move(loadTask)),
           _documentMetaStore(documentMetaStore),
           _result(result)
     {}
 
     void run() override {
-        AttributeInitializerResult result = _initializer->init();
-        if (result) {
-            AttributesInitializerBase::considerPadAttribute(*result.getAttribute(),
-                                                            _initializer->getCurrentSerialNum(),
+        const auto &attr = _loadTask->getAttribute();
+        if (attr) {
+            AttributesInitializerBase::considerPadAttribute(*attr,
+                                                            _loadTask->getCurrentSerialNum(),
                                                             _documentMetaStore->getCommittedDocIdLimit());
-            _result.add(result);
+            _result.add(AttributeInitializerResult(attr));
         }
     }
 };
@@ -120,11 +149,13 @@ AttributeInitializerTasksBuilder::~AttributeInitializerTasksBuilder() {}
 
 void
 AttributeInitializerTasksBuilder::add(AttributeInitializer::UP initializer) {
+    auto attributeLoadTask = std::make_shared<AttributeLoadTask>(std::move(initializer));
     InitializerTask::SP attributeInitTask =
-            std::make_shared<AttributeInitializerTask>(std::move(initializer),
+            std::make_shared<AttributeInitializerTask>(attributeLoadTask,
                                                        _documentMetaStore,
                                                        _attributesResult);
     attributeInitTask->addDependency(_documentMetaStoreInitTask);
+    attributeInitTask->addDependency(attributeLoadTask);
     _attrMgrInitTask.addDependency(attributeInitTask);
 }
 
@@ -165,6 +196,12 @@ AttributeManagerInitializer::AttributeManagerInitializer(SerialNum configSerialN
     _attrMgr = std::make_shared<AttributeManager>(*baseAttrMgr, *attrSpec, tasksBuilder);
 }
 
+vespalib::string
+AttributeManagerInitializer::getName() const
+{
+    return "attribute";
+}
+
 void
 AttributeManagerInitializer::run()
 {
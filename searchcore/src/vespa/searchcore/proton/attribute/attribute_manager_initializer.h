@@ -46,6 +46,7 @@ public:
                                 std::shared_ptr<AttributeManager::SP> attrMgrResult);
 
     virtual void run() override;
+    vespalib::string getName() const override;
 };
 
 } // namespace proton
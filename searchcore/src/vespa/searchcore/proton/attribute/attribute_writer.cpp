@@ -7,8 +7,12 @@
 #include <vespa/searchcore/proton/attribute/imported_attributes_repo.h>
 #include <vespa/searchcore/proton/common/attrupdate.h>
 #include <vespa/searchlib/attribute/attributevector.hpp>
+#include <vespa/searchlib/attribute/floatbase.h>
 #include <vespa/searchlib/attribute/imported_attribute_vector.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/common/idestructorcallback.h>
 #include <vespa/searchlib/common/isequencedtaskexecutor.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.attributeadapter");
@@ -349,6 +353,164 @@ CommitTask::run()
     }
 }
 
+struct GetLong {
+    int64_t operator () (const FieldValue &fv) const { return fv.getAsLong(); }
+};
+
+struct GetDouble {
+    double operator () (const FieldValue &fv) const { return fv.getAsDouble(); }
+};
+
+}
+
+/**
+ * Puts and updates for the attributes in one write context. When run,
+ * all operations are applied to one attribute before moving on to the
+ * next, and each attribute is committed at most once.
+ */
+class AttributeWriter::WriteBatch : public vespalib::Executor::Task
+{
+    struct Op {
+        SerialNum          _serialNum;
+        uint32_t           _lid;
+        uint32_t           _fieldId;    // only used by updates
+        uint32_t           _valueIdx;   // only used by puts, index of first field value
+        const FieldUpdate *_update;     // nullptr for puts
+    };
+    const WriteContext          &_wc;
+    std::vector<Op>              _ops;
+    std::vector<FieldValue::UP>  _fieldValues;
+    std::vector<std::shared_ptr<IDestructorCallback>> _onWriteDone;
+    bool                         _commit;
+
+    bool applies(const Op &op, uint32_t fieldId, SerialNum lastSyncToken) const {
+        return (op._serialNum > lastSyncToken) && ((op._update == nullptr) || (op._fieldId == fieldId));
+    }
+    void keepAlive(AttributeWriter::OnWriteDoneType onWriteDone);
+    template <typename AttrT, typename ValueGetter>
+    void applyNumericPuts(AttrT &attr, uint32_t fieldId, SerialNum lastSyncToken, ValueGetter getValue);
+    void applyTo(AttributeVector &attr, uint32_t fieldId);
+public:
+    WriteBatch(const WriteContext &wc);
+    ~WriteBatch() override;
+    void addPut(SerialNum serialNum, const Document &doc, uint32_t lid, AttributeWriter::OnWriteDoneType onWriteDone);
+    void addUpdate(SerialNum serialNum, const FieldUpdate &fieldUpd, uint32_t lid, uint32_t fieldId,
+                   AttributeWriter::OnWriteDoneType onWriteDone);
+    void setCommit() { _commit = true; }
+    void run() override;
+};
+
+AttributeWriter::WriteBatch::WriteBatch(const WriteContext &wc)
+    : _wc(wc),
+      _ops(),
+      _fieldValues(),
+      _onWriteDone(),
+      _commit(false)
+{
+}
+
+AttributeWriter::WriteBatch::~WriteBatch() = default;
+
+void
+AttributeWriter::WriteBatch::keepAlive(AttributeWriter::OnWriteDoneType onWriteDone)
+{
+    if (onWriteDone && (_onWriteDone.empty() || (_onWriteDone.back() != onWriteDone))) {
+        _onWriteDone.push_back(onWriteDone);
+    }
+}
+
+void
+AttributeWriter::WriteBatch::addPut(SerialNum serialNum, const Document &doc, uint32_t lid,
+                                    AttributeWriter::OnWriteDoneType onWriteDone)
+{
+    _ops.push_back({serialNum, lid, 0, static_cast<uint32_t>(_fieldValues.size()), nullptr});
+    for (const auto &fieldPath : _wc.getFieldPaths()) {
+        FieldValue::UP fv;
+        if (!fieldPath.empty()) {
+            fv = doc.getNestedFieldValue(fieldPath.getFullRange());
+        }
+        _fieldValues.emplace_back(std::move(fv));
+    }
+    keepAlive(onWriteDone);
+}
+
+void
+AttributeWriter::WriteBatch::addUpdate(SerialNum serialNum, const FieldUpdate &fieldUpd, uint32_t lid,
+                                       uint32_t fieldId, AttributeWriter::OnWriteDoneType onWriteDone)
+{
+    // The field update is kept alive by the write done context, cf. IAttributeWriter::update().
+    _ops.push_back({serialNum, lid, fieldId, 0, &fieldUpd});
+    keepAlive(onWriteDone);
+}
+
+template <typename AttrT, typename ValueGetter>
+void
+AttributeWriter::WriteBatch::applyNumericPuts(AttrT &attr, uint32_t fieldId, SerialNum lastSyncToken,
+                                              ValueGetter getValue)
+{
+    for (const Op &op : _ops) {
+        if (!applies(op, fieldId, lastSyncToken)) {
+            continue;
+        }
+        const FieldValue *fv = _fieldValues[op._valueIdx + fieldId].get();
+        if (fv == nullptr) {
+            attr.clearDoc(op._lid);
+        } else if (!attr.update(op._lid, getValue(*fv))) {
+            throw UpdateException(vespalib::make_string("attribute update failed: %s[%u]",
+                                                        attr.getName().c_str(), op._lid));
+        }
+    }
+}
+
+void
+AttributeWriter::WriteBatch::applyTo(AttributeVector &attr, uint32_t fieldId)
+{
+    SerialNum lastSyncToken = attr.getStatus().getLastSyncToken();
+    SerialNum lastSerialNum = 0;
+    uint32_t maxLid = 0;
+    bool onlyPuts = true;
+    for (const Op &op : _ops) {
+        if (applies(op, fieldId, lastSyncToken)) {
+            lastSerialNum = op._serialNum;
+            maxLid = std::max(maxLid, op._lid);
+            onlyPuts = onlyPuts && (op._update == nullptr);
+        }
+    }
+    if (lastSerialNum == 0) {
+        return;
+    }
+    AttributeManager::padAttribute(attr, maxLid + 1);
+    const vespalib::Identifiable::RuntimeClass &rc = attr.getClass();
+    if (onlyPuts && !attr.hasMultiValue() && rc.inherits(IntegerAttribute::classId)) {
+        applyNumericPuts(static_cast<IntegerAttribute &>(attr), fieldId, lastSyncToken, GetLong());
+    } else if (onlyPuts && !attr.hasMultiValue() && rc.inherits(FloatingPointAttribute::classId)) {
+        applyNumericPuts(static_cast<FloatingPointAttribute &>(attr), fieldId, lastSyncToken, GetDouble());
+    } else {
+        for (const Op &op : _ops) {
+            if (!applies(op, fieldId, lastSyncToken)) {
+                continue;
+            }
+            if (op._update != nullptr) {
+                AttrUpdate::handleUpdate(attr, op._lid, *op._update);
+            } else if (_fieldValues[op._valueIdx + fieldId]) {
+                AttrUpdate::handleValue(attr, op._lid, *_fieldValues[op._valueIdx + fieldId]);
+            } else {
+                attr.clearDoc(op._lid);
+            }
+        }
+    }
+    if (_commit) {
+        attr.commit(lastSerialNum, lastSerialNum);
+    }
+}
+
+void
+AttributeWriter::WriteBatch::run()
+{
+    const auto &attributes = _wc.getAttributes();
+    for (uint32_t fieldId = 0; fieldId < attributes.size(); ++fieldId) {
+        applyTo(*attributes[fieldId], fieldId);
+    }
 }
 
 void
@@ -367,6 +529,7 @@ AttributeWriter::setupWriteContexts()
         }
         _writeContexts.back().add(fc.getAttribute());
     }
+    _batches.resize(_writeContexts.size());
 }
 
 void
@@ -399,18 +562,80 @@ AttributeWriter::internalRemove(SerialNum serialNum, DocumentIdT lid,
     }
 }
 
-AttributeWriter::AttributeWriter(const proton::IAttributeManager::SP &mgr)
+AttributeWriter::WriteBatch &
+AttributeWriter::getBatch(uint32_t writeContextId)
+{
+    auto &batch = _batches[writeContextId];
+    if (!batch) {
+        batch = std::make_unique<WriteBatch>(_writeContexts[writeContextId]);
+    }
+    return *batch;
+}
+
+void
+AttributeWriter::batchedPut(SerialNum serialNum, const Document &doc, DocumentIdT lid,
+                            bool immediateCommit, OnWriteDoneType onWriteDone)
+{
+    for (uint32_t i = 0; i < _writeContexts.size(); ++i) {
+        getBatch(i).addPut(serialNum, doc, lid, onWriteDone);
+    }
+    maybeFlushBatches(immediateCommit);
+}
+
+bool
+AttributeWriter::batchedUpdate(SerialNum serialNum, const FieldUpdate &fieldUpd, DocumentIdT lid,
+                               const AttributeVector &attr, OnWriteDoneType onWriteDone)
+{
+    for (uint32_t i = 0; i < _writeContexts.size(); ++i) {
+        const auto &attributes = _writeContexts[i].getAttributes();
+        auto itr = std::find(attributes.begin(), attributes.end(), &attr);
+        if (itr != attributes.end()) {
+            getBatch(i).addUpdate(serialNum, fieldUpd, lid, itr - attributes.begin(), onWriteDone);
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+AttributeWriter::maybeFlushBatches(bool immediateCommit)
+{
+    ++_batchedOps;
+    if (immediateCommit || (_batchedOps >= _batchSize)) {
+        flushBatches(immediateCommit);
+    }
+}
+
+void
+AttributeWriter::flushBatches(bool commit)
+{
+    for (uint32_t i = 0; i < _batches.size(); ++i) {
+        if (_batches[i]) {
+            if (commit) {
+                _batches[i]->setCommit();
+            }
+            _attributeFieldWriter.executeTask(_writeContexts[i].getExecutorId(), std::move(_batches[i]));
+        }
+    }
+    _batchedOps = 0;
+}
+
+AttributeWriter::AttributeWriter(const proton::IAttributeManager::SP &mgr, uint32_t batchSize)
     : _mgr(mgr),
       _attributeFieldWriter(mgr->getAttributeFieldWriter()),
       _writableAttributes(mgr->getWritableAttributes()),
       _writeContexts(),
-      _dataType(nullptr)
+      _dataType(nullptr),
+      _batchSize(batchSize),
+      _batchedOps(0),
+      _batches()
 {
     setupWriteContexts();
 }
 
 AttributeWriter::~AttributeWriter()
 {
+    flushBatches(false);
     _attributeFieldWriter.sync();
 }
 
@@ -442,13 +667,18 @@ AttributeWriter::put(SerialNum serialNum, const Document &doc, DocumentIdT lid,
     if (_dataType != dataType) {
         buildFieldPaths(doc.getType(), dataType);
     }
-    internalPut(serialNum, doc, lid, immediateCommit, onWriteDone);
+    if (_batchSize > 1) {
+        batchedPut(serialNum, doc, lid, immediateCommit, onWriteDone);
+    } else {
+        internalPut(serialNum, doc, lid, immediateCommit, onWriteDone);
+    }
 }
 
 void
 AttributeWriter::remove(SerialNum serialNum, DocumentIdT lid,
                         bool immediateCommit, OnWriteDoneType onWriteDone)
 {
+    flushBatches(false);
     internalRemove(serialNum, lid, immediateCommit, onWriteDone);
 }
 
@@ -456,6 +686,7 @@ void
 AttributeWriter::remove(const LidVector &lidsToRemove, SerialNum serialNum,
                         bool immediateCommit, OnWriteDoneType onWriteDone)
 {
+    flushBatches(false);
     for (const auto &writeCtx : _writeContexts) {
         auto removeTask = std::make_unique<BatchRemoveTask>(writeCtx, serialNum, lidsToRemove, immediateCommit, onWriteDone);
         _attributeFieldWriter.executeTask(writeCtx.getExecutorId(), std::move(removeTask));
@@ -486,17 +717,27 @@ AttributeWriter::update(SerialNum serialNum, const DocumentUpdate &upd, Document
         LOG(debug, "About to apply update for docId %u in attribute vector '%s'.",
                 lid, attr.getName().c_str());
 
+        if (_batchSize > 1) {
+            if (batchedUpdate(serialNum, fupd, lid, attr, onWriteDone)) {
+                continue;
+            }
+            flushBatches(false);
+        }
         // NOTE: The lifetime of the field update will be ensured by keeping the document update alive
         // in a operation done context object.
         _attributeFieldWriter.execute(attr.getName(),
                 [serialNum, &fupd, lid, immediateCommit, &attr, onWriteDone]()
                 { applyUpdateToAttribute(serialNum, fupd, lid, immediateCommit, attr, onWriteDone); });
     }
+    if (_batchSize > 1) {
+        maybeFlushBatches(immediateCommit);
+    }
 }
 
 void
 AttributeWriter::heartBeat(SerialNum serialNum)
 {
+    flushBatches(false);
     for (auto attrp : _writableAttributes) {
         auto &attr = *attrp;
         _attributeFieldWriter.execute(attr.getName(),
@@ -516,6 +757,7 @@ AttributeWriter::forceCommit(SerialNum serialNum, OnWriteDoneType onWriteDone)
             attr->clearSearchCache();
         }
     }
+    flushBatches(false);
     for (const auto &wc : _writeContexts) {
         auto commitTask = std::make_unique<CommitTask>(wc, serialNum, onWriteDone);
         _attributeFieldWriter.executeTask(wc.getExecutorId(), std::move(commitTask));
@@ -526,6 +768,7 @@ AttributeWriter::forceCommit(SerialNum serialNum, OnWriteDoneType onWriteDone)
 void
 AttributeWriter::onReplayDone(uint32_t docIdLimit)
 {
+    flushBatches(false);
     for (auto attrp : _writableAttributes) {
         auto &attr = *attrp;
         _attributeFieldWriter.execute(attr.getName(),
@@ -539,6 +782,7 @@ AttributeWriter::onReplayDone(uint32_t docIdLimit)
 void
 AttributeWriter::compactLidSpace(uint32_t wantedLidLimit, SerialNum serialNum)
 {
+    flushBatches(false);
     for (auto attrp : _writableAttributes) {
         auto &attr = *attrp;
         _attributeFieldWriter.
@@ -19,6 +19,7 @@ private:
     typedef document::DataType DataType;
     typedef document::DocumentType DocumentType;
     typedef document::FieldValue FieldValue;
+    typedef document::FieldUpdate FieldUpdate;
     const IAttributeManager::SP _mgr;
     search::ISequencedTaskExecutor &_attributeFieldWriter;
     const std::vector<search::AttributeVector *> &_writableAttributes;
@@ -40,8 +41,12 @@ public:
         const std::vector<AttributeVector *> &getAttributes() const { return _attributes; }
     };
 private:
+    class WriteBatch;
     std::vector<WriteContext> _writeContexts;
     const DataType           *_dataType;
+    const uint32_t            _batchSize;
+    uint32_t                  _batchedOps;
+    std::vector<std::unique_ptr<WriteBatch>> _batches; // one per write context, empty when nothing is pending
 
     void setupWriteContexts();
     void buildFieldPaths(const DocumentType &docType, const DataType *dataType);
@@ -49,9 +54,23 @@ private:
                      bool immediateCommit, OnWriteDoneType onWriteDone);
     void internalRemove(SerialNum serialNum, DocumentIdT lid,
                         bool immediateCommit, OnWriteDoneType onWriteDone);
+    WriteBatch &getBatch(uint32_t writeContextId);
+    void batchedPut(SerialNum serialNum, const Document &doc, DocumentIdT lid,
+                    bool immediateCommit, OnWriteDoneType onWriteDone);
+    bool batchedUpdate(SerialNum serialNum, const FieldUpdate &fieldUpd, DocumentIdT lid,
+                       const AttributeVector &attr, OnWriteDoneType onWriteDone);
+    void maybeFlushBatches(bool immediateCommit);
+    void flushBatches(bool commit);
 
 public:
-    AttributeWriter(const proton::IAttributeManager::SP &mgr);
+    /**
+     * With a batch size above 1, puts and updates are collected per write
+     * context and handed to the attribute field writer as one task when
+     * the given number of operations has been collected, when an operation
+     * asks for immediate commit, or when any other operation arrives.
+     * Each attribute is then committed at most once per batch.
+     */
+    AttributeWriter(const proton::IAttributeManager::SP &mgr, uint32_t batchSize = 1);
     ~AttributeWriter();
 
     /**
@@ -75,6 +94,8 @@ public:
         return _mgr;
     }
     void forceCommit(SerialNum serialNum, OnWriteDoneType onWriteDone) override;
+    bool hasPendingBatches() const override { return _batchedOps != 0; }
+    void flushPendingBatches() override { flushBatches(false); }
 
     virtual void onReplayDone(uint32_t docIdLimit) override;
 };
@@ -59,6 +59,19 @@ public:
      */
     virtual void forceCommit(SerialNum serialNum, OnWriteDoneType onWriteDone) = 0;
 
+    /**
+     * Returns true if puts or updates are held back in batches that have
+     * not yet been handed to the attribute field writer.
+     */
+    virtual bool hasPendingBatches() const = 0;
+
+    /**
+     * Hand batched puts and updates to the attribute field writer without
+     * committing. Called when a feed window ends so batched operations
+     * are not held back waiting for more operations to arrive.
+     */
+    virtual void flushPendingBatches() = 0;
+
     virtual void onReplayDone(uint32_t docIdLimit) = 0;
 };
 
@@ -48,4 +48,10 @@ SummaryManagerInitializer::run()
     EventLogger::loadDocumentStoreComplete(_subDbName, elapsedTimeMs);
 }
 
+vespalib::string
+SummaryManagerInitializer::getName() const
+{
+    return "summary";
+}
+
 } // namespace proton
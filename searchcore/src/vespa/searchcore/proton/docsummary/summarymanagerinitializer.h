@@ -45,6 +45,7 @@ public:
                               std::shared_ptr<SummaryManager::SP> result);
     ~SummaryManagerInitializer();
     void run() override;
+    vespalib::string getName() const override;
 };
 
 } // namespace proton
@@ -61,6 +61,11 @@ DocumentMetaStoreInitializer::run()
     }
 }
 
+vespalib::string
+DocumentMetaStoreInitializer::getName() const
+{
+    return "documentmetastore";
+}
 
 } // namespace proton::documentmetastore
 
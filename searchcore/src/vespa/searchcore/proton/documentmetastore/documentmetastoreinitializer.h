@@ -34,6 +34,7 @@ public:
                                  const vespalib::string &docTypeName,
                                  DocumentMetaStore::SP dms);
     virtual void run() override;
+    vespalib::string getName() const override;
 };
 
 
@@ -13,6 +13,8 @@ IndexManagerInitializer(const vespalib::string &baseDir,
                         const searchcorespi::index::WarmupConfig & warmupCfg,
                         size_t maxFlushed,
                         size_t cacheSize,
+                        uint32_t fusionThreads,
+                        size_t fusionMemoryBudget,
                         const search::index::Schema &schema,
                         search::SerialNum serialNum,
                         searchcorespi::IIndexManager::Reconfigurer & reconfigurer,
@@ -26,6 +28,8 @@ IndexManagerInitializer(const vespalib::string &baseDir,
       _warmupCfg(warmupCfg),
       _maxFlushed(maxFlushed),
       _cacheSize(cacheSize),
+      _fusionThreads(fusionThreads),
+      _fusionMemoryBudget(fusionMemoryBudget),
       _schema(schema),
       _serialNum(serialNum),
       _reconfigurer(reconfigurer),
@@ -50,6 +54,8 @@ IndexManagerInitializer::run()
                      _warmupCfg,
                      _maxFlushed,
                      _cacheSize,
+                     _fusionThreads,
+                     _fusionMemoryBudget,
                      _schema,
                      _serialNum,
                      _reconfigurer,
@@ -60,5 +66,10 @@ IndexManagerInitializer::run()
                      _fileHeaderContext);
 }
 
+vespalib::string
+IndexManagerInitializer::getName() const
+{
+    return "index";
+}
 
 } // namespace proton
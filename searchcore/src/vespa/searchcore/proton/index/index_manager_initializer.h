@@ -19,6 +19,8 @@ class IndexManagerInitializer :  public initializer::InitializerTask
     const searchcorespi::index::WarmupConfig    _warmupCfg;
     size_t                                      _maxFlushed;
     size_t                                      _cacheSize;
+    uint32_t                                    _fusionThreads;
+    size_t                                      _fusionMemoryBudget;
     const search::index::Schema                 _schema;
     search::SerialNum                           _serialNum;
     searchcorespi::IIndexManager::Reconfigurer &_reconfigurer;
@@ -34,6 +36,8 @@ public:
                             const searchcorespi::index::WarmupConfig & warmupCfg,
                             size_t maxFlushed,
                             size_t cacheSize,
+                            uint32_t fusionThreads,
+                            size_t fusionMemoryBudget,
                             const search::index::Schema &schema,
                             search::SerialNum serialNum,
                             searchcorespi::IIndexManager::Reconfigurer & reconfigurer,
@@ -44,6 +48,7 @@ public:
                             const search::common::FileHeaderContext & fileHeaderContext,
                             std::shared_ptr<searchcorespi::IIndexManager::SP> indexManager);
     virtual void run() override;
+    vespalib::string getName() const override;
 };
 
 } // namespace proton
@@ -7,6 +7,7 @@
 #include <vespa/searchlib/diskindex/fusion.h>
 
 using search::diskindex::Fusion;
+using search::diskindex::FusionProgress;
 using search::common::FileHeaderContext;
 using search::common::SerialNumFileHeaderContext;
 using search::index::Schema;
@@ -27,10 +28,14 @@ namespace proton {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          size_t cacheSize,
+                                                         uint32_t fusionThreads,
+                                                         size_t fusionMemoryBudget,
                                                          searchcorespi::index::
                                                          IThreadingService &
                                                          threadingService)
     : _cacheSize(cacheSize),
+      _fusionThreads(fusionThreads),
+      _fusionMemoryBudget(fusionMemoryBudget),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
@@ -67,14 +72,16 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
                                               const vespalib::string &outputDir,
                                               const std::vector<vespalib::string> &sources,
                                               const SelectorArray &selectorArray,
-                                              SerialNum serialNum)
+                                              SerialNum serialNum,
+                                              const FusionProgress::SP &progress)
 {
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext,
                                                  serialNum);
     const bool dynamic_k_doc_pos_occ_format = false;
     return Fusion::merge(schema, outputDir, sources, selectorArray,
                          dynamic_k_doc_pos_occ_format,
-                         _tuneFileIndexing, fileHeaderContext);
+                         _tuneFileIndexing, fileHeaderContext,
+                         _fusionThreads, _fusionMemoryBudget, progress);
 }
 
 
@@ -82,6 +89,8 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const WarmupConfig & warmup,
                            const size_t maxFlushed,
                            const size_t cacheSize,
+                           const uint32_t fusionThreads,
+                           const size_t fusionMemoryBudget,
                            const Schema &schema,
                            SerialNum serialNum,
                            Reconfigurer &reconfigurer,
@@ -91,7 +100,7 @@ IndexManager::IndexManager(const vespalib::string &baseDir,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const search::common::FileHeaderContext &fileHeaderContext) :
     _operations(fileHeaderContext, tuneFileIndexManager, cacheSize,
-                threadingService),
+                fusionThreads, fusionMemoryBudget, threadingService),
     _maintainer(IndexMaintainerConfig(baseDir,
                                       warmup,
                                       maxFlushed,
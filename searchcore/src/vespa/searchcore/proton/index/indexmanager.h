@@ -20,6 +20,8 @@ public:
     class MaintainerOperations : public searchcorespi::index::IIndexMaintainerOperations {
     private:
         const size_t _cacheSize;
+        const uint32_t _fusionThreads;
+        const size_t _fusionMemoryBudget;
         const search::common::FileHeaderContext &_fileHeaderContext;
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
@@ -29,6 +31,8 @@ public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              size_t cacheSize,
+                             uint32_t fusionThreads,
+                             size_t fusionMemoryBudget,
                              searchcorespi::index::IThreadingService &
                              threadingService);
 
@@ -43,7 +47,8 @@ public:
                                const vespalib::string &outputDir,
                                const std::vector<vespalib::string> &sources,
                                const search::diskindex::SelectorArray &docIdSelector,
-                               search::SerialNum lastSerialNum) override;
+                               search::SerialNum lastSerialNum,
+                               const search::diskindex::FusionProgress::SP &progress) override;
     };
 
 private:
@@ -57,6 +62,8 @@ public:
                  const searchcorespi::index::WarmupConfig & warmup,
                  size_t maxFlushed,
                  size_t cacheSize,
+                 uint32_t fusionThreads,
+                 size_t fusionMemoryBudget,
                  const Schema &schema,
                  SerialNum serialNum,
                  Reconfigurer &reconfigurer,
@@ -118,6 +125,10 @@ public:
     virtual void setMaxFlushed(uint32_t maxFlushed) override {
         _maintainer.setMaxFlushed(maxFlushed);
     }
+
+    std::shared_ptr<const search::diskindex::FusionProgress> getFusionProgress() const override {
+        return _maintainer.getFusionProgress();
+    }
 };
 
 } // namespace proton
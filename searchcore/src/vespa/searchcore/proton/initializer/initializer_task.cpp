@@ -6,7 +6,9 @@ namespace proton::initializer {
 
 InitializerTask::InitializerTask()
     : _state(State::BLOCKED),
-      _dependencies()
+      _dependencies(),
+      _startTime(),
+      _endTime()
 {
 }
 
@@ -22,5 +24,11 @@ InitializerTask::addDependency(SP dependency)
     _dependencies.emplace_back(std::move(dependency));
 }
 
+vespalib::string
+InitializerTask::getName() const
+{
+    return vespalib::string();
+}
+
 } // namespace proton::initializer
 
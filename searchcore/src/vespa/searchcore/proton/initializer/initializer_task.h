@@ -1,6 +1,8 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include <vespa/fastos/timestamp.h>
+#include <vespa/vespalib/stllike/string.h>
 #include <memory>
 #include <vector>
 
@@ -22,8 +24,10 @@ public:
         DONE
     };
 private:
-    State           _state;
-    List            _dependencies;
+    State             _state;
+    List              _dependencies;
+    fastos::TimeStamp _startTime;
+    fastos::TimeStamp _endTime;
 public:
     InitializerTask();
     virtual ~InitializerTask();
@@ -33,6 +37,16 @@ public:
     void setDone() { _state = State::DONE; }
     void addDependency(SP dependency);
     virtual void run() = 0;
+
+    /*
+     * Name used when reporting timings, tasks without a name are only
+     * glue between other tasks and are not reported.
+     */
+    virtual vespalib::string getName() const;
+    void setStartTime(fastos::TimeStamp startTime) { _startTime = startTime; }
+    void setEndTime(fastos::TimeStamp endTime) { _endTime = endTime; }
+    fastos::TimeStamp getStartTime() const { return _startTime; }
+    fastos::TimeStamp getEndTime() const { return _endTime; }
 };
 
 } // namespace proton::initializer
@@ -73,7 +73,9 @@ TaskRunner::internalRunTask(InitializerTask::SP task, Context::SP context)
     setTaskRunning(*task);
     auto done(makeLambdaTask([=]() { setTaskDone(*task, context); }));
     _executor.execute(makeLambdaTask([=, done(std::move(done))]() mutable
-                                     {   task->run();
+                                     {   task->setStartTime(fastos::ClockSystem::now());
+                                         task->run();
+                                         task->setEndTime(fastos::ClockSystem::now());
                                          context->execute(std::move(done)); }));
 }
 
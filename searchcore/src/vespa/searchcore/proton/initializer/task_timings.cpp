@@ -0,0 +1,54 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "task_timings.h"
+#include <vespa/vespalib/stllike/hash_set.hpp>
+#include <algorithm>
+
+namespace proton::initializer {
+
+TaskTimings::TaskTimings(const InitializerTask &rootTask)
+    : _timings(),
+      _wallTimeMs(0)
+{
+    TaskSet seen;
+    NamedTasks named;
+    collect(rootTask, "", seen, named);
+    // Unnamed tasks also count towards the wall time.
+    fastos::TimeStamp first(rootTask.getStartTime());
+    fastos::TimeStamp last(rootTask.getEndTime());
+    for (const void *ptr : seen) {
+        const InitializerTask &task = *static_cast<const InitializerTask *>(ptr);
+        first = std::min(first, task.getStartTime());
+        last = std::max(last, task.getEndTime());
+    }
+    _wallTimeMs = (last - first).ms();
+    std::stable_sort(named.begin(), named.end(),
+                     [](const auto &lhs, const auto &rhs) { return lhs.first->getStartTime() < rhs.first->getStartTime(); });
+    for (const auto &entry : named) {
+        const InitializerTask &task = *entry.first;
+        _timings.emplace_back(entry.second, (task.getStartTime() - first).ms(),
+                              (task.getEndTime() - task.getStartTime()).ms());
+    }
+}
+
+TaskTimings::~TaskTimings() = default;
+
+void
+TaskTimings::collect(const InitializerTask &task, const vespalib::string &prefix, TaskSet &seen,
+                     NamedTasks &named)
+{
+    if (!seen.insert(&task).second) {
+        return;
+    }
+    vespalib::string name = task.getName();
+    vespalib::string childPrefix = prefix;
+    if (!name.empty()) {
+        childPrefix = prefix.empty() ? name : (prefix + "." + name);
+        named.emplace_back(&task, childPrefix);
+    }
+    for (const auto &dep : task.getDependencies()) {
+        collect(*dep, childPrefix, seen, named);
+    }
+}
+
+} // namespace proton::initializer
@@ -0,0 +1,47 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "initializer_task.h"
+#include <vespa/vespalib/stllike/hash_set.h>
+
+namespace proton {
+
+namespace initializer {
+
+/*
+ * Wall clock timings for the named tasks of a finished initializer task
+ * graph. The name of a task is prefixed with the names of the named tasks
+ * depending on it, as found by a depth first walk from the root task.
+ */
+class TaskTimings {
+public:
+    struct Timing {
+        vespalib::string name;
+        int64_t          startMs;    // relative to start of first task
+        int64_t          durationMs;
+        Timing(const vespalib::string &name_, int64_t startMs_, int64_t durationMs_)
+            : name(name_),
+              startMs(startMs_),
+              durationMs(durationMs_)
+        {
+        }
+    };
+    using SP = std::shared_ptr<const TaskTimings>;
+private:
+    using TaskSet = vespalib::hash_set<const void *>;
+    using NamedTasks = std::vector<std::pair<const InitializerTask *, vespalib::string>>;
+    std::vector<Timing> _timings;
+    int64_t             _wallTimeMs;
+
+    static void collect(const InitializerTask &task, const vespalib::string &prefix, TaskSet &seen,
+                        NamedTasks &named);
+public:
+    TaskTimings(const InitializerTask &rootTask);
+    ~TaskTimings();
+    const std::vector<Timing> &getTimings() const { return _timings; }
+    int64_t getWallTimeMs() const { return _wallTimeMs; }
+};
+
+} // namespace proton::initializer
+
+} // namespace proton
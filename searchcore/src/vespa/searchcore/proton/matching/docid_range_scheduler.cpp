@@ -160,4 +160,157 @@ AdaptiveDocidRangeScheduler::share_range(size_t thread_id, DocidRange todo)
 
 //-----------------------------------------------------------------------------
 
+void
+WorkStealingDocidRangeScheduler::update_cost(Worker &worker, clock::time_point now)
+{
+    if (worker.chunk_size == 0) {
+        return;
+    }
+    double elapsed_ns = std::chrono::duration<double, std::nano>(now - worker.chunk_start).count();
+    double cost = elapsed_ns / worker.chunk_size;
+    double old_cost = worker.docid_cost.load(std::memory_order_relaxed);
+    if (old_cost > 0.0) {
+        // smooth out noise from single chunks
+        cost = (old_cost + cost) / 2.0;
+    }
+    worker.docid_cost.store(cost, std::memory_order_relaxed);
+}
+
+uint32_t
+WorkStealingDocidRangeScheduler::chunk_size(const Worker &worker) const
+{
+    double cost = worker.docid_cost.load(std::memory_order_relaxed);
+    if (cost <= 0.0) {
+        return _min_task;
+    }
+    double wanted = _target_chunk_ns / cost;
+    if (wanted >= double(search::endDocId)) {
+        return search::endDocId;
+    }
+    return std::max(_min_task, uint32_t(wanted));
+}
+
+DocidRange
+WorkStealingDocidRangeScheduler::take(Worker &worker, clock::time_point now)
+{
+    size_t chunk = chunk_size(worker);
+    uint64_t value = worker.remaining.load(std::memory_order_acquire);
+    for (;;) {
+        DocidRange range = unpack(value);
+        if (range.empty()) {
+            return DocidRange();
+        }
+        uint32_t end = range.begin + std::min(chunk, range.size());
+        if (worker.remaining.compare_exchange_weak(value, pack(DocidRange(end, range.end)),
+                                                   std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            worker.assigned += (end - range.begin);
+            worker.chunk_size = (end - range.begin);
+            worker.chunk_start = now;
+            return DocidRange(range.begin, end);
+        }
+    }
+}
+
+bool
+WorkStealingDocidRangeScheduler::steal(size_t thread_id)
+{
+    for (;;) {
+        // unknown cost means the peer has not yet finished its first chunk
+        double default_cost = 1.0;
+        for (size_t i = 0; i < _num_workers; ++i) {
+            default_cost = std::max(default_cost, _workers[i].docid_cost.load(std::memory_order_relaxed));
+        }
+        size_t victim = _num_workers;
+        uint64_t victim_value = 0;
+        double max_work = 0.0;
+        for (size_t i = 0; i < _num_workers; ++i) {
+            if (i == thread_id) {
+                continue;
+            }
+            uint64_t value = _workers[i].remaining.load(std::memory_order_acquire);
+            DocidRange range = unpack(value);
+            if (range.empty()) {
+                continue;
+            }
+            double cost = _workers[i].docid_cost.load(std::memory_order_relaxed);
+            double work = range.size() * ((cost > 0.0) ? cost : default_cost);
+            if (work > max_work) {
+                victim = i;
+                victim_value = value;
+                max_work = work;
+            }
+        }
+        if (victim == _num_workers) {
+            return false;
+        }
+        DocidRange range = unpack(victim_value);
+        uint32_t mid = (range.size() < (2 * _min_task)) ? range.begin : (range.begin + range.size() / 2);
+        if (_workers[victim].remaining.compare_exchange_strong(victim_value, pack(DocidRange(range.begin, mid)),
+                                                               std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+            // our own part is empty, so nobody else is touching it
+            _workers[thread_id].remaining.store(pack(DocidRange(mid, range.end)), std::memory_order_release);
+            return true;
+        }
+    }
+}
+
+DocidRange
+WorkStealingDocidRangeScheduler::find_work(size_t thread_id, clock::time_point now)
+{
+    Worker &worker = _workers[thread_id];
+    for (;;) {
+        DocidRange range = take(worker, now);
+        if (!range.empty()) {
+            return range;
+        }
+        if (!steal(thread_id)) {
+            worker.chunk_size = 0;
+            return DocidRange();
+        }
+    }
+}
+
+WorkStealingDocidRangeScheduler::WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit,
+                                                                 std::chrono::nanoseconds target_chunk_time)
+    : _splitter(DocidRange(1, docid_limit), num_threads),
+      _min_task(std::max(1u, min_task)),
+      _target_chunk_ns(std::chrono::duration<double, std::nano>(target_chunk_time).count()),
+      _workers(new Worker[num_threads]),
+      _num_workers(num_threads)
+{
+    for (size_t i = 0; i < num_threads; ++i) {
+        _workers[i].remaining.store(pack(_splitter.get(i)), std::memory_order_relaxed);
+    }
+}
+
+WorkStealingDocidRangeScheduler::~WorkStealingDocidRangeScheduler() {}
+
+DocidRange
+WorkStealingDocidRangeScheduler::first_range(size_t thread_id)
+{
+    return find_work(thread_id, clock::now());
+}
+
+DocidRange
+WorkStealingDocidRangeScheduler::next_range(size_t thread_id)
+{
+    clock::time_point now = clock::now();
+    update_cost(_workers[thread_id], now);
+    return find_work(thread_id, now);
+}
+
+size_t
+WorkStealingDocidRangeScheduler::unassigned_size() const
+{
+    size_t sum = 0;
+    for (size_t i = 0; i < _num_workers; ++i) {
+        sum += unpack(_workers[i].remaining.load(std::memory_order_relaxed)).size();
+    }
+    return sum;
+}
+
+//-----------------------------------------------------------------------------
+
 }
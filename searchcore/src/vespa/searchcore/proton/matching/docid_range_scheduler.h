@@ -8,6 +8,8 @@
 #include <condition_variable>
 #include <atomic>
 #include <algorithm>
+#include <chrono>
+#include <memory>
 #include <vector>
 
 namespace proton {
@@ -205,5 +207,59 @@ public:
     DocidRange share_range(size_t, DocidRange todo) override;
 };
 
+/**
+ * A work-stealing scheduler that begins by giving each thread an
+ * equal part of the docid space. Each thread consumes its own part
+ * front to back in chunks sized by its observed cost per docid, aiming
+ * for each chunk to take about 'target_chunk_time' (but never less
+ * than 'min_task' docids). A thread that runs out of work steals the
+ * upper half of the remaining part of the peer with the most estimated
+ * work left, and continues with that part as its own. The remaining
+ * part of each thread is kept as a single packed atomic value, making
+ * both taking and stealing work lock-free.
+ *
+ * Idle threads never wait for busy threads to share their work,
+ * so this scheduler does not support work-sharing; 'share_range'
+ * returns its input and the idle observer is always zero.
+ **/
+class WorkStealingDocidRangeScheduler : public DocidRangeScheduler
+{
+private:
+    using clock = std::chrono::steady_clock;
+    struct alignas(64) Worker {
+        std::atomic<uint64_t> remaining;   // packed docid range, shrinks from both ends
+        std::atomic<double>   docid_cost;  // observed nanoseconds per docid
+        size_t                assigned;    // only touched by the owner
+        uint32_t              chunk_size;  // size of last chunk taken
+        clock::time_point     chunk_start; // when last chunk was taken
+        Worker() : remaining(0), docid_cost(0.0), assigned(0), chunk_size(0), chunk_start() {}
+    };
+    DocidRangeSplitter       _splitter;
+    uint32_t                 _min_task;
+    double                   _target_chunk_ns;
+    std::unique_ptr<Worker[]> _workers;
+    size_t                   _num_workers;
+
+    static uint64_t pack(DocidRange range) { return ((uint64_t(range.begin) << 32) | range.end); }
+    static DocidRange unpack(uint64_t value) { return DocidRange(value >> 32, value & 0xffffffff); }
+
+    VESPA_DLL_LOCAL void update_cost(Worker &worker, clock::time_point now);
+    VESPA_DLL_LOCAL uint32_t chunk_size(const Worker &worker) const;
+    VESPA_DLL_LOCAL DocidRange take(Worker &worker, clock::time_point now);
+    VESPA_DLL_LOCAL bool steal(size_t thread_id);
+    VESPA_DLL_LOCAL DocidRange find_work(size_t thread_id, clock::time_point now);
+public:
+    WorkStealingDocidRangeScheduler(size_t num_threads, uint32_t min_task, uint32_t docid_limit,
+                                    std::chrono::nanoseconds target_chunk_time);
+    ~WorkStealingDocidRangeScheduler();
+    DocidRange first_range(size_t thread_id) override;
+    DocidRange next_range(size_t thread_id) override;
+    DocidRange total_span(size_t) const override { return _splitter.full_range(); }
+    size_t total_size(size_t thread_id) const override { return _workers[thread_id].assigned; }
+    size_t unassigned_size() const override;
+    IdleObserver make_idle_observer() const override { return IdleObserver(); }
+    DocidRange share_range(size_t, DocidRange todo) override { return todo; }
+};
+
 } // namespace proton::matching
 } // namespace proton
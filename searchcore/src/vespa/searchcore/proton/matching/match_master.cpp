@@ -4,6 +4,7 @@
 #include "docid_range_scheduler.h"
 #include "match_loop_communicator.h"
 #include "match_thread.h"
+#include <vespa/searchcore/grouping/partitionedgroupingmerger.h>
 #include <vespa/searchlib/common/featureset.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 
@@ -16,6 +17,7 @@ namespace matching {
 using namespace search::fef;
 using search::queryeval::SearchIterator;
 using search::FeatureSet;
+using search::grouping::PartitionedGroupingMerger;
 
 namespace {
 
@@ -38,9 +40,19 @@ struct TimedMatchLoopCommunicator : IMatchLoopCommunicator {
     }
 };
 
+// work stealing threads size their chunks to take about this long
+const std::chrono::milliseconds WORK_STEALING_CHUNK_TIME(1);
+const uint32_t WORK_STEALING_MIN_TASK = 64;
+
+} // namespace proton::matching::<unnamed>
+
 DocidRangeScheduler::UP
-createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs)
+MatchMaster::createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs, bool workStealing)
 {
+    if (workStealing) {
+        return std::make_unique<WorkStealingDocidRangeScheduler>(numThreads, WORK_STEALING_MIN_TASK, numDocs,
+                                                                 WORK_STEALING_CHUNK_TIME);
+    }
     if (numSearchPartitions == 0) {
         return std::make_unique<AdaptiveDocidRangeScheduler>(numThreads, 1, numDocs);
     }
@@ -50,22 +62,27 @@ createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numD
     return std::make_unique<TaskDocidRangeScheduler>(numThreads, numSearchPartitions, numDocs);
 }
 
-} // namespace proton::matching::<unnamed>
-
 ResultProcessor::Result::UP
 MatchMaster::match(const MatchParams &params,
                    vespalib::ThreadBundle &threadBundle,
                    const MatchToolsFactory &matchToolsFactory,
                    ResultProcessor &resultProcessor,
                    uint32_t distributionKey,
-                   uint32_t numSearchPartitions)
+                   uint32_t numSearchPartitions,
+                   bool partitionedGroupingMerge,
+                   bool workStealing)
 {
     fastos::StopWatch query_latency_time;
     query_latency_time.start();
     vespalib::DualMergeDirector mergeDirector(threadBundle.size());
     MatchLoopCommunicator communicator(threadBundle.size(), params.heapSize);
     TimedMatchLoopCommunicator timedCommunicator(communicator);
-    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs);
+    DocidRangeScheduler::UP scheduler = createScheduler(threadBundle.size(), numSearchPartitions, params.numDocs,
+                                                        workStealing);
+    std::unique_ptr<PartitionedGroupingMerger> groupingMerger;
+    if (partitionedGroupingMerge && (threadBundle.size() > 1)) {
+        groupingMerger = std::make_unique<PartitionedGroupingMerger>(threadBundle.size());
+    }
 
     std::vector<MatchThread::UP> threadState;
     std::vector<vespalib::Runnable*> targets;
@@ -76,7 +93,7 @@ MatchMaster::match(const MatchParams &params,
             static_cast<IMatchLoopCommunicator&>(communicator);
         threadState.emplace_back(std::make_unique<MatchThread>(i, threadBundle.size(),
                         params, matchToolsFactory, com, *scheduler,
-                        resultProcessor, mergeDirector, distributionKey));
+                        resultProcessor, mergeDirector, groupingMerger.get(), distributionKey));
         targets.push_back(threadState.back().get());
     }
     resultProcessor.prepareThreadContextCreation(threadBundle.size());
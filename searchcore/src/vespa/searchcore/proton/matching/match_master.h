@@ -13,6 +13,7 @@ namespace matching {
 
 class MatchToolsFactory;
 class MatchParams;
+class DocidRangeScheduler;
 
 /**
  * Handles overall matching and keeps track of match threads.
@@ -29,7 +30,12 @@ public:
                                       const MatchToolsFactory &matchToolsFactory,
                                       ResultProcessor &resultProcessor,
                                       uint32_t distributionKey,
-                                      uint32_t numSearchPartitions);
+                                      uint32_t numSearchPartitions,
+                                      bool partitionedGroupingMerge = false,
+                                      bool workStealing = false);
+
+    static std::unique_ptr<DocidRangeScheduler>
+    createScheduler(uint32_t numThreads, uint32_t numSearchPartitions, uint32_t numDocs, bool workStealing);
 
     static std::shared_ptr<search::FeatureSet>
     getFeatureSet(const MatchToolsFactory &matchToolsFactory,
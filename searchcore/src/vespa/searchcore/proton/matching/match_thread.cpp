@@ -10,6 +10,7 @@
 #include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/searchcore/grouping/groupingmanager.h>
 #include <vespa/searchcore/grouping/groupingcontext.h>
+#include <vespa/searchcore/grouping/partitionedgroupingmerger.h>
 #include <vespa/searchlib/common/bitvector.h>
 
 #include <vespa/log/log.h>
@@ -346,6 +347,7 @@ MatchThread::MatchThread(size_t thread_id_in,
                          DocidRangeScheduler &sched,
                          ResultProcessor &rp,
                          vespalib::DualMergeDirector &md,
+                         PartitionedGroupingMerger *gm,
                          uint32_t distributionKey) :
     thread_id(thread_id_in),
     num_threads(num_threads_in),
@@ -357,6 +359,7 @@ MatchThread::MatchThread(size_t thread_id_in,
     _distributionKey(distributionKey),
     resultProcessor(rp),
     mergeDirector(md),
+    groupingMerger(gm),
     resultContext(),
     thread_stats(),
     total_time_s(0.0),
@@ -392,6 +395,10 @@ MatchThread::run()
     total_time.stop();
     total_time_s = total_time.elapsed().sec();
     thread_stats.active_time(total_time_s - wait_time_s).wait_time(wait_time_s);
+    if (groupingMerger != nullptr) {
+        groupingMerger->merge(thread_id, resultContext->grouping.get());
+        resultContext->groupingSource.ctx = nullptr; // already merged
+    }
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
 }
 
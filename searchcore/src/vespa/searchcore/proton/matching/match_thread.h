@@ -15,6 +15,8 @@
 #include <vespa/searchlib/common/sortresults.h>
 #include <vespa/searchlib/queryeval/hitcollector.h>
 
+namespace search::grouping { class PartitionedGroupingMerger; }
+
 namespace proton::matching {
 
 /**
@@ -30,6 +32,7 @@ public:
     using RankProgram = search::fef::RankProgram;
     using LazyValue = search::fef::LazyValue;
     using Doom = vespalib::Doom;
+    using PartitionedGroupingMerger = search::grouping::PartitionedGroupingMerger;
 
 private:
     size_t                        thread_id;
@@ -42,6 +45,7 @@ private:
     uint32_t                      _distributionKey;
     ResultProcessor              &resultProcessor;
     vespalib::DualMergeDirector  &mergeDirector;
+    PartitionedGroupingMerger    *groupingMerger;
     ResultProcessor::Context::UP  resultContext;
     MatchingStats::Partition      thread_stats;
     double                        total_time_s;
@@ -102,6 +106,7 @@ public:
                 DocidRangeScheduler &sched,
                 ResultProcessor &rp,
                 vespalib::DualMergeDirector &md,
+                PartitionedGroupingMerger *gm,
                 uint32_t distributionKey);
     virtual void run() override;
     const MatchingStats::Partition &get_thread_stats() const { return thread_stats; }
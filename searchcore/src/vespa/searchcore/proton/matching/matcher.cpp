@@ -265,8 +265,12 @@ Matcher::match(const SearchRequest &request,
         MatchMaster master;
         uint32_t numSearchPartitions = NumSearchPartitions::lookup(rankProperties,
                                                                    _rankSetup->getNumSearchPartitions());
+        bool partitionedGroupingMerge = PartitionedGroupingMerge::lookup(rankProperties,
+                                                                         _rankSetup->getPartitionedGroupingMerge());
+        bool workStealing = WorkStealing::lookup(rankProperties, _rankSetup->getWorkStealing());
         ResultProcessor::Result::UP result = master.match(params, limitedThreadBundle, *mtf, rp,
-                                                          _distributionKey, numSearchPartitions);
+                                                          _distributionKey, numSearchPartitions,
+                                                          partitionedGroupingMerge, workStealing);
         my_stats = MatchMaster::getStats(std::move(master));
 
         bool wasLimited = mtf->match_limiter().was_limited();
@@ -53,11 +53,22 @@ DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::DocumentStoreMetric
       diskUsage("disk_usage", "", "Disk space usage in bytes", this),
       diskBloat("disk_bloat", "", "Disk space bloat in bytes", this),
       maxBucketSpread("max_bucket_spread", "", "Max bucket spread in underlying files (sum(unique buckets in each chunk)/unique buckets in file)", this),
-      memoryUsage(this)
+      memoryUsage(this),
+      chunkCache(this)
 { }
 
 DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::~DocumentStoreMetrics() { }
 
+DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::ChunkCacheMetrics::ChunkCacheMetrics(MetricSet *parent)
+    : MetricSet("chunk_cache", "", "Compressed chunk cache metrics for this document store", parent),
+      memoryUsage("memory_usage", "", "Memory usage of the chunk cache in bytes", this),
+      elements("elements", "", "Number of chunks in the chunk cache", this),
+      lookups("lookups", "", "Number of chunk cache lookups", this),
+      hits("hits", "", "Number of chunk cache hits", this)
+{ }
+
+DocumentDBTaggedMetrics::SubDBMetrics::DocumentStoreMetrics::ChunkCacheMetrics::~ChunkCacheMetrics() { }
+
 DocumentDBTaggedMetrics::AttributeMetrics::AttributeMetrics(MetricSet *parent)
     : MetricSet("attribute", "", "Attribute vector metrics for this document db", parent),
       resourceUsage(this)
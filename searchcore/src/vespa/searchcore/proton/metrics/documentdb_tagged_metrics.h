@@ -47,10 +47,22 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
 
         struct DocumentStoreMetrics : metrics::MetricSet
         {
+            struct ChunkCacheMetrics : metrics::MetricSet
+            {
+                metrics::LongValueMetric memoryUsage;
+                metrics::LongValueMetric elements;
+                metrics::LongCountMetric lookups;
+                metrics::LongCountMetric hits;
+
+                ChunkCacheMetrics(metrics::MetricSet *parent);
+                ~ChunkCacheMetrics();
+            };
+
             metrics::LongValueMetric diskUsage;
             metrics::LongValueMetric diskBloat;
             metrics::DoubleValueMetric maxBucketSpread;
             MemoryUsageMetrics memoryUsage;
+            ChunkCacheMetrics chunkCache;
 
             DocumentStoreMetrics(metrics::MetricSet *parent);
             ~DocumentStoreMetrics();
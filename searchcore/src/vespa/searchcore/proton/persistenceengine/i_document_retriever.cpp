@@ -2,9 +2,23 @@
 
 #include "i_document_retriever.h"
 #include <vespa/persistence/spi/read_consistency.h>
+#include <vespa/vespalib/objects/nbostream.h>
 
 namespace proton {
 
+document::SerializedDocumentView::UP
+IDocumentRetriever::getDocumentView(search::DocumentIdT lid) const {
+    document::Document::UP doc = getDocument(lid);
+    if ( ! doc) {
+        return document::SerializedDocumentView::UP();
+    }
+    vespalib::nbostream stream;
+    doc->serialize(stream);
+    auto buffer = std::make_unique<vespalib::DataBuffer>(stream.size());
+    buffer->writeBytes(stream.peek(), stream.size());
+    return std::make_unique<document::SerializedDocumentView>(getDocumentTypeRepo(), std::move(buffer));
+}
+
 void DocumentRetrieverBaseForTest::visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor, ReadConsistency readConsistency) const {
     (void) readConsistency;
     for (uint32_t lid : lids) {
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/document/fieldvalue/document.h>
+#include <vespa/document/serialization/serializeddocumentview.h>
 #include <persistence/spi/types.h>
 #include <vespa/persistence/spi/bucket.h>
 #include <vespa/persistence/spi/read_consistency.h>
@@ -36,6 +37,12 @@ public:
     virtual void getBucketMetaData(const storage::spi::Bucket &bucket, search::DocumentMetaData::Vector &result) const = 0;
     virtual search::DocumentMetaData getDocumentMetaData(const document::DocumentId &id) const = 0;
     virtual document::Document::UP getDocument(search::DocumentIdT lid) const = 0;
+    /**
+     * Returns a view of the document that only deserializes the fields
+     * that are accessed, or null if there is no document for the lid.
+     * The default implementation serializes the result of getDocument().
+     */
+    virtual document::SerializedDocumentView::UP getDocumentView(search::DocumentIdT lid) const;
     virtual ReadGuard getReadGuard() const = 0;
     virtual uint32_t getDocIdLimit() const = 0;
     /**
@@ -12,14 +12,15 @@ namespace proton {
  */
 struct AttributeWriterFactory : public IAttributeWriterFactory
 {
-    AttributeWriterFactory() {}
+    const uint32_t _batchSize;
+    AttributeWriterFactory(uint32_t batchSize = 1) : _batchSize(batchSize) {}
     virtual IAttributeWriter::SP create(const IAttributeWriter::SP &old,
                                         const AttributeCollectionSpec &attrSpec) const override
     {
         const AttributeWriter &oldAdapter = dynamic_cast<const AttributeWriter &>(*old.get());
         const proton::IAttributeManager::SP &oldMgr = oldAdapter.getAttributeManager();
         proton::IAttributeManager::SP newMgr = oldMgr->create(attrSpec);
-        return IAttributeWriter::SP(new AttributeWriter(newMgr));
+        return IAttributeWriter::SP(new AttributeWriter(newMgr, _batchSize));
     }
 };
 
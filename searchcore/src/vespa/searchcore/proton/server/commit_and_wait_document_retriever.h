@@ -41,6 +41,10 @@ public:
         _commit.commitAndWait();
         return _retriever->getDocument(lid);
     }
+    document::SerializedDocumentView::UP getDocumentView(search::DocumentIdT lid) const override {
+        _commit.commitAndWait();
+        return _retriever->getDocumentView(lid);
+    }
     void visitDocuments(const LidVector &lids, search::IDocumentVisitor &visitor,
                         ReadConsistency readConsistency) const override
     {
@@ -7,6 +7,7 @@
 #include "maintenance_controller_explorer.h"
 #include <vespa/searchcore/proton/common/state_reporter_utils.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_explorer.h>
+#include <vespa/searchcore/proton/initializer/task_timings.h>
 #include <vespa/searchcore/proton/matching/session_manager_explorer.h>
 #include <vespa/vespalib/data/slime/slime.h>
 
@@ -42,6 +43,18 @@ DocumentDBExplorer::get_state(const Inserter &inserter, bool full) const
         documents.setLong("stored", dmss.numStoredDocs());
         documents.setLong("removed", dmss.numRemovedDocs());
     }
+    auto timings = _docDb->getInitTimings();
+    if (timings) {
+        Cursor &initialization = object.setObject("initialization");
+        initialization.setLong("wallTimeMs", timings->getWallTimeMs());
+        Cursor &tasks = initialization.setArray("tasks");
+        for (const auto &timing : timings->getTimings()) {
+            Cursor &task = tasks.addObject();
+            task.setString("name", timing.name);
+            task.setLong("startMs", timing.startMs);
+            task.setLong("durationMs", timing.durationMs);
+        }
+    }
 }
 
 const vespalib::string SUB_DB = "subdb";
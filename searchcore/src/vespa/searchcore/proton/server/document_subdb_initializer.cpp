@@ -35,4 +35,10 @@ DocumentSubDbInitializer::run()
     future.wait();
 }
 
+vespalib::string
+DocumentSubDbInitializer::getName() const
+{
+    return _subDB.getName();
+}
+
 } // namespace proton
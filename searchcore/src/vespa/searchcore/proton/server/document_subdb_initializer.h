@@ -46,6 +46,7 @@ public:
     }
 
     virtual void run() override;
+    vespalib::string getName() const override;
 };
 
 } // namespace proton
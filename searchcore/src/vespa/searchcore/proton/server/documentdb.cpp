@@ -17,6 +17,7 @@
 #include <vespa/searchcore/proton/common/statusreport.h>
 #include <vespa/searchcore/proton/index/index_writer.h>
 #include <vespa/searchcore/proton/initializer/task_runner.h>
+#include <vespa/searchcore/proton/initializer/task_timings.h>
 #include <vespa/searchcore/proton/metrics/attribute_metrics_collection.h>
 #include <vespa/searchcore/proton/metrics/metricswireservice.h>
 #include <vespa/searchcore/proton/reference/i_document_db_reference_resolver.h>
@@ -55,6 +56,7 @@ using storage::spi::Timestamp;
 using search::common::FileHeaderContext;
 using proton::initializer::InitializerTask;
 using proton::initializer::TaskRunner;
+using proton::initializer::TaskTimings;
 using vespalib::makeLambdaTask;
 using searchcorespi::IFlushTarget;
 
@@ -110,6 +112,7 @@ DocumentDB::DocumentDB(const vespalib::string &baseDir,
       _activeConfigSnapshot(),
       _activeConfigSnapshotGeneration(0),
       _activeConfigSnapshotSerialNum(0u),
+      _initTimings(),
       _initGate(),
       _clusterStateHandler(_writeService.master()),
       _bucketHandler(_writeService.master()),
@@ -213,15 +216,18 @@ DocumentDB::internalInit()
 class InitDoneTask : public vespalib::Executor::Task {
     DocumentDB::InitializeThreads _initializeThreads;
     std::shared_ptr<TaskRunner>   _taskRunner;
+    InitializerTask::SP           _rootTask;
     DocumentDBConfig::SP          _configSnapshot;
     DocumentDB&                   _self;
 public:
     InitDoneTask(DocumentDB::InitializeThreads initializeThreads,
                  std::shared_ptr<TaskRunner> taskRunner,
+                 InitializerTask::SP rootTask,
                  DocumentDBConfig::SP configSnapshot,
                  DocumentDB& self)
         : _initializeThreads(std::move(initializeThreads)),
           _taskRunner(std::move(taskRunner)),
+          _rootTask(std::move(rootTask)),
           _configSnapshot(std::move(configSnapshot)),
           _self(self)
     {
@@ -230,6 +236,8 @@ public:
     ~InitDoneTask();
 
     void run() override {
+        _self.setInitTimings(std::make_shared<TaskTimings>(*_rootTask));
+        _rootTask.reset();
         _self.initFinish(std::move(_configSnapshot));
     }
 };
@@ -248,11 +256,25 @@ DocumentDB::initManagers()
     InitializeThreads initializeThreads = _initializeThreads;
     _initializeThreads.reset();
     std::shared_ptr<TaskRunner> taskRunner(std::make_shared<TaskRunner>(*initializeThreads));
-    auto doneTask = std::make_unique<InitDoneTask>(std::move(initializeThreads), taskRunner,
+    auto doneTask = std::make_unique<InitDoneTask>(std::move(initializeThreads), taskRunner, rootTask,
                                                    std::move(configSnapshot), *this);
     taskRunner->runTask(rootTask, _writeService.master(), std::move(doneTask));
 }
 
+void
+DocumentDB::setInitTimings(std::shared_ptr<const TaskTimings> timings)
+{
+    lock_guard guard(_configMutex);
+    _initTimings = std::move(timings);
+}
+
+std::shared_ptr<const TaskTimings>
+DocumentDB::getInitTimings() const
+{
+    lock_guard guard(_configMutex);
+    return _initTimings;
+}
+
 void
 DocumentDB::initFinish(DocumentDBConfig::SP configSnapshot)
 {
@@ -1199,6 +1221,11 @@ updateDocumentStoreMetrics(DocumentDBTaggedMetrics::SubDBMetrics::
     metrics.diskBloat.set(storageStats.diskBloat());
     metrics.maxBucketSpread.set(storageStats.maxBucketSpread());
     metrics.memoryUsage.update(backingStore.getMemoryUsage());
+    CacheStats chunkCacheStats = backingStore.getChunkCacheStats();
+    metrics.chunkCache.memoryUsage.set(chunkCacheStats.memory_used);
+    metrics.chunkCache.elements.set(chunkCacheStats.elements);
+    metrics.chunkCache.lookups.set(chunkCacheStats.hits + chunkCacheStats.misses);
+    metrics.chunkCache.hits.set(chunkCacheStats.hits);
 }
 
 template <typename MetricSetType>
@@ -45,6 +45,7 @@ class MetricsWireService;
 class StatusReport;
 
 namespace matching { class SessionManager; }
+namespace initializer { class TaskTimings; }
 
 /**
  * The document database contains all the necessary structures required per
@@ -101,6 +102,7 @@ private:
     DocumentDBConfig::SP          _activeConfigSnapshot;
     int64_t                       _activeConfigSnapshotGeneration;
     SerialNum                     _activeConfigSnapshotSerialNum;
+    std::shared_ptr<const initializer::TaskTimings> _initTimings; // protected by _configMutex
 
     vespalib::Gate                _initGate;
 
@@ -138,6 +140,7 @@ private:
     void internalInit();
     void initManagers();
     void initFinish(DocumentDBConfig::SP configSnapshot);
+    void setInitTimings(std::shared_ptr<const initializer::TaskTimings> timings);
     void performReconfig(DocumentDBConfig::SP configSnapshot);
     void closeSubDBs();
 
@@ -250,6 +253,12 @@ public:
                InitializeThreads initializeThreads,
                const HwInfo &hwInfo);
 
+    /**
+     * Returns the timings of the initializer tasks run when loading this
+     * document db, or an empty pointer if initialization is not done.
+     */
+    std::shared_ptr<const initializer::TaskTimings> getInitTimings() const;
+
     /**
      * Expose a cost view of the session manager. This is used by the
      * document db explorer.
@@ -16,6 +16,7 @@ using document::Document;
 using document::DocumentType;
 using document::DocumentTypeRepo;
 using document::PositionDataType;
+using document::SerializedDocumentView;
 using document::StructFieldValue;
 using document::FieldValue;
 using search::AttributeGuard;
@@ -112,6 +113,50 @@ private:
     search::IDocumentVisitor & _visitor;
 };
 
+/**
+ * Document view where fields backed by attributes are read from the
+ * attributes, as done for documents returned by getDocument().
+ */
+class PopulatingDocumentView : public SerializedDocumentView
+{
+public:
+    PopulatingDocumentView(const DocumentRetriever & retriever, DocumentIdT lid, vespalib::DataBuffer::UP buffer)
+        : SerializedDocumentView(retriever.getDocumentTypeRepo(), std::move(buffer)),
+          _retriever(retriever),
+          _lid(lid)
+    { }
+
+    bool hasValue(const document::Field & field) const override {
+        if ( ! _retriever.isPopulatedField(field)) {
+            return SerializedDocumentView::hasValue(field);
+        }
+        return bool(getValue(field));
+    }
+
+    FieldValue::UP getValue(const document::Field & field) const override {
+        FieldValue::UP stored = SerializedDocumentView::getValue(field);
+        if ( ! _retriever.isPopulatedField(field)) {
+            return stored;
+        }
+        Document doc(getType(), getId());
+        if (stored) {
+            doc.setValue(field, *stored);
+        }
+        _retriever.populate(_lid, doc, field);
+        return doc.getValue(field);
+    }
+
+    Document::UP createDocument() const override {
+        Document::UP doc = SerializedDocumentView::createDocument();
+        _retriever.populate(_lid, *doc);
+        return doc;
+    }
+
+private:
+    const DocumentRetriever & _retriever;
+    DocumentIdT               _lid;
+};
+
 }  // namespace
 
 Document::UP DocumentRetriever::getDocument(DocumentIdT lid) const
@@ -123,6 +168,15 @@ Document::UP DocumentRetriever::getDocument(DocumentIdT lid) const
     return doc;
 }
 
+SerializedDocumentView::UP DocumentRetriever::getDocumentView(DocumentIdT lid) const
+{
+    auto buffer = std::make_unique<vespalib::DataBuffer>();
+    if ( ! _doc_store.readSerialized(lid, *buffer)) {
+        return SerializedDocumentView::UP();
+    }
+    return std::make_unique<PopulatingDocumentView>(*this, lid, std::move(buffer));
+}
+
 void DocumentRetriever::visitDocuments(const LidVector & lids, search::IDocumentVisitor & visitor, ReadConsistency) const
 {
     PopulateVisitor populater(*this, visitor);
@@ -138,6 +192,34 @@ void DocumentRetriever::populate(DocumentIdT lid, Document & doc) const
     fillInPositionFields(doc, lid, _possiblePositionFields, _attr_manager);
 }
 
+bool DocumentRetriever::isPopulatedField(const document::Field & field) const
+{
+    for (const auto &name : _attributeFields) {
+        if (name == field.getName()) {
+            return true;
+        }
+    }
+    for (const auto &it : _possiblePositionFields) {
+        if (*it.first == field) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DocumentRetriever::populate(DocumentIdT lid, Document & doc, const document::Field & field) const
+{
+    const vespalib::string &name = field.getName();
+    for (const auto &it : _possiblePositionFields) {
+        if (*it.first == field) {
+            fillInPositionFields(doc, lid, PositionFields(1, it), _attr_manager);
+            return;
+        }
+    }
+    AttributeGuard::UP attr = _attr_manager.getAttribute(name);
+    DocumentFieldRetriever::populate(lid, doc, name, **attr, _schema.isIndexField(name));
+}
+
 const IAttributeManager *
 DocumentRetriever::getAttrMgr() const
 {
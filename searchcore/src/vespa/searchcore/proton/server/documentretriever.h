@@ -25,8 +25,13 @@ public:
                       const search::IDocumentStore &doc_store);
 
     document::Document::UP getDocument(search::DocumentIdT lid) const override;
+    document::SerializedDocumentView::UP getDocumentView(search::DocumentIdT lid) const override;
     void visitDocuments(const LidVector & lids, search::IDocumentVisitor & visitor, ReadConsistency) const override;
     void populate(search::DocumentIdT lid, document::Document & doc) const;
+    /** Returns true if the value of the given field is taken from an attribute. */
+    bool isPopulatedField(const document::Field & field) const;
+    /** Populates a single field from its attribute. The field must be a populated field. */
+    void populate(search::DocumentIdT lid, document::Document & doc, const document::Field & field) const;
 private:
     const search::index::Schema     &_schema;
     const search::IAttributeManager &_attr_manager;
@@ -67,6 +67,7 @@ DocumentSubDBCollection::DocumentSubDBCollection(
     GrowStrategy notReadyGrowth = makeGrowStrategy(growCfg.initial * (distCfg.redundancy - distCfg.searchablecopies), growCfg);
     size_t attributeGrowNumDocs(growCfg.numdocs);
     size_t numSearcherThreads = protonCfg.numsearcherthreads;
+    uint32_t attributeBatchSize = std::max(1, protonCfg.feeding.attributebatchsize);
 
     StoreOnlyDocSubDB::Context context(owner,
                                        tlSyncer,
@@ -91,7 +92,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                         SubDbType::READY),
                         true,
                         true,
-                        false),
+                        false,
+                        attributeBatchSize),
                         numSearcherThreads),
                 SearchableDocSubDB::Context(FastAccessDocSubDB::Context
                         (context,
@@ -122,7 +124,8 @@ DocumentSubDBCollection::DocumentSubDBCollection(
                         SubDbType::NOTREADY),
                         true,
                         true,
-                        true),
+                        true,
+                        attributeBatchSize),
                 FastAccessDocSubDB::Context(context,
                         AttributeMetricsCollection(metrics.getTaggedMetrics().notReady.attributes,
                                                    metrics.getLegacyMetrics().notReady.attributes),
@@ -207,6 +207,7 @@ FastAccessDocSubDB::FastAccessDocSubDB(const Config &cfg, const Context &ctx)
       _subAttributeMetrics(ctx._subAttributeMetrics),
       _totalAttributeMetrics(ctx._totalAttributeMetrics),
       _addMetrics(cfg._addMetrics),
+      _attributeBatchSize(cfg._attributeBatchSize),
       _metricsWireService(ctx._metricsWireService),
       _docIdLimit(0)
 { }
@@ -241,7 +242,7 @@ FastAccessDocSubDB::initViews(const DocumentDBConfig &configSnapshot,
     // Called by executor thread
     (void) sessionManager;
     _iSearchView.set(ISearchHandler::SP(new EmptySearchView));
-    IAttributeWriter::SP writer(new AttributeWriter(getAndResetInitAttributeManager()));
+    IAttributeWriter::SP writer(new AttributeWriter(getAndResetInitAttributeManager(), _attributeBatchSize));
     {
         std::lock_guard<std::mutex> guard(_configMutex);
         initFeedView(writer, configSnapshot);
@@ -268,7 +269,7 @@ FastAccessDocSubDB::applyConfig(const DocumentDBConfig &newConfigSnapshot, const
         params.shouldAttributeWriterChange() ||
         newConfigSnapshot.getDocumentTypeRepoSP().get() != oldConfigSnapshot.getDocumentTypeRepoSP().get()) {
         FastAccessDocSubDBConfigurer configurer(_fastAccessFeedView,
-                std::make_unique<AttributeWriterFactory>(), getSubDbName());
+                std::make_unique<AttributeWriterFactory>(_attributeBatchSize), getSubDbName());
         proton::IAttributeManager::SP oldMgr = extractAttributeManager(_fastAccessFeedView.get());
         AttributeCollectionSpec::UP attrSpec =
             createAttributeSpec(newConfigSnapshot.getAttributesConfig(), serialNum);
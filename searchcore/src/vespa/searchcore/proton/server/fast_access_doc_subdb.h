@@ -31,14 +31,17 @@ public:
         const bool                      _hasAttributes;
         const bool                      _addMetrics;
         const bool                      _fastAccessAttributesOnly;
+        const uint32_t                  _attributeBatchSize;
         Config(const StoreOnlyDocSubDB::Config &storeOnlyCfg,
                bool hasAttributes,
                bool addMetrics,
-               bool fastAccessAttributesOnly)
+               bool fastAccessAttributesOnly,
+               uint32_t attributeBatchSize = 1)
         : _storeOnlyCfg(storeOnlyCfg),
           _hasAttributes(hasAttributes),
           _addMetrics(addMetrics),
-          _fastAccessAttributesOnly(fastAccessAttributesOnly)
+          _fastAccessAttributesOnly(fastAccessAttributesOnly),
+          _attributeBatchSize(attributeBatchSize)
         { }
     };
 
@@ -85,6 +88,7 @@ protected:
     using SessionManagerSP = std::shared_ptr<matching::SessionManager>;
 
     const bool           _addMetrics;
+    const uint32_t       _attributeBatchSize;
     MetricsWireService  &_metricsWireService;
     DocIdLimit           _docIdLimit;
 
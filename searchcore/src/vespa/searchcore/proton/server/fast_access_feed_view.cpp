@@ -5,11 +5,13 @@
 #include "operationdonecontext.h"
 #include "removedonecontext.h"
 #include "putdonecontext.h"
+#include <vespa/vespalib/util/lambdatask.h>
 
 using document::Document;
 using document::DocumentUpdate;
 using document::FieldUpdate;
 using search::index::Schema;
+using vespalib::makeLambdaTask;
 
 namespace proton {
 
@@ -39,17 +41,38 @@ void
 FastAccessFeedView::putAttributes(SerialNum serialNum, search::DocumentIdT lid, const Document &doc,
                                   bool immediateCommit, OnPutDoneType onWriteDone)
 {
+    bool hadPendingBatches = _attributeWriter->hasPendingBatches();
     _attributeWriter->put(serialNum, doc, lid, immediateCommit, onWriteDone);
     if (immediateCommit && onWriteDone) {
         onWriteDone->registerPutLid(&_docIdLimit);
     }
+    scheduleFlushPendingBatches(hadPendingBatches);
 }
 
 void
 FastAccessFeedView::updateAttributes(SerialNum serialNum, search::DocumentIdT lid, const DocumentUpdate &upd,
                                      bool immediateCommit, OnOperationDoneType onWriteDone)
 {
+    bool hadPendingBatches = _attributeWriter->hasPendingBatches();
     _attributeWriter->update(serialNum, upd, lid, immediateCommit, onWriteDone);
+    scheduleFlushPendingBatches(hadPendingBatches);
+}
+
+/**
+ * When an operation starts a new attribute write batch, a flush of it is
+ * queued behind the operations already waiting for the master thread. The
+ * batch is thereby handed on when the current feed window is drained, even
+ * if it never fills up. The task keeps the attribute writer alive across
+ * reconfig; a replaced writer has already been flushed by forceCommit.
+ */
+void
+FastAccessFeedView::scheduleFlushPendingBatches(bool hadPendingBatches)
+{
+    if (!hadPendingBatches && _attributeWriter->hasPendingBatches()) {
+        IAttributeWriter::SP attributeWriter = _attributeWriter;
+        _writeService.master().execute(makeLambdaTask([attributeWriter]()
+                                                      { attributeWriter->flushPendingBatches(); }));
+    }
 }
 
 void
@@ -55,6 +55,8 @@ private:
 
     void heartBeatAttributes(SerialNum serialNum) override;
 
+    void scheduleFlushPendingBatches(bool hadPendingBatches);
+
 protected:
     void forceCommit(SerialNum serialNum, OnForceCommitDoneType onCommitDone) override;
 
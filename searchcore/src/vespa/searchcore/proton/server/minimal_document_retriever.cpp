@@ -5,6 +5,7 @@
 
 using document::Document;
 using document::DocumentTypeRepo;
+using document::SerializedDocumentView;
 using search::DocumentIdT;
 using search::IDocumentStore;
 
@@ -25,6 +26,14 @@ Document::UP MinimalDocumentRetriever::getDocument(DocumentIdT lid) const {
     return _doc_store.read(lid, *_repo);
 }
 
+SerializedDocumentView::UP MinimalDocumentRetriever::getDocumentView(DocumentIdT lid) const {
+    auto buffer = std::make_unique<vespalib::DataBuffer>();
+    if ( ! _doc_store.readSerialized(lid, *buffer)) {
+        return SerializedDocumentView::UP();
+    }
+    return std::make_unique<SerializedDocumentView>(*_repo, std::move(buffer));
+}
+
 void MinimalDocumentRetriever::visitDocuments(const LidVector & lids, search::IDocumentVisitor & visitor, ReadConsistency) const {
     _doc_store.visit(lids, getDocumentTypeRepo(), visitor);
 }
@@ -28,6 +28,7 @@ public:
                              bool hasFields);
 
     document::Document::UP getDocument(search::DocumentIdT lid) const override;
+    document::SerializedDocumentView::UP getDocumentView(search::DocumentIdT lid) const override;
     void visitDocuments(const LidVector & lids, search::IDocumentVisitor & visitor, ReadConsistency) const override;
 };
 }  // namespace proton
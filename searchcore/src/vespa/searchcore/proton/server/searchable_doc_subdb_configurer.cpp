@@ -104,7 +104,8 @@ SearchableDocSubDBConfigurer(const ISummaryManager::SP &summaryMgr,
                              matching::ConstantValueRepo &constantValueRepo,
                              const vespalib::Clock &clock,
                              const vespalib::string &subDbName,
-                             uint32_t distributionKey) :
+                             uint32_t distributionKey,
+                             uint32_t attributeBatchSize) :
     _summaryMgr(summaryMgr),
     _searchView(searchView),
     _feedView(feedView),
@@ -112,7 +113,8 @@ SearchableDocSubDBConfigurer(const ISummaryManager::SP &summaryMgr,
     _constantValueRepo(constantValueRepo),
     _clock(clock),
     _subDbName(subDbName),
-    _distributionKey(distributionKey)
+    _distributionKey(distributionKey),
+    _attributeBatchSize(attributeBatchSize)
 { }
 
 SearchableDocSubDBConfigurer::~SearchableDocSubDBConfigurer() { }
@@ -217,13 +219,13 @@ SearchableDocSubDBConfigurer::reconfigure(const DocumentDBConfig &newConfig,
         attrMgr = newAttrMgr;
         shouldMatchViewChange = true;
 
-        IAttributeWriter::SP newAttrWriter(new AttributeWriter(newAttrMgr));
+        IAttributeWriter::SP newAttrWriter(new AttributeWriter(newAttrMgr, _attributeBatchSize));
         attrWriter = newAttrWriter;
         shouldFeedViewChange = true;
         initializer.reset(createAttributeReprocessingInitializer(newConfig, newAttrMgr,
                                                                  oldConfig, oldAttrMgr, _subDbName, attrSpec.getCurrentSerialNum()).release());
     } else if (params.shouldAttributeWriterChange()) {
-        attrWriter = std::make_shared<AttributeWriter>(attrMgr);
+        attrWriter = std::make_shared<AttributeWriter>(attrMgr, _attributeBatchSize);
         shouldFeedViewChange = true;
     }
 
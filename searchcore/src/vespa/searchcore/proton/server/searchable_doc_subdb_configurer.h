@@ -45,6 +45,7 @@ private:
     const vespalib::Clock       &_clock;
     vespalib::string             _subDbName;
     uint32_t                     _distributionKey;
+    uint32_t                     _attributeBatchSize;
 
     void
     reconfigureFeedView(const SearchView::SP &searchView);
@@ -82,7 +83,8 @@ public:
                                  matching::ConstantValueRepo &constantValueRepo,
                                  const vespalib::Clock &clock,
                                  const vespalib::string &subDbName,
-                                 uint32_t distributionKey);
+                                 uint32_t distributionKey,
+                                 uint32_t attributeBatchSize = 1);
     ~SearchableDocSubDBConfigurer();
 
     Matchers::UP
@@ -47,7 +47,8 @@ SearchableDocSubDB::SearchableDocSubDB(const Config &cfg, const Context &ctx)
       _constantValueCache(_tensorLoader),
       _constantValueRepo(_constantValueCache),
       _configurer(_iSummaryMgr, _rSearchView, _rFeedView, ctx._queryLimiter, _constantValueRepo, ctx._clock,
-                  getSubDbName(), ctx._fastUpdCtx._storeOnlyCtx._owner.getDistributionKey()),
+                  getSubDbName(), ctx._fastUpdCtx._storeOnlyCtx._owner.getDistributionKey(),
+                  cfg._fastUpdCfg._attributeBatchSize),
       _numSearcherThreads(cfg._numSearcherThreads),
       _warmupExecutor(ctx._warmupExecutor),
       _realGidToLidChangeHandler(std::make_shared<GidToLidChangeHandler>()),
@@ -103,6 +104,8 @@ createIndexManagerInitializer(const DocumentDBConfig &configSnapshot,
          searchcorespi::index::WarmupConfig(indexCfg.warmup.time, indexCfg.warmup.unpack),
          indexCfg.maxflushed,
          indexCfg.cache.size,
+         indexCfg.fusion.threads,
+         indexCfg.fusion.memorybudget,
          *schema,
          configSerialNum,
          const_cast<SearchableDocSubDB &>(*this),
@@ -232,7 +235,7 @@ SearchableDocSubDB::initViews(const DocumentDBConfig &configSnapshot, const Sess
                                               matchView->getAttributeManager()),
                                       matchView)));
 
-    IAttributeWriter::SP attrWriter(new AttributeWriter(attrMgr));
+    IAttributeWriter::SP attrWriter(new AttributeWriter(attrMgr, _attributeBatchSize));
     {
         std::lock_guard<std::mutex> guard(_configMutex);
         initFeedView(attrWriter, configSnapshot);
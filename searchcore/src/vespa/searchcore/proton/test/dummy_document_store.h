@@ -21,6 +21,9 @@ struct DummyDocumentStore : public search::IDocumentStore
                                         const document::DocumentTypeRepo &) const override {
         return document::Document::UP();
     }
+    virtual bool readSerialized(search::DocumentIdT, vespalib::DataBuffer &) const override {
+        return false;
+    }
     virtual void write(uint64_t, search::DocumentIdT, const document::Document &) override {}
     virtual void write(uint64_t, search::DocumentIdT, const vespalib::nbostream &) override {}
     virtual void remove(uint64_t, search::DocumentIdT) override {}
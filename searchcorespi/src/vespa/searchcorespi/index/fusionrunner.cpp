@@ -19,6 +19,7 @@ using search::common::FileHeaderContext;
 using search::common::SerialNumFileHeaderContext;
 using search::index::Schema;
 using search::queryeval::ISourceSelector;
+using search::diskindex::FusionProgress;
 using search::diskindex::SelectorArray;
 using search::SerialNum;
 using std::vector;
@@ -82,7 +83,8 @@ writeFusionSelector(const IndexDiskLayout &diskLayout, uint32_t fusion_id,
 uint32_t
 FusionRunner::fuse(const FusionSpec &fusion_spec,
                    SerialNum lastSerialNum,
-                   IIndexMaintainerOperations &operations)
+                   IIndexMaintainerOperations &operations,
+                   const FusionProgress::SP &progress)
 {
     const vector<uint32_t> &ids = fusion_spec.flush_ids;
     if (ids.empty()) {
@@ -112,7 +114,7 @@ FusionRunner::fuse(const FusionSpec &fusion_spec,
     SelectorArray selector_array;
     readSelectorArray(selector_name, selector_array, id_map, fusion_spec.last_fusion_id);
 
-    if (!operations.runFusion(_schema, fusion_dir, sources, selector_array, lastSerialNum)) {
+    if (!operations.runFusion(_schema, fusion_dir, sources, selector_array, lastSerialNum, progress)) {
         return 0;
     }
 
@@ -52,11 +52,13 @@ public:
      * @param fusion_spec the specification on which indexes to run fusion on.
      * @param lastSerialNum the serial number of the last flushed index part of the fusion spec.
      * @param operations interface used for running the actual fusion.
+     * @param progress updated with the progress of the fusion, may be empty.
      * @return the id of the fusioned disk index
      **/
     uint32_t fuse(const FusionSpec &fusion_spec,
                   search::SerialNum lastSerialNum,
-                  IIndexMaintainerOperations &operations);
+                  IIndexMaintainerOperations &operations,
+                  const search::diskindex::FusionProgress::SP &progress = search::diskindex::FusionProgress::SP());
 };
 
 }  // namespace index
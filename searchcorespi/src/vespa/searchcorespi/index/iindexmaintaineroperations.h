@@ -6,6 +6,7 @@
 #include <vespa/searchcommon/common/schema.h>
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/searchlib/diskindex/docidmapper.h>
+#include <vespa/searchlib/diskindex/fusionprogress.h>
 
 namespace searchcorespi {
 namespace index {
@@ -42,12 +43,14 @@ struct IIndexMaintainerOperations {
      * @param sources the directories of the input disk indexes.
      * @param selectorArray the array specifying in which input disk index a document is located.
      * @param lastSerialNum the serial number of the last operation in the last input disk index.
+     * @param progress updated with the progress of the fusion, may be empty.
      */
     virtual bool runFusion(const search::index::Schema &schema,
                            const vespalib::string &outputDir,
                            const std::vector<vespalib::string> &sources,
                            const search::diskindex::SelectorArray &selectorArray,
-                           search::SerialNum lastSerialNum) = 0;
+                           search::SerialNum lastSerialNum,
+                           const search::diskindex::FusionProgress::SP &progress) = 0;
 };
 
 } // namespace index
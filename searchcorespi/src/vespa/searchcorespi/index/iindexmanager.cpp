@@ -7,4 +7,10 @@ IIndexManager::Reconfigurer::~Reconfigurer()
 {
 }
 
+std::shared_ptr<const search::diskindex::FusionProgress>
+IIndexManager::getFusionProgress() const
+{
+    return std::shared_ptr<const search::diskindex::FusionProgress>();
+}
+
 } // namespace searchcorespi
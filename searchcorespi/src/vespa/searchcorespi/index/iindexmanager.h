@@ -14,6 +14,8 @@ namespace search
 
 class IDestructorCallback;
 
+namespace diskindex { class FusionProgress; }
+
 }
 
 namespace searchcorespi {
@@ -164,6 +166,12 @@ public:
      * @param maxFlushed   The max number of flushed indexes before fusion is urgent.
      */
     virtual void setMaxFlushed(uint32_t maxFlushed) = 0;
+
+    /**
+     * Returns the progress of the running or most recently completed
+     * fusion, or an empty pointer if no fusion has been started.
+     */
+    virtual std::shared_ptr<const search::diskindex::FusionProgress> getFusionProgress() const;
 };
 
 } // namespace searchcorespi
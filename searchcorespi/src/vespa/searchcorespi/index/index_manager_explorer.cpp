@@ -3,11 +3,13 @@
 #include "index_manager_explorer.h"
 #include "index_manager_stats.h"
 
+#include <vespa/searchlib/diskindex/fusionprogress.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 
 using vespalib::slime::Cursor;
 using vespalib::slime::Inserter;
 using search::SearchableStats;
+using search::diskindex::FusionProgress;
 using searchcorespi::index::DiskIndexStats;
 using searchcorespi::index::MemoryIndexStats;
 
@@ -45,6 +47,26 @@ insertMemoryIndex(Cursor &arrayCursor, const MemoryIndexStats &memoryIndex)
     insertMemoryUsage(memoryIndexCursor, sstats.memoryUsage());
 }
 
+void
+insertFusion(Cursor &object, const FusionProgress &progress)
+{
+    Cursor &fusion = object.setObject("fusion");
+    fusion.setBool("done", progress.isDone());
+    fusion.setLong("elapsedMs", progress.getElapsedMs());
+    fusion.setLong("threads", progress.getNumThreads());
+    fusion.setLong("memoryBudget", progress.getMemoryBudget());
+    fusion.setLong("fieldsDone", progress.getNumDoneFields());
+    Cursor &fields = fusion.setArray("fields");
+    for (const auto &field : progress.getFields()) {
+        Cursor &fieldCursor = fields.addObject();
+        fieldCursor.setString("name", field.name);
+        fieldCursor.setString("state", FusionProgress::toString(field.state));
+        fieldCursor.setLong("memoryEstimate", field.memoryEstimate);
+        fieldCursor.setLong("numWordIds", field.numWordIds);
+        fieldCursor.setLong("durationMs", field.getDurationMs());
+    }
+}
+
 }
 
 
@@ -68,6 +90,10 @@ IndexManagerExplorer::get_state(const Inserter &inserter, bool full) const
         for (const auto &memoryIndex : stats.getMemoryIndexes()) {
             insertMemoryIndex(memoryIndexArrayCursor, memoryIndex);
         }
+        auto fusionProgress = _mgr->getFusionProgress();
+        if (fusionProgress) {
+            insertFusion(object, *fusionProgress);
+        }
     }
 }
 
@@ -28,6 +28,7 @@ using search::FixedSourceSelector;
 using search::TuneFileAttributes;
 using search::index::Schema;
 using search::common::FileHeaderContext;
+using search::diskindex::FusionProgress;
 using search::queryeval::ISourceSelector;
 using search::queryeval::Source;
 using search::SerialNum;
@@ -824,6 +825,7 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
       _remove_lock(),
       _fusion_spec(),
       _fusion_lock(),
+      _fusion_progress(),
       _maxFlushed(config.getMaxFlushed()),
       _maxFrozen(10),
       _changeGens(),
@@ -982,8 +984,13 @@ IndexMaintainer::runFusion(const FusionSpec &fusion_spec)
     if (FastOS_File::Stat(lastSerialFile.c_str(), &statInfo)) {
         serialNum = IndexReadUtilities::readSerialNum(lastFlushDir);
     }
+    auto progress = std::make_shared<FusionProgress>();
+    {
+        LockGuard lock(_fusion_lock);
+        _fusion_progress = progress;
+    }
     FusionRunner fusion_runner(_base_dir, args._schema, tuneFileAttributes, _ctx.getFileHeaderContext());
-    uint32_t new_fusion_id = fusion_runner.fuse(fusion_spec, serialNum, _operations);
+    uint32_t new_fusion_id = fusion_runner.fuse(fusion_spec, serialNum, _operations, progress);
     bool ok = (new_fusion_id != 0);
     if (ok) {
         ok = IndexWriteUtilities::copySerialNumFile(getFlushDir(fusion_spec.flush_ids.back()),
@@ -1235,5 +1242,12 @@ IndexMaintainer::setMaxFlushed(uint32_t maxFlushed)
     _maxFlushed = maxFlushed;
 }
 
+std::shared_ptr<const FusionProgress>
+IndexMaintainer::getFusionProgress() const
+{
+    LockGuard lock(_fusion_lock);
+    return _fusion_progress;
+}
+
 }  // namespace index
 }  // namespace searchcorespi
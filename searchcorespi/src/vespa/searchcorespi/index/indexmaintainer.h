@@ -144,6 +144,7 @@ class IndexMaintainer : public IIndexManager,
     // Protected by SL + IUL
     FusionSpec     _fusion_spec;		// Protected by FL
     vespalib::Lock _fusion_lock;	// Fusion spec lock (FL)
+    search::diskindex::FusionProgress::SP _fusion_progress; // Protected by FL
     uint32_t       _maxFlushed;
     uint32_t       _maxFrozen;
     ChangeGens     _changeGens; // Protected by SL + IUL
@@ -384,6 +385,7 @@ public:
     IFlushTarget::List getFlushTargets() override;
     void setSchema(const Schema & schema, SerialNum serialNum) override ;
     void setMaxFlushed(uint32_t maxFlushed) override;
+    std::shared_ptr<const search::diskindex::FusionProgress> getFusionProgress() const override;
 };
 
 } // namespace index
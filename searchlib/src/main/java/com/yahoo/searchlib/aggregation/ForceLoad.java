@@ -25,6 +25,8 @@ public class ForceLoad {
                 "CountAggregationResult",
                 "AverageAggregationResult",
                 "ExpressionCountAggregationResult",
+                "QuantileAggregationResult",
+                "TopKAggregationResult",
                 "hll.SparseSketch",
                 "hll.NormalSketch"
         };
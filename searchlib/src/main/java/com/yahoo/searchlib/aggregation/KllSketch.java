@@ -0,0 +1,245 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.vespa.objects.Deserializer;
+import com.yahoo.vespa.objects.Serializer;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.List;
+
+/**
+ * KLL sketch used to estimate quantiles of a stream of values in bounded memory. This is the Java counterpart of the
+ * C++ search::KllSketch, and the two must serialize identically. Values are kept in a set of levels, where each value
+ * on level h represents 2^h values seen. When the sketch is full, the lowest level exceeding its capacity is sorted
+ * and every other value is promoted to the level above. Sketches with the same k can be merged.
+ */
+public class KllSketch {
+
+    public static final int DEFAULT_K = 200;
+    // Smallest capacity of any level, which keeps the lowest levels from compacting on every insert.
+    private static final int MIN_LEVEL_CAPACITY = 8;
+    private static final double CAPACITY_DECAY = 2.0 / 3.0;
+
+    private int k;
+    private long count = 0;
+    private double min = Double.MAX_VALUE;
+    private double max = -Double.MAX_VALUE;
+    private List<List<Double>> levels = new ArrayList<>();
+    private int size = 0;
+    private int capacity = 0;
+    private int compactions = 0;
+
+    public KllSketch() {
+        this(DEFAULT_K);
+    }
+
+    public KllSketch(int k) {
+        this.k = Math.max(k, MIN_LEVEL_CAPACITY);
+        levels.add(new ArrayList<>());
+        updateCapacity();
+    }
+
+    public KllSketch(KllSketch rhs) {
+        k = rhs.k;
+        count = rhs.count;
+        min = rhs.min;
+        max = rhs.max;
+        for (List<Double> values : rhs.levels) {
+            levels.add(new ArrayList<>(values));
+        }
+        size = rhs.size;
+        capacity = rhs.capacity;
+        compactions = rhs.compactions;
+    }
+
+    public int getK() {
+        return k;
+    }
+
+    public long getCount() {
+        return count;
+    }
+
+    public double getMin() {
+        return min;
+    }
+
+    public double getMax() {
+        return max;
+    }
+
+    public int getNumRetained() {
+        return size;
+    }
+
+    public void add(double value) {
+        ++count;
+        min = Math.min(min, value);
+        max = Math.max(max, value);
+        levels.get(0).add(value);
+        if (++size > capacity) {
+            compress();
+        }
+    }
+
+    public void merge(KllSketch other) {
+        if (other.k != k) {
+            throw new IllegalArgumentException("Can not merge KLL sketches with different k");
+        }
+        while (levels.size() < other.levels.size()) {
+            levels.add(new ArrayList<>());
+        }
+        updateCapacity();
+        for (int level = 0; level < other.levels.size(); ++level) {
+            levels.get(level).addAll(other.levels.get(level));
+        }
+        size += other.size;
+        count += other.count;
+        min = Math.min(min, other.min);
+        max = Math.max(max, other.max);
+        compress();
+    }
+
+    /**
+     * Estimates the value at the given quantile (0.0 - 1.0). The exact min and max values are returned for 0.0 and
+     * 1.0.
+     *
+     * @param q The quantile to estimate.
+     * @return The estimated value.
+     */
+    public double quantile(double q) {
+        if (count == 0) {
+            return 0.0;
+        }
+        if (q <= 0.0) {
+            return min;
+        }
+        if (q >= 1.0) {
+            return max;
+        }
+        List<double[]> weighted = new ArrayList<>(size);
+        long total = 0;
+        for (int level = 0; level < levels.size(); ++level) {
+            for (double value : levels.get(level)) {
+                weighted.add(new double[] { value, (double)(1L << level) });
+            }
+            total += ((long)levels.get(level).size()) << level;
+        }
+        weighted.sort((a, b) -> Double.compare(a[0], b[0]));
+        double target = q * total;
+        long seen = 0;
+        for (double[] entry : weighted) {
+            seen += (long)entry[1];
+            if (seen >= target) {
+                return entry[0];
+            }
+        }
+        return max;
+    }
+
+    private int levelCapacity(int level) {
+        int depth = levels.size() - level - 1;
+        int levelCapacity = (int)Math.ceil(k * Math.pow(CAPACITY_DECAY, depth));
+        return Math.max(levelCapacity, MIN_LEVEL_CAPACITY);
+    }
+
+    private void updateCapacity() {
+        capacity = 0;
+        for (int level = 0; level < levels.size(); ++level) {
+            capacity += levelCapacity(level);
+        }
+    }
+
+    private void compact(int level) {
+        if (level + 1 == levels.size()) {
+            levels.add(new ArrayList<>());
+            updateCapacity();
+        }
+        List<Double> values = levels.get(level);
+        Collections.sort(values);
+        // an odd value out stays on this level
+        Double keep = null;
+        if ((values.size() % 2) != 0) {
+            keep = values.remove(values.size() - 1);
+        }
+        // alternate which half survives to avoid a systematic bias
+        int offset = (compactions++ % 2);
+        List<Double> above = levels.get(level + 1);
+        for (int i = offset; i < values.size(); i += 2) {
+            above.add(values.get(i));
+        }
+        size -= values.size() / 2;
+        values.clear();
+        if (keep != null) {
+            values.add(keep);
+        }
+    }
+
+    private void compress() {
+        while (size > capacity) {
+            for (int level = 0; level < levels.size(); ++level) {
+                if (levels.get(level).size() >= levelCapacity(level)) {
+                    compact(level);
+                    break;
+                }
+            }
+        }
+    }
+
+    public void serialize(Serializer buf) {
+        buf.putInt(null, k);
+        buf.putLong(null, count);
+        buf.putDouble(null, min);
+        buf.putDouble(null, max);
+        buf.putInt(null, levels.size());
+        for (List<Double> values : levels) {
+            buf.putInt(null, values.size());
+            for (double value : values) {
+                buf.putDouble(null, value);
+            }
+        }
+    }
+
+    public void deserialize(Deserializer buf) {
+        k = buf.getInt(null);
+        count = buf.getLong(null);
+        min = buf.getDouble(null);
+        max = buf.getDouble(null);
+        int numLevels = buf.getInt(null);
+        levels = new ArrayList<>();
+        size = 0;
+        for (int level = 0; level < numLevels; ++level) {
+            int numValues = buf.getInt(null);
+            List<Double> values = new ArrayList<>(numValues);
+            for (int i = 0; i < numValues; ++i) {
+                values.add(buf.getDouble(null));
+            }
+            levels.add(values);
+            size += numValues;
+        }
+        if (levels.isEmpty()) {
+            levels.add(new ArrayList<>());
+        }
+        updateCapacity();
+    }
+
+    @Override
+    public boolean equals(Object obj) {
+        if (!(obj instanceof KllSketch)) {
+            return false;
+        }
+        KllSketch rhs = (KllSketch)obj;
+        return k == rhs.k && count == rhs.count && min == rhs.min && max == rhs.max && levels.equals(rhs.levels);
+    }
+
+    @Override
+    public int hashCode() {
+        return k + 31 * Long.hashCode(count) + 31 * 31 * levels.hashCode();
+    }
+
+    @Override
+    public String toString() {
+        return "KllSketch{k=" + k + ", count=" + count + ", min=" + min + ", max=" + max + ", levels=" + levels + "}";
+    }
+}
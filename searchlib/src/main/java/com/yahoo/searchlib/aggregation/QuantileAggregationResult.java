@@ -0,0 +1,105 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.FloatResultNode;
+import com.yahoo.searchlib.expression.ResultNode;
+import com.yahoo.vespa.objects.Deserializer;
+import com.yahoo.vespa.objects.ObjectVisitor;
+import com.yahoo.vespa.objects.Serializer;
+
+/**
+ * This is an aggregated result holding a KLL sketch of the values of an expression, from which quantiles can be
+ * estimated. The rank is the estimated median.
+ */
+public class QuantileAggregationResult extends AggregationResult {
+
+    public static final int classId = registerClass(0x4000 + 98, QuantileAggregationResult.class);
+    private KllSketch sketch;
+    // The estimated median. This value will not be serialized / deserialized.
+    private FloatResultNode rank = null;
+
+    /**
+     * Constructor used for deserialization. Will be instantiated with a default sketch.
+     */
+    @SuppressWarnings("UnusedDeclaration")
+    public QuantileAggregationResult() {
+        this(new KllSketch());
+    }
+
+    public QuantileAggregationResult(KllSketch sketch) {
+        this.sketch = sketch;
+    }
+
+    public KllSketch getSketch() {
+        return sketch;
+    }
+
+    /**
+     * Estimates the value at the given quantile (0.0 - 1.0).
+     *
+     * @param q The quantile to estimate.
+     * @return The estimated value.
+     */
+    public double getQuantile(double q) {
+        return sketch.quantile(q);
+    }
+
+    @Override
+    public ResultNode getRank() {
+        if (rank == null) {
+            rank = new FloatResultNode(sketch.quantile(0.5));
+        }
+        return rank;
+    }
+
+    @Override
+    protected void onMerge(AggregationResult result) {
+        sketch.merge(((QuantileAggregationResult)result).sketch);
+        // Any cached rank should be invalidated.
+        rank = null;
+    }
+
+    @Override
+    protected int onGetClassId() {
+        return classId;
+    }
+
+    @Override
+    protected void onSerialize(Serializer buf) {
+        super.onSerialize(buf);
+        sketch.serialize(buf);
+    }
+
+    @Override
+    protected void onDeserialize(Deserializer buf) {
+        super.onDeserialize(buf);
+        sketch.deserialize(buf);
+        rank = null;
+    }
+
+    @Override
+    protected boolean equalsAggregation(AggregationResult obj) {
+        return sketch.equals(((QuantileAggregationResult)obj).sketch);
+    }
+
+    @Override
+    public QuantileAggregationResult clone() {
+        QuantileAggregationResult obj = (QuantileAggregationResult)super.clone();
+        obj.sketch = new KllSketch(sketch);
+        obj.rank = null;
+        return obj;
+    }
+
+    @Override
+    public void visitMembers(ObjectVisitor visitor) {
+        super.visitMembers(visitor);
+        visitor.visit("k", sketch.getK());
+        visitor.visit("count", sketch.getCount());
+        visitor.visit("median", sketch.quantile(0.5));
+    }
+
+    @Override
+    public int hashCode() {
+        return super.hashCode() + 31 * sketch.hashCode();
+    }
+}
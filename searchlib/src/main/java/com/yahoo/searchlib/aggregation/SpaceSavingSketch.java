@@ -0,0 +1,263 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.ResultNode;
+import com.yahoo.vespa.objects.Deserializer;
+import com.yahoo.vespa.objects.Identifiable;
+import com.yahoo.vespa.objects.Serializer;
+
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.Comparator;
+import java.util.List;
+import java.util.Objects;
+
+/**
+ * Space-Saving sketch used to find the most frequent values of a stream in bounded memory. This is the Java
+ * counterpart of the C++ search::SpaceSavingSketch, and the two must serialize identically. At most 'capacity'
+ * values are tracked, with counters kept as a min-heap on count. Sketches are merged following Agarwal et al,
+ * "Mergeable Summaries"; a value missing from a full sketch is assumed to have the minimum count of that sketch.
+ * Values are looked up linearly, since the capacity is small.
+ */
+public class SpaceSavingSketch {
+
+    public static final int DEFAULT_CAPACITY = 64;
+
+    /**
+     * A tracked value with its estimated count and the upper bound of the overestimation of that count.
+     */
+    public static class Counter {
+
+        private final ResultNode value;
+        private long count;
+        private long error;
+
+        public Counter(ResultNode value, long count, long error) {
+            this.value = value;
+            this.count = count;
+            this.error = error;
+        }
+
+        public ResultNode getValue() {
+            return value;
+        }
+
+        public long getCount() {
+            return count;
+        }
+
+        public long getError() {
+            return error;
+        }
+
+        @Override
+        public boolean equals(Object obj) {
+            if (!(obj instanceof Counter)) {
+                return false;
+            }
+            Counter rhs = (Counter)obj;
+            return count == rhs.count && error == rhs.error && Objects.equals(value, rhs.value);
+        }
+
+        @Override
+        public int hashCode() {
+            return Long.hashCode(count) + 31 * Long.hashCode(error);
+        }
+
+        @Override
+        public String toString() {
+            return "Counter{value=" + value + ", count=" + count + ", error=" + error + "}";
+        }
+    }
+
+    // Orders by decreasing count, with ties broken on value to make merges deterministic.
+    private static final Comparator<Counter> HIGHER_COUNT =
+            Comparator.comparingLong(Counter::getCount).reversed().thenComparing(Counter::getValue);
+
+    private int capacity;
+    private long total = 0;
+    private List<Counter> counters = new ArrayList<>();
+
+    public SpaceSavingSketch() {
+        this(DEFAULT_CAPACITY);
+    }
+
+    public SpaceSavingSketch(int capacity) {
+        this.capacity = Math.max(capacity, 1);
+    }
+
+    public SpaceSavingSketch(SpaceSavingSketch rhs) {
+        capacity = rhs.capacity;
+        total = rhs.total;
+        for (Counter counter : rhs.counters) {
+            counters.add(new Counter((ResultNode)counter.value.clone(), counter.count, counter.error));
+        }
+    }
+
+    public int getCapacity() {
+        return capacity;
+    }
+
+    public long getTotal() {
+        return total;
+    }
+
+    public int getSize() {
+        return counters.size();
+    }
+
+    /**
+     * Returns the tracked values ordered by decreasing estimated count.
+     *
+     * @return The tracked values.
+     */
+    public List<Counter> getTopK() {
+        List<Counter> result = new ArrayList<>(counters);
+        result.sort(HIGHER_COUNT);
+        return result;
+    }
+
+    public void add(ResultNode value, long weight) {
+        total += weight;
+        int pos = find(value);
+        if (pos >= 0) {
+            counters.get(pos).count += weight;
+            siftDown(pos);
+        } else if (!isFull()) {
+            counters.add(new Counter((ResultNode)value.clone(), weight, 0));
+            siftUp(counters.size() - 1);
+        } else {
+            Counter victim = counters.get(0);
+            counters.set(0, new Counter((ResultNode)value.clone(), victim.count + weight, victim.count));
+            siftDown(0);
+        }
+    }
+
+    public void merge(SpaceSavingSketch other) {
+        if (other.capacity != capacity) {
+            throw new IllegalArgumentException("Can not merge space saving sketches with different capacity");
+        }
+        long myMin = minCount();
+        long otherMin = other.minCount();
+        List<Counter> merged = new ArrayList<>(counters.size() + other.counters.size());
+        for (Counter counter : counters) {
+            int found = other.find(counter.value);
+            if (found >= 0) {
+                Counter match = other.counters.get(found);
+                merged.add(new Counter(counter.value, counter.count + match.count, counter.error + match.error));
+            } else {
+                merged.add(new Counter(counter.value, counter.count + otherMin, counter.error + otherMin));
+            }
+        }
+        for (Counter counter : other.counters) {
+            if (find(counter.value) < 0) {
+                merged.add(new Counter((ResultNode)counter.value.clone(), counter.count + myMin, counter.error + myMin));
+            }
+        }
+        if (merged.size() > capacity) {
+            merged.sort(HIGHER_COUNT);
+            merged = new ArrayList<>(merged.subList(0, capacity));
+        }
+        counters = merged;
+        for (int pos = counters.size() / 2 - 1; pos >= 0; --pos) {
+            siftDown(pos);
+        }
+        total += other.total;
+    }
+
+    private boolean isFull() {
+        return counters.size() >= capacity;
+    }
+
+    private long minCount() {
+        return isFull() ? counters.get(0).count : 0;
+    }
+
+    private int find(ResultNode value) {
+        for (int pos = 0; pos < counters.size(); ++pos) {
+            ResultNode candidate = counters.get(pos).value;
+            if (candidate.getClassId() == value.getClassId() && candidate.equals(value)) {
+                return pos;
+            }
+        }
+        return -1;
+    }
+
+    private void siftUp(int pos) {
+        while (pos > 0) {
+            int parent = (pos - 1) / 2;
+            if (counters.get(parent).count <= counters.get(pos).count) {
+                break;
+            }
+            Collections.swap(counters, parent, pos);
+            pos = parent;
+        }
+    }
+
+    private void siftDown(int pos) {
+        int size = counters.size();
+        for (;;) {
+            int smallest = pos;
+            int left = 2 * pos + 1;
+            int right = left + 1;
+            if (left < size && counters.get(left).count < counters.get(smallest).count) {
+                smallest = left;
+            }
+            if (right < size && counters.get(right).count < counters.get(smallest).count) {
+                smallest = right;
+            }
+            if (smallest == pos) {
+                break;
+            }
+            Collections.swap(counters, pos, smallest);
+            pos = smallest;
+        }
+    }
+
+    public void serialize(Serializer buf) {
+        buf.putInt(null, capacity);
+        buf.putLong(null, total);
+        buf.putInt(null, counters.size());
+        for (Counter counter : counters) {
+            buf.putByte(null, (byte)1);
+            counter.value.serializeWithId(buf);
+            buf.putLong(null, counter.count);
+            buf.putLong(null, counter.error);
+        }
+    }
+
+    public void deserialize(Deserializer buf) {
+        capacity = buf.getInt(null);
+        total = buf.getLong(null);
+        int size = buf.getInt(null);
+        counters = new ArrayList<>(size);
+        for (int i = 0; i < size; ++i) {
+            ResultNode value = null;
+            if (buf.getByte(null) == 1) {
+                value = (ResultNode)Identifiable.create(buf);
+            }
+            long count = buf.getLong(null);
+            long error = buf.getLong(null);
+            counters.add(new Counter(value, count, error));
+        }
+    }
+
+    @Override
+    public boolean equals(Object obj) {
+        if (!(obj instanceof SpaceSavingSketch)) {
+            return false;
+        }
+        SpaceSavingSketch rhs = (SpaceSavingSketch)obj;
+        return capacity == rhs.capacity && total == rhs.total && counters.equals(rhs.counters);
+    }
+
+    @Override
+    public int hashCode() {
+        return capacity + 31 * Long.hashCode(total) + 31 * 31 * counters.hashCode();
+    }
+
+    @Override
+    public String toString() {
+        return "SpaceSavingSketch{capacity=" + capacity + ", total=" + total + ", counters=" + counters + "}";
+    }
+}
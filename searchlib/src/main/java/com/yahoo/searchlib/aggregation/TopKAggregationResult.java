@@ -0,0 +1,99 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.IntegerResultNode;
+import com.yahoo.searchlib.expression.ResultNode;
+import com.yahoo.vespa.objects.Deserializer;
+import com.yahoo.vespa.objects.ObjectVisitor;
+import com.yahoo.vespa.objects.Serializer;
+
+import java.util.List;
+
+/**
+ * This is an aggregated result holding a Space-Saving sketch of the most frequent values of an expression. The
+ * estimated counts are upper bounds, each with a maximum error. The rank is the estimated count of the most frequent
+ * value.
+ */
+public class TopKAggregationResult extends AggregationResult {
+
+    public static final int classId = registerClass(0x4000 + 99, TopKAggregationResult.class);
+    private SpaceSavingSketch sketch;
+
+    /**
+     * Constructor used for deserialization. Will be instantiated with a default sketch.
+     */
+    @SuppressWarnings("UnusedDeclaration")
+    public TopKAggregationResult() {
+        this(new SpaceSavingSketch());
+    }
+
+    public TopKAggregationResult(SpaceSavingSketch sketch) {
+        this.sketch = sketch;
+    }
+
+    public SpaceSavingSketch getSketch() {
+        return sketch;
+    }
+
+    /**
+     * Returns the tracked values ordered by decreasing estimated count.
+     *
+     * @return The tracked values.
+     */
+    public List<SpaceSavingSketch.Counter> getTopK() {
+        return sketch.getTopK();
+    }
+
+    @Override
+    public ResultNode getRank() {
+        List<SpaceSavingSketch.Counter> topK = sketch.getTopK();
+        return new IntegerResultNode(topK.isEmpty() ? 0 : topK.get(0).getCount());
+    }
+
+    @Override
+    protected void onMerge(AggregationResult result) {
+        sketch.merge(((TopKAggregationResult)result).sketch);
+    }
+
+    @Override
+    protected int onGetClassId() {
+        return classId;
+    }
+
+    @Override
+    protected void onSerialize(Serializer buf) {
+        super.onSerialize(buf);
+        sketch.serialize(buf);
+    }
+
+    @Override
+    protected void onDeserialize(Deserializer buf) {
+        super.onDeserialize(buf);
+        sketch.deserialize(buf);
+    }
+
+    @Override
+    protected boolean equalsAggregation(AggregationResult obj) {
+        return sketch.equals(((TopKAggregationResult)obj).sketch);
+    }
+
+    @Override
+    public TopKAggregationResult clone() {
+        TopKAggregationResult obj = (TopKAggregationResult)super.clone();
+        obj.sketch = new SpaceSavingSketch(sketch);
+        return obj;
+    }
+
+    @Override
+    public void visitMembers(ObjectVisitor visitor) {
+        super.visitMembers(visitor);
+        visitor.visit("capacity", sketch.getCapacity());
+        visitor.visit("total", sketch.getTotal());
+        visitor.visit("size", sketch.getSize());
+    }
+
+    @Override
+    public int hashCode() {
+        return super.hashCode() + 31 * sketch.hashCode();
+    }
+}
@@ -157,6 +157,14 @@ public class GroupingSerializationTest {
                     .setExpression(new ConstantNode(new IntegerResultNode(67))));
             t.assertMatch(new StandardDeviationAggregationResult(1, 67, 67 * 67)
                     .setExpression(new ConstantNode(new IntegerResultNode(67))));
+            KllSketch kllSketch = new KllSketch();
+            kllSketch.add(67);
+            t.assertMatch(new QuantileAggregationResult(kllSketch)
+                    .setExpression(new ConstantNode(new IntegerResultNode(67))));
+            SpaceSavingSketch spaceSavingSketch = new SpaceSavingSketch();
+            spaceSavingSketch.add(new IntegerResultNode(67), 1);
+            t.assertMatch(new TopKAggregationResult(spaceSavingSketch)
+                    .setExpression(new ConstantNode(new IntegerResultNode(67))));
         }
     }
 
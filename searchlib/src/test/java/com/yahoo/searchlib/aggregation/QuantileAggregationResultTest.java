@@ -0,0 +1,65 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.vespa.objects.BufferSerializer;
+import org.junit.Test;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertSame;
+
+public class QuantileAggregationResultTest {
+
+    private static QuantileAggregationResult createAggregation(int k, long from, long to, long step) {
+        KllSketch sketch = new KllSketch(k);
+        for (long value = from; value < to; value += step) {
+            sketch.add(value);
+        }
+        return new QuantileAggregationResult(sketch);
+    }
+
+    @Test
+    public void requireThatQuantilesAreEstimated() {
+        QuantileAggregationResult aggr = createAggregation(KllSketch.DEFAULT_K, 1, 100, 1);
+        assertEquals(99, aggr.getSketch().getCount());
+        assertEquals(1.0, aggr.getQuantile(0.0), 0);
+        assertEquals(99.0, aggr.getQuantile(1.0), 0);
+        assertEquals(50.0, aggr.getQuantile(0.5), 0);
+        assertEquals(50.0, aggr.getRank().getFloat(), 0);
+    }
+
+    @Test
+    public void requireThatSketchesAreMerged() {
+        QuantileAggregationResult aggr1 = createAggregation(100, 0, 10000, 2);
+        QuantileAggregationResult aggr2 = createAggregation(100, 1, 10000, 2);
+        assertEquals(5000.0, aggr1.getRank().getFloat(), 300.0);
+        aggr1.merge(aggr2);
+        assertEquals(10000, aggr1.getSketch().getCount());
+        assertEquals(0.0, aggr1.getQuantile(0.0), 0);
+        assertEquals(9999.0, aggr1.getQuantile(1.0), 0);
+        assertEquals(9000.0, aggr1.getQuantile(0.9), 300.0);
+        assertEquals(aggr1.getQuantile(0.5), aggr1.getRank().getFloat(), 0);
+    }
+
+    @Test
+    public void requireThatRankIsCachedUntilMerge() {
+        QuantileAggregationResult aggr = createAggregation(KllSketch.DEFAULT_K, 1, 4, 1);
+        assertSame(aggr.getRank(), aggr.getRank());
+        assertEquals(2.0, aggr.getRank().getFloat(), 0);
+        aggr.merge(createAggregation(KllSketch.DEFAULT_K, 10, 14, 1));
+        assertEquals(10.0, aggr.getRank().getFloat(), 0);
+    }
+
+    @Test
+    public void requireThatSerializationDeserializationMatch() {
+        QuantileAggregationResult from = createAggregation(100, 0, 10000, 1);
+        QuantileAggregationResult to = new QuantileAggregationResult();
+        BufferSerializer buffer = new BufferSerializer();
+        from.serialize(buffer);
+        buffer.flip();
+        to.deserialize(buffer);
+        assertEquals(from.getSketch(), to.getSketch());
+        assertEquals(from.getSketch().getNumRetained(), to.getSketch().getNumRetained());
+        assertEquals(from.getRank().getFloat(), to.getRank().getFloat(), 0);
+        assertEquals(from, to);
+    }
+}
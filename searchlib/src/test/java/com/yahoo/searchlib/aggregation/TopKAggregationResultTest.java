@@ -0,0 +1,64 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+package com.yahoo.searchlib.aggregation;
+
+import com.yahoo.searchlib.expression.IntegerResultNode;
+import com.yahoo.searchlib.expression.StringResultNode;
+import com.yahoo.vespa.objects.BufferSerializer;
+import org.junit.Test;
+
+import java.util.List;
+
+import static org.junit.Assert.assertEquals;
+
+public class TopKAggregationResultTest {
+
+    private static TopKAggregationResult createAggregation(int capacity, long from, long to) {
+        SpaceSavingSketch sketch = new SpaceSavingSketch(capacity);
+        for (long i = from; i < to; ++i) {
+            if ((i % 2) == 0) {
+                sketch.add(new StringResultNode("frequent"), 1);
+            } else {
+                sketch.add(new IntegerResultNode(i), 1);
+            }
+        }
+        return new TopKAggregationResult(sketch);
+    }
+
+    @Test
+    public void requireThatMostFrequentValueIsFound() {
+        TopKAggregationResult aggr = createAggregation(8, 0, 100);
+        List<SpaceSavingSketch.Counter> topK = aggr.getTopK();
+        assertEquals(8, topK.size());
+        assertEquals(new StringResultNode("frequent"), topK.get(0).getValue());
+        assertEquals(100, aggr.getSketch().getTotal());
+        assertEquals(topK.get(0).getCount(), aggr.getRank().getInteger());
+    }
+
+    @Test
+    public void requireThatSketchesAreMerged() {
+        TopKAggregationResult aggr1 = createAggregation(8, 0, 50);
+        TopKAggregationResult aggr2 = createAggregation(8, 50, 100);
+        aggr1.merge(aggr2);
+        List<SpaceSavingSketch.Counter> topK = aggr1.getTopK();
+        assertEquals(8, topK.size());
+        assertEquals(100, aggr1.getSketch().getTotal());
+        SpaceSavingSketch.Counter frequent = topK.get(0);
+        assertEquals(new StringResultNode("frequent"), frequent.getValue());
+        // the true count is 50, and the estimate is an upper bound within the error
+        assertEquals(true, frequent.getCount() >= 50);
+        assertEquals(true, frequent.getCount() - frequent.getError() <= 50);
+    }
+
+    @Test
+    public void requireThatSerializationDeserializationMatch() {
+        TopKAggregationResult from = createAggregation(8, 0, 100);
+        TopKAggregationResult to = new TopKAggregationResult();
+        BufferSerializer buffer = new BufferSerializer();
+        from.serialize(buffer);
+        buffer.flip();
+        to.deserialize(buffer);
+        assertEquals(from.getSketch(), to.getSketch());
+        assertEquals(from.getTopK(), to.getTopK());
+        assertEquals(from, to);
+    }
+}
@@ -2,6 +2,8 @@
 #include <vespa/searchlib/aggregation/aggregation.h>
 #include <vespa/searchlib/aggregation/expressioncountaggregationresult.h>
 #include <vespa/searchlib/aggregation/perdocexpression.h>
+#include <vespa/searchlib/aggregation/quantileaggregationresult.h>
+#include <vespa/searchlib/aggregation/topkaggregationresult.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
 #include <vespa/vespalib/objects/objectdumper.h>
 #include <vespa/vespalib/testkit/testapp.h>
@@ -243,6 +245,83 @@ TEST("require that StandardDeviationAggregationResult aggregates multi-value exp
     EXPECT_APPROX(41.5, aggr.getRank().getFloat(), 0.1);
 }
 
+TEST("require that QuantileAggregationResult estimates quantiles of aggregated values") {
+    QuantileAggregationResult aggr;
+    for (int64_t i = 1; i <= 99; ++i) {
+        aggr.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(i))).aggregate(DocId(i), HitRank(i));
+    }
+    aggr.setExpression(createVectorFloat(std::vector<double>({0.5, 100.5}))).aggregate(DocId(100), HitRank(1));
+    EXPECT_EQUAL(101u, aggr.getSketch().getCount());
+    EXPECT_EQUAL(0.5, aggr.getQuantile(0.0));
+    EXPECT_EQUAL(100.5, aggr.getQuantile(1.0));
+    EXPECT_EQUAL(50.0, aggr.getQuantile(0.5));
+    EXPECT_EQUAL(50.0, aggr.getRank().getFloat());
+}
+
+TEST("require that QuantileAggregationResult can be merged and serialized") {
+    QuantileAggregationResult aggr1(100);
+    QuantileAggregationResult aggr2(100);
+    for (int64_t i = 0; i < 10000; ++i) {
+        QuantileAggregationResult &aggr = ((i % 2) == 0) ? aggr1 : aggr2;
+        aggr.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(i))).aggregate(DocId(i), HitRank(i));
+    }
+    EXPECT_APPROX(5000.0, aggr1.getRank().getFloat(), 300.0);
+    aggr2.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(20000))).aggregate(DocId(1), HitRank(1));
+    aggr1.merge(aggr2);
+    EXPECT_EQUAL(10001u, aggr1.getSketch().getCount());
+    EXPECT_APPROX(9000.0, aggr1.getQuantile(0.9), 300.0);
+    EXPECT_EQUAL(aggr1.getQuantile(0.5), aggr1.getRank().getFloat());
+
+    nbostream os;
+    NBOSerializer nos(os);
+    nos << aggr1;
+    Identifiable::UP obj = Identifiable::create(nos);
+    auto *aggr3 = dynamic_cast<QuantileAggregationResult *>(obj.get());
+    ASSERT_TRUE(aggr3);
+    EXPECT_TRUE(os.empty());
+    EXPECT_TRUE(aggr1.getSketch() == aggr3->getSketch());
+    EXPECT_EQUAL(aggr1.getRank().getFloat(), aggr3->getRank().getFloat());
+}
+
+ExpressionNode::UP
+createTopKValue(int64_t i) {
+    if ((i % 2) == 0) {
+        return MU<ConstantNode>(MU<StringResultNode>("frequent"));
+    } else if ((i % 4) == 1) {
+        return MU<ConstantNode>(MU<StringResultNode>("less frequent"));
+    }
+    return MU<ConstantNode>(MU<Int64ResultNode>(i));
+}
+
+TEST("require that TopKAggregationResult finds the most frequent values") {
+    TopKAggregationResult aggr1(8);
+    TopKAggregationResult aggr2(8);
+    for (int64_t i = 0; i < 100; ++i) {
+        TopKAggregationResult &aggr = (i < 50) ? aggr1 : aggr2;
+        aggr.setExpression(createTopKValue(i)).aggregate(DocId(i), HitRank(i));
+    }
+    aggr1.merge(aggr2);
+    auto topK = aggr1.getSketch().getTopK();
+    ASSERT_EQUAL(8u, topK.size());
+    EXPECT_EQUAL(0, topK[0]->value->cmp(StringResultNode("frequent")));
+    EXPECT_EQUAL(0, topK[1]->value->cmp(StringResultNode("less frequent")));
+    EXPECT_LESS_EQUAL(topK[1]->count - topK[1]->error, 25u);
+    EXPECT_GREATER_EQUAL(topK[1]->count, 25u);
+    EXPECT_EQUAL(100u, aggr1.getSketch().getTotal());
+    EXPECT_EQUAL(static_cast<int64_t>(topK[0]->count), aggr1.getRank().getInteger());
+}
+
+TEST("require that TopKAggregationResult aggregates multi-value expression") {
+    TopKAggregationResult aggr;
+    aggr.setExpression(createVectorInt(std::vector<double>({3, 7, 3, 3}))).aggregate(DocId(42), HitRank(21));
+    auto topK = aggr.getSketch().getTopK();
+    ASSERT_EQUAL(2u, topK.size());
+    EXPECT_EQUAL(3, topK[0]->value->getInteger());
+    EXPECT_EQUAL(3u, topK[0]->count);
+    EXPECT_EQUAL(7, topK[1]->value->getInteger());
+    EXPECT_EQUAL(1u, topK[1]->count);
+}
+
 void testAdd(const ResultNode &a, const ResultNode &b, const ResultNode &c) {
     AddFunctionNode func;
     func.appendArg(MU<ConstantNode>(ResultNode::UP(a.clone())))
@@ -1590,6 +1669,8 @@ TEST("testStreamingAll") {
     testStreaming(CountAggregationResult());
     testStreaming(ExpressionCountAggregationResult());
     testStreaming(StandardDeviationAggregationResult());
+    testStreaming(QuantileAggregationResult());
+    testStreaming(TopKAggregationResult());
     testStreaming(SumAggregationResult());
     testStreaming(MinAggregationResult());
     testStreaming(MaxAggregationResult());
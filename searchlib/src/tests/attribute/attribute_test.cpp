@@ -245,6 +245,7 @@ private:
     void testReaderDuringLastUpdate();
 
     void testPendingCompaction();
+    void testMMapLoad();
 
 public:
     AttributeTest() { }
@@ -2315,6 +2316,47 @@ AttributeTest::testPendingCompaction()
     populateSimple(iv, 1, 2);  // should not trigger new compaction
 }
 
+void
+AttributeTest::testMMapLoad()
+{
+    Config cfg(BasicType::INT64, CollectionType::SINGLE);
+    const uint32_t numDocs = 5000;
+    {
+        AttributePtr v = createAttribute("sint64_mmap", cfg);
+        addClearedDocs(v, numDocs);
+        populateSimple(static_cast<IntegerAttribute &>(*v.get()), 1, numDocs);
+        EXPECT_TRUE(v->save());
+    }
+    Config mmapCfg(cfg);
+    mmapCfg.setMMapLoad(true);
+    {
+        AttributePtr v = createAttribute("sint64_mmap", mmapCfg);
+        IntegerAttribute &iv = static_cast<IntegerAttribute &>(*v.get());
+        EXPECT_TRUE(v->load());
+        EXPECT_EQUAL(numDocs, v->getNumDocs());
+        for (uint32_t docId = 1; docId < numDocs; ++docId) {
+            EXPECT_EQUAL(docId + 1, v->getInt(docId));
+        }
+        // Writes are copied away from the mapping, also when the vector grows.
+        EXPECT_TRUE(iv.update(7, 1000));
+        AttributeVector::DocId docId;
+        for (uint32_t i = 0; i < 100; ++i) {
+            EXPECT_TRUE(v->addDoc(docId));
+        }
+        EXPECT_TRUE(iv.update(numDocs + 50, 2000));
+        commit(v);
+        EXPECT_EQUAL(1000, v->getInt(7));
+        EXPECT_EQUAL(2000, v->getInt(numDocs + 50));
+        EXPECT_EQUAL(9, v->getInt(8));
+    }
+    {
+        AttributePtr v = createAttribute("sint64_mmap", cfg);
+        EXPECT_TRUE(v->load());
+        EXPECT_EQUAL(numDocs, v->getNumDocs());
+        EXPECT_EQUAL(8, v->getInt(7));
+    }
+}
+
 void
 deleteDataDirs()
 {
@@ -2361,6 +2403,7 @@ int AttributeTest::Main()
     TEST_DO(requireThatAddressSpaceUsageIsReported());
     testReaderDuringLastUpdate();
     TEST_DO(testPendingCompaction());
+    TEST_DO(testMMapLoad());
 
     deleteDataDirs();
     TEST_DONE();
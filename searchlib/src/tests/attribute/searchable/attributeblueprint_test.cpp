@@ -3,6 +3,7 @@
 #include <vespa/searchcommon/attribute/iattributecontext.h>
 #include <vespa/searchlib/attribute/attribute_blueprint_factory.h>
 #include <vespa/searchlib/attribute/attributecontext.h>
+#include <vespa/searchlib/attribute/attributeiterators.h>
 #include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
 #include <vespa/searchlib/attribute/singlenumericattribute.h>
@@ -13,12 +14,14 @@
 #include <vespa/searchlib/query/tree/simplequery.h>
 #include <vespa/searchlib/queryeval/fake_requestcontext.h>
 #include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
 
 #include <vespa/log/log.h>
 LOG_SETUP("attributeblueprint_test");
 
 using search::AttributeEnumGuard;
 using search::AttributeGuard;
+using search::AttributeScanIterator;
 using search::AttributeVector;
 using search::IAttributeManager;
 using search::SingleStringExtAttribute;
@@ -49,9 +52,11 @@ class Test : public vespalib::TestApp {
     void requireThatPrefixTermsWork();
     void requireThatLocationTermsWork();
     void requireThatFastSearchLocationTermsWork();
+    void requireThatScanIteratorIsUsedForStrictSearchOverFullBlock();
 
     bool search(const string &term, IAttributeManager &attribute_manager);
     bool search(const Node &term, IAttributeManager &attribute_manager);
+    bool usesScanIterator(uint32_t docIdLimit, bool strict);
 
 public:
     int Main() override;
@@ -67,6 +72,7 @@ Test::Main()
     TEST_DO(requireThatPrefixTermsWork());
     TEST_DO(requireThatLocationTermsWork());
     TEST_DO(requireThatFastSearchLocationTermsWork());
+    TEST_DO(requireThatScanIteratorIsUsedForStrictSearchOverFullBlock());
 
     TEST_DONE();
 }
@@ -173,6 +179,38 @@ MyAttributeManager makeFastSearchLongAttribute(int64_t value) {
     return fill<FastSearchLongAttribute, int64_t>(attr, value);
 }
 
+MyAttributeManager makeLongAttributeManager(uint32_t docIdLimit, int64_t value) {
+    typedef AttributeVectorTypeFinder<int64_t> AT;
+    AT::Type *attr = new AT::Type(field);
+    AttributeVector::DocId docid;
+    for (uint32_t i = 0; i < docIdLimit; ++i) {
+        attr->addDoc(docid);
+    }
+    AT::add(*attr, value);
+    return MyAttributeManager(attr);
+}
+
+bool Test::usesScanIterator(uint32_t docIdLimit, bool strict) {
+    TEST_STATE(vespalib::make_string("docIdLimit=%u, strict=%s", docIdLimit, strict ? "true" : "false").c_str());
+    MyAttributeManager attribute_manager = makeLongAttributeManager(docIdLimit, 42);
+    AttributeContext ac(attribute_manager);
+    FakeRequestContext requestContext(&ac);
+    MatchData::UP md(MatchData::makeTestInstance(1, 1));
+    AttributeBlueprintFactory source;
+    SimpleStringTerm node("[23;46]", field, 0, Weight(0));
+    Blueprint::UP result = source.createBlueprint(requestContext, FieldSpec(field, 0, 0), node);
+    ASSERT_TRUE(result.get());
+    result->fetchPostings(strict);
+    result->setDocIdLimit(docIdLimit);
+    SearchIterator::UP iterator = result->createSearch(*md, strict);
+    ASSERT_TRUE((bool)iterator);
+    iterator->initRange(1, docIdLimit);
+    // Only the last document has a value in range
+    EXPECT_TRUE(!iterator->seek(1));
+    EXPECT_TRUE(iterator->seek(docIdLimit - 1));
+    return dynamic_cast<AttributeScanIterator *>(iterator.get()) != nullptr;
+}
+
 void Test::requireThatIteratorsCanBeCreated() {
     MyAttributeManager attribute_manager = makeAttributeManager("foo");
 
@@ -234,6 +272,17 @@ void Test::requireThatFastSearchLocationTermsWork() {
 #endif
 }
 
+void Test::requireThatScanIteratorIsUsedForStrictSearchOverFullBlock() {
+    const uint32_t blockDocs = AttributeScanIterator::BlockDocs;
+    EXPECT_TRUE(!usesScanIterator(DOCID_LIMIT, true));
+    EXPECT_TRUE(!usesScanIterator(DOCID_LIMIT, false));
+    EXPECT_TRUE(!usesScanIterator(blockDocs - 1, true));
+    EXPECT_TRUE(usesScanIterator(blockDocs, true));
+    EXPECT_TRUE(!usesScanIterator(blockDocs, false));
+    EXPECT_TRUE(usesScanIterator(10 * blockDocs, true));
+    EXPECT_TRUE(!usesScanIterator(10 * blockDocs, false));
+}
+
 }  // namespace
 
 TEST_APPHOOK(Test);
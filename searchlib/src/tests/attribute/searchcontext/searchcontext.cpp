@@ -273,6 +273,10 @@ private:
                                                        int64_t maxValue);
     void requireThatOutOfBoundsSearchTermGivesZeroHits();
 
+    template <typename VectorType, typename ValueType>
+    void requireThatScanIteratorFindsSameHitsAsStrictIterator(const vespalib::string & name, const Config & cfg);
+    void requireThatScanIteratorFindsSameHitsAsStrictIterator();
+
     // init maps with config objects
     void initIntegerConfig();
     void initFloatConfig();
@@ -620,20 +624,27 @@ void SearchContextTest::testSearch(const ConfigMap & cfgs) {
 template<typename T, typename A>
 class Verifier : public search::test::SearchIteratorVerifier {
 public:
-    Verifier(T key, const vespalib::string & keyAsString, const vespalib::string & name, const Config & cfg);
+    Verifier(T key, const vespalib::string & keyAsString, const vespalib::string & name, const Config & cfg,
+             bool scan = false);
     ~Verifier();
     SearchIterator::UP create(bool strict) const override {
+        if (strict && _scan) {
+            return _sc->createScanIterator(&_dummy);
+        }
         return _sc->createIterator(&_dummy, strict);
     }
 private:
+    bool _scan;
     mutable TermFieldMatchData _dummy;
     AttributePtr _attribute;
     SearchContextPtr _sc;
 };
 
 template<typename T, typename A>
-Verifier<T, A>::Verifier(T key, const vespalib::string & keyAsString, const vespalib::string & name, const Config & cfg)
-    :_attribute(AttributeFactory::createAttribute(name + "-initrange", cfg)),
+Verifier<T, A>::Verifier(T key, const vespalib::string & keyAsString, const vespalib::string & name, const Config & cfg,
+                         bool scan)
+    :_scan(scan),
+     _attribute(AttributeFactory::createAttribute(name + "-initrange", cfg)),
      _sc()
 {
     SearchContextTest::addDocs(*_attribute, getDocIdLimit());
@@ -656,6 +667,12 @@ void SearchContextTest::testSearchIterator(T key, const vespalib::string &keyAsS
     for (const auto & cfg : cfgs) {
         Verifier<T, A> verifier(key, keyAsString, cfg.first, cfg.second);
         verifier.verify();
+        if (cfg.second.collectionType() == CollectionType::SINGLE && !cfg.second.fastSearch() &&
+            cfg.second.basicType() != BasicType::STRING)
+        {
+            Verifier<T, A> scanVerifier(key, keyAsString, cfg.first, cfg.second, true);
+            scanVerifier.verify();
+        }
     }
 }
 
@@ -1787,6 +1804,78 @@ SearchContextTest::requireThatOutOfBoundsSearchTermGivesZeroHits()
     }
 }
 
+namespace {
+
+std::vector<uint32_t>
+getHits(SearchIterator & it, uint32_t beginId, uint32_t endId)
+{
+    std::vector<uint32_t> hits;
+    it.initRange(beginId, endId);
+    for (uint32_t docId = it.seekFirst(beginId); !it.isAtEnd(); docId = it.seekNext(docId + 1)) {
+        hits.push_back(docId);
+    }
+    return hits;
+}
+
+}
+
+template <typename VectorType, typename ValueType>
+void
+SearchContextTest::requireThatScanIteratorFindsSameHitsAsStrictIterator(const vespalib::string & name,
+                                                                        const Config & cfg)
+{
+    AttributePtr a = AttributeFactory::createAttribute(name, cfg);
+    VectorType & va = dynamic_cast<VectorType &>(*a);
+    LOG(info, "requireThatScanIteratorFindsSameHitsAsStrictIterator: vector '%s'", a->getName().c_str());
+    const uint32_t numDocs = 1000;
+    addDocs(va, numDocs);
+    for (uint32_t doc = 1; doc <= numDocs; ++doc) {
+        va.update(doc, static_cast<ValueType>(doc % 37));
+    }
+    va.commit(true);
+    for (const char * term : { "5", "[10;20]", "<3", ">30", "100" }) {
+        SearchContextPtr sc = getSearch(va, vespalib::string(term));
+        TermFieldMatchData md;
+        SearchBasePtr scan = sc->createScanIterator(&md);
+        SearchBasePtr strict = sc->createIterator(&md, true);
+        if (cfg.collectionType() != CollectionType::SINGLE || cfg.fastSearch()) {
+            EXPECT_TRUE(scan.get() == nullptr);
+            continue;
+        }
+        ASSERT_TRUE(scan.get() != nullptr);
+        EXPECT_TRUE(scan->is_strict() == vespalib::Trinary::True);
+        for (uint32_t beginId : { 1u, 100u, 255u, 256u, 700u }) {
+            for (uint32_t endId : { 257u, numDocs + 1 }) {
+                if (beginId < endId) {
+                    EXPECT_TRUE(getHits(*strict, beginId, endId) == getHits(*scan, beginId, endId));
+                }
+            }
+        }
+        EXPECT_TRUE(getHits(*scan, 1, search::endDocId) == getHits(*strict, 1, numDocs + 1));
+        if (vespalib::string(term) == "5") {
+            EXPECT_EQUAL(27u, getHits(*scan, 1, numDocs + 1).size());
+            scan->initRange(1, numDocs + 1);
+            EXPECT_TRUE(scan->seek(42));
+            scan->unpack(42);
+            EXPECT_EQUAL(42u, md.getDocId());
+            EXPECT_EQUAL(1, md.getWeight());
+        }
+    }
+}
+
+void
+SearchContextTest::requireThatScanIteratorFindsSameHitsAsStrictIterator()
+{
+    for (const auto & cfg : _integerCfg) {
+        requireThatScanIteratorFindsSameHitsAsStrictIterator<IntegerAttribute, largeint_t>(cfg.first + "-scan",
+                                                                                           cfg.second);
+    }
+    for (const auto & cfg : _floatCfg) {
+        requireThatScanIteratorFindsSameHitsAsStrictIterator<FloatingPointAttribute, double>(cfg.first + "-scan",
+                                                                                             cfg.second);
+    }
+}
+
 
 void
 SearchContextTest::initIntegerConfig()
@@ -1918,6 +2007,7 @@ SearchContextTest::Main()
     TEST_DO(requireThatInvalidSearchTermGivesZeroHits());
     TEST_DO(requireThatFlagAttributeHandlesTheByteRange());
     TEST_DO(requireThatOutOfBoundsSearchTermGivesZeroHits());
+    TEST_DO(requireThatScanIteratorFindsSameHitsAsStrictIterator());
 
     TEST_DONE();
 }
@@ -0,0 +1,192 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Compares document id decode throughput of the exp golomb and zc varint
+// codings used by the Zc posting formats with the StreamVByte blocks used
+// by the block posting format.
+
+#include <vespa/searchlib/bitcompression/compression.h>
+#include <vespa/searchlib/bitcompression/streamvbyte.h>
+#include <vespa/searchlib/diskindex/blockposting.h>
+#include <vespa/searchlib/diskindex/zcpostingiterators.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <random>
+#include <vector>
+
+using search::bitcompression::DecodeContext64BE;
+using search::bitcompression::EncodeContext64BE;
+using search::bitcompression::FeatureEncodeContextBE;
+using search::bitcompression::StreamVByte;
+using search::diskindex::BlockPostingFormat;
+
+namespace {
+
+constexpr uint32_t BLOCK_SIZE = BlockPostingFormat::BLOCK_SIZE;
+
+std::vector<uint32_t>
+makeDocIds(uint32_t numDocs, uint32_t docIdLimit)
+{
+    std::mt19937 rnd(42);
+    uint32_t maxGap = std::max(1u, 2 * (docIdLimit / numDocs) - 1);
+    std::vector<uint32_t> docIds;
+    uint32_t docId = 0;
+    for (uint32_t i = 0; i < numDocs; ++i) {
+        docId += 1 + rnd() % maxGap;
+        docIds.push_back(docId);
+    }
+    return docIds;
+}
+
+class ExpGolombList
+{
+    EncodeContext64BE _e;
+    search::ComprFileWriteContext _wc;
+    uint32_t _numDocs;
+    uint32_t _docIdK;
+public:
+    ExpGolombList(const std::vector<uint32_t> &docIds, uint32_t docIdLimit)
+        : _e(),
+          _wc(_e),
+          _numDocs(docIds.size()),
+          _docIdK(FeatureEncodeContextBE::calcDocIdK(docIds.size(), docIdLimit))
+    {
+        _wc.allocComprBuf(32768, 32768);
+        _e.setupWrite(_wc);
+        uint32_t prev = 0;
+        for (uint32_t docId : docIds) {
+            _e.encodeExpGolomb(docId - prev - 1, _docIdK);
+            prev = docId;
+            if (_e._valI >= _e._valE) {
+                _wc.writeComprBuffer(false);
+            }
+        }
+        _e.flush();
+    }
+
+    uint64_t decode() const {
+        typedef EncodeContext64BE EC;
+        DecodeContext64BE dc(static_cast<const uint64_t *>(_wc._comprBuf), 0);
+        unsigned int length;
+        uint64_t val64;
+        uint32_t docId = 0;
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < _numDocs; ++i) {
+            UC64BE_DECODEEXPGOLOMB(dc._val, dc._valI, dc._preRead, dc._cacheInt, _docIdK, EC);
+            docId += 1 + val64;
+            sum += docId;
+        }
+        return sum;
+    }
+};
+
+class ZcList
+{
+    std::vector<uint8_t> _buf;
+    uint32_t _numDocs;
+public:
+    ZcList(const std::vector<uint32_t> &docIds)
+        : _buf(docIds.size() * 5),
+          _numDocs(docIds.size())
+    {
+        uint8_t *p = &_buf[0];
+        uint32_t prev = 0;
+        for (uint32_t docId : docIds) {
+            p = BlockPostingFormat::encodeZc(p, docId - prev - 1);
+            prev = docId;
+        }
+    }
+
+    uint64_t decode() const {
+        const uint8_t *valI = &_buf[0];
+        uint32_t docId = 0;
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < _numDocs; ++i) {
+            ZCDECODE(valI, docId += 1 +);
+            sum += docId;
+        }
+        return sum;
+    }
+};
+
+class StreamVByteList
+{
+    std::vector<uint8_t> _buf;
+    std::vector<size_t> _blockStarts;
+    std::vector<uint32_t> _blockLastDocIds;
+    uint32_t _numDocs;
+public:
+    StreamVByteList(const std::vector<uint32_t> &docIds)
+        : _buf(StreamVByte::maxEncodedSize(docIds.size()) + StreamVByte::DECODE_SLACK),
+          _blockStarts(),
+          _blockLastDocIds(),
+          _numDocs(docIds.size())
+    {
+        size_t pos = 0;
+        uint32_t prev = 0;
+        for (uint32_t start = 0; start < _numDocs; start += BLOCK_SIZE) {
+            uint32_t blockDocs = std::min(BLOCK_SIZE, _numDocs - start);
+            _blockStarts.push_back(pos);
+            pos += StreamVByte::encodeDeltas(&docIds[start], blockDocs, prev, &_buf[pos]);
+            prev = docIds[start + blockDocs - 1];
+            _blockLastDocIds.push_back(prev);
+        }
+    }
+
+    template <typename DecodeDeltas>
+    uint64_t decode(DecodeDeltas decodeDeltas) const {
+        uint32_t block[BLOCK_SIZE + 3];
+        uint32_t prev = 0;
+        uint64_t sum = 0;
+        for (uint32_t i = 0; i < _blockStarts.size(); ++i) {
+            uint32_t blockDocs = std::min(BLOCK_SIZE, _numDocs - i * BLOCK_SIZE);
+            decodeDeltas(&_buf[_blockStarts[i]], blockDocs, prev, block);
+            for (uint32_t j = 0; j < blockDocs; ++j) {
+                sum += block[j];
+            }
+            prev = _blockLastDocIds[i];
+        }
+        return sum;
+    }
+};
+
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t docIdLimit = (argc > 1) ? strtoul(argv[1], NULL, 0) : 10000000;
+    double budget = (argc > 2) ? strtod(argv[2], NULL) : 1.0;
+    printf("Decoding document ids below %u, vector decoder: %s\n", docIdLimit,
+           StreamVByte::hasVectorDecoder() ? "yes" : "no");
+    for (uint32_t divisor : { 2u, 8u, 64u, 1024u }) {
+        uint32_t numDocs = docIdLimit / divisor;
+        std::vector<uint32_t> docIds = makeDocIds(numDocs, docIdLimit);
+        uint64_t expected = 0;
+        for (uint32_t docId : docIds) {
+            expected += docId;
+        }
+        ExpGolombList expGolomb(docIds, docIdLimit);
+        ZcList zc(docIds);
+        StreamVByteList streamVByte(docIds);
+        uint64_t expGolombSum = 0;
+        uint64_t zcSum = 0;
+        uint64_t genericSum = 0;
+        uint64_t vectorSum = 0;
+        double expGolombTime = vespalib::BenchmarkTimer::benchmark([&]() { expGolombSum = expGolomb.decode(); },
+                                                                   budget);
+        double zcTime = vespalib::BenchmarkTimer::benchmark([&]() { zcSum = zc.decode(); }, budget);
+        double genericTime = vespalib::BenchmarkTimer::benchmark([&]() {
+                genericSum = streamVByte.decode(StreamVByte::decodeDeltasGeneric);
+            }, budget);
+        double vectorTime = vespalib::BenchmarkTimer::benchmark([&]() {
+                vectorSum = streamVByte.decode(StreamVByte::decodeDeltas);
+            }, budget);
+        printf("%u documents (1/%u)\n", numDocs, divisor);
+        printf("    exp golomb: %.2f ns/doc, zc: %.2f ns/doc\n",
+               expGolombTime * 1e9 / numDocs, zcTime * 1e9 / numDocs);
+        printf("    streamvbyte generic: %.2f ns/doc, dispatched: %.2f ns/doc, speedup vs exp golomb: %.2f\n",
+               genericTime * 1e9 / numDocs, vectorTime * 1e9 / numDocs, expGolombTime / vectorTime);
+        if (expGolombSum != expected || zcSum != expected || genericSum != expected || vectorSum != expected) {
+            fprintf(stderr, "Checksum mismatch for %u documents\n", numDocs);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,109 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/bitcompression/streamvbyte.h>
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <random>
+#include <vector>
+
+using search::bitcompression::StreamVByte;
+
+namespace {
+
+const uint32_t boundaries[] = { 0u, 1u, 255u, 256u, 65535u, 65536u, 0xffffffu, 0x1000000u, 0xffffffffu };
+
+std::vector<uint32_t>
+makeValues(uint32_t count, uint32_t seed)
+{
+    std::mt19937 rnd(seed);
+    std::vector<uint32_t> values;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t bits = rnd() % 33;
+        uint32_t value = (bits == 0) ? 0 : (rnd() >> (32 - bits));
+        values.push_back((i % 3) == 0 ? boundaries[rnd() % 9] : value);
+    }
+    return values;
+}
+
+std::vector<uint32_t>
+makeDocIds(uint32_t count, uint32_t base, uint32_t maxGap, uint32_t seed)
+{
+    std::mt19937 rnd(seed);
+    std::vector<uint32_t> docIds;
+    uint32_t docId = base;
+    for (uint32_t i = 0; i < count; ++i) {
+        docId += 1 + rnd() % maxGap;
+        docIds.push_back(docId);
+    }
+    return docIds;
+}
+
+// Decoders may write up to 3 values past count
+std::vector<uint32_t>
+decodeBuf(uint32_t count)
+{
+    return std::vector<uint32_t>(count + 3);
+}
+
+}
+
+TEST("require that values are round tripped")
+{
+    for (uint32_t count = 0; count <= 130; ++count) {
+        std::vector<uint32_t> values = makeValues(count, count);
+        std::vector<uint8_t> buf(StreamVByte::maxEncodedSize(count) + StreamVByte::DECODE_SLACK);
+        size_t size = StreamVByte::encode(&values[0], count, &buf[0]);
+        EXPECT_LESS_EQUAL(size, StreamVByte::maxEncodedSize(count));
+        std::vector<uint32_t> generic = decodeBuf(count);
+        std::vector<uint32_t> dispatched = decodeBuf(count);
+        StreamVByte::decodeGeneric(&buf[0], count, &generic[0]);
+        StreamVByte::decode(&buf[0], count, &dispatched[0]);
+        for (uint32_t i = 0; i < count; ++i) {
+            EXPECT_EQUAL(values[i], generic[i]);
+            EXPECT_EQUAL(values[i], dispatched[i]);
+        }
+    }
+}
+
+TEST("require that encoded size depends on value magnitude")
+{
+    std::vector<uint32_t> values = { 1, 300, 70000, 20000000, 5 };
+    std::vector<uint8_t> buf(StreamVByte::maxEncodedSize(values.size()));
+    EXPECT_EQUAL(2u + 1u + 2u + 3u + 4u + 1u, StreamVByte::encode(&values[0], values.size(), &buf[0]));
+    EXPECT_EQUAL(0xe4u, buf[0]);
+    EXPECT_EQUAL(0x00u, buf[1]);
+}
+
+TEST("require that document id deltas are round tripped")
+{
+    for (uint32_t maxGap : { 1u, 3u, 200u, 70000u, 30000000u }) {
+        for (uint32_t count : { 1u, 4u, 7u, 127u, 128u }) {
+            uint32_t base = maxGap * 3;
+            std::vector<uint32_t> docIds = makeDocIds(count, base, maxGap, maxGap + count);
+            std::vector<uint8_t> buf(StreamVByte::maxEncodedSize(count) + StreamVByte::DECODE_SLACK);
+            StreamVByte::encodeDeltas(&docIds[0], count, base, &buf[0]);
+            std::vector<uint32_t> generic = decodeBuf(count);
+            std::vector<uint32_t> dispatched = decodeBuf(count);
+            StreamVByte::decodeDeltasGeneric(&buf[0], count, base, &generic[0]);
+            StreamVByte::decodeDeltas(&buf[0], count, base, &dispatched[0]);
+            for (uint32_t i = 0; i < count; ++i) {
+                EXPECT_EQUAL(docIds[i], generic[i]);
+                EXPECT_EQUAL(docIds[i], dispatched[i]);
+            }
+        }
+    }
+}
+
+TEST("require that consecutive document ids are coded with one byte each")
+{
+    std::vector<uint32_t> docIds = makeDocIds(128, 1000, 1, 1);
+    std::vector<uint8_t> buf(StreamVByte::maxEncodedSize(128));
+    EXPECT_EQUAL(32u + 128u, StreamVByte::encodeDeltas(&docIds[0], 128, 1000, &buf[0]));
+    EXPECT_EQUAL(1128u, docIds.back());
+}
+
+TEST("report decoder")
+{
+    fprintf(stderr, "vector decoder: %s\n", StreamVByte::hasVectorDecoder() ? "yes" : "no");
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,118 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Measures insert, lookup and iterate throughput of btrees with uint32_t
+// keys, comparing binary search in the nodes with the linear SIMD node
+// search used for std::less<uint32_t>, and the default slot counts with
+// slot counts making the nodes fill whole cache lines.
+
+#include <vespa/searchlib/btree/btree.h>
+#include <vespa/searchlib/btree/btreenodeallocator.hpp>
+#include <vespa/searchlib/btree/btreenode.hpp>
+#include <vespa/searchlib/btree/btreenodestore.hpp>
+#include <vespa/searchlib/btree/btreeiterator.hpp>
+#include <vespa/searchlib/btree/btreeroot.hpp>
+#include <vespa/searchlib/btree/btree.hpp>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <cinttypes>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using search::btree::BTree;
+using search::btree::BTreeCacheLineTraits;
+using search::btree::BTreeDefaultTraits;
+using search::btree::NoAggregated;
+
+namespace {
+
+/**
+ * Same order as std::less<uint32_t>, but searched with binary search in
+ * the nodes.
+ */
+struct BinaryLess {
+    bool operator()(uint32_t lhs, uint32_t rhs) const { return lhs < rhs; }
+};
+
+using CacheLineTraits = BTreeCacheLineTraits<uint32_t, int32_t, NoAggregated>;
+
+struct Result {
+    uint64_t insertChecksum;
+    uint64_t lookupChecksum;
+    uint64_t iterateChecksum;
+
+    bool operator==(const Result &rhs) const {
+        return insertChecksum == rhs.insertChecksum &&
+            lookupChecksum == rhs.lookupChecksum &&
+            iterateChecksum == rhs.iterateChecksum;
+    }
+};
+
+template <typename CompareT, typename TraitsT>
+Result
+run(const char *name, const std::vector<uint32_t> &keys,
+    const std::vector<uint32_t> &lookups, double budget)
+{
+    using Tree = BTree<uint32_t, int32_t, NoAggregated, CompareT, TraitsT>;
+    Result result{0, 0, 0};
+    double insertTime = vespalib::BenchmarkTimer::benchmark([&]() {
+            Tree tree;
+            uint64_t inserted = 0;
+            for (uint32_t key : keys) {
+                inserted += tree.insert(key, key & 0xff) ? 1 : 0;
+            }
+            result.insertChecksum = inserted;
+        }, budget);
+    Tree tree;
+    for (uint32_t key : keys) {
+        tree.insert(key, key & 0xff);
+    }
+    double lookupTime = vespalib::BenchmarkTimer::benchmark([&]() {
+            uint64_t sum = 0;
+            for (uint32_t key : lookups) {
+                auto itr = tree.lowerBound(key);
+                if (itr.valid()) {
+                    sum += itr.getKey() + itr.getData();
+                }
+            }
+            result.lookupChecksum = sum;
+        }, budget);
+    double iterateTime = vespalib::BenchmarkTimer::benchmark([&]() {
+            uint64_t sum = 0;
+            for (auto itr = tree.begin(); itr.valid(); ++itr) {
+                sum += itr.getKey();
+            }
+            result.iterateChecksum = sum;
+        }, budget);
+    size_t numKeys = tree.size();
+    printf("%-24s fanout=%2zu,%2zu insert: %6.1f ns/key, lookup: %6.1f ns/key, iterate: %5.2f ns/key\n",
+           name, TraitsT::LEAF_SLOTS, TraitsT::INTERNAL_SLOTS,
+           insertTime * 1e9 / keys.size(),
+           lookupTime * 1e9 / lookups.size(),
+           iterateTime * 1e9 / numKeys);
+    return result;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t numKeys = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1000000;
+    double budget = (argc > 2) ? strtod(argv[2], NULL) : 1.0;
+    std::mt19937 rnd(42);
+    std::vector<uint32_t> keys;
+    std::vector<uint32_t> lookups;
+    for (uint32_t i = 0; i < numKeys; ++i) {
+        keys.push_back(rnd());
+        lookups.push_back(rnd());
+    }
+    printf("%u keys\n", numKeys);
+    Result expected = run<BinaryLess, BTreeDefaultTraits>("binary search", keys, lookups, budget);
+    Result simd = run<std::less<uint32_t>, BTreeDefaultTraits>("simd search", keys, lookups, budget);
+    Result cacheLine = run<std::less<uint32_t>, CacheLineTraits>("simd search, cache line", keys, lookups, budget);
+    Result binaryCacheLine = run<BinaryLess, CacheLineTraits>("binary search, cache line", keys, lookups, budget);
+    if (!(simd == expected) || !(cacheLine == expected) || !(binaryCacheLine == expected)) {
+        fprintf(stderr, "Checksums differ: %" PRIu64 "/%" PRIu64 "/%" PRIu64 " expected\n",
+                expected.insertChecksum, expected.lookupChecksum, expected.iterateChecksum);
+        return 1;
+    }
+    return 0;
+}
@@ -3,6 +3,7 @@
 LOG_SETUP("btree_test");
 #include <vespa/vespalib/testkit/testapp.h>
 #include <string>
+#include <set>
 #include <vespa/searchlib/btree/btreeroot.h>
 #include <vespa/searchlib/btree/btreebuilder.h>
 #include <vespa/searchlib/btree/btreenodeallocator.h>
@@ -100,6 +101,10 @@ typedef BTreeTraits<16, 16, 10, false> LSeekTraits;
 typedef BTree<int, BTreeNoLeafData, btree::NoAggregated,
               std::less<int>, LSeekTraits> SetTreeL;
 
+typedef BTreeCacheLineTraits<uint32_t, BTreeNoLeafData, btree::NoAggregated> CacheLineTraits;
+typedef BTree<uint32_t, BTreeNoLeafData, btree::NoAggregated,
+              std::less<uint32_t>, CacheLineTraits> SetTreeU;
+
 struct LeafPairLess {
     bool operator()(const LeafPair & lhs, const LeafPair & rhs) const {
         return UNWRAP(lhs.first) < UNWRAP(rhs.first);
@@ -185,6 +190,9 @@ private:
     void requireThatTreeRemoveStealWorks();
     void requireThatNodeRemoveWorks();
     void requireThatNodeLowerBoundWorks();
+    void requireThatNodeSearchMatchesBinarySearch();
+    void requireThatCacheLineTraitsFillCacheLines();
+    void requireThatUnsignedTreeSearchWorks();
     void requireThatWeCanInsertAndRemoveFromTree();
     void requireThatSortedTreeInsertWorks();
     void requireThatCornerCaseTreeFindWorks();
@@ -669,6 +677,83 @@ Test::requireThatNodeLowerBoundWorks()
     cleanup(g, m, nPair.ref, n);
 }
 
+void
+Test::requireThatNodeSearchMatchesBinarySearch()
+{
+    using Search = BTreeNodeSearch<uint32_t, std::less<uint32_t>>;
+    std::vector<uint32_t> keys;
+    Rand48 rnd;
+    rnd.srand48(10);
+    for (uint32_t numKeys = 0; numKeys <= 20; ++numKeys) {
+        keys.clear();
+        for (uint32_t i = 0; i < numKeys; ++i) {
+            // Duplicates and keys with the sign bit set are included
+            keys.push_back((rnd.lrand48() % 16) * 0x11111111u);
+        }
+        std::sort(keys.begin(), keys.end());
+        const uint32_t *k = keys.data();
+        for (uint32_t sidx = 0; sidx <= numKeys; ++sidx) {
+            for (uint32_t key : { 0u, 0x11111111u, 0x7fffffffu, 0x80000000u, 0x88888888u, 0xfffffffeu, 0xffffffffu }) {
+                uint32_t expLower = std::lower_bound(k + sidx, k + numKeys, key) - k;
+                uint32_t expUpper = std::upper_bound(k + sidx, k + numKeys, key) - k;
+                EXPECT_EQUAL(expLower, Search::lower_bound(k, sidx, numKeys, key, std::less<uint32_t>()));
+                EXPECT_EQUAL(expUpper, Search::upper_bound(k, sidx, numKeys, key, std::less<uint32_t>()));
+            }
+        }
+    }
+}
+
+void
+Test::requireThatCacheLineTraitsFillCacheLines()
+{
+    using LeafTraits = BTreeCacheLineTraits<uint32_t, uint32_t, btree::NoAggregated>;
+    using LeafNode = BTreeLeafNode<uint32_t, uint32_t, btree::NoAggregated, LeafTraits::LEAF_SLOTS>;
+    using InternalNode = BTreeInternalNode<uint32_t, btree::NoAggregated, LeafTraits::INTERNAL_SLOTS>;
+    EXPECT_EQUAL(15u, LeafTraits::LEAF_SLOTS);
+    EXPECT_EQUAL(15u, LeafTraits::INTERNAL_SLOTS);
+    EXPECT_EQUAL(124u, sizeof(LeafNode));
+    EXPECT_EQUAL(128u, sizeof(InternalNode));
+    using AggrTraits = BTreeCacheLineTraits<uint32_t, int32_t, MinMaxAggregated>;
+    using AggrLeafNode = BTreeLeafNode<uint32_t, int32_t, MinMaxAggregated, AggrTraits::LEAF_SLOTS>;
+    using AggrInternalNode = BTreeInternalNode<uint32_t, MinMaxAggregated, AggrTraits::INTERNAL_SLOTS>;
+    EXPECT_EQUAL(14u, AggrTraits::LEAF_SLOTS);
+    EXPECT_EQUAL(14u, AggrTraits::INTERNAL_SLOTS);
+    EXPECT_EQUAL(124u, sizeof(AggrLeafNode));
+    EXPECT_EQUAL(128u, sizeof(AggrInternalNode));
+    EXPECT_EQUAL(31u, CacheLineTraits::LEAF_SLOTS);
+    EXPECT_EQUAL(15u, CacheLineTraits::INTERNAL_SLOTS);
+}
+
+void
+Test::requireThatUnsignedTreeSearchWorks()
+{
+    GenerationHandler g;
+    SetTreeU t;
+    std::set<uint32_t> exp;
+    Rand48 rnd;
+    rnd.srand48(10);
+    for (uint32_t i = 0; i < 5000; ++i) {
+        uint32_t key = (rnd.lrand48() % 10000) * 429497u;
+        EXPECT_EQUAL(exp.insert(key).second, t.insert(key, BTreeNoLeafData()));
+    }
+    EXPECT_TRUE(t.isValid());
+    EXPECT_EQUAL(exp.size(), t.size());
+    for (uint32_t i = 0; i < 10000; ++i) {
+        uint32_t key = (rnd.lrand48() % 10000) * 429497u + (rnd.lrand48() % 2);
+        auto lower = exp.lower_bound(key);
+        auto upper = exp.upper_bound(key);
+        EXPECT_EQUAL(lower != exp.end(), t.lowerBound(key).valid());
+        EXPECT_EQUAL(upper != exp.end(), t.upperBound(key).valid());
+        EXPECT_EQUAL(exp.count(key) != 0, t.find(key).valid());
+        if (lower != exp.end()) {
+            EXPECT_EQUAL(*lower, t.lowerBound(key).getKey());
+        }
+        if (upper != exp.end()) {
+            EXPECT_EQUAL(*upper, t.upperBound(key).getKey());
+        }
+    }
+}
+
 void
 generateData(std::vector<LeafPair> & data, size_t numEntries)
 {
@@ -1503,6 +1588,9 @@ Test::Main()
     requireThatTreeRemoveStealWorks();
     requireThatNodeRemoveWorks();
     requireThatNodeLowerBoundWorks();
+    requireThatNodeSearchMatchesBinarySearch();
+    requireThatCacheLineTraitsFillCacheLines();
+    requireThatUnsignedTreeSearchWorks();
     requireThatWeCanInsertAndRemoveFromTree();
     requireThatSortedTreeInsertWorks();
     requireThatCornerCaseTreeFindWorks();
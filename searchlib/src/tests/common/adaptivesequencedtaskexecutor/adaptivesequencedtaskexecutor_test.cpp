@@ -0,0 +1,203 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/common/adaptivesequencedtaskexecutor.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/test/insertion_operators.h>
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <unistd.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("adaptivesequencedtaskexecutor_test");
+
+namespace search::common {
+
+
+class Fixture
+{
+public:
+    AdaptiveSequencedTaskExecutor _threads;
+
+    Fixture(uint32_t threads = 2, uint32_t strands = 0, uint32_t taskLimit = 1000)
+        : _threads(threads, strands, taskLimit)
+    {
+    }
+};
+
+
+class TestObj
+{
+public:
+    std::mutex _m;
+    std::condition_variable _cv;
+    int _done;
+    int _fail;
+    int _val;
+
+    TestObj()
+        : _m(),
+          _cv(),
+          _done(0),
+          _fail(0),
+          _val(0)
+    {
+    }
+
+    void
+    modify(int oldValue, int newValue)
+    {
+        {
+            std::lock_guard<std::mutex> guard(_m);
+            if (_val == oldValue) {
+                _val = newValue;
+            } else {
+                ++_fail;
+            }
+            ++_done;
+        }
+        _cv.notify_all();
+    }
+
+    void
+    wait(int wantDone)
+    {
+        std::unique_lock<std::mutex> guard(_m);
+        _cv.wait(guard, [=] { return this->_done >= wantDone; });
+    }
+};
+
+TEST_F("testExecute", Fixture) {
+    std::shared_ptr<TestObj> tv(std::make_shared<TestObj>());
+    EXPECT_EQUAL(0, tv->_val);
+    f._threads.execute(1, [=]() { tv->modify(0, 42); });
+    tv->wait(1);
+    EXPECT_EQUAL(0,  tv->_fail);
+    EXPECT_EQUAL(42, tv->_val);
+    f._threads.sync();
+    EXPECT_EQUAL(0,  tv->_fail);
+    EXPECT_EQUAL(42, tv->_val);
+}
+
+TEST_F("require that default number of strands is a multiple of threads", Fixture(3)) {
+    EXPECT_EQUAL(24u, f._threads.getNumStrands());
+}
+
+TEST_F("require that task with same component id are serialized", Fixture)
+{
+    std::shared_ptr<TestObj> tv(std::make_shared<TestObj>());
+    EXPECT_EQUAL(0, tv->_val);
+    f._threads.execute(0, [=]() { usleep(2000); tv->modify(0, 14); });
+    f._threads.execute(0, [=]() { tv->modify(14, 42); });
+    tv->wait(2);
+    EXPECT_EQUAL(0,  tv->_fail);
+    EXPECT_EQUAL(42, tv->_val);
+    f._threads.sync();
+    EXPECT_EQUAL(0,  tv->_fail);
+    EXPECT_EQUAL(42, tv->_val);
+}
+
+TEST_F("require that task with different component ids are not serialized", Fixture)
+{
+    int tryCnt = 0;
+    for (tryCnt = 0; tryCnt < 100; ++tryCnt) {
+        std::shared_ptr<TestObj> tv(std::make_shared<TestObj>());
+        EXPECT_EQUAL(0, tv->_val);
+        f._threads.execute(0, [=]() { usleep(2000); tv->modify(0, 14); });
+        f._threads.execute(2, [=]() { tv->modify(14, 42); });
+        tv->wait(2);
+        if (tv->_fail != 1) {
+             continue;
+        }
+        EXPECT_EQUAL(1,  tv->_fail);
+        EXPECT_EQUAL(14, tv->_val);
+        f._threads.sync();
+        EXPECT_EQUAL(1,  tv->_fail);
+        EXPECT_EQUAL(14, tv->_val);
+        break;
+    }
+    EXPECT_TRUE(tryCnt < 100);
+}
+
+TEST_F("require that a busy component id does not block ids that would share its thread", Fixture(2, 4))
+{
+    // SequencedTaskExecutor with 2 threads would run component id 0 and 2 on the same thread.
+    std::shared_ptr<TestObj> tv(std::make_shared<TestObj>());
+    std::atomic<bool> release(false);
+    f._threads.execute(0, [&release]() { while (!release) { usleep(100); } });
+    f._threads.execute(0, [=]() { tv->modify(14, 42); });
+    f._threads.execute(2, [=]() { tv->modify(0, 14); });
+    usleep(20000);
+    release = true;
+    f._threads.sync();
+    EXPECT_EQUAL(0,  tv->_fail);
+    EXPECT_EQUAL(42, tv->_val);
+}
+
+TEST_F("require that per id ordering is kept under load", Fixture(8, 0, 100))
+{
+    constexpr uint32_t numIds = 37;
+    constexpr uint32_t tasksPerId = 2000;
+    std::vector<uint32_t> next(numIds, 0);
+    std::atomic<uint32_t> failures(0);
+    for (uint32_t i = 0; i < tasksPerId; ++i) {
+        for (uint32_t id = 0; id < numIds; ++id) {
+            f._threads.execute(id, [&next, &failures, id, i]() {
+                if (next[id] != i) {
+                    failures++;
+                }
+                next[id] = i + 1;
+            });
+        }
+    }
+    f._threads.sync();
+    EXPECT_EQUAL(0u, failures.load());
+    for (uint32_t id = 0; id < numIds; ++id) {
+        EXPECT_EQUAL(tasksPerId, next[id]);
+    }
+}
+
+TEST_F("require that sync waits for all tasks", Fixture(4))
+{
+    std::atomic<uint32_t> done(0);
+    for (uint32_t i = 0; i < 100; ++i) {
+        f._threads.execute(i, [&done]() { usleep(100); done++; });
+    }
+    f._threads.sync();
+    EXPECT_EQUAL(100u, done.load());
+}
+
+TEST_F("require that execute blocks when task limit is reached", Fixture(1, 0, 2))
+{
+    std::atomic<bool> release(false);
+    std::atomic<uint32_t> done(0);
+    f._threads.execute(0, [&]() { while (!release) { usleep(100); } done++; });
+    f._threads.execute(0, [&]() { done++; });
+    std::thread producer([&]() { f._threads.execute(0, [&]() { done++; }); });
+    usleep(20000);
+    EXPECT_EQUAL(0u, done.load());
+    release = true;
+    producer.join();
+    f._threads.sync();
+    EXPECT_EQUAL(3u, done.load());
+}
+
+TEST_F("require that executeLambda works", Fixture)
+{
+    int i = 5;
+    std::vector<int> res;
+    const auto lambda = [i, &res]() mutable
+                        { res.push_back(i--); res.push_back(i--); };
+    f._threads.executeLambda(0, lambda);
+    f._threads.sync();
+    std::vector<int> exp({5, 4});
+    EXPECT_EQUAL(exp, res);
+    EXPECT_EQUAL(5, i);
+}
+
+
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
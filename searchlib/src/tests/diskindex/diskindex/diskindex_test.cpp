@@ -275,6 +275,10 @@ Test::requireThatBlueprintCanCreateSearchIterators()
         b->fetchPostings(true);
         s = (dynamic_cast<LeafBlueprint *>(b.get()))->createLeafSearch(mda, true);
         ASSERT_TRUE(dynamic_cast<Zc4RareWordPosOccIterator<true> *>(s.get()) != NULL);
+        const BlockMaxPostingInfo *info = dynamic_cast<const BlockMaxPostingInfo *>(s->getPostingInfo());
+        ASSERT_TRUE(info != NULL);
+        EXPECT_EQUAL(1, info->getMaxWeight());
+        EXPECT_EQUAL(1, info->getBlockMaxWeight());
     }
 }
 
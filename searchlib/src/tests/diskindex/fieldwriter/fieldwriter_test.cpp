@@ -9,6 +9,7 @@
 #include <vespa/searchlib/index/postinglisthandle.h>
 #include <vespa/searchlib/diskindex/zcposocc.h>
 #include <vespa/searchlib/diskindex/zcposoccrandread.h>
+#include <vespa/searchlib/diskindex/blockposoccrandread.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/index/schemautil.h>
 #include <vespa/searchlib/diskindex/fieldwriter.h>
@@ -143,6 +144,7 @@ public:
     std::unique_ptr<FieldWriter> _fieldWriter;
 private:
     bool _dynamicK;
+    bool _blockPostings;
     uint32_t _numWordIds;
     uint32_t _docIdLimit;
     vespalib::string _namepref;
@@ -153,6 +155,7 @@ public:
 
     WrappedFieldWriter(const vespalib::string &namepref,
                       bool dynamicK,
+                      bool blockPostings,
                       uint32_t numWordIds,
                       uint32_t docIdLimit);
     ~WrappedFieldWriter();
@@ -165,10 +168,12 @@ WrappedFieldWriter::~WrappedFieldWriter() {}
 
 WrappedFieldWriter::WrappedFieldWriter(const vespalib::string &namepref,
                                        bool dynamicK,
+                                       bool blockPostings,
                                        uint32_t numWordIds,
                                        uint32_t docIdLimit)
     : _fieldWriter(),
       _dynamicK(dynamicK),
+      _blockPostings(blockPostings),
       _numWordIds(numWordIds),
       _docIdLimit(docIdLimit),
       _namepref(dirprefix + namepref),
@@ -189,7 +194,8 @@ WrappedFieldWriter::open()
     fileHeaderContext.disableFileName();
     _fieldWriter = std::make_unique<FieldWriter>(_docIdLimit, _numWordIds);
     _fieldWriter->open(_namepref,
-                       minSkipDocs, minChunkDocs, _dynamicK, _schema,
+                       minSkipDocs, minChunkDocs, _dynamicK, _blockPostings,
+                       _schema,
                        _indexId,
                        tuneFileWrite, fileHeaderContext);
 }
@@ -276,7 +282,8 @@ void
 writeField(FakeWordSet &wordSet,
            uint32_t docIdLimit,
            const std::string &namepref,
-           bool dynamicK)
+           bool dynamicK,
+           bool blockPostings = false)
 {
     const char *dynamicKStr = dynamicK ? "true" : "false";
 
@@ -292,7 +299,7 @@ writeField(FakeWordSet &wordSet,
     tv.SetNow();
     before = tv.Secs();
     WrappedFieldWriter ostate(namepref,
-                             dynamicK,
+                             dynamicK, blockPostings,
                              wordSet.getNumWords(), docIdLimit);
     FieldWriter::remove(namepref);
     ostate.open();
@@ -378,7 +385,8 @@ void
 randReadField(FakeWordSet &wordSet,
               const std::string &namepref,
               bool dynamicK,
-              bool verbose)
+              bool verbose,
+              bool blockPostings = false)
 {
     const char *dynamicKStr = dynamicK ? "true" : "false";
 
@@ -402,7 +410,10 @@ randReadField(FakeWordSet &wordSet,
     dictFile.reset(new PageDict4RandRead);
 
     search::index::PostingListFileRandRead *postingFile = NULL;
-    if (dynamicK)
+    if (blockPostings)
+        postingFile =
+            new search::diskindex::BlockPosOccRandRead;
+    else if (dynamicK)
         postingFile =
             new search::diskindex::ZcPosOccRandRead;
     else
@@ -498,7 +509,8 @@ fusionField(uint32_t numWordIds,
             const vespalib::string &ipref,
             const vespalib::string &opref,
             bool doRaw,
-            bool dynamicK)
+            bool dynamicK,
+            bool blockPostings = false)
 {
     const char *rawStr = doRaw ? "true" : "false";
     const char *dynamicKStr = dynamicK ? "true" : "false";
@@ -517,7 +529,7 @@ fusionField(uint32_t numWordIds,
     double before;
     double after;
     WrappedFieldWriter ostate(opref,
-                             dynamicK,
+                             dynamicK, blockPostings,
                              numWordIds, docIdLimit);
     WrappedFieldReader istate(ipref, numWordIds, docIdLimit);
 
@@ -634,6 +646,18 @@ testFieldWriterVariants(FakeWordSet &wordSet,
                 true, false);
     randReadField(wordSet, "newchunk4", true, verbose);
     randReadField(wordSet, "newchunk5", false, verbose);
+    enableSkip();
+    writeField(wordSet, docIdLimit, "newblock", false, true);
+    readField(wordSet, docIdLimit, "newblock", false, verbose);
+    fusionField(wordSet.getNumWords(),
+                docIdLimit,
+                "newblock", "newblockx",
+                false, false, true);
+    fusionField(wordSet.getNumWords(),
+                docIdLimit,
+                "newblock", "newblockxx",
+                true, false, true);
+    randReadField(wordSet, "newblock", false, verbose, true);
 }
 
 
@@ -662,6 +686,10 @@ testFieldWriterVariantsWithHighLids(FakeWordSet &wordSet, uint32_t docIdLimit,
     readField(wordSet, docIdLimit, "hlidchunk5", false, verbose);
     randReadField(wordSet, "hlidchunk4", true, verbose);
     randReadField(wordSet, "hlidchunk5", false, verbose);
+    enableSkip();
+    writeField(wordSet, docIdLimit, "hlidblock", false, true);
+    readField(wordSet, docIdLimit, "hlidblock", false, verbose);
+    randReadField(wordSet, "hlidblock", false, verbose, true);
 }
 
 int
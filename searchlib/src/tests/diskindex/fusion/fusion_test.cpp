@@ -445,6 +445,50 @@ Test::requireThatFusionIsWorking(const vespalib::string &prefix,
             break;
         TEST_DO(validateDiskIndex(dw3, true, true));
     } while (0);
+    do {
+        std::vector<vespalib::string> sources;
+        SelectorArray selector(numDocs, 0);
+        sources.push_back(prefix + "dump2");
+        auto progress = std::make_shared<FusionProgress>();
+        // Small memory budget, forcing fields to be merged one at a time
+        if (!EXPECT_TRUE(Fusion::merge(schema,
+                                       prefix + "dump7",
+                                       sources, selector,
+                                       dynamicKPosOcc,
+                                       tuneFileIndexing,
+                                       fileHeaderContext,
+                                       4, 1, progress)))
+            return;
+        EXPECT_TRUE(progress->isDone());
+        EXPECT_EQUAL(4u, progress->getNumThreads());
+        EXPECT_EQUAL(4u, progress->getNumFields());
+        EXPECT_EQUAL(4u, progress->getNumDoneFields());
+        for (const auto &field : progress->getFields()) {
+            EXPECT_TRUE(field.state == FusionProgress::State::DONE);
+            EXPECT_LESS(0u, field.memoryEstimate);
+        }
+        EXPECT_TRUE(progress->getFields()[0].name == "f0");
+        EXPECT_LESS(0u, progress->getFields()[0].numWordIds);
+    } while (0);
+    do {
+        std::vector<vespalib::string> sources;
+        SelectorArray selector(numDocs, 0);
+        sources.push_back(prefix + "dump2");
+        if (!EXPECT_TRUE(Fusion::merge(schema,
+                                       prefix + "dump8",
+                                       sources, selector,
+                                       dynamicKPosOcc,
+                                       tuneFileIndexing,
+                                       fileHeaderContext,
+                                       4, 0)))
+            return;
+    } while (0);
+    for (const char *dir : { "dump7", "dump8" }) {
+        DiskIndex dw(prefix + dir);
+        if (!EXPECT_TRUE(dw.setup(tuneFileSearch)))
+            break;
+        TEST_DO(validateDiskIndex(dw, true, true));
+    }
 }
 
 Test::Test()
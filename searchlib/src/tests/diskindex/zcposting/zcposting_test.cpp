@@ -0,0 +1,289 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/common/tunefileinfo.h>
+#include <vespa/searchlib/diskindex/blockposoccrandread.h>
+#include <vespa/searchlib/diskindex/blockposting.h>
+#include <vespa/searchlib/diskindex/fieldwriter.h>
+#include <vespa/searchlib/diskindex/pagedict4randread.h>
+#include <vespa/searchlib/diskindex/zcposoccrandread.h>
+#include <vespa/searchlib/fef/termfieldmatchdata.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+#include <vespa/searchlib/index/docidandfeatures.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/index/postinglisthandle.h>
+#include <vespa/searchlib/queryeval/posting_info.h>
+#include <vespa/searchlib/queryeval/searchiterator.h>
+#include <vespa/vespalib/io/fileutil.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+
+using search::TuneFileRandRead;
+using search::TuneFileSeqWrite;
+using search::diskindex::BlockPosOccRandRead;
+using search::diskindex::BlockPostingFormat;
+using search::diskindex::FieldWriter;
+using search::diskindex::PageDict4RandRead;
+using search::diskindex::Zc4PosOccRandRead;
+using search::diskindex::ZcPosOccRandRead;
+using search::fef::TermFieldMatchData;
+using search::fef::TermFieldMatchDataArray;
+using search::index::DocIdAndFeatures;
+using search::index::DummyFileHeaderContext;
+using search::index::PostingListFileRandRead;
+using search::index::PostingListHandle;
+using search::index::PostingListOffsetAndCounts;
+using search::index::Schema;
+using search::index::WordDocElementFeatures;
+using search::index::WordDocElementWordPosFeatures;
+using search::index::schema::CollectionType;
+using search::index::schema::DataType;
+using search::queryeval::BlockMaxPostingInfo;
+using search::queryeval::SearchIterator;
+
+namespace {
+
+const vespalib::string dir("zcposting");
+const uint32_t l1SkipStride = 16;
+
+struct Word {
+    vespalib::string word;
+    std::vector<uint32_t> docIds;
+    std::vector<int32_t> weights;
+
+    Word(const vespalib::string &word_, uint32_t numDocs)
+        : word(word_),
+          docIds(),
+          weights()
+    {
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            docIds.push_back(2 * i + 1);
+            weights.push_back(static_cast<int32_t>((i * 7919u) % 2000u) - 500);
+        }
+    }
+    ~Word();
+    uint32_t docIdLimit() const { return docIds.back() + 2; }
+    int32_t maxWeight() const { return *std::max_element(weights.begin(), weights.end()); }
+};
+
+Word::~Word() = default;
+
+/*
+ * Documents are split into chunks of minChunkDocs documents and each
+ * chunk is split into blocks of blockSize documents. Returns the
+ * index range [first, last] of the block containing document idx.
+ */
+std::pair<uint32_t, uint32_t>
+blockBounds(uint32_t idx, uint32_t numDocs, uint32_t minChunkDocs, uint32_t blockSize)
+{
+    uint32_t chunkStart = (idx / minChunkDocs) * minChunkDocs;
+    uint32_t chunkEnd = std::min(chunkStart + minChunkDocs, numDocs);
+    uint32_t blockStart = chunkStart + ((idx - chunkStart) / blockSize) * blockSize;
+    return std::make_pair(blockStart, std::min(blockStart + blockSize, chunkEnd) - 1);
+}
+
+class Fixture
+{
+    Schema _schema;
+    bool _dynamicK;
+    bool _blockPostings;
+    uint32_t _minChunkDocs;
+    vespalib::string _prefix;
+    std::unique_ptr<PageDict4RandRead> _dictFile;
+    std::unique_ptr<PostingListFileRandRead> _postingFile;
+
+public:
+    Fixture(const vespalib::string &name, bool blockMaxWeights, bool dynamicK, uint32_t minChunkDocs,
+            bool blockPostings = false);
+    ~Fixture();
+    void write(const std::vector<Word> &words);
+    void open();
+    SearchIterator::UP createIterator(const Word &word, TermFieldMatchDataArray &tfmda);
+    void assertBlocks(const Word &word, uint32_t stride);
+};
+
+Fixture::Fixture(const vespalib::string &name, bool blockMaxWeights, bool dynamicK, uint32_t minChunkDocs,
+                 bool blockPostings)
+    : _schema(),
+      _dynamicK(dynamicK),
+      _blockPostings(blockPostings),
+      _minChunkDocs(minChunkDocs),
+      _prefix(dir + "/" + name + "/"),
+      _dictFile(),
+      _postingFile()
+{
+    _schema.addIndexField(Schema::IndexField("f", DataType::STRING, CollectionType::WEIGHTEDSET).
+                          setBlockMaxWeights(blockMaxWeights));
+    vespalib::mkdir(_prefix, true);
+}
+
+Fixture::~Fixture() = default;
+
+void
+Fixture::write(const std::vector<Word> &words)
+{
+    TuneFileSeqWrite tuneFileWrite;
+    DummyFileHeaderContext fileHeaderContext;
+    fileHeaderContext.disableFileName();
+    uint32_t docIdLimit = 0;
+    for (const auto &word : words) {
+        docIdLimit = std::max(docIdLimit, word.docIdLimit());
+    }
+    FieldWriter writer(docIdLimit, words.size());
+    ASSERT_TRUE(writer.open(_prefix, 64, _minChunkDocs, _dynamicK, _blockPostings, _schema, 0,
+                            tuneFileWrite, fileHeaderContext));
+    DocIdAndFeatures features;
+    for (const auto &word : words) {
+        writer.newWord(word.word);
+        for (size_t i = 0; i < word.docIds.size(); ++i) {
+            features.clear(word.docIds[i]);
+            features._elements.emplace_back(0, word.weights[i], 1);
+            features._elements.back().setNumOccs(1);
+            features._wordPositions.emplace_back(0);
+            writer.add(features);
+        }
+    }
+    ASSERT_TRUE(writer.close());
+}
+
+void
+Fixture::open()
+{
+    TuneFileRandRead tuneFileRead;
+    _dictFile = std::make_unique<PageDict4RandRead>();
+    ASSERT_TRUE(_dictFile->open(_prefix + "dictionary", tuneFileRead));
+    if (_blockPostings) {
+        _postingFile = std::make_unique<BlockPosOccRandRead>();
+    } else if (_dynamicK) {
+        _postingFile = std::make_unique<ZcPosOccRandRead>();
+    } else {
+        _postingFile = std::make_unique<Zc4PosOccRandRead>();
+    }
+    ASSERT_TRUE(_postingFile->open(_prefix + "posocc.dat.compressed", tuneFileRead));
+}
+
+SearchIterator::UP
+Fixture::createIterator(const Word &word, TermFieldMatchDataArray &tfmda)
+{
+    PostingListOffsetAndCounts offsetAndCounts;
+    uint64_t wordNum = 0;
+    EXPECT_TRUE(_dictFile->lookup(word.word, wordNum, offsetAndCounts));
+    PostingListHandle handle;
+    handle._file = _postingFile.get();
+    handle._bitOffset = offsetAndCounts._offset;
+    handle._bitLength = offsetAndCounts._counts._bitLength;
+    const auto &counts = offsetAndCounts._counts;
+    _postingFile->readPostingList(counts, 0, counts._segments.empty() ? 1 : counts._segments.size(), handle);
+    SearchIterator::UP iterator(handle.createIterator(counts, tfmda));
+    iterator->initFullRange();
+    return iterator;
+}
+
+/*
+ * Seek to every stride'th document, checking that the block max info
+ * exposed by the iterator matches the block containing the document.
+ * Seeking to the even docid before each document makes the iterator
+ * skip over the gap as well.
+ */
+void
+Fixture::assertBlocks(const Word &word, uint32_t stride)
+{
+    TermFieldMatchData md;
+    TermFieldMatchDataArray tfmda;
+    tfmda.add(&md);
+    SearchIterator::UP iterator = createIterator(word, tfmda);
+    auto info = dynamic_cast<const BlockMaxPostingInfo *>(iterator->getPostingInfo());
+    ASSERT_TRUE(info != nullptr);
+    EXPECT_EQUAL(word.maxWeight(), info->getMaxWeight());
+    uint32_t numDocs = word.docIds.size();
+    bool rare = numDocs < 64;
+    for (uint32_t i = 0; i < numDocs; i += stride) {
+        uint32_t docId = word.docIds[i];
+        iterator->seek(std::max(docId - 1, 1u));
+        if (!EXPECT_EQUAL(docId, iterator->getDocId())) {
+            return;
+        }
+        if (rare) {
+            EXPECT_EQUAL(search::endDocId, info->getBlockLastDocId());
+            EXPECT_EQUAL(word.maxWeight(), info->getBlockMaxWeight());
+            continue;
+        }
+        uint32_t blockSize = _blockPostings ? BlockPostingFormat::BLOCK_SIZE : l1SkipStride;
+        auto bounds = blockBounds(i, numDocs, _minChunkDocs, blockSize);
+        uint32_t first = bounds.first;
+        uint32_t last = bounds.second;
+        int32_t blockMax = *std::max_element(word.weights.begin() + first, word.weights.begin() + last + 1);
+        if (!EXPECT_EQUAL(word.docIds[last], info->getBlockLastDocId()) ||
+            !EXPECT_EQUAL(blockMax, info->getBlockMaxWeight()))
+        {
+            return;
+        }
+    }
+    iterator->seek(word.docIds.back() + 1);
+    EXPECT_TRUE(iterator->isAtEnd());
+}
+
+std::vector<Word>
+makeWords()
+{
+    std::vector<Word> words;
+    words.emplace_back("common", 30005);
+    words.emplace_back("rare", 40);
+    return words;
+}
+
+void
+assertBlockMaxWeights(const vespalib::string &name, bool dynamicK, uint32_t minChunkDocs,
+                      bool blockPostings = false)
+{
+    std::vector<Word> words = makeWords();
+    Fixture f(name, true, dynamicK, minChunkDocs, blockPostings);
+    TEST_DO(f.write(words));
+    TEST_DO(f.open());
+    // Strides covering plain iteration and L1, L2, L3, L4 and chunk skips
+    for (uint32_t stride : { 1u, 7u, 100u, 1000u, 8500u, 10000u }) {
+        for (const auto &word : words) {
+            TEST_STATE(vespalib::make_string("word=%s, stride=%u", word.word.c_str(), stride).c_str());
+            TEST_DO(f.assertBlocks(word, stride));
+        }
+    }
+}
+
+}
+
+TEST("require that block max weights are not written unless enabled in schema") {
+    std::vector<Word> words = makeWords();
+    Fixture f("disabled", false, true, 1 << 30);
+    TEST_DO(f.write(words));
+    TEST_DO(f.open());
+    for (const auto &word : words) {
+        TermFieldMatchData md;
+        TermFieldMatchDataArray tfmda;
+        tfmda.add(&md);
+        SearchIterator::UP iterator = f.createIterator(word, tfmda);
+        EXPECT_TRUE(iterator->getPostingInfo() == nullptr);
+    }
+}
+
+TEST("require that block max weights are exposed when seeking zc posting lists") {
+    assertBlockMaxWeights("zc", true, 1 << 30);
+}
+
+TEST("require that block max weights are exposed when seeking zc4 posting lists") {
+    assertBlockMaxWeights("zc4", false, 1 << 30);
+}
+
+TEST("require that block max weights are exposed when seeking chunked posting lists") {
+    assertBlockMaxWeights("zcchunked", true, 9000);
+    assertBlockMaxWeights("zc4chunked", false, 9000);
+}
+
+TEST("require that block max weights are exposed when seeking block posting lists") {
+    assertBlockMaxWeights("block", true, 1 << 30, true);
+}
+
+TEST_MAIN() {
+    vespalib::rmdir(dir, true);
+    TEST_RUN_ALL();
+    vespalib::rmdir(dir, true);
+}
@@ -0,0 +1,125 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/searchlib/docstore/chunkcache.h>
+
+using namespace search::docstore;
+using search::CacheStats;
+using vespalib::DataBuffer;
+
+ChunkCache::Blob
+makeBlob(size_t size, char fill = 'x')
+{
+    auto blob = std::make_shared<DataBuffer>(size);
+    for (size_t i = 0; i < size; ++i) {
+        blob->writeInt8(fill);
+    }
+    return blob;
+}
+
+void
+access(ChunkCache &cache, uint64_t file, uint32_t chunk, size_t size = 1000)
+{
+    if ( ! cache.get(file, chunk)) {
+        cache.put(file, chunk, makeBlob(size));
+    }
+}
+
+TEST("require that frequency sketch counts and saturates") {
+    FrequencySketch sketch(100);
+    EXPECT_EQUAL(0u, sketch.estimate(17));
+    sketch.record(17);
+    sketch.record(17);
+    EXPECT_EQUAL(2u, sketch.estimate(17));
+    EXPECT_EQUAL(0u, sketch.estimate(18));
+    for (size_t i = 0; i < 100; ++i) {
+        sketch.record(17);
+    }
+    EXPECT_EQUAL(15u, sketch.estimate(17));
+}
+
+TEST("require that frequency sketch ages counters") {
+    FrequencySketch sketch(100);
+    for (size_t i = 0; i < 8; ++i) {
+        sketch.record(17);
+    }
+    for (uint64_t key = 1000; key < 1000 + sketch.getSampleSize(); ++key) {
+        sketch.record(key * 0x9e3779b97f4a7c15ul);
+    }
+    EXPECT_GREATER_EQUAL(4u, sketch.estimate(17));
+}
+
+TEST("require that disabled cache stores nothing") {
+    ChunkCache cache(0);
+    EXPECT_FALSE(cache.enabled());
+    cache.put(1, 1, makeBlob(10));
+    EXPECT_FALSE(cache.get(1, 1));
+}
+
+TEST("require that cached chunk is returned and counted as hit") {
+    ChunkCache cache(100000);
+    EXPECT_TRUE(cache.enabled());
+    EXPECT_FALSE(cache.get(1, 7));
+    cache.put(1, 7, makeBlob(100, 'a'));
+    ChunkCache::Blob blob = cache.get(1, 7);
+    ASSERT_TRUE(blob);
+    EXPECT_EQUAL(100u, blob->getDataLen());
+    EXPECT_EQUAL('a', blob->getData()[0]);
+    EXPECT_FALSE(cache.get(2, 7));
+    EXPECT_FALSE(cache.get(1, 8));
+    CacheStats stats = cache.getCacheStats();
+    EXPECT_EQUAL(1u, stats.hits);
+    EXPECT_EQUAL(3u, stats.misses);
+    EXPECT_EQUAL(1u, stats.elements);
+    EXPECT_GREATER_EQUAL(stats.memory_used, 100u);
+}
+
+TEST("require that chunk larger than cache is not admitted") {
+    ChunkCache cache(1000);
+    access(cache, 1, 1, 2000);
+    EXPECT_EQUAL(0u, cache.getCacheStats().elements);
+}
+
+TEST("require that memory usage stays within capacity") {
+    ChunkCache cache(10000);
+    for (uint32_t chunk = 0; chunk < 100; ++chunk) {
+        access(cache, 1, chunk);
+        access(cache, 1, chunk);
+        EXPECT_GREATER_EQUAL(10000u, cache.getCacheStats().memory_used);
+    }
+    EXPECT_GREATER(cache.getCacheStats().elements, 0u);
+}
+
+TEST("require that a scan does not flush frequently used chunks") {
+    ChunkCache cache(10000);
+    for (size_t round = 0; round < 5; ++round) {
+        for (uint32_t chunk = 0; chunk < 5; ++chunk) {
+            access(cache, 1, chunk);
+        }
+    }
+    for (uint32_t chunk = 0; chunk < 1000; ++chunk) {
+        access(cache, 2, chunk);
+    }
+    size_t hitsBefore = cache.getCacheStats().hits;
+    for (uint32_t chunk = 0; chunk < 5; ++chunk) {
+        EXPECT_TRUE(cache.get(1, chunk));
+    }
+    EXPECT_EQUAL(hitsBefore + 5, cache.getCacheStats().hits);
+}
+
+TEST("require that reduced capacity evicts entries") {
+    ChunkCache cache(100000);
+    for (uint32_t chunk = 0; chunk < 10; ++chunk) {
+        access(cache, 1, chunk);
+    }
+    EXPECT_EQUAL(10u, cache.getCacheStats().elements);
+    cache.setCapacity(3000);
+    EXPECT_EQUAL(3000u, cache.getCapacity());
+    EXPECT_GREATER_EQUAL(3000u, cache.getCacheStats().memory_used);
+    EXPECT_LESS(cache.getCacheStats().elements, 10u);
+    cache.setCapacity(0);
+    EXPECT_FALSE(cache.enabled());
+    EXPECT_EQUAL(0u, cache.getCacheStats().elements);
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
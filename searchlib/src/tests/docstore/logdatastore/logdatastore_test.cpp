@@ -439,9 +439,12 @@ makeDoc(const DocumentTypeRepo &repo, uint32_t i, bool extra_field)
 
 class VisitCacheStore {
 public:
-    VisitCacheStore();
+    VisitCacheStore(size_t chunkCacheSize = 0);
     ~VisitCacheStore();
     IDocumentStore & getStore() { return _datastore; }
+    void flush() {
+        _datastore.flush(_datastore.initFlush(_serial - 1));
+    }
     void write(uint32_t id) {
         write(id, makeDoc(_repo, id, true));
     }
@@ -459,6 +462,12 @@ public:
     void verifyRead(uint32_t id) {
         verifyDoc(*_datastore.read(id, _repo), id);
     }
+    void verifyReadSerialized(uint32_t id) {
+        vespalib::DataBuffer buf;
+        EXPECT_TRUE(_datastore.readSerialized(id, buf));
+        vespalib::nbostream is(buf.getData(), buf.getDataLen());
+        verifyDoc(Document(_repo, is), id);
+    }
     void verifyDoc(const Document & doc, uint32_t id) {
         EXPECT_TRUE(doc == *_inserted[id]);
     }
@@ -509,11 +518,11 @@ VisitCacheStore::VerifyVisitor::~VerifyVisitor() {
     EXPECT_EQUAL(_expected.size(), _actual.size());
 }
 
-VisitCacheStore::VisitCacheStore() :
+VisitCacheStore::VisitCacheStore(size_t chunkCacheSize) :
     _myDir("visitcache"),
     _repo(makeDocTypeRepoConfig()),
     _config(DocumentStore::Config(CompressionConfig::LZ4, 1000000, 0).allowVisitCaching(true),
-            LogDataStore::Config().setMaxFileSize(50000).setMaxBucketSpread(3.0)
+            LogDataStore::Config().setMaxFileSize(50000).setMaxBucketSpread(3.0).setChunkCacheSize(chunkCacheSize)
                     .setFileConfig(WriteableFileChunk::Config(CompressionConfig(), 16384))),
     _fileHeaderContext(),
     _executor(1, 128*1024),
@@ -582,6 +591,64 @@ TEST("test that the integrated visit cache works.") {
     TEST_DO(verifyCacheStats(ds.getCacheStats(), 101, 108, 99, 20944));
 }
 
+TEST("require that chunk cache stats are reported separately from the document cache stats") {
+    VisitCacheStore vcs(1000000);
+    IDocumentStore & ds = vcs.getStore();
+    for (size_t i(1); i <= 100; i++) {
+        vcs.write(i);
+    }
+    vcs.flush();
+    TEST_DO(verifyCacheStats(ds.getCacheStats(), 0, 0, 0, 0));
+    TEST_DO(verifyCacheStats(ds.getChunkCacheStats(), 0, 0, 0, 0));
+    for (size_t i(1); i <= 100; i++) {
+        vcs.verifyRead(i);
+    }
+    TEST_DO(verifyCacheStats(ds.getCacheStats(), 0, 100, 100, 20574));
+    CacheStats chunkStats = ds.getChunkCacheStats();
+    EXPECT_GREATER(chunkStats.misses, 0u);
+    EXPECT_GREATER(chunkStats.hits, 0u);
+    EXPECT_EQUAL(chunkStats.misses, chunkStats.elements);
+    EXPECT_GREATER(chunkStats.memory_used, 0u);
+    for (size_t i(1); i <= 100; i++) {
+        vcs.verifyRead(i);
+    }
+    TEST_DO(verifyCacheStats(ds.getCacheStats(), 100, 100, 100, 20574));
+    TEST_DO(verifyCacheStats(ds.getChunkCacheStats(), chunkStats.hits, chunkStats.misses,
+                             chunkStats.elements, chunkStats.memory_used));
+}
+
+TEST("require that chunk cache stats are empty when the chunk cache is disabled") {
+    VisitCacheStore vcs;
+    IDocumentStore & ds = vcs.getStore();
+    for (size_t i(1); i <= 100; i++) {
+        vcs.write(i);
+    }
+    vcs.flush();
+    for (size_t i(1); i <= 100; i++) {
+        vcs.verifyRead(i);
+    }
+    TEST_DO(verifyCacheStats(ds.getChunkCacheStats(), 0, 0, 0, 0));
+}
+
+TEST("require that serialized documents can be read without deserializing") {
+    VisitCacheStore vcs;
+    for (size_t i(1); i <= 10; i++) {
+        vcs.write(i);
+    }
+    for (size_t i(1); i <= 10; i++) {
+        vcs.verifyReadSerialized(i);
+    }
+    EXPECT_EQUAL(10u, vcs.getStore().getCacheStats().misses);
+    for (size_t i(1); i <= 10; i++) {
+        vcs.verifyReadSerialized(i);
+    }
+    EXPECT_EQUAL(10u, vcs.getStore().getCacheStats().hits);
+    vcs.remove(7);
+    vespalib::DataBuffer buf;
+    EXPECT_FALSE(vcs.getStore().readSerialized(7, buf));
+    EXPECT_FALSE(vcs.getStore().readSerialized(11, buf));
+}
+
 TEST("testWriteRead") {
     FastOS_File::RemoveDirectory("empty");
     const char * bufA = "aaaaaaaaaaaaaaaaaaaaa";
@@ -765,12 +832,15 @@ struct Fixture {
     Fixture(const vespalib::string &dirName = "tmp",
             bool dirCleanup = true,
             size_t maxFileSize = 4096 * 2)
+        : Fixture(dirName, dirCleanup, getBasicConfig(maxFileSize))
+    {}
+    Fixture(const vespalib::string &dirName, bool dirCleanup, const LogDataStore::Config &config)
         : executor(1, 0x10000),
           dir(dirName),
           serialNum(0),
           fileHeaderCtx(),
           tlSyncer(),
-          store(executor, dirName, getBasicConfig(maxFileSize), GrowStrategy(),
+          store(executor, dirName, config, GrowStrategy(),
                 TuneFileSummary(), fileHeaderCtx, tlSyncer, nullptr)
     {
         dir.cleanup(dirCleanup);
@@ -892,6 +962,43 @@ TEST("require that lid space can be compacted and entries from old files skipped
     }
 }
 
+class CollectVisitor : public IBufferVisitor {
+public:
+    std::vector<std::pair<uint32_t, vespalib::string>> visited;
+    void visit(uint32_t lid, vespalib::ConstBufferRef buf) override {
+        visited.emplace_back(lid, vespalib::string(buf.c_str(), buf.size()));
+    }
+};
+
+void
+verifyMultiLidRead(uint32_t maxReadThreads)
+{
+    // Small chunks give many chunks per file, and a small max file size gives several frozen files.
+    Fixture f("tmp", true, getBasicConfig(4096 * 2).setMaxReadThreads(maxReadThreads)
+                                .setFileConfig(WriteableFileChunk::Config({}, 2048)));
+    uint32_t lastLid = f.writeUntilNewChunk(1);
+    lastLid = f.writeUntilNewChunk(lastLid + 1);
+    EXPECT_GREATER(f.store.getFileChunkStats().size(), 2u);
+    IDataStore::LidVector lids;
+    for (uint32_t lid = 1; lid <= lastLid; lid += 2) {
+        lids.push_back(lid);
+    }
+    std::reverse(lids.begin(), lids.end());
+    lids.push_back(lastLid + 100);
+    CollectVisitor visitor;
+    f.store.read(lids, visitor);
+    std::sort(visitor.visited.begin(), visitor.visited.end());
+    ASSERT_EQUAL(lids.size() - 1, visitor.visited.size());
+    for (const auto &entry : visitor.visited) {
+        EXPECT_EQUAL(genData(entry.first, 1024), entry.second);
+    }
+}
+
+TEST("require that multi lid read visits all lids across files and chunks") {
+    TEST_DO(verifyMultiLidRead(0));
+    TEST_DO(verifyMultiLidRead(4));
+}
+
 TEST_F("require that getLid() is protected by docIdLimit", Fixture)
 {
     f.write(1);
@@ -974,6 +1081,8 @@ TEST("require that config equality operator detects inequality") {
     EXPECT_FALSE(C() == C().setMaxDiskBloatFactor(0.3));
     EXPECT_FALSE(C() == C().setMaxBucketSpread(0.3));
     EXPECT_FALSE(C() == C().setMinFileSizeFactor(0.3));
+    EXPECT_FALSE(C() == C().setMaxReadThreads(4));
+    EXPECT_FALSE(C() == C().setChunkCacheSize(1000000));
     EXPECT_FALSE(C() == C().setFileConfig(WriteableFileChunk::Config({}, 70)));
     EXPECT_FALSE(C() == C().disableCrcOnRead(true));
     EXPECT_FALSE(C() == C().compact2ActiveFile(false));
@@ -4,6 +4,7 @@
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/searchlib/fef/feature_type.h>
 #include <vespa/searchlib/fef/featurenameparser.h>
+#include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/features/rankingexpressionfeature.h>
 #include <vespa/searchlib/fef/test/dummy_dependency_handler.h>
 #include <vespa/searchlib/fef/test/indexenvironment.h>
@@ -65,16 +66,21 @@ struct SetupResult {
     RankingExpressionBlueprint rank;
     DummyDependencyHandler deps;
     bool setup_ok;
-    SetupResult(const TypeMap &object_inputs, const vespalib::string &expression);
+    SetupResult(const TypeMap &object_inputs, const vespalib::string &expression,
+                bool compile_tensors = false);
     ~SetupResult();
 };
 
 SetupResult::SetupResult(const TypeMap &object_inputs,
-                         const vespalib::string &expression)
+                         const vespalib::string &expression,
+                         bool compile_tensors)
     : stash(), index_env(), query_env(&index_env), rank(make_replacer()), deps(rank), setup_ok(false)
 {
     rank.setName("self");
     index_env.getProperties().add("self.rankingScript", expression);
+    if (compile_tensors) {
+        index_env.getProperties().add(indexproperties::eval::CompileTensorExpressions::NAME, "true");
+    }
     for (const auto &input: object_inputs) {
         deps.define_object_input(input.first, ValueType::from_spec(input.second));
     }
@@ -84,9 +90,10 @@ SetupResult::SetupResult(const TypeMap &object_inputs,
 SetupResult::~SetupResult() {}
 
 void verify_output_type(const TypeMap &object_inputs,
-                        const vespalib::string &expression, const FeatureType &expect)
+                        const vespalib::string &expression, const FeatureType &expect,
+                        bool compile_tensors = false)
 {
-    SetupResult result(object_inputs, expression);
+    SetupResult result(object_inputs, expression, compile_tensors);
     EXPECT_TRUE(result.setup_ok);
     EXPECT_EQUAL(1u, result.deps.output.size());
     ASSERT_EQUAL(1u, result.deps.output_type.size());
@@ -119,6 +126,28 @@ TEST("require that expression with object input produces object output (interpre
     TEST_DO(verify_output_type({{"b", "double"}}, "a*b", FeatureType::object(ValueType::double_type())));
 }
 
+TEST("require that dense tensor expression produces number output when tensor compilation is enabled") {
+    TypeMap inputs({{"a", "tensor(x[3])"}, {"b", "tensor(x[3])"}});
+    TEST_DO(verify_output_type(inputs, "reduce(a*b,sum)", FeatureType::object(ValueType::double_type())));
+    TEST_DO(verify_output_type(inputs, "reduce(a*b,sum)", FeatureType::number(), true));
+}
+
+TEST("require that tensor compilation falls back to interpretation when not supported") {
+    TEST_DO(verify_output_type({{"a", "tensor(x{})"}}, "reduce(a,sum)",
+                               FeatureType::object(ValueType::double_type()), true));
+    TEST_DO(verify_output_type({{"a", "tensor(x[3])"}}, "a*2",
+                               FeatureType::object(ValueType::from_spec("tensor(x[3])")), true));
+}
+
+TEST("require that tensor compilation needs all inputs to be numbers or concrete dense tensors") {
+    TEST_DO(verify_output_type({{"a", "tensor(x[3])"}, {"b", "double"}}, "reduce(a,sum)*b",
+                               FeatureType::number(), true));
+    TEST_DO(verify_output_type({{"a", "tensor(x[])"}}, "reduce(a,sum)",
+                               FeatureType::object(ValueType::double_type()), true));
+    TEST_DO(verify_output_type({{"a", "tensor(x[3])"}, {"b", "tensor(y{})"}}, "reduce(a,sum)+reduce(b,sum)",
+                               FeatureType::object(ValueType::double_type()), true));
+}
+
 TEST("require that ranking expression can resolve to concrete complex type") {
     TEST_DO(verify_output_type({{"a", "tensor(x{},y{})"}, {"b", "tensor(y{},z{})"}}, "a*b",
                                FeatureType::object(ValueType::from_spec("tensor(x{},y{},z{})"))));
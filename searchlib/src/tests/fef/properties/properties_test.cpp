@@ -226,6 +226,14 @@ TEST("test stuff") {
             EXPECT_TRUE(!eval::LazyExpressions::check(p, true));
             EXPECT_TRUE(!eval::LazyExpressions::check(p, false));
         }
+        { // vespa.eval.compile_tensor_expressions
+            EXPECT_EQUAL(eval::CompileTensorExpressions::NAME, vespalib::string("vespa.eval.compile_tensor_expressions"));
+            EXPECT_TRUE(!eval::CompileTensorExpressions::DEFAULT_VALUE);
+            Properties p;
+            EXPECT_TRUE(!eval::CompileTensorExpressions::check(p));
+            p = Properties().add("vespa.eval.compile_tensor_expressions", "true");
+            EXPECT_TRUE(eval::CompileTensorExpressions::check(p));
+        }
         { // vespa.rank.firstphase
             EXPECT_EQUAL(rank::FirstPhase::NAME, vespalib::string("vespa.rank.firstphase"));
             EXPECT_EQUAL(rank::FirstPhase::DEFAULT_VALUE, vespalib::string("nativeRank"));
@@ -295,6 +303,24 @@ TEST("test stuff") {
             p.add("vespa.matching.numsearchpartitions", "50");
             EXPECT_EQUAL(matching::NumSearchPartitions::lookup(p), 50u);
         }
+        {
+            EXPECT_EQUAL(matching::PartitionedGroupingMerge::NAME, vespalib::string("vespa.matching.partitionedgroupingmerge"));
+            EXPECT_EQUAL(matching::PartitionedGroupingMerge::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matching::PartitionedGroupingMerge::lookup(p), false);
+            EXPECT_EQUAL(matching::PartitionedGroupingMerge::lookup(p, true), true);
+            p.add("vespa.matching.partitionedgroupingmerge", "true");
+            EXPECT_EQUAL(matching::PartitionedGroupingMerge::lookup(p), true);
+        }
+        {
+            EXPECT_EQUAL(matching::WorkStealing::NAME, vespalib::string("vespa.matching.workstealing"));
+            EXPECT_EQUAL(matching::WorkStealing::DEFAULT_VALUE, false);
+            Properties p;
+            EXPECT_EQUAL(matching::WorkStealing::lookup(p), false);
+            EXPECT_EQUAL(matching::WorkStealing::lookup(p, true), true);
+            p.add("vespa.matching.workstealing", "true");
+            EXPECT_EQUAL(matching::WorkStealing::lookup(p), true);
+        }
         { // vespa.matchphase.degradation.attribute
             EXPECT_EQUAL(matchphase::DegradationAttribute::NAME, vespalib::string("vespa.matchphase.degradation.attribute"));
             EXPECT_EQUAL(matchphase::DegradationAttribute::DEFAULT_VALUE, "");
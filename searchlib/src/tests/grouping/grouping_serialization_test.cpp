@@ -4,6 +4,8 @@
 #include <vespa/searchlib/aggregation/aggregation.h>
 #include <vespa/searchlib/aggregation/expressioncountaggregationresult.h>
 #include <vespa/searchlib/aggregation/perdocexpression.h>
+#include <vespa/searchlib/aggregation/quantileaggregationresult.h>
+#include <vespa/searchlib/aggregation/topkaggregationresult.h>
 #include <vespa/searchlib/expression/getdocidnamespacespecificfunctionnode.h>
 #include <vespa/searchlib/expression/getymumchecksumfunctionnode.h>
 #include <vespa/searchlib/expression/documentfieldnode.h>
@@ -233,6 +235,14 @@ TEST_F("testAggregatorResults", Fixture("testAggregatorResults")) {
     stddev.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(67)))
             .aggregate(DocId(42), HitRank(21));
     f.checkObject(stddev);
+    QuantileAggregationResult quantile;
+    quantile.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(67)))
+            .aggregate(DocId(42), HitRank(21));
+    f.checkObject(quantile);
+    TopKAggregationResult topK;
+    topK.setExpression(MU<ConstantNode>(MU<Int64ResultNode>(67)))
+            .aggregate(DocId(42), HitRank(21));
+    f.checkObject(topK);
 }
 
 TEST_F("testHitCollection", Fixture("testHitCollection")) {
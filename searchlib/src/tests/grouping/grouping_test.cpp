@@ -134,6 +134,8 @@ public:
                          const Group &expect);
     bool testMerge(const Grouping &a, const Grouping &b,
                    const Group &expect);
+    bool testPartitionedMerge(const Grouping &a, const Grouping &b,
+                              const Group &expect);
     bool testMerge(const Grouping &a, const Grouping &b, const Grouping &c,
                    const Group &expect);
     bool testPrune(const Grouping &a, const Grouping &b,
@@ -220,6 +222,45 @@ Test::testMerge(const Grouping &a, const Grouping &b,
     return EXPECT_EQUAL(tmp.getRoot().asString(), expect.asString());
 }
 
+/**
+ * Merge the given grouping requests by splitting the top level groups
+ * into two id ranges at each possible position, merging each range
+ * separately, and verify that the resulting group tree matches the
+ * expected value.
+ **/
+bool
+Test::testPartitionedMerge(const Grouping &a, const Grouping &b,
+                           const Group &expect)
+{
+    bool ok = true;
+    for (uint32_t split = 0; split <= a.getRoot().getChildrenSize(); ++split) {
+        Grouping tmp = a; // create local copy
+        Grouping tmpB = b;
+        std::vector<Group> partitions(2);
+        for (Grouping *g : {&tmp, &tmpB}) {
+            uint32_t offset = g->getRoot().getChildrenSize();
+            if (split < a.getRoot().getChildrenSize()) {
+                offset = g->getRoot().lowerBoundChild(a.getRoot().getChild(split).getId());
+            }
+            Group::GroupList children = g->getRoot().groups();
+            std::vector<Group *> lower(children, children + offset);
+            std::vector<Group *> upper(children + offset, children + g->getRoot().getChildrenSize());
+            tmp.mergePartition(partitions[0], lower);
+            tmp.mergePartition(partitions[1], upper);
+        }
+        std::vector<Group *> partitionRefs;
+        for (Group &partition : partitions) {
+            tmp.prunePartition(partition);
+            partitionRefs.push_back(&partition);
+        }
+        tmp.mergePartitions({&tmpB}, partitionRefs);
+        tmp.postMerge();
+        tmp.sortById();
+        ok = EXPECT_EQUAL(tmp.getRoot().asString(), expect.asString()) && ok;
+    }
+    return ok;
+}
+
 /**
  * Prune the given grouping request and verify that the resulting
  * group tree matches the expected value.
@@ -969,12 +1010,15 @@ Test::testMergeGroups()
     request.levels()[0].setMaxGroups(3);
     EXPECT_TRUE(testMerge(request.unchain().setRoot(a), request.unchain().setRoot(b), expect_3));
     EXPECT_TRUE(testMerge(request.unchain().setRoot(b), request.unchain().setRoot(a), expect_3));
+    EXPECT_TRUE(testPartitionedMerge(request.unchain().setRoot(a), request.unchain().setRoot(b), expect_3));
     request.levels()[0].setMaxGroups(5);
     EXPECT_TRUE(testMerge(request.unchain().setRoot(a), request.unchain().setRoot(b), expect_5));
     EXPECT_TRUE(testMerge(request.unchain().setRoot(b), request.unchain().setRoot(a), expect_5));
+    EXPECT_TRUE(testPartitionedMerge(request.unchain().setRoot(a), request.unchain().setRoot(b), expect_5));
     request.levels()[0].setMaxGroups(-1);
     EXPECT_TRUE(testMerge(request.unchain().setRoot(a), request.unchain().setRoot(b), expect_all));
     EXPECT_TRUE(testMerge(request.unchain().setRoot(b), request.unchain().setRoot(a), expect_all));
+    EXPECT_TRUE(testPartitionedMerge(request.unchain().setRoot(a), request.unchain().setRoot(b), expect_all));
 }
 
 /**
@@ -1244,6 +1288,8 @@ Test::testMergeTrees()
 
     EXPECT_TRUE(testMerge(request.unchain().setRoot(a), request.unchain().setRoot(b), expect));
     EXPECT_TRUE(testMerge(request.unchain().setRoot(b), request.unchain().setRoot(a), expect));
+    EXPECT_TRUE(testPartitionedMerge(request.unchain().setRoot(a), request.unchain().setRoot(b), expect));
+    EXPECT_TRUE(testPartitionedMerge(request.unchain().setRoot(b), request.unchain().setRoot(a), expect));
 }
 
 void
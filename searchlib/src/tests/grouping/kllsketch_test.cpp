@@ -0,0 +1,111 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for kllsketch.
+
+#include <vespa/log/log.h>
+LOG_SETUP("kllsketch_test");
+
+#include <vespa/searchlib/grouping/kllsketch.h>
+#include <vespa/vespalib/objects/nboserializer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+#include <random>
+
+using vespalib::NBOSerializer;
+using vespalib::nbostream;
+using namespace search;
+
+namespace {
+
+// Values 0 .. n-1 in random order, so quantile q should be close to q * n.
+std::vector<double> shuffled(size_t n, uint32_t seed) {
+    std::vector<double> values;
+    for (size_t i = 0; i < n; ++i) {
+        values.push_back(i);
+    }
+    std::shuffle(values.begin(), values.end(), std::mt19937(seed));
+    return values;
+}
+
+void checkQuantiles(const KllSketch &sketch, size_t n) {
+    for (double q : {0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99}) {
+        TEST_STATE(vespalib::make_string("q=%g", q).c_str());
+        EXPECT_APPROX(q * n, sketch.quantile(q), 0.02 * n);
+    }
+}
+
+TEST("require that small streams give exact quantiles") {
+    KllSketch sketch;
+    for (double value : {5.0, 1.0, 4.0, 2.0, 3.0}) {
+        sketch.add(value);
+    }
+    EXPECT_EQUAL(5u, sketch.getCount());
+    EXPECT_EQUAL(5u, sketch.getNumRetained());
+    EXPECT_EQUAL(1.0, sketch.quantile(0.0));
+    EXPECT_EQUAL(1.0, sketch.quantile(0.2));
+    EXPECT_EQUAL(3.0, sketch.quantile(0.5));
+    EXPECT_EQUAL(5.0, sketch.quantile(1.0));
+}
+
+TEST("require that empty sketch gives zero") {
+    KllSketch sketch;
+    EXPECT_EQUAL(0u, sketch.getCount());
+    EXPECT_EQUAL(0.0, sketch.quantile(0.5));
+}
+
+TEST("require that memory is bounded and quantiles are approximated") {
+    const size_t n = 1000000;
+    KllSketch sketch;
+    for (double value : shuffled(n, 1)) {
+        sketch.add(value);
+    }
+    EXPECT_EQUAL(n, sketch.getCount());
+    EXPECT_LESS(sketch.getNumRetained(), 4 * KllSketch::DEFAULT_K);
+    EXPECT_EQUAL(0.0, sketch.getMin());
+    EXPECT_EQUAL(n - 1.0, sketch.getMax());
+    checkQuantiles(sketch, n);
+}
+
+TEST("require that merged sketches approximate the combined stream") {
+    const size_t n = 200000;
+    std::vector<double> values = shuffled(n, 2);
+    std::vector<KllSketch> parts(7);
+    for (size_t i = 0; i < n; ++i) {
+        parts[i % parts.size()].add(values[i]);
+    }
+    KllSketch merged;
+    for (const KllSketch &part : parts) {
+        merged.merge(part);
+    }
+    EXPECT_EQUAL(n, merged.getCount());
+    EXPECT_LESS(merged.getNumRetained(), 4 * KllSketch::DEFAULT_K);
+    checkQuantiles(merged, n);
+}
+
+TEST("require that sketches with different k can not be merged") {
+    KllSketch a(100);
+    KllSketch b(200);
+    EXPECT_EXCEPTION(a.merge(b), std::runtime_error, "different k");
+}
+
+TEST("require that sketch can be (de)serialized") {
+    KllSketch sketch(50);
+    for (double value : shuffled(10000, 3)) {
+        sketch.add(value);
+    }
+    nbostream stream;
+    NBOSerializer serializer(stream);
+    sketch.serialize(serializer);
+    KllSketch sketch2;
+    sketch2.deserialize(serializer);
+    EXPECT_EQUAL(0u, stream.size());
+    EXPECT_TRUE(sketch == sketch2);
+    EXPECT_EQUAL(sketch.quantile(0.5), sketch2.quantile(0.5));
+    sketch2.add(42.0);
+    EXPECT_FALSE(sketch == sketch2);
+}
+
+}  // namespace
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,119 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Unit tests for spacesavingsketch.
+
+#include <vespa/log/log.h>
+LOG_SETUP("spacesavingsketch_test");
+
+#include <vespa/searchlib/grouping/spacesavingsketch.h>
+#include <vespa/searchlib/expression/integerresultnode.h>
+#include <vespa/searchlib/expression/stringresultnode.h>
+#include <vespa/vespalib/objects/nboserializer.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <vespa/vespalib/util/stringfmt.h>
+
+using vespalib::NBOSerializer;
+using vespalib::nbostream;
+using search::expression::Int64ResultNode;
+using search::expression::StringResultNode;
+using namespace search;
+
+namespace {
+
+// Value i is seen (100 - i) times for i < 10, followed by a long tail
+// of values seen once.
+void addSkewed(SpaceSavingSketch &sketch, int64_t tailStart, int64_t tailSize) {
+    for (int64_t i = 0; i < 10; ++i) {
+        for (int64_t j = i; j < 100; ++j) {
+            sketch.add(Int64ResultNode(i));
+        }
+        for (int64_t j = 0; j < tailSize / 10; ++j) {
+            sketch.add(Int64ResultNode(tailStart + i * (tailSize / 10) + j));
+        }
+    }
+}
+
+// The frequent values are the top 10, with estimated counts bounding
+// the exact count from above, and count - error bounding it from below.
+void checkSkewed(const SpaceSavingSketch &sketch, uint64_t factor) {
+    auto topK = sketch.getTopK();
+    ASSERT_TRUE(topK.size() >= 10);
+    for (size_t pos = 0; pos < 10; ++pos) {
+        int64_t i = topK[pos]->value->getInteger();
+        TEST_STATE(vespalib::make_string("i=%d", int(i)).c_str());
+        ASSERT_TRUE((i >= 0) && (i < 10));
+        uint64_t exact = factor * (100 - i);
+        EXPECT_GREATER_EQUAL(topK[pos]->count, exact);
+        EXPECT_LESS_EQUAL(topK[pos]->count - topK[pos]->error, exact);
+    }
+}
+
+TEST("require that exact counts are kept below capacity") {
+    SpaceSavingSketch sketch(4);
+    sketch.add(StringResultNode("a"));
+    sketch.add(StringResultNode("b"), 3);
+    sketch.add(StringResultNode("a"));
+    auto topK = sketch.getTopK();
+    ASSERT_EQUAL(2u, topK.size());
+    EXPECT_EQUAL(0, topK[0]->value->cmp(StringResultNode("b")));
+    EXPECT_EQUAL(3u, topK[0]->count);
+    EXPECT_EQUAL(2u, topK[1]->count);
+    EXPECT_EQUAL(0u, topK[1]->error);
+    EXPECT_EQUAL(5u, sketch.getTotal());
+}
+
+TEST("require that least frequent value is replaced when full") {
+    SpaceSavingSketch sketch(2);
+    sketch.add(Int64ResultNode(1), 5);
+    sketch.add(Int64ResultNode(2), 2);
+    sketch.add(Int64ResultNode(3));
+    auto topK = sketch.getTopK();
+    ASSERT_EQUAL(2u, topK.size());
+    EXPECT_EQUAL(1, topK[0]->value->getInteger());
+    EXPECT_EQUAL(3, topK[1]->value->getInteger());
+    EXPECT_EQUAL(3u, topK[1]->count);
+    EXPECT_EQUAL(2u, topK[1]->error);
+}
+
+TEST("require that frequent values are found in a long tail") {
+    SpaceSavingSketch sketch(32);
+    addSkewed(sketch, 1000, 500);
+    EXPECT_EQUAL(32u, sketch.getSize());
+    checkSkewed(sketch, 1);
+}
+
+TEST("require that merged sketches find frequent values of the combined streams") {
+    SpaceSavingSketch merged(32);
+    for (int64_t part = 0; part < 4; ++part) {
+        SpaceSavingSketch sketch(32);
+        addSkewed(sketch, 1000 * (part + 1), 500);
+        merged.merge(sketch);
+    }
+    EXPECT_EQUAL(32u, merged.getSize());
+    checkSkewed(merged, 4);
+}
+
+TEST("require that sketches with different capacity can not be merged") {
+    SpaceSavingSketch a(10);
+    SpaceSavingSketch b(20);
+    EXPECT_EXCEPTION(a.merge(b), std::runtime_error, "different capacity");
+}
+
+TEST("require that sketch can be (de)serialized") {
+    SpaceSavingSketch sketch(16);
+    addSkewed(sketch, 1000, 100);
+    nbostream stream;
+    NBOSerializer serializer(stream);
+    sketch.serialize(serializer);
+    SpaceSavingSketch sketch2;
+    sketch2.deserialize(serializer);
+    EXPECT_EQUAL(0u, stream.size());
+    EXPECT_TRUE(sketch == sketch2);
+    checkSkewed(sketch2, 1);
+    sketch2.add(Int64ResultNode(5));
+    EXPECT_FALSE(sketch == sketch2);
+}
+
+}  // namespace
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -632,6 +632,29 @@ TEST_F("requireThatMultiplePostingListsCanExist", Fixture)
     EXPECT_TRUE(assertPostingList("[]", d.find("c", 0)));
 }
 
+TEST_F("requireThatWordsSharingPrefixCanBeFound", Fixture)
+{
+    Dictionary d(f.getSchema());
+    std::vector<vespalib::string> words = {"a", "abcdefg", "abcdefgh", "abcdefgha", "abcdefghb",
+                                           "abcdefgi", "b", "\xc3\xa6", "\xc3\xa6\xc3\xb8\xc3\xa5\xc3\xa6\xc3\xb8"};
+    WrapInserter inserter(d, 0);
+    uint32_t docId = 10;
+    for (const auto &word : words) {
+        inserter.word(word).add(docId++);
+    }
+    inserter.flush();
+    EXPECT_EQUAL(words.size(), d.getNumUniqueWords());
+    docId = 10;
+    for (const auto &word : words) {
+        TEST_STATE(word.c_str());
+        EXPECT_TRUE(assertPostingList("[" + std::to_string(docId++) + "]", d.find(word, 0)));
+    }
+    EXPECT_TRUE(assertPostingList("[]", d.find("abcdef", 0)));
+    EXPECT_TRUE(assertPostingList("[]", d.find("abcdefgh0", 0)));
+    EXPECT_TRUE(assertPostingList("[]", d.find("abcdefghc", 0)));
+    EXPECT_TRUE(assertPostingList("[]", d.find("\xc3", 0)));
+}
+
 TEST_F("requireThatRemoveWorks", Fixture)
 {
     Dictionary d(f.getSchema());
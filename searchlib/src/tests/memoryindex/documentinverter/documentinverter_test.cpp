@@ -3,11 +3,14 @@
 
 
 #include <vespa/searchlib/index/docbuilder.h>
+#include <vespa/searchlib/memoryindex/dictionary.h>
 #include <vespa/searchlib/memoryindex/documentinverter.h>
 #include <vespa/searchlib/memoryindex/fieldinverter.h>
 #include <vespa/searchlib/test/memoryindex/ordereddocumentinserter.h>
 #include <vespa/searchlib/common/sequencedtaskexecutor.h>
+#include <vespa/searchlib/common/idestructorcallback.h>
 #include <vespa/vespalib/testkit/testapp.h>
+#include <sstream>
 
 namespace search {
 
@@ -98,6 +101,7 @@ struct Fixture
     SequencedTaskExecutor _pushThreads;
     DocumentInverter _inv;
     test::OrderedDocumentInserter _inserter;
+    Dictionary _dict;
 
     static Schema
     makeSchema()
@@ -110,13 +114,14 @@ struct Fixture
         return schema;
     }
 
-    Fixture()
+    Fixture(uint32_t numPartitions = 1)
         : _schema(makeSchema()),
           _b(_schema),
           _invertThreads(2),
           _pushThreads(2),
-          _inv(_schema, _invertThreads, _pushThreads),
-          _inserter()
+          _inv(_schema, _invertThreads, _pushThreads, numPartitions),
+          _inserter(),
+          _dict(_schema)
     {
     }
 
@@ -132,6 +137,32 @@ struct Fixture
         }
         _pushThreads.sync();
     }
+
+    void
+    commit()
+    {
+        _invertThreads.sync();
+        _pushThreads.sync();
+        _inv.pushDocuments(_dict, std::shared_ptr<IDestructorCallback>());
+        // Partitions are sorted by the invert threads before being pushed
+        _invertThreads.sync();
+        _pushThreads.sync();
+    }
+
+    std::string
+    postings(const vespalib::string &word, uint32_t fieldId)
+    {
+        std::ostringstream os;
+        os << "[";
+        bool first = true;
+        for (auto itr = _dict.find(word, fieldId); itr.valid(); ++itr) {
+            if (!first) os << ",";
+            os << itr.getKey();
+            first = false;
+        }
+        os << "]";
+        return os.str();
+    }
 };
 
 
@@ -271,6 +302,78 @@ TEST_F("requireThatMixOfAddAndRemoveWorks", Fixture)
 }
 
 
+TEST_F("require that partitioned inverters are merged", Fixture(3))
+{
+    f._inv.invertDocument(10, *makeDoc10(f._b));
+    f._inv.invertDocument(11, *makeDoc11(f._b));
+    f._inv.invertDocument(12, *makeDoc12(f._b));
+    f._inv.invertDocument(14, *makeDoc14(f._b));
+    f.commit();
+    EXPECT_EQUAL("[10,11]", f.postings("a", 0));
+    EXPECT_EQUAL("[10,11]", f.postings("b", 0));
+    EXPECT_EQUAL("[10]", f.postings("c", 0));
+    EXPECT_EQUAL("[10]", f.postings("d", 0));
+    EXPECT_EQUAL("[12]", f.postings("doc12", 0));
+    EXPECT_EQUAL("[14]", f.postings("doc14", 0));
+    EXPECT_EQUAL("[11]", f.postings("e", 0));
+    EXPECT_EQUAL("[11]", f.postings("f", 0));
+    EXPECT_EQUAL("[12]", f.postings("h", 0));
+    EXPECT_EQUAL("[14]", f.postings("j", 0));
+    EXPECT_EQUAL("[11]", f.postings("a", 1));
+    EXPECT_EQUAL("[11]", f.postings("g", 1));
+}
+
+
+TEST_F("require that partitioned inverters handle reput and abort", Fixture(3))
+{
+    f._inv.invertDocument(10, *makeDoc10(f._b));
+    f._inv.invertDocument(11, *makeDoc11(f._b));
+    f._inv.invertDocument(12, *makeDoc12(f._b));
+    f._inv.invertDocument(10, *makeDoc11(f._b));
+    f._inv.removeDocument(12);
+    f.commit();
+    EXPECT_EQUAL("[10,11]", f.postings("a", 0));
+    EXPECT_EQUAL("[10,11]", f.postings("b", 0));
+    EXPECT_EQUAL("[]", f.postings("c", 0));
+    EXPECT_EQUAL("[]", f.postings("d", 0));
+    EXPECT_EQUAL("[10,11]", f.postings("e", 0));
+    EXPECT_EQUAL("[10,11]", f.postings("f", 0));
+    EXPECT_EQUAL("[]", f.postings("h", 0));
+    EXPECT_EQUAL("[10,11]", f.postings("a", 1));
+    EXPECT_EQUAL("[10,11]", f.postings("g", 1));
+}
+
+
+TEST_F("require that removes are merged before adds for partitioned inverters", Fixture(3))
+{
+    f._inv.invertDocument(10, *makeDoc10(f._b));
+    f._inv.invertDocument(11, *makeDoc11(f._b));
+    f._inv.invertDocument(12, *makeDoc12(f._b));
+    f.commit();
+    EXPECT_EQUAL("[10,11]", f.postings("a", 0));
+    EXPECT_EQUAL("[12]", f.postings("h", 0));
+    EXPECT_EQUAL("[11]", f.postings("a", 1));
+
+    // Reput of 10 removes its old words before adding the new ones
+    f._inv.invertDocument(10, *makeDoc11(f._b));
+    f._inv.removeDocument(11);
+    f._inv.removeDocument(12);
+    f._inv.invertDocument(13, *makeDoc13(f._b));
+    f.commit();
+    EXPECT_EQUAL("[10]", f.postings("a", 0));
+    EXPECT_EQUAL("[10]", f.postings("b", 0));
+    EXPECT_EQUAL("[]", f.postings("c", 0));
+    EXPECT_EQUAL("[]", f.postings("d", 0));
+    EXPECT_EQUAL("[10]", f.postings("e", 0));
+    EXPECT_EQUAL("[10]", f.postings("f", 0));
+    EXPECT_EQUAL("[]", f.postings("h", 0));
+    EXPECT_EQUAL("[]", f.postings("doc12", 0));
+    EXPECT_EQUAL("[13]", f.postings("i", 0));
+    EXPECT_EQUAL("[10]", f.postings("a", 1));
+    EXPECT_EQUAL("[10]", f.postings("g", 1));
+}
+
+
 TEST_F("require that empty document can be inverted", Fixture)
 {
     f._inv.invertDocument(15, *makeDoc15(f._b));
@@ -56,7 +56,7 @@ struct Index {
     uint32_t     docid;
     std::string  currentField;
 
-    Index(const Setup &setup);
+    Index(const Setup &setup, uint32_t invertThreads = 2);
     ~Index();
     void closeField() {
         if (!currentField.empty()) {
@@ -86,10 +86,14 @@ struct Index {
                       makeLambdaTask([&]() { gate.countDown(); })));
         gate.await();
     }
-    Document::UP commit() {
+    Document::UP insert() {
         closeField();
         Document::UP d = builder.endDocument();
         index.insertDocument(docid, *d);
+        return d;
+    }
+    Document::UP commit() {
+        Document::UP d = insert();
         internalSyncCommit();
         return d;
     }
@@ -105,10 +109,10 @@ private:
 };
 
 
-Index::Index(const Setup &setup)
+Index::Index(const Setup &setup, uint32_t invertThreads)
     : schema(setup.schema),
       _executor(1, 128 * 1024),
-      _invertThreads(2),
+      _invertThreads(invertThreads),
       _pushThreads(2),
       index(schema, _invertThreads, _pushThreads),
       builder(schema),
@@ -286,6 +290,51 @@ TEST("require that documents can be removed and updated")
                             index.index, title, makeTerm(foo)));
 }
 
+// tests that documents inserted, removed and updated in the same
+// commit are merged correctly when each field is inverted by several
+// partitions.
+TEST("require that documents can be removed and updated with partitioned inverters")
+{
+    // 4 invert threads and 2 fields gives 2 partitions per field
+    Index index(Setup().field(title).field(body), 4);
+
+    // add unordered, in one commit
+    index.doc(3).field(title).add(foo).add(foo).add(foo).insert();
+    index.doc(1).field(title).add(foo).field(body).add(bar).insert();
+    index.doc(4).field(title).add(bar).add(foo).insert();
+    index.doc(2).field(title).add(foo).add(foo).field(body).add(bar).insert();
+    index.internalSyncCommit();
+
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(1).pos(0)
+                            .doc(2).len(2).pos(0).pos(1)
+                            .doc(3).len(3).pos(0).pos(1).pos(2)
+                            .doc(4).len(2).pos(1),
+                            index.index, title, makeTerm(foo)));
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(1).pos(0)
+                            .doc(2).len(1).pos(0),
+                            index.index, body, makeTerm(bar)));
+
+    // remove and update documents from both partitions, in one commit
+    index.index.removeDocument(2);
+    index.index.removeDocument(3);
+    index.doc(1).field(title).add(bar).add(foo).add(foo).insert();
+    index.doc(4).field(title).add(foo).field(body).add(bar).insert();
+    index.internalSyncCommit();
+
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(3).pos(1).pos(2)
+                            .doc(4).len(1).pos(0),
+                            index.index, title, makeTerm(foo)));
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(1).len(3).pos(0),
+                            index.index, title, makeTerm(bar)));
+    EXPECT_TRUE(verifyResult(FakeResult()
+                            .doc(4).len(1).pos(0),
+                            index.index, body, makeTerm(bar)));
+}
+
 // test the fake field source here, to make sure it acts similar to
 // the memory index field source.
 TEST("testFakeSearchable")
@@ -12,6 +12,7 @@
 #include <vespa/searchlib/test/weightedchildrenverifiers.h>
 #include <vespa/searchlib/test/document_weight_attribute_helper.h>
 #include <vespa/searchlib/queryeval/document_weight_search_iterator.h>
+#include <vespa/searchlib/queryeval/posting_info.h>
 #include <vespa/searchlib/fef/fef.h>
 
 using namespace search::query;
@@ -684,4 +685,163 @@ TEST("verify search iterator conformance") {
     }
 }
 
+/**
+ * Posting list iterator exposing the max weight of each block of
+ * blockSize documents, like disk index posting lists written with block
+ * max weights. Counts the number of unpacked documents.
+ */
+class BlockMaxSearch : public SearchIterator
+{
+public:
+    static const uint32_t blockSize = 16;
+
+private:
+    TermFieldMatchData &_tfmd;
+    std::vector<uint32_t> _docIds;
+    std::vector<int32_t> _weights;
+    size_t _offset;
+    std::unique_ptr<MinMaxPostingInfo> _postingInfo;
+    BlockMaxPostingInfo *_blockMaxInfo;
+    size_t &_unpacks;
+
+    void updateBlock() {
+        if (_blockMaxInfo == nullptr) {
+            return;
+        }
+        if (_offset >= _docIds.size()) {
+            _blockMaxInfo->setBlock(search::endDocId, std::numeric_limits<int32_t>::min());
+            return;
+        }
+        size_t first = (_offset / blockSize) * blockSize;
+        size_t last = std::min(first + blockSize, _docIds.size()) - 1;
+        _blockMaxInfo->setBlock(_docIds[last], *std::max_element(_weights.begin() + first, _weights.begin() + last + 1));
+    }
+
+public:
+    BlockMaxSearch(TermFieldMatchData &tfmd, const std::vector<uint32_t> &docIds,
+                   const std::vector<int32_t> &weights, bool blockMax, size_t &unpacks)
+        : _tfmd(tfmd),
+          _docIds(docIds),
+          _weights(weights),
+          _offset(0),
+          _postingInfo(),
+          _blockMaxInfo(nullptr),
+          _unpacks(unpacks)
+    {
+        int32_t minWeight = *std::min_element(weights.begin(), weights.end());
+        int32_t maxWeight = *std::max_element(weights.begin(), weights.end());
+        if (blockMax) {
+            auto blockMaxInfo = std::make_unique<BlockMaxPostingInfo>(minWeight, maxWeight, search::endDocId);
+            _blockMaxInfo = blockMaxInfo.get();
+            _postingInfo = std::move(blockMaxInfo);
+        } else {
+            _postingInfo = std::make_unique<MinMaxPostingInfo>(minWeight, maxWeight);
+        }
+        updateBlock();
+    }
+    void initRange(uint32_t begin, uint32_t end) override {
+        SearchIterator::initRange(begin, end);
+        _offset = 0;
+        updateBlock();
+    }
+    void doSeek(uint32_t docid) override {
+        while (_offset < _docIds.size() && _docIds[_offset] < docid) {
+            ++_offset;
+        }
+        if (_offset < _docIds.size()) {
+            setDocId(_docIds[_offset]);
+        } else {
+            setAtEnd();
+        }
+        updateBlock();
+    }
+    void doUnpack(uint32_t docid) override {
+        ++_unpacks;
+        _tfmd.reset(docid);
+        _tfmd.appendPosition(search::fef::TermFieldMatchDataPosition(0, 0, _weights[_offset], 1));
+    }
+    const PostingInfo *getPostingInfo() const override { return _postingInfo.get(); }
+};
+
+struct BlockMaxFixture
+{
+    std::vector<std::vector<uint32_t>> docIds;
+    std::vector<std::vector<int32_t>> weights;
+
+    BlockMaxFixture() : docIds(), weights() {
+        // low weights everywhere, except for a few blocks with high weights
+        addTerm(4000, 1, [](uint32_t i) { return (i >= 1000 && i < 1016) ? 1000 : 1 + int32_t((i * 31) % 7); });
+        addTerm(1500, 3, [](uint32_t i) { return (i >= 700 && i < 720) ? 500 : 1 + int32_t((i * 17) % 5); });
+    }
+    template <typename F>
+    void addTerm(uint32_t numDocs, uint32_t stride, F weight) {
+        docIds.emplace_back();
+        weights.emplace_back();
+        for (uint32_t i = 0; i < numDocs; ++i) {
+            docIds.back().push_back(stride * i + 1);
+            weights.back().push_back(weight(i));
+        }
+    }
+    FakeResult search(bool blockMax, bool strict, size_t &unpacks) {
+        SharedWeakAndPriorityQueue heap(10);
+        MatchParams matchParams(heap, 0, 1.0, 1);
+        TermFieldMatchData rootMatchData;
+        MatchDataLayout layout;
+        std::vector<TermFieldHandle> handles;
+        for (size_t i = 0; i < docIds.size(); ++i) {
+            handles.push_back(layout.allocTermField(0));
+        }
+        MatchData::UP childrenMatchData = layout.createMatchData();
+        wand::Terms terms;
+        for (size_t i = 0; i < docIds.size(); ++i) {
+            TermFieldMatchData *tfmd = childrenMatchData->resolveTermField(handles[i]);
+            terms.push_back(wand::Term(new BlockMaxSearch(*tfmd, docIds[i], weights[i], blockMax, unpacks),
+                                       1, docIds[i].size(), tfmd));
+        }
+        SearchIterator::UP sb(ParallelWeakAndSearch::create(terms, matchParams,
+                                                            RankParams(rootMatchData, std::move(childrenMatchData)),
+                                                            strict));
+        if (!strict) {
+            FakeResult retval;
+            sb->initFullRange();
+            for (uint32_t docId = 1; docId < 4002; ++docId) {
+                if (sb->seek(docId)) {
+                    sb->unpack(docId);
+                    retval.doc(docId).score(rootMatchData.getRawScore());
+                }
+            }
+            return retval;
+        }
+        return doSearch(*sb, rootMatchData);
+    }
+};
+
+bool
+hasHit(const SimpleResult &result, uint32_t docId)
+{
+    for (size_t i = 0; i < result.getHitCount(); ++i) {
+        if (result.getHit(i) == docId) {
+            return true;
+        }
+    }
+    return false;
+}
+
+TEST_F("require that block max weights prune candidates without changing the result", BlockMaxFixture)
+{
+    for (bool strict : {true, false}) {
+        TEST_STATE(strict ? "strict" : "non-strict");
+        size_t plainUnpacks = 0;
+        size_t blockMaxUnpacks = 0;
+        FakeResult plain = f.search(false, strict, plainUnpacks);
+        FakeResult blockMax = f.search(true, strict, blockMaxUnpacks);
+        EXPECT_EQUAL(plain, blockMax);
+        EXPECT_LESS(blockMaxUnpacks, plainUnpacks);
+        // the documents in the high weight blocks must be among the hits
+        SimpleResult hits = asSimpleResult(blockMax);
+        EXPECT_TRUE(hasHit(hits, 1001));
+        EXPECT_TRUE(hasHit(hits, 3 * 700 + 1));
+    }
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
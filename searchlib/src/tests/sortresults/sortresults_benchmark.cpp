@@ -0,0 +1,176 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Measures multi level attribute sorting of the hits of a query: a full
+// sort, a top n sort with preselection on the first sort level, and top n
+// sorts of the hits of each match thread merged like the partial results
+// of the match threads are.
+
+#include <vespa/searchlib/attribute/attributecontext.h>
+#include <vespa/searchlib/attribute/attributefactory.h>
+#include <vespa/searchlib/attribute/attributemanager.h>
+#include <vespa/searchlib/attribute/integerbase.h>
+#include <vespa/searchlib/attribute/stringbase.h>
+#include <vespa/searchlib/common/sortresults.h>
+#include <vespa/searchlib/uca/ucaconverter.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <vespa/vespalib/util/clock.h>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+using search::AttributeContext;
+using search::AttributeFactory;
+using search::AttributeManager;
+using search::AttributeVector;
+using search::IntegerAttribute;
+using search::RankedHit;
+using search::StringAttribute;
+using search::attribute::BasicType;
+using search::attribute::CollectionType;
+using search::attribute::Config;
+
+namespace {
+
+const char *sortSpec = "+category -uca(title,en_US) +price";
+
+struct Setup {
+    AttributeManager mgr;
+    std::vector<RankedHit> hits;
+    vespalib::Clock clock;
+    vespalib::Doom doom;
+    search::uca::UcaConverterFactory ucaFactory;
+
+    Setup(uint32_t numDocs);
+    ~Setup();
+};
+
+Setup::Setup(uint32_t numDocs)
+    : mgr(),
+      hits(),
+      clock(),
+      doom(clock, std::numeric_limits<long>::max()),
+      ucaFactory()
+{
+    std::mt19937 rnd(42);
+    auto category = AttributeFactory::createAttribute("category", Config(BasicType::INT8, CollectionType::SINGLE));
+    auto title = AttributeFactory::createAttribute("title", Config(BasicType::STRING, CollectionType::SINGLE));
+    auto price = AttributeFactory::createAttribute("price", Config(BasicType::INT32, CollectionType::SINGLE));
+    for (auto &attr : { category, title, price }) {
+        attr->addDocs(numDocs);
+    }
+    for (uint32_t docId = 0; docId < numDocs; ++docId) {
+        static_cast<IntegerAttribute &>(*category).update(docId, rnd() % 16);
+        std::string word;
+        for (uint32_t len = 4 + rnd() % 12; word.size() < len;) {
+            word.push_back('a' + rnd() % 26);
+        }
+        static_cast<StringAttribute &>(*title).update(docId, word.c_str());
+        static_cast<IntegerAttribute &>(*price).update(docId, rnd() % 100000);
+        hits.emplace_back(docId, rnd() % 1000);
+    }
+    for (auto &attr : { category, title, price }) {
+        attr->commit();
+        mgr.add(attr);
+    }
+}
+
+Setup::~Setup() = default;
+
+struct Winner {
+    RankedHit hit;
+    std::string sortData;
+};
+
+std::vector<Winner>
+sortTopN(Setup &setup, RankedHit *hits, uint32_t numHits, uint32_t topn)
+{
+    AttributeContext ac(setup.mgr);
+    FastS_SortSpec spec(7, setup.doom, setup.ucaFactory);
+    spec.Init(sortSpec, ac);
+    spec.sortResults(hits, numHits, topn);
+    std::vector<Winner> winners;
+    for (uint32_t i = 0; i < std::min(numHits, topn); ++i) {
+        auto ref = spec.getSortRef(i);
+        winners.push_back(Winner{hits[i], std::string(ref.first, ref.second)});
+    }
+    return winners;
+}
+
+std::vector<Winner>
+sortTopNPerThread(Setup &setup, std::vector<RankedHit> &hits, uint32_t topn, uint32_t numThreads)
+{
+    std::vector<std::vector<Winner>> threadWinners(numThreads);
+    std::vector<std::thread> threads;
+    uint32_t chunk = (hits.size() + numThreads - 1) / numThreads;
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        uint32_t begin = std::min<size_t>(t * chunk, hits.size());
+        uint32_t end = std::min<size_t>(begin + chunk, hits.size());
+        threads.emplace_back([&, t, begin, end]() {
+                threadWinners[t] = sortTopN(setup, &hits[begin], end - begin, topn);
+            });
+    }
+    std::vector<Winner> winners;
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        threads[t].join();
+        winners.insert(winners.end(), threadWinners[t].begin(), threadWinners[t].end());
+    }
+    std::sort(winners.begin(), winners.end(),
+              [](const Winner &a, const Winner &b) { return a.sortData < b.sortData; });
+    winners.resize(std::min<size_t>(winners.size(), topn));
+    return winners;
+}
+
+bool
+sameWinners(const std::vector<Winner> &a, const std::vector<Winner> &b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].sortData != b[i].sortData) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t numDocs = (argc > 1) ? strtoul(argv[1], NULL, 0) : 400000;
+    double budget = (argc > 2) ? strtod(argv[2], NULL) : 1.0;
+    uint32_t topn = 100;
+    Setup setup(numDocs);
+    printf("Sorting %u hits on '%s', top %u\n", numDocs, sortSpec, topn);
+    std::vector<RankedHit> hits;
+    std::vector<Winner> fullWinners;
+    double fullTime = vespalib::BenchmarkTimer::benchmark([&]() {
+            hits = setup.hits;
+            fullWinners = sortTopN(setup, &hits[0], hits.size(), hits.size());
+        }, budget);
+    fullWinners.resize(topn);
+    std::vector<Winner> topWinners;
+    double topTime = vespalib::BenchmarkTimer::benchmark([&]() {
+            hits = setup.hits;
+            topWinners = sortTopN(setup, &hits[0], hits.size(), topn);
+        }, budget);
+    printf("    full sort: %.2f ms, top n with preselection: %.2f ms\n", fullTime * 1000, topTime * 1000);
+    if (!sameWinners(fullWinners, topWinners)) {
+        fprintf(stderr, "Top n sort differs from full sort\n");
+        return 1;
+    }
+    for (uint32_t numThreads : { 2u, 4u, 8u }) {
+        std::vector<Winner> threadWinners;
+        double threadTime = vespalib::BenchmarkTimer::benchmark([&]() {
+                hits = setup.hits;
+                threadWinners = sortTopNPerThread(setup, hits, topn, numThreads);
+            }, budget);
+        printf("    %u threads, top n per thread merged: %.2f ms\n", numThreads, threadTime * 1000);
+        if (!sameWinners(fullWinners, threadWinners)) {
+            fprintf(stderr, "Top n sort with %u threads differs from full sort\n", numThreads);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -74,6 +74,7 @@ private:
 public:
     MultilevelSortTest() : _sortMethod(0) { srand(time(NULL)); }
     void testSortMethod(int method);
+    void testTopN(int method);
 };
 
 template<typename T>
@@ -389,6 +390,62 @@ void MultilevelSortTest::testSortMethod(int method)
 
 }
 
+void MultilevelSortTest::testTopN(int method)
+{
+    const uint32_t num = 5000;
+    VectorMap vec;
+    // Few unique values on the first level gives many ties to resolve on the next levels
+    vec["int8"] = AttributeFactory::createAttribute("int8", Config(BasicType::INT8, CollectionType::SINGLE));
+    fill<int8_t>(static_cast<IntegerAttribute *>(vec["int8"].get()), num, 4);
+    vec["string"] = AttributeFactory::createAttribute("string", Config(BasicType::STRING, CollectionType::SINGLE));
+    fill(static_cast<StringAttribute *>(vec["string"].get()), num, {"applications", "places", "system", "trondheim"});
+    vec["int32"] = AttributeFactory::createAttribute("int32", Config(BasicType::INT32, CollectionType::SINGLE));
+    fill<int32_t>(static_cast<IntegerAttribute *>(vec["int32"].get()), num, 0);
+    for (auto & v : vec) {
+        v.second->commit();
+    }
+
+    vespalib::Clock clock;
+    vespalib::Doom doom(clock, std::numeric_limits<long>::max());
+    search::uca::UcaConverterFactory ucaFactory;
+    for (uint32_t topn : {1u, 10u, 100u, 1000u}) {
+        std::vector<RankedHit> fullHits(num);
+        for (uint32_t i = 0; i < num; ++i) {
+            fullHits[i]._docId = i;
+            fullHits[i]._rankValue = getRandomValue<uint32_t>();
+        }
+        std::vector<RankedHit> topHits(fullHits);
+        FastS_SortSpec full(7, doom, ucaFactory, method);
+        FastS_SortSpec top(7, doom, ucaFactory, method);
+        for (FastS_SortSpec *sorter : {&full, &top}) {
+            sorter->_vectors.push_back(VectorRef(FastS_SortSpec::ASC_VECTOR, vec["int8"].get(), NULL));
+            sorter->_vectors.push_back(VectorRef(FastS_SortSpec::DESC_VECTOR, vec["string"].get(), NULL));
+            sorter->_vectors.push_back(VectorRef(FastS_SortSpec::ASC_VECTOR, vec["int32"].get(), NULL));
+            sorter->_vectors.push_back(VectorRef(FastS_SortSpec::DESC_RANK, NULL, NULL));
+        }
+        full.sortResults(&fullHits[0], num, num);
+        top.sortResults(&topHits[0], num, topn);
+        EXPECT_TRUE(top._sortDataArray.size() >= topn);
+        EXPECT_TRUE(top._sortDataArray.size() < num);
+        for (uint32_t i = 0; i < topn; ++i) {
+            auto fullRef = full.getSortRef(i);
+            auto topRef = top.getSortRef(i);
+            EXPECT_EQUAL(fullRef.second, topRef.second);
+            EXPECT_EQUAL(0, memcmp(fullRef.first, topRef.first, std::min(fullRef.second, topRef.second)));
+            EXPECT_EQUAL(fullHits[i]._docId, topHits[i]._docId);
+        }
+        // No hits are lost by the preselection
+        std::vector<uint32_t> docIds;
+        for (const RankedHit & hit : topHits) {
+            docIds.push_back(hit._docId);
+        }
+        std::sort(docIds.begin(), docIds.end());
+        for (uint32_t i = 0; i < num; ++i) {
+            EXPECT_EQUAL(i, docIds[i]);
+        }
+    }
+}
+
 TEST("require that all sort methods behave the same")
 {
     MultilevelSortTest test;
@@ -397,6 +454,14 @@ TEST("require that all sort methods behave the same")
     test.testSortMethod(2);
 }
 
+TEST("require that top n sorting with preselection finds the same top hits as a full sort")
+{
+    MultilevelSortTest test;
+    test.testTopN(0);
+    test.testTopN(1);
+    test.testTopN(2);
+}
+
 TEST("test that [docid] translates to [lid][paritionid]") {
     vespalib::Clock clock;
     vespalib::Doom doom(clock, fastos::ClockSystem::now() + fastos::TimeStamp::SEC*10);
@@ -5,6 +5,8 @@
 #include <vespa/vespalib/objects/identifiable.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/fastos/file.h>
+#include <vespa/vespalib/util/sync.h>
+#include <atomic>
 #include <map>
 
 #include <vespa/log/log.h>
@@ -52,6 +54,7 @@ private:
     void testMany();
     void testErase();
     void testSync();
+    void testCommitCallbacks(bool useFsync);
     void testTruncateOnShortRead();
     void testTruncateOnVersionMismatch();
 };
@@ -507,7 +510,7 @@ bool Test::testVisitOverGeneratedDomain()
 void Test::createAndFillDomain(const vespalib::string & name, DomainPart::Crc crcMethod, size_t preExistingDomains)
 {
     DummyFileHeaderContext fileHeaderContext;
-    TransLogServer tlss("test13", 18377, ".", fileHeaderContext, 0x10000, 4, crcMethod);
+    TransLogServer tlss("test13", 18377, ".", fileHeaderContext, 0x10000, 4, crcMethod, false);
     TransLogClient tls("tcp/localhost:18377");
 
     createDomainTest(tls, name, preExistingDomains);
@@ -770,6 +773,60 @@ Test::testSync()
     EXPECT_EQUAL(syncedTo, TOTAL_NUM_ENTRIES);
 }
 
+namespace {
+
+class CountingCallback : public IDestructorCallback
+{
+    std::atomic<size_t>     &_done;
+    vespalib::CountDownLatch &_latch;
+public:
+    CountingCallback(std::atomic<size_t> &done, vespalib::CountDownLatch &latch)
+        : _done(done),
+          _latch(latch)
+    { }
+    ~CountingCallback() override {
+        ++_done;
+        _latch.countDown();
+    }
+};
+
+}
+
+void
+Test::testCommitCallbacks(bool useFsync)
+{
+    const size_t NUM_PACKETS = 100;
+
+    DummyFileHeaderContext fileHeaderContext;
+    TransLogServer tlss(useFsync ? "test15" : "test14", 18377, ".", fileHeaderContext, 0x10000, 4, DomainPart::xxh64, useFsync);
+    TransLogClient tls("tcp/localhost:18377");
+
+    createDomainTest(tls, "callbacks", 0);
+    TransLogClient::Session::UP s1 = openDomainTest(tls, "callbacks");
+    std::atomic<size_t> done(0);
+    vespalib::CountDownLatch latch(NUM_PACKETS);
+    for (size_t i = 0; i < NUM_PACKETS; ++i) {
+        SerialNum serial(i + 1);
+        Packet packet;
+        ASSERT_TRUE(packet.add(Packet::Entry(serial, 1, vespalib::ConstBufferRef(&serial, sizeof(serial)))));
+        tlss.commit("callbacks", packet, std::make_shared<CountingCallback>(done, latch));
+        if ( ! useFsync) {
+            // Without fsync the callback is done as soon as the entry is written.
+            EXPECT_EQUAL(i + 1, done.load());
+        }
+    }
+    EXPECT_TRUE(latch.await(60000));
+    EXPECT_EQUAL(NUM_PACKETS, done.load());
+    SerialNum syncedTo(0);
+    EXPECT_TRUE(s1->sync(NUM_PACKETS, syncedTo));
+    EXPECT_EQUAL(NUM_PACKETS, syncedTo);
+    DomainInfo info = tlss.getDomainStats()["callbacks"];
+    EXPECT_EQUAL(NUM_PACKETS, info.range.to());
+    EXPECT_EQUAL(NUM_PACKETS, info.commitLatency.count);
+    if (useFsync) {
+        EXPECT_GREATER(info.syncLatency.count, 0u);
+    }
+}
 
 void
 Test::testTruncateOnVersionMismatch()
@@ -888,6 +945,8 @@ int Test::Main()
     testRemove();
     
     testSync();
+    testCommitCallbacks(false);
+    testCommitCallbacks(true);
 
     testTruncateOnShortRead();
     testTruncateOnVersionMismatch();
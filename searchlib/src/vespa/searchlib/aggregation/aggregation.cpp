@@ -2,6 +2,8 @@
 
 #include "aggregation.h"
 #include "expressioncountaggregationresult.h"
+#include "quantileaggregationresult.h"
+#include "topkaggregationresult.h"
 #include <vespa/searchlib/expression/resultvector.h>
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/vespalib/objects/visit.hpp>
@@ -36,6 +38,8 @@ IMPLEMENT_AGGREGATIONRESULT(AverageAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(XorAggregationResult,     AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(ExpressionCountAggregationResult, AggregationResult);
 IMPLEMENT_AGGREGATIONRESULT(StandardDeviationAggregationResult, AggregationResult);
+IMPLEMENT_AGGREGATIONRESULT(QuantileAggregationResult, AggregationResult);
+IMPLEMENT_AGGREGATIONRESULT(TopKAggregationResult, AggregationResult);
 
 AggregationResult::AggregationResult() :
     _expressionTree(new ExpressionTree()),
@@ -500,6 +504,122 @@ Deserializer &ExpressionCountAggregationResult::onDeserialize(
 ExpressionCountAggregationResult::ExpressionCountAggregationResult() : AggregationResult(), _hll() { }
 ExpressionCountAggregationResult::~ExpressionCountAggregationResult() {}
 
+QuantileAggregationResult::QuantileAggregationResult() : AggregationResult(), _sketch(), _rank(), _rankDirty(true) { }
+QuantileAggregationResult::QuantileAggregationResult(uint32_t k) : AggregationResult(), _sketch(k), _rank(), _rankDirty(true) { }
+QuantileAggregationResult::~QuantileAggregationResult() {}
+
+const ResultNode & QuantileAggregationResult::onGetRank() const
+{
+    if (_rankDirty) {
+        _rank.set(_sketch.quantile(0.5));
+        _rankDirty = false;
+    }
+    return _rank;
+}
+
+void QuantileAggregationResult::onMerge(const AggregationResult &r) {
+    const QuantileAggregationResult &result =
+        Identifiable::cast<const QuantileAggregationResult &>(r);
+    _sketch.merge(result._sketch);
+    _rankDirty = true;
+}
+
+void QuantileAggregationResult::onAggregate(const ResultNode &result) {
+    if (result.isMultiValue()) {
+        const ResultNodeVector &v = static_cast<const ResultNodeVector &>(result);
+        for (size_t i(0), m(v.size()); i < m; i++) {
+            _sketch.add(v.get(i).getFloat());
+        }
+    } else {
+        _sketch.add(result.getFloat());
+    }
+    _rankDirty = true;
+}
+
+void QuantileAggregationResult::onReset()
+{
+    _sketch = KllSketch(_sketch.getK());
+    _rankDirty = true;
+}
+
+Serializer & QuantileAggregationResult::onSerialize(Serializer & os) const
+{
+    AggregationResult::onSerialize(os);
+    _sketch.serialize(os);
+    return os;
+}
+
+Deserializer & QuantileAggregationResult::onDeserialize(Deserializer & is)
+{
+    AggregationResult::onDeserialize(is);
+    _sketch.deserialize(is);
+    _rankDirty = true;
+    return is;
+}
+
+void QuantileAggregationResult::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    AggregationResult::visitMembers(visitor);
+    visit(visitor, "k", _sketch.getK());
+    visit(visitor, "count", _sketch.getCount());
+    visit(visitor, "median", _sketch.quantile(0.5));
+}
+
+TopKAggregationResult::TopKAggregationResult() : AggregationResult(), _sketch(), _rank() { }
+TopKAggregationResult::TopKAggregationResult(uint32_t capacity) : AggregationResult(), _sketch(capacity), _rank() { }
+TopKAggregationResult::~TopKAggregationResult() {}
+
+const ResultNode & TopKAggregationResult::onGetRank() const
+{
+    auto topK = _sketch.getTopK();
+    _rank.set(topK.empty() ? 0 : topK[0]->count);
+    return _rank;
+}
+
+void TopKAggregationResult::onMerge(const AggregationResult &r) {
+    const TopKAggregationResult &result =
+        Identifiable::cast<const TopKAggregationResult &>(r);
+    _sketch.merge(result._sketch);
+}
+
+void TopKAggregationResult::onAggregate(const ResultNode &result) {
+    if (result.isMultiValue()) {
+        const ResultNodeVector &v = static_cast<const ResultNodeVector &>(result);
+        for (size_t i(0), m(v.size()); i < m; i++) {
+            _sketch.add(v.get(i));
+        }
+    } else {
+        _sketch.add(result);
+    }
+}
+
+void TopKAggregationResult::onReset()
+{
+    _sketch = SpaceSavingSketch(_sketch.getCapacity());
+}
+
+Serializer & TopKAggregationResult::onSerialize(Serializer & os) const
+{
+    AggregationResult::onSerialize(os);
+    _sketch.serialize(os);
+    return os;
+}
+
+Deserializer & TopKAggregationResult::onDeserialize(Deserializer & is)
+{
+    AggregationResult::onDeserialize(is);
+    _sketch.deserialize(is);
+    return is;
+}
+
+void TopKAggregationResult::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    AggregationResult::visitMembers(visitor);
+    visit(visitor, "capacity", _sketch.getCapacity());
+    visit(visitor, "total", _sketch.getTotal());
+    visit(visitor, "size", _sketch.getSize());
+}
+
 StandardDeviationAggregationResult::StandardDeviationAggregationResult()
         : AggregationResult(), _count(), _sum(), _sumOfSquared(), _stdDevScratchPad()
 {
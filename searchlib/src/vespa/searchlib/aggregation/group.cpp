@@ -123,15 +123,43 @@ Group::Value::groupSingle(const ResultNode & selectResult, HitRank rank, const G
 
 void
 Group::merge(const GroupingLevelList &levels, uint32_t firstLevel, uint32_t currentLevel, Group &b) {
+    mergeCollectors(firstLevel, currentLevel, b);
+    mergeChildren(levels, firstLevel, currentLevel, b);
+}
+
+void
+Group::mergeCollectors(uint32_t firstLevel, uint32_t currentLevel, const Group &b) {
     bool frozen = (currentLevel < firstLevel);    // is this level frozen ?
     _rank = std::max(_rank, b._rank);
 
     if (!frozen) { // should we merge collectors for this level ?
         _aggr.mergeCollectors(b._aggr);
     }
+}
+
+void
+Group::mergeChildren(const GroupingLevelList &levels, uint32_t firstLevel, uint32_t currentLevel, Group &b) {
     _aggr.merge(levels, firstLevel, currentLevel, b._aggr);
 }
 
+void
+Group::mergeChildren(const GroupingLevelList &levels, uint32_t firstLevel, uint32_t currentLevel,
+                     std::vector<ChildP> &children) {
+    _aggr.mergeChildren(levels, firstLevel, currentLevel, children.data(), children.data() + children.size());
+    for (ChildP &child : children) {
+        destruct(child); // merged into an existing child
+    }
+    children.clear();
+}
+
+uint32_t
+Group::lowerBoundChild(const ResultNode &id) const {
+    GroupList children(groups());
+    return std::lower_bound(children, children + getChildrenSize(), id,
+                            [](const ChildP &a, const ResultNode &b) { return (a->getId().cmpFast(b) < 0); })
+           - children;
+}
+
 void
 Group::prune(const Group & b, uint32_t lastLevel, uint32_t currentLevel) {
     if (currentLevel >= lastLevel) {
@@ -382,12 +410,54 @@ void
 Group::Value::merge(const std::vector<GroupingLevel> &levels,
                     uint32_t firstLevel, uint32_t currentLevel, const Value &b)
 {
-    GroupList z = new ChildP[getChildrenSize() + b.getChildrenSize()];
+    mergeChildren(levels, firstLevel, currentLevel, b._children, b._children + b.getChildrenSize());
+}
+
+void
+Group::Value::releaseChildren()
+{
+    // the visible children are owned by someone else by now
+    for (ChildP *it(_children), *mt(_children + getChildrenSize()); it != mt; ++it) {
+        reset(*it);
+    }
+    destruct(_children, getAllChildrenSize());
+    setChildrenSize(0);
+    _childInfo._allChildren = 0;
+}
+
+void
+Group::Value::pruneChildrenByRank(const std::vector<GroupingLevel> &levels, uint32_t currentLevel)
+{
+    if (currentLevel >= levels.size()) {
+        return;
+    }
+    // same selection as done by postMerge, but without touching the
+    // collectors, keeping the children ordered by id
+    uint64_t maxGroups = levels[currentLevel].getPrecision();
+    if (getChildrenSize() <= maxGroups) {
+        return;
+    }
+    for (ChildP *it(_children), *mt(_children + getChildrenSize()); it != mt; ++it) {
+        (*it)->executeOrderBy();
+    }
+    std::sort(_children, _children + getChildrenSize(), SortByGroupRank());
+    for (size_t i(maxGroups); i < getAllChildrenSize(); i++) {
+        destruct(_children[i]);
+        reset(_children[i]);
+    }
+    setChildrenSize(maxGroups);
+    _childInfo._allChildren = 0;
+    std::sort(_children, _children + getChildrenSize(), SortByGroupId());
+}
+
+void
+Group::Value::mergeChildren(const std::vector<GroupingLevel> &levels,
+                            uint32_t firstLevel, uint32_t currentLevel, ChildP *py, ChildP *ey)
+{
+    GroupList z = new ChildP[getChildrenSize() + (ey - py)];
     size_t kept(0);
     ChildP * px = _children;
     ChildP * ex = _children + getChildrenSize();
-    ChildP * py = b._children;
-    ChildP * ey = b._children + b.getChildrenSize();
     while (px != ex && py != ey) {
         int c = (*px)->cmpId(**py);
         if (c == 0) {
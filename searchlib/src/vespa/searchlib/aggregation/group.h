@@ -100,6 +100,10 @@ private:
         void mergePartial(const GroupingLevelList &levels, uint32_t firstLevel, uint32_t lastLevel,
                           uint32_t currentLevel, const Value & b);
         void merge(const GroupingLevelList & levels, uint32_t firstLevel, uint32_t currentLevel, const Value & rhs);
+        void mergeChildren(const GroupingLevelList & levels, uint32_t firstLevel, uint32_t currentLevel,
+                           ChildP * py, ChildP * ey);
+        void releaseChildren();
+        void pruneChildrenByRank(const GroupingLevelList & levels, uint32_t currentLevel);
         void prune(const Value & b, uint32_t lastLevel, uint32_t currentLevel);
         void postMerge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel);
         void partialCopy(const Value & rhs);
@@ -254,6 +258,43 @@ public:
     void collect(const Doc & docId, HitRank rank) { _aggr.collect(docId, rank); }
     void postAggregate() { _aggr.postAggregate(); }
     void merge(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel, Group &b);
+
+    /**
+     * The parts of merge; merge the rank and collectors of this group
+     * only, or merge the children of this group only.
+     **/
+    void mergeCollectors(uint32_t firstLevel, uint32_t currentLevel, const Group &b);
+    void mergeChildren(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel, Group &b);
+
+    /**
+     * Merge children ordered by id into the children of this group,
+     * taking ownership of them. Children with an id already present
+     * are merged into the existing child and then deleted.
+     **/
+    void mergeChildren(const std::vector<GroupingLevel> &levels, uint32_t firstLevel, uint32_t currentLevel,
+                       std::vector<ChildP> &children);
+
+    /**
+     * Find the index of the first child with an id not less than the
+     * given id.
+     **/
+    uint32_t lowerBoundChild(const ResultNode &id) const;
+
+    /**
+     * Forget all children of this group without deleting them. Used
+     * when the children have been handed over to another group with
+     * mergeChildren.
+     **/
+    void releaseChildren() { _aggr.releaseChildren(); }
+
+    /**
+     * Keep only the best ranked children of this group, as limited by
+     * the precision of the current level. Children are kept in id
+     * order.
+     **/
+    void pruneChildrenByRank(const std::vector<GroupingLevel> &levels, uint32_t currentLevel) {
+        _aggr.pruneChildrenByRank(levels, currentLevel);
+    }
     void executeOrderBy() { _aggr.executeOrderBy(); }
     void sortById() { _aggr.sortById(); }
 
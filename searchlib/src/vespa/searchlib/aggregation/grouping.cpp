@@ -154,6 +154,38 @@ Grouping::merge(Grouping & b)
     _root.merge(_levels, _firstLevel, 0, b._root);
 }
 
+void
+Grouping::mergePartition(Group & target, std::vector<Group *> & groups) const
+{
+    target.mergeChildren(_levels, _firstLevel, 0, groups);
+}
+
+void
+Grouping::mergePartition(Group & target, Group & source) const
+{
+    target.mergeChildren(_levels, _firstLevel, 0, source);
+}
+
+void
+Grouping::prunePartition(Group & target) const
+{
+    target.pruneChildrenByRank(_levels, 0);
+}
+
+void
+Grouping::mergePartitions(const std::vector<Grouping *> & others, std::vector<Group *> & partitions)
+{
+    // all top level groups have been moved into the partitions
+    _root.releaseChildren();
+    for (Grouping * b : others) {
+        _root.mergeCollectors(_firstLevel, 0, b->_root);
+        b->_root.releaseChildren();
+    }
+    for (Group * partition : partitions) {
+        _root.mergeChildren(_levels, _firstLevel, 0, *partition);
+    }
+}
+
 void
 Grouping::postMerge()
 {
@@ -79,6 +79,16 @@ public:
                        vespalib::ObjectOperation &operation) override;
 
     void merge(Grouping & b);
+    /**
+     * Partitioned merging, used to merge many groupings in parallel:
+     * the top level groups of all groupings are split into id ranges,
+     * each range is merged and pruned separately, and finally the
+     * ranges are combined into one of the groupings.
+     **/
+    void mergePartition(Group & target, std::vector<Group *> & groups) const;
+    void mergePartition(Group & target, Group & source) const;
+    void prunePartition(Group & target) const;
+    void mergePartitions(const std::vector<Grouping *> & others, std::vector<Group *> & partitions);
     void mergePartial(const Grouping & b);
     void postMerge();
     void preAggregate(bool isOrdered);
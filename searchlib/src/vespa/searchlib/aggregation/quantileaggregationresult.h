@@ -0,0 +1,36 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "aggregationresult.h"
+#include <vespa/searchlib/grouping/kllsketch.h>
+#include <vespa/searchlib/expression/floatresultnode.h>
+
+namespace search::aggregation {
+
+/**
+ * Estimates quantiles of a numeric expression. This class keeps a
+ * mergeable KLL sketch of the observed values, using bounded memory
+ * regardless of the number of values. Quantiles are extracted from the
+ * sketch on the QR server. The rank is the estimated median, which is
+ * only recalculated when the sketch has changed since last asked for.
+ */
+class QuantileAggregationResult : public AggregationResult {
+    KllSketch _sketch;
+    mutable expression::FloatResultNode _rank;
+    mutable bool _rankDirty;
+
+    const ResultNode & onGetRank() const override;
+    void onPrepare(const ResultNode &, bool) override { }
+public:
+    DECLARE_AGGREGATIONRESULT(QuantileAggregationResult);
+    QuantileAggregationResult();
+    QuantileAggregationResult(uint32_t k);
+    ~QuantileAggregationResult();
+
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    const KllSketch &getSketch() const { return _sketch; }
+    double getQuantile(double q) const { return _sketch.quantile(q); }
+};
+
+}
@@ -0,0 +1,35 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "aggregationresult.h"
+#include <vespa/searchlib/grouping/spacesavingsketch.h>
+#include <vespa/searchlib/expression/integerresultnode.h>
+
+namespace search::aggregation {
+
+/**
+ * Finds the most frequent values of an expression with bounded memory
+ * using a Space-Saving sketch. This is an alternative to grouping on a
+ * high cardinality expression, where the exact group state would keep
+ * one group per unique value. The sketch is merged across threads and
+ * nodes; the estimated counts are upper bounds, each with a maximum
+ * error. The rank is the estimated count of the most frequent value.
+ */
+class TopKAggregationResult : public AggregationResult {
+    SpaceSavingSketch _sketch;
+    mutable expression::Int64ResultNode _rank;
+
+    const ResultNode & onGetRank() const override;
+    void onPrepare(const ResultNode &, bool) override { }
+public:
+    DECLARE_AGGREGATIONRESULT(TopKAggregationResult);
+    TopKAggregationResult();
+    TopKAggregationResult(uint32_t capacity);
+    ~TopKAggregationResult();
+
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    const SpaceSavingSketch &getSketch() const { return _sketch; }
+};
+
+}
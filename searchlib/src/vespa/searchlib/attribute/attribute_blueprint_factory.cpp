@@ -2,6 +2,7 @@
 
 #include "attribute_blueprint_factory.h"
 #include "attribute_weighted_set_blueprint.h"
+#include "attributeiterators.h"
 #include "i_document_weight_attribute.h"
 #include "iterator_pack.h"
 #include "predicate_attribute.h"
@@ -74,6 +75,25 @@ namespace {
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Policy for picking between an attribute iterator comparing the
+ * value of one document per seek and one scanning the values a block
+ * of documents at a time.
+ *
+ * A strict iterator without postings compares every document in the
+ * range either way, so the hit estimate does not matter, and the scan
+ * is used when the docid limit spans at least one scan block. A
+ * non-strict iterator is only asked about documents hit by other
+ * iterators, so it keeps comparing per document.
+ **/
+struct AttributeScanPolicy {
+    static constexpr uint32_t min_docid_limit = AttributeScanIterator::BlockDocs;
+
+    static bool use_scan(bool strict, uint32_t docid_limit) {
+        return strict && (docid_limit >= min_docid_limit);
+    }
+};
+
 /**
  * Blueprint for creating regular, stack-based attribute iterators.
  **/
@@ -126,6 +146,12 @@ public:
 
     SearchIterator::UP createLeafSearch(const TermFieldMatchDataArray &tfmda, bool strict) const override {
         assert(tfmda.size() == 1);
+        if (AttributeScanPolicy::use_scan(strict, get_docid_limit())) {
+            SearchIterator::UP search = _search_context->createScanIterator(tfmda[0]);
+            if (search) {
+                return search;
+            }
+        }
         return _search_context->createIterator(tfmda[0], strict);
     }
 
@@ -2,6 +2,7 @@
 
 #include "attributeiterators.hpp"
 #include "postinglistattribute.h"
+#include <vespa/vespalib/util/optimized.h>
 
 namespace search {
 
@@ -67,6 +68,50 @@ FilterAttributeIterator::doUnpack(uint32_t docId)
     _matchData->resetOnlyDocId(docId);
 }
 
+AttributeScanIterator::AttributeScanIterator(TermFieldMatchData *matchData, uint32_t docIdLimit)
+    : AttributeIteratorBase(matchData),
+      _bits(),
+      _blockStart(search::endDocId),
+      _docIdLimit(docIdLimit)
+{
+    _matchPosition->setElementWeight(1);
+}
+
+void
+AttributeScanIterator::initRange(uint32_t begin, uint32_t end)
+{
+    AttributeIteratorBase::initRange(begin, end);
+    _blockStart = search::endDocId;
+}
+
+void
+AttributeScanIterator::doUnpack(uint32_t docId)
+{
+    _matchData->resetOnlyDocId(docId);
+}
+
+void
+AttributeScanIterator::visitMembers(vespalib::ObjectVisitor &visitor) const
+{
+    AttributeIteratorBase::visitMembers(visitor);
+    visit(visitor, "docIdLimit", _docIdLimit);
+}
+
+uint32_t
+AttributeScanIterator::nextInBlock(uint32_t docId) const
+{
+    uint32_t offset = docId - _blockStart;
+    uint32_t wordIdx = offset >> 6;
+    uint64_t word = _bits[wordIdx] & (~uint64_t(0) << (offset & 63));
+    while (word == 0) {
+        if (++wordIdx == BlockWords) {
+            return _blockStart + BlockDocs;
+        }
+        word = _bits[wordIdx];
+    }
+    return _blockStart + (wordIdx << 6) + vespalib::Optimized::lsbIdx(word);
+}
+
 template <>
 void
 AttributePostingListIteratorT<btree::
@@ -148,6 +148,57 @@ public:
     { }
 };
 
+/**
+ * This class acts as a strict iterator over documents that are
+ * results for the subquery represented by the search context object
+ * associated with this iterator. Instead of comparing one document per
+ * seek, the search context compares the values of a block of documents
+ * at a time into a bit vector, and the iterator returns the set bits.
+ * Only used for single value attributes, the weight of a hit is 1.
+ */
+class AttributeScanIterator : public AttributeIteratorBase
+{
+public:
+    static constexpr uint32_t BlockDocs = 256;
+    static constexpr uint32_t BlockWords = BlockDocs / 64;
+
+    AttributeScanIterator(fef::TermFieldMatchData *matchData, uint32_t docIdLimit);
+    Trinary is_strict() const override { return Trinary::True; }
+protected:
+    void initRange(uint32_t begin, uint32_t end) override;
+    void doUnpack(uint32_t docId) override;
+    void visitMembers(vespalib::ObjectVisitor &visitor) const override;
+    /**
+     * Returns the first hit >= docId in the current block, or the
+     * start of the next block if there is none.
+     */
+    uint32_t nextInBlock(uint32_t docId) const;
+
+    uint64_t _bits[BlockWords];
+    uint32_t _blockStart;
+    uint32_t _docIdLimit;
+};
+
+/**
+ * @param SC the specialized search context type associated with this
+ * iterator, providing scan(docId, numDocs, bits)
+ */
+template <typename SC>
+class AttributeScanIteratorT : public AttributeScanIterator
+{
+private:
+    void doSeek(uint32_t docId) override;
+
+    const SC & _searchContext;
+
+public:
+    AttributeScanIteratorT(const SC &searchContext, fef::TermFieldMatchData *matchData, uint32_t docIdLimit)
+        : AttributeScanIterator(matchData, docIdLimit),
+          _searchContext(searchContext)
+    { }
+};
+
+
 /**
  * This class acts as an iterator over documents that are results for
  * the subquery represented by the search context object associated
@@ -380,6 +380,27 @@ FilterAttributeIteratorStrict<SC>::doSeek(uint32_t docId)
     setAtEnd();
 }
 
+template <typename SC>
+void
+AttributeScanIteratorT<SC>::doSeek(uint32_t docId)
+{
+    uint32_t scanEnd = std::min(getEndId(), _docIdLimit);
+    for (uint32_t blockStart = docId & ~(BlockDocs - 1); blockStart < scanEnd; blockStart += BlockDocs) {
+        if (blockStart != _blockStart) {
+            uint32_t numDocs = std::min(BlockDocs, scanEnd - blockStart);
+            std::fill(_bits, _bits + BlockWords, 0);
+            _searchContext.scan(blockStart, numDocs, _bits);
+            _blockStart = blockStart;
+        }
+        uint32_t nextId = nextInBlock(std::max(docId, blockStart));
+        if (nextId < blockStart + BlockDocs) {
+            setDocId(nextId);
+            return;
+        }
+    }
+    setAtEnd();
+}
+
 template <typename SC>
 void
 AttributeIteratorT<SC>::or_hits_into(BitVector & result, uint32_t begin_id) {
@@ -588,6 +588,15 @@ createIterator(fef::TermFieldMatchData *matchData, bool strict)
 }
 
 
+SearchIterator::UP
+AttributeVector::SearchContext::
+createScanIterator(fef::TermFieldMatchData *matchData)
+{
+    (void) matchData;
+    return SearchIterator::UP();
+}
+
+
 SearchIterator::UP
 AttributeVector::SearchContext::
 createFilterIterator(fef::TermFieldMatchData *matchData, bool strict)
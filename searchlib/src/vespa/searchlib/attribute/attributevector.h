@@ -535,6 +535,7 @@ public:
         // Implements attribute::ISearchContext
         virtual unsigned int approximateHits() const override;
         virtual queryeval::SearchIterator::UP createIterator(fef::TermFieldMatchData *matchData, bool strict) override;
+        virtual queryeval::SearchIterator::UP createScanIterator(fef::TermFieldMatchData *matchData) override;
         virtual void fetchPostings(bool strict) override;
         virtual bool valid() const override { return false; }
         virtual Int64Range getAsIntegerTerm() const override { return Int64Range(); }
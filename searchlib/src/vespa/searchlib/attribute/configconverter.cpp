@@ -65,6 +65,7 @@ ConfigConverter::convert(const AttributesConfig::Attribute & cfg)
     PredicateParams predicateParams;
     retval.setFastSearch(cfg.fastsearch);
     retval.setHuge(cfg.huge);
+    retval.setMMapLoad(cfg.mmapload);
     retval.setEnableBitVectors(cfg.enablebitvectors);
     retval.setEnableOnlyBitVector(cfg.enableonlybitvector);
     retval.setIsFilter(cfg.enableonlybitvector);
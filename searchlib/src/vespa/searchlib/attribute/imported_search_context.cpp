@@ -74,8 +74,29 @@ ImportedSearchContext::createIterator(fef::TermFieldMatchData* matchData, bool s
     }
 }
 
+SearchIterator::UP
+ImportedSearchContext::createScanIterator(fef::TermFieldMatchData* matchData) {
+    // Values are looked up through the referenced lids, there is no column to scan
+    (void) matchData;
+    return SearchIterator::UP();
+}
+
 namespace {
 
+/*
+ * Every target document is visited when merging postings, so scanning
+ * the target attribute is preferred when the target supports it.
+ */
+SearchIterator::UP
+createTargetIterator(SearchContext &target_search_context, fef::TermFieldMatchData &matchData)
+{
+    auto it = target_search_context.createScanIterator(&matchData);
+    if (!it) {
+        it = target_search_context.createIterator(&matchData, true);
+    }
+    return it;
+}
+
 struct WeightedRef {
     EntryRef revMapIdx;
     int32_t  weight;
@@ -130,7 +151,7 @@ TargetWeightedResult::getResult(ReverseMappingRefs reverseMappingRefs, const Rev
 {
     TargetWeightedResult targetResult;
     fef::TermFieldMatchData matchData;
-    auto it = target_search_context.createIterator(&matchData, true);
+    auto it = createTargetIterator(target_search_context, matchData);
     uint32_t docIdLimit = reverseMappingRefs.size();
     if (docIdLimit > committedDocIdLimit) {
         docIdLimit = committedDocIdLimit;
@@ -155,7 +176,7 @@ TargetResult::getResult(ReverseMappingRefs reverseMappingRefs, const ReverseMapp
                         PostingListMerger<int32_t> & merger)
 {
     fef::TermFieldMatchData matchData;
-    auto it = target_search_context.createIterator(&matchData, true);
+    auto it = createTargetIterator(target_search_context, matchData);
     uint32_t docIdLimit = reverseMappingRefs.size();
     if (docIdLimit > committedDocIdLimit) {
         docIdLimit = committedDocIdLimit;
@@ -54,6 +54,8 @@ public:
 
     std::unique_ptr<queryeval::SearchIterator>
     createIterator(fef::TermFieldMatchData* matchData, bool strict) override;
+    std::unique_ptr<queryeval::SearchIterator>
+    createScanIterator(fef::TermFieldMatchData* matchData) override;
     unsigned int approximateHits() const override;
     void fetchPostings(bool strict) override;
     bool valid() const override;
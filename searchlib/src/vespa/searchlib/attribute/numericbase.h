@@ -61,7 +61,8 @@ protected:
             return Int64Range(static_cast<int64_t>(_low), static_cast<int64_t>(_high));
         }
         bool isValid() const { return _valid; }
-        bool match(T v) const { return (_low <= v) && (v <= _high); }
+        // No short circuit, a branch free match lets scanMatches() vectorize the compares
+        bool match(T v) const { return (_low <= v) & (v <= _high); }
         int getRangeLimit() const { return _limit; }
         size_t getMaxPerGroup() const { return _max_per_group; }
 
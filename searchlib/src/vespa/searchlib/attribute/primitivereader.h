@@ -19,6 +19,7 @@ namespace search {
         virtual ~PrimitiveReader() { }
         T getNextData() { return _datReader.readHostOrder(); }
         size_t getDataCount() const { return getDataCountHelper(sizeof(T)); }
+        vespalib::alloc::Alloc mapData() const { return mapDataHelper(sizeof(T)); }
     private:
         FileReader<T> _datReader;
     };
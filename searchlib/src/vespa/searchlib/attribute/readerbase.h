@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchlib/util/fileutil.h>
+#include <vespa/vespalib/util/alloc.h>
 #include <cassert>
 
 namespace search {
@@ -75,6 +76,11 @@ protected:
         size_t dataSize(_datFileSize - _datHeaderLen);
         return dataSize / elemSize;
     }
+    /**
+     * Map the data part of the dat file copy on write. Returns an empty
+     * allocation if the data does not start at a page boundary in the file.
+     */
+    vespalib::alloc::Alloc mapDataHelper(size_t elemSize) const;
 };
 
 }
@@ -0,0 +1,66 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace search::attribute {
+
+/**
+ * Packs 64 bytes, each either 0 or 0xff, into one bit per byte.
+ **/
+inline uint64_t
+packMatchBytes(const uint8_t *bytes)
+{
+#ifdef __SSE2__
+    uint64_t bits = 0;
+    for (uint32_t i = 0; i < 4; ++i) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(bytes + i * 16));
+        bits |= static_cast<uint64_t>(static_cast<uint16_t>(_mm_movemask_epi8(v))) << (i * 16);
+    }
+    return bits;
+#else
+    uint64_t bits = 0;
+    for (uint32_t i = 0; i < 64; ++i) {
+        bits |= static_cast<uint64_t>(bytes[i] & 1) << i;
+    }
+    return bits;
+#endif
+}
+
+/**
+ * Evaluates pred for numValues consecutive values, setting bit i in
+ * the bit words when pred(values[i]) is true. Bits after numValues in
+ * the last word written are cleared.
+ *
+ * Full words are evaluated in two passes: the compares write one byte
+ * per value in a loop without branches that the compiler can turn into
+ * SIMD compares, and the bytes are then packed into a bit word.
+ **/
+template <typename T, typename Pred>
+void
+scanMatches(const T *values, uint32_t numValues, uint64_t *bits, Pred pred)
+{
+    uint8_t bytes[64];
+    uint32_t i = 0;
+    for (; i + 64 <= numValues; i += 64) {
+        const T *v = values + i;
+        for (uint32_t j = 0; j < 64; ++j) {
+            bytes[j] = -static_cast<uint8_t>(pred(v[j]));
+        }
+        *bits++ = packMatchBytes(bytes);
+    }
+    if (i < numValues) {
+        uint64_t tail = 0;
+        for (uint32_t j = 0; i + j < numValues; ++j) {
+            tail |= static_cast<uint64_t>(pred(values[i + j])) << j;
+        }
+        *bits = tail;
+    }
+}
+
+}
@@ -4,6 +4,7 @@
 
 #include "integerbase.h"
 #include "floatbase.h"
+#include "scan_matches.h"
 #include <vespa/searchlib/common/rcuvector.h>
 #include <limits>
 
@@ -39,6 +40,7 @@ private:
     class SingleSearchContext : public M, public AttributeVector::SearchContext
     {
     private:
+        uint32_t  _docIdLimit; // Read before _data, so _data covers all docs below it
         const T * _data;
 
         bool onCmp(DocId docId, int32_t & weight) const override {
@@ -64,10 +66,21 @@ private:
             return this->match(v);
         }
 
+        /**
+         * Sets bit i in bits if document docId + i matches, for numDocs
+         * documents starting at docId.
+         */
+        void scan(DocId docId, uint32_t numDocs, uint64_t *bits) const {
+            attribute::scanMatches(_data + docId, numDocs, bits, [this](T v) { return this->match(v); });
+        }
+
         Int64Range getAsIntegerTerm() const override;
 
         std::unique_ptr<queryeval::SearchIterator>
         createFilterIterator(fef::TermFieldMatchData * matchData, bool strict) override;
+
+        std::unique_ptr<queryeval::SearchIterator>
+        createScanIterator(fef::TermFieldMatchData * matchData) override;
     };
 
 
@@ -140,10 +140,19 @@ SingleValueNumericAttribute<B>::onLoad()
     
     const size_t sz(attrReader.getDataCount());
     getGenerationHolder().clearHoldLists();
-    _data.reset();
-    _data.unsafe_reserve(sz);
-    for (uint32_t i = 0; i < sz; ++i) {
-        _data.push_back(attrReader.getNextData());
+    vespalib::alloc::Alloc mapped;
+    if (this->getConfig().mmapLoad()) {
+        mapped = attrReader.mapData();
+    }
+    if (mapped.size() > 0) {
+        // Pages are read on first access and copied to memory on first write.
+        _data.unsafe_adopt(std::move(mapped), sz);
+    } else {
+        _data.reset();
+        _data.unsafe_reserve(sz);
+        for (uint32_t i = 0; i < sz; ++i) {
+            _data.push_back(attrReader.getNextData());
+        }
     }
 
     B::setNumDocs(sz);
@@ -210,6 +219,7 @@ SingleValueNumericAttribute<B>::SingleSearchContext<M>::SingleSearchContext(Quer
                                                                             const NumericAttribute & toBeSearched) :
     M(*qTerm, true),
     AttributeVector::SearchContext(toBeSearched),
+    _docIdLimit(toBeSearched.getCommittedDocIdLimit()),
     _data(&static_cast<const SingleValueNumericAttribute<B> &>(toBeSearched)._data[0])
 { }
 
@@ -241,5 +251,18 @@ createFilterIterator(fef::TermFieldMatchData * matchData, bool strict)
              ? new AttributeIteratorStrict<SingleSearchContext<M> >(*this, matchData)
              : new AttributeIteratorT<SingleSearchContext<M> >(*this, matchData));
 }
+
+template <typename B>
+template <typename M>
+std::unique_ptr<queryeval::SearchIterator>
+SingleValueNumericAttribute<B>::SingleSearchContext<M>::
+createScanIterator(fef::TermFieldMatchData * matchData)
+{
+    if (!valid()) {
+        return queryeval::SearchIterator::UP(new queryeval::EmptySearch());
+    }
+    return queryeval::SearchIterator::UP
+            (new AttributeScanIteratorT<SingleSearchContext<M> >(*this, matchData, _docIdLimit));
+}
 }
 
@@ -74,6 +74,7 @@ private:
 #define K_VALUE_ZCPOSTING_L4SKIPSIZE 6
 #define K_VALUE_ZCPOSTING_FEATURESSIZE 25
 #define K_VALUE_ZCPOSTING_DELTA_DOCID 22
+#define K_VALUE_ZCPOSTING_MAXWEIGHT 0
 
 /**
  * Lookup tables used for compression / decompression.
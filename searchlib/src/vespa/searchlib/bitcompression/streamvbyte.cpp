@@ -0,0 +1,131 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "streamvbyte.h"
+#include <cstring>
+
+namespace search::bitcompression {
+
+#if defined(__x86_64__)
+// Implemented in streamvbyte_ssse3.cpp
+void streamVByteDecodeSsse3(const uint8_t *src, uint32_t count, uint32_t *dst);
+void streamVByteDecodeDeltasSsse3(const uint8_t *src, uint32_t count, uint32_t base, uint32_t *dst);
+#endif
+
+namespace {
+
+const uint32_t valueMask[4] = { 0xffu, 0xffffu, 0xffffffu, 0xffffffffu };
+
+uint32_t
+byteLength(uint32_t value)
+{
+    return (value < (1u << 8)) ? 1 : (value < (1u << 16)) ? 2 : (value < (1u << 24)) ? 3 : 4;
+}
+
+// Loads a value with a 4 byte read, relying on DECODE_SLACK.
+template <bool delta>
+void
+decodeGenericImpl(const uint8_t *src, uint32_t count, uint32_t base, uint32_t *dst)
+{
+    const uint8_t *control = src;
+    const uint8_t *data = src + StreamVByte::controlSize(count);
+    uint32_t prev = base;
+    for (uint32_t i = 0; i < count; i += 4) {
+        uint32_t c = *control++;
+        for (uint32_t j = 0; j < 4; ++j, c >>= 2) {
+            uint32_t value;
+            memcpy(&value, data, sizeof(value));
+            value &= valueMask[c & 3];
+            data += (c & 3) + 1;
+            if (delta) {
+                prev += value + 1;
+                value = prev;
+            }
+            dst[i + j] = value;
+        }
+    }
+}
+
+StreamVByte::DecodeFunc
+selectDecode()
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3")) {
+        return streamVByteDecodeSsse3;
+    }
+#endif
+    return StreamVByte::decodeGeneric;
+}
+
+StreamVByte::DecodeDeltasFunc
+selectDecodeDeltas()
+{
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("ssse3")) {
+        return streamVByteDecodeDeltasSsse3;
+    }
+#endif
+    return StreamVByte::decodeDeltasGeneric;
+}
+
+}
+
+StreamVByte::DecodeFunc StreamVByte::_decode = selectDecode();
+StreamVByte::DecodeDeltasFunc StreamVByte::_decodeDeltas = selectDecodeDeltas();
+
+size_t
+StreamVByte::encode(const uint32_t *values, uint32_t count, uint8_t *dst)
+{
+    uint8_t *control = dst;
+    uint8_t *data = dst + controlSize(count);
+    memset(control, 0, controlSize(count));
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t value = values[i];
+        uint32_t len = byteLength(value);
+        control[i / 4] |= (len - 1) << ((i % 4) * 2);
+        for (uint32_t j = 0; j < len; ++j, value >>= 8) {
+            *data++ = value & 0xff;
+        }
+    }
+    return data - dst;
+}
+
+size_t
+StreamVByte::encodeDeltas(const uint32_t *values, uint32_t count, uint32_t base, uint8_t *dst)
+{
+    uint8_t *control = dst;
+    uint8_t *data = dst + controlSize(count);
+    memset(control, 0, controlSize(count));
+    uint32_t prev = base;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint32_t value = values[i] - prev - 1;
+        prev = values[i];
+        uint32_t len = byteLength(value);
+        control[i / 4] |= (len - 1) << ((i % 4) * 2);
+        for (uint32_t j = 0; j < len; ++j, value >>= 8) {
+            *data++ = value & 0xff;
+        }
+    }
+    return data - dst;
+}
+
+void
+StreamVByte::decodeGeneric(const uint8_t *src, uint32_t count, uint32_t *dst)
+{
+    decodeGenericImpl<false>(src, count, 0, dst);
+}
+
+void
+StreamVByte::decodeDeltasGeneric(const uint8_t *src, uint32_t count, uint32_t base, uint32_t *dst)
+{
+    decodeGenericImpl<true>(src, count, base, dst);
+}
+
+bool
+StreamVByte::hasVectorDecoder()
+{
+    return _decode != decodeGeneric;
+}
+
+}
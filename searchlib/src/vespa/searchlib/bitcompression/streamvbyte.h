@@ -0,0 +1,64 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace search::bitcompression {
+
+/**
+ * Byte oriented integer coding where the lengths of four values are
+ * packed into one control byte ahead of the data bytes (StreamVByte).
+ * Decoding needs no branches per value and maps to a single shuffle per
+ * four values on SSSE3 capable cpus, which is selected at runtime.
+ *
+ * Layout of n encoded values: (n + 3) / 4 control bytes with 2 bits per
+ * value (byte length - 1, least significant bits first), followed by the
+ * little endian data bytes of each value.
+ *
+ * Decoding may read up to DECODE_SLACK bytes past the end of the encoded
+ * data and may write up to 3 values past count in the output array.
+ */
+class StreamVByte
+{
+public:
+    static constexpr size_t DECODE_SLACK = 16;
+
+    static size_t controlSize(uint32_t count) { return (count + 3) / 4; }
+    static size_t maxEncodedSize(uint32_t count) { return controlSize(count) + 4 * size_t(count); }
+
+    static size_t encode(const uint32_t *values, uint32_t count, uint8_t *dst);
+
+    /**
+     * Encodes strictly increasing values as gaps (value - previous - 1),
+     * starting with base as the previous value.
+     */
+    static size_t encodeDeltas(const uint32_t *values, uint32_t count, uint32_t base, uint8_t *dst);
+
+    static void decode(const uint8_t *src, uint32_t count, uint32_t *dst) {
+        _decode(src, count, dst);
+    }
+
+    /**
+     * Decodes values written by encodeDeltas.
+     */
+    static void decodeDeltas(const uint8_t *src, uint32_t count, uint32_t base, uint32_t *dst) {
+        _decodeDeltas(src, count, base, dst);
+    }
+
+    // Portable implementations, always available.
+    static void decodeGeneric(const uint8_t *src, uint32_t count, uint32_t *dst);
+    static void decodeDeltasGeneric(const uint8_t *src, uint32_t count, uint32_t base, uint32_t *dst);
+
+    static bool hasVectorDecoder();
+
+    using DecodeFunc = void (*)(const uint8_t *, uint32_t, uint32_t *);
+    using DecodeDeltasFunc = void (*)(const uint8_t *, uint32_t, uint32_t, uint32_t *);
+
+private:
+    static DecodeFunc _decode;
+    static DecodeDeltasFunc _decodeDeltas;
+};
+
+}
@@ -0,0 +1,75 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+// Compiled with -mssse3, only called when the cpu supports it.
+
+#include "streamvbyte.h"
+#include <tmmintrin.h>
+
+namespace search::bitcompression {
+
+namespace {
+
+/**
+ * Per control byte: shuffle mask gathering the data bytes of four values
+ * into four 32 bit lanes, and the total number of data bytes.
+ */
+struct ShuffleTable {
+    uint8_t masks[256][16];
+    uint8_t lengths[256];
+
+    ShuffleTable() {
+        for (uint32_t c = 0; c < 256; ++c) {
+            uint32_t offset = 0;
+            for (uint32_t lane = 0; lane < 4; ++lane) {
+                uint32_t len = ((c >> (lane * 2)) & 3) + 1;
+                for (uint32_t b = 0; b < 4; ++b) {
+                    masks[c][lane * 4 + b] = (b < len) ? (offset + b) : 0x80;
+                }
+                offset += len;
+            }
+            lengths[c] = offset;
+        }
+    }
+};
+
+const ShuffleTable shuffleTable;
+
+inline __m128i
+decodeQuad(const uint8_t *&data, uint8_t control)
+{
+    __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data));
+    __m128i mask = _mm_loadu_si128(reinterpret_cast<const __m128i *>(shuffleTable.masks[control]));
+    data += shuffleTable.lengths[control];
+    return _mm_shuffle_epi8(bytes, mask);
+}
+
+}
+
+void
+streamVByteDecodeSsse3(const uint8_t *src, uint32_t count, uint32_t *dst)
+{
+    const uint8_t *control = src;
+    const uint8_t *data = src + StreamVByte::controlSize(count);
+    for (uint32_t i = 0; i < count; i += 4) {
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), decodeQuad(data, *control++));
+    }
+}
+
+void
+streamVByteDecodeDeltasSsse3(const uint8_t *src, uint32_t count, uint32_t base, uint32_t *dst)
+{
+    const uint8_t *control = src;
+    const uint8_t *data = src + StreamVByte::controlSize(count);
+    const __m128i one = _mm_set1_epi32(1);
+    __m128i prev = _mm_set1_epi32(base);
+    for (uint32_t i = 0; i < count; i += 4) {
+        __m128i v = _mm_add_epi32(decodeQuad(data, *control++), one);
+        // Prefix sum of the four gaps
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 4));
+        v = _mm_add_epi32(v, _mm_slli_si128(v, 8));
+        v = _mm_add_epi32(v, prev);
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i), v);
+        prev = _mm_shuffle_epi32(v, 0xff);
+    }
+}
+
+}
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "btreenode.h"
+#include "btreenodesearch.h"
 #include <algorithm>
 
 namespace search {
@@ -44,9 +45,7 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 lower_bound(uint32_t sidx, const KeyT & key, CompareT comp) const
 {
-    const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
-        (_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    return BTreeNodeSearch<KeyT, CompareT>::lower_bound(_keys, sidx, validSlots(), key, comp);
 }
 
 template <typename KeyT, uint32_t NumSlots>
@@ -54,10 +53,7 @@ template <typename CompareT>
 uint32_t
 BTreeNodeT<KeyT, NumSlots>::lower_bound(const KeyT & key, CompareT comp) const
 {
-    
-    const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
-        (_keys, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    return BTreeNodeSearch<KeyT, CompareT>::lower_bound(_keys, 0, validSlots(), key, comp);
 }
 
 
@@ -67,9 +63,7 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 upper_bound(uint32_t sidx, const KeyT & key, CompareT comp) const
 {
-    const KeyT * itr = std::upper_bound<const KeyT *, KeyT, CompareT>
-        (_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    return BTreeNodeSearch<KeyT, CompareT>::upper_bound(_keys, sidx, validSlots(), key, comp);
 }
 
 
@@ -0,0 +1,88 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace search::btree {
+
+/**
+ * Searches the sorted keys [sidx, eidx) of a btree node using binary
+ * search.
+ */
+template <typename KeyT, typename CompareT>
+struct BTreeNodeSearch
+{
+    static uint32_t
+    lower_bound(const KeyT *keys, uint32_t sidx, uint32_t eidx,
+                const KeyT &key, CompareT comp)
+    {
+        return std::lower_bound<const KeyT *, KeyT, CompareT>
+            (keys + sidx, keys + eidx, key, comp) - keys;
+    }
+
+    static uint32_t
+    upper_bound(const KeyT *keys, uint32_t sidx, uint32_t eidx,
+                const KeyT &key, CompareT comp)
+    {
+        return std::upper_bound<const KeyT *, KeyT, CompareT>
+            (keys + sidx, keys + eidx, key, comp) - keys;
+    }
+};
+
+/**
+ * Searches the sorted uint32_t keys of a btree node linearly, comparing
+ * 4 keys at a time. Node key arrays are small enough for this to beat
+ * binary search, which has a hard to predict branch per step.
+ */
+template <>
+struct BTreeNodeSearch<uint32_t, std::less<uint32_t>>
+{
+    template <bool upper>
+    static uint32_t
+    search(const uint32_t *keys, uint32_t sidx, uint32_t eidx, uint32_t key)
+    {
+        uint32_t idx = sidx;
+#ifdef __SSE2__
+        // SSE2 only has signed compares, flip the sign bits to compare
+        // unsigned values.
+        const __m128i bias = _mm_set1_epi32(0x80000000);
+        const __m128i biasedKey = _mm_xor_si128(_mm_set1_epi32(key), bias);
+        for (; idx + 4 <= eidx; idx += 4) {
+            __m128i biased = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + idx)), bias);
+            // Bits are set for the keys before the result
+            uint32_t before = upper
+                              ? (~_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(biased, biasedKey))) & 0xf)
+                              : _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpgt_epi32(biasedKey, biased)));
+            if (before != 0xf) {
+                return idx + __builtin_popcount(before);
+            }
+        }
+#endif
+        while (idx < eidx && (upper ? keys[idx] <= key : keys[idx] < key)) {
+            ++idx;
+        }
+        return idx;
+    }
+
+    static uint32_t
+    lower_bound(const uint32_t *keys, uint32_t sidx, uint32_t eidx,
+                const uint32_t &key, std::less<uint32_t>)
+    {
+        return search<false>(keys, sidx, eidx, key);
+    }
+
+    static uint32_t
+    upper_bound(const uint32_t *keys, uint32_t sidx, uint32_t eidx,
+                const uint32_t &key, std::less<uint32_t>)
+    {
+        return search<true>(keys, sidx, eidx, key);
+    }
+};
+
+}
@@ -3,6 +3,8 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 namespace search::btree {
 
@@ -16,4 +18,34 @@ struct BTreeTraits {
 
 typedef BTreeTraits<16, 16, 10, true> BTreeDefaultTraits;
 
+/**
+ * Number of slots in a btree node that fits in numCacheLines cache
+ * lines. The node header is 4 bytes (level, frozen flag and number of
+ * valid slots). Internal nodes have 4 byte child node references as data
+ * and 4 extra bytes for the number of valid leaves. Empty data and
+ * aggregated types take no space.
+ */
+template <typename KeyT, typename DataT, typename AggrT>
+constexpr size_t
+btreeCacheLineSlots(size_t numCacheLines, size_t extraSize)
+{
+    constexpr size_t cacheLineSize = 64;
+    constexpr size_t headerSize = (alignof(KeyT) > 4) ? alignof(KeyT) : 4;
+    constexpr size_t dataSize = std::is_empty<DataT>::value ? 0 : sizeof(DataT);
+    constexpr size_t aggrSize = std::is_empty<AggrT>::value ? 0 : sizeof(AggrT);
+    return (numCacheLines * cacheLineSize - headerSize - aggrSize - extraSize) / (sizeof(KeyT) + dataSize);
+}
+
+/**
+ * Traits with slot counts chosen to make leaf and internal nodes fill
+ * a whole number of cache lines, e.g. 15 slots in 128 bytes for uint32_t
+ * keys and data without aggregation instead of 16 slots in 132 bytes.
+ */
+template <typename KeyT, typename DataT, typename AggrT,
+          size_t LeafCacheLines = 2, size_t InternalCacheLines = 2>
+using BTreeCacheLineTraits =
+    BTreeTraits<btreeCacheLineSlots<KeyT, DataT, AggrT>(LeafCacheLines, 0),
+                btreeCacheLineSlots<KeyT, uint32_t, AggrT>(InternalCacheLines, 4),
+                10, true>;
+
 }
@@ -0,0 +1,243 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "adaptivesequencedtaskexecutor.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace search {
+
+namespace {
+
+constexpr uint32_t strandsPerThread = 8;
+// Max tasks run from one strand before it goes to the back of the ready queue.
+constexpr uint32_t maxBatch = 64;
+constexpr uint32_t minSpin = 16;
+constexpr uint32_t maxSpin = 4096;
+
+}
+
+AdaptiveSequencedTaskExecutor::Strand::Strand()
+    : _head(new Node()),
+      _tail(_head.load(std::memory_order_relaxed)),
+      _pending(0)
+{
+}
+
+AdaptiveSequencedTaskExecutor::Strand::~Strand()
+{
+    while (_tail != nullptr) {
+        Node *next = _tail->_next.load(std::memory_order_relaxed);
+        delete _tail;
+        _tail = next;
+    }
+}
+
+void
+AdaptiveSequencedTaskExecutor::Strand::push(vespalib::Executor::Task::UP task)
+{
+    Node *node = new Node(std::move(task));
+    Node *prev = _head.exchange(node, std::memory_order_acq_rel);
+    prev->_next.store(node, std::memory_order_release);
+}
+
+vespalib::Executor::Task::UP
+AdaptiveSequencedTaskExecutor::Strand::pop()
+{
+    // Only called when a task is known to be queued, but its producer
+    // might not have linked it in yet.
+    Node *next = _tail->_next.load(std::memory_order_acquire);
+    while (next == nullptr) {
+        std::this_thread::yield();
+        next = _tail->_next.load(std::memory_order_acquire);
+    }
+    vespalib::Executor::Task::UP task = std::move(next->_task);
+    delete _tail;
+    _tail = next;
+    return task;
+}
+
+AdaptiveSequencedTaskExecutor::AdaptiveSequencedTaskExecutor(uint32_t threads, uint32_t strands, uint32_t taskLimit)
+    : _strands(),
+      _ids(),
+      _workers(),
+      _lock(),
+      _workCond(),
+      _doneCond(),
+      _ready(),
+      _readyCount(0),
+      _sleepers(0),
+      _spinLimit(minSpin),
+      _outstanding(0),
+      _taskLimit(taskLimit),
+      _waiters(0),
+      _closed(false)
+{
+    assert(threads > 0);
+    uint32_t numStrands = (strands != 0) ? strands : threads * strandsPerThread;
+    for (uint32_t id = 0; id < numStrands; ++id) {
+        _strands.push_back(std::make_unique<Strand>());
+    }
+    for (uint32_t id = 0; id < threads; ++id) {
+        _workers.emplace_back([this]() { workerMain(); });
+    }
+}
+
+AdaptiveSequencedTaskExecutor::~AdaptiveSequencedTaskExecutor()
+{
+    sync();
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _closed = true;
+    }
+    _workCond.notify_all();
+    for (auto &worker : _workers) {
+        worker.join();
+    }
+}
+
+void
+AdaptiveSequencedTaskExecutor::setTaskLimit(uint32_t taskLimit)
+{
+    _taskLimit = taskLimit;
+    std::lock_guard<std::mutex> guard(_lock);
+    _doneCond.notify_all();
+}
+
+uint32_t
+AdaptiveSequencedTaskExecutor::getExecutorId(uint64_t componentId)
+{
+    auto itr = _ids.find(componentId);
+    if (itr == _ids.end()) {
+        auto insarg = std::make_pair(componentId, _ids.size() % _strands.size());
+        auto insres = _ids.insert(insarg);
+        assert(insres.second);
+        itr = insres.first;
+    }
+    return itr->second;
+}
+
+void
+AdaptiveSequencedTaskExecutor::executeTask(uint32_t executorId, vespalib::Executor::Task::UP task)
+{
+    assert(executorId < _strands.size());
+    if (_outstanding.load() >= _taskLimit.load(std::memory_order_relaxed)) {
+        _waiters++;
+        std::unique_lock<std::mutex> guard(_lock);
+        _doneCond.wait(guard, [this]() { return _outstanding.load() < _taskLimit.load(std::memory_order_relaxed); });
+        _waiters--;
+    }
+    _outstanding++;
+    Strand &strand = *_strands[executorId];
+    strand.push(std::move(task));
+    if (strand._pending.fetch_add(1, std::memory_order_acq_rel) == 0) {
+        schedule(strand);
+    }
+}
+
+void
+AdaptiveSequencedTaskExecutor::sync()
+{
+    _waiters++;
+    std::unique_lock<std::mutex> guard(_lock);
+    _doneCond.wait(guard, [this]() { return _outstanding.load() == 0; });
+    _waiters--;
+}
+
+void
+AdaptiveSequencedTaskExecutor::schedule(Strand &strand)
+{
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        _ready.push_back(&strand);
+        _readyCount++;
+    }
+    if (_sleepers.load() > 0) {
+        _workCond.notify_one();
+    }
+}
+
+AdaptiveSequencedTaskExecutor::Strand *
+AdaptiveSequencedTaskExecutor::trySpinForStrand()
+{
+    uint32_t limit = _spinLimit.load(std::memory_order_relaxed);
+    for (uint32_t i = 0; i < limit; ++i) {
+        if (_readyCount.load(std::memory_order_relaxed) > 0) {
+            std::lock_guard<std::mutex> guard(_lock);
+            if (!_ready.empty()) {
+                Strand *strand = _ready.front();
+                _ready.pop_front();
+                _readyCount--;
+                // Spinning paid off, allow more of it.
+                _spinLimit.store(std::min(maxSpin, limit * 2), std::memory_order_relaxed);
+                return strand;
+            }
+        }
+        std::this_thread::yield();
+    }
+    _spinLimit.store(std::max(minSpin, limit / 2), std::memory_order_relaxed);
+    return nullptr;
+}
+
+AdaptiveSequencedTaskExecutor::Strand *
+AdaptiveSequencedTaskExecutor::obtainStrand()
+{
+    Strand *strand = trySpinForStrand();
+    if (strand != nullptr) {
+        return strand;
+    }
+    std::unique_lock<std::mutex> guard(_lock);
+    while (_ready.empty()) {
+        if (_closed) {
+            return nullptr;
+        }
+        _sleepers++;
+        _workCond.wait(guard);
+        _sleepers--;
+    }
+    strand = _ready.front();
+    _ready.pop_front();
+    _readyCount--;
+    return strand;
+}
+
+void
+AdaptiveSequencedTaskExecutor::run(Strand &strand)
+{
+    uint32_t ran = 0;
+    do {
+        vespalib::Executor::Task::UP task = strand.pop();
+        task->run();
+        task.reset();
+        ++ran;
+    } while ((ran < maxBatch) && (ran < strand._pending.load(std::memory_order_acquire)));
+    uint32_t left = strand._pending.fetch_sub(ran, std::memory_order_acq_rel) - ran;
+    taskDone(ran);
+    if (left > 0) {
+        schedule(strand);
+    }
+}
+
+void
+AdaptiveSequencedTaskExecutor::taskDone(uint32_t count)
+{
+    _outstanding -= count;
+    if (_waiters.load() > 0) {
+        std::lock_guard<std::mutex> guard(_lock);
+        _doneCond.notify_all();
+    }
+}
+
+void
+AdaptiveSequencedTaskExecutor::workerMain()
+{
+    for (;;) {
+        Strand *strand = obtainStrand();
+        if (strand == nullptr) {
+            return;
+        }
+        run(*strand);
+    }
+}
+
+} // namespace search
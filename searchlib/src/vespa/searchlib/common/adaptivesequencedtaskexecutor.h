@@ -0,0 +1,100 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "isequencedtaskexecutor.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace search {
+
+/**
+ * Class to run multiple tasks in parallel, but tasks with same id has
+ * to be run in sequence.
+ *
+ * Unlike SequencedTaskExecutor, an executor id does not map to a
+ * dedicated thread. It maps to a strand, which is a lock-free queue of
+ * tasks that is run by whichever worker is available once it has work.
+ * At most one worker runs a given strand at any time, which preserves
+ * the ordering. Having more strands than threads means that a single
+ * busy component id does not block the other ids hashed to its thread.
+ * Idle workers spin for a while before blocking, the spin budget adapts
+ * to how often spinning actually found work.
+ */
+class AdaptiveSequencedTaskExecutor : public ISequencedTaskExecutor
+{
+private:
+    struct Node {
+        Node() : _next(nullptr), _task() { }
+        explicit Node(vespalib::Executor::Task::UP task) : _next(nullptr), _task(std::move(task)) { }
+        std::atomic<Node *>           _next;
+        vespalib::Executor::Task::UP  _task;
+    };
+
+    /**
+     * Multi producer, single consumer queue of tasks with the number of
+     * tasks not yet run. The strand is scheduled on a worker when the
+     * count goes from 0 to 1, and released when the worker brings it
+     * back to 0.
+     */
+    struct alignas(64) Strand {
+        Strand();
+        ~Strand();
+        void push(vespalib::Executor::Task::UP task);
+        vespalib::Executor::Task::UP pop();
+        std::atomic<Node *>   _head;     // producer end
+        Node                 *_tail;     // consumer end, always a consumed node
+        std::atomic<uint32_t> _pending;
+    };
+
+    std::vector<std::unique_ptr<Strand>> _strands;
+    vespalib::hash_map<size_t, size_t>   _ids;
+    std::vector<std::thread>             _workers;
+    std::mutex                           _lock;
+    std::condition_variable              _workCond;
+    std::condition_variable              _doneCond;
+    std::deque<Strand *>                 _ready;
+    std::atomic<size_t>                  _readyCount;
+    std::atomic<uint32_t>                _sleepers;
+    std::atomic<uint32_t>                _spinLimit;
+    std::atomic<size_t>                  _outstanding;
+    std::atomic<uint32_t>                _taskLimit;
+    std::atomic<uint32_t>                _waiters;
+    bool                                 _closed;
+
+    void schedule(Strand &strand);
+    Strand *obtainStrand();
+    Strand *trySpinForStrand();
+    void run(Strand &strand);
+    void taskDone(uint32_t count);
+    void workerMain();
+public:
+    using ISequencedTaskExecutor::getExecutorId;
+
+    /**
+     * @param threads   number of worker threads
+     * @param strands   number of independent task sequences, 0 selects 8 per thread
+     * @param taskLimit max number of tasks not yet run, executeTask blocks above it
+     */
+    AdaptiveSequencedTaskExecutor(uint32_t threads, uint32_t strands = 0, uint32_t taskLimit = 1000);
+
+    ~AdaptiveSequencedTaskExecutor();
+
+    void setTaskLimit(uint32_t taskLimit);
+
+    uint32_t getExecutorId(uint64_t componentId) override;
+
+    void executeTask(uint32_t executorId, vespalib::Executor::Task::UP task) override;
+
+    void sync() override;
+
+    uint32_t getNumExecutors() const override { return _workers.size(); }
+
+    uint32_t getNumStrands() const { return _strands.size(); }
+};
+
+} // namespace search
@@ -28,6 +28,13 @@ void verifyContains(const search::BitVector & a, const search::BitVector & b)
     }
 }
 
+const IAccelrated &
+accelrator()
+{
+    static IAccelrated::UP accel = IAccelrated::getAccelrator();
+    return *accel;
+}
+
 }
 
 /////////////////////////////////
@@ -135,11 +142,7 @@ BitVector::count() const
 BitVector::Index
 BitVector::internalCount(const Word *tarr, size_t sz)
 {
-    Index count(0);
-    for (size_t i(0); i < sz; i++) {
-        count += Optimized::popCount(tarr[i]);
-    }
-    return count;
+    return accelrator().populationCount(tarr, sz);
 }
 
 BitVector::Index
@@ -37,6 +37,8 @@ public:
     virtual void executeTask(uint32_t executorId, vespalib::Executor::Task::UP task) override;
 
     virtual void sync() override;
+
+    virtual uint32_t getNumExecutors() const override { return 1; }
 };
 
 } // namespace search
@@ -92,6 +92,8 @@
                                                           SEARCHLIB_CID(88)
 #define CID_search_aggregation_StandardDeviationAggregationResult \
                                                           SEARCHLIB_CID(89)
+#define CID_search_aggregation_QuantileAggregationResult  SEARCHLIB_CID(98)
+#define CID_search_aggregation_TopKAggregationResult      SEARCHLIB_CID(99)
 
 #define CID_search_aggregation_Group                      SEARCHLIB_CID(90)
 #define CID_search_aggregation_Grouping                   SEARCHLIB_CID(91)
@@ -56,6 +56,12 @@ public:
      */
     virtual void sync() = 0;
 
+    /**
+     * Get the number of tasks with different ids that can run in
+     * parallel, i.e. the number of threads.
+     */
+    virtual uint32_t getNumExecutors() const = 0;
+
     /**
      * Wrap lambda function into a task and schedule it to be run.
      * Caller must ensure that pointers and references are valid and
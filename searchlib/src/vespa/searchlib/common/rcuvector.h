@@ -121,6 +121,11 @@ public:
     const T & operator[](size_t i) const { return _data[i]; }
 
     void reset();
+    /**
+     * Take over an already filled buffer, e.g. a file mapping, as the
+     * underlying data with n elements. Assumes no readers at this moment.
+     **/
+    void unsafe_adopt(Alloc && buf, size_t n);
     void shrink(size_t newSize) __attribute__((noinline));
 };
 
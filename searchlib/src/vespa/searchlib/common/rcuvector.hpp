@@ -46,6 +46,13 @@ RcuVectorBase<T>::reset() {
     _data.reserve(16);
 }
 
+template <typename T>
+void
+RcuVectorBase<T>::unsafe_adopt(Alloc && buf, size_t n) {
+    assert(n * sizeof(T) <= buf.size());
+    Array(std::move(buf), n).swap(_data);
+}
+
 template <typename T>
 RcuVectorBase<T>::~RcuVectorBase() { }
 
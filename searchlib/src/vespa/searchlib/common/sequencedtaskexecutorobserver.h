@@ -30,6 +30,7 @@ public:
     virtual void executeTask(uint32_t executorId,
                              vespalib::Executor::Task::UP task) override;
     virtual void sync() override;
+    virtual uint32_t getNumExecutors() const override { return _executor.getNumExecutors(); }
 
     uint32_t getExecuteCnt() const { return _executeCnt; }
     uint32_t getSyncCnt() const { return _syncCnt; }
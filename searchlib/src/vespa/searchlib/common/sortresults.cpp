@@ -219,12 +219,13 @@ FastS_SortSpec::realloc(uint32_t n, size_t & variableWidth, uint32_t & available
 }
 
 void
-FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
+FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n, size_t numVectors)
 {
     freeSortData();
+    const auto vectorsEnd = _vectors.begin() + std::min(numVectors, _vectors.size());
     size_t fixedWidth = 0;
     size_t variableWidth = 0;
-    for (auto iter = _vectors.begin(); iter != _vectors.end(); ++iter) {
+    for (auto iter = _vectors.begin(); iter != vectorsEnd; ++iter) {
         if (iter->_type >= ASC_DOCID) { // doc id
             fixedWidth += sizeof(uint32_t) + sizeof(uint16_t);
         }else if (iter->_type >= ASC_RANK) { // rank value
@@ -248,7 +249,7 @@ FastS_SortSpec::initSortData(const RankedHit *hits, uint32_t n)
     document::GlobalId gid;
     for (uint32_t i(0), idx(0); (i < n) && !_doom.doom(); ++i) {
         uint32_t len = 0;
-        for (auto iter = _vectors.begin(); iter != _vectors.end(); ++iter) {
+        for (auto iter = _vectors.begin(); iter != vectorsEnd; ++iter) {
             int written(0);
             if (available < std::max(sizeof(hits->_docId) + sizeof(_partitionId), sizeof(hits->_rankValue))) {
                 mySortData = realloc(n, variableWidth, available, dataSize, mySortData);
@@ -383,7 +384,7 @@ FastS_SortSpec::hasSortData() const
 void
 FastS_SortSpec::initWithoutSorting(const RankedHit * hits, uint32_t hitCnt)
 {
-    initSortData(hits, hitCnt);
+    initSortData(hits, hitCnt, _vectors.size());
 }
 
 inline int
@@ -486,10 +487,49 @@ public:
 };
 
 
+bool
+FastS_SortSpec::usePreselection(uint32_t n, uint32_t topn) const
+{
+    // Pays off when most hits can be rejected before serializing the
+    // remaining sort levels, string levels in particular.
+    return (_vectors.size() > 1) && (topn > 0) && (uint64_t(topn) * 4 <= n);
+}
+
+uint32_t
+FastS_SortSpec::preselect(RankedHit a[], uint32_t n, uint32_t topn)
+{
+    initSortData(a, n, 1);
+    if (_doom.doom()) {
+        return n;
+    }
+    StdSortDataCompare compare(&_binarySortData[0]);
+    SortDataArray ordered(_sortDataArray);
+    std::nth_element(ordered.begin(), ordered.begin() + (topn - 1), ordered.end(), compare);
+    const SortData threshold = ordered[topn - 1];
+    // Hits tied with the threshold on the first level are decided by the
+    // remaining levels, keep all of them. Preserves the order of the hits.
+    std::vector<RankedHit> rejected;
+    rejected.reserve(n - topn);
+    uint32_t numSelected = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        const SortData & sd = _sortDataArray[i];
+        if (compare.cmp(sd, threshold) <= 0) {
+            a[numSelected++] = sd;
+        } else {
+            rejected.push_back(sd);
+        }
+    }
+    std::copy(rejected.begin(), rejected.end(), a + numSelected);
+    return numSelected;
+}
+
 void
 FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
 {
-    initSortData(a, n);
+    if (usePreselection(n, topn)) {
+        n = preselect(a, n, topn);
+    }
+    initSortData(a, n, _vectors.size());
     SortData * sortData = &_sortDataArray[0];
     if (_method == 0) {
         search::qsort<7, 40, SortData, FastS_SortSpec>(sortData, n, this);
@@ -130,7 +130,19 @@ private:
     SortDataArray            _sortDataArray;
 
     bool Add(search::attribute::IAttributeContext & vecMan, const search::common::SortInfo & sInfo);
-    void initSortData(const search::RankedHit *a, uint32_t n);
+    /**
+     * Serialize sort data for the given hits, using only the first
+     * numVectors sort levels.
+     **/
+    void initSortData(const search::RankedHit *a, uint32_t n, size_t numVectors);
+    bool usePreselection(uint32_t n, uint32_t topn) const;
+    /**
+     * Move the hits that may be among the topn best to the front of
+     * the array, judged by the first sort level only.
+     *
+     * @return the number of hits moved to the front
+     **/
+    uint32_t preselect(search::RankedHit a[], uint32_t n, uint32_t topn);
     uint8_t * realloc(uint32_t n, size_t & variableWidth, uint32_t & available, uint32_t & dataSize, uint8_t *mySortData);
 
 public:
@@ -0,0 +1,33 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "blockposting.h"
+#include <vespa/searchlib/bitcompression/posocccompression.h>
+
+namespace search::diskindex {
+
+class BlockPosOccSeqRead : public BlockPostingSeqRead
+{
+private:
+    bitcompression::PosOccFieldsParams _fieldsParams;
+    bitcompression::EGPosOccDecodeContextCooked<true> _cookedDecodeContext;
+    bitcompression::EGPosOccDecodeContext<true> _rawDecodeContext;
+public:
+    BlockPosOccSeqRead(index::PostingListCountFileSeqRead *countFile);
+    void setFeatureParams(const PostingListParams &params) override;
+    static const vespalib::string &getSubIdentifier();
+};
+
+
+class BlockPosOccSeqWrite : public BlockPostingSeqWrite
+{
+private:
+    bitcompression::PosOccFieldsParams _fieldsParams;
+    bitcompression::EGPosOccEncodeContext<true> _realEncodeFeatures;
+public:
+    typedef index::Schema Schema;
+    BlockPosOccSeqWrite(const Schema &schema, uint32_t indexId, index::PostingListCountFileSeqWrite *countFile);
+};
+
+}
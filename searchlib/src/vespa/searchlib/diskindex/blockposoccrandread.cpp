@@ -0,0 +1,132 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "blockposoccrandread.h"
+#include "blockposting.h"
+#include "blockpostingiterator.h"
+#include "zcposocciterators.h"
+#include <vespa/vespalib/data/fileheader.h>
+#include <vespa/searchlib/queryeval/emptysearch.h>
+#include <vespa/fastos/file.h>
+
+namespace search::diskindex {
+
+using bitcompression::EGPosOccDecodeContext;
+using bitcompression::PosOccFieldsParams;
+using index::PostingListCounts;
+using index::PostingListHandle;
+
+BlockPosOccRandRead::BlockPosOccRandRead()
+    : ZcPosOccRandRead()
+{
+}
+
+
+search::queryeval::SearchIterator *
+BlockPosOccRandRead::
+createIterator(const PostingListCounts &counts,
+               const PostingListHandle &handle,
+               const search::fef::TermFieldMatchDataArray &matchData,
+               bool usebitVector) const
+{
+    (void) usebitVector;
+
+    assert((handle._bitLength != 0) == (counts._bitLength != 0));
+    assert((counts._numDocs != 0) == (counts._bitLength != 0));
+    assert(handle._bitOffsetMem <= handle._bitOffset);
+
+    if (handle._bitLength == 0)
+        return new search::queryeval::EmptySearch;
+
+    const char *cmem = static_cast<const char *>(handle._mem);
+    uint64_t memOffset = reinterpret_cast<unsigned long>(cmem) & 7;
+    const uint64_t *mem = reinterpret_cast<const uint64_t *>
+                          (cmem - memOffset) +
+                          (memOffset * 8 + handle._bitOffset -
+                           handle._bitOffsetMem) / 64;
+    int bitOffset = (memOffset * 8 + handle._bitOffset -
+                     handle._bitOffsetMem) & 63;
+
+    Position start(mem, bitOffset);
+
+    ZcIteratorBase *iterator;
+    int32_t maxWeight = 0;
+    if (counts._numDocs < _minSkipDocs) {
+        iterator = new ZcRareWordPosOccIterator<true>(start, handle._bitLength, _docIdLimit, &_fieldsParams, matchData);
+        if (_blockMaxWeights) {
+            maxWeight = readMaxWeight(mem, bitOffset, counts);
+        }
+    } else {
+        iterator = new BlockPosOccIterator(start, handle._bitLength, _docIdLimit, _blockMaxWeights,
+                                           &_fieldsParams, matchData);
+        if (_blockMaxWeights) {
+            maxWeight = BlockPostingIterator::readMaxWeight(start);
+        }
+    }
+    if (_blockMaxWeights) {
+        iterator->enableBlockMaxWeights(maxWeight);
+    }
+    return iterator;
+}
+
+
+void
+BlockPosOccRandRead::readHeader()
+{
+    EGPosOccDecodeContext<true> d(&_fieldsParams);
+    ComprFileReadContext drc(d);
+
+    drc.setFile(_file.get());
+    drc.setFileSize(_file->GetSize());
+    drc.allocComprBuf(512, 32768u);
+    d.emptyBuffer(0);
+    drc.readComprBuffer();
+    d.setReadContext(&drc);
+
+    vespalib::FileHeader header;
+    d.readHeader(header, _file->getSize());
+    uint32_t headerLen = header.getSize();
+    assert(header.hasTag("frozen"));
+    assert(header.hasTag("fileBitSize"));
+    assert(header.hasTag("format.0"));
+    assert(header.hasTag("format.1"));
+    assert(!header.hasTag("format.2"));
+    assert(header.hasTag("numWords"));
+    assert(header.hasTag("minChunkDocs"));
+    assert(header.hasTag("docIdLimit"));
+    assert(header.hasTag("minSkipDocs"));
+    assert(header.getTag("frozen").asInteger() != 0);
+    _fileBitSize = header.getTag("fileBitSize").asInteger();
+    assert(header.getTag("format.0").asString() == getIdentifier());
+    assert(header.getTag("format.1").asString() == d.getIdentifier());
+    _numWords = header.getTag("numWords").asInteger();
+    _minChunkDocs = header.getTag("minChunkDocs").asInteger();
+    _docIdLimit = header.getTag("docIdLimit").asInteger();
+    _minSkipDocs = header.getTag("minSkipDocs").asInteger();
+    _blockMaxWeights = header.hasTag("blockMaxWeights") &&
+                       header.getTag("blockMaxWeights").asInteger() != 0;
+    // Read feature decoding specific subheader
+    d.readHeader(header, "features.");
+    // Align on 64-bit unit
+    d.smallAlign(64);
+    headerLen += (-headerLen & 7);
+    assert(d.getReadOffset() == headerLen * 8);
+    _headerBitSize = d.getReadOffset();
+}
+
+
+const vespalib::string &
+BlockPosOccRandRead::getIdentifier()
+{
+    return BlockPostingSeqRead::getIdentifier();
+}
+
+
+const vespalib::string &
+BlockPosOccRandRead::getSubIdentifier()
+{
+    PosOccFieldsParams fieldsParams;
+    EGPosOccDecodeContext<true> d(&fieldsParams);
+    return d.getIdentifier();
+}
+
+}
@@ -0,0 +1,35 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "zcposoccrandread.h"
+
+namespace search::diskindex {
+
+/**
+ * Random access to posting lists in the block posting format. Words
+ * stored as blocks get a BlockPosOccIterator, rare words are read as in
+ * the Zc.5 format.
+ */
+class BlockPosOccRandRead : public ZcPosOccRandRead
+{
+public:
+    BlockPosOccRandRead();
+
+    /**
+     * Create iterator for single word.  Semantic lifetime of counts and
+     * handle must exceed lifetime of iterator.
+     */
+    search::queryeval::SearchIterator *
+    createIterator(const PostingListCounts &counts,
+                   const PostingListHandle &handle,
+                   const search::fef::TermFieldMatchDataArray &matchData,
+                   bool usebitVector) const override;
+
+    void readHeader() override;
+
+    static const vespalib::string &getIdentifier();
+    static const vespalib::string &getSubIdentifier();
+};
+
+}
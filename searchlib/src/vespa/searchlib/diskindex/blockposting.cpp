@@ -0,0 +1,272 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "blockposting.h"
+#include <vespa/searchlib/bitcompression/streamvbyte.h>
+#include <vespa/searchlib/index/docidandfeatures.h>
+#include <vespa/searchlib/index/postinglistcounts.h>
+#include <algorithm>
+
+namespace {
+
+vespalib::string myId("Block.1");
+
+}
+
+namespace search::diskindex {
+
+using bitcompression::StreamVByte;
+using index::PostingListCountFileSeqRead;
+using index::PostingListCountFileSeqWrite;
+
+BlockPostingSeqRead::BlockPostingSeqRead(PostingListCountFileSeqRead *countFile)
+    : ZcPostingSeqRead(countFile),
+      _blockDocIds(),
+      _blockBuf(BlockPostingFormat::MAX_DOCID_BYTES + StreamVByte::DECODE_SLACK),
+      _inBlocks(false),
+      _lastBlock(false),
+      _blockDocs(0),
+      _blockPos(0),
+      _prevBlockLastDocId(0),
+      _blockFeaturesEnd(0),
+      _wordMaxWeight(0)
+{
+}
+
+
+BlockPostingSeqRead::~BlockPostingSeqRead() = default;
+
+
+uint32_t
+BlockPostingSeqRead::readZc()
+{
+    DecodeContext &d = *_decodeContext;
+    uint32_t value = 0;
+    for (uint32_t shift = 0; ; shift += 7) {
+        uint32_t byte = d.readBits(8);
+        d.readComprBufferIfNeeded();
+        value |= (byte & ((1 << 7) - 1)) << shift;
+        if (byte < (1 << 7)) {
+            return value;
+        }
+    }
+}
+
+
+void
+BlockPostingSeqRead::readBlockStart()
+{
+    DecodeContext &d = *_decodeContext;
+    uint32_t flags = d.readBits(8);
+    d.readComprBufferIfNeeded();
+    _blockDocs = (flags & ~BlockPostingFormat::LAST_BLOCK) + 1;
+    _lastBlock = (flags & BlockPostingFormat::LAST_BLOCK) != 0;
+    uint32_t lastDocId = _prevBlockLastDocId + 1 + readZc();
+    uint32_t docIdBytes = readZc();
+    uint32_t featureBytes = readZc();
+    if (_blockMaxWeights) {
+        _maxWeight = DecodeContext::convertToSigned(readZc());
+        assert(_maxWeight <= _wordMaxWeight);
+    }
+    assert(_blockDocs <= _residue);
+    assert(_lastBlock == (_blockDocs == _residue));
+    assert(docIdBytes <= BlockPostingFormat::MAX_DOCID_BYTES);
+    d.readBytes(&_blockBuf[0], docIdBytes);
+    StreamVByte::decodeDeltas(&_blockBuf[0], _blockDocs, _prevBlockLastDocId, _blockDocIds);
+    assert(_blockDocIds[_blockDocs - 1] == lastDocId);
+    assert(lastDocId < _docIdLimit);
+    _prevBlockLastDocId = lastDocId;
+    _blockFeaturesEnd = d.getReadOffset() + 8 * static_cast<uint64_t>(featureBytes);
+    _blockPos = 0;
+}
+
+
+void
+BlockPostingSeqRead::readBlockEnd()
+{
+    DecodeContext &d = *_decodeContext;
+    d.align(8);
+    assert(d.getReadOffset() == _blockFeaturesEnd);
+}
+
+
+void
+BlockPostingSeqRead::readDocIdAndFeatures(DocIdAndFeatures &features)
+{
+    if (!_inBlocks) {
+        ZcPostingSeqRead::readDocIdAndFeatures(features);
+        return;
+    }
+    if (_residue == 0) {
+        // Don't read past end of posting list.
+        features.clear(static_cast<uint32_t>(-1));
+        return;
+    }
+    if (_blockPos == _blockDocs) {
+        readBlockEnd();
+        readBlockStart();
+    }
+    features._docId = _blockDocIds[_blockPos++];
+    _decodeContext->readFeatures(features);
+    assert(!_blockMaxWeights || Zc4PostingSeqWrite::calcMaxWeight(features) <= _maxWeight);
+    if (--_residue == 0) {
+        assert(_lastBlock && _blockPos == _blockDocs);
+        readBlockEnd();
+        _inBlocks = false;
+    }
+}
+
+
+void
+BlockPostingSeqRead::readCounts(const PostingListCounts &counts)
+{
+    if (counts._numDocs < _minSkipDocs) {
+        ZcPostingSeqRead::readCounts(counts);
+        return;
+    }
+    _counts = counts;
+    assert(_counts._segments.empty());
+    _wordStart = _decodeContext->getReadOffset();
+    _decodeContext->align(8);
+    if (_blockMaxWeights) {
+        _wordMaxWeight = DecodeContext::convertToSigned(readZc());
+    }
+    _residue = _counts._numDocs;
+    _prevBlockLastDocId = 0;
+    _inBlocks = true;
+    readBlockStart();
+}
+
+
+const vespalib::string &
+BlockPostingSeqRead::getFormatIdentifier() const
+{
+    return myId;
+}
+
+
+const vespalib::string &
+BlockPostingSeqRead::getIdentifier()
+{
+    return myId;
+}
+
+
+BlockPostingSeqWrite::BlockPostingSeqWrite(PostingListCountFileSeqWrite *countFile)
+    : ZcPostingSeqWrite(countFile),
+      _blockBuf((BlockPostingFormat::MAX_DOCID_BYTES + 7) / 8),
+      _blockDocIds(),
+      _prevBlockLastDocId(0)
+{
+    _blockDocIds.reserve(BlockPostingFormat::BLOCK_SIZE);
+}
+
+
+BlockPostingSeqWrite::~BlockPostingSeqWrite() = default;
+
+
+void
+BlockPostingSeqWrite::writeDocIdAndFeatures(const DocIdAndFeatures &features)
+{
+    _encodeFeatures->writeFeatures(features);
+    uint64_t writeOffset = _encodeFeatures->getWriteOffset();
+    uint64_t featureSize = writeOffset - _featureOffset;
+    assert(static_cast<uint32_t>(featureSize) == featureSize);
+    _docIds.push_back(std::make_pair(features._docId,
+                                     static_cast<uint32_t>(featureSize)));
+    if (_blockMaxWeights) {
+        _docMaxWeights.push_back(calcMaxWeight(features));
+    }
+    _featureOffset = writeOffset;
+}
+
+
+void
+BlockPostingSeqWrite::flushBlocks()
+{
+    typedef BlockPostingFormat BPF;
+    _encodeFeatures->flush();
+    EncodeContext &e = _encodeContext;
+    e.smallAlign(8);
+    e.writeComprBufferIfNeeded();
+    const uint64_t *features =
+        static_cast<const uint64_t *>(_featureWriteContext._comprBuf);
+    uint64_t featureOffset = 0;
+    uint32_t numDocs = _docIds.size();
+    uint64_t header[(BPF::MAX_HEADER_BYTES + 7) / 8] = {};
+    if (_blockMaxWeights) {
+        int32_t maxWeight = *std::max_element(_docMaxWeights.begin(), _docMaxWeights.end());
+        uint8_t *headerStart = reinterpret_cast<uint8_t *>(header);
+        uint8_t *p = BPF::encodeZc(headerStart, EncodeContext::convertToUnsigned(maxWeight));
+        e.writeBits(header, 0, (p - headerStart) * 8);
+        e.writeComprBufferIfNeeded();
+    }
+    uint8_t *docIdBuf = reinterpret_cast<uint8_t *>(&_blockBuf[0]);
+    for (uint32_t start = 0; start < numDocs; start += BPF::BLOCK_SIZE) {
+        uint32_t blockDocs = std::min(BPF::BLOCK_SIZE, numDocs - start);
+        bool lastBlock = start + blockDocs == numDocs;
+        assert(lastBlock || blockDocs == BPF::BLOCK_SIZE);
+        uint64_t featureSize = 0;
+        _blockDocIds.clear();
+        for (uint32_t i = start; i < start + blockDocs; ++i) {
+            _blockDocIds.push_back(_docIds[i].first);
+            featureSize += _docIds[i].second;
+        }
+        uint32_t lastDocId = _blockDocIds.back();
+        size_t docIdBytes = StreamVByte::encodeDeltas(&_blockDocIds[0], blockDocs,
+                                                      _prevBlockLastDocId, docIdBuf);
+
+        uint8_t *headerStart = reinterpret_cast<uint8_t *>(header);
+        uint8_t *p = headerStart;
+        *p++ = (blockDocs - 1) | (lastBlock ? BPF::LAST_BLOCK : 0);
+        p = BPF::encodeZc(p, lastDocId - _prevBlockLastDocId - 1);
+        p = BPF::encodeZc(p, docIdBytes);
+        p = BPF::encodeZc(p, (featureSize + 7) / 8);
+        if (_blockMaxWeights) {
+            int32_t maxWeight = *std::max_element(_docMaxWeights.begin() + start,
+                                                  _docMaxWeights.begin() + start + blockDocs);
+            p = BPF::encodeZc(p, EncodeContext::convertToUnsigned(maxWeight));
+        }
+        e.writeBits(header, 0, (p - headerStart) * 8);
+        e.writeBits(&_blockBuf[0], 0, docIdBytes * 8);
+        if (featureSize > 0) {
+            e.writeBits(features + (featureOffset >> 6),
+                        featureOffset & 63,
+                        featureSize);
+        }
+        e.smallAlign(8);
+        e.writeComprBufferIfNeeded();
+        featureOffset += featureSize;
+        _prevBlockLastDocId = lastDocId;
+    }
+    _counts._numDocs += numDocs;
+    resetWord();
+}
+
+
+void
+BlockPostingSeqWrite::flushWord()
+{
+    if (_docIds.size() >= _minSkipDocs) {
+        flushBlocks();
+        _numWords++;
+    } else if (_docIds.size() > 0) {
+        flushWordNoSkip();
+        _numWords++;
+    }
+
+    EncodeContext &e = _encodeContext;
+    uint64_t writePos = e.getWriteOffset();
+
+    _counts._bitLength = writePos - _writePos;
+    _writePos = writePos;
+    _prevBlockLastDocId = 0;
+}
+
+
+const vespalib::string &
+BlockPostingSeqWrite::getFormatIdentifier() const
+{
+    return myId;
+}
+
+}
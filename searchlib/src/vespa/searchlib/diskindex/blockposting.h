@@ -0,0 +1,99 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "zcposting.h"
+
+namespace search::diskindex {
+
+/**
+ * Layout of posting lists in the block posting format.
+ *
+ * Words with fewer than minSkipDocs documents are stored as in the Zc.5
+ * format (exp golomb coded document id deltas interleaved with features).
+ *
+ * Other words are stored byte aligned, as a word header followed by a
+ * sequence of blocks with up to BLOCK_SIZE documents, all but the last
+ * block being full. The word header is
+ *
+ *   maxWeight      zc varint, max weight for word, only present if
+ *                  blockMaxWeights is set
+ *
+ * and each block is
+ *
+ *
+ *   flags          1 byte, (number of documents - 1) | LAST_BLOCK
+ *   lastDocId      zc varint, delta from last document id in previous block - 1
+ *   docIdBytes     zc varint, size of document id deltas
+ *   featureBytes   zc varint, size of features
+ *   maxWeight      zc varint, only present if blockMaxWeights is set
+ *   docIds         StreamVByte coded document id deltas
+ *   features       features for all documents in block, padded to byte
+ *
+ * The block header works as a skip entry: a block where the last document
+ * id is below the seek target is passed without decoding its contents.
+ */
+struct BlockPostingFormat {
+    static constexpr uint32_t BLOCK_SIZE = 128;
+    static constexpr uint8_t LAST_BLOCK = 0x80;
+    static constexpr size_t MAX_HEADER_BYTES = 1 + 4 * 5;
+    static constexpr size_t MAX_DOCID_BYTES = BLOCK_SIZE / 4 + BLOCK_SIZE * 4;
+
+    static uint8_t *encodeZc(uint8_t *dst, uint32_t value) {
+        while (value >= (1 << 7)) {
+            *dst++ = (value & ((1 << 7) - 1)) | (1 << 7);
+            value >>= 7;
+        }
+        *dst++ = value;
+        return dst;
+    }
+};
+
+class BlockPostingSeqRead : public ZcPostingSeqRead
+{
+    uint32_t _blockDocIds[BlockPostingFormat::BLOCK_SIZE];
+    std::vector<uint8_t> _blockBuf;
+    bool _inBlocks;               // Current word is stored as blocks
+    bool _lastBlock;
+    uint32_t _blockDocs;
+    uint32_t _blockPos;
+    uint32_t _prevBlockLastDocId;
+    uint64_t _blockFeaturesEnd;   // Read offset after features for block
+    int32_t _wordMaxWeight;
+
+    uint32_t readZc();
+    void readBlockStart();
+    void readBlockEnd();
+public:
+    BlockPostingSeqRead(index::PostingListCountFileSeqRead *countFile);
+    ~BlockPostingSeqRead();
+
+    void readDocIdAndFeatures(DocIdAndFeatures &features) override;
+    void readCounts(const PostingListCounts &counts) override;
+    const vespalib::string &getFormatIdentifier() const override;
+    static const vespalib::string &getIdentifier();
+};
+
+
+class BlockPostingSeqWrite : public ZcPostingSeqWrite
+{
+    std::vector<uint64_t> _blockBuf;    // StreamVByte coded docid deltas for block
+    std::vector<uint32_t> _blockDocIds;
+    uint32_t _prevBlockLastDocId;
+
+    /**
+     * Write word header and all documents for word as blocks. The whole
+     * word is buffered, since the word header needs the max weight for
+     * the word.
+     */
+    void flushBlocks();
+public:
+    BlockPostingSeqWrite(index::PostingListCountFileSeqWrite *countFile);
+    ~BlockPostingSeqWrite();
+
+    void writeDocIdAndFeatures(const DocIdAndFeatures &features) override;
+    void flushWord() override;
+    const vespalib::string &getFormatIdentifier() const override;
+};
+
+}
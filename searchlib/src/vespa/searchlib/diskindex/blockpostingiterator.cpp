@@ -0,0 +1,181 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "blockpostingiterator.h"
+#include <vespa/searchlib/bitcompression/streamvbyte.h>
+#include <vespa/searchlib/fef/termfieldmatchdataarray.h>
+
+namespace search::diskindex {
+
+using bitcompression::DecodeContext64Base;
+using bitcompression::PosOccFieldsParams;
+using bitcompression::StreamVByte;
+using fef::TermFieldMatchDataArray;
+
+BlockPostingIterator::BlockPostingIterator(const TermFieldMatchDataArray &matchData, Position start,
+                                           uint32_t docIdLimit, bool blockMaxWeightsInFile)
+    : ZcIteratorBase(matchData, start, docIdLimit),
+      _decodeContext(nullptr),
+      _blockMaxWeightsInFile(blockMaxWeightsInFile),
+      _firstBlock(getFirstBlock(start)),
+      _docIdData(nullptr),
+      _features(nullptr),
+      _nextBlock(nullptr),
+      _featureBlock(nullptr),
+      _prevBlockLastDocId(0),
+      _blockLastDocId(0),
+      _blockDocs(0),
+      _docIdPos(0),
+      _featureDocPos(0),
+      _lastBlock(false),
+      _blockDecoded(false)
+{ }
+
+
+const uint8_t *
+BlockPostingIterator::getWordStart(Position start)
+{
+    // Blocks start at byte boundary
+    return reinterpret_cast<const uint8_t *>(start.getOccurences()) + ((start.getBitOffset() + 7) >> 3);
+}
+
+
+const uint8_t *
+BlockPostingIterator::getFirstBlock(Position start) const
+{
+    const uint8_t *valI = getWordStart(start);
+    if (_blockMaxWeightsInFile) {
+        // Skip word header
+        uint32_t maxWeight;
+        ZCDECODE(valI, maxWeight =);
+        (void) maxWeight;
+    }
+    return valI;
+}
+
+
+void
+BlockPostingIterator::readBlockHeader(const uint8_t *header)
+{
+    const uint8_t *valI = header;
+    uint32_t flags = *valI++;
+    uint32_t lastDocIdDelta;
+    uint32_t docIdBytes;
+    uint32_t featureBytes;
+    ZCDECODE(valI, lastDocIdDelta =);
+    ZCDECODE(valI, docIdBytes =);
+    ZCDECODE(valI, featureBytes =);
+    _blockDocs = (flags & ~BlockPostingFormat::LAST_BLOCK) + 1;
+    _lastBlock = (flags & BlockPostingFormat::LAST_BLOCK) != 0;
+    _prevBlockLastDocId = _blockLastDocId;
+    _blockLastDocId += 1 + lastDocIdDelta;
+    if (_blockMaxWeightsInFile) {
+        uint32_t maxWeight;
+        ZCDECODE(valI, maxWeight =);
+        if (hasBlockMaxWeights()) {
+            _blockMaxInfo->setBlock(_blockLastDocId, DecodeContext64Base::convertToSigned(maxWeight));
+        }
+    }
+    _docIdData = valI;
+    _features = valI + docIdBytes;
+    _nextBlock = _features + featureBytes;
+    _blockDecoded = false;
+}
+
+
+void
+BlockPostingIterator::decodeBlock()
+{
+    StreamVByte::decodeDeltas(_docIdData, _blockDocs, _prevBlockLastDocId, _docIds);
+    _blockDecoded = true;
+    _docIdPos = 0;
+}
+
+
+void
+BlockPostingIterator::doSeek(uint32_t docId)
+{
+    if (__builtin_expect(docId > _blockLastDocId, false)) {
+        do {
+            if (_lastBlock) {
+                setAtEnd();
+                return;
+            }
+            readBlockHeader(_nextBlock);
+        } while (docId > _blockLastDocId);
+    }
+    if (!_blockDecoded) {
+        decodeBlock();
+    }
+    uint32_t pos = _docIdPos;
+    while (_docIds[pos] < docId) {
+        ++pos;
+    }
+    _docIdPos = pos;
+    setDocId(_docIds[pos]);
+    clearUnpacked();
+}
+
+
+void
+BlockPostingIterator::doUnpack(uint32_t docId)
+{
+    if (!_matchData.valid() || getUnpacked()) {
+        return;
+    }
+    assert(docId == getDocId());
+    if (_featureBlock != _features) {
+        _decodeContext->setByteCompr(_features);
+        _featureBlock = _features;
+        _featureDocPos = 0;
+    }
+    if (_docIdPos > _featureDocPos) {
+        _decodeContext->skipFeatures(_docIdPos - _featureDocPos);
+    }
+    _decodeContext->unpackFeatures(_matchData, docId);
+    _featureDocPos = _docIdPos + 1;
+    setUnpacked();
+}
+
+
+void
+BlockPostingIterator::readWordStart(uint32_t docIdLimit)
+{
+    (void) docIdLimit;
+    _blockLastDocId = 0;
+    _featureBlock = nullptr;
+    readBlockHeader(_firstBlock);
+    decodeBlock();
+    setDocId(_docIds[0]);
+    clearUnpacked();
+}
+
+
+void
+BlockPostingIterator::rewind(Position start)
+{
+    _firstBlock = getFirstBlock(start);
+}
+
+
+int32_t
+BlockPostingIterator::readMaxWeight(Position start)
+{
+    const uint8_t *valI = getWordStart(start);
+    uint32_t maxWeight;
+    ZCDECODE(valI, maxWeight =);
+    return DecodeContext64Base::convertToSigned(maxWeight);
+}
+
+
+BlockPosOccIterator::BlockPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit,
+                                         bool blockMaxWeightsInFile,
+                                         const PosOccFieldsParams *fieldsParams,
+                                         const TermFieldMatchDataArray &matchData)
+    : BlockPostingIterator(matchData, start, docIdLimit, blockMaxWeightsInFile),
+      _decodeContextReal(start.getOccurences(), start.getBitOffset(), bitLength, fieldsParams)
+{
+    assert(!matchData.valid() || (fieldsParams->getNumFields() == matchData.size()));
+    _decodeContext = &_decodeContextReal;
+}
+
+}
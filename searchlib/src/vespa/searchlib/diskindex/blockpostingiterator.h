@@ -0,0 +1,73 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "blockposting.h"
+#include "zcpostingiterators.h"
+#include <vespa/searchlib/bitcompression/posocccompression.h>
+
+namespace search::diskindex {
+
+/**
+ * Iterator over a word stored as blocks in the block posting format.
+ *
+ * Seeking past the last document id of the current block hops from block
+ * header to block header without touching the document ids. The document
+ * ids of a block are decoded all at once, the first time a seek lands in
+ * it. Features are only decoded when unpacking.
+ */
+class BlockPostingIterator : public ZcIteratorBase
+{
+public:
+    typedef bitcompression::FeatureDecodeContextBE DecodeContextBase;
+protected:
+    DecodeContextBase *_decodeContext;
+private:
+    const bool     _blockMaxWeightsInFile;
+    const uint8_t *_firstBlock;
+    const uint8_t *_docIdData;    // docid deltas for current block
+    const uint8_t *_features;     // features for current block
+    const uint8_t *_nextBlock;
+    const uint8_t *_featureBlock; // block the decode context is positioned in
+    uint32_t       _prevBlockLastDocId;
+    uint32_t       _blockLastDocId;
+    uint32_t       _blockDocs;
+    uint32_t       _docIdPos;     // index of current document in block
+    uint32_t       _featureDocPos;
+    bool           _lastBlock;
+    bool           _blockDecoded;
+    uint32_t       _docIds[BlockPostingFormat::BLOCK_SIZE];
+
+    const uint8_t *getFirstBlock(Position start) const;
+    void readBlockHeader(const uint8_t *header);
+    void decodeBlock();
+public:
+    BlockPostingIterator(const fef::TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit,
+                         bool blockMaxWeightsInFile);
+
+    void doSeek(uint32_t docId) override;
+    void doUnpack(uint32_t docId) override;
+    void readWordStart(uint32_t docIdLimit) override;
+    void rewind(Position start) override;
+
+    /**
+     * Read max weight for word from word header. Only valid when block
+     * max weights are present in the file.
+     */
+    static int32_t readMaxWeight(Position start);
+    static const uint8_t *getWordStart(Position start);
+};
+
+
+class BlockPosOccIterator : public BlockPostingIterator
+{
+private:
+    typedef bitcompression::EGPosOccDecodeContextCooked<true> DecodeContextReal;
+    DecodeContextReal _decodeContextReal;
+public:
+    BlockPosOccIterator(Position start, uint64_t bitLength, uint32_t docIdLimit, bool blockMaxWeightsInFile,
+                        const bitcompression::PosOccFieldsParams *fieldsParams,
+                        const search::fef::TermFieldMatchDataArray &matchData);
+};
+
+}
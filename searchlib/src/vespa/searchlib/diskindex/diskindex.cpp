@@ -104,8 +104,17 @@ DiskIndex::openField(const vespalib::string &fieldDir,
     BitVectorDictionary::SP bDict;
     FileHeader fileHeader;
     bool dynamicK = false;
+    bool blockPostings = false;
     if (fileHeader.taste(postingName, tuneFileSearch._read)) {
         if (fileHeader.getVersion() == 1 &&
+            fileHeader.getBigEndian() &&
+            fileHeader.getFormats().size() == 2 &&
+            fileHeader.getFormats()[0] ==
+            DiskPostingFileBlockReal::getIdentifier() &&
+            fileHeader.getFormats()[1] ==
+            DiskPostingFileBlockReal::getSubIdentifier()) {
+            blockPostings = true;
+        } else if (fileHeader.getVersion() == 1 &&
             fileHeader.getBigEndian() &&
             fileHeader.getFormats().size() == 2 &&
             fileHeader.getFormats()[0] ==
@@ -127,9 +136,13 @@ DiskIndex::openField(const vespalib::string &fieldDir,
                 postingName.c_str());
         }
     }
-    pFile.reset(dynamicK ?
-                new DiskPostingFileDynamicKReal() :
-                new DiskPostingFileReal());
+    if (blockPostings) {
+        pFile.reset(new DiskPostingFileBlockReal());
+    } else {
+        pFile.reset(dynamicK ?
+                    new DiskPostingFileDynamicKReal() :
+                    new DiskPostingFileReal());
+    }
     if (!pFile->open(postingName, tuneFileSearch._read)) {
         LOG(warning,
             "Could not open posting list file '%s'",
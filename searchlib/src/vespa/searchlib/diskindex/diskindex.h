@@ -3,6 +3,7 @@
 #pragma once
 
 #include "bitvectordictionary.h"
+#include "blockposoccrandread.h"
 #include "zcposoccrandread.h"
 #include <vespa/searchlib/index/dictionaryfile.h>
 #include <vespa/searchlib/queryeval/searchable.h>
@@ -67,6 +68,7 @@ private:
     typedef index::PostingListFileRandRead DiskPostingFile;
     typedef Zc4PosOccRandRead DiskPostingFileReal;
     typedef ZcPosOccRandRead DiskPostingFileDynamicKReal;
+    typedef BlockPosOccRandRead DiskPostingFileBlockReal;
     typedef vespalib::cache<vespalib::CacheParam<vespalib::LruParam<Key, LookupResultVector>, DiskIndex>> Cache;
 
     vespalib::string                       _indexDir;
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "extposocc.h"
+#include "blockposocc.h"
 #include "zcposocc.h"
 #include "fileheader.h"
 #include <vespa/searchlib/index/postinglistcounts.h>
@@ -60,6 +61,7 @@ PostingListFileSeqWrite *
 makePosOccWrite(const vespalib::string &name,
                 PostingListCountFileSeqWrite *const posOccCountWrite,
                 bool dynamicK,
+                bool blockPostings,
                 const PostingListParams &params,
                 const PostingListParams &featureParams,
                 const Schema &schema,
@@ -74,10 +76,19 @@ makePosOccWrite(const vespalib::string &name,
             fileHeader.getBigEndian() &&
             fileHeader.getFormats().size() == 2 &&
             fileHeader.getFormats()[0] ==
-            ZcPosOccSeqRead::getIdentifier() &&
+            BlockPosOccSeqRead::getIdentifier() &&
             fileHeader.getFormats()[1] ==
-            ZcPosOccSeqRead::getSubIdentifier()) {
+            BlockPosOccSeqRead::getSubIdentifier()) {
+            blockPostings = true;
+        } else if (fileHeader.getVersion() == 1 &&
+                   fileHeader.getBigEndian() &&
+                   fileHeader.getFormats().size() == 2 &&
+                   fileHeader.getFormats()[0] ==
+                   ZcPosOccSeqRead::getIdentifier() &&
+                   fileHeader.getFormats()[1] ==
+                   ZcPosOccSeqRead::getSubIdentifier()) {
             dynamicK = true;
+            blockPostings = false;
         } else if (fileHeader.getVersion() == 1 &&
                    fileHeader.getBigEndian() &&
                    fileHeader.getFormats().size() == 2 &&
@@ -86,13 +97,16 @@ makePosOccWrite(const vespalib::string &name,
                    fileHeader.getFormats()[1] ==
                    Zc4PosOccSeqRead::getSubIdentifier()) {
             dynamicK = false;
+            blockPostings = false;
         } else {
             LOG(warning,
                 "Could not detect format for posocc file write %s",
                 name.c_str());
         }
     }
-    if (dynamicK)
+    if (blockPostings)
+        posOccWrite = new BlockPosOccSeqWrite(schema, indexId, posOccCountWrite);
+    else if (dynamicK)
         posOccWrite =  new ZcPosOccSeqWrite(schema, indexId, posOccCountWrite);
     else
         posOccWrite =
@@ -112,10 +126,19 @@ makePosOccRead(const vespalib::string &name,
                const TuneFileSeqRead &tuneFileRead)
 {
     PostingListFileSeqRead *posOccRead = NULL;
+    bool blockPostings = false;
 
     FileHeader fileHeader;
     if (fileHeader.taste(name, tuneFileRead)) {
         if (fileHeader.getVersion() == 1 &&
+            fileHeader.getBigEndian() &&
+            fileHeader.getFormats().size() == 2 &&
+            fileHeader.getFormats()[0] ==
+            BlockPosOccSeqRead::getIdentifier() &&
+            fileHeader.getFormats()[1] ==
+            BlockPosOccSeqRead::getSubIdentifier()) {
+            blockPostings = true;
+        } else if (fileHeader.getVersion() == 1 &&
             fileHeader.getBigEndian() &&
             fileHeader.getFormats().size() == 2 &&
             fileHeader.getFormats()[0] ==
@@ -137,7 +160,9 @@ makePosOccRead(const vespalib::string &name,
                 name.c_str());
         }
     }
-    if (dynamicK)
+    if (blockPostings)
+        posOccRead = new BlockPosOccSeqRead(posOccCountRead);
+    else if (dynamicK)
         posOccRead =  new ZcPosOccSeqRead(posOccCountRead);
     else
         posOccRead =  new Zc4PosOccSeqRead(posOccCountRead);
@@ -35,6 +35,7 @@ index::PostingListFileSeqWrite *
 makePosOccWrite(const vespalib::string &name,
                 index::PostingListCountFileSeqWrite *const posOccCountWrite,
                 bool dynamicK,
+                bool blockPostings,
                 const index::PostingListParams &params,
                 const index::PostingListParams &featureParams,
                 const index::Schema &schema,
@@ -37,6 +37,7 @@ FieldWriter::open(const vespalib::string &prefix,
                   uint32_t minSkipDocs,
                   uint32_t minChunkDocs,
                   bool dynamicKPosOccFormat,
+                  bool blockPosOccFormat,
                   const Schema &schema,
                   const uint32_t indexId,
                   const TuneFileSeqWrite &tuneFileWrite,
@@ -62,6 +63,9 @@ FieldWriter::open(const vespalib::string &prefix,
         countParams.set("minChunkDocs", minChunkDocs);
         params.set("minChunkDocs", minChunkDocs);
     }
+    if (schema.getIndexField(indexId).hasBlockMaxWeights()) {
+        params.set("blockMaxWeights", true);
+    }
 
     _dictFile = std::make_unique<PageDict4FileSeqWrite>();
     _dictFile->setParams(countParams);
@@ -69,6 +73,7 @@ FieldWriter::open(const vespalib::string &prefix,
     _posoccfile.reset(diskindex::makePosOccWrite(name,
                                                  _dictFile.get(),
                                                  dynamicKPosOccFormat,
+                                                 blockPosOccFormat,
                                                  params,
                                                  featureParams,
                                                  schema,
@@ -9,7 +9,13 @@
 #include <vespa/vespalib/io/fileutil.h>
 #include <vespa/searchlib/common/documentsummary.h>
 #include <vespa/vespalib/util/error.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
+#include <tuple>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.fusion");
@@ -31,30 +37,112 @@ namespace search {
 
 namespace diskindex {
 
+namespace {
+
+// Per input buffers for dictionary and posting file readers.
+const size_t fieldReaderMemory = 1024 * 1024;
+
+const char *dictionaryFileSuffixes[] = { "dictionary.pdat", "dictionary.spdat", "dictionary.ssdat" };
+
+/*
+ * Limits the number of fields merged concurrently and the sum of their
+ * memory estimates. Stops handing out slots after a field has failed.
+ */
+class FieldMergeLimiter
+{
+    std::mutex _lock;
+    std::condition_variable _cond;
+    const uint32_t _maxFields;
+    const size_t _memoryBudget;
+    uint32_t _activeFields;
+    size_t _usedMemory;
+    bool _failed;
+
+public:
+    FieldMergeLimiter(uint32_t maxFields, size_t memoryBudget)
+        : _lock(),
+          _cond(),
+          _maxFields(maxFields),
+          _memoryBudget(memoryBudget),
+          _activeFields(0),
+          _usedMemory(0),
+          _failed(false)
+    {
+    }
+
+    bool acquire(size_t memory) {
+        std::unique_lock<std::mutex> guard(_lock);
+        while (!_failed && _activeFields != 0 &&
+               (_activeFields >= _maxFields ||
+                (_memoryBudget != 0 && _usedMemory + memory > _memoryBudget))) {
+            _cond.wait(guard);
+        }
+        if (_failed) {
+            return false;
+        }
+        ++_activeFields;
+        _usedMemory += memory;
+        return true;
+    }
+
+    void release(size_t memory, bool ok) {
+        std::lock_guard<std::mutex> guard(_lock);
+        --_activeFields;
+        _usedMemory -= memory;
+        if (!ok) {
+            _failed = true;
+        }
+        _cond.notify_all();
+    }
+
+    void waitIdle() {
+        std::unique_lock<std::mutex> guard(_lock);
+        while (_activeFields != 0) {
+            _cond.wait(guard);
+        }
+    }
+
+    bool failed() {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _failed;
+    }
+};
+
+}
+
 void
 FusionInputIndex::setSchema(const Schema::SP &schema)
 {
     _schema = schema;
 }
 
+Fusion::FieldState::FieldState(const SchemaUtil::IndexIterator &index, uint32_t progressId, size_t numOldIndexes)
+    : _index(index),
+      _progressId(progressId),
+      _wordNumMappings(numOldIndexes),
+      _numWordIds(0u)
+{
+}
+
+Fusion::FieldState::~FieldState() = default;
+
 Fusion::Fusion(bool dynamicKPosIndexFormat,
                const TuneFileIndexing &tuneFileIndexing,
                const FileHeaderContext &fileHeaderContext)
     : _schema(NULL),
       _oldIndexes(),
       _docIdLimit(0u),
-      _numWordIds(0u),
       _dynamicKPosIndexFormat(dynamicKPosIndexFormat),
       _outDir("merged"),
       _tuneFileIndexing(tuneFileIndexing),
-      _fileHeaderContext(fileHeaderContext)
+      _fileHeaderContext(fileHeaderContext),
+      _numThreads(1),
+      _memoryBudget(0),
+      _progress(std::make_shared<FusionProgress>())
 { }
 
 
-Fusion::~Fusion()
-{
-    ReleaseMappingTables();
-}
+Fusion::~Fusion() = default;
 
 
 void
@@ -71,6 +159,21 @@ Fusion::setOutDir(const vespalib::string &outDir)
 }
 
 
+void
+Fusion::setConcurrency(uint32_t numThreads, size_t memoryBudget)
+{
+    _numThreads = std::max(numThreads, 1u);
+    _memoryBudget = memoryBudget;
+}
+
+
+void
+Fusion::setProgress(const FusionProgress::SP &progress)
+{
+    _progress = progress;
+}
+
+
 void
 Fusion::SetOldIndexList(const std::vector<vespalib::string> &oldIndexList)
 {
@@ -94,16 +197,17 @@ Fusion::SetOldIndexList(const std::vector<vespalib::string> &oldIndexList)
 
 
 bool
-Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
+Fusion::openInputWordReaders(const FieldState &field,
                              std::vector<
                                  std::unique_ptr<DictionaryWordReader> > &
                              readers,
                              PostingPriorityQueue<DictionaryWordReader> &heap)
 {
+    const SchemaUtil::IndexIterator &index = field._index;
     for (auto &i : getOldIndexes()) {
         OldIndex &oi = *i;
         auto reader(std::make_unique<DictionaryWordReader>());
-        const vespalib::string &tmpindexpath = oi.getTmpPath();
+        const vespalib::string tmpindexpath = getFieldTmpPath(oi, index);
         const vespalib::string &oldindexpath = oi.getPath();
         vespalib::string wordMapName = tmpindexpath + "/old2new.dat";
         vespalib::string fieldDir(oldindexpath + "/" + index.getName());
@@ -131,22 +235,22 @@ Fusion::openInputWordReaders(const SchemaUtil::IndexIterator &index,
 
 
 bool
-Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
+Fusion::renumberFieldWordIds(FieldState &field)
 {
-    vespalib::string indexName = index.getName();
+    vespalib::string indexName = field._index.getName();
     LOG(debug, "Renumber word IDs for field %s", indexName.c_str());
 
     std::vector<std::unique_ptr<DictionaryWordReader>> readers;
     PostingPriorityQueue<DictionaryWordReader> heap;
     WordAggregator out;
 
-    if (!openInputWordReaders(index, readers, heap))
+    if (!openInputWordReaders(field, readers, heap))
         return false;
 
 
     heap.merge(out, 4);
     assert(heap.empty());
-    _numWordIds = out.getWordNum();
+    field._numWordIds = out.getWordNum();
 
     // Close files
     for (auto &i : readers) {
@@ -155,7 +259,7 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 
     // Now read mapping files back into an array
     // XXX: avoid this, and instead make the array here
-    if (!ReadMappingFiles(&index))
+    if (!ReadMappingFiles(field))
         return false;
 
     LOG(debug, "Finished renumbering words IDs for field %s",
@@ -165,66 +269,140 @@ Fusion::renumberFieldWordIds(const SchemaUtil::IndexIterator &index)
 }
 
 
+size_t
+Fusion::estimateFieldMemory(const SchemaUtil::IndexIterator &index) const
+{
+    size_t memory = fieldReaderMemory;
+    for (const auto &i : _oldIndexes) {
+        const OldIndex &oi = *i;
+        if (!index.hasOldFields(oi.getSchema(), false)) {
+            continue;
+        }
+        memory += fieldReaderMemory;
+        // The compressed dictionary uses a few bytes per word, the word
+        // number mapping 8 bytes per word.
+        for (const char *suffix : dictionaryFileSuffixes) {
+            FastOS_StatInfo statInfo;
+            vespalib::string name(oi.getPath() + "/" + index.getName() + "/" + suffix);
+            if (FastOS_File::Stat(name.c_str(), &statInfo)) {
+                memory += 2 * statInfo._size;
+            }
+        }
+    }
+    return memory;
+}
+
+
 bool
 Fusion::mergeFields()
 {
-   typedef SchemaUtil::IndexIterator IndexIterator;
+    typedef SchemaUtil::IndexIterator IndexIterator;
 
     const Schema &schema = getSchema();
+    // Field id, progress id and memory estimate
+    std::vector<std::tuple<uint32_t, uint32_t, size_t>> fields;
     for (IndexIterator index(schema); index.isValid(); ++index) {
-        if (!mergeField(index.getIndex()))
-            return false;
+        size_t memory = estimateFieldMemory(index);
+        uint32_t progressId = _progress->addField(index.getName(), memory);
+        fields.emplace_back(index.getIndex(), progressId, memory);
     }
-    return true;
+    _progress->start(_numThreads, _memoryBudget);
+    bool ok = true;
+    if (_numThreads <= 1 || fields.size() <= 1) {
+        for (const auto &field : fields) {
+            if (!mergeField(std::get<0>(field), std::get<1>(field))) {
+                ok = false;
+                break;
+            }
+        }
+    } else {
+        // Start the largest fields first, to avoid one of them being the tail
+        std::stable_sort(fields.begin(), fields.end(),
+                         [](const auto &lhs, const auto &rhs) { return std::get<2>(lhs) > std::get<2>(rhs); });
+        vespalib::ThreadStackExecutor executor(std::min(_numThreads, static_cast<uint32_t>(fields.size())),
+                                               128 * 1024);
+        FieldMergeLimiter limiter(_numThreads, _memoryBudget);
+        for (const auto &field : fields) {
+            uint32_t id = std::get<0>(field);
+            uint32_t progressId = std::get<1>(field);
+            size_t memory = std::get<2>(field);
+            if (!limiter.acquire(memory)) {
+                break;
+            }
+            auto task = vespalib::makeLambdaTask([this, &limiter, id, progressId, memory]() {
+                limiter.release(memory, mergeField(id, progressId));
+            });
+            vespalib::Executor::Task::UP rejected = executor.execute(std::move(task));
+            if (rejected) {
+                rejected->run();
+            }
+        }
+        limiter.waitIdle();
+        executor.sync();
+        ok = !limiter.failed();
+    }
+    if (ok && !CleanTmpDirs()) {
+        ok = false;
+    }
+    _progress->finish();
+    return ok;
 }
 
 
 bool
-Fusion::mergeField(uint32_t id)
+Fusion::mergeField(uint32_t id, uint32_t progressId)
 {
     typedef SchemaUtil::IndexIterator IndexIterator;
     typedef SchemaUtil::IndexSettings IndexSettings;
 
     const Schema &schema = getSchema();
     IndexIterator index(schema, id);
+    FieldState field(index, progressId, _oldIndexes.size());
     const vespalib::string &indexName = index.getName();
     IndexSettings settings = index.getIndexSettings();
-    if (settings.hasError())
+    _progress->startField(progressId);
+    if (settings.hasError()) {
+        _progress->finishField(progressId, 0, false);
         return false;
+    }
     vespalib::string indexDir = _outDir + "/" + indexName;
 
-    if (FileKit::hasStamp(indexDir + "/.mergeocc_done"))
+    if (FileKit::hasStamp(indexDir + "/.mergeocc_done")) {
+        _progress->finishField(progressId, 0, true);
         return true;
+    }
 
     vespalib::mkdir(indexDir.c_str(), false);
 
     LOG(debug, "mergeField for field %s dir %s",
         indexName.c_str(), indexDir.c_str());
 
-    makeTmpDirs();
+    makeTmpDirs(index);
 
-    if (!renumberFieldWordIds(index)) {
+    if (!renumberFieldWordIds(field)) {
         LOG(error, "Could not renumber field word ids for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
+        _progress->finishField(progressId, 0, false);
         return false;
     }
 
     // Tokamak
-    bool res = mergeFieldPostings(index);
+    bool res = mergeFieldPostings(field);
     if (!res) {
         LOG(error, "Could not merge field postings for field %s dir %s",
             indexName.c_str(), indexDir.c_str());
         abort();
     }
-    if (!FileKit::createStamp(indexDir +  "/.mergeocc_done"))
-        return false;
-
-    if (!CleanTmpDirs())
+    if (!FileKit::createStamp(indexDir +  "/.mergeocc_done") ||
+        !cleanFieldTmpDirs(index)) {
+        _progress->finishField(progressId, field._numWordIds, false);
         return false;
+    }
 
     LOG(debug, "Finished mergeField for field %s dir %s",
         indexName.c_str(), indexDir.c_str());
 
+    _progress->finishField(progressId, field._numWordIds, true);
     return true;
 }
 
@@ -284,19 +462,20 @@ Fusion::selectCookedOrRawFeatures(Reader &reader, Writer &writer)
 
 
 bool
-Fusion::openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+Fusion::openInputFieldReaders(const FieldState &field,
                               std::vector<std::unique_ptr<FieldReader> > &
                               readers)
 {
+    const SchemaUtil::IndexIterator &index = field._index;
     vespalib::string indexName = index.getName();
-    for (auto &i : _oldIndexes) {
-        OldIndex &oi = *i;
+    for (uint32_t i = 0; i < _oldIndexes.size(); ++i) {
+        OldIndex &oi = *_oldIndexes[i];
         const Schema &oldSchema = oi.getSchema();
         if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
         auto reader = FieldReader::allocFieldReader(index, oldSchema);
-        reader->setup(oi.getWordNumMapping(),
+        reader->setup(field._wordNumMappings[i],
                       oi.getDocIdMapping());
         if (!reader->open(oi.getPath() + "/" +
                           indexName + "/",
@@ -309,15 +488,17 @@ Fusion::openInputFieldReaders(const SchemaUtil::IndexIterator &index,
 
 
 bool
-Fusion::openFieldWriter(const SchemaUtil::IndexIterator &index,
+Fusion::openFieldWriter(const FieldState &field,
                         FieldWriter &writer)
 {
+    const SchemaUtil::IndexIterator &index = field._index;
     vespalib::string dir = _outDir + "/" + index.getName();
 
     if (!writer.open(dir + "/",
                      64,
                      262144,
                      _dynamicKPosIndexFormat,
+                     false,
                      index.getSchema(),
                      index.getIndex(),
                      _tuneFileIndexing._write,
@@ -350,17 +531,17 @@ Fusion::setupMergeHeap(const std::vector<std::unique_ptr<FieldReader> > &
 
 
 bool
-Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
+Fusion::mergeFieldPostings(const FieldState &field)
 {
     std::vector<std::unique_ptr<FieldReader>> readers;
     PostingPriorityQueue<FieldReader> heap;
     /* OUTPUT */
-    FieldWriter fieldWriter(_docIdLimit, _numWordIds);
-    vespalib::string indexName = index.getName();
+    FieldWriter fieldWriter(_docIdLimit, field._numWordIds);
+    vespalib::string indexName = field._index.getName();
 
-    if (!openInputFieldReaders(index, readers))
+    if (!openInputFieldReaders(field, readers))
         return false;
-    if (!openFieldWriter(index, fieldWriter))
+    if (!openFieldWriter(field, fieldWriter))
         return false;
     if (!setupMergeHeap(readers, fieldWriter, heap))
         return false;
@@ -382,15 +563,14 @@ Fusion::mergeFieldPostings(const SchemaUtil::IndexIterator &index)
 
 
 bool
-Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
+Fusion::ReadMappingFiles(FieldState &field)
 {
-    ReleaseMappingTables();
-
+    const SchemaUtil::IndexIterator &index = field._index;
     size_t numberOfOldIndexes = _oldIndexes.size();
     for (uint32_t i = 0; i < numberOfOldIndexes; i++)
     {
         OldIndex &oi = *_oldIndexes[i];
-        WordNumMapping &wordNumMapping = oi.getWordNumMapping();
+        WordNumMapping &wordNumMapping = field._wordNumMappings[i];
         std::vector<uint32_t> oldIndexes;
         const Schema &oldSchema = oi.getSchema();
         if (!SchemaUtil::getIndexIds(oldSchema,
@@ -401,12 +581,12 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
             wordNumMapping.noMappingFile();
             continue;
         }
-        if (index && !index->hasOldFields(oldSchema, false)) {
+        if (!index.hasOldFields(oldSchema, false)) {
             continue; // drop data
         }
 
         // Open word mapping file
-        vespalib::string old2newname = oi.getTmpPath() + "/old2new.dat";
+        vespalib::string old2newname = getFieldTmpPath(oi, index) + "/old2new.dat";
         wordNumMapping.readMappingFile(old2newname, _tuneFileIndexing._read);
     }
 
@@ -414,30 +594,39 @@ Fusion::ReadMappingFiles(const SchemaUtil::IndexIterator *index)
 }
 
 
-bool
-Fusion::ReleaseMappingTables()
+vespalib::string
+Fusion::getFieldTmpPath(const OldIndex &oi, const SchemaUtil::IndexIterator &index) const
 {
-    size_t numberOfOldIndexes = _oldIndexes.size();
-    for (uint32_t i = 0; i < numberOfOldIndexes; i++)
-    {
-        OldIndex &oi = *_oldIndexes[i];
-        oi.getWordNumMapping().clear();
-    }
-    return true;
+    return oi.getTmpPath() + "/" + index.getName();
 }
 
 
 void
-Fusion::makeTmpDirs()
+Fusion::makeTmpDirs(const SchemaUtil::IndexIterator &index)
 {
     for (auto &i : getOldIndexes()) {
         OldIndex &oi = *i;
-        // Make tmpindex directories
-        const vespalib::string &tmpindexpath = oi.getTmpPath();
-        vespalib::mkdir(tmpindexpath, false);
+        // Make tmpindex directories, with a subdirectory per field
+        vespalib::mkdir(getFieldTmpPath(oi, index), true);
     }
 }
 
+
+bool
+Fusion::cleanFieldTmpDirs(const SchemaUtil::IndexIterator &index)
+{
+    for (auto &i : getOldIndexes()) {
+        OldIndex &oi = *i;
+        const vespalib::string tmpindexpath = getFieldTmpPath(oi, index);
+        search::DirectoryTraverse dt(tmpindexpath.c_str());
+        if (!dt.RemoveTree()) {
+            LOG(error, "Failed to clean tmpdir %s", tmpindexpath.c_str());
+            return false;
+        }
+    }
+    return true;
+}
+
 bool
 Fusion::CleanTmpDirs()
 {
@@ -514,7 +703,10 @@ Fusion::merge(const Schema &schema,
               const SelectorArray &selector,
               bool dynamicKPosOccFormat,
               const TuneFileIndexing &tuneFileIndexing,
-              const FileHeaderContext &fileHeaderContext)
+              const FileHeaderContext &fileHeaderContext,
+              uint32_t numThreads,
+              size_t memoryBudget,
+              const FusionProgress::SP &progress)
 {
     assert(sources.size() <= 255);
     uint32_t docIdLimit = selector.size();
@@ -557,6 +749,10 @@ Fusion::merge(const Schema &schema,
                                          fileHeaderContext));
     fusion->setSchema(&schema);
     fusion->setOutDir(dir);
+    fusion->setConcurrency(numThreads, memoryBudget);
+    if (progress) {
+        fusion->setProgress(progress);
+    }
     fusion->SetOldIndexList(sources);
     if (!fusion->readSchemaFiles()) {
         LOG(error, "Cannot read schema files for source indexes");
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "docidmapper.h"
+#include "fusionprogress.h"
 #include "wordnummapper.h"
 
 #include <vespa/searchlib/index/schemautil.h>
@@ -33,11 +34,9 @@ class DictionaryWordReader;
 class FusionInputIndex
 {
 public:
-    typedef diskindex::WordNumMapping WordNumMapping;
     typedef diskindex::DocIdMapping DocIdMapping;
 private:
     vespalib::string _path;
-    WordNumMapping _wordNumMapping;
     DocIdMapping _docIdMapping;
     vespalib::string _tmpPath;
     index::Schema::SP _schema;
@@ -45,7 +44,6 @@ private:
 public:
     FusionInputIndex()
         : _path(),
-          _wordNumMapping(),
           _docIdMapping(),
           _tmpPath(),
           _schema()
@@ -81,18 +79,6 @@ public:
         return _tmpPath;
     }
 
-    const WordNumMapping &
-    getWordNumMapping() const
-    {
-        return _wordNumMapping;
-    }
-
-    WordNumMapping &
-    getWordNumMapping()
-    {
-        return _wordNumMapping;
-    }
-
     const DocIdMapping &
     getDocIdMapping() const
     {
@@ -123,6 +109,22 @@ public:
     typedef search::index::Schema Schema;
     typedef search::index::SchemaUtil SchemaUtil;
 
+    /*
+     * State for merging a single field. Owned by the thread merging the
+     * field, allowing fields to be merged concurrently.
+     */
+    class FieldState
+    {
+    public:
+        const SchemaUtil::IndexIterator _index;
+        const uint32_t _progressId;
+        std::vector<WordNumMapping> _wordNumMappings; // One per old index
+        uint64_t _numWordIds;
+
+        FieldState(const SchemaUtil::IndexIterator &index, uint32_t progressId, size_t numOldIndexes);
+        ~FieldState();
+    };
+
 private:
     Fusion(const Fusion &);
     Fusion& operator=(const Fusion &);
@@ -138,23 +140,23 @@ public:
     void SetOldIndexList(const std::vector<vespalib::string> &oldIndexList);
 
     bool mergeFields();
-    bool mergeField(uint32_t id);
-    bool openInputFieldReaders(const SchemaUtil::IndexIterator &index,
+    bool mergeField(uint32_t id, uint32_t progressId);
+    bool openInputFieldReaders(const FieldState &field,
                                std::vector<std::unique_ptr<FieldReader> > &
                                readers);
-    bool openFieldWriter(const SchemaUtil::IndexIterator &index,
+    bool openFieldWriter(const FieldState &field,
                          FieldWriter &writer);
     bool setupMergeHeap(const std::vector<std::unique_ptr<FieldReader> > &
                         readers,
                         FieldWriter &writer,
                         PostingPriorityQueue<FieldReader> &heap);
-    bool mergeFieldPostings(const SchemaUtil::IndexIterator &index);
-    bool openInputWordReaders(const SchemaUtil::IndexIterator &index,
+    bool mergeFieldPostings(const FieldState &field);
+    bool openInputWordReaders(const FieldState &field,
                               std::vector<
                                  std::unique_ptr<DictionaryWordReader> > &
                               readers,
                               PostingPriorityQueue<DictionaryWordReader> &heap);
-    bool renumberFieldWordIds(const SchemaUtil::IndexIterator &index);
+    bool renumberFieldWordIds(FieldState &field);
 
     void
     setSchema(const Schema *schema);
@@ -162,7 +164,23 @@ public:
     void
     setOutDir(const vespalib::string &outDir);
 
-    void makeTmpDirs();
+    /**
+     * Merge up to numThreads fields concurrently, while the sum of the
+     * memory estimates for the fields being merged is within
+     * memoryBudget. A field exceeding the budget is merged alone.
+     * A memoryBudget of 0 means no limit.
+     */
+    void
+    setConcurrency(uint32_t numThreads, size_t memoryBudget);
+
+    void
+    setProgress(const FusionProgress::SP &progress);
+
+    vespalib::string getFieldTmpPath(const FusionInputIndex &oi, const SchemaUtil::IndexIterator &index) const;
+
+    void makeTmpDirs(const SchemaUtil::IndexIterator &index);
+
+    bool cleanFieldTmpDirs(const SchemaUtil::IndexIterator &index);
 
     bool CleanTmpDirs();
 
@@ -172,13 +190,18 @@ public:
     bool
     checkSchemaCompat();
 
+    /**
+     * Estimate memory needed for merging field, dominated by the old to
+     * new word number mappings.
+     */
+    size_t estimateFieldMemory(const SchemaUtil::IndexIterator &index) const;
+
     template <class Reader, class Writer>
     static bool
     selectCookedOrRawFeatures(Reader &reader, Writer &writer);
 
 protected:
-    bool ReadMappingFiles(const SchemaUtil::IndexIterator *index);
-    bool ReleaseMappingTables();
+    bool ReadMappingFiles(FieldState &field);
 
     static unsigned int noGen()
     {
@@ -197,7 +220,6 @@ protected:
     // OUTPUT:
 
     uint32_t _docIdLimit;
-    uint64_t _numWordIds;
 
     // Index format parameters.
     bool _dynamicKPosIndexFormat;
@@ -212,6 +234,10 @@ protected:
     const TuneFileIndexing &_tuneFileIndexing;
     const search::common::FileHeaderContext &_fileHeaderContext;
 
+    uint32_t _numThreads;
+    size_t _memoryBudget;
+    FusionProgress::SP _progress;
+
     const Schema &
     getSchema() const
     {
@@ -226,12 +252,6 @@ public:
         _docIdLimit = docIdLimit;
     }
 
-    void
-    setNumWordIds(uint64_t numWordIds)
-    {
-        _numWordIds = numWordIds;
-    }
-
     std::vector<std::shared_ptr<OldIndex> > &
     getOldIndexes()
     {
@@ -246,6 +266,10 @@ public:
 
     /**
      * This method is used by new indexing pipeline to merge indexes.
+     *
+     * Fields are merged by up to numThreads threads, limited by
+     * memoryBudget (see setConcurrency). If progress is set, it is
+     * updated as fields are merged.
      */
     static bool
     merge(const Schema &schema,
@@ -254,7 +278,10 @@ public:
           const SelectorArray &docIdSelector,
           bool dynamicKPosOccFormat,
           const TuneFileIndexing &tuneFileIndexing,
-          const search::common::FileHeaderContext &fileHeaderContext);
+          const search::common::FileHeaderContext &fileHeaderContext,
+          uint32_t numThreads = 1,
+          size_t memoryBudget = 0,
+          const FusionProgress::SP &progress = FusionProgress::SP());
 };
 
 } // namespace diskindex
@@ -0,0 +1,169 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "fusionprogress.h"
+#include <cassert>
+
+namespace search::diskindex {
+
+using Guard = std::lock_guard<std::mutex>;
+
+FusionProgress::Field::Field(const vespalib::string &name_, size_t memoryEstimate_)
+    : name(name_),
+      state(State::PENDING),
+      memoryEstimate(memoryEstimate_),
+      numWordIds(0),
+      startTime(),
+      endTime()
+{
+}
+
+FusionProgress::Field::~Field() = default;
+
+int64_t
+FusionProgress::Field::getDurationMs() const
+{
+    switch (state) {
+    case State::PENDING:
+        return 0;
+    case State::RUNNING:
+        return (fastos::TimeStamp(fastos::ClockSystem::now()) - startTime).ms();
+    default:
+        return (endTime - startTime).ms();
+    }
+}
+
+FusionProgress::FusionProgress()
+    : _lock(),
+      _fields(),
+      _startTime(),
+      _endTime(),
+      _numThreads(1),
+      _memoryBudget(0),
+      _done(false)
+{
+}
+
+FusionProgress::~FusionProgress() = default;
+
+void
+FusionProgress::start(uint32_t numThreads, size_t memoryBudget)
+{
+    Guard guard(_lock);
+    _startTime = fastos::ClockSystem::now();
+    _numThreads = numThreads;
+    _memoryBudget = memoryBudget;
+}
+
+void
+FusionProgress::finish()
+{
+    Guard guard(_lock);
+    _endTime = fastos::ClockSystem::now();
+    _done = true;
+}
+
+uint32_t
+FusionProgress::addField(const vespalib::string &name, size_t memoryEstimate)
+{
+    Guard guard(_lock);
+    _fields.emplace_back(name, memoryEstimate);
+    return _fields.size() - 1;
+}
+
+void
+FusionProgress::startField(uint32_t fieldId)
+{
+    Guard guard(_lock);
+    assert(fieldId < _fields.size());
+    Field &field = _fields[fieldId];
+    field.state = State::RUNNING;
+    field.startTime = fastos::ClockSystem::now();
+}
+
+void
+FusionProgress::finishField(uint32_t fieldId, uint64_t numWordIds, bool ok)
+{
+    Guard guard(_lock);
+    assert(fieldId < _fields.size());
+    Field &field = _fields[fieldId];
+    field.state = ok ? State::DONE : State::FAILED;
+    field.numWordIds = numWordIds;
+    field.endTime = fastos::ClockSystem::now();
+}
+
+std::vector<FusionProgress::Field>
+FusionProgress::getFields() const
+{
+    Guard guard(_lock);
+    return _fields;
+}
+
+uint32_t
+FusionProgress::getNumFields() const
+{
+    Guard guard(_lock);
+    return _fields.size();
+}
+
+uint32_t
+FusionProgress::getNumDoneFields() const
+{
+    Guard guard(_lock);
+    uint32_t numDone = 0;
+    for (const auto &field : _fields) {
+        if (field.state == State::DONE) {
+            ++numDone;
+        }
+    }
+    return numDone;
+}
+
+int64_t
+FusionProgress::getElapsedMs() const
+{
+    Guard guard(_lock);
+    if (_startTime == fastos::TimeStamp()) {
+        return 0;
+    }
+    fastos::TimeStamp endTime(_done ? _endTime : fastos::TimeStamp(fastos::ClockSystem::now()));
+    return (endTime - _startTime).ms();
+}
+
+uint32_t
+FusionProgress::getNumThreads() const
+{
+    Guard guard(_lock);
+    return _numThreads;
+}
+
+size_t
+FusionProgress::getMemoryBudget() const
+{
+    Guard guard(_lock);
+    return _memoryBudget;
+}
+
+bool
+FusionProgress::isDone() const
+{
+    Guard guard(_lock);
+    return _done;
+}
+
+const char *
+FusionProgress::toString(State state)
+{
+    switch (state) {
+    case State::PENDING:
+        return "pending";
+    case State::RUNNING:
+        return "running";
+    case State::DONE:
+        return "done";
+    case State::FAILED:
+        return "failed";
+    }
+    return "unknown";
+}
+
+}
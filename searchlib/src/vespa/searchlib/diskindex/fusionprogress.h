@@ -0,0 +1,79 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/fastos/timestamp.h>
+#include <vespa/vespalib/stllike/string.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace search::diskindex {
+
+/**
+ * Progress of a disk index fusion, updated by the threads merging the
+ * fields and read by state explorers while the fusion is running.
+ */
+class FusionProgress
+{
+public:
+    enum class State {
+        PENDING,
+        RUNNING,
+        DONE,
+        FAILED
+    };
+
+    struct Field {
+        vespalib::string  name;
+        State             state;
+        size_t            memoryEstimate; // Reserved from memory budget while running
+        uint64_t          numWordIds;
+        fastos::TimeStamp startTime;
+        fastos::TimeStamp endTime;
+
+        Field(const vespalib::string &name_, size_t memoryEstimate_);
+        ~Field();
+        int64_t getDurationMs() const;
+    };
+
+private:
+    mutable std::mutex _lock;
+    std::vector<Field> _fields;
+    fastos::TimeStamp  _startTime;
+    fastos::TimeStamp  _endTime;
+    uint32_t           _numThreads;
+    size_t             _memoryBudget;
+    bool               _done;
+
+public:
+    typedef std::shared_ptr<FusionProgress> SP;
+
+    FusionProgress();
+    ~FusionProgress();
+
+    void start(uint32_t numThreads, size_t memoryBudget);
+    void finish();
+
+    /**
+     * Register a field to be merged, returns the id used when updating it.
+     */
+    uint32_t addField(const vespalib::string &name, size_t memoryEstimate);
+    void startField(uint32_t fieldId);
+    void finishField(uint32_t fieldId, uint64_t numWordIds, bool ok);
+
+    /**
+     * Snapshot of all fields, in the order they were added.
+     */
+    std::vector<Field> getFields() const;
+    uint32_t getNumFields() const;
+    uint32_t getNumDoneFields() const;
+    int64_t getElapsedMs() const;
+    uint32_t getNumThreads() const;
+    size_t getMemoryBudget() const;
+    bool isDone() const;
+
+    static const char *toString(State state);
+};
+
+}
@@ -292,7 +292,7 @@ FileHandle::open(const vespalib::stringref &dir,
 
     _fieldWriter = new FieldWriter(docIdLimit, numWordIds);
 
-    if (!_fieldWriter->open(dir + "/", 64, 262144u, false,
+    if (!_fieldWriter->open(dir + "/", 64, 262144u, false, false,
                             index.getSchema(), index.getIndex(),
                             tuneFileWrite, fileHeaderContext)) {
         LOG(error, "Could not open term writer %s for write (%s)",
@@ -5,6 +5,7 @@
 #include <vespa/vespalib/data/fileheader.h>
 #include <vespa/searchlib/queryeval/emptysearch.h>
 #include <vespa/fastos/file.h>
+#include <algorithm>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.zcposoccrandread");
@@ -26,6 +27,31 @@ namespace {
 vespalib::string myId4("Zc.4");
 vespalib::string myId5("Zc.5");
 
+/*
+ * Decode max weight from start of word or chunk header.
+ */
+int32_t
+decodeMaxWeight(const uint64_t *mem, int bitOffset, uint32_t minChunkDocs)
+{
+    typedef EGPosOccEncodeContext<true> EC;
+    FeatureDecodeContext<true> d(mem, bitOffset);
+
+    UC64_DECODECONTEXT_CONSTRUCTOR(o, d._);
+    uint32_t length;
+    uint64_t val64;
+
+    UC64BE_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_NUMDOCS, EC);
+    uint32_t numDocs = static_cast<uint32_t>(val64) + 1;
+    if (numDocs >= minChunkDocs) {
+        // Skip hasMore flag
+        oVal <<= 1;
+        length = 1;
+        UC64BE_READBITS_NS(o, EC);
+    }
+    UC64BE_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_MAXWEIGHT, EC);
+    return FeatureDecodeContext<true>::convertToSigned(val64);
+}
+
 }
 
 namespace search {
@@ -44,7 +70,8 @@ ZcPosOccRandRead::ZcPosOccRandRead()
       _fileBitSize(0),
       _headerBitSize(0),
       _fieldsParams(),
-      _dynamicK(true)
+      _dynamicK(true),
+      _blockMaxWeights(false)
 { }
 
 
@@ -97,11 +124,31 @@ createIterator(const PostingListCounts &counts,
 
     uint32_t numDocs = static_cast<uint32_t>(val64) + 1;
 
+    ZcIteratorBase *iterator;
     if (numDocs < _minSkipDocs) {
-        return new ZcRareWordPosOccIterator<true>(start, handle._bitLength, _docIdLimit, &_fieldsParams, matchData);
+        iterator = new ZcRareWordPosOccIterator<true>(start, handle._bitLength, _docIdLimit, &_fieldsParams, matchData);
     } else {
-        return new ZcPosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+        iterator = new ZcPosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+    }
+    if (_blockMaxWeights) {
+        iterator->enableBlockMaxWeights(readMaxWeight(mem, bitOffset, counts));
     }
+    return iterator;
+}
+
+
+int32_t
+ZcPosOccRandRead::readMaxWeight(const uint64_t *mem, int bitOffset, const PostingListCounts &counts) const
+{
+    int32_t maxWeight = decodeMaxWeight(mem, bitOffset, _minChunkDocs);
+    // Each chunk header holds the max weight for that chunk
+    uint64_t chunkBitOffset = bitOffset;
+    for (size_t i = 1; i < counts._segments.size(); ++i) {
+        chunkBitOffset += counts._segments[i - 1]._bitLength;
+        maxWeight = std::max(maxWeight,
+                             decodeMaxWeight(mem + (chunkBitOffset >> 6), chunkBitOffset & 63, _minChunkDocs));
+    }
+    return maxWeight;
 }
 
 
@@ -231,6 +278,8 @@ ZcPosOccRandRead::readHeader()
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
     _docIdLimit = header.getTag("docIdLimit").asInteger();
     _minSkipDocs = header.getTag("minSkipDocs").asInteger();
+    _blockMaxWeights = header.hasTag("blockMaxWeights") &&
+                       header.getTag("blockMaxWeights").asInteger() != 0;
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
@@ -302,11 +351,16 @@ createIterator(const PostingListCounts &counts,
 
     uint32_t numDocs = static_cast<uint32_t>(val64) + 1;
 
+    ZcIteratorBase *iterator;
     if (numDocs < _minSkipDocs) {
-        return new Zc4RareWordPosOccIterator<true>(start, handle._bitLength, _docIdLimit, &_fieldsParams, matchData);
+        iterator = new Zc4RareWordPosOccIterator<true>(start, handle._bitLength, _docIdLimit, &_fieldsParams, matchData);
     } else {
-        return new Zc4PosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+        iterator = new Zc4PosOccIterator<true>(start, handle._bitLength, _docIdLimit, _minChunkDocs, counts, &_fieldsParams, matchData);
+    }
+    if (_blockMaxWeights) {
+        iterator->enableBlockMaxWeights(readMaxWeight(mem, bitOffset, counts));
     }
+    return iterator;
 }
 
 void
@@ -342,6 +396,8 @@ Zc4PosOccRandRead::readHeader()
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
     _docIdLimit = header.getTag("docIdLimit").asInteger();
     _minSkipDocs = header.getTag("minSkipDocs").asInteger();
+    _blockMaxWeights = header.hasTag("blockMaxWeights") &&
+                       header.getTag("blockMaxWeights").asInteger() != 0;
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
     // Align on 64-bit unit
@@ -26,7 +26,13 @@ protected:
     uint64_t _headerBitSize;
     bitcompression::PosOccFieldsParams _fieldsParams;
     bool _dynamicK;
+    bool _blockMaxWeights;  // Max weights stored in word headers and L1 skip info ?
 
+    /**
+     * Read max weight for word, scanning all chunk headers for
+     * chunked posting lists.
+     */
+    int32_t readMaxWeight(const uint64_t *mem, int bitOffset, const index::PostingListCounts &counts) const;
 
 public:
     ZcPosOccRandRead();
@@ -7,6 +7,8 @@
 #include <vespa/searchlib/index/docidandfeatures.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <algorithm>
+#include <limits>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".diskindex.zcposting");
@@ -44,6 +46,8 @@ Zc4PostingSeqRead(PostingListCountFileSeqRead *countFile)
       _minChunkDocs(1 << 30),
       _minSkipDocs(64),
       _docIdLimit(10000000),
+      _blockMaxWeights(false),
+      _maxWeight(0),
       _zcDocIds(),
       _l1Skip(),
       _l2Skip(),
@@ -55,6 +59,7 @@ Zc4PostingSeqRead(PostingListCountFileSeqRead *countFile)
       _l1SkipDocId(0),
       _l1SkipDocIdPos(0),
       _l1SkipFeaturesPos(0),
+      _l1SkipMaxWeight(0),
       _l2SkipDocId(0),
       _l2SkipDocIdPos(0),
       _l2SkipL1SkipPos(0),
@@ -161,6 +166,7 @@ readCommonWordDocIdAndFeatures(DocIdAndFeatures &features)
         assert(_l1SkipDocId <= _l3SkipDocId);
         assert(_l1SkipDocId <= _l2SkipDocId);
         assert(_l1SkipDocId >= docId);
+        decodeL1SkipMaxWeight();
     }
     if (docId < _lastDocId) {
         // Assert more space available when not yet at last docid
@@ -178,6 +184,7 @@ readCommonWordDocIdAndFeatures(DocIdAndFeatures &features)
         }
     }
     _decodeContext->readFeatures(features);
+    assert(!_blockMaxWeights || Zc4PostingSeqWrite::calcMaxWeight(features) <= _l1SkipMaxWeight);
     --_residue;
 }
 
@@ -246,6 +253,12 @@ Zc4PostingSeqRead::readWordStartWithSkip()
         length = 1;
         UC64BE_READBITS_NS(o, EC);
     }
+    if (_blockMaxWeights) {
+        UC64BE_DECODEEXPGOLOMB_NS(o,
+                                  K_VALUE_ZCPOSTING_MAXWEIGHT,
+                                  EC);
+        _maxWeight = DecodeContext::convertToSigned(val64);
+    }
     if (_dynamicK)
         _docIdK = EC::calcDocIdK((_hasMore || hasMore) ? 1 : _numDocs,
                                  _docIdLimit);
@@ -373,10 +386,13 @@ Zc4PostingSeqRead::readWordStartWithSkip()
         _decodeContext->readBytes(_l4Skip._valI, l4SkipSize);
     _l4Skip._valE = _l4Skip._valI + l4SkipSize;
 
-    if (l1SkipSize > 0)
+    if (l1SkipSize > 0) {
         _l1SkipDocId = _l1Skip.decode() + 1 + _prevDocId;
-    else
+        decodeL1SkipMaxWeight();
+    } else {
         _l1SkipDocId = _lastDocId;
+        _l1SkipMaxWeight = _maxWeight;
+    }
     if (l2SkipSize > 0)
         _l2SkipDocId = _l2Skip.decode() + 1 + _prevDocId;
     else
@@ -437,6 +453,9 @@ Zc4PostingSeqRead::readWordStart()
         readWordStartWithSkip();
         // Decode context is not positioned at start of features
     } else {
+        if (_blockMaxWeights) {
+            readWordMaxWeight();
+        }
         if (_dynamicK)
             _docIdK = EC::calcDocIdK(_numDocs, _docIdLimit);
         _lastDocId = 0u;
@@ -445,6 +464,35 @@ Zc4PostingSeqRead::readWordStart()
 }
 
 
+void
+Zc4PostingSeqRead::readWordMaxWeight()
+{
+    typedef FeatureEncodeContextBE EC;
+    UC64_DECODECONTEXT_CONSTRUCTOR(o, _decodeContext->_);
+    uint32_t length;
+    uint64_t val64;
+    const uint64_t *valE = _decodeContext->_valE;
+
+    UC64BE_DECODEEXPGOLOMB_NS(o,
+                              K_VALUE_ZCPOSTING_MAXWEIGHT,
+                              EC);
+    UC64_DECODECONTEXT_STORE(o, _decodeContext->_);
+    if (oCompr >= valE)
+        _readContext.readComprBuffer();
+    _maxWeight = DecodeContext::convertToSigned(val64);
+}
+
+
+void
+Zc4PostingSeqRead::decodeL1SkipMaxWeight()
+{
+    if (_blockMaxWeights) {
+        _l1SkipMaxWeight = DecodeContext::convertToSigned(_l1Skip.decode());
+        assert(_l1SkipMaxWeight <= _maxWeight);
+    }
+}
+
+
 void
 Zc4PostingSeqRead::readCounts(const PostingListCounts &counts)
 {
@@ -516,6 +564,7 @@ Zc4PostingSeqRead::getParams(PostingListParams &params)
         params.set("minChunkDocs", _minChunkDocs);
     }
     params.set("minSkipDocs", _minSkipDocs);
+    params.set("blockMaxWeights", _blockMaxWeights);
 }
 
 
@@ -530,7 +579,7 @@ void
 Zc4PostingSeqRead::readHeader()
 {
     FeatureDecodeContextBE &d = *_decodeContext;
-    const vespalib::string &myId = _dynamicK ? myId5 : myId4;
+    const vespalib::string &myId = getFormatIdentifier();
 
     vespalib::FileHeader header;
     d.readHeader(header, _file.getSize());
@@ -558,6 +607,8 @@ Zc4PostingSeqRead::readHeader()
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
     _docIdLimit = header.getTag("docIdLimit").asInteger();
     _minSkipDocs = header.getTag("minSkipDocs").asInteger();
+    _blockMaxWeights = header.hasTag("blockMaxWeights") &&
+                       header.getTag("blockMaxWeights").asInteger() != 0;
     assert(header.getTag("endian").asString() == "big");
     // Read feature decoding specific subheader
     d.readHeader(header, "features.");
@@ -575,6 +626,13 @@ Zc4PostingSeqRead::getIdentifier()
 }
 
 
+const vespalib::string &
+Zc4PostingSeqRead::getFormatIdentifier() const
+{
+    return _dynamicK ? myId5 : myId4;
+}
+
+
 uint64_t
 Zc4PostingSeqRead::getCurrentPostingOffset() const
 {
@@ -613,7 +671,9 @@ Zc4PostingSeqWrite(PostingListCountFileSeqWrite *countFile)
       _minChunkDocs(1 << 30),
       _minSkipDocs(64),
       _docIdLimit(10000000),
+      _blockMaxWeights(false),
       _docIds(),
+      _docMaxWeights(),
       _encodeFeatures(NULL),
       _featureOffset(0),
       _featureWriteContext(sizeof(uint64_t)),
@@ -657,6 +717,9 @@ writeDocIdAndFeatures(const DocIdAndFeatures &features)
     assert(static_cast<uint32_t>(featureSize) == featureSize);
     _docIds.push_back(std::make_pair(features._docId,
                                      static_cast<uint32_t>(featureSize)));
+    if (_blockMaxWeights) {
+        _docMaxWeights.push_back(calcMaxWeight(features));
+    }
     _featureOffset = writeOffset;
 }
 
@@ -690,7 +753,7 @@ Zc4PostingSeqWrite::readHeader(const vespalib::string &name)
     FeatureDecodeContextBE d;
     ComprFileReadContext drc(d);
     FastOS_File file;
-    const vespalib::string &myId = _dynamicK ? myId5 : myId4;
+    const vespalib::string &myId = getFormatIdentifier();
 
     d.setReadContext(&drc);
     bool res = file.OpenReadOnly(name.c_str());
@@ -731,6 +794,8 @@ Zc4PostingSeqWrite::readHeader(const vespalib::string &name)
     _minChunkDocs = header.getTag("minChunkDocs").asInteger();
     _docIdLimit = header.getTag("docIdLimit").asInteger();
     _minSkipDocs = header.getTag("minSkipDocs").asInteger();
+    _blockMaxWeights = header.hasTag("blockMaxWeights") &&
+                       header.getTag("blockMaxWeights").asInteger() != 0;
     assert(header.getTag("endian").asString() == "big");
     // Read feature decoding specific subheader using helper decode context
     f.readHeader(header, "features.");
@@ -742,6 +807,13 @@ Zc4PostingSeqWrite::readHeader(const vespalib::string &name)
 }
 
 
+const vespalib::string &
+Zc4PostingSeqWrite::getFormatIdentifier() const
+{
+    return _dynamicK ? myId5 : myId4;
+}
+
+
 void
 Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
 {
@@ -749,7 +821,7 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     EncodeContext &e = _encodeContext;
     ComprFileWriteContext &wce = _writeContext;
 
-    const vespalib::string &myId = _dynamicK ? myId5 : myId4;
+    const vespalib::string &myId = getFormatIdentifier();
     vespalib::FileHeader header;
 
     typedef vespalib::GenericHeader::Tag Tag;
@@ -762,6 +834,7 @@ Zc4PostingSeqWrite::makeHeader(const FileHeaderContext &fileHeaderContext)
     header.putTag(Tag("minChunkDocs", _minChunkDocs));
     header.putTag(Tag("docIdLimit", _docIdLimit));
     header.putTag(Tag("minSkipDocs", _minSkipDocs));
+    header.putTag(Tag("blockMaxWeights", _blockMaxWeights ? 1 : 0));
     header.putTag(Tag("endian", "big"));
     header.putTag(Tag("desc", "Posting list file"));
 
@@ -890,6 +963,7 @@ setParams(const PostingListParams &params)
     params.get("docIdLimit", _docIdLimit);
     params.get("minChunkDocs", _minChunkDocs);
     params.get("minSkipDocs", _minSkipDocs);
+    params.get("blockMaxWeights", _blockMaxWeights);
 }
 
 
@@ -913,6 +987,7 @@ getParams(PostingListParams &params)
         params.set("minChunkDocs", _minChunkDocs);
     }
     params.set("minSkipDocs", _minSkipDocs);
+    params.set("blockMaxWeights", _blockMaxWeights);
 }
 
 
@@ -972,6 +1047,8 @@ Zc4PostingSeqWrite::calcSkipInfo()
     unsigned int l3SkipCnt = 0;
     unsigned int l4SkipCnt = 0;
     uint64_t featurePos = 0;
+    int32_t l1SkipMaxWeight = std::numeric_limits<int32_t>::min();
+    std::vector<int32_t>::const_iterator wit = _docMaxWeights.begin();
 
     std::vector<DocIdAndFeatureSize>::const_iterator dit = _docIds.begin();
     std::vector<DocIdAndFeatureSize>::const_iterator dite = _docIds.end();
@@ -991,6 +1068,11 @@ Zc4PostingSeqWrite::calcSkipInfo()
             assert(static_cast<int32_t>(docIdDelta) > 0);
             _l1Skip.encode(docIdDelta - 1);
             lastL1SkipDocId = lastDocId;
+            // L1 max weight
+            if (_blockMaxWeights) {
+                _l1Skip.encode(static_cast<uint32_t>(EncodeContext::convertToUnsigned(l1SkipMaxWeight)));
+                l1SkipMaxWeight = std::numeric_limits<int32_t>::min();
+            }
             // L1 docid pos
             uint64_t docIdPos = _zcDocIds.size();
             _l1Skip.encode(docIdPos - lastL1SkipDocIdPos - 1);
@@ -1076,11 +1158,19 @@ Zc4PostingSeqWrite::calcSkipInfo()
         featurePos += dit->second;
         _zcDocIds.encode(docId - lastDocId - 1);
         lastDocId = docId;
+        if (_blockMaxWeights) {
+            l1SkipMaxWeight = std::max(l1SkipMaxWeight, *wit);
+            ++wit;
+        }
         ++l1SkipCnt;
     }
     // Extra partial entries for skip tables to simplify iterator during search
-    if (_l1Skip.size() > 0)
+    if (_l1Skip.size() > 0) {
         _l1Skip.encode(lastDocId - lastL1SkipDocId - 1);
+        if (_blockMaxWeights) {
+            _l1Skip.encode(static_cast<uint32_t>(EncodeContext::convertToUnsigned(l1SkipMaxWeight)));
+        }
+    }
     if (_l2Skip.size() > 0)
         _l2Skip.encode(lastDocId - lastL2SkipDocId - 1);
     if (_l3Skip.size() > 0)
@@ -1103,6 +1193,7 @@ Zc4PostingSeqWrite::flushWordWithSkip(bool hasMore)
     e.encodeExpGolomb(numDocs - 1, K_VALUE_ZCPOSTING_NUMDOCS);
     if (numDocs >= _minChunkDocs)
         e.writeBits((hasMore ? 1 : 0), 1);
+    writeMaxWeight();
 
     // TODO: Calculate docids size, possible also k parameter  */
     calcSkipInfo();
@@ -1206,6 +1297,7 @@ Zc4PostingSeqWrite::flushWordNoSkip()
     uint32_t numDocs = _docIds.size();
 
     e.encodeExpGolomb(numDocs - 1, K_VALUE_ZCPOSTING_NUMDOCS);
+    writeMaxWeight();
 
     uint32_t baseDocId = 1;
     const uint64_t *features =
@@ -1230,10 +1322,36 @@ Zc4PostingSeqWrite::flushWordNoSkip()
 }
 
 
+void
+Zc4PostingSeqWrite::writeMaxWeight()
+{
+    if (_blockMaxWeights) {
+        int32_t maxWeight = *std::max_element(_docMaxWeights.begin(), _docMaxWeights.end());
+        _encodeContext.encodeExpGolomb(EncodeContext::convertToUnsigned(maxWeight),
+                                       K_VALUE_ZCPOSTING_MAXWEIGHT);
+    }
+}
+
+
+int32_t
+Zc4PostingSeqWrite::calcMaxWeight(const DocIdAndFeatures &features)
+{
+    if (features._elements.empty()) {
+        return 1;
+    }
+    int32_t maxWeight = std::numeric_limits<int32_t>::min();
+    for (const auto &element : features._elements) {
+        maxWeight = std::max(maxWeight, element._weight);
+    }
+    return maxWeight;
+}
+
+
 void
 Zc4PostingSeqWrite::resetWord()
 {
     _docIds.clear();
+    _docMaxWeights.clear();
     _encodeFeatures->setupWrite(_featureWriteContext);
     _featureOffset = 0;
 }
@@ -1315,6 +1433,7 @@ ZcPostingSeqWrite::flushWordNoSkip()
     uint32_t numDocs = _docIds.size();
 
     e.encodeExpGolomb(numDocs - 1, K_VALUE_ZCPOSTING_NUMDOCS);
+    writeMaxWeight();
 
     uint32_t docIdK = e.calcDocIdK(numDocs, _docIdLimit);
 
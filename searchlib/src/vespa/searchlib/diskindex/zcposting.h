@@ -39,6 +39,8 @@ protected:
     uint32_t _minChunkDocs; // # of documents needed for chunking
     uint32_t _minSkipDocs;  // # of documents needed for skipping
     uint32_t _docIdLimit;   // Limit for document ids (docId < docIdLimit)
+    bool _blockMaxWeights;  // Max weights stored in word headers and L1 skip info ?
+    int32_t _maxWeight;     // Max weight in chunk or word
 
     ZcBuf _zcDocIds;    // Document id deltas
     ZcBuf _l1Skip;      // L1 skip info
@@ -54,6 +56,7 @@ protected:
     uint32_t _l1SkipDocId;
     uint32_t _l1SkipDocIdPos;
     uint64_t _l1SkipFeaturesPos;
+    int32_t _l1SkipMaxWeight;
     uint32_t _l2SkipDocId;
     uint32_t _l2SkipDocIdPos;
     uint32_t _l2SkipL1SkipPos;
@@ -101,9 +104,16 @@ public:
     void getFeatureParams(PostingListParams &params) override;
     void readWordStartWithSkip();
     void readWordStart();
+    void readWordMaxWeight();
+    void decodeL1SkipMaxWeight();
     void readHeader();
     static const vespalib::string &getIdentifier();
 
+    /**
+     * Identifier stored as format.0 in the file header.
+     */
+    virtual const vespalib::string &getFormatIdentifier() const;
+
     // Methods used when generating posting list for common word pairs.
 
     /*
@@ -141,9 +151,12 @@ protected:
     uint32_t _minChunkDocs; // # of documents needed for chunking
     uint32_t _minSkipDocs;  // # of documents needed for skipping
     uint32_t _docIdLimit;   // Limit for document ids (docId < docIdLimit)
+    bool _blockMaxWeights;  // Store max weights in word headers and L1 skip info ?
     // Unpacked document ids for word and feature sizes
     typedef std::pair<uint32_t, uint32_t> DocIdAndFeatureSize;
     std::vector<DocIdAndFeatureSize> _docIds;
+    // Max element weight for each document in _docIds
+    std::vector<int32_t> _docMaxWeights;
 
     // Buffer up features in memory
     EncodeContext *_encodeFeatures;
@@ -191,6 +204,11 @@ public:
      */
     void flushWordWithSkip(bool hasMore);
 
+    /**
+     * Write max weight for chunk or word, if enabled.
+     */
+    void writeMaxWeight();
+
 
     /**
      * Flush word without skip info to disk.
@@ -202,6 +220,12 @@ public:
      */
     void resetWord();
 
+    /*
+     * Max element weight for document, used as upper bound for the weight
+     * exposed through match data when the document matches the word.
+     */
+    static int32_t calcMaxWeight(const DocIdAndFeatures &features);
+
     /**
      * Make header using feature encode write context.
      */
@@ -212,6 +236,11 @@ public:
      * Read header, using temporary feature decode context.
      */
     uint32_t readHeader(const vespalib::string &name);
+
+    /**
+     * Identifier stored as format.0 in the file header.
+     */
+    virtual const vespalib::string &getFormatIdentifier() const;
 };
 
 
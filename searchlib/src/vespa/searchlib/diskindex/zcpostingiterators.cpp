@@ -3,6 +3,7 @@
 #include "zcpostingiterators.h"
 #include <vespa/searchlib/fef/termfieldmatchdataarray.h>
 #include <vespa/searchlib/bitcompression/posocccompression.h>
+#include <limits>
 
 namespace search {
 
@@ -18,10 +19,19 @@ using queryeval::RankedSearchIteratorBase;
 
 ZcIteratorBase::ZcIteratorBase(const TermFieldMatchDataArray &matchData, Position start, uint32_t docIdLimit) :
     RankedSearchIteratorBase(matchData),
+    _blockMaxInfo(),
     _docIdLimit(docIdLimit),
     _start(start)
 { }
 
+void
+ZcIteratorBase::enableBlockMaxWeights(int32_t maxWeight)
+{
+    // Min weight is not stored in posting list
+    _blockMaxInfo = std::make_unique<queryeval::BlockMaxPostingInfo>(std::numeric_limits<int32_t>::min(), maxWeight,
+                                                                     search::endDocId);
+}
+
 void
 ZcIteratorBase::initRange(uint32_t beginid, uint32_t endid)
 {
@@ -120,6 +130,10 @@ Zc4RareWordPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_NUMDOCS, EC);
 
     _numDocs = static_cast<uint32_t>(val64) + 1;
+    if (hasBlockMaxWeights()) {
+        // Word max weight already decoded when creating iterator
+        UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_MAXWEIGHT, EC);
+    }
     UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_DELTA_DOCID, EC);
     uint32_t docId = static_cast<uint32_t>(val64) + 1;
     UC64_DECODECONTEXT_STORE(o, _decodeContext->_);
@@ -194,6 +208,10 @@ ZcRareWordPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
 
     UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_NUMDOCS, EC);
     _numDocs = static_cast<uint32_t>(val64) + 1;
+    if (this->hasBlockMaxWeights()) {
+        // Word max weight already decoded when creating iterator
+        UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_MAXWEIGHT, EC);
+    }
     _docIdK = EC::calcDocIdK(_numDocs, docIdLimit);
     UC64_DECODEEXPGOLOMB_NS(o, _docIdK, EC);
     uint32_t docId = static_cast<uint32_t>(val64) + 1;
@@ -266,6 +284,11 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
         }
         UC64_READBITS_NS(o, EC);
     }
+    int32_t chunkMaxWeight = 0;
+    if (hasBlockMaxWeights()) {
+        UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_MAXWEIGHT, EC);
+        chunkMaxWeight = DecodeContextBase::convertToSigned(val64);
+    }
     if (_dynamicK)
         _docIdK = EC::calcDocIdK((_hasMore || hasMore) ? 1 : _numDocs, docIdLimit);
     UC64_DECODEEXPGOLOMB_NS(o, K_VALUE_ZCPOSTING_DOCIDSSIZE, EC);
@@ -320,6 +343,13 @@ ZcPostingIterator<bigEndian>::readWordStart(uint32_t docIdLimit)
     _l2.postSetup(_l1);
     _l3.postSetup(_l2);
     _l4.postSetup(_l3);
+    if (hasBlockMaxWeights()) {
+        if (l1SkipSize != 0) {
+            decodeL1SkipMaxWeight();
+        } else {
+            _blockMaxInfo->setBlock(_chunk._lastDocId, chunkMaxWeight);
+        }
+    }
     d.setByteCompr(bcompr);
     _hasMore = hasMore;
     // Save information about start of next chunk
@@ -386,7 +416,7 @@ ZcPostingIteratorBase::doL4SkipSeek(uint32_t docId)
     _l2._valI = _l3._l2Pos = _l4._l2Pos;
     _l3._valI = _l4._l3Pos;
     nextDocId(lastL4SkipDocId);
-    _l1.nextDocId();
+    nextL1SkipDocId();
     _l2.nextDocId();
     _l3.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
@@ -434,7 +464,7 @@ ZcPostingIteratorBase::doL3SkipSeek(uint32_t docId)
     _l1._valI = _l2._l1Pos = _l3._l1Pos;
     _l2._valI = _l3._l2Pos;
     nextDocId(lastL3SkipDocId);
-    _l1.nextDocId();
+    nextL1SkipDocId();
     _l2.nextDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L3Seek, docId %d docIdPos %d"
@@ -477,7 +507,7 @@ ZcPostingIteratorBase::doL2SkipSeek(uint32_t docId)
     _l1._skipDocId = lastL2SkipDocId;
     _l1._valI = _l2._l1Pos;
     nextDocId(lastL2SkipDocId);
-    _l1.nextDocId();
+    nextL1SkipDocId();
 #if DEBUG_ZCPOSTING_PRINTF
     printf("L2Seek, docId %d docIdPos %d L1SkipPos %d, nextDocId %d\n",
            lastL2SkipDocId,
@@ -502,7 +532,7 @@ ZcPostingIteratorBase::doL1SkipSeek(uint32_t docId)
     do {
         lastL1SkipDocId = _l1._skipDocId;
         _l1.decodeSkipEntry();
-        _l1.nextDocId();
+        nextL1SkipDocId();
 #if DEBUG_ZCPOSTING_PRINTF
         printf("L1Decode docId %d, docIdPos %d, L1SkipPos %d, nextDocId %d\n",
                lastL1SkipDocId,
@@ -5,6 +5,7 @@
 #include <vespa/searchlib/index/postinglistfile.h>
 #include <vespa/searchlib/bitcompression/compression.h>
 #include <vespa/searchlib/queryeval/iterators.h>
+#include <vespa/searchlib/queryeval/posting_info.h>
 #include <vespa/fastos/dynamiclibrary.h>
 
 namespace search {
@@ -52,9 +53,20 @@ protected:
     void initRange(uint32_t beginid, uint32_t endid) override;
     uint32_t getDocIdLimit() const { return _docIdLimit; }
     Trinary is_strict() const override { return Trinary::True; }
+    bool hasBlockMaxWeights() const { return static_cast<bool>(_blockMaxInfo); }
+    std::unique_ptr<queryeval::BlockMaxPostingInfo> _blockMaxInfo;
 private:
     uint32_t   _docIdLimit;
     Position   _start;
+public:
+    /**
+     * Use the max weights stored in the posting list, exposing them as
+     * posting info. Must be called before the iterator is used. The max
+     * weight for the whole word is decoded by the caller when creating
+     * the iterator.
+     */
+    void enableBlockMaxWeights(int32_t maxWeight);
+    const queryeval::PostingInfo *getPostingInfo() const override { return _blockMaxInfo.get(); }
 };
 
 template <bool bigEndian>
@@ -248,6 +260,17 @@ protected:
         ZCDECODE(_valI, docId +=);
         setDocId(docId);
     }
+    void decodeL1SkipMaxWeight() {
+        uint32_t maxWeight;
+        ZCDECODE(_l1._valI, maxWeight =);
+        _blockMaxInfo->setBlock(_l1._skipDocId, bitcompression::DecodeContext64Base::convertToSigned(maxWeight));
+    }
+    void nextL1SkipDocId() {
+        _l1.nextDocId();
+        if (hasBlockMaxWeights()) {
+            decodeL1SkipMaxWeight();
+        }
+    }
     virtual void featureSeek(uint64_t offset) = 0;
     VESPA_DLL_LOCAL void doChunkSkipSeek(uint32_t docId);
     VESPA_DLL_LOCAL void doL4SkipSeek(uint32_t docId);
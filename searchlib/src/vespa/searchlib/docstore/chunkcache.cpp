@@ -0,0 +1,200 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "chunkcache.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+namespace search::docstore {
+
+namespace {
+
+constexpr size_t MIN_SKETCH_ENTRIES = 1024;
+// Typical size of a compressed chunk, used to size the frequency sketch.
+constexpr size_t ESTIMATED_CHUNK_SIZE = 0x4000;
+constexpr size_t ENTRY_OVERHEAD = 64;
+
+uint64_t
+mix(uint64_t h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdul;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ul;
+    h ^= h >> 33;
+    return h;
+}
+
+size_t
+roundUp2inN(size_t v)
+{
+    size_t n = 1;
+    while (n < v) {
+        n <<= 1;
+    }
+    return n;
+}
+
+}
+
+FrequencySketch::FrequencySketch(size_t expectedEntries)
+    : _counters(),
+      _mask(0),
+      _additions(0),
+      _sampleSize(0)
+{
+    size_t width = roundUp2inN(std::max(expectedEntries, MIN_SKETCH_ENTRIES));
+    _counters.resize(width * NUM_ROWS, 0);
+    _mask = width - 1;
+    _sampleSize = width * 10;
+}
+
+FrequencySketch::~FrequencySketch() = default;
+
+size_t
+FrequencySketch::index(uint64_t hash, uint32_t row) const
+{
+    // Derive the row hashes from two halves of one good hash (Kirsch-Mitzenmacher).
+    uint64_t h = (hash & 0xffffffffu) + row * (hash >> 32);
+    return row * (_mask + 1) + (h & _mask);
+}
+
+void
+FrequencySketch::record(uint64_t hash)
+{
+    uint32_t minCount = estimate(hash);
+    if (minCount >= MAX_COUNT) {
+        return;
+    }
+    // Conservative update, only the smallest counters are incremented.
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        uint8_t & counter = _counters[index(hash, row)];
+        if (counter == minCount) {
+            ++counter;
+        }
+    }
+    if (++_additions >= _sampleSize) {
+        age();
+    }
+}
+
+uint32_t
+FrequencySketch::estimate(uint64_t hash) const
+{
+    uint32_t minCount = MAX_COUNT;
+    for (uint32_t row = 0; row < NUM_ROWS; ++row) {
+        minCount = std::min(minCount, uint32_t(_counters[index(hash, row)]));
+    }
+    return minCount;
+}
+
+void
+FrequencySketch::age()
+{
+    for (uint8_t & counter : _counters) {
+        counter >>= 1;
+    }
+    _additions /= 2;
+}
+
+uint64_t
+ChunkCache::Key::hash() const
+{
+    return mix(_fileKey ^ mix(_chunkId));
+}
+
+size_t
+ChunkCache::Entry::memoryUsed() const
+{
+    return _blob->getDataLen() + ENTRY_OVERHEAD;
+}
+
+size_t
+ChunkCache::expectedEntries(size_t maxBytes)
+{
+    return maxBytes / ESTIMATED_CHUNK_SIZE;
+}
+
+ChunkCache::ChunkCache(size_t maxBytes)
+    : _lock(),
+      _maxBytes(maxBytes),
+      _usedBytes(0),
+      _lru(),
+      _entries(),
+      _sketch(expectedEntries(maxBytes)),
+      _hits(0),
+      _misses(0)
+{ }
+
+ChunkCache::~ChunkCache() = default;
+
+ChunkCache::Blob
+ChunkCache::get(uint64_t fileKey, uint32_t chunkId)
+{
+    Key key(fileKey, chunkId);
+    Guard guard(_lock);
+    _sketch.record(key.hash());
+    auto found = _entries.find(key);
+    if (found == _entries.end()) {
+        _misses++;
+        return Blob();
+    }
+    _hits++;
+    _lru.splice(_lru.begin(), _lru, found->second);
+    return found->second->_blob;
+}
+
+void
+ChunkCache::put(uint64_t fileKey, uint32_t chunkId, Blob blob)
+{
+    Key key(fileKey, chunkId);
+    Entry candidate(key, std::move(blob));
+    size_t needed = candidate.memoryUsed();
+    Guard guard(_lock);
+    size_t maxBytes = _maxBytes.load(std::memory_order_relaxed);
+    if ((needed > maxBytes) || (_entries.find(key) != _entries.end())) {
+        return;
+    }
+    // Admit only if the candidate is more popular than every entry it would push out.
+    uint32_t candidateFreq = _sketch.estimate(key.hash());
+    size_t freed = 0;
+    for (auto it = _lru.rbegin(); (_usedBytes + needed - freed > maxBytes) && (it != _lru.rend()); ++it) {
+        if (_sketch.estimate(it->_key.hash()) >= candidateFreq) {
+            return;
+        }
+        freed += it->memoryUsed();
+    }
+    evictToFit(guard, maxBytes - needed);
+    _lru.push_front(std::move(candidate));
+    _entries[key] = _lru.begin();
+    _usedBytes += needed;
+}
+
+void
+ChunkCache::evictToFit(const Guard &, size_t maxBytes)
+{
+    while ((_usedBytes > maxBytes) && ! _lru.empty()) {
+        _usedBytes -= _lru.back().memoryUsed();
+        _entries.erase(_lru.back()._key);
+        _lru.pop_back();
+    }
+}
+
+void
+ChunkCache::setCapacity(size_t maxBytes)
+{
+    Guard guard(_lock);
+    if (expectedEntries(maxBytes) > _sketch.getSampleSize() / 10) {
+        _sketch = FrequencySketch(expectedEntries(maxBytes));
+    }
+    _maxBytes.store(maxBytes, std::memory_order_relaxed);
+    evictToFit(guard, maxBytes);
+}
+
+CacheStats
+ChunkCache::getCacheStats() const
+{
+    Guard guard(_lock);
+    return CacheStats(_hits, _misses, _entries.size(), _usedBytes);
+}
+
+}
@@ -0,0 +1,103 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "cachestats.h"
+#include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace search::docstore {
+
+/**
+ * Approximate access frequency of keys, used for cache admission (TinyLFU).
+ * It is a count-min sketch with 4 rows of small saturating counters.
+ * All counters are halved when the number of recorded accesses reaches the
+ * sample size, so that past popularity fades away.
+ **/
+class FrequencySketch {
+public:
+    explicit FrequencySketch(size_t expectedEntries);
+    ~FrequencySketch();
+    void record(uint64_t hash);
+    uint32_t estimate(uint64_t hash) const;
+    size_t getSampleSize() const { return _sampleSize; }
+private:
+    static constexpr uint32_t NUM_ROWS = 4;
+    static constexpr uint8_t MAX_COUNT = 15;
+    size_t index(uint64_t hash, uint32_t row) const;
+    void age();
+
+    std::vector<uint8_t> _counters;
+    size_t               _mask;
+    size_t               _additions;
+    size_t               _sampleSize;
+};
+
+/**
+ * Memory bounded cache of chunks exactly as stored on disk, that is still
+ * compressed. Entries are keyed by the file they belong to and the chunk id
+ * within that file. Eviction is LRU, but a new chunk is only admitted if it
+ * is estimated to be accessed more often than the entries it would evict.
+ * This keeps one-off reads, like a full visit, from flushing the hot set.
+ *
+ * The file key must never be reused for different content, as entries are
+ * not invalidated when a file is removed. They will just age out.
+ **/
+class ChunkCache {
+public:
+    using Blob = std::shared_ptr<const vespalib::DataBuffer>;
+
+    explicit ChunkCache(size_t maxBytes);
+    ~ChunkCache();
+
+    bool enabled() const { return _maxBytes.load(std::memory_order_relaxed) > 0; }
+    /**
+     * Look up a chunk, returns an empty blob on miss. Every lookup counts
+     * towards the access frequency used for admission.
+     **/
+    Blob get(uint64_t fileKey, uint32_t chunkId);
+    /**
+     * Offer a chunk read from disk after a miss. It might be rejected.
+     **/
+    void put(uint64_t fileKey, uint32_t chunkId, Blob blob);
+    void setCapacity(size_t maxBytes);
+    size_t getCapacity() const { return _maxBytes.load(std::memory_order_relaxed); }
+    CacheStats getCacheStats() const;
+private:
+    struct Key {
+        Key() : _fileKey(0), _chunkId(0) { }
+        Key(uint64_t fileKey, uint32_t chunkId) : _fileKey(fileKey), _chunkId(chunkId) { }
+        uint64_t hash() const;
+        bool operator == (const Key & rhs) const { return (_fileKey == rhs._fileKey) && (_chunkId == rhs._chunkId); }
+        uint64_t _fileKey;
+        uint32_t _chunkId;
+    };
+    struct Entry {
+        Entry(const Key & key, Blob blob) : _key(key), _blob(std::move(blob)) { }
+        size_t memoryUsed() const;
+        Key  _key;
+        Blob _blob;
+    };
+    using LruList = std::list<Entry>;
+    using EntryMap = vespalib::hash_map<Key, LruList::iterator>;
+    using Guard = std::lock_guard<std::mutex>;
+
+    static size_t expectedEntries(size_t maxBytes);
+    void evictToFit(const Guard & guard, size_t maxBytes);
+
+    mutable std::mutex  _lock;
+    std::atomic<size_t> _maxBytes;
+    size_t              _usedBytes;
+    LruList             _lru;      // most recently used first
+    EntryMap            _entries;
+    FrequencySketch     _sketch;
+    size_t              _hits;
+    size_t              _misses;
+};
+
+}
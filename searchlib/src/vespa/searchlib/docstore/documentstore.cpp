@@ -97,6 +97,11 @@ public:
      */
     document::Document::UP deserializeDocument(const DocumentTypeRepo &repo);
 
+    /**
+     * Decompress value into the given buffer.
+     */
+    void decompressInto(vespalib::DataBuffer &buffer) const;
+
     size_t size() const { return _compressedSize; }
     bool empty() const { return size() == 0; }
     operator const void *() const { return _buf.get(); }
@@ -163,6 +168,12 @@ Value::deserializeDocument(const DocumentTypeRepo &repo) {
 }
 
 
+void
+Value::decompressInto(vespalib::DataBuffer &buffer) const {
+    vespalib::compression::decompress(getCompression(), getUncompressedSize(),
+                                      vespalib::ConstBufferRef(*this, size()), buffer, false);
+}
+
 void
 BackingStore::visit(const IDocumentStore::LidVector &lids, const DocumentTypeRepo &repo,
                     IDocumentVisitor &visitor) const {
@@ -272,6 +283,23 @@ DocumentStore::read(DocumentIdT lid, const DocumentTypeRepo &repo) const
     return retval;
 }
 
+bool
+DocumentStore::readSerialized(DocumentIdT lid, vespalib::DataBuffer &buffer) const
+{
+    buffer.clear();
+    if (useCache()) {
+        Value value = _cache->read(lid);
+        if (value.empty()) {
+            return false;
+        }
+        value.decompressInto(buffer);
+        return true;
+    }
+    // Read directly from the backing store, no need to compress into a cache value.
+    _uncached_lookups.fetch_add(1);
+    return _backingStore.read(lid, buffer) > 0;
+}
+
 void
 DocumentStore::write(uint64_t syncToken, DocumentIdT lid, const document::Document& doc) {
     nbostream stream(12345);
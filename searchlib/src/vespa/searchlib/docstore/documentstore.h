@@ -63,6 +63,7 @@ public:
     ~DocumentStore();
 
     document::Document::UP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const override;
+    bool readSerialized(DocumentIdT lid, vespalib::DataBuffer &buffer) const override;
     void visit(const LidVector & lids, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const override;
     void write(uint64_t synkToken, DocumentIdT lid, const document::Document& doc) override;
     void write(uint64_t synkToken, DocumentIdT lid, const vespalib::nbostream & os) override;
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "filechunk.h"
+#include "chunkcache.h"
 #include "data_store_file_chunk_stats.h"
 #include "summaryexceptions.h"
 #include "randreaders.h"
@@ -72,6 +73,7 @@ FileChunk::FileChunk(FileId fileId, NameId nameId, const vespalib::string & base
       _numChunksWithBuckets(0),
       _numUniqueBuckets(0),
       _file(),
+      _chunkCache(nullptr),
       _bucketizer(bucketizer),
       _addedBytes(0),
       _tune(tune),
@@ -382,12 +384,55 @@ FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisi
 void
 FileChunk::read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const
 {
-    vespalib::DataBuffer whole(0ul, ALIGNMENT);
-    FileRandRead::FSP keepAlive = _file->read(ci.getOffset(), whole, ci.getSize());
-    Chunk chunk(begin->getChunkId(), whole.getData(), whole.getDataLen(), _skipCrcOnRead);
+    loadChunk(begin->getChunkId(), ci)->visit(begin, count, visitor);
+}
+
+FileChunk::LoadedChunk::UP
+FileChunk::loadChunk(SubChunkId chunkId) const
+{
+    return loadChunk(chunkId, _chunkInfo[chunkId]);
+}
+
+FileChunk::LoadedChunk::UP
+FileChunk::loadChunk(SubChunkId chunkId, const ChunkInfo & chunkInfo) const
+{
+    auto loaded = std::make_unique<LoadedChunk>();
+    if ((_chunkCache != nullptr) && _chunkCache->enabled()) {
+        loaded->_cached = _chunkCache->get(_nameId.getId(), chunkId);
+        if ( ! loaded->_cached) {
+            // The read buffer might be a view into a memory mapped file, so the cache gets its own copy.
+            vespalib::DataBuffer whole(0ul, ALIGNMENT);
+            FileRandRead::FSP keepAlive = _file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize());
+            auto copy = std::make_shared<vespalib::DataBuffer>(whole.getDataLen());
+            copy->writeBytes(whole.getData(), whole.getDataLen());
+            loaded->_cached = std::move(copy);
+            _chunkCache->put(_nameId.getId(), chunkId, loaded->_cached);
+        }
+        loaded->_chunk = std::make_unique<Chunk>(chunkId, loaded->_cached->getData(), loaded->_cached->getDataLen(),
+                                                 _skipCrcOnRead);
+    } else {
+        loaded->_keepAlive = _file->read(chunkInfo.getOffset(), loaded->_whole, chunkInfo.getSize());
+        loaded->_chunk = std::make_unique<Chunk>(chunkId, loaded->_whole.getData(), loaded->_whole.getDataLen(),
+                                                 _skipCrcOnRead);
+    }
+    return loaded;
+}
+
+FileChunk::LoadedChunk::LoadedChunk()
+    : _whole(0ul, ALIGNMENT),
+      _keepAlive(),
+      _cached(),
+      _chunk()
+{ }
+
+FileChunk::LoadedChunk::~LoadedChunk() { }
+
+void
+FileChunk::LoadedChunk::visit(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const
+{
     for (size_t i(0); i < count; i++) {
         const LidInfoWithLid & li = *(begin + i);
-        vespalib::ConstBufferRef buf = chunk.getLid(li.getLid());
+        vespalib::ConstBufferRef buf = _chunk->getLid(li.getLid());
         if (buf.size() != 0) {
             visitor.visit(li.getLid(), buf);
         }
@@ -407,10 +452,7 @@ ssize_t
 FileChunk::read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo,
                 vespalib::DataBuffer & buffer) const
 {
-    vespalib::DataBuffer whole(0ul, ALIGNMENT);
-    FileRandRead::FSP keepAlive(_file->read(chunkInfo.getOffset(), whole, chunkInfo.getSize()));
-    Chunk chunk(chunkId, whole.getData(), whole.getDataLen(), _skipCrcOnRead);
-    return chunk.read(lid, buffer);
+    return loadChunk(chunkId, chunkInfo)->getChunk().read(lid, buffer);
 }
 
 uint64_t
@@ -7,6 +7,7 @@
 #include "lid_info.h"
 #include "randread.h"
 #include <vespa/searchlib/util/memoryusage.h>
+#include <vespa/vespalib/data/databuffer.h>
 #include <vespa/vespalib/util/ptrholder.h>
 #include <vespa/vespalib/util/sync.h>
 #include <vespa/vespalib/stllike/hash_map.h>
@@ -24,6 +25,7 @@ namespace vespalib {
 namespace search {
 
 class DataStoreFileChunkStats;
+namespace docstore { class ChunkCache; }
 
 class IWriteData
 {
@@ -105,6 +107,27 @@ public:
     typedef vespalib::hash_map<uint32_t, std::unique_ptr<vespalib::DataBuffer>> LidBufferMap;
     typedef std::unique_ptr<FileChunk> UP;
     typedef uint32_t SubChunkId;
+    /**
+     * A chunk that has been read from disk and deserialized. It keeps alive the
+     * raw buffer the chunk content might still refer to.
+     */
+    class LoadedChunk {
+    public:
+        typedef std::unique_ptr<LoadedChunk> UP;
+        LoadedChunk();
+        ~LoadedChunk();
+        const Chunk & getChunk() const { return *_chunk; }
+        /**
+         * Visit the given lids, which must all reside in this chunk.
+         */
+        void visit(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const;
+    private:
+        friend class FileChunk;
+        vespalib::DataBuffer  _whole;
+        FileRandRead::FSP     _keepAlive;
+        std::shared_ptr<const vespalib::DataBuffer> _cached;
+        std::unique_ptr<Chunk> _chunk;
+    };
     FileChunk(FileId fileId, NameId nameId, const vespalib::string &baseName, const TuneFileSummary &tune,
               const IBucketizer *bucketizer, bool skipCrcOnRead);
     virtual ~FileChunk();
@@ -112,6 +135,12 @@ public:
     virtual size_t updateLidMap(const LockGuard &guard, ISetLid &lidMap, uint64_t serialNum, uint32_t docIdLimit);
     virtual ssize_t read(uint32_t lid, SubChunkId chunk, vespalib::DataBuffer & buffer) const;
     virtual void read(LidInfoWithLidV::const_iterator begin, size_t count, IBufferVisitor & visitor) const;
+    /**
+     * Read and deserialize the given chunk from disk. Only valid for chunks already
+     * persisted, which is all of them when the file is frozen. Safe to call from
+     * multiple threads concurrently.
+     */
+    LoadedChunk::UP loadChunk(SubChunkId chunkId) const;
     void remove(uint32_t lid, uint32_t size);
     virtual size_t getDiskFootprint() const { return _diskFootprint; }
     virtual size_t getMemoryFootprint() const;
@@ -170,6 +199,10 @@ public:
      * any read.
      */
     void enableRead();
+    /**
+     * Serve chunk reads through the given cache. It must outlive this file chunk.
+     */
+    void setChunkCache(docstore::ChunkCache * chunkCache) { _chunkCache = chunkCache; }
     // This should never be done to something that is used. Backing
     // Files are removed and everythings dies.
     void erase();
@@ -211,6 +244,7 @@ private:
     size_t                 _numChunksWithBuckets;
     size_t                 _numUniqueBuckets;
     File                   _file;
+    docstore::ChunkCache * _chunkCache;
 protected:
     void setDiskFootprint(size_t sz) { _diskFootprint = sz; }
     static size_t adjustSize(size_t sz);
@@ -234,6 +268,7 @@ protected:
     void setNumUniqueBuckets(size_t numUniqueBuckets) { _numUniqueBuckets = numUniqueBuckets; }
     ssize_t read(uint32_t lid, SubChunkId chunkId, const ChunkInfo & chunkInfo, vespalib::DataBuffer & buffer) const;
     void read(LidInfoWithLidV::const_iterator begin, size_t count, ChunkInfo ci, IBufferVisitor & visitor) const;
+    LoadedChunk::UP loadChunk(SubChunkId chunkId, const ChunkInfo & chunkInfo) const;
     static uint32_t readDocIdLimit(vespalib::GenericHeader &header);
     static void writeDocIdLimit(vespalib::GenericHeader &header, uint32_t docIdLimit);
 
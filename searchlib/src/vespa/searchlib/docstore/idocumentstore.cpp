@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "idocumentstore.h"
+#include "cachestats.h"
 
 namespace search {
 
@@ -18,4 +19,10 @@ void IDocumentStore::visit(const LidVector & lids, const document::DocumentTypeR
     }
 }
 
+CacheStats
+IDocumentStore::getChunkCacheStats() const
+{
+    return CacheStats();
+}
+
 } // namespace search
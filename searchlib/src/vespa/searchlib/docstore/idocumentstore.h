@@ -75,6 +75,14 @@ public:
      * @return NULL if there is no document associated with the lid.
      **/
     virtual document::Document::UP read(DocumentIdT lid, const document::DocumentTypeRepo &repo) const = 0;
+
+    /**
+     * Read the serialized form of a stored document into the given buffer,
+     * without deserializing it. Any existing content of the buffer is cleared.
+     * @param lid The local ID associated with the document.
+     * @return false if there is no document associated with the lid.
+     **/
+    virtual bool readSerialized(DocumentIdT lid, vespalib::DataBuffer &buffer) const = 0;
     virtual void visit(const LidVector & lidVector, const document::DocumentTypeRepo &repo, IDocumentVisitor & visitor) const;
 
     /**
@@ -166,6 +174,12 @@ public:
      */
     virtual CacheStats getCacheStats() const = 0;
 
+    /**
+     * Returns statistics about the cache of compressed chunks below the
+     * document cache, if there is one.
+     */
+    virtual CacheStats getChunkCacheStats() const;
+
     /**
      * Returns the base directory from which all structures are stored.
      **/
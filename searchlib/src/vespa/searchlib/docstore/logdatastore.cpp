@@ -9,6 +9,8 @@
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/searchlib/common/rcuvector.hpp>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/sync.h>
 #include <thread>
 
 #include <vespa/log/log.h>
@@ -34,6 +36,8 @@ LogDataStore::Config::Config()
       _maxDiskBloatFactor(0.2),
       _maxBucketSpread(2.5),
       _minFileSizeFactor(0.2),
+      _maxReadThreads(0),
+      _chunkCacheSize(0),
       _skipCrcOnRead(false),
       _compact2ActiveFile(true),
       _compactCompression(CompressionConfig::LZ4),
@@ -46,6 +50,8 @@ LogDataStore::Config::operator == (const Config & rhs) const {
             (_maxDiskBloatFactor == rhs._maxDiskBloatFactor) &&
             (_maxFileSize == rhs._maxFileSize) &&
             (_minFileSizeFactor == rhs._minFileSizeFactor) &&
+            (_maxReadThreads == rhs._maxReadThreads) &&
+            (_chunkCacheSize == rhs._chunkCacheSize) &&
             (_compact2ActiveFile == rhs._compact2ActiveFile) &&
             (_skipCrcOnRead == rhs._skipCrcOnRead) &&
             (_compactCompression == rhs._compactCompression) &&
@@ -70,6 +76,10 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
       _prevActive(FileId::active()),
       _readOnly(readOnly),
       _executor(executor),
+      _readExecutor(config.getMaxReadThreads() > 0
+                    ? std::make_unique<vespalib::ThreadStackExecutor>(config.getMaxReadThreads(), 128*1024)
+                    : std::unique_ptr<vespalib::ThreadStackExecutor>()),
+      _chunkCache(config.getChunkCacheSize()),
       _initFlushSyncToken(0),
       _tlSyncer(tlSyncer),
       _bucketizer(bucketizer),
@@ -87,6 +97,7 @@ LogDataStore::LogDataStore(vespalib::ThreadExecutor &executor, const vespalib::s
 
 void LogDataStore::reconfigure(const Config & config) {
     _config = config;
+    _chunkCache.setCapacity(config.getChunkCacheSize());
 }
 
 void
@@ -146,13 +157,61 @@ LogDataStore::read(const LidVector & lids, IBufferVisitor & visitor) const
         const LidInfoWithLid & li = orderedLids[curr];
         if (prevFile != li.getFileId()) {
             const FileChunk & fc(*_fileChunks[prevFile]);
-            fc.read(orderedLids.begin() + start, curr - start, visitor);
+            readChunksInParallel(fc, orderedLids.begin() + start, curr - start, visitor);
             start = curr;
             prevFile = li.getFileId();
         }
     }
     const FileChunk & fc(*_fileChunks[prevFile]);
-    fc.read(orderedLids.begin() + start, orderedLids.size() - start, visitor);
+    readChunksInParallel(fc, orderedLids.begin() + start, orderedLids.size() - start, visitor);
+}
+
+void
+LogDataStore::readChunksInParallel(const FileChunk & fc, LidInfoWithLidV::const_iterator begin, size_t count,
+                                   IBufferVisitor & visitor) const
+{
+    // Chunks in the active file might still be in memory, leave them to the file chunk itself.
+    if ( ! _readExecutor || ! fc.frozen()) {
+        fc.read(begin, count, visitor);
+        return;
+    }
+    std::vector<std::pair<size_t, size_t>> ranges; // offset and count of lids sharing a chunk
+    for (size_t i(0); i < count; i++) {
+        if ((i == 0) || ((begin + i)->getChunkId() != (begin + i - 1)->getChunkId())) {
+            ranges.emplace_back(i, 0);
+        }
+        ranges.back().second++;
+    }
+    if (ranges.size() == 1) {
+        fc.read(begin, count, visitor);
+        return;
+    }
+    // Issue all chunk reads up front so disk latency overlaps, then visit in lid order in this thread.
+    std::vector<FileChunk::LoadedChunk::UP> loaded(ranges.size());
+    std::vector<std::exception_ptr> failures(ranges.size());
+    vespalib::CountDownLatch latch(ranges.size());
+    for (size_t i(0); i < ranges.size(); i++) {
+        uint32_t chunkId = (begin + ranges[i].first)->getChunkId();
+        auto task = vespalib::makeLambdaTask([&fc, &loaded, &failures, &latch, chunkId, i]() {
+            try {
+                loaded[i] = fc.loadChunk(chunkId);
+            } catch (...) {
+                failures[i] = std::current_exception();
+            }
+            latch.countDown();
+        });
+        vespalib::Executor::Task::UP rejected = _readExecutor->execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
+    for (size_t i(0); i < ranges.size(); i++) {
+        if (failures[i]) {
+            std::rethrow_exception(failures[i]);
+        }
+        loaded[i]->visit(begin + ranges[i].first, ranges[i].second, visitor);
+    }
 }
 
 ssize_t
@@ -631,6 +690,7 @@ FileChunk::UP
 LogDataStore::createReadOnlyFile(FileId fileId, NameId nameId) {
     FileChunk::UP file(new FileChunk(fileId, nameId, getBaseDir(), _tune,
                                      _bucketizer.get(), _config.crcOnReadDisabled()));
+    file->setChunkCache(&_chunkCache);
     file->enableRead();
     return file;
 }
@@ -650,6 +710,7 @@ LogDataStore::createWritableFile(FileId fileId, SerialNum serialNum, NameId name
                                               serialNum, docIdLimit,
                                               _config.getFileConfig(), _tune, _fileHeaderContext,
                                               _bucketizer.get(), _config.crcOnReadDisabled()));
+    file->setChunkCache(&_chunkCache);
     file->enableRead();
     return file;
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "idatastore.h"
+#include "chunkcache.h"
 #include "lid_info.h"
 #include "writeablefilechunk.h"
 #include <vespa/vespalib/util/compressionconfig.h>
@@ -10,6 +11,7 @@
 #include <vespa/searchlib/common/tunefileinfo.h>
 #include <vespa/searchlib/transactionlog/syncproxy.h>
 #include <vespa/vespalib/util/threadexecutor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 
 #include <set>
 
@@ -42,6 +44,8 @@ public:
         Config & setMaxDiskBloatFactor(double v) { _maxDiskBloatFactor = v; return *this; }
         Config & setMaxBucketSpread(double v) { _maxBucketSpread = v; return *this; }
         Config & setMinFileSizeFactor(double v) { _minFileSizeFactor = v; return *this; }
+        Config & setMaxReadThreads(uint32_t v) { _maxReadThreads = v; return *this; }
+        Config & setChunkCacheSize(size_t v) { _chunkCacheSize = v; return *this; }
 
         Config & compactCompression(CompressionConfig v) { _compactCompression = v; return *this; }
         Config & setFileConfig(WriteableFileChunk::Config v) { _fileConfig = v; return *this; }
@@ -50,6 +54,10 @@ public:
         double getMaxDiskBloatFactor() const { return _maxDiskBloatFactor; }
         double getMaxBucketSpread() const { return _maxBucketSpread; }
         double getMinFileSizeFactor() const { return _minFileSizeFactor; }
+        /// Number of threads used to read and decompress chunks of a multi lid read, 0 reads in the caller thread.
+        uint32_t getMaxReadThreads() const { return _maxReadThreads; }
+        /// Max bytes of compressed chunks kept in memory, 0 disables the chunk cache.
+        size_t getChunkCacheSize() const { return _chunkCacheSize; }
 
         bool crcOnReadDisabled() const { return _skipCrcOnRead; }
         bool compact2ActiveFile() const { return _compact2ActiveFile; }
@@ -65,6 +73,8 @@ public:
         double                      _maxDiskBloatFactor;
         double                      _maxBucketSpread;
         double                      _minFileSizeFactor;
+        uint32_t                    _maxReadThreads;
+        size_t                      _chunkCacheSize;
         bool                        _skipCrcOnRead;
         bool                        _compact2ActiveFile;
         CompressionConfig           _compactCompression;
@@ -177,6 +187,7 @@ public:
 
     NameIdSet getAllActiveFiles() const;
     void reconfigure(const Config & config);
+    CacheStats getCacheStats() const { return _chunkCache.getCacheStats(); }
 
 private:
     class WrapVisitor;
@@ -193,6 +204,8 @@ private:
     typedef std::vector<FileChunk::UP> FileChunkVector;
 
     void updateLidMap(uint32_t lastFileChunkDocIdLimit);
+    void readChunksInParallel(const FileChunk & fc, LidInfoWithLidV::const_iterator begin, size_t count,
+                              IBufferVisitor & visitor) const;
     void preload();
     uint32_t getLastFileChunkDocIdLimit();
     void verifyModificationTime(const NameIdSet & partList);
@@ -282,6 +295,8 @@ private:
     vespalib::Lock                           _updateLock;
     bool                                     _readOnly;
     vespalib::ThreadExecutor                &_executor;
+    std::unique_ptr<vespalib::ThreadStackExecutor> _readExecutor;
+    docstore::ChunkCache                     _chunkCache;
     SerialNum                                _initFlushSyncToken;
     transactionlog::SyncProxy               &_tlSyncer;
     IBucketizer::SP                          _bucketizer;
@@ -50,6 +50,7 @@ public:
                      transactionlog::SyncProxy &tlSyncer, const IBucketizer::SP & bucketizer);
     ~LogDocumentStore();
     void reconfigure(const Config & config);
+    CacheStats getChunkCacheStats() const override { return _backingStore.getCacheStats(); }
 private:
     void compact(uint64_t syncToken) override       { _backingStore.compact(syncToken); }
     LogDataStore _backingStore;
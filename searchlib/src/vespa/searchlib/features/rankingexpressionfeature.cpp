@@ -6,6 +6,7 @@
 #include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/features/rankingexpression/feature_name_extractor.h>
 #include <vespa/eval/tensor/default_tensor_engine.h>
+#include <vespa/eval/tensor/dense/dense_tensor_view.h>
 #include <vespa/eval/eval/param_usage.h>
 
 #include <vespa/log/log.h>
@@ -22,6 +23,7 @@ using vespalib::eval::Value;
 using vespalib::eval::DoubleValue;
 using vespalib::eval::NodeTypes;
 using vespalib::tensor::DefaultTensorEngine;
+using vespalib::tensor::DenseTensorView;
 using search::fef::FeatureType;
 using vespalib::ArrayRef;
 using vespalib::ConstArrayRef;
@@ -39,6 +41,31 @@ vespalib::string list_issues(const std::vector<vespalib::string> &issues) {
     return result;
 }
 
+/**
+ * Cells compiled functions are called with the cells of each input.
+ * This requires all object inputs to be numbers or dense tensors of
+ * the exact type the function is compiled for. Returns the expected
+ * number of cells for each input, or an empty vector if some input
+ * cannot be passed as cells.
+ */
+std::vector<size_t> input_cells(const std::vector<ValueType> &input_types) {
+    std::vector<size_t> cells;
+    for (const ValueType &type: input_types) {
+        if (type.is_double()) {
+            cells.push_back(1);
+        } else if (type.is_tensor() && type.is_dense() && !type.is_abstract()) {
+            size_t num_cells = 1;
+            for (const auto &dim: type.dimensions()) {
+                num_cells *= dim.size;
+            }
+            cells.push_back(num_cells);
+        } else {
+            return std::vector<size_t>();
+        }
+    }
+    return cells;
+}
+
 } // namespace search::features::<unnamed>
 
 //-----------------------------------------------------------------------------
@@ -78,6 +105,30 @@ public:
 
 //-----------------------------------------------------------------------------
 
+/**
+ * Implements the executor for compiled ranking expressions with
+ * dense tensor inputs
+ **/
+class CellsCompiledRankingExpressionExecutor : public fef::FeatureExecutor
+{
+private:
+    using function_type = CompiledFunction::cells_function;
+    function_type               _ranking_function;
+    ConstArrayRef<char>         _input_is_object;
+    ConstArrayRef<size_t>       _input_cells;
+    std::vector<double>         _numbers;
+    std::vector<const double *> _params;
+
+public:
+    CellsCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function,
+                                           ConstArrayRef<char> input_is_object,
+                                           ConstArrayRef<size_t> input_cells);
+    bool isPure() override { return true; }
+    void execute(uint32_t docId) override;
+};
+
+//-----------------------------------------------------------------------------
+
 struct MyLazyParams : LazyParams {
     const fef::FeatureExecutor::Inputs &inputs;
     const ConstArrayRef<char> input_is_object;
@@ -152,6 +203,44 @@ LazyCompiledRankingExpressionExecutor::execute(uint32_t)
 
 //-----------------------------------------------------------------------------
 
+CellsCompiledRankingExpressionExecutor::CellsCompiledRankingExpressionExecutor(const CompiledFunction &compiled_function,
+                                                                               ConstArrayRef<char> input_is_object,
+                                                                               ConstArrayRef<size_t> input_cells)
+    : _ranking_function(compiled_function.get_cells_function()),
+      _input_is_object(input_is_object),
+      _input_cells(input_cells),
+      _numbers(compiled_function.num_params(), 0.0),
+      _params(compiled_function.num_params(), nullptr)
+{
+    assert(_input_is_object.size() == _params.size());
+    assert(_input_cells.size() == _params.size());
+}
+
+void
+CellsCompiledRankingExpressionExecutor::execute(uint32_t)
+{
+    for (size_t i = 0; i < _params.size(); ++i) {
+        if (_input_is_object[i]) {
+            const Value &value = inputs().get_object(i);
+            if (value.is_double()) {
+                _numbers[i] = value.as_double();
+                _params[i] = &_numbers[i];
+            } else {
+                // declared input types are checked to be concrete dense tensors during setup
+                const DenseTensorView &tensor = static_cast<const DenseTensorView &>(*value.as_tensor());
+                assert(tensor.cellsRef().size() == _input_cells[i]);
+                _params[i] = tensor.cellsRef().cbegin();
+            }
+        } else {
+            _numbers[i] = inputs().get_number(i);
+            _params[i] = &_numbers[i];
+        }
+    }
+    outputs().set_number(0, _ranking_function(&_params[0]));
+}
+
+//-----------------------------------------------------------------------------
+
 InterpretedRankingExpressionExecutor::InterpretedRankingExpressionExecutor(const InterpretedFunction &function,
                                                                            ConstArrayRef<char> input_is_object)
     : _function(function),
@@ -177,7 +266,8 @@ RankingExpressionBlueprint::RankingExpressionBlueprint(rankingexpression::Expres
       _intrinsic_expression(),
       _interpreted_function(),
       _compile_token(),
-      _input_is_object()
+      _input_is_object(),
+      _input_cells()
 {
 }
 
@@ -252,8 +342,22 @@ RankingExpressionBlueprint::setup(const fef::IIndexEnvironment &env,
             script.c_str(), list_issues(compile_issues.list).c_str());
         do_compile = false;
     }
+    bool do_compile_tensors = false;
+    if (!do_compile && fef::indexproperties::eval::CompileTensorExpressions::check(env.getProperties())) {
+        _input_cells = input_cells(input_types);
+        auto tensor_issues = (_input_cells.size() == input_types.size())
+                             ? CompiledFunction::detect_issues(rank_function, input_types)
+                             : Function::Issues({"inputs are not all numbers or concrete dense tensors"});
+        if (tensor_issues) {
+            LOG(debug, "rank expression tensor compilation disabled: %s\n%s",
+                script.c_str(), list_issues(tensor_issues.list).c_str());
+            _input_cells.clear();
+        } else {
+            do_compile_tensors = true;
+        }
+    }
     const auto &issues = do_compile ? compile_issues : interpret_issues;
-    if (issues) {
+    if (issues && !do_compile_tensors) {
         LOG(error, "rank expression cannot be evaluated: %s\n%s",
             script.c_str(), list_issues(issues.list).c_str());
         return false;
@@ -267,11 +371,13 @@ RankingExpressionBlueprint::setup(const fef::IIndexEnvironment &env,
             } else {
                 _compile_token = CompileCache::compile(rank_function, PassParams::ARRAY);
             }
+        } else if (do_compile_tensors) {
+            _compile_token = CompileCache::compile(rank_function, input_types);
         } else {
             _interpreted_function.reset(new InterpretedFunction(DefaultTensorEngine::ref(), rank_function, node_types));
         }
     }
-    FeatureType output_type = do_compile
+    FeatureType output_type = (do_compile || do_compile_tensors)
                               ? FeatureType::number()
                               : FeatureType::object(root_type);
     describeOutput("out", "The result of running the contained ranking expression.", output_type);
@@ -297,6 +403,10 @@ RankingExpressionBlueprint::createExecutor(const fef::IQueryEnvironment &env, ve
     assert(_compile_token.get() != nullptr); // will be nullptr for VERIFY_SETUP feature motivation
     if (_compile_token->get().pass_params() == PassParams::ARRAY) {
         return stash.create<CompiledRankingExpressionExecutor>(_compile_token->get());
+    } else if (_compile_token->get().pass_params() == PassParams::CELLS) {
+        ConstArrayRef<char> input_is_object = stash.copy_array<char>(_input_is_object);
+        ConstArrayRef<size_t> input_cells = stash.copy_array<size_t>(_input_cells);
+        return stash.create<CellsCompiledRankingExpressionExecutor>(_compile_token->get(), input_is_object, input_cells);
     } else {
         assert(_compile_token->get().pass_params() == PassParams::LAZY);
         return stash.create<LazyCompiledRankingExpressionExecutor>(_compile_token->get());
@@ -24,6 +24,7 @@ private:
     vespalib::eval::InterpretedFunction::UP    _interpreted_function;
     vespalib::eval::CompileCache::Token::UP    _compile_token;
     std::vector<char>                          _input_is_object;
+    std::vector<size_t>                        _input_cells;
 
 public:
     RankingExpressionBlueprint();
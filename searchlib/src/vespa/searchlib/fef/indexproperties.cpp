@@ -84,6 +84,15 @@ LazyExpressions::check(const Properties &props, bool default_value)
     return lookupBool(props, NAME, default_value);
 }
 
+const vespalib::string CompileTensorExpressions::NAME("vespa.eval.compile_tensor_expressions");
+const bool CompileTensorExpressions::DEFAULT_VALUE(false);
+
+bool
+CompileTensorExpressions::check(const Properties &props)
+{
+    return lookupBool(props, NAME, DEFAULT_VALUE);
+}
+
 } // namespace eval
 
 namespace rank {
@@ -190,6 +199,36 @@ NumSearchPartitions::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const vespalib::string PartitionedGroupingMerge::NAME("vespa.matching.partitionedgroupingmerge");
+const bool PartitionedGroupingMerge::DEFAULT_VALUE(false);
+
+bool
+PartitionedGroupingMerge::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+PartitionedGroupingMerge::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
+const vespalib::string WorkStealing::NAME("vespa.matching.workstealing");
+const bool WorkStealing::DEFAULT_VALUE(false);
+
+bool
+WorkStealing::lookup(const Properties &props)
+{
+    return lookup(props, DEFAULT_VALUE);
+}
+
+bool
+WorkStealing::lookup(const Properties &props, bool defaultValue)
+{
+    return lookupBool(props, NAME, defaultValue);
+}
+
 const vespalib::string MinHitsPerThread::NAME("vespa.matching.minhitsperthread");
 const uint32_t MinHitsPerThread::DEFAULT_VALUE(0);
 
@@ -29,6 +29,14 @@ struct LazyExpressions {
     static bool check(const Properties &props, bool default_value);
 };
 
+// compile expressions using dense tensors with known types to
+// vectorized machine code instead of interpreting them. affects rank/summary/dump
+struct CompileTensorExpressions {
+    static const vespalib::string NAME;
+    static const bool DEFAULT_VALUE;
+    static bool check(const Properties &props);
+};
+
 } // namespace eval
 
 namespace rank {
@@ -133,6 +141,28 @@ namespace matching {
         static uint32_t lookup(const Properties &props);
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
+    /**
+     * Property for merging the grouping results of the search threads
+     * by hash partitioning the top level groups, letting each thread
+     * merge one partition, instead of merging them pairwise.
+     **/
+    struct PartitionedGroupingMerge {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
+    /**
+     * Property for letting the search threads steal work from each
+     * other instead of using the adaptive or partitioned scheduling
+     * selected by the number of search partitions.
+     **/
+    struct WorkStealing {
+        static const vespalib::string NAME;
+        static const bool DEFAULT_VALUE;
+        static bool lookup(const Properties &props);
+        static bool lookup(const Properties &props, bool defaultValue);
+    };
 }
 
 namespace softtimeout {
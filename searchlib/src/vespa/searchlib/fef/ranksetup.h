@@ -36,6 +36,8 @@ private:
     uint32_t                 _numThreads;
     uint32_t                 _minHitsPerThread;
     uint32_t                 _numSearchPartitions;
+    bool                     _partitionedGroupingMerge;
+    bool                     _workStealing;
     uint32_t                 _heapSize;
     uint32_t                 _arraySize;
     uint32_t                 _estimatePoint;
@@ -158,6 +160,14 @@ public:
 
     uint32_t getNumSearchPartitions() const { return _numSearchPartitions; }
 
+    void setPartitionedGroupingMerge(bool value) { _partitionedGroupingMerge = value; }
+
+    bool getPartitionedGroupingMerge() const { return _partitionedGroupingMerge; }
+
+    void setWorkStealing(bool value) { _workStealing = value; }
+
+    bool getWorkStealing() const { return _workStealing; }
+
     /**
      * Sets the heap size to be used in the hit collector.
      *
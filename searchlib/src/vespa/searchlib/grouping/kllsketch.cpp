@@ -0,0 +1,206 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "kllsketch.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace search {
+
+namespace {
+
+// Smallest capacity of any level, which keeps the lowest levels from
+// compacting on every insert.
+constexpr uint32_t MIN_LEVEL_CAPACITY = 8;
+constexpr double CAPACITY_DECAY = 2.0 / 3.0;
+
+}
+
+KllSketch::KllSketch(uint32_t k)
+    : _k(std::max(k, MIN_LEVEL_CAPACITY)),
+      _count(0),
+      _min(std::numeric_limits<double>::max()),
+      _max(std::numeric_limits<double>::lowest()),
+      _levels(1),
+      _size(0),
+      _capacity(0),
+      _compactions(0)
+{
+    updateCapacity();
+}
+
+KllSketch::KllSketch(const KllSketch &) = default;
+KllSketch & KllSketch::operator = (const KllSketch &) = default;
+KllSketch::~KllSketch() = default;
+
+uint32_t
+KllSketch::levelCapacity(uint32_t level) const
+{
+    uint32_t depth = _levels.size() - level - 1;
+    uint32_t capacity = std::ceil(_k * std::pow(CAPACITY_DECAY, depth));
+    return std::max(capacity, MIN_LEVEL_CAPACITY);
+}
+
+void
+KllSketch::updateCapacity()
+{
+    _capacity = 0;
+    for (uint32_t level = 0; level < _levels.size(); ++level) {
+        _capacity += levelCapacity(level);
+    }
+}
+
+void
+KllSketch::compact(uint32_t level)
+{
+    if (level + 1 == _levels.size()) {
+        _levels.emplace_back();
+        updateCapacity();
+    }
+    std::vector<double> &values = _levels[level];
+    std::sort(values.begin(), values.end());
+    // an odd value out stays on this level
+    double keep = values.back();
+    bool odd = ((values.size() % 2) != 0);
+    if (odd) {
+        values.pop_back();
+    }
+    // alternate which half survives to avoid a systematic bias
+    size_t offset = (_compactions++ % 2);
+    std::vector<double> &above = _levels[level + 1];
+    for (size_t i = offset; i < values.size(); i += 2) {
+        above.push_back(values[i]);
+    }
+    _size -= (values.size() / 2);
+    values.clear();
+    if (odd) {
+        values.push_back(keep);
+    }
+}
+
+void
+KllSketch::compress()
+{
+    while (_size > _capacity) {
+        for (uint32_t level = 0; level < _levels.size(); ++level) {
+            if (_levels[level].size() >= levelCapacity(level)) {
+                compact(level);
+                break;
+            }
+        }
+    }
+}
+
+void
+KllSketch::add(double value)
+{
+    ++_count;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+    _levels[0].push_back(value);
+    if (++_size > _capacity) {
+        compress();
+    }
+}
+
+void
+KllSketch::merge(const KllSketch &other)
+{
+    if (other._k != _k) {
+        throw std::runtime_error("Can not merge KLL sketches with different k");
+    }
+    if (other._levels.size() > _levels.size()) {
+        _levels.resize(other._levels.size());
+        updateCapacity();
+    }
+    for (uint32_t level = 0; level < other._levels.size(); ++level) {
+        const std::vector<double> &values = other._levels[level];
+        _levels[level].insert(_levels[level].end(), values.begin(), values.end());
+    }
+    _size += other._size;
+    _count += other._count;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+    compress();
+}
+
+double
+KllSketch::quantile(double q) const
+{
+    if (_count == 0) {
+        return 0.0;
+    }
+    if (q <= 0.0) {
+        return _min;
+    }
+    if (q >= 1.0) {
+        return _max;
+    }
+    std::vector<std::pair<double, uint64_t>> weighted;
+    weighted.reserve(_size);
+    for (uint32_t level = 0; level < _levels.size(); ++level) {
+        for (double value : _levels[level]) {
+            weighted.emplace_back(value, uint64_t(1) << level);
+        }
+    }
+    std::sort(weighted.begin(), weighted.end());
+    uint64_t total = 0;
+    for (const auto &entry : weighted) {
+        total += entry.second;
+    }
+    double target = q * total;
+    uint64_t seen = 0;
+    for (const auto &entry : weighted) {
+        seen += entry.second;
+        if (seen >= target) {
+            return entry.first;
+        }
+    }
+    return _max;
+}
+
+void
+KllSketch::serialize(vespalib::Serializer &os) const
+{
+    os << _k << _count << _min << _max << static_cast<uint32_t>(_levels.size());
+    for (const std::vector<double> &values : _levels) {
+        os << static_cast<uint32_t>(values.size());
+        for (double value : values) {
+            os << value;
+        }
+    }
+}
+
+void
+KllSketch::deserialize(vespalib::Deserializer &is)
+{
+    uint32_t numLevels;
+    is >> _k >> _count >> _min >> _max >> numLevels;
+    _levels.clear();
+    _levels.resize(std::max(numLevels, 1u));
+    _size = 0;
+    for (uint32_t level = 0; level < numLevels; ++level) {
+        uint32_t numValues;
+        is >> numValues;
+        std::vector<double> &values = _levels[level];
+        values.resize(numValues);
+        for (double &value : values) {
+            is >> value;
+        }
+        _size += numValues;
+    }
+    updateCapacity();
+}
+
+bool
+KllSketch::operator==(const KllSketch &other) const
+{
+    return ((_k == other._k) &&
+            (_count == other._count) &&
+            (_min == other._min) &&
+            (_max == other._max) &&
+            (_levels == other._levels));
+}
+
+}  // namespace search
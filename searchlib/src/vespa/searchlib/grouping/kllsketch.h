@@ -0,0 +1,70 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/objects/deserializer.h>
+#include <vespa/vespalib/objects/serializer.h>
+#include <vector>
+
+namespace search {
+
+/**
+ * KLL sketch used to estimate quantiles of a stream of values in
+ * bounded memory. Values are kept in a set of levels, where each
+ * value on level h represents 2^h values seen. When the sketch is
+ * full, the lowest level exceeding its capacity is sorted and every
+ * other value is promoted to the level above. The capacities shrink
+ * geometrically towards the lower levels, which keeps the number of
+ * retained values around 3k regardless of stream length. Sketches
+ * with the same k can be merged, and the result has the same error
+ * bounds as a sketch built from the concatenated streams.
+ */
+class KllSketch {
+public:
+    static constexpr uint32_t DEFAULT_K = 200;
+
+private:
+    uint32_t                         _k;
+    uint64_t                         _count;
+    double                           _min;
+    double                           _max;
+    std::vector<std::vector<double>> _levels;
+    size_t                           _size;
+    size_t                           _capacity;
+    uint32_t                         _compactions;
+
+    uint32_t levelCapacity(uint32_t level) const;
+    void updateCapacity();
+    void compact(uint32_t level);
+    void compress();
+
+public:
+    explicit KllSketch(uint32_t k = DEFAULT_K);
+    KllSketch(const KllSketch &);
+    KllSketch & operator = (const KllSketch &);
+    KllSketch(KllSketch &&) = default;
+    KllSketch & operator = (KllSketch &&) = default;
+    ~KllSketch();
+
+    void add(double value);
+    void merge(const KllSketch &other);
+
+    /**
+     * Estimates the value at the given quantile (0.0 - 1.0). The
+     * exact min and max values are returned for 0.0 and 1.0.
+     **/
+    double quantile(double q) const;
+
+    uint32_t getK() const { return _k; }
+    uint64_t getCount() const { return _count; }
+    double getMin() const { return _min; }
+    double getMax() const { return _max; }
+    size_t getNumRetained() const { return _size; }
+
+    void serialize(vespalib::Serializer &os) const;
+    void deserialize(vespalib::Deserializer &is);
+
+    bool operator==(const KllSketch &other) const;
+};
+
+}  // namespace search
@@ -0,0 +1,227 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "spacesavingsketch.h"
+#include <algorithm>
+#include <stdexcept>
+
+using search::expression::ResultNode;
+
+namespace search {
+
+namespace {
+
+// Orders by decreasing count, with ties broken on value to make merges
+// deterministic.
+struct HigherCount {
+    bool operator()(const SpaceSavingSketch::Counter &a, const SpaceSavingSketch::Counter &b) const {
+        if (a.count != b.count) {
+            return (a.count > b.count);
+        }
+        return (a.value->cmp(*b.value) < 0);
+    }
+};
+
+}
+
+SpaceSavingSketch::Counter::Counter(const ResultNode &value_in, uint64_t count_in, uint64_t error_in)
+    : value(value_in.clone()),
+      count(count_in),
+      error(error_in)
+{
+}
+
+bool
+SpaceSavingSketch::Counter::operator==(const Counter &rhs) const
+{
+    return ((count == rhs.count) && (error == rhs.error) && (value->cmp(*rhs.value) == 0));
+}
+
+SpaceSavingSketch::SpaceSavingSketch(uint32_t capacity)
+    : _capacity(std::max(capacity, 1u)),
+      _total(0),
+      _counters(),
+      _index()
+{
+}
+
+SpaceSavingSketch::SpaceSavingSketch(const SpaceSavingSketch &rhs)
+    : _capacity(rhs._capacity),
+      _total(rhs._total),
+      _counters(rhs._counters),
+      _index()
+{
+    rebuildIndex();
+}
+
+SpaceSavingSketch &
+SpaceSavingSketch::operator = (const SpaceSavingSketch &rhs)
+{
+    if (this != &rhs) {
+        _capacity = rhs._capacity;
+        _total = rhs._total;
+        _counters = rhs._counters;
+        rebuildIndex();
+    }
+    return *this;
+}
+
+SpaceSavingSketch::~SpaceSavingSketch() = default;
+
+void
+SpaceSavingSketch::swapCounters(uint32_t a, uint32_t b)
+{
+    std::swap(_counters[a], _counters[b]);
+    _index[_counters[a].value.get()] = a;
+    _index[_counters[b].value.get()] = b;
+}
+
+void
+SpaceSavingSketch::siftUp(uint32_t pos)
+{
+    while (pos > 0) {
+        uint32_t parent = (pos - 1) / 2;
+        if (_counters[parent].count <= _counters[pos].count) {
+            break;
+        }
+        swapCounters(parent, pos);
+        pos = parent;
+    }
+}
+
+void
+SpaceSavingSketch::siftDown(uint32_t pos)
+{
+    uint32_t size = _counters.size();
+    for (;;) {
+        uint32_t smallest = pos;
+        uint32_t left = 2 * pos + 1;
+        uint32_t right = left + 1;
+        if ((left < size) && (_counters[left].count < _counters[smallest].count)) {
+            smallest = left;
+        }
+        if ((right < size) && (_counters[right].count < _counters[smallest].count)) {
+            smallest = right;
+        }
+        if (smallest == pos) {
+            break;
+        }
+        swapCounters(pos, smallest);
+        pos = smallest;
+    }
+}
+
+void
+SpaceSavingSketch::rebuildIndex()
+{
+    _index.clear();
+    for (uint32_t pos = 0; pos < _counters.size(); ++pos) {
+        _index[_counters[pos].value.get()] = pos;
+    }
+}
+
+void
+SpaceSavingSketch::add(const ResultNode &value, uint64_t weight)
+{
+    _total += weight;
+    auto found = _index.find(&value);
+    if (found != _index.end()) {
+        uint32_t pos = found->second;
+        _counters[pos].count += weight;
+        siftDown(pos);
+    } else if (!isFull()) {
+        _counters.emplace_back(value, weight, 0);
+        uint32_t pos = _counters.size() - 1;
+        _index[_counters[pos].value.get()] = pos;
+        siftUp(pos);
+    } else {
+        Counter &victim = _counters[0];
+        _index.erase(victim.value.get());
+        victim.error = victim.count;
+        victim.count += weight;
+        victim.value.reset(value.clone());
+        _index[victim.value.get()] = 0;
+        siftDown(0);
+    }
+}
+
+void
+SpaceSavingSketch::merge(const SpaceSavingSketch &other)
+{
+    if (other._capacity != _capacity) {
+        throw std::runtime_error("Can not merge space saving sketches with different capacity");
+    }
+    uint64_t myMin = minCount();
+    uint64_t otherMin = other.minCount();
+    std::vector<Counter> merged;
+    merged.reserve(_counters.size() + other._counters.size());
+    for (Counter &counter : _counters) {
+        auto found = other._index.find(counter.value.get());
+        if (found != other._index.end()) {
+            const Counter &match = other._counters[found->second];
+            counter.count += match.count;
+            counter.error += match.error;
+        } else {
+            counter.count += otherMin;
+            counter.error += otherMin;
+        }
+        merged.push_back(std::move(counter));
+    }
+    for (const Counter &counter : other._counters) {
+        if (_index.find(counter.value.get()) == _index.end()) {
+            merged.emplace_back(*counter.value, counter.count + myMin, counter.error + myMin);
+        }
+    }
+    if (merged.size() > _capacity) {
+        std::nth_element(merged.begin(), merged.begin() + _capacity, merged.end(), HigherCount());
+        merged.resize(_capacity);
+    }
+    std::make_heap(merged.begin(), merged.end(),
+                   [](const Counter &a, const Counter &b) { return (a.count > b.count); });
+    _counters = std::move(merged);
+    _total += other._total;
+    rebuildIndex();
+}
+
+std::vector<const SpaceSavingSketch::Counter *>
+SpaceSavingSketch::getTopK() const
+{
+    std::vector<const Counter *> result;
+    result.reserve(_counters.size());
+    for (const Counter &counter : _counters) {
+        result.push_back(&counter);
+    }
+    std::sort(result.begin(), result.end(), [](const Counter *a, const Counter *b) { return HigherCount()(*a, *b); });
+    return result;
+}
+
+void
+SpaceSavingSketch::serialize(vespalib::Serializer &os) const
+{
+    os << _capacity << _total << static_cast<uint32_t>(_counters.size());
+    for (const Counter &counter : _counters) {
+        os << counter.value << counter.count << counter.error;
+    }
+}
+
+void
+SpaceSavingSketch::deserialize(vespalib::Deserializer &is)
+{
+    uint32_t size;
+    is >> _capacity >> _total >> size;
+    _counters.clear();
+    _counters.resize(size);
+    for (Counter &counter : _counters) {
+        is >> counter.value >> counter.count >> counter.error;
+    }
+    rebuildIndex();
+}
+
+bool
+SpaceSavingSketch::operator==(const SpaceSavingSketch &other) const
+{
+    return ((_capacity == other._capacity) &&
+            (_total == other._total) &&
+            (_counters == other._counters));
+}
+
+}  // namespace search
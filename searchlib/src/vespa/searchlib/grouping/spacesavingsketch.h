@@ -0,0 +1,85 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/searchlib/expression/resultnode.h>
+#include <vespa/vespalib/objects/deserializer.h>
+#include <vespa/vespalib/objects/serializer.h>
+#include <unordered_map>
+#include <vector>
+
+namespace search {
+
+/**
+ * Space-Saving sketch used to find the most frequent values of a
+ * stream in bounded memory. At most 'capacity' values are tracked.
+ * When a new value is seen and the sketch is full, the value with the
+ * lowest count is replaced, and the new value inherits its count as
+ * the possible overestimation (error). The counters are kept as a
+ * min-heap on count to make replacement cheap. Sketches can be merged
+ * following Agarwal et al, "Mergeable Summaries"; a value missing from
+ * a full sketch is assumed to have the minimum count of that sketch.
+ */
+class SpaceSavingSketch {
+public:
+    static constexpr uint32_t DEFAULT_CAPACITY = 64;
+
+    struct Counter {
+        expression::ResultNode::CP value;
+        uint64_t count;
+        uint64_t error; // upper bound of the overestimation of count
+        Counter() : value(), count(0), error(0) {}
+        Counter(const expression::ResultNode &value_in, uint64_t count_in, uint64_t error_in);
+        bool operator==(const Counter &rhs) const;
+    };
+
+private:
+    struct ValueHash {
+        size_t operator()(const expression::ResultNode *value) const { return value->hash(); }
+    };
+    struct ValueEqual {
+        bool operator()(const expression::ResultNode *a, const expression::ResultNode *b) const {
+            return (a->cmp(*b) == 0);
+        }
+    };
+    using Index = std::unordered_map<const expression::ResultNode *, uint32_t, ValueHash, ValueEqual>;
+
+    uint32_t             _capacity;
+    uint64_t             _total;
+    std::vector<Counter> _counters;
+    Index                _index;
+
+    bool isFull() const { return (_counters.size() >= _capacity); }
+    uint64_t minCount() const { return isFull() ? _counters[0].count : 0; }
+    void swapCounters(uint32_t a, uint32_t b);
+    void siftUp(uint32_t pos);
+    void siftDown(uint32_t pos);
+    void rebuildIndex();
+
+public:
+    explicit SpaceSavingSketch(uint32_t capacity = DEFAULT_CAPACITY);
+    SpaceSavingSketch(const SpaceSavingSketch &rhs);
+    SpaceSavingSketch & operator = (const SpaceSavingSketch &rhs);
+    SpaceSavingSketch(SpaceSavingSketch &&) = default;
+    SpaceSavingSketch & operator = (SpaceSavingSketch &&) = default;
+    ~SpaceSavingSketch();
+
+    void add(const expression::ResultNode &value, uint64_t weight = 1);
+    void merge(const SpaceSavingSketch &other);
+
+    /**
+     * The tracked values ordered by decreasing estimated count.
+     **/
+    std::vector<const Counter *> getTopK() const;
+
+    uint32_t getCapacity() const { return _capacity; }
+    uint64_t getTotal() const { return _total; }
+    size_t getSize() const { return _counters.size(); }
+
+    void serialize(vespalib::Serializer &os) const;
+    void deserialize(vespalib::Deserializer &is);
+
+    bool operator==(const SpaceSavingSketch &other) const;
+};
+
+}  // namespace search
@@ -9,6 +9,7 @@
 #include <vespa/document/annotation/alternatespanlist.h>
 #include <vespa/searchlib/util/url.h>
 #include <stdexcept>
+#include <atomic>
 #include <vespa/vespalib/text/utf8.h>
 #include <vespa/vespalib/text/lowercase.h>
 #include <vespa/searchlib/common/sort.h>
@@ -45,37 +46,91 @@ using vespalib::make_string;
 using search::util::URL;
 
 
+namespace {
+
+/*
+ * Pushes the partitioned inverters of a field to the field index
+ * when all partitions have been sorted.
+ */
+class PushPartitionsTask
+{
+    std::vector<FieldInverter *> _inverters; // remove inverter first
+    MemoryFieldIndex &_fieldIndex;
+    std::shared_ptr<IDestructorCallback> _onWriteDone;
+    std::atomic<uint32_t> _pendingPartitions;
+
+public:
+    PushPartitionsTask(std::vector<FieldInverter *> inverters,
+                       MemoryFieldIndex &fieldIndex,
+                       const std::shared_ptr<IDestructorCallback> &onWriteDone)
+        : _inverters(std::move(inverters)),
+          _fieldIndex(fieldIndex),
+          _onWriteDone(onWriteDone),
+          _pendingPartitions(_inverters.size() - 1)
+    {
+    }
+
+    /*
+     * Returns true when the last partition has been sorted.
+     */
+    bool partitionSorted() { return --_pendingPartitions == 0; }
+
+    void run() {
+        FieldInverter &removeInverter(*_inverters[0]);
+        for (size_t i = 1; i < _inverters.size(); ++i) {
+            _inverters[i]->applyRemoves(_fieldIndex.getDocumentRemover(), removeInverter);
+        }
+        removeInverter.sortPositions();
+        FieldInverter::pushDocuments(_inverters, _fieldIndex.getInserter());
+        _fieldIndex.commit();
+    }
+};
+
+}
+
+
 DocumentInverter::DocumentInverter(const Schema &schema,
                                    ISequencedTaskExecutor &invertThreads,
-                                   ISequencedTaskExecutor &pushThreads)
+                                   ISequencedTaskExecutor &pushThreads,
+                                   uint32_t numPartitions)
     : _schema(schema),
       _indexedFieldPaths(),
       _dataType(nullptr),
       _schemaIndexFields(),
+      _numPartitions(std::max(1u, numPartitions)),
       _inverters(),
       _urlInverters(),
+      _removeInverters(),
       _invertThreads(invertThreads),
       _pushThreads(pushThreads)
 {
     _schemaIndexFields.setup(schema);
 
-    for (uint32_t fieldId = 0; fieldId < _schema.getNumIndexFields();
-         ++fieldId) {
-        _inverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId));
+    for (uint32_t partition = 0; partition < _numPartitions; ++partition) {
+        for (uint32_t fieldId = 0; fieldId < _schema.getNumIndexFields();
+             ++fieldId) {
+            _inverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId));
+        }
+        for (auto &urlField : _schemaIndexFields._uriFields) {
+            Schema::CollectionType collectionType =
+                _schema.getIndexField(urlField._all).getCollectionType();
+            _urlInverters.push_back(std::make_unique<UrlFieldInverter>
+                                    (collectionType,
+                                     getInverter(urlField._all, partition),
+                                     getInverter(urlField._scheme, partition),
+                                     getInverter(urlField._host, partition),
+                                     getInverter(urlField._port, partition),
+                                     getInverter(urlField._path, partition),
+                                     getInverter(urlField._query, partition),
+                                     getInverter(urlField._fragment, partition),
+                                     getInverter(urlField._hostname, partition)));
+        }
     }
-    for (auto &urlField : _schemaIndexFields._uriFields) {
-        Schema::CollectionType collectionType =
-            _schema.getIndexField(urlField._all).getCollectionType();
-        _urlInverters.push_back(std::make_unique<UrlFieldInverter>
-                                (collectionType,
-                                 _inverters[urlField._all].get(),
-                                 _inverters[urlField._scheme].get(),
-                                 _inverters[urlField._host].get(),
-                                 _inverters[urlField._port].get(),
-                                 _inverters[urlField._path].get(),
-                                 _inverters[urlField._query].get(),
-                                 _inverters[urlField._fragment].get(),
-                                 _inverters[urlField._hostname].get()));
+    if (_numPartitions > 1) {
+        for (uint32_t fieldId = 0; fieldId < _schema.getNumIndexFields();
+             ++fieldId) {
+            _removeInverters.push_back(std::make_unique<FieldInverter>(_schema, fieldId));
+        }
     }
 }
 
@@ -129,6 +184,8 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
     if (_indexedFieldPaths.empty() || _dataType != dataType) {
         buildFieldPath(doc.getType(), dataType);
     }
+    const uint32_t partition = getPartition(docId);
+    const uint32_t componentBase = partition * getNumFields();
     for (uint32_t fieldId : _schemaIndexFields._textFields) {
         const FieldPath *const fieldPath(_indexedFieldPaths[fieldId].get());
         FieldValue::UP fv;
@@ -137,12 +194,12 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
             // FieldValue::UP fv = doc.getNestedFieldValue(fieldPath.begin(), fieldPath.end());
             fv = doc.getValue(*fieldPath);
         }
-        FieldInverter *inverter = _inverters[fieldId].get();
-        _invertThreads.execute(fieldId,
+        FieldInverter *inverter = getInverter(fieldId, partition);
+        _invertThreads.execute(componentBase + fieldId,
                                [inverter, docId, fv(std::move(fv))]()
                                { inverter->invertField(docId, fv); });
     }
-    uint32_t urlId = 0;
+    uint32_t urlId = partition * _schemaIndexFields._uriFields.size();
     for (const auto & fi : _schemaIndexFields._uriFields) {
         uint32_t fieldId = fi._all;
         const FieldPath *const fieldPath(_indexedFieldPaths[fieldId].get());
@@ -153,7 +210,7 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
             fv = doc.getValue(*fieldPath);
         }
         UrlFieldInverter *inverter = _urlInverters[urlId].get();
-        _invertThreads.execute(fieldId,
+        _invertThreads.execute(componentBase + fieldId,
                                [inverter, docId, fv(std::move(fv))]()
                                { inverter->invertField(docId, fv); });
         ++urlId;
@@ -164,17 +221,19 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc)
 void
 DocumentInverter::removeDocument(uint32_t docId)
 {
+    const uint32_t partition = getPartition(docId);
+    const uint32_t componentBase = partition * getNumFields();
     for (uint32_t fieldId : _schemaIndexFields._textFields) {
-        FieldInverter *inverter = _inverters[fieldId].get();
-        _invertThreads.execute(fieldId,
+        FieldInverter *inverter = getInverter(fieldId, partition);
+        _invertThreads.execute(componentBase + fieldId,
                                [inverter, docId]()
                                { inverter->removeDocument(docId); });
     }
-    uint32_t urlId = 0;
+    uint32_t urlId = partition * _schemaIndexFields._uriFields.size();
     for (const auto & fi : _schemaIndexFields._uriFields) {
         uint32_t fieldId = fi._all;
         UrlFieldInverter *inverter = _urlInverters[urlId].get();
-        _invertThreads.execute(fieldId,
+        _invertThreads.execute(componentBase + fieldId,
                                [inverter, docId]()
                                { inverter->removeDocument(docId); });
         ++urlId;
@@ -187,6 +246,10 @@ DocumentInverter::pushDocuments(Dictionary &dict,
                                 const std::shared_ptr<IDestructorCallback> &
                                 onWriteDone)
 {
+    if (_numPartitions > 1) {
+        pushPartitionedDocuments(dict, onWriteDone);
+        return;
+    }
     auto indexFieldIterator = dict.getFieldIndexes().begin();
     uint32_t fieldId = 0;
     for (auto &inverter : _inverters) {
@@ -204,5 +267,44 @@ DocumentInverter::pushDocuments(Dictionary &dict,
     }
 }
 
+
+
+void
+DocumentInverter::pushPartitionedDocuments(Dictionary &dict,
+                                           const std::shared_ptr<IDestructorCallback> &
+                                           onWriteDone)
+{
+    // Caller has drained the invert and push threads. Partitions are
+    // sorted in parallel by the invert threads, and the last partition
+    // of a field to be sorted schedules the merge and the removes
+    // (which depend on earlier pushes) on the push threads.
+    ISequencedTaskExecutor &pushThreads(_pushThreads);
+    auto indexFieldIterator = dict.getFieldIndexes().begin();
+    for (uint32_t fieldId = 0; fieldId < getNumFields(); ++fieldId) {
+        MemoryFieldIndex &fieldIndex(**indexFieldIterator);
+        // Removes come first, to be pushed before adds of the same docId
+        std::vector<FieldInverter *> inverters;
+        inverters.push_back(_removeInverters[fieldId].get());
+        for (uint32_t partition = 0; partition < _numPartitions; ++partition) {
+            inverters.push_back(getInverter(fieldId, partition));
+        }
+        auto task = std::make_shared<PushPartitionsTask>(std::move(inverters), fieldIndex,
+                                                         onWriteDone);
+        // Executor ids must be resolved here, since only the committing
+        // thread may map component ids to executor ids.
+        uint32_t pushExecutorId = pushThreads.getExecutorId(fieldId);
+        for (uint32_t partition = 0; partition < _numPartitions; ++partition) {
+            _invertThreads.execute(partition * getNumFields() + fieldId,
+                                   [inverter(getInverter(fieldId, partition)), task,
+                                    &pushThreads, pushExecutorId]()
+                                   { inverter->sortPositions();
+                                       if (task->partitionSorted()) {
+                                           pushThreads.executeLambda(pushExecutorId,
+                                                                     [task]() { task->run(); });
+                                       } });
+        }
+        ++indexFieldIterator;
+    }
 }
 
+}
@@ -58,11 +58,28 @@ private:
 
     DocTypeBuilder::SchemaIndexFields  _schemaIndexFields;
 
+    /*
+     * Documents are spread over _numPartitions inverters per field
+     * based on docId, allowing a field to be inverted by several
+     * threads.  Inverters are stored partition by partition, with
+     * partition 0 first.  With more than one partition, removes are
+     * collected in separate inverters when pushing.
+     */
+    uint32_t _numPartitions;
     std::vector<std::unique_ptr<FieldInverter>> _inverters;
     std::vector<std::unique_ptr<UrlFieldInverter>> _urlInverters;
+    std::vector<std::unique_ptr<FieldInverter>> _removeInverters;
     ISequencedTaskExecutor &_invertThreads;
     ISequencedTaskExecutor &_pushThreads;
 
+    uint32_t getPartition(uint32_t docId) const {
+        return docId % _numPartitions;
+    }
+
+    void
+    pushPartitionedDocuments(Dictionary &dict,
+                             const std::shared_ptr<IDestructorCallback> &onWriteDone);
+
     /**
      * Obtain the schema used by this index.
      *
@@ -79,10 +96,12 @@ public:
      * Create a new memory index based on the given schema.
      *
      * @param schema the index schema to use
+     * @param numPartitions number of inverters per field
      */
     DocumentInverter(const index::Schema &schema,
                      ISequencedTaskExecutor &invertThreads,
-                     ISequencedTaskExecutor &pushThreads);
+                     ISequencedTaskExecutor &pushThreads,
+                     uint32_t numPartitions = 1);
 
     ~DocumentInverter();
 
@@ -116,10 +135,16 @@ public:
         return _inverters[fieldId].get();
     }
 
+    FieldInverter *getInverter(uint32_t fieldId, uint32_t partition) const {
+        return _inverters[partition * getNumFields() + fieldId].get();
+    }
+
     const std::vector<std::unique_ptr<FieldInverter> > &
     getInverters() const { return _inverters; }
 
-    uint32_t getNumFields() const { return _inverters.size(); }
+    uint32_t getNumFields() const { return _schema.getNumIndexFields(); }
+
+    uint32_t getNumPartitions() const { return _numPartitions; }
 };
 
 } // namespace memoryindex
@@ -478,21 +478,28 @@ struct FullRadix {
 
 void
 FieldInverter::applyRemoves(DocumentRemover &remover)
+{
+    applyRemoves(remover, *this);
+}
+
+
+void
+FieldInverter::applyRemoves(DocumentRemover &remover,
+                            IDocumentRemoveListener &listener)
 {
     for (auto docId : _removeDocs) {
-        remover.remove(docId, *this);
+        remover.remove(docId, listener);
     }
     _removeDocs.clear();
 }
 
 
 void
-FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
+FieldInverter::sortPositions()
 {
     trimAbortedDocs();
 
     if (_positions.empty()) {
-        reset();
         return;             // All documents with words aborted
     }
 
@@ -501,51 +508,39 @@ FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
     // Sort for terms.
     ShiftBasedRadixSorter<PosInfo, FullRadix, std::less<PosInfo>, 56, true>::
         radix_sort(FullRadix(), std::less<PosInfo>(), &_positions[0], _positions.size(), 16);
+}
+
 
+uint32_t
+FieldInverter::pushDoc(uint32_t idx, IOrderedDocumentInserter &inserter)
+{
     constexpr uint32_t NO_ELEMENT_ID = std::numeric_limits<uint32_t>::max();
     constexpr uint32_t NO_WORD_POS = std::numeric_limits<uint32_t>::max();
-    uint32_t lastWordNum = 0;
-    uint32_t lastElemId = 0;
-    uint32_t lastWordPos = 0;
-    uint32_t numWordIds = _wordRefs.size() - 1;
-    uint32_t lastDocId = 0;
-    vespalib::stringref word;
-    bool emptyFeatures = true;
-
-    inserter.rewind();
-
-    for (auto &i : _positions) {
-        assert(i._wordNum <= numWordIds);
-        (void) numWordIds;
-        if (lastWordNum != i._wordNum || lastDocId != i._docId) {
-            if (!emptyFeatures) {
-                inserter.add(lastDocId, _features);
-                emptyFeatures = true;
-            }
-            if (lastWordNum != i._wordNum) {
-                lastWordNum = i._wordNum;
-                word = getWordFromNum(lastWordNum);
-                inserter.setNextWord(word);
-            }
-            lastDocId = i._docId;
-            if (i.removed()) {
-                inserter.remove(lastDocId);
-                continue;
-            }
-        }
-        if (emptyFeatures) {
-            if (!i.removed()) {
-                emptyFeatures = false;
-                _features.clear(lastDocId);
-                lastElemId = NO_ELEMENT_ID;
-                lastWordPos = NO_WORD_POS;
-            } else {
-                continue; // ignore dup remove
-            }
-        } else {
-            // removes must come before non-removes
-            assert(!i.removed());
-        }
+    const uint32_t posEnd = _positions.size();
+    const uint32_t wordNum = _positions[idx]._wordNum;
+    const uint32_t docId = _positions[idx]._docId;
+    auto sameDoc = [&](uint32_t i) {
+        return ((i < posEnd) &&
+                (_positions[i]._wordNum == wordNum) &&
+                (_positions[i]._docId == docId));
+    };
+
+    if (_positions[idx].removed()) {
+        inserter.remove(docId);
+        do {
+            ++idx; // ignore dup remove
+        } while (sameDoc(idx) && _positions[idx].removed());
+    }
+    if (!sameDoc(idx)) {
+        return idx;
+    }
+    _features.clear(docId);
+    uint32_t lastElemId = NO_ELEMENT_ID;
+    uint32_t lastWordPos = NO_WORD_POS;
+    for (; sameDoc(idx); ++idx) {
+        const PosInfo &i = _positions[idx];
+        // removes must come before non-removes
+        assert(!i.removed());
         const ElemInfo &elem = _elems[i._elemRef];
         if (i._wordPos != lastWordPos || i._elemId != lastElemId) {
             _features.addNextOcc(i._elemId, i._wordPos,
@@ -556,15 +551,125 @@ FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
             // silently ignore duplicate annotations
         }
     }
+    inserter.add(docId, _features);
+    return idx;
+}
+
+
+void
+FieldInverter::pushDocuments(IOrderedDocumentInserter &inserter)
+{
+    sortPositions();
+
+    if (_positions.empty()) {
+        reset();
+        return;             // All documents with words aborted
+    }
 
-    if (!emptyFeatures) {
-        inserter.add(lastDocId, _features);
+    uint32_t lastWordNum = 0;
+    uint32_t numWordIds = _wordRefs.size() - 1;
+    const uint32_t posEnd = _positions.size();
+
+    inserter.rewind();
+
+    uint32_t idx = 0;
+    while (idx < posEnd) {
+        uint32_t wordNum = _positions[idx]._wordNum;
+        assert(wordNum <= numWordIds);
+        (void) numWordIds;
+        if (wordNum != lastWordNum) {
+            lastWordNum = wordNum;
+            inserter.setNextWord(getWordFromNum(wordNum));
+        }
+        idx = pushDoc(idx, inserter);
     }
     inserter.flush();
     reset();
 }
 
 
+namespace {
+
+/*
+ * Next (word, docId) group in the sorted positions of one of the
+ * inverters being merged.
+ */
+struct MergeCursor {
+    const char *_word;
+    uint32_t    _docId;
+    uint32_t    _idx;
+    uint32_t    _inverterIdx;
+
+    MergeCursor(uint32_t inverterIdx)
+        : _word(nullptr),
+          _docId(0),
+          _idx(0),
+          _inverterIdx(inverterIdx)
+    {
+    }
+
+    // Heap order, smallest (word, docId) on top.
+    bool
+    operator<(const MergeCursor &rhs) const
+    {
+        int cmpres = strcmp(_word, rhs._word);
+        if (cmpres != 0) {
+            return cmpres > 0;
+        }
+        if (_docId != rhs._docId) {
+            return _docId > rhs._docId;
+        }
+        return _inverterIdx > rhs._inverterIdx;
+    }
+};
+
+}
+
+
+void
+FieldInverter::pushDocuments(const std::vector<FieldInverter *> &inverters,
+                             IOrderedDocumentInserter &inserter)
+{
+    std::vector<MergeCursor> heap;
+    for (uint32_t i = 0; i < inverters.size(); ++i) {
+        const FieldInverter &inverter = *inverters[i];
+        if (!inverter._positions.empty()) {
+            heap.emplace_back(i);
+            const PosInfo &pos = inverter._positions[0];
+            heap.back()._word = inverter.getWordFromNum(pos._wordNum);
+            heap.back()._docId = pos._docId;
+        }
+    }
+    if (!heap.empty()) {
+        std::make_heap(heap.begin(), heap.end());
+        const char *lastWord = nullptr;
+        inserter.rewind();
+        while (!heap.empty()) {
+            std::pop_heap(heap.begin(), heap.end());
+            MergeCursor &cursor = heap.back();
+            FieldInverter &inverter = *inverters[cursor._inverterIdx];
+            if (lastWord == nullptr || strcmp(lastWord, cursor._word) != 0) {
+                lastWord = cursor._word;
+                inserter.setNextWord(lastWord);
+            }
+            cursor._idx = inverter.pushDoc(cursor._idx, inserter);
+            if (cursor._idx < inverter._positions.size()) {
+                const PosInfo &pos = inverter._positions[cursor._idx];
+                cursor._word = inverter.getWordFromNum(pos._wordNum);
+                cursor._docId = pos._docId;
+                std::push_heap(heap.begin(), heap.end());
+            } else {
+                heap.pop_back();
+            }
+        }
+        inserter.flush();
+    }
+    for (auto inverter : inverters) {
+        inverter->reset();
+    }
+}
+
+
 } // namespace memoryindex
 
 } // namespace search
@@ -354,6 +354,16 @@ private:
     void
     trimAbortedDocs();
 
+    /*
+     * Push the (word, docId) group starting at the given index in
+     * sorted _positions to the inserter. The caller has already set
+     * the word.
+     *
+     * @return index of the next group
+     */
+    uint32_t
+    pushDoc(uint32_t idx, IOrderedDocumentInserter &inserter);
+
     /*
      * Abort a pending document that has already been inverted.
      *
@@ -380,6 +390,24 @@ public:
     void
     applyRemoves(DocumentRemover &remover);
 
+    /*
+     * Apply pending removes, saving the removed words in another
+     * inverter.
+     *
+     * @param remover    document remover
+     * @param listener   inverter receiving the removed words
+     */
+    void
+    applyRemoves(DocumentRemover &remover, IDocumentRemoveListener &listener);
+
+    /*
+     * Trim aborted documents, then sort words and positions.  Used to
+     * prepare the inverters for a field for pushDocuments() below,
+     * this can be done in parallel for the inverters.
+     */
+    void
+    sortPositions();
+
     /**
      * Push inverted documents to memory index structure.
      *
@@ -391,6 +419,20 @@ public:
     void
     pushDocuments(IOrderedDocumentInserter &inserter);
 
+    /**
+     * Push inverted documents from several inverters for the same
+     * field to memory index structure, merging them on (word, docId).
+     * All inverters must have been sorted by sortPositions(), and a
+     * docId must only be present in one of them, except that removes
+     * may be held by a separate inverter placed before the others.
+     *
+     * @param inverters inverters to merge
+     * @param inserter  ordered document inserter
+     */
+    static void
+    pushDocuments(const std::vector<FieldInverter *> &inverters,
+                  IOrderedDocumentInserter &inserter);
+
     /*
      * Invert a normal text field, based on annotations.
      */
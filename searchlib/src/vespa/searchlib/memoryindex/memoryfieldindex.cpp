@@ -74,7 +74,7 @@ MemoryFieldIndex::PostingList::Iterator
 MemoryFieldIndex::find(const vespalib::stringref word) const
 {
     DictionaryTree::Iterator itr =
-        _dict.find(WordKey(datastore::EntryRef()),
+        _dict.find(WordKey(),
                   KeyComp(_wordStore, word));
     if (itr.valid()) {
         return _postingListStore.begin(itr.getData());
@@ -86,7 +86,7 @@ MemoryFieldIndex::PostingList::ConstIterator
 MemoryFieldIndex::findFrozen(const vespalib::stringref word) const
 {
     DictionaryTree::ConstIterator itr =
-        _dict.getFrozenView().find(WordKey(datastore::EntryRef()),
+        _dict.getFrozenView().find(WordKey(),
                                    KeyComp(_wordStore, word));
     if (itr.valid()) {
         return _postingListStore.beginFrozen(itr.getData());
@@ -32,11 +32,41 @@ public:
     typedef PostingListStore::KeyDataType PostingListKeyDataType;
 
 
+    /*
+     * Dictionary key. The first 8 bytes of the word are kept inline as
+     * a prefix, ordered the same way as strcmp orders the words, so
+     * most comparisons during btree descent are resolved without
+     * reading the word from the word store. The prefix is split in two
+     * halves to keep the key 4 byte aligned.
+     */
     struct WordKey {
         datastore::EntryRef _wordRef;
+        uint32_t            _prefixHigh;
+        uint32_t            _prefixLow;
 
-        explicit WordKey(datastore::EntryRef wordRef) : _wordRef(wordRef) { }
-        WordKey() : _wordRef() { }
+        WordKey(datastore::EntryRef wordRef, uint64_t prefix)
+            : _wordRef(wordRef),
+              _prefixHigh(prefix >> 32),
+              _prefixLow(prefix & 0xffffffffu)
+        { }
+        WordKey() : _wordRef(), _prefixHigh(0), _prefixLow(0) { }
+
+        static constexpr size_t PREFIX_BYTES = sizeof(uint64_t);
+
+        uint64_t getPrefix() const { return (static_cast<uint64_t>(_prefixHigh) << 32) | _prefixLow; }
+
+        static uint64_t
+        makePrefix(const vespalib::stringref word)
+        {
+            uint64_t prefix = 0;
+            for (size_t i = 0; i < PREFIX_BYTES; ++i) {
+                prefix <<= 8;
+                if (i < word.size()) {
+                    prefix |= static_cast<unsigned char>(word[i]);
+                }
+            }
+            return prefix;
+        }
 
         friend vespalib::asciistream &
         operator<<(vespalib::asciistream & os, const WordKey & rhs);
@@ -46,6 +76,7 @@ public:
     private:
         const WordStore           &_wordStore;
         const vespalib::stringref  _word;
+        const uint64_t             _wordPrefix;
 
         const char *
         getWord(datastore::EntryRef wordRef) const
@@ -56,16 +87,33 @@ public:
             return _word.c_str();
         }
 
+        uint64_t
+        getPrefix(const WordKey & key) const
+        {
+            return key._wordRef.valid() ? key.getPrefix() : _wordPrefix;
+        }
+
     public:
         KeyComp(const WordStore &wordStore, const vespalib::stringref word)
             : _wordStore(wordStore),
-              _word(word)
+              _word(word),
+              _wordPrefix(WordKey::makePrefix(word))
         { }
 
         bool
         operator()(const WordKey & lhs, const WordKey & rhs) const
         {
-            int cmpres = strcmp(getWord(lhs._wordRef), getWord(rhs._wordRef));
+            uint64_t lhsPrefix = getPrefix(lhs);
+            uint64_t rhsPrefix = getPrefix(rhs);
+            if (lhsPrefix != rhsPrefix) {
+                return lhsPrefix < rhsPrefix;
+            }
+            if ((lhsPrefix & 0xff) == 0) {
+                // Both words end within the prefix, i.e. they are equal
+                return false;
+            }
+            int cmpres = strcmp(getWord(lhs._wordRef) + WordKey::PREFIX_BYTES,
+                                getWord(rhs._wordRef) + WordKey::PREFIX_BYTES);
             return cmpres < 0;
         }
     };
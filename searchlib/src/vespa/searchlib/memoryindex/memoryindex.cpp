@@ -47,14 +47,28 @@ using queryeval::IRequestContext;
 
 namespace memoryindex {
 
+namespace {
+
+uint32_t
+selectInvertPartitions(const Schema &schema,
+                       const ISequencedTaskExecutor &invertThreads)
+{
+    uint32_t numFields = std::max(1u, schema.getNumIndexFields());
+    return std::max(1u, invertThreads.getNumExecutors() / numFields);
+}
+
+}
+
 MemoryIndex::MemoryIndex(const Schema &schema,
                          ISequencedTaskExecutor &invertThreads,
                          ISequencedTaskExecutor &pushThreads)
     : _schema(schema),
       _invertThreads(invertThreads),
       _pushThreads(pushThreads),
-      _inverter0(_schema, _invertThreads, _pushThreads),
-      _inverter1(_schema, _invertThreads, _pushThreads),
+      _inverter0(_schema, _invertThreads, _pushThreads,
+                 selectInvertPartitions(_schema, _invertThreads)),
+      _inverter1(_schema, _invertThreads, _pushThreads,
+                 _inverter0.getNumPartitions()),
       _inverter(&_inverter0),
       _dictionary(_schema),
       _frozen(false),
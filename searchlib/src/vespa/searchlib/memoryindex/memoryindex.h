@@ -70,7 +70,9 @@ public:
     typedef std::shared_ptr<MemoryIndex> SP;
 
     /**
-     * Create a new memory index based on the given schema.
+     * Create a new memory index based on the given schema.  When there
+     * are more invert threads than index fields, documents are spread
+     * over several inverters per field so all threads can be used.
      *
      * @param schema the index schema to use
      **/
@@ -118,7 +120,8 @@ public:
      * them searchable. When commit is completed, onWriteDone goes out
      * of scope, scheduling completion callback.
      *
-     * Callers can call pushThreads.sync() to wait for push completion.
+     * Callers can call invertThreads.sync() followed by
+     * pushThreads.sync() to wait for push completion.
      **/
     void commit(const std::shared_ptr<IDestructorCallback> &onWriteDone);
 
@@ -41,4 +41,33 @@ public:
     int32_t getMaxWeight() const { return _maxWeight; }
 };
 
+
+/**
+ * Class for getting the max weight of the posting list block containing
+ * the current document of the search iterator exposing this info, in
+ * addition to the min and max weights of the whole posting list.
+ *
+ * The block information is updated by the search iterator as it moves
+ * through the posting list, and is used by block-max WAND to skip
+ * documents that cannot get a score high enough to enter the heap.
+ */
+class BlockMaxPostingInfo : public MinMaxPostingInfo {
+private:
+    uint32_t _blockLastDocId;
+    int32_t  _blockMaxWeight;
+
+public:
+    BlockMaxPostingInfo(int32_t minWeight, int32_t maxWeight, uint32_t lastDocId)
+        : MinMaxPostingInfo(minWeight, maxWeight),
+          _blockLastDocId(lastDocId),
+          _blockMaxWeight(maxWeight)
+    {}
+    void setBlock(uint32_t lastDocId, int32_t maxWeight) {
+        _blockLastDocId = lastDocId;
+        _blockMaxWeight = maxWeight;
+    }
+    uint32_t getBlockLastDocId() const { return _blockLastDocId; }
+    int32_t getBlockMaxWeight() const { return _blockMaxWeight; }
+};
+
 }
@@ -21,7 +21,7 @@ namespace wand {
 namespace { bool should_monitor_wand() { return LOG_WOULD_LOG(spam); } }
 
 
-template <typename VectorizedTerms, typename FutureHeap, typename PastHeap, bool IS_STRICT>
+template <typename VectorizedTerms, typename FutureHeap, typename PastHeap, bool IS_STRICT, bool USE_BLOCK_MAX = false>
 class ParallelWeakAndSearchImpl : public ParallelWeakAndSearch
 {
 private:
@@ -44,7 +44,9 @@ private:
     void seek_strict(uint32_t docid) {
         _algo.set_candidate(_terms, _heaps, docid);
         while (_algo.solve_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
-            if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
+            if (USE_BLOCK_MAX && !_algo.check_block_max_score(_terms, _heaps, DotProductScorer(), GreaterThan(_boostedThreshold))) {
+                _algo.skip_blocks(_terms, _heaps);
+            } else if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
                 setDocId(_algo.get_candidate());
                 return;
             } else {
@@ -58,7 +60,9 @@ private:
         if (docid > _algo.get_candidate()) {
             _algo.set_candidate(_terms, _heaps, docid);
             if (_algo.check_wand_constraint(_terms, _heaps, GreaterThan(_boostedThreshold))) {
-                if (_algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold))) {
+                if ((!USE_BLOCK_MAX || _algo.check_block_max_score(_terms, _heaps, DotProductScorer(), GreaterThan(_boostedThreshold))) &&
+                    _algo.check_score(_terms, _heaps, DotProductScorer(), GreaterThan(_threshold)))
+                {
                     setDocId(_algo.get_candidate());
                 }
             }
@@ -127,21 +131,33 @@ insertMonitoringSearchIterator(const wand::Terms &terms)
     return retval;
 }
 
-template <typename FutureHeap, typename PastHeap, bool IS_STRICT>
+bool
+hasBlockMaxInfo(const wand::Terms &terms)
+{
+    TermInput input(terms);
+    for (size_t i = 0; i < input.size(); ++i) {
+        if (input.get_block_max_info(i) != nullptr) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename FutureHeap, typename PastHeap, bool IS_STRICT, bool USE_BLOCK_MAX>
 SearchIterator *
 createWand(const wand::Terms &terms,
            const ParallelWeakAndSearch::MatchParams &matchParams,
            ParallelWeakAndSearch::RankParams &&rankParams)
 {
-    typedef ParallelWeakAndSearchImpl<VectorizedIteratorTerms, FutureHeap, PastHeap, IS_STRICT> WandType;
+    typedef ParallelWeakAndSearchImpl<VectorizedIteratorTerms, FutureHeap, PastHeap, IS_STRICT, USE_BLOCK_MAX> WandType;
     if (should_monitor_wand()) {
         wand::Terms termsWithMonitoring = insertMonitoringSearchIterator(terms);
         MonitoringSearchIterator::UP monitoringIterator =
             MonitoringSearchIterator::UP(new MonitoringSearchIterator
-            (make_string("PWAND(%u,%" PRId64 "),strict=%u",
+            (make_string("PWAND(%u,%" PRId64 "),strict=%u,blockmax=%u",
                          matchParams.scores.getScoresToTrack(),
                          matchParams.scoreThreshold,
-                         IS_STRICT),
+                         IS_STRICT, USE_BLOCK_MAX),
              SearchIterator::UP(new WandType(rankParams.rootMatchData,
                                              VectorizedIteratorTerms(termsWithMonitoring,
                                                      DotProductScorer(),
@@ -159,6 +175,25 @@ createWand(const wand::Terms &terms,
                         matchParams);
 }
 
+template <typename FutureHeap, typename PastHeap>
+SearchIterator *
+createWandForTerms(const wand::Terms &terms,
+                   const ParallelWeakAndSearch::MatchParams &matchParams,
+                   ParallelWeakAndSearch::RankParams &&rankParams,
+                   bool strict)
+{
+    bool useBlockMax = hasBlockMaxInfo(terms);
+    if (strict) {
+        return useBlockMax
+            ? createWand<FutureHeap, PastHeap, true, true>(terms, matchParams, std::move(rankParams))
+            : createWand<FutureHeap, PastHeap, true, false>(terms, matchParams, std::move(rankParams));
+    } else {
+        return useBlockMax
+            ? createWand<FutureHeap, PastHeap, false, true>(terms, matchParams, std::move(rankParams))
+            : createWand<FutureHeap, PastHeap, false, false>(terms, matchParams, std::move(rankParams));
+    }
+}
+
 } // namespace search::queryeval::wand::<unnamed>
 
 } // namespace search::queryeval::wand
@@ -169,11 +204,7 @@ ParallelWeakAndSearch::createArrayWand(const Terms &terms,
                                        RankParams &&rankParams,
                                        bool strict)
 {
-    if (strict) {
-        return wand::createWand<vespalib::LeftArrayHeap, vespalib::RightArrayHeap, true>(terms, matchParams, std::move(rankParams));
-    } else {
-        return wand::createWand<vespalib::LeftArrayHeap, vespalib::RightArrayHeap, false>(terms, matchParams, std::move(rankParams));
-    }
+    return wand::createWandForTerms<vespalib::LeftArrayHeap, vespalib::RightArrayHeap>(terms, matchParams, std::move(rankParams), strict);
 }
 
 SearchIterator *
@@ -182,11 +213,7 @@ ParallelWeakAndSearch::createHeapWand(const Terms &terms,
                                       RankParams &&rankParams,
                                       bool strict)
 {
-    if (strict) {
-        return wand::createWand<vespalib::LeftHeap, vespalib::RightHeap, true>(terms, matchParams, std::move(rankParams));
-    } else {
-        return wand::createWand<vespalib::LeftHeap, vespalib::RightHeap, false>(terms, matchParams, std::move(rankParams));
-    }
+    return wand::createWandForTerms<vespalib::LeftHeap, vespalib::RightHeap>(terms, matchParams, std::move(rankParams), strict);
 }
 
 SearchIterator *
@@ -78,6 +78,10 @@ int32_t get_max_weight(const SearchIterator &search) {
     return (minMax != nullptr) ? minMax->getMaxWeight() : std::numeric_limits<int32_t>::max();
 }
 
+const BlockMaxPostingInfo *get_block_max_info(const SearchIterator &search) {
+    return dynamic_cast<const BlockMaxPostingInfo *>(search.getPostingInfo());
+}
+
 } // namespace search::wand::<unnamed>
 
 struct TermInput {
@@ -88,6 +92,9 @@ struct TermInput {
     uint32_t get_est_hits(ref_t ref) const { return terms[ref].estHits; }
     int32_t get_max_weight(ref_t ref) const { return ::search::queryeval::wand::get_max_weight(*(terms[ref].search)); }
     docid_t get_initial_docid(ref_t ref) const { return terms[ref].search->getDocId(); } 
+    const BlockMaxPostingInfo *get_block_max_info(ref_t ref) const {
+        return ::search::queryeval::wand::get_block_max_info(*(terms[ref].search));
+    }
 };
 
 struct AttrInput {
@@ -153,6 +160,7 @@ private:
     std::vector<docid_t> _docId;
     std::vector<int32_t> _weight;
     std::vector<score_t> _maxScore;
+    std::vector<const BlockMaxPostingInfo *> _blockMax;
     IteratorPack         _iteratorPack;
 
 public:
@@ -172,6 +180,12 @@ public:
     int32_t weight(ref_t ref) const { return _weight[ref]; }
     score_t maxScore(ref_t ref) const { return _maxScore[ref]; }
 
+    // block max info is only present for terms backed by posting lists storing it
+    std::vector<const BlockMaxPostingInfo *> &blockMax() { return _blockMax; }
+    const BlockMaxPostingInfo *blockMax(ref_t ref) const {
+        return _blockMax.empty() ? nullptr : _blockMax[ref];
+    }
+
     size_t size() const { return _docId.size(); }
     IteratorPack &iteratorPack() { return _iteratorPack; }
 
@@ -186,6 +200,7 @@ VectorizedState<IteratorPack>::VectorizedState()
     : _docId(),
       _weight(),
       _maxScore(),
+      _blockMax(),
       _iteratorPack()
 {}
 template <typename IteratorPack>
@@ -253,8 +268,10 @@ VectorizedIteratorTerms::VectorizedIteratorTerms(const Terms &t, const Scorer &,
                                                  fef::MatchData::UP childrenMatchData)
     : _terms()
 {
-    std::vector<ref_t> order = init_state<Scorer>(TermInput(t), docIdLimit);
+    TermInput input(t);
+    std::vector<ref_t> order = init_state<Scorer>(input, docIdLimit);
     _terms = assemble([&t](ref_t ref){ return t[ref]; }, order);
+    blockMax() = assemble([&input](ref_t ref){ return input.get_block_max_info(ref); }, order);
     iteratorPack() = SearchIteratorPack(assemble([&t](ref_t ref){ return t[ref].search; }, order),
                                         assemble([&t](ref_t ref){ return t[ref].matchData; }, order),
                                         std::move(childrenMatchData));
@@ -445,6 +462,11 @@ struct DotProductScorer
     static score_t calculateScore(VectorizedTerms &terms, ref_t ref, docid_t docId) {
         return terms.weight(ref) * (score_t)terms.get_weight(ref, docId);
     }
+
+    template <typename VectorizedTerms>
+    static score_t calculate_block_max_score(const VectorizedTerms &terms, ref_t ref) {
+        return terms.weight(ref) * (score_t)terms.blockMax(ref)->getBlockMaxWeight();
+    }
 };
 
 //-----------------------------------------------------------------------------
@@ -472,6 +494,7 @@ private:
     score_t _upperBound;
     score_t _maxUpperBound;
     score_t _partial_score;
+    docid_t _blockLastDocId;
 
     template <typename VectorizedTerms>
     bool step_term(VectorizedTerms &terms, ref_t ref) {
@@ -557,10 +580,14 @@ private:
         _upperBound = 0;
         _maxUpperBound = 0;
         _partial_score = 0;
+        _blockLastDocId = search::endDocId;
     }
 
 public:
-    Algorithm() : _candidate(SearchIterator::beginId()), _upperBound(0), _maxUpperBound(0), _partial_score(0) {}
+    Algorithm()
+        : _candidate(SearchIterator::beginId()), _upperBound(0), _maxUpperBound(0), _partial_score(0),
+          _blockLastDocId(search::endDocId)
+    {}
 
     template <typename VectorizedTerms, typename Heaps>
     void init_range(VectorizedTerms &terms, Heaps &heaps, uint32_t begin_id, uint32_t end_id) {
@@ -628,6 +655,43 @@ public:
         return false;
     }
 
+    /**
+     * Check the candidate against an upper bound where present terms
+     * contribute with the max score of their current posting list
+     * block instead of the max score of the whole posting list. Terms
+     * not yet known to match the candidate still use their global max
+     * score. The last document covered by all the present blocks is
+     * tracked to be able to skip past them with skip_blocks.
+     **/
+    template <typename VectorizedTerms, typename Heaps, typename Scorer, typename AboveThreshold>
+    bool check_block_max_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&, AboveThreshold &&aboveThreshold) {
+        score_t max_score = _maxUpperBound;
+        _blockLastDocId = search::endDocId;
+        ref_t *end = heaps.present_end();
+        for (ref_t *ref = heaps.present_begin(); ref != end; ++ref) {
+            const BlockMaxPostingInfo *info = terms.blockMax(*ref);
+            if (info != nullptr) {
+                max_score -= (terms.maxScore(*ref) - Scorer::calculate_block_max_score(terms, *ref));
+                _blockLastDocId = std::min(_blockLastDocId, info->getBlockLastDocId());
+            }
+        }
+        return aboveThreshold(max_score);
+    }
+
+    /**
+     * Move to the first document where the upper bound calculated by
+     * check_block_max_score may no longer hold; after the blocks of
+     * the present terms or where the next future term is positioned.
+     **/
+    template <typename VectorizedTerms, typename Heaps>
+    void skip_blocks(VectorizedTerms &terms, Heaps &heaps) {
+        docid_t next = std::min(std::max(_blockLastDocId, _candidate) + 1, search::endDocId);
+        if (heaps.has_future()) {
+            next = std::min(next, terms.docId(heaps.future()));
+        }
+        set_candidate(terms, heaps, next);
+    }
+
     template <typename VectorizedTerms, typename Heaps, typename Scorer>
     score_t get_full_score(VectorizedTerms &terms, Heaps &heaps, Scorer &&) {
         score_t score = _partial_score;
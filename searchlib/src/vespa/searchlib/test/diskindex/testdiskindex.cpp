@@ -57,7 +57,7 @@ struct Builder
 void
 TestDiskIndex::buildSchema()
 {
-    _schema.addIndexField(Schema::IndexField("f1", DataType::STRING));
+    _schema.addIndexField(Schema::IndexField("f1", DataType::STRING).setBlockMaxWeights(true));
     _schema.addIndexField(Schema::IndexField("f2", DataType::STRING));
     _schema.addFieldSet(Schema::FieldSet("c2").
                         addField("f1").
@@ -25,7 +25,7 @@ namespace search::transactionlog {
 
 Domain::Domain(const string &domainName, const string & baseDir, Executor & commitExecutor,
                Executor & sessionExecutor, uint64_t domainPartSize, DomainPart::Crc defaultCrcType,
-               const FileHeaderContext &fileHeaderContext) :
+               const FileHeaderContext &fileHeaderContext, bool useFsync) :
     _defaultCrcType(defaultCrcType),
     _commitExecutor(commitExecutor),
     _sessionExecutor(sessionExecutor),
@@ -41,7 +41,15 @@ Domain::Domain(const string &domainName, const string & baseDir, Executor & comm
     _maxSessionRunTime(),
     _baseDir(baseDir),
     _fileHeaderContext(fileHeaderContext),
-    _markedDeleted(false)
+    _markedDeleted(false),
+    _useFsync(useFsync),
+    _commitLock(),
+    _commitCond(),
+    _commitQueue(),
+    _commitLeader(false),
+    _syncWaiters(),
+    _commitLatency(),
+    _syncLatency()
 {
     int retval(0);
     if ((retval = makeDirectory(_baseDir.c_str())) != 0) {
@@ -84,25 +92,37 @@ void Domain::addPart(int64_t partId, bool isLastPart) {
 class Sync : public vespalib::Executor::Task
 {
 public:
-    Sync(Monitor &syncMonitor, const DomainPart::SP &dp, bool &pendingSync) :
-        _syncMonitor(syncMonitor),
-        _dp(dp),
-        _pendingSync(pendingSync)
+    Sync(Domain &domain, const DomainPart::SP &dp) :
+        _domain(domain),
+        _dp(dp)
     { }
 private:
     void run() override {
+        auto start = std::chrono::steady_clock::now();
         _dp->sync();
-        MonitorGuard guard(_syncMonitor);
-        _pendingSync = false;
-        guard.broadcast();
+        _domain.syncDone(std::chrono::steady_clock::now() - start);
     }
-    
-    Monitor           & _syncMonitor;
+
+    Domain            & _domain;
     DomainPart::SP      _dp;
-    bool              & _pendingSync;
 };
 
-Domain::~Domain() { }
+namespace {
+
+void waitPendingSync(vespalib::Monitor &syncMonitor, bool &pendingSync)
+{
+    MonitorGuard guard(syncMonitor);
+    while (pendingSync) {
+        guard.wait();
+    }
+}
+
+}
+
+Domain::~Domain()
+{
+    waitPendingSync(_syncMonitor, _pendingSync);
+}
 
 DomainInfo
 Domain::getDomainInfo() const
@@ -113,6 +133,8 @@ Domain::getDomainInfo() const
         const DomainPart &part = *entry.second;
         info.parts.emplace_back(PartInfo(part.range(), part.size(), part.byteSize(), part.fileName()));
     }
+    info.commitLatency = _commitLatency.snapshot();
+    info.syncLatency = _syncLatency.snapshot();
     return info;
 }
 
@@ -195,12 +217,41 @@ Domain::triggerSyncNow()
 {
     MonitorGuard guard(_syncMonitor);
     if (!_pendingSync) {
-        _pendingSync = true;
-        DomainPart::SP dp(_parts.rbegin()->second);
-        _commitExecutor.execute(Sync::UP(new Sync(_syncMonitor, dp, _pendingSync)));
+        _pendingSync = scheduleSync(guard);
     }
 }
 
+bool
+Domain::scheduleSync(const MonitorGuard &)
+{
+    DomainPart::SP dp;
+    {
+        LockGuard guard(_lock);
+        dp = _parts.rbegin()->second;
+    }
+    // A rejected task means that the executor is shutting down.
+    return ! _commitExecutor.execute(std::make_unique<Sync>(*this, dp));
+}
+
+void
+Domain::syncDone(LatencyHistogram::Duration syncTime)
+{
+    _syncLatency.add(syncTime);
+    SerialNum synced = getSynced();
+    std::vector<SyncWaiter> done;
+    {
+        MonitorGuard guard(_syncMonitor);
+        while (!_syncWaiters.empty() && (_syncWaiters.front().first <= synced)) {
+            done.push_back(std::move(_syncWaiters.front()));
+            _syncWaiters.pop_front();
+        }
+        // Entries written while this sync was running are covered by the next one.
+        _pendingSync = !_syncWaiters.empty() && scheduleSync(guard);
+        guard.broadcast();
+    }
+    // Durability callbacks are run when done goes out of scope.
+}
+
 DomainPart::SP Domain::findPart(SerialNum s)
 {
     LockGuard guard(_lock);
@@ -265,19 +316,91 @@ void Domain::cleanSessions()
     }
 }
 
-namespace {
+Domain::CommitRequest::CommitRequest(const Packet &packet, DoneCallback done)
+    : _packet(packet),
+      _done(std::move(done)),
+      _start(std::chrono::steady_clock::now()),
+      _error(),
+      _written(false)
+{
+}
 
-void waitPendingSync(vespalib::Monitor &syncMonitor, bool &pendingSync)
+Domain::CommitRequest::~CommitRequest() = default;
+
+void Domain::commit(const Packet & packet, DoneCallback done)
 {
-    MonitorGuard guard(syncMonitor);
-    while (pendingSync) {
-        guard.wait();
+    CommitRequest request(packet, std::move(done));
+    std::unique_lock<std::mutex> guard(_commitLock);
+    _commitQueue.push_back(&request);
+    while (_commitLeader && !request._written) {
+        _commitCond.wait(guard);
+    }
+    if (!request._written) {
+        // Lead until our own packet is written, then hand over to one of the waiters.
+        _commitLeader = true;
+        while (!request._written) {
+            CommitBatch batch;
+            batch.swap(_commitQueue);
+            guard.unlock();
+            commitBatch(batch);
+            guard.lock();
+            for (CommitRequest *written : batch) {
+                written->_written = true;
+            }
+            _commitCond.notify_all();
+        }
+        _commitLeader = false;
+        _commitCond.notify_all();
+    }
+    guard.unlock();
+    if (request._error) {
+        std::rethrow_exception(request._error);
+    }
+}
+
+void Domain::commitBatch(const CommitBatch &batch)
+{
+    // Packets with increasing serial numbers are merged and written together.
+    auto runStart = batch.begin();
+    for (auto it = batch.begin() + 1; it <= batch.end(); ++it) {
+        if ((it == batch.end()) || ((*it)->_packet.range().from() <= (*(it - 1))->_packet.range().to())) {
+            commitRun(runStart, it);
+            runStart = it;
+        }
+    }
+    auto now = std::chrono::steady_clock::now();
+    for (const CommitRequest *request : batch) {
+        _commitLatency.add(now - request->_start);
     }
+    cleanSessions();
 }
 
+void Domain::commitRun(CommitBatch::const_iterator begin, CommitBatch::const_iterator end)
+{
+    if (end - begin > 1) {
+        Packet merged((*begin)->_packet);
+        for (auto it = begin + 1; it != end; ++it) {
+            merged.merge((*it)->_packet);
+        }
+        try {
+            commitPacket(merged);
+            addSyncWaiters(begin, end);
+            return;
+        } catch (const std::exception &) {
+            // Nothing was written, retry one by one below to fail only the offending packets.
+        }
+    }
+    for (auto it = begin; it != end; ++it) {
+        try {
+            commitPacket((*it)->_packet);
+            addSyncWaiters(it, it + 1);
+        } catch (...) {
+            (*it)->_error = std::current_exception();
+        }
+    }
 }
 
-void Domain::commit(const Packet & packet)
+void Domain::commitPacket(const Packet & packet)
 {
     DomainPart::SP dp(_parts.rbegin()->second);
     vespalib::nbostream_longlivedbuf is(packet.getHandle().c_str(), packet.getHandle().size());
@@ -296,7 +419,20 @@ void Domain::commit(const Packet & packet)
         dp = _parts.rbegin()->second;
     }
     dp->commit(entry.serial(), packet);
-    cleanSessions();
+}
+
+void Domain::addSyncWaiters(CommitBatch::const_iterator begin, CommitBatch::const_iterator end)
+{
+    if (!_useFsync) {
+        return;
+    }
+    {
+        MonitorGuard guard(_syncMonitor);
+        for (auto it = begin; it != end; ++it) {
+            _syncWaiters.emplace_back((*it)->_packet.range().to(), std::move((*it)->_done));
+        }
+    }
+    triggerSyncNow();
 }
 
 bool Domain::erase(SerialNum to)
@@ -2,9 +2,13 @@
 #pragma once
 
 #include "domainpart.h"
+#include "latency_histogram.h"
 #include "session.h"
 #include <vespa/vespalib/util/threadexecutor.h>
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
 
 namespace search::transactionlog {
 
@@ -27,10 +31,13 @@ struct DomainInfo {
     size_t byteSize;
     DurationSeconds maxSessionRunTime;
     std::vector<PartInfo> parts;
+    LatencyHistogram::Snapshot commitLatency;
+    LatencyHistogram::Snapshot syncLatency;
     DomainInfo(SerialNumRange range_in, size_t numEntries_in, size_t byteSize_in, DurationSeconds maxSessionRunTime_in)
-        : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts() {}
+        : range(range_in), numEntries(numEntries_in), byteSize(byteSize_in), maxSessionRunTime(maxSessionRunTime_in), parts(),
+          commitLatency(), syncLatency() {}
     DomainInfo()
-        : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts() {}
+        : range(), numEntries(0), byteSize(0), maxSessionRunTime(), parts(), commitLatency(), syncLatency() {}
 };
 
 typedef std::map<vespalib::string, DomainInfo> DomainStats;
@@ -40,9 +47,15 @@ class Domain
 public:
     using SP = std::shared_ptr<Domain>;
     using Executor = vespalib::ThreadExecutor;
+    using DoneCallback = Writer::DoneCallback;
+    /**
+     * With useFsync, the done callback given to commit is kept until the
+     * committed entries have been synced to disk, and a sync is started
+     * as soon as there is something to wait for.
+     */
     Domain(const vespalib::string &name, const vespalib::string &baseDir, Executor & commitExecutor,
            Executor & sessionExecutor, uint64_t domainPartSize, DomainPart::Crc defaultCrcType,
-           const common::FileHeaderContext &fileHeaderContext);
+           const common::FileHeaderContext &fileHeaderContext, bool useFsync);
 
     virtual ~Domain();
 
@@ -50,13 +63,19 @@ public:
     const vespalib::string & name() const { return _name; }
     bool erase(SerialNum to);
 
-    void commit(const Packet & packet);
+    /**
+     * Write the packet to the log. Concurrent commits are coalesced, one
+     * caller writes the packets of all waiting callers in one go while
+     * the others wait for their packet to be written.
+     */
+    void commit(const Packet & packet, DoneCallback done);
     int visit(const Domain::SP & self, SerialNum from, SerialNum to, FRT_Supervisor & supervisor, FNET_Connection *conn);
 
     SerialNum begin() const;
     SerialNum end() const;
     SerialNum getSynced() const;
     void triggerSyncNow();
+    void syncDone(LatencyHistogram::Duration syncTime);
     bool getMarkedDeleted() const { return _markedDeleted; }
     void markDeleted() { _markedDeleted = true; }
 
@@ -79,6 +98,23 @@ public:
     uint64_t size() const;
 
 private:
+    struct CommitRequest {
+        CommitRequest(const Packet &packet, DoneCallback done);
+        ~CommitRequest();
+        const Packet                          &_packet;
+        DoneCallback                           _done;
+        std::chrono::steady_clock::time_point  _start;
+        std::exception_ptr                     _error;
+        bool                                   _written;
+    };
+    using CommitBatch = std::vector<CommitRequest *>;
+    using SyncWaiter = std::pair<SerialNum, DoneCallback>;
+
+    void commitBatch(const CommitBatch &batch);
+    void commitRun(CommitBatch::const_iterator begin, CommitBatch::const_iterator end);
+    void commitPacket(const Packet & packet);
+    void addSyncWaiters(CommitBatch::const_iterator begin, CommitBatch::const_iterator end);
+    bool scheduleSync(const vespalib::MonitorGuard & guard);
     SerialNum begin(const vespalib::LockGuard & guard) const;
     SerialNum end(const vespalib::LockGuard & guard) const;
     size_t byteSize(const vespalib::LockGuard & guard) const;
@@ -111,6 +147,14 @@ private:
     vespalib::string    _baseDir;
     const common::FileHeaderContext &_fileHeaderContext;
     bool                _markedDeleted;
+    const bool          _useFsync;
+    std::mutex          _commitLock;
+    std::condition_variable _commitCond;
+    CommitBatch         _commitQueue;    // Protected by _commitLock
+    bool                _commitLeader;   // Protected by _commitLock
+    std::deque<SyncWaiter> _syncWaiters; // Protected by _syncMonitor
+    LatencyHistogram    _commitLatency;
+    LatencyHistogram    _syncLatency;
 };
 
 }
@@ -0,0 +1,48 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "latency_histogram.h"
+
+namespace search::transactionlog {
+
+LatencyHistogram::LatencyHistogram()
+    : _lock(),
+      _buckets(),
+      _count(0),
+      _total(Duration::zero()),
+      _max(Duration::zero())
+{
+    _buckets.fill(0);
+}
+
+LatencyHistogram::~LatencyHistogram() = default;
+
+void
+LatencyHistogram::add(Duration latency)
+{
+    uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+    size_t bucket = 0;
+    while ((bucket + 1 < NUM_BUCKETS) && (us >= Snapshot::bucketLimitUs(bucket))) {
+        ++bucket;
+    }
+    std::lock_guard<std::mutex> guard(_lock);
+    _buckets[bucket]++;
+    _count++;
+    _total += latency;
+    if (latency > _max) {
+        _max = latency;
+    }
+}
+
+LatencyHistogram::Snapshot
+LatencyHistogram::snapshot() const
+{
+    Snapshot result;
+    std::lock_guard<std::mutex> guard(_lock);
+    result.buckets.assign(_buckets.begin(), _buckets.end());
+    result.count = _count;
+    result.total = _total;
+    result.max = _max;
+    return result;
+}
+
+}
@@ -0,0 +1,43 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace search::transactionlog {
+
+/**
+ * Thread safe histogram of latencies. Bucket i counts latencies below
+ * 2^i microseconds that did not fit in the previous bucket, the last
+ * bucket counts everything above.
+ */
+class LatencyHistogram
+{
+public:
+    using Duration = std::chrono::steady_clock::duration;
+    static constexpr size_t NUM_BUCKETS = 24;
+
+    struct Snapshot {
+        std::vector<uint64_t> buckets;
+        uint64_t              count;
+        Duration              total;
+        Duration              max;
+        Snapshot() : buckets(NUM_BUCKETS, 0), count(0), total(Duration::zero()), max(Duration::zero()) { }
+        static uint64_t bucketLimitUs(size_t bucket) { return uint64_t(1) << bucket; }
+    };
+
+    LatencyHistogram();
+    ~LatencyHistogram();
+    void add(Duration latency);
+    Snapshot snapshot() const;
+private:
+    mutable std::mutex                   _lock;
+    std::array<uint64_t, NUM_BUCKETS>    _buckets;
+    uint64_t                             _count;
+    Duration                             _total;
+    Duration                             _max;
+};
+
+}
@@ -12,6 +12,26 @@ namespace search::transactionlog {
 
 namespace {
 
+void
+insertLatency(Cursor &object, const LatencyHistogram::Snapshot &latency)
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+    object.setLong("count", latency.count);
+    object.setLong("totalUs", duration_cast<microseconds>(latency.total).count());
+    object.setLong("maxUs", duration_cast<microseconds>(latency.max).count());
+    Cursor &buckets = object.setArray("buckets");
+    for (size_t i = 0; i < latency.buckets.size(); ++i) {
+        if (latency.buckets[i] != 0) {
+            Cursor &bucket = buckets.addObject();
+            if (i + 1 < latency.buckets.size()) {
+                bucket.setLong("belowUs", LatencyHistogram::Snapshot::bucketLimitUs(i));
+            }
+            bucket.setLong("count", latency.buckets[i]);
+        }
+    }
+}
+
 struct DomainExplorer : vespalib::StateExplorer {
     Domain::SP domain;
     DomainExplorer(Domain::SP domain_in) : domain(std::move(domain_in)) {}
@@ -22,6 +42,8 @@ struct DomainExplorer : vespalib::StateExplorer {
         state.setLong("to", info.range.to());
         state.setLong("numEntries", info.numEntries);
         state.setLong("byteSize", info.byteSize);
+        insertLatency(state.setObject("commitLatency"), info.commitLatency);
+        insertLatency(state.setObject("syncLatency"), info.syncLatency);
         if (full) {
             Cursor &array = state.setArray("parts");
             for (const PartInfo &part_in: info.parts) {
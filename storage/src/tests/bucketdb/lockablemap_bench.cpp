@@ -0,0 +1,83 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/log/log.h>
+LOG_SETUP("lockablemap_bench");
+
+#include <vespa/storage/bucketdb/storbucketdb.h>
+#include <vespa/vespalib/testkit/testapp.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace storage;
+using document::BucketId;
+
+const uint32_t numBuckets = 100000;
+const uint32_t opsPerThread = 200000;
+
+/**
+ * Bucket database populated with buckets spread over the whole
+ * bucket space.
+ */
+struct Fixture {
+    StorBucketDatabase db;
+    std::vector<BucketId> buckets;
+    Fixture() : db(), buckets() {
+        for (uint32_t i = 0; i < numBuckets; ++i) {
+            BucketId bucket(58, (static_cast<uint64_t>(i) * 0x9e3779b9u) & 0xffffffffu);
+            StorBucketDatabase::WrappedEntry entry(db.get(bucket, "bench", StorBucketDatabase::CREATE_IF_NONEXISTING));
+            entry->disk = 0;
+            entry.write();
+            buckets.push_back(bucket);
+        }
+    }
+};
+
+/**
+ * Each thread does get/write of buckets, and every writeInterval
+ * operation inserts and erases a bucket not otherwise used.
+ */
+double
+runLoad(Fixture &f, uint32_t numThreads, uint32_t writeInterval)
+{
+    std::atomic<uint64_t> checksum(0);
+    std::vector<std::thread> threads;
+    auto before = std::chrono::steady_clock::now();
+    for (uint32_t t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&f, &checksum, t, writeInterval]() {
+                uint64_t sum = 0;
+                uint32_t idx = t * 7919;
+                for (uint32_t i = 0; i < opsPerThread; ++i) {
+                    idx = (idx + 104729) % numBuckets;
+                    if (writeInterval != 0 && (i % writeInterval) == 0) {
+                        BucketId extra(58, (static_cast<uint64_t>(t + 1) << 40) | i);
+                        bucketdb::StorageBucketInfo info;
+                        info.disk = 0;
+                        f.db.insert(extra, info, "bench");
+                        f.db.erase(extra, "bench");
+                    } else {
+                        StorBucketDatabase::WrappedEntry entry(f.db.get(f.buckets[idx], "bench"));
+                        sum += entry->disk;
+                    }
+                }
+                checksum += sum;
+            });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - before;
+    EXPECT_EQUAL(0u, checksum.load());
+    return elapsed.count();
+}
+
+TEST_F("benchmark concurrent bucket database lookups", Fixture) {
+    fprintf(stderr, "%u buckets, %u operations per thread\n", numBuckets, opsPerThread);
+    for (uint32_t threads : {1, 2, 4, 8, 16, 32}) {
+        double readOnly = runLoad(f, threads, 0);
+        double mixed = runLoad(f, threads, 10);
+        fprintf(stderr, "threads: %2u, get: %10.0f ops/s, get with 10%% insert/erase: %10.0f ops/s\n",
+                threads, (threads * opsPerThread) / readOnly, (threads * opsPerThread) / mixed);
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
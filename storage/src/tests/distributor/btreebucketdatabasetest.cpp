@@ -0,0 +1,137 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#include <vespa/vdstestlib/cppunit/macros.h>
+#include <vespa/storage/bucketdb/btreebucketdatabase.h>
+#include <vespa/storage/bucketdb/mapbucketdatabase.h>
+#include <tests/distributor/bucketdatabasetest.h>
+#include <random>
+
+namespace storage {
+namespace distributor {
+
+using document::BucketId;
+
+struct BTreeBucketDatabaseTest : public BucketDatabaseTest {
+    BTreeBucketDatabase _db;
+    BucketDatabase& db() override { return _db; };
+
+    void testReadGuardSeesSnapshotAtAcquireTime();
+    void testLookupsMatchMapBucketDatabase();
+
+    CPPUNIT_TEST_SUITE(BTreeBucketDatabaseTest);
+    SETUP_DATABASE_TESTS();
+    CPPUNIT_TEST(testReadGuardSeesSnapshotAtAcquireTime);
+    CPPUNIT_TEST(testLookupsMatchMapBucketDatabase);
+    CPPUNIT_TEST_SUITE_END();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BTreeBucketDatabaseTest);
+
+namespace {
+
+BucketInfo
+makeInfo(uint16_t node, uint32_t checksum)
+{
+    BucketInfo info;
+    info.addNode(BucketCopy(0, node, api::BucketInfo(checksum, 1, 1)), toVector<uint16_t>(0));
+    return info;
+}
+
+struct CollectingProcessor : public BucketDatabase::EntryProcessor {
+    std::vector<BucketDatabase::Entry> entries;
+    bool process(const BucketDatabase::Entry& e) override {
+        entries.push_back(e);
+        return true;
+    }
+};
+
+std::string
+toString(const std::vector<BucketDatabase::Entry>& entries)
+{
+    std::ostringstream ost;
+    for (const auto& e : entries) {
+        ost << e << "\n";
+    }
+    return ost.str();
+}
+
+}
+
+void
+BTreeBucketDatabaseTest::testReadGuardSeesSnapshotAtAcquireTime()
+{
+    _db.update(BucketDatabase::Entry(BucketId(16, 1), makeInfo(1, 10)));
+    _db.update(BucketDatabase::Entry(BucketId(16, 2), makeInfo(2, 20)));
+    auto guard = _db.acquireReadGuard();
+
+    _db.update(BucketDatabase::Entry(BucketId(16, 1), makeInfo(3, 30)));
+    _db.update(BucketDatabase::Entry(BucketId(16, 3), makeInfo(4, 40)));
+    _db.remove(BucketId(16, 2));
+
+    CPPUNIT_ASSERT_EQUAL(makeInfo(1, 10), guard.get(BucketId(16, 1)).getBucketInfo());
+    CPPUNIT_ASSERT_EQUAL(makeInfo(2, 20), guard.get(BucketId(16, 2)).getBucketInfo());
+    CPPUNIT_ASSERT(!guard.get(BucketId(16, 3)).valid());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), guard.size());
+    CollectingProcessor proc;
+    guard.forEach(proc);
+    CPPUNIT_ASSERT_EQUAL(size_t(2), proc.entries.size());
+
+    CPPUNIT_ASSERT_EQUAL(makeInfo(3, 30), _db.get(BucketId(16, 1)).getBucketInfo());
+    CPPUNIT_ASSERT(!_db.get(BucketId(16, 2)).valid());
+    CPPUNIT_ASSERT_EQUAL(uint64_t(2), _db.size());
+
+    auto newGuard = _db.acquireReadGuard();
+    CPPUNIT_ASSERT_EQUAL(makeInfo(3, 30), newGuard.get(BucketId(16, 1)).getBucketInfo());
+    CPPUNIT_ASSERT(newGuard.get(BucketId(16, 3)).valid());
+}
+
+void
+BTreeBucketDatabaseTest::testLookupsMatchMapBucketDatabase()
+{
+    // Few distinct low bits and varying used bits give plenty of
+    // parent/child relations and inconsistent splits.
+    MapBucketDatabase reference;
+    std::mt19937 rnd(1234);
+    std::vector<BucketId> buckets;
+    for (uint32_t i = 0; i < 2000; ++i) {
+        BucketId bucket(8 + (rnd() % 16), rnd() & 0xffffff);
+        buckets.push_back(bucket);
+        BucketDatabase::Entry entry(bucket, makeInfo(i % 5, i));
+        reference.update(entry);
+        _db.update(entry);
+        if ((i % 7) == 0) {
+            BucketId removed(buckets[rnd() % buckets.size()]);
+            reference.remove(removed);
+            _db.remove(removed);
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(reference.size(), _db.size());
+    {
+        CollectingProcessor expected;
+        CollectingProcessor actual;
+        reference.forEach(expected);
+        _db.forEach(actual);
+        CPPUNIT_ASSERT_EQUAL(toString(expected.entries), toString(actual.entries));
+    }
+    for (uint32_t i = 0; i < 2000; ++i) {
+        BucketId bucket(8 + (rnd() % 24), rnd() & 0xffffff);
+        if ((i % 2) == 0) {
+            bucket = buckets[rnd() % buckets.size()];
+        }
+        std::vector<BucketDatabase::Entry> expected;
+        std::vector<BucketDatabase::Entry> actual;
+        reference.getParents(bucket, expected);
+        _db.getParents(bucket, actual);
+        CPPUNIT_ASSERT_EQUAL(toString(expected), toString(actual));
+        expected.clear();
+        actual.clear();
+        reference.getAll(bucket, expected);
+        _db.getAll(bucket, actual);
+        CPPUNIT_ASSERT_EQUAL(toString(expected), toString(actual));
+        CPPUNIT_ASSERT_EQUAL(reference.childCount(bucket), _db.childCount(bucket));
+        CPPUNIT_ASSERT_EQUAL(reference.upperBound(bucket).getBucketId(), _db.upperBound(bucket).getBucketId());
+        CPPUNIT_ASSERT_EQUAL(reference.getAppropriateBucket(8, bucket), _db.getAppropriateBucket(8, bucket));
+    }
+}
+
+}
+}
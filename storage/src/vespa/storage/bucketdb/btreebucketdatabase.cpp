@@ -0,0 +1,502 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "btreebucketdatabase.h"
+#include <vespa/storage/common/bucketoperationlogger.h>
+#include <vespa/searchlib/btree/btreenode.hpp>
+#include <vespa/searchlib/btree/btreenodeallocator.hpp>
+#include <vespa/searchlib/btree/btreenodestore.hpp>
+#include <vespa/searchlib/btree/btreeiterator.hpp>
+#include <vespa/searchlib/btree/btreeroot.hpp>
+#include <vespa/searchlib/btree/btreebuilder.hpp>
+#include <vespa/searchlib/btree/btree.hpp>
+#include <vespa/searchlib/datastore/array_store.hpp>
+#include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/backtrace.h>
+#include <atomic>
+#include <ostream>
+#include <cassert>
+
+#include <vespa/log/bufferedlogger.h>
+LOG_SETUP(".btreebucketdatabase");
+
+using document::BucketId;
+using search::datastore::EntryRef;
+
+namespace storage {
+
+namespace {
+
+constexpr size_t MAX_SMALL_REPLICA_ARRAY_SIZE = 16;
+constexpr size_t SMALL_MEMORY_PAGE_SIZE = 4 * 1024;
+constexpr size_t MIN_ARRAYS_FOR_NEW_BUFFER = 8 * 1024;
+constexpr float ALLOC_GROW_FACTOR = 0.2;
+
+search::datastore::ArrayStoreConfig
+makeReplicaStoreConfig()
+{
+    return BTreeBucketDatabase::ReplicaStore::optimizedConfigForHugePage(MAX_SMALL_REPLICA_ARRAY_SIZE,
+                                                                          vespalib::alloc::MemoryAllocator::HUGEPAGE_SIZE,
+                                                                          SMALL_MEMORY_PAGE_SIZE,
+                                                                          MIN_ARRAYS_FOR_NEW_BUFFER,
+                                                                          ALLOC_GROW_FACTOR);
+}
+
+uint64_t
+makeEntryValue(uint32_t gcTimestamp, EntryRef replicas)
+{
+    return ((static_cast<uint64_t>(gcTimestamp) << 32u) | replicas.ref());
+}
+
+uint32_t
+gcTimestampFromValue(uint64_t value)
+{
+    return (value >> 32u);
+}
+
+EntryRef
+replicasFromValue(uint64_t value)
+{
+    return EntryRef(value & 0xffffffffu);
+}
+
+/**
+ * Index, in bucket bit order, of the first bit where two bucket keys
+ * differ. Only meaningful when the keys differ within their used bits.
+ */
+uint32_t
+firstDifferingBit(uint64_t lhsKey, uint64_t rhsKey)
+{
+    return __builtin_clzl(lhsKey ^ rhsKey);
+}
+
+/**
+ * Key of the bucket using the first `usedBits` bits of the given bucket key.
+ * BucketId does not strip any bits when no bits are used, so this is done
+ * on the key directly.
+ */
+uint64_t
+prefixKey(uint64_t bucketKey, uint32_t usedBits)
+{
+    if (usedBits == 0) {
+        return 0;
+    }
+    const uint64_t prefixMask = ~((static_cast<uint64_t>(1) << (64 - usedBits)) - 1);
+    return ((bucketKey & prefixMask) | usedBits);
+}
+
+/**
+ * Returns the smallest bucket key ordered after all buckets contained in
+ * the given bucket, or 0 if there is no such key.
+ */
+uint64_t
+subtreeEndKey(const BucketId& bucket)
+{
+    const uint32_t usedBits = bucket.getUsedBits();
+    if (usedBits == 0) {
+        return 0;
+    }
+    const uint64_t step = (static_cast<uint64_t>(1) << (64 - usedBits));
+    return ((bucket.toKey() & ~(step - 1)) + step);
+}
+
+bool
+sameReplicas(const BucketInfo& lhs, const BucketInfo& rhs)
+{
+    if (lhs.getLastGarbageCollectionTime() != rhs.getLastGarbageCollectionTime()) {
+        return false;
+    }
+    const auto& lhsNodes = lhs.getRawNodes();
+    const auto& rhsNodes = rhs.getRawNodes();
+    if (lhsNodes.size() != rhsNodes.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhsNodes.size(); ++i) {
+        if (lhsNodes[i].getNode() != rhsNodes[i].getNode() ||
+            lhsNodes[i].getTimestamp() != rhsNodes[i].getTimestamp() ||
+            !(lhsNodes[i] == rhsNodes[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void __attribute__((noinline)) log_empty_bucket_insertion(const BucketId& id) {
+    // Use buffered logging to avoid spamming the logs in case this is triggered for
+    // many buckets simultaneously.
+    LOGBP(error, "Inserted empty bucket %s into database.\n%s",
+          id.toString().c_str(), vespalib::getStackTrace(2).c_str());
+}
+
+}
+
+BTreeBucketDatabase::ReadGuard::ReadGuard(const BTreeBucketDatabase& db)
+    : _guard(db._generationHandler.takeGuard()),
+      _db(&db),
+      _frozenView(db._tree.getFrozenView())
+{
+}
+
+BTreeBucketDatabase::ReadGuard::ReadGuard(ReadGuard&& rhs)
+    : _guard(std::move(rhs._guard)),
+      _db(rhs._db),
+      _frozenView(rhs._frozenView)
+{
+}
+
+BTreeBucketDatabase::ReadGuard::~ReadGuard() = default;
+
+BucketDatabase::Entry
+BTreeBucketDatabase::ReadGuard::get(const BucketId& bucket) const
+{
+    auto iter = _frozenView.find(bucket.toKey());
+    if (iter.valid()) {
+        return _db->entryFromIterator(iter);
+    }
+    return Entry::createInvalid();
+}
+
+void
+BTreeBucketDatabase::ReadGuard::getParents(const BucketId& childBucket, std::vector<Entry>& entries) const
+{
+    findParents(_frozenView, childBucket, *_db, entries);
+}
+
+void
+BTreeBucketDatabase::ReadGuard::forEach(EntryProcessor& processor, const BucketId& after) const
+{
+    forEachImpl(_frozenView, *_db, processor, after);
+}
+
+BTreeBucketDatabase::BTreeBucketDatabase()
+    : _tree(),
+      _store(makeReplicaStoreConfig()),
+      _generationHandler()
+{
+}
+
+BTreeBucketDatabase::~BTreeBucketDatabase() = default;
+
+template <typename IteratorType>
+BucketDatabase::Entry
+BTreeBucketDatabase::entryFromIterator(const IteratorType& iter) const
+{
+    const uint64_t value = iter.getData();
+    std::atomic_thread_fence(std::memory_order_acquire);
+    auto replicas = _store.get(replicasFromValue(value));
+    return Entry(BucketId(BucketId::keyToBucketId(iter.getKey())),
+                 BucketInfo(gcTimestampFromValue(value),
+                            std::vector<BucketCopy>(replicas.begin(), replicas.end())));
+}
+
+uint64_t
+BTreeBucketDatabase::storeEntryValue(const BucketInfo& info)
+{
+    const auto& nodes = info.getRawNodes();
+    EntryRef replicas = _store.add(ReplicaStore::ConstArrayRef(nodes.data(), nodes.size()));
+    return makeEntryValue(info.getLastGarbageCollectionTime(), replicas);
+}
+
+void
+BTreeBucketDatabase::releaseEntryValue(uint64_t value)
+{
+    _store.remove(replicasFromValue(value));
+}
+
+/**
+ * Make tree and replica store changes visible to new readers, and free
+ * memory that is no longer reachable by any reader.
+ */
+void
+BTreeBucketDatabase::commitTreeChanges()
+{
+    _tree.getAllocator().freeze();
+    const auto currentGen = _generationHandler.getCurrentGeneration();
+    _store.transferHoldLists(currentGen);
+    _tree.getAllocator().transferHoldLists(currentGen);
+    _generationHandler.incGeneration();
+    const auto usedGen = _generationHandler.getFirstUsedGeneration();
+    _store.trimHoldLists(usedGen);
+    _tree.getAllocator().trimHoldLists(usedGen);
+}
+
+BucketDatabase::Entry
+BTreeBucketDatabase::get(const BucketId& bucket) const
+{
+    auto iter = _tree.find(bucket.toKey());
+    if (iter.valid()) {
+        return entryFromIterator(iter);
+    }
+    return Entry::createInvalid();
+}
+
+void
+BTreeBucketDatabase::remove(const BucketId& bucket)
+{
+    LOG_BUCKET_OPERATION_NO_LOCK(bucket, "REMOVING from bucket db!");
+    auto iter = _tree.find(bucket.toKey());
+    if (!iter.valid()) {
+        return;
+    }
+    const uint64_t value = iter.getData();
+    _tree.remove(iter);
+    releaseEntryValue(value);
+    commitTreeChanges();
+}
+
+/**
+ * The parents of a bucket are the buckets using the same raw id with
+ * fewer used bits, and they are ordered by used bits in key order. Instead
+ * of probing every used bits level we seek to the next possible parent
+ * and use the entry found there to skip levels where no parent can exist.
+ */
+template <typename TreeType>
+void
+BTreeBucketDatabase::findParents(const TreeType& tree, const BucketId& bucket,
+                                 const BTreeBucketDatabase& db, std::vector<Entry>& entries)
+{
+    const uint64_t bucketKey = bucket.toKey();
+    const uint32_t usedBits = bucket.getUsedBits();
+    uint32_t bits = 0;
+    auto iter = tree.lowerBound(prefixKey(bucketKey, bits));
+    while (iter.valid()) {
+        const uint64_t candidateKey = iter.getKey();
+        const BucketId candidate(BucketId::keyToBucketId(candidateKey));
+        if (candidate.getUsedBits() <= usedBits && candidate.contains(bucket)) {
+            entries.push_back(db.entryFromIterator(iter));
+            if (candidate.getUsedBits() == usedBits) {
+                return;
+            }
+            bits = candidate.getUsedBits() + 1;
+        } else {
+            if (bucket.contains(candidate)) {
+                return; // Past the bucket itself
+            }
+            const uint32_t diffBit = firstDifferingBit(candidateKey, bucketKey);
+            if (bucket.getBit(diffBit) == 0) {
+                return; // Candidate is ordered after all remaining parents
+            }
+            bits = diffBit + 1;
+        }
+        iter.seek(prefixKey(bucketKey, bits));
+    }
+}
+
+void
+BTreeBucketDatabase::getParents(const BucketId& childBucket, std::vector<Entry>& entries) const
+{
+    findParents(_tree, childBucket, *this, entries);
+}
+
+void
+BTreeBucketDatabase::getAll(const BucketId& bucket, std::vector<Entry>& entries) const
+{
+    findParents(_tree, bucket, *this, entries);
+    const uint64_t bucketKey = bucket.toKey();
+    auto iter = _tree.lowerBound(bucketKey);
+    if (iter.valid() && iter.getKey() == bucketKey) {
+        ++iter; // Already added as its own parent
+    }
+    for (; iter.valid(); ++iter) {
+        const BucketId candidate(BucketId::keyToBucketId(iter.getKey()));
+        if (!bucket.contains(candidate)) {
+            break;
+        }
+        entries.push_back(entryFromIterator(iter));
+    }
+}
+
+void
+BTreeBucketDatabase::update(const Entry& newEntry)
+{
+    assert(newEntry.valid());
+    if (newEntry->getNodeCount() == 0) {
+        log_empty_bucket_insertion(newEntry.getBucketId());
+    }
+    LOG_BUCKET_OPERATION_NO_LOCK(
+            newEntry.getBucketId(),
+            vespalib::make_string(
+                    "bucketdb insert of %s", newEntry.toString().c_str()));
+
+    const uint64_t bucketKey = newEntry.getBucketId().toKey();
+    const uint64_t newValue = storeEntryValue(newEntry.getBucketInfo());
+    auto iter = _tree.lowerBound(bucketKey);
+    if (iter.valid() && iter.getKey() == bucketKey) {
+        const uint64_t oldValue = iter.getData();
+        // Copy-on-write the path to the entry so frozen readers keep seeing the old value.
+        _tree.thaw(iter);
+        // Replicas must be written before the value referencing them.
+        std::atomic_thread_fence(std::memory_order_release);
+        iter.writeData(newValue);
+        releaseEntryValue(oldValue);
+    } else {
+        _tree.insert(iter, bucketKey, newValue);
+    }
+    commitTreeChanges();
+}
+
+template <typename TreeType>
+void
+BTreeBucketDatabase::forEachImpl(const TreeType& tree, const BTreeBucketDatabase& db,
+                                 EntryProcessor& processor, const BucketId& after)
+{
+    for (auto iter = tree.upperBound(after.toKey()); iter.valid(); ++iter) {
+        if (!processor.process(db.entryFromIterator(iter))) {
+            break;
+        }
+    }
+}
+
+void
+BTreeBucketDatabase::forEach(EntryProcessor& processor, const BucketId& after) const
+{
+    forEachImpl(_tree, *this, processor, after);
+}
+
+void
+BTreeBucketDatabase::forEach(MutableEntryProcessor& processor, const BucketId& after)
+{
+    bool modified = false;
+    for (auto iter = _tree.upperBound(after.toKey()); iter.valid(); ++iter) {
+        Entry entry(entryFromIterator(iter));
+        const BucketInfo original(entry.getBucketInfo());
+        const bool proceed = processor.process(entry);
+        // Only write back entries that were changed, to avoid replica store churn.
+        if (!sameReplicas(original, entry.getBucketInfo())) {
+            const uint64_t oldValue = iter.getData();
+            const uint64_t newValue = storeEntryValue(entry.getBucketInfo());
+            _tree.thaw(iter);
+            std::atomic_thread_fence(std::memory_order_release);
+            iter.writeData(newValue);
+            releaseEntryValue(oldValue);
+            modified = true;
+        }
+        if (!proceed) {
+            break;
+        }
+    }
+    if (modified) {
+        commitTreeChanges();
+    }
+}
+
+void
+BTreeBucketDatabase::clear()
+{
+    for (auto iter = _tree.begin(); iter.valid(); ++iter) {
+        releaseEntryValue(iter.getData());
+    }
+    _tree.clear();
+    commitTreeChanges();
+}
+
+/**
+ * Any bucket that splits off from the path of `bid` at bit index d (i.e.
+ * has the same first d bits but a different bit d) requires the new bucket
+ * to use at least d + 1 bits. The buckets splitting off deepest are the
+ * closest ones in key order that are neither parents nor children of `bid`.
+ */
+BucketId
+BTreeBucketDatabase::getAppropriateBucket(uint16_t minBits, const BucketId& bid)
+{
+    const uint64_t bucketKey = bid.toKey();
+    uint32_t result = minBits;
+    auto iter = _tree.lowerBound(bucketKey);
+    auto prev = iter;
+    --prev;
+    while (prev.valid() && BucketId(BucketId::keyToBucketId(prev.getKey())).contains(bid)) {
+        --prev;
+    }
+    if (prev.valid()) {
+        result = std::max(result, firstDifferingBit(prev.getKey(), bucketKey) + 1);
+    }
+    const uint64_t endKey = subtreeEndKey(bid);
+    if (endKey != 0) {
+        auto next = _tree.lowerBound(endKey);
+        if (next.valid()) {
+            result = std::max(result, firstDifferingBit(next.getKey(), bucketKey) + 1);
+        }
+    }
+    return BucketId(result, bid.getRawId());
+}
+
+uint32_t
+BTreeBucketDatabase::childCount(const BucketId& bucket) const
+{
+    const uint32_t usedBits = bucket.getUsedBits();
+    if (usedBits >= BucketId::maxNumBits) {
+        return 0;
+    }
+    const uint64_t splitBit = (static_cast<uint64_t>(1) << usedBits);
+    uint32_t count = 0;
+    for (uint64_t rawId : {bucket.getId() & ~splitBit, bucket.getId() | splitBit}) {
+        const BucketId child(usedBits + 1, rawId);
+        auto iter = _tree.lowerBound(child.toKey());
+        if (iter.valid() && child.contains(BucketId(BucketId::keyToBucketId(iter.getKey())))) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+BucketDatabase::Entry
+BTreeBucketDatabase::upperBound(const BucketId& value) const
+{
+    auto iter = _tree.upperBound(value.toKey());
+    if (iter.valid()) {
+        return entryFromIterator(iter);
+    }
+    return Entry::createInvalid();
+}
+
+search::MemoryUsage
+BTreeBucketDatabase::getMemoryUsage() const
+{
+    search::MemoryUsage usage = _tree.getMemoryUsage();
+    usage.merge(_store.getMemoryUsage());
+    return usage;
+}
+
+namespace {
+    struct Writer : public BucketDatabase::EntryProcessor {
+        std::ostream& _ost;
+        Writer(std::ostream& ost) : _ost(ost) {}
+        bool process(const BucketDatabase::Entry& e) override {
+            _ost << e.toString() << "\n";
+            return true;
+        }
+    };
+}
+
+void
+BTreeBucketDatabase::print(std::ostream& out, bool verbose,
+                           const std::string& indent) const
+{
+    (void) indent;
+    if (verbose) {
+        Writer writer(out);
+        forEach(writer);
+    } else {
+        out << "Size(" << size() << ") Memory(" << getMemoryUsage().usedBytes() << ")";
+    }
+}
+
+} // storage
+
+namespace search::btree {
+
+template class BTreeNodeTT<uint64_t, uint64_t, NoAggregated, BTreeDefaultTraits::LEAF_SLOTS>;
+template class BTreeInternalNode<uint64_t, NoAggregated, BTreeDefaultTraits::INTERNAL_SLOTS>;
+template class BTreeLeafNode<uint64_t, uint64_t, NoAggregated, BTreeDefaultTraits::LEAF_SLOTS>;
+template class BTreeNodeStore<uint64_t, uint64_t, NoAggregated,
+                              BTreeDefaultTraits::INTERNAL_SLOTS, BTreeDefaultTraits::LEAF_SLOTS>;
+template class BTreeNodeAllocator<uint64_t, uint64_t, NoAggregated,
+                                  BTreeDefaultTraits::INTERNAL_SLOTS, BTreeDefaultTraits::LEAF_SLOTS>;
+template class BTreeIteratorBase<uint64_t, uint64_t, NoAggregated>;
+template class BTreeConstIterator<uint64_t, uint64_t, NoAggregated>;
+template class BTreeIterator<uint64_t, uint64_t, NoAggregated>;
+template class BTreeRootT<uint64_t, uint64_t, NoAggregated>;
+template class BTreeRoot<uint64_t, uint64_t, NoAggregated>;
+template class BTree<uint64_t, uint64_t, NoAggregated>;
+
+}
@@ -0,0 +1,95 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include "bucketdatabase.h"
+#include <vespa/searchlib/btree/btree.h>
+#include <vespa/searchlib/datastore/array_store.h>
+#include <vespa/vespalib/util/generationhandler.h>
+
+namespace storage {
+
+/**
+ * Bucket database implementation using a B-tree keyed on bucket key
+ * (BucketId::toKey()), which orders buckets the same way as a pre-order
+ * traversal of the bucket bit tree. Each tree entry holds the last
+ * garbage collection time and a reference into an array store holding
+ * the bucket replicas, so an entry does not need any per-bucket heap
+ * allocation.
+ *
+ * All mutations are done by a single writer. Old tree nodes and replica
+ * arrays are kept on hold until no reader can observe them, allowing
+ * readers to take a ReadGuard and read a frozen snapshot of the database
+ * without blocking the writer. Lookups through the BucketDatabase
+ * interface read the live tree, and must be done by the writer thread.
+ */
+class BTreeBucketDatabase : public BucketDatabase
+{
+public:
+    // Entry value layout: [gc timestamp: 32 bits | replica array ref: 32 bits]
+    using BTree = search::btree::BTree<uint64_t, uint64_t>;
+    using ReplicaStore = search::datastore::ArrayStore<BucketCopy>;
+    using GenerationHandler = vespalib::GenerationHandler;
+
+    /**
+     * Read access to a snapshot of the database as it was when the guard
+     * was taken. Concurrent writes are not visible through the guard.
+     */
+    class ReadGuard {
+        GenerationHandler::Guard _guard;
+        const BTreeBucketDatabase *_db;
+        BTree::FrozenView _frozenView;
+    public:
+        explicit ReadGuard(const BTreeBucketDatabase &db);
+        ReadGuard(ReadGuard &&rhs);
+        ReadGuard(const ReadGuard &) = delete;
+        ReadGuard &operator=(const ReadGuard &) = delete;
+        ~ReadGuard();
+
+        Entry get(const document::BucketId& bucket) const;
+        void getParents(const document::BucketId& childBucket, std::vector<Entry>& entries) const;
+        void forEach(EntryProcessor&, const document::BucketId& after = document::BucketId()) const;
+        uint64_t size() const { return _frozenView.size(); }
+    };
+
+    BTreeBucketDatabase();
+    ~BTreeBucketDatabase();
+
+    Entry get(const document::BucketId& bucket) const override;
+    void remove(const document::BucketId& bucket) override;
+    void getParents(const document::BucketId& childBucket, std::vector<Entry>& entries) const override;
+    void getAll(const document::BucketId& bucket, std::vector<Entry>& entries) const override;
+    void update(const Entry& newEntry) override;
+    void forEach(EntryProcessor&, const document::BucketId& after = document::BucketId()) const override;
+    void forEach(MutableEntryProcessor&, const document::BucketId& after = document::BucketId()) override;
+    uint64_t size() const override { return _tree.size(); };
+    void clear() override;
+
+    uint32_t childCount(const document::BucketId&) const override;
+    Entry upperBound(const document::BucketId& value) const override;
+
+    document::BucketId getAppropriateBucket(uint16_t minBits, const document::BucketId& bid) override;
+    void print(std::ostream& out, bool verbose, const std::string& indent) const override;
+
+    ReadGuard acquireReadGuard() const { return ReadGuard(*this); }
+    search::MemoryUsage getMemoryUsage() const;
+
+private:
+    template <typename IteratorType>
+    Entry entryFromIterator(const IteratorType& iter) const;
+    uint64_t storeEntryValue(const BucketInfo& info);
+    void releaseEntryValue(uint64_t value);
+    void commitTreeChanges();
+
+    template <typename TreeType>
+    static void findParents(const TreeType& tree, const document::BucketId& bucket,
+                            const BTreeBucketDatabase& db, std::vector<Entry>& entries);
+    template <typename TreeType>
+    static void forEachImpl(const TreeType& tree, const BTreeBucketDatabase& db,
+                            EntryProcessor& processor, const document::BucketId& after);
+
+    BTree _tree;
+    ReplicaStore _store;
+    GenerationHandler _generationHandler;
+};
+
+}
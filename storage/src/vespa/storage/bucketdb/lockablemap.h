@@ -11,6 +11,14 @@
  *     wrapper copy dies.
  *   - Built in function for iterating taking a functor. Halts when
  *     encountering locked values.
+ *
+ * The map mutex is only held while accessing the map itself. The entry
+ * locks are kept in a set of lock stripes, selected by key hash, each
+ * with its own mutex and condition variable. Taking or releasing an
+ * entry lock thus only contends with operations on keys in the same
+ * stripe, and releasing one only wakes the waiters of that stripe.
+ * Lock order is map mutex before stripe mutex, waiting for an entry
+ * lock is done without holding the map mutex.
  */
 #pragma once
 
@@ -19,6 +27,7 @@
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <vespa/vespalib/stllike/hash_set.h>
 #include <vespa/document/bucket/bucketid.h>
+#include <array>
 #include <mutex>
 #include <condition_variable>
 #include <cassert>
@@ -239,20 +248,60 @@ private:
         WaiterMap _map;
     };
 
-    Map               _map;
-    mutable std::mutex      _lock;
-    std::condition_variable _cond;
-    LockIdSet         _lockedKeys;
-    LockWaiters       _lockWaiters;
+    struct LockStripe {
+        std::mutex              _lock;
+        std::condition_variable _cond;
+        LockIdSet               _lockedKeys;
+        LockWaiters             _lockWaiters;
+
+        LockStripe();
+        ~LockStripe();
+    };
+
+    static constexpr uint32_t NUM_LOCK_STRIPES = 64;
+
+    Map                     _map;
+    mutable std::mutex      _lock; // Protects _map
+    mutable std::array<LockStripe, NUM_LOCK_STRIPES> _stripes;
+
+    LockStripe &getStripe(key_type key) const {
+        uint64_t hash = static_cast<uint64_t>(key) * 0x9e3779b97f4a7c15ul;
+        return _stripes[(hash >> 32) % NUM_LOCK_STRIPES];
+    }
 
     bool erase(const key_type& key, const char* clientId, bool haslock);
     void insert(const key_type& key, const mapped_type& value,
                 const char* clientId, bool haslock, bool& preExisted);
     void unlock(const key_type& key);
+
+    /**
+     * Find the first key not less than `key` that is not locked,
+     * waiting for locked keys to be released. Locks the found key if
+     * `lockKey` is set. `guard` holds the map mutex, it is released
+     * while waiting.
+     *
+     * Returns true if there are no more keys.
+     */
     bool findNextKey(key_type& key, mapped_type& val, const char* clientId,
-                     std::unique_lock<std::mutex> &guard);
+                     bool lockKey, std::unique_lock<std::mutex> &guard);
     bool handleDecision(key_type& key, mapped_type& val, Decision decision);
-    void acquireKey(const LockId & lid, std::unique_lock<std::mutex> &guard);
+
+    /** Wait until the key is not locked. */
+    void acquireKey(const LockId & lid, LockStripe &stripe,
+                    std::unique_lock<std::mutex> &stripeGuard);
+    /** Wait until the key is not locked, then lock it. */
+    void lockKey(const LockId & lid);
+    /**
+     * Wait until the key is not locked, and return holding its stripe
+     * mutex so it stays unlocked. `guard` holds the map mutex, it is
+     * released while waiting.
+     */
+    std::unique_lock<std::mutex> guardFreeKey(const LockId & lid,
+                                              std::unique_lock<std::mutex> &guard);
+
+    template<typename Functor>
+    void eachImpl(Functor& functor, const char* clientId,
+                  const key_type& first, const key_type& last);
 
     /**
      * Process up to `chunkSize` bucket database entries from--and possibly
@@ -302,7 +351,8 @@ private:
 
     /**
      * Find the given list of keys in the map and add them to the map of
-     * results, locking them in the process.
+     * results, locking them in the process. `guard` holds the map mutex,
+     * it is released while waiting for locked keys.
      */
     void addAndLockResults(const std::vector<BucketId::Type> keys,
                            const char* clientId,
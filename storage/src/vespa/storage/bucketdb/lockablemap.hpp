@@ -5,6 +5,7 @@
 #include <vespa/vespalib/stllike/asciistream.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
 #include <vespa/vespalib/stllike/hash_set.hpp>
+#include <algorithm>
 #include <thread>
 #include <chrono>
 
@@ -36,6 +37,17 @@ LockableMap<Map>::LockWaiters::insert(const LockId & lid) {
     return id;
 }
 
+template<typename Map>
+LockableMap<Map>::LockStripe::LockStripe()
+    : _lock(),
+      _cond(),
+      _lockedKeys(),
+      _lockWaiters()
+{ }
+
+template<typename Map>
+LockableMap<Map>::LockStripe::~LockStripe() { }
+
 template<typename Map>
 void
 LockableMap<Map>::WrappedEntry::write()
@@ -69,9 +81,7 @@ template<typename Map>
 LockableMap<Map>::LockableMap()
     : _map(),
       _lock(),
-      _cond(),
-      _lockedKeys(),
-      _lockWaiters()
+      _stripes()
 {}
 
 template<typename Map>
@@ -107,9 +117,14 @@ template<typename Map>
 typename Map::size_type
 LockableMap<Map>::getMemoryUsage() const
 {
+    size_type lockedKeysUsage = 0;
+    for (LockStripe &stripe : _stripes) {
+        std::lock_guard<std::mutex> stripeGuard(stripe._lock);
+        lockedKeysUsage += stripe._lockedKeys.getMemoryUsage();
+    }
     std::lock_guard<std::mutex> guard(_lock);
-    return _map.getMemoryUsage() + _lockedKeys.getMemoryUsage() +
-        sizeof(std::mutex) + sizeof(std::condition_variable);
+    return _map.getMemoryUsage() + lockedKeysUsage +
+        sizeof(std::mutex) + NUM_LOCK_STRIPES * sizeof(LockStripe);
 }
 
 template<typename Map>
@@ -130,14 +145,41 @@ LockableMap<Map>::swap(LockableMap<Map>& other)
 }
 
 template<typename Map>
-void LockableMap<Map>::acquireKey(const LockId & lid, std::unique_lock<std::mutex> &guard)
+void LockableMap<Map>::acquireKey(const LockId & lid, LockStripe &stripe,
+                                  std::unique_lock<std::mutex> &stripeGuard)
 {
-    if (_lockedKeys.exist(lid)) {
-        typename LockWaiters::Key waitId(_lockWaiters.insert(lid));
-        while (_lockedKeys.exist(lid)) {
-            _cond.wait(guard);
+    if (stripe._lockedKeys.exist(lid)) {
+        typename LockWaiters::Key waitId(stripe._lockWaiters.insert(lid));
+        while (stripe._lockedKeys.exist(lid)) {
+            stripe._cond.wait(stripeGuard);
         }
-        _lockWaiters.erase(waitId);
+        stripe._lockWaiters.erase(waitId);
+    }
+}
+
+template<typename Map>
+void LockableMap<Map>::lockKey(const LockId & lid)
+{
+    LockStripe &stripe(getStripe(lid._key));
+    std::unique_lock<std::mutex> stripeGuard(stripe._lock);
+    acquireKey(lid, stripe, stripeGuard);
+    stripe._lockedKeys.insert(lid);
+}
+
+template<typename Map>
+std::unique_lock<std::mutex>
+LockableMap<Map>::guardFreeKey(const LockId & lid, std::unique_lock<std::mutex> &guard)
+{
+    LockStripe &stripe(getStripe(lid._key));
+    while (true) {
+        std::unique_lock<std::mutex> stripeGuard(stripe._lock);
+        if (!stripe._lockedKeys.exist(lid)) {
+            return stripeGuard;
+        }
+        guard.unlock();
+        acquireKey(lid, stripe, stripeGuard);
+        stripeGuard.unlock();
+        guard.lock();
     }
 }
 
@@ -148,21 +190,28 @@ LockableMap<Map>::get(const key_type& key, const char* clientId,
                       bool lockIfNonExistingAndNotCreating)
 {
     LockId lid(key, clientId);
-    std::unique_lock<std::mutex> guard(_lock);
-    acquireKey(lid, guard);
+    lockKey(lid);
     bool preExisted = false;
-    typename Map::iterator it =
-        _map.find(key, createIfNonExisting, preExisted);
-
-    if (it == _map.end()) {
+    mapped_type value;
+    bool found;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        typename Map::iterator it =
+            _map.find(key, createIfNonExisting, preExisted);
+        found = (it != _map.end());
+        if (found) {
+            value = it->second;
+        }
+    }
+    if (!found) {
+        unlock(key);
         if (lockIfNonExistingAndNotCreating) {
             return WrappedEntry(*this, key, clientId);
         } else {
             return WrappedEntry();
         }
     }
-    _lockedKeys.insert(lid);
-    return WrappedEntry(*this, key, it->second, clientId, preExisted);
+    return WrappedEntry(*this, key, value, clientId, preExisted);
 }
 
 #ifdef ENABLE_BUCKET_OPERATION_LOGGING
@@ -196,10 +245,10 @@ template<typename Map>
 bool
 LockableMap<Map>::erase(const key_type& key, const char* clientId, bool haslock)
 {
-    LockId lid(key, clientId);
     std::unique_lock<std::mutex> guard(_lock);
+    std::unique_lock<std::mutex> stripeGuard;
     if (!haslock) {
-        acquireKey(lid, guard);
+        stripeGuard = guardFreeKey(LockId(key, clientId), guard);
     }
 #ifdef ENABLE_BUCKET_OPERATION_LOGGING
     debug::logBucketDbErase(key, debug::TypeTag<mapped_type>());
@@ -212,10 +261,10 @@ void
 LockableMap<Map>::insert(const key_type& key, const mapped_type& value,
                          const char* clientId, bool haslock, bool& preExisted)
 {
-    LockId lid(key, clientId);
     std::unique_lock<std::mutex> guard(_lock);
+    std::unique_lock<std::mutex> stripeGuard;
     if (!haslock) {
-        acquireKey(lid, guard);
+        stripeGuard = guardFreeKey(LockId(key, clientId), guard);
     }
 #ifdef ENABLE_BUCKET_OPERATION_LOGGING
     debug::logBucketDbInsert(key, value);
@@ -234,21 +283,29 @@ LockableMap<Map>::clear()
 template<typename Map>
 bool
 LockableMap<Map>::findNextKey(key_type& key, mapped_type& val,
-                              const char* clientId,
+                              const char* clientId, bool lockKey,
                               std::unique_lock<std::mutex> &guard)
 {
-    // Wait for next value to unlock.
-    typename Map::iterator it(_map.lower_bound(key));
-    while (it != _map.end() && _lockedKeys.exist(LockId(it->first, ""))) {
-        typename LockWaiters::Key waitId(_lockWaiters.insert(LockId(it->first, clientId)));
-        _cond.wait(guard);
-        _lockWaiters.erase(waitId);
-        it = _map.lower_bound(key);
+    while (true) {
+        typename Map::iterator it(_map.lower_bound(key));
+        if (it == _map.end()) return true;
+        LockId lid(it->first, clientId);
+        LockStripe &stripe(getStripe(lid._key));
+        std::unique_lock<std::mutex> stripeGuard(stripe._lock);
+        if (!stripe._lockedKeys.exist(lid)) {
+            if (lockKey) {
+                stripe._lockedKeys.insert(lid);
+            }
+            key = it->first;
+            val = it->second;
+            return false;
+        }
+        // Wait for next value to unlock, then look it up again.
+        guard.unlock();
+        acquireKey(lid, stripe, stripeGuard);
+        stripeGuard.unlock();
+        guard.lock();
     }
-    if (it == _map.end()) return true;
-    key = it->first;
-    val = it->second;
-    return false;
 }
 
 template<typename Map>
@@ -272,71 +329,58 @@ LockableMap<Map>::handleDecision(key_type& key, mapped_type& val,
 template<typename Map>
 template<typename Functor>
 void
-LockableMap<Map>::each(Functor& functor, const char* clientId,
-                       const key_type& first, const key_type& last)
+LockableMap<Map>::eachImpl(Functor& functor, const char* clientId,
+                           const key_type& first, const key_type& last)
 {
     key_type key = first;
     mapped_type val;
-    Decision decision;
-    {
-        std::unique_lock<std::mutex> guard(_lock);
-        if (findNextKey(key, val, clientId, guard) || key > last) return;
-        _lockedKeys.insert(LockId(key, clientId));
-    }
-    try{
-        while (true) {
-            decision = functor(const_cast<const key_type&>(key), val);
+    while (true) {
+        {
             std::unique_lock<std::mutex> guard(_lock);
-            _lockedKeys.erase(LockId(key, clientId));
-            _cond.notify_all();
-            if (handleDecision(key, val, decision)) return;
-            ++key;
-            if (findNextKey(key, val, clientId, guard) || key > last) return;
-            _lockedKeys.insert(LockId(key, clientId));
+            if (findNextKey(key, val, clientId, true, guard)) return;
+        }
+        if (key > last) {
+            unlock(key);
+            return;
         }
-    } catch (...) {
+        Decision decision;
+        try {
+            decision = functor(const_cast<const key_type&>(key), val);
+        } catch (...) {
             // Assuming only the functor call can throw exceptions, we need
             // to unlock the current key before exiting
-        std::lock_guard<std::mutex> guard(_lock);
-        _lockedKeys.erase(LockId(key, clientId));
-        _cond.notify_all();
-        throw;
+            unlock(key);
+            throw;
+        }
+        bool abort;
+        if (decision == UPDATE || decision == REMOVE) {
+            std::lock_guard<std::mutex> guard(_lock);
+            abort = handleDecision(key, val, decision);
+        } else {
+            abort = handleDecision(key, val, decision);
+        }
+        unlock(key);
+        if (abort) return;
+        ++key;
     }
 }
 
+template<typename Map>
+template<typename Functor>
+void
+LockableMap<Map>::each(Functor& functor, const char* clientId,
+                       const key_type& first, const key_type& last)
+{
+    eachImpl(functor, clientId, first, last);
+}
+
 template<typename Map>
 template<typename Functor>
 void
 LockableMap<Map>::each(const Functor& functor, const char* clientId,
                        const key_type& first, const key_type& last)
 {
-    key_type key = first;
-    mapped_type val;
-    Decision decision;
-    {
-        std::unique_lock<std::mutex> guard(_lock);
-        if (findNextKey(key, val, clientId, guard) || key > last) return;
-        _lockedKeys.insert(LockId(key, clientId));
-    }
-    try{
-        while (true) {
-            decision = functor(const_cast<const key_type&>(key), val);
-            std::unique_lock<std::mutex> guard(_lock);
-            _lockedKeys.erase(LockId(key, clientId));
-            _cond.notify_all();
-            if (handleDecision(key, val, decision)) return;
-            ++key;
-            if (findNextKey(key, val, clientId, guard) || key > last) return;
-            _lockedKeys.insert(LockId(key, clientId));
-        }
-    } catch (...) {
-            // Assuming only the functor call can throw exceptions, we need
-            // to unlock the current key before exiting
-        std::lock_guard<std::mutex> guard(_lock);
-        _lockedKeys.erase(LockId(key, clientId));
-        _cond.notify_all();
-        throw;
-    }
+    eachImpl(functor, clientId, first, last);
 }
 
 template<typename Map>
@@ -349,7 +393,7 @@ LockableMap<Map>::all(Functor& functor, const char* clientId,
     mapped_type val;
     std::unique_lock<std::mutex> guard(_lock);
     while (true) {
-        if (findNextKey(key, val, clientId, guard) || key > last) return;
+        if (findNextKey(key, val, clientId, false, guard) || key > last) return;
         Decision d(functor(const_cast<const key_type&>(key), val));
         if (handleDecision(key, val, d)) return;
         ++key;
@@ -366,7 +410,7 @@ LockableMap<Map>::all(const Functor& functor, const char* clientId,
     mapped_type val;
     std::unique_lock<std::mutex> guard(_lock);
     while (true) {
-        if (findNextKey(key, val, clientId, guard) || key > last) return;
+        if (findNextKey(key, val, clientId, false, guard) || key > last) return;
         Decision d(functor(const_cast<const key_type&>(key), val));
         assert(d == ABORT || d == CONTINUE);
         if (handleDecision(key, val, d)) return;
@@ -385,7 +429,7 @@ LockableMap<Map>::processNextChunk(Functor& functor,
     mapped_type val;
     std::unique_lock<std::mutex> guard(_lock);
     for (uint32_t processed = 0; processed < chunkSize; ++processed) {
-        if (findNextKey(key, val, clientId, guard)) {
+        if (findNextKey(key, val, clientId, false, guard)) {
             return false;
         }
         Decision d(functor(const_cast<const key_type&>(key), val));
@@ -432,7 +476,14 @@ LockableMap<Map>::print(std::ostream& out, bool verbose,
         }
 
         out << "\n" << indent << "  Locked keys: ";
-        _lockedKeys.print(out, verbose, indent + "  ");
+        LockIdSet lockedKeys;
+        for (LockStripe &stripe : _stripes) {
+            std::lock_guard<std::mutex> stripeGuard(stripe._lock);
+            for (const LockId &lid : stripe._lockedKeys) {
+                lockedKeys.insert(lid);
+            }
+        }
+        lockedKeys.print(out, verbose, indent + "  ");
     }
     out << "} : ";
 
@@ -462,9 +513,10 @@ template<typename Map>
 void
 LockableMap<Map>::unlock(const key_type& key)
 {
-    std::lock_guard<std::mutex> guard(_lock);
-    _lockedKeys.erase(LockId(key, ""));
-    _cond.notify_all();
+    LockStripe &stripe(getStripe(key));
+    std::lock_guard<std::mutex> stripeGuard(stripe._lock);
+    stripe._lockedKeys.erase(LockId(key, ""));
+    stripe._cond.notify_all();
 }
 
 /**
@@ -552,13 +604,25 @@ LockableMap<Map>::addAndLockResults(
         std::map<BucketId, WrappedEntry>& results,
         std::unique_lock<std::mutex> &guard)
 {
+    std::vector<LockStripe *> stripes;
+    for (BucketId::Type key : keys) {
+        stripes.push_back(&getStripe(key));
+    }
+    // Stripes are locked in address order when holding several
+    std::sort(stripes.begin(), stripes.end());
+    stripes.erase(std::unique(stripes.begin(), stripes.end()), stripes.end());
+
     // Wait until all buckets are free to be added, then add them all.
     while (true) {
+        std::vector<std::unique_lock<std::mutex>> stripeGuards;
+        for (LockStripe *stripe : stripes) {
+            stripeGuards.emplace_back(stripe->_lock);
+        }
         bool allOk = true;
         key_type waitingFor(0);
 
         for (uint32_t i=0; i<keys.size(); i++) {
-            if (_lockedKeys.exist(LockId(keys[i], clientId))) {
+            if (getStripe(keys[i])._lockedKeys.exist(LockId(keys[i], clientId))) {
                 waitingFor = keys[i];
                 allOk = false;
                 break;
@@ -566,14 +630,19 @@ LockableMap<Map>::addAndLockResults(
         }
 
         if (!allOk) {
-            typename LockWaiters::Key waitId(_lockWaiters.insert(LockId(waitingFor, clientId)));
-            _cond.wait(guard);
-            _lockWaiters.erase(waitId);
+            LockStripe &stripe(getStripe(waitingFor));
+            size_t waitIdx = std::find(stripes.begin(), stripes.end(), &stripe) - stripes.begin();
+            std::unique_lock<std::mutex> stripeGuard(std::move(stripeGuards[waitIdx]));
+            stripeGuards.clear();
+            guard.unlock();
+            acquireKey(LockId(waitingFor, clientId), stripe, stripeGuard);
+            stripeGuard.unlock();
+            guard.lock();
         } else {
             for (uint32_t i=0; i<keys.size(); i++) {
                 typename Map::iterator it = _map.find(keys[i]);
                 if (it != _map.end()) {
-                    _lockedKeys.insert(LockId(keys[i], clientId));
+                    getStripe(keys[i])._lockedKeys.insert(LockId(keys[i], clientId));
                     results[BucketId(BucketId::keyToBucketId(keys[i]))]
                           = WrappedEntry(*this, keys[i], it->second,
                                          clientId, true);
@@ -612,11 +681,11 @@ LockableMap<Map>::createAppropriateBucket(
     newBucket.setUsedBits(newBucketBits);
     BucketId::Type key = newBucket.stripUnused().toKey();
 
-    LockId lid(key, clientId);
-    acquireKey(lid, guard);
+    guard.unlock();
+    lockKey(LockId(key, clientId));
+    guard.lock();
     bool preExisted;
     typename Map::iterator it = _map.find(key, true, preExisted);
-    _lockedKeys.insert(LockId(key, clientId));
     return WrappedEntry(*this, key, it->second, clientId, preExisted);
 }
 
@@ -750,23 +819,26 @@ template<typename Map>
 void
 LockableMap<Map>::showLockClients(vespalib::asciistream & out) const
 {
-    std::lock_guard<std::mutex> guard(_lock);
+    vespalib::asciistream waiting;
     out << "Currently grabbed locks:";
-    for (typename LockIdSet::const_iterator it = _lockedKeys.begin();
-         it != _lockedKeys.end(); ++it)
-    {
-        out << "\n  "
-            << BucketId(BucketId::keyToBucketId(it->_key))
-            << " - " << it->_owner;
-    }
-    out << "\nClients waiting for keys:";
-    for (typename LockWaiters::const_iterator it = _lockWaiters.begin();
-         it != _lockWaiters.end(); ++it)
-    {
-        out << "\n  "
-            << BucketId(BucketId::keyToBucketId(it->second._key))
-            << " - " << it->second._owner;
+    for (LockStripe &stripe : _stripes) {
+        std::lock_guard<std::mutex> stripeGuard(stripe._lock);
+        for (typename LockIdSet::const_iterator it = stripe._lockedKeys.begin();
+             it != stripe._lockedKeys.end(); ++it)
+        {
+            out << "\n  "
+                << BucketId(BucketId::keyToBucketId(it->_key))
+                << " - " << it->_owner;
+        }
+        for (typename LockWaiters::const_iterator it = stripe._lockWaiters.begin();
+             it != stripe._lockWaiters.end(); ++it)
+        {
+            waiting << "\n  "
+                    << BucketId(BucketId::keyToBucketId(it->second._key))
+                    << " - " << it->second._owner;
+        }
     }
+    out << "\nClients waiting for keys:" << waiting.str();
 }
 
 }
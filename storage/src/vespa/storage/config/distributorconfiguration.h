@@ -235,6 +235,10 @@ public:
     void setSequenceMutatingOperations(bool sequenceMutations) noexcept {
         _sequenceMutatingOperations = sequenceMutations;
     }
+
+    bool useBTreeDatabase() const noexcept {
+        return _useBTreeDatabase;
+    }
     
 private:
     DistributorConfiguration(const DistributorConfiguration& other);
@@ -274,6 +278,7 @@ private:
     bool _enableHostInfoReporting;
     bool _disableBucketActivation;
     bool _sequenceMutatingOperations;
+    bool _useBTreeDatabase;
 
     DistrConfig::MinimumReplicaCountingMode _minimumReplicaCountingMode;
     
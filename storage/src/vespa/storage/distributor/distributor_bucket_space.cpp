@@ -1,12 +1,27 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "distributor_bucket_space.h"
+#include <vespa/storage/bucketdb/btreebucketdatabase.h>
+#include <vespa/storage/bucketdb/mapbucketdatabase.h>
 
 namespace storage {
 namespace distributor {
 
-DistributorBucketSpace::DistributorBucketSpace()
-    : _bucketDatabase(),
+namespace {
+
+std::unique_ptr<BucketDatabase>
+makeBucketDatabase(bool useBTreeDatabase)
+{
+    if (useBTreeDatabase) {
+        return std::make_unique<BTreeBucketDatabase>();
+    }
+    return std::make_unique<MapBucketDatabase>();
+}
+
+}
+
+DistributorBucketSpace::DistributorBucketSpace(bool useBTreeDatabase)
+    : _bucketDatabase(makeBucketDatabase(useBTreeDatabase)),
       _distribution()
 {
 }
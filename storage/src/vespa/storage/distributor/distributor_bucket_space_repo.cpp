@@ -14,12 +14,12 @@ using document::BucketSpace;
 namespace storage {
 namespace distributor {
 
-DistributorBucketSpaceRepo::DistributorBucketSpaceRepo(bool enableGlobalBucketSpace)
+DistributorBucketSpaceRepo::DistributorBucketSpaceRepo(bool enableGlobalBucketSpace, bool useBTreeDatabase)
     : _map()
 {
-    add(document::FixedBucketSpaces::default_space(), std::make_unique<DistributorBucketSpace>());
+    add(document::FixedBucketSpaces::default_space(), std::make_unique<DistributorBucketSpace>(useBTreeDatabase));
     if (enableGlobalBucketSpace) {
-        add(document::FixedBucketSpaces::global_space(), std::make_unique<DistributorBucketSpace>());
+        add(document::FixedBucketSpaces::global_space(), std::make_unique<DistributorBucketSpace>(useBTreeDatabase));
     }
 }
 
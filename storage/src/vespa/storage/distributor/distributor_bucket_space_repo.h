@@ -21,7 +21,7 @@ private:
     BucketSpaceMap _map;
 
 public:
-    explicit DistributorBucketSpaceRepo(bool enableGlobalBucketSpace);
+    explicit DistributorBucketSpaceRepo(bool enableGlobalBucketSpace, bool useBTreeDatabase = false);
     ~DistributorBucketSpaceRepo();
 
     DistributorBucketSpaceRepo(const DistributorBucketSpaceRepo&&) = delete;
@@ -4,6 +4,10 @@
 #include <vespa/vespalib/util/alloc.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <cstddef>
+#include <cstring>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace vespalib;
 using namespace vespalib::alloc;
@@ -246,4 +250,32 @@ TEST("auto alloced mmap alloc can not be shrinked below HUGEPAGE_SIZE/2 + 1 ") {
     EXPECT_EQUAL(SZ, buf.size());
 }
 
+TEST("file mmap alloc is copy on write and can not be extended") {
+    const char *fileName = "mmap_file_test.dat";
+    std::vector<char> content(3 * 4096);
+    for (size_t i(0); i < content.size(); i++) {
+        content[i] = i % 127;
+    }
+    int fd = open(fileName, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_TRUE(fd >= 0);
+    ASSERT_EQUAL(ssize_t(content.size()), write(fd, &content[0], content.size()));
+    EXPECT_EXCEPTION(Alloc::allocMMapFile(fd, 100, 4096), IllegalArgumentException, "not aligned to page size");
+    {
+        Alloc buf = Alloc::allocMMapFile(fd, 4096, 8192 - 10);
+        EXPECT_EQUAL(8192u - 10, buf.size());
+        char *data = static_cast<char *>(buf.get());
+        EXPECT_EQUAL(0, memcmp(data, &content[4096], buf.size()));
+        data[1] = 100;
+        EXPECT_EQUAL(100, data[1]);
+        EXPECT_FALSE(buf.resize_inplace(3 * 4096));
+        Alloc other = buf.create(100);
+        EXPECT_TRUE(other.get() != nullptr);
+    }
+    char check(0);
+    EXPECT_EQUAL(1, pread(fd, &check, 1, 4096 + 1));
+    EXPECT_EQUAL(content[4096 + 1], check);
+    close(fd);
+    unlink(fileName);
+}
+
 TEST_MAIN() { TEST_RUN_ALL(); }
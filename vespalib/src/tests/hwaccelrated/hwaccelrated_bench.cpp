@@ -0,0 +1,100 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/hwaccelrated/generic.h>
+#include <vespa/vespalib/util/benchmark_timer.h>
+#include <functional>
+#include <vector>
+
+using namespace vespalib;
+using namespace vespalib::hwaccelrated;
+
+//-----------------------------------------------------------------------------
+
+const size_t num_values = 4096;
+
+struct Data {
+    std::vector<uint64_t> bits_a;
+    std::vector<uint64_t> bits_b;
+    std::vector<int8_t>   int8_a;
+    std::vector<int8_t>   int8_b;
+    std::vector<uint16_t> bf16_a;
+    std::vector<uint16_t> bf16_b;
+    std::vector<float>    float_a;
+    std::vector<float>    float_b;
+    std::vector<double>   double_a;
+    std::vector<double>   double_b;
+    std::vector<uint32_t> indexes;
+    Data() : bits_a(num_values), bits_b(num_values), int8_a(num_values), int8_b(num_values),
+             bf16_a(num_values), bf16_b(num_values), float_a(num_values), float_b(num_values),
+             double_a(num_values), double_b(num_values), indexes(num_values)
+    {
+        for (size_t i = 0; i < num_values; ++i) {
+            bits_a[i] = 0x9e3779b97f4a7c15ul * (i + 1);
+            bits_b[i] = 0xc2b2ae3d27d4eb4ful * (i + 7);
+            int8_a[i] = i;
+            int8_b[i] = i * 3;
+            bf16_a[i] = 0x3f80 + (i & 0x7f);
+            bf16_b[i] = 0x3f00 + (i & 0x7f);
+            float_a[i] = double_a[i] = i * 0.5;
+            float_b[i] = double_b[i] = i * 0.25;
+            indexes[i] = (i * 31) % num_values;
+        }
+    }
+};
+
+struct Kernel {
+    const char *name;
+    std::function<double(const IAccelrated &, const Data &)> run;
+};
+
+struct KernelList {
+    std::vector<Kernel> list;
+    KernelList() : list({
+        {"populationCount", [](const IAccelrated &accel, const Data &d)
+         { return accel.populationCount(&d.bits_a[0], num_values); }},
+        {"andPopulationCount", [](const IAccelrated &accel, const Data &d)
+         { return accel.andPopulationCount(&d.bits_a[0], &d.bits_b[0], num_values); }},
+        {"dotProduct(int8)", [](const IAccelrated &accel, const Data &d)
+         { return accel.dotProduct(&d.int8_a[0], &d.int8_b[0], num_values); }},
+        {"dotProductBFloat16", [](const IAccelrated &accel, const Data &d)
+         { return accel.dotProductBFloat16(&d.bf16_a[0], &d.bf16_b[0], num_values); }},
+        {"squaredEuclideanDistance(float)", [](const IAccelrated &accel, const Data &d)
+         { return accel.squaredEuclideanDistance(&d.float_a[0], &d.float_b[0], num_values); }},
+        {"squaredEuclideanDistance(double)", [](const IAccelrated &accel, const Data &d)
+         { return accel.squaredEuclideanDistance(&d.double_a[0], &d.double_b[0], num_values); }},
+        {"sparseDotProduct", [](const IAccelrated &accel, const Data &d)
+         { return accel.sparseDotProduct(&d.indexes[0], &d.float_a[0], num_values, &d.float_b[0]); }}
+    }) {}
+};
+
+double measure(const Kernel &kernel, const IAccelrated &accel, const Data &data) {
+    double sink = 0.0;
+    BenchmarkTimer timer(1.0);
+    while (timer.has_budget()) {
+        timer.before();
+        for (size_t i = 0; i < 1000; ++i) {
+            sink += kernel.run(accel, data);
+        }
+        timer.after();
+    }
+    EXPECT_TRUE(sink != -1.0);
+    return timer.min_time() * 1000.0;
+}
+
+TEST_FF("benchmark selected accelrator against generic implementation", Data(), KernelList()) {
+    GenericAccelrator generic;
+    IAccelrated::UP selected = IAccelrated::getAccelrator();
+    fprintf(stderr, "1000 calls with %zu values each:\n", num_values);
+    for (const Kernel &kernel: f2.list) {
+        double generic_ms = measure(kernel, generic, f1);
+        double selected_ms = measure(kernel, *selected, f1);
+        fprintf(stderr, "  %-34s generic: %8.3f ms, selected: %8.3f ms, speedup: %5.2f\n",
+                kernel.name, generic_ms, selected_ms, generic_ms / selected_ms);
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+TEST_MAIN() { TEST_RUN_ALL(); }
@@ -0,0 +1,113 @@
+// Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/testkit/test_kit.h>
+#include <vespa/vespalib/hwaccelrated/iaccelrated.h>
+#include <vespa/vespalib/hwaccelrated/generic.h>
+#include <vespa/vespalib/hwaccelrated/avx2.h>
+#include <vespa/vespalib/hwaccelrated/avx512.h>
+#include <cstring>
+#include <vector>
+
+using namespace vespalib::hwaccelrated;
+
+struct Accelrators {
+    std::vector<std::pair<const char *, IAccelrated::UP>> list;
+    Accelrators() : list() {
+        list.emplace_back("generic", std::make_unique<GenericAccelrator>());
+        list.emplace_back("selected", IAccelrated::getAccelrator());
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            list.emplace_back("avx2", std::make_unique<Avx2Accelrator>());
+        }
+        if (__builtin_cpu_supports("avx512bw")) {
+            list.emplace_back("avx512", std::make_unique<Avx512Accelrator>());
+        }
+    }
+};
+
+uint16_t toBFloat16(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return (bits >> 16);
+}
+
+// Lengths covering empty input, tails and multiple vector chunks.
+const std::vector<size_t> lengths = { 0, 1, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 127, 128, 1000 };
+
+TEST_F("require that population count matches scalar count", Accelrators()) {
+    std::vector<uint64_t> a(1000);
+    std::vector<uint64_t> b(1000);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = 0x9e3779b97f4a7c15ul * (i + 1);
+        b[i] = 0xc2b2ae3d27d4eb4ful * (i + 7);
+    }
+    for (const auto &accel: f1.list) {
+        for (size_t sz: lengths) {
+            size_t expect = 0;
+            size_t expect_and = 0;
+            for (size_t i = 0; i < sz; ++i) {
+                expect += __builtin_popcountl(a[i]);
+                expect_and += __builtin_popcountl(a[i] & b[i]);
+            }
+            TEST_STATE(accel.first);
+            EXPECT_EQUAL(expect, accel.second->populationCount(&a[0], sz));
+            EXPECT_EQUAL(expect_and, accel.second->andPopulationCount(&a[0], &b[0], sz));
+        }
+    }
+}
+
+TEST_F("require that int8 dot product matches scalar product", Accelrators()) {
+    std::vector<int8_t> a(100000);
+    std::vector<int8_t> b(100000);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = (i % 2 == 0) ? -128 : 127;
+        b[i] = (i % 3 == 0) ? 127 : -128;
+    }
+    for (const auto &accel: f1.list) {
+        for (size_t sz: { size_t(0), size_t(31), size_t(33), size_t(1000), a.size() }) {
+            int64_t expect = 0;
+            for (size_t i = 0; i < sz; ++i) {
+                expect += int64_t(a[i]) * b[i];
+            }
+            TEST_STATE(accel.first);
+            EXPECT_EQUAL(expect, accel.second->dotProduct(&a[0], &b[0], sz));
+        }
+    }
+}
+
+TEST_F("require that float kernels match scalar computation", Accelrators()) {
+    std::vector<float> a(1000);
+    std::vector<float> b(1000);
+    std::vector<double> ad(1000);
+    std::vector<double> bd(1000);
+    std::vector<uint16_t> abf(1000);
+    std::vector<uint16_t> bbf(1000);
+    std::vector<uint32_t> indexes(1000);
+    for (size_t i = 0; i < a.size(); ++i) {
+        // small integers and halves are exact in both float and bfloat16
+        a[i] = ad[i] = float(i % 13) - 6.0;
+        b[i] = bd[i] = float(i % 7) * 0.5;
+        abf[i] = toBFloat16(a[i]);
+        bbf[i] = toBFloat16(b[i]);
+        indexes[i] = (i * 7) % b.size();
+    }
+    for (const auto &accel: f1.list) {
+        for (size_t sz: lengths) {
+            double dot = 0.0;
+            double dist = 0.0;
+            double sparse = 0.0;
+            for (size_t i = 0; i < sz; ++i) {
+                dot += a[i] * b[i];
+                dist += (a[i] - b[i]) * (a[i] - b[i]);
+                sparse += a[i] * b[indexes[i]];
+            }
+            TEST_STATE(accel.first);
+            EXPECT_EQUAL(dot, accel.second->dotProductBFloat16(&abf[0], &bbf[0], sz));
+            EXPECT_EQUAL(dist, accel.second->squaredEuclideanDistance(&a[0], &b[0], sz));
+            EXPECT_EQUAL(dist, accel.second->squaredEuclideanDistance(&ad[0], &bd[0], sz));
+            EXPECT_EQUAL(sparse, accel.second->sparseDotProduct(&indexes[0], &a[0], sz, &b[0]));
+        }
+    }
+}
+
+TEST_MAIN() { TEST_RUN_ALL(); }
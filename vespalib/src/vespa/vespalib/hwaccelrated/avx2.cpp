@@ -2,9 +2,73 @@
 
 #include "avx2.h"
 #include "avxprivate.hpp"
+#include <immintrin.h>
 
 namespace vespalib::hwaccelrated {
 
+namespace {
+
+/**
+ * Counts bits in each byte using a nibble lookup table, then sums the
+ * byte counts into the four 64-bit lanes.
+ */
+inline __m256i
+popCount256(__m256i v)
+{
+    const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                            0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i lowMask = _mm256_set1_epi8(0x0f);
+    __m256i lo = _mm256_and_si256(v, lowMask);
+    __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+    __m256i bytes = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+    return _mm256_sad_epu8(bytes, _mm256_setzero_si256());
+}
+
+inline int64_t
+sum64(__m256i v)
+{
+    return _mm256_extract_epi64(v, 0) + _mm256_extract_epi64(v, 1) +
+           _mm256_extract_epi64(v, 2) + _mm256_extract_epi64(v, 3);
+}
+
+inline float
+sumFloat(__m256 v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s);
+}
+
+template <bool USE_B>
+size_t
+populationCountT(const uint64_t * a, const uint64_t * b, size_t sz)
+{
+    __m256i acc = _mm256_setzero_si256();
+    size_t i(0);
+    for (; i + 4 <= sz; i += 4) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        if (USE_B) {
+            v = _mm256_and_si256(v, _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+        }
+        acc = _mm256_add_epi64(acc, popCount256(v));
+    }
+    size_t count = sum64(acc);
+    for (; i < sz; i++) {
+        count += __builtin_popcountl(USE_B ? (a[i] & b[i]) : a[i]);
+    }
+    return count;
+}
+
+inline __m256
+bfloat16ToFloat(const uint16_t * v)
+{
+    __m256i widened = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(v)));
+    return _mm256_castsi256_ps(_mm256_slli_epi32(widened, 16));
+}
+
+}
+
 float
 Avx2Accelrator::dotProduct(const float * af, const float * bf, size_t sz) const
 {
@@ -17,4 +81,100 @@ Avx2Accelrator::dotProduct(const double * af, const double * bf, size_t sz) cons
     return avx::dotProductSelectAlignment<double, 32>(af, bf, sz);
 }
 
+size_t
+Avx2Accelrator::populationCount(const uint64_t * a, size_t sz) const
+{
+    return populationCountT<false>(a, a, sz);
+}
+
+size_t
+Avx2Accelrator::andPopulationCount(const uint64_t * a, const uint64_t * b, size_t sz) const
+{
+    return populationCountT<true>(a, b, sz);
+}
+
+int64_t
+Avx2Accelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    // Each 32-bit lane gains at most 2^16 per iteration, flush to 64 bits before it can overflow.
+    const size_t FlushInterval(1 << 14);
+    int64_t sum(0);
+    size_t i(0);
+    while (i + 32 <= sz) {
+        __m256i acc = _mm256_setzero_si256();
+        for (size_t n(0); (n < FlushInterval) && (i + 32 <= sz); n++, i += 32) {
+            __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+            __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+            __m256i aLo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(va));
+            __m256i bLo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(vb));
+            __m256i aHi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(va, 1));
+            __m256i bHi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(vb, 1));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(aLo, bLo));
+            acc = _mm256_add_epi32(acc, _mm256_madd_epi16(aHi, bHi));
+        }
+        __m256i lo = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(acc));
+        __m256i hi = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(acc, 1));
+        sum += sum64(_mm256_add_epi64(lo, hi));
+    }
+    for (; i < sz; i++) {
+        sum += static_cast<int64_t>(a[i]) * b[i];
+    }
+    return sum;
+}
+
+float
+Avx2Accelrator::dotProductBFloat16(const uint16_t * a, const uint16_t * b, size_t sz) const
+{
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    size_t i(0);
+    for (; i + 16 <= sz; i += 16) {
+        acc0 = _mm256_fmadd_ps(bfloat16ToFloat(a + i), bfloat16ToFloat(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(bfloat16ToFloat(a + i + 8), bfloat16ToFloat(b + i + 8), acc1);
+    }
+    for (; i + 8 <= sz; i += 8) {
+        acc0 = _mm256_fmadd_ps(bfloat16ToFloat(a + i), bfloat16ToFloat(b + i), acc0);
+    }
+    float sum = sumFloat(_mm256_add_ps(acc0, acc1));
+    for (; i < sz; i++) {
+        uint32_t va = static_cast<uint32_t>(a[i]) << 16;
+        uint32_t vb = static_cast<uint32_t>(b[i]) << 16;
+        float fa, fb;
+        memcpy(&fa, &va, sizeof(fa));
+        memcpy(&fb, &vb, sizeof(fb));
+        sum += fa * fb;
+    }
+    return sum;
+}
+
+float
+Avx2Accelrator::squaredEuclideanDistance(const float * a, const float * b, size_t sz) const
+{
+    return avx::squaredEuclideanDistance<float, 32>(a, b, sz);
+}
+
+double
+Avx2Accelrator::squaredEuclideanDistance(const double * a, const double * b, size_t sz) const
+{
+    return avx::squaredEuclideanDistance<double, 32>(a, b, sz);
+}
+
+float
+Avx2Accelrator::sparseDotProduct(const uint32_t * indexes, const float * values, size_t sz,
+                                 const float * dense) const
+{
+    __m256 acc = _mm256_setzero_ps();
+    size_t i(0);
+    for (; i + 8 <= sz; i += 8) {
+        __m256i idx = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indexes + i));
+        __m256 gathered = _mm256_i32gather_ps(dense, idx, sizeof(float));
+        acc = _mm256_fmadd_ps(_mm256_loadu_ps(values + i), gathered, acc);
+    }
+    float sum = sumFloat(acc);
+    for (; i < sz; i++) {
+        sum += values[i] * dense[indexes[i]];
+    }
+    return sum;
+}
+
 }
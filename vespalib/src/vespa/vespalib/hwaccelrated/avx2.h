@@ -7,13 +7,21 @@
 namespace vespalib::hwaccelrated {
 
 /**
- * Avx-512 implementation.
+ * Avx2 implementation.
  */
 class Avx2Accelrator : public AvxAccelrator
 {
 public:
     float dotProduct(const float * a, const float * b, size_t sz) const override;
     double dotProduct(const double * a, const double * b, size_t sz) const override;
+    size_t populationCount(const uint64_t * a, size_t sz) const override;
+    size_t andPopulationCount(const uint64_t * a, const uint64_t * b, size_t sz) const override;
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const override;
+    float dotProductBFloat16(const uint16_t * a, const uint16_t * b, size_t sz) const override;
+    float squaredEuclideanDistance(const float * a, const float * b, size_t sz) const override;
+    double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const override;
+    float sparseDotProduct(const uint32_t * indexes, const float * values, size_t sz,
+                           const float * dense) const override;
 };
 
 }
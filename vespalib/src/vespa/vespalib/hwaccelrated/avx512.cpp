@@ -2,9 +2,60 @@
 
 #include "avx512.h"
 #include "avxprivate.hpp"
+// Newer gcc versions warn about the deliberately undefined values inside some avx-512 intrinsics
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
 
 namespace vespalib:: hwaccelrated {
 
+namespace {
+
+/**
+ * Counts bits in each byte using a nibble lookup table, then sums the
+ * byte counts into the eight 64-bit lanes.
+ */
+inline __m512i
+popCount512(__m512i v)
+{
+    // bit counts for nibbles 0-15, repeated for each 128-bit lane
+    const __m512i lookup = _mm512_set4_epi32(0x04030302, 0x03020201, 0x03020201, 0x02010100);
+    const __m512i lowMask = _mm512_set1_epi8(0x0f);
+    __m512i lo = _mm512_and_si512(v, lowMask);
+    __m512i hi = _mm512_and_si512(_mm512_srli_epi16(v, 4), lowMask);
+    __m512i bytes = _mm512_add_epi8(_mm512_shuffle_epi8(lookup, lo), _mm512_shuffle_epi8(lookup, hi));
+    return _mm512_sad_epu8(bytes, _mm512_setzero_si512());
+}
+
+template <bool USE_B>
+size_t
+populationCountT(const uint64_t * a, const uint64_t * b, size_t sz)
+{
+    __m512i acc = _mm512_setzero_si512();
+    size_t i(0);
+    for (; i + 8 <= sz; i += 8) {
+        __m512i v = _mm512_loadu_si512(a + i);
+        if (USE_B) {
+            v = _mm512_and_si512(v, _mm512_loadu_si512(b + i));
+        }
+        acc = _mm512_add_epi64(acc, popCount512(v));
+    }
+    size_t count = _mm512_reduce_add_epi64(acc);
+    for (; i < sz; i++) {
+        count += __builtin_popcountl(USE_B ? (a[i] & b[i]) : a[i]);
+    }
+    return count;
+}
+
+inline __m512
+bfloat16ToFloat(const uint16_t * v)
+{
+    __m512i widened = _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(v)));
+    return _mm512_castsi512_ps(_mm512_slli_epi32(widened, 16));
+}
+
+}
+
 float
 Avx512Accelrator::dotProduct(const float * af, const float * bf, size_t sz) const
 {
@@ -17,4 +68,95 @@ Avx512Accelrator::dotProduct(const double * af, const double * bf, size_t sz) co
     return avx::dotProductSelectAlignment<double, 64>(af, bf, sz);
 }
 
+size_t
+Avx512Accelrator::populationCount(const uint64_t * a, size_t sz) const
+{
+    return populationCountT<false>(a, a, sz);
+}
+
+size_t
+Avx512Accelrator::andPopulationCount(const uint64_t * a, const uint64_t * b, size_t sz) const
+{
+    return populationCountT<true>(a, b, sz);
+}
+
+int64_t
+Avx512Accelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    // Each 32-bit lane gains at most 2^15 per iteration, flush to 64 bits before it can overflow.
+    const size_t FlushInterval(1 << 15);
+    int64_t sum(0);
+    size_t i(0);
+    while (i + 32 <= sz) {
+        __m512i acc = _mm512_setzero_si512();
+        for (size_t n(0); (n < FlushInterval) && (i + 32 <= sz); n++, i += 32) {
+            __m512i va = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i)));
+            __m512i vb = _mm512_cvtepi8_epi16(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i)));
+            acc = _mm512_add_epi32(acc, _mm512_madd_epi16(va, vb));
+        }
+        __m512i lo = _mm512_cvtepi32_epi64(_mm512_castsi512_si256(acc));
+        __m512i hi = _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(acc, 1));
+        sum += _mm512_reduce_add_epi64(_mm512_add_epi64(lo, hi));
+    }
+    for (; i < sz; i++) {
+        sum += static_cast<int64_t>(a[i]) * b[i];
+    }
+    return sum;
+}
+
+float
+Avx512Accelrator::dotProductBFloat16(const uint16_t * a, const uint16_t * b, size_t sz) const
+{
+    __m512 acc0 = _mm512_setzero_ps();
+    __m512 acc1 = _mm512_setzero_ps();
+    size_t i(0);
+    for (; i + 32 <= sz; i += 32) {
+        acc0 = _mm512_fmadd_ps(bfloat16ToFloat(a + i), bfloat16ToFloat(b + i), acc0);
+        acc1 = _mm512_fmadd_ps(bfloat16ToFloat(a + i + 16), bfloat16ToFloat(b + i + 16), acc1);
+    }
+    for (; i + 16 <= sz; i += 16) {
+        acc0 = _mm512_fmadd_ps(bfloat16ToFloat(a + i), bfloat16ToFloat(b + i), acc0);
+    }
+    float sum = _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+    for (; i < sz; i++) {
+        uint32_t va = static_cast<uint32_t>(a[i]) << 16;
+        uint32_t vb = static_cast<uint32_t>(b[i]) << 16;
+        float fa, fb;
+        memcpy(&fa, &va, sizeof(fa));
+        memcpy(&fb, &vb, sizeof(fb));
+        sum += fa * fb;
+    }
+    return sum;
+}
+
+float
+Avx512Accelrator::squaredEuclideanDistance(const float * a, const float * b, size_t sz) const
+{
+    return avx::squaredEuclideanDistance<float, 64>(a, b, sz);
+}
+
+double
+Avx512Accelrator::squaredEuclideanDistance(const double * a, const double * b, size_t sz) const
+{
+    return avx::squaredEuclideanDistance<double, 64>(a, b, sz);
+}
+
+float
+Avx512Accelrator::sparseDotProduct(const uint32_t * indexes, const float * values, size_t sz,
+                                   const float * dense) const
+{
+    __m512 acc = _mm512_setzero_ps();
+    size_t i(0);
+    for (; i + 16 <= sz; i += 16) {
+        __m512i idx = _mm512_loadu_si512(indexes + i);
+        __m512 gathered = _mm512_i32gather_ps(idx, dense, sizeof(float));
+        acc = _mm512_fmadd_ps(_mm512_loadu_ps(values + i), gathered, acc);
+    }
+    float sum = _mm512_reduce_add_ps(acc);
+    for (; i < sz; i++) {
+        sum += values[i] * dense[indexes[i]];
+    }
+    return sum;
+}
+
 }
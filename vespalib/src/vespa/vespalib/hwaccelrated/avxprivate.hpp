@@ -65,6 +65,37 @@ T computeDotProduct(const T * af, const T * bf, size_t sz)
 
 }
 
+template <typename T, size_t VLEN, size_t VectorsPerChunk=4>
+VESPA_DLL_LOCAL T squaredEuclideanDistance(const T * af, const T * bf, size_t sz);
+
+template <typename T, size_t VLEN, size_t VectorsPerChunk>
+T squaredEuclideanDistance(const T * af, const T * bf, size_t sz)
+{
+    constexpr const size_t ChunkSize = VLEN*VectorsPerChunk/sizeof(T);
+    typedef T V __attribute__ ((vector_size (VLEN)));
+    typedef T U __attribute__ ((vector_size (VLEN), aligned(1)));
+    V partial[VectorsPerChunk];
+    memset(partial, 0, sizeof(partial));
+    const U * a = reinterpret_cast<const U *>(af);
+    const U * b = reinterpret_cast<const U *>(bf);
+
+    const size_t numChunks(sz/ChunkSize);
+    for (size_t i(0); i < numChunks; i++) {
+        for (size_t j(0); j < VectorsPerChunk; j++) {
+            V d = a[VectorsPerChunk*i+j] - b[VectorsPerChunk*i+j];
+            partial[j] += d * d;
+        }
+    }
+    T sum(0);
+    for (size_t i(numChunks*ChunkSize); i < sz; i++) {
+        T d = af[i] - bf[i];
+        sum += d * d;
+    }
+    partial[0] = sumR<V, VectorsPerChunk>(partial);
+
+    return sum + sumT<T, V>(partial[0]);
+}
+
 template <typename T, size_t VLEN, size_t VectorsPerChunk=4>
 VESPA_DLL_LOCAL T dotProductSelectAlignment(const T * af, const T * bf, size_t sz);
 
@@ -1,6 +1,7 @@
 // Copyright 2017 Yahoo Holdings. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "generic.h"
+#include <cstring>
 
 namespace vespalib::hwaccelrated {
 
@@ -30,6 +31,65 @@ multiplyAdd(const T * a, const T * b, size_t sz)
     return sum;
 }
 
+template <typename ACCUM, typename T, size_t UNROLL>
+ACCUM
+squaredEuclideanDistanceT(const T * a, const T * b, size_t sz)
+{
+    ACCUM partial[UNROLL];
+    for (size_t i(0); i < UNROLL; i++) {
+        partial[i] = 0;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i+= UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            ACCUM d = a[i+j] - b[i+j];
+            partial[j] += d * d;
+        }
+    }
+    for (;i < sz; i++) {
+        ACCUM d = a[i] - b[i];
+        partial[i%UNROLL] += d * d;
+    }
+    ACCUM sum(0);
+    for (size_t j(0); j < UNROLL; j++) {
+        sum += partial[j];
+    }
+    return sum;
+}
+
+template<size_t UNROLL, typename Operation>
+size_t
+populationCountT(Operation operation, const uint64_t * a, const uint64_t * b, size_t sz)
+{
+    size_t partial[UNROLL];
+    for (size_t i(0); i < UNROLL; i++) {
+        partial[i] = 0;
+    }
+    size_t i(0);
+    for (; i + UNROLL <= sz; i += UNROLL) {
+        for (size_t j(0); j < UNROLL; j++) {
+            partial[j] += __builtin_popcountl(operation(a[i + j], b[i + j]));
+        }
+    }
+    size_t count(0);
+    for (; i < sz; i++) {
+        count += __builtin_popcountl(operation(a[i], b[i]));
+    }
+    for (size_t j(0); j < UNROLL; j++) {
+        count += partial[j];
+    }
+    return count;
+}
+
+inline float
+bfloat16ToFloat(uint16_t value)
+{
+    uint32_t bits = static_cast<uint32_t>(value) << 16;
+    float result;
+    memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
 template<size_t UNROLL, typename Operation>
 void
 bitOperation(Operation operation, void * aOrg, const void * bOrg, size_t bytes) {
@@ -99,6 +159,57 @@ GenericAccelrator::andNotBit(void * aOrg, const void * bOrg, size_t bytes) const
     bitOperation<8>([](uint64_t a, uint64_t b) { return a & ~b; }, aOrg, bOrg, bytes);
 }
 
+size_t
+GenericAccelrator::populationCount(const uint64_t * a, size_t sz) const
+{
+    return populationCountT<4>([](uint64_t v, uint64_t) { return v; }, a, a, sz);
+}
+
+size_t
+GenericAccelrator::andPopulationCount(const uint64_t * a, const uint64_t * b, size_t sz) const
+{
+    return populationCountT<4>([](uint64_t va, uint64_t vb) { return va & vb; }, a, b, sz);
+}
+
+int64_t
+GenericAccelrator::dotProduct(const int8_t * a, const int8_t * b, size_t sz) const
+{
+    return multiplyAdd<int64_t, int8_t, 4>(a, b, sz);
+}
+
+float
+GenericAccelrator::dotProductBFloat16(const uint16_t * a, const uint16_t * b, size_t sz) const
+{
+    float partial[4] = { 0.0, 0.0, 0.0, 0.0 };
+    for (size_t i(0); i < sz; i++) {
+        partial[i%4] += bfloat16ToFloat(a[i]) * bfloat16ToFloat(b[i]);
+    }
+    return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
+
+float
+GenericAccelrator::squaredEuclideanDistance(const float * a, const float * b, size_t sz) const
+{
+    return squaredEuclideanDistanceT<float, float, 4>(a, b, sz);
+}
+
+double
+GenericAccelrator::squaredEuclideanDistance(const double * a, const double * b, size_t sz) const
+{
+    return squaredEuclideanDistanceT<double, double, 4>(a, b, sz);
+}
+
+float
+GenericAccelrator::sparseDotProduct(const uint32_t * indexes, const float * values, size_t sz,
+                                    const float * dense) const
+{
+    float partial[4] = { 0.0, 0.0, 0.0, 0.0 };
+    for (size_t i(0); i < sz; i++) {
+        partial[i%4] += values[i] * dense[indexes[i]];
+    }
+    return (partial[0] + partial[1]) + (partial[2] + partial[3]);
+}
+
 void
 GenericAccelrator::notBit(void * aOrg, size_t bytes) const
 {
@@ -20,6 +20,14 @@ public:
     void andBit(void * a, const void * b, size_t bytes) const override;
     void andNotBit(void * a, const void * b, size_t bytes) const override;
     void notBit(void * a, size_t bytes) const override;
+    size_t populationCount(const uint64_t * a, size_t sz) const override;
+    size_t andPopulationCount(const uint64_t * a, const uint64_t * b, size_t sz) const override;
+    int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const override;
+    float dotProductBFloat16(const uint16_t * a, const uint16_t * b, size_t sz) const override;
+    float squaredEuclideanDistance(const float * a, const float * b, size_t sz) const override;
+    double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const override;
+    float sparseDotProduct(const uint32_t * indexes, const float * values, size_t sz,
+                           const float * dense) const override;
 };
 
 }
@@ -6,6 +6,8 @@
 #include "avx.h"
 #include "avx2.h"
 #include "avx512.h"
+#include <cstdio>
+#include <cstdlib>
 
 namespace vespalib::hwaccelrated {
 
@@ -64,6 +66,50 @@ void verifyAccelrator(const IAccelrated & accel)
     delete [] b;
 }
 
+void verifyPopulationCount(const IAccelrated & accel)
+{
+    const size_t testLength(127);
+    uint64_t a[testLength];
+    uint64_t b[testLength];
+    for (size_t i(0); i < testLength; i++) {
+        a[i] = 0x5555555555555555ul >> (i%64);
+        b[i] = 0xffff0000ffff0000ul << (i%32);
+    }
+    for (size_t j(0); j < 0x20; j++) {
+        size_t count(0);
+        size_t andCount(0);
+        for (size_t i(j); i < testLength; i++) {
+            count += __builtin_popcountl(a[i]);
+            andCount += __builtin_popcountl(a[i] & b[i]);
+        }
+        if ((count != accel.populationCount(&a[j], testLength - j)) ||
+            (andCount != accel.andPopulationCount(&a[j], &b[j], testLength - j)))
+        {
+            fprintf(stderr, "Accelrator is not computing population count correctly.\n");
+            abort();
+        }
+    }
+}
+
+void verifyInt8DotProduct(const IAccelrated & accel)
+{
+    const size_t testLength(127);
+    int8_t a[testLength];
+    int8_t b[testLength];
+    for (size_t j(0); j < 0x20; j++) {
+        int64_t sum(0);
+        for (size_t i(j); i < testLength; i++) {
+            a[i] = i;
+            b[i] = -i;
+            sum += static_cast<int64_t>(a[i]) * b[i];
+        }
+        if (sum != accel.dotProduct(&a[j], &b[j], testLength - j)) {
+            fprintf(stderr, "Accelrator is not computing int8 dotproduct correctly.\n");
+            abort();
+        }
+    }
+}
+
 class RuntimeVerificator
 {
 public:
@@ -77,12 +123,16 @@ RuntimeVerificator::RuntimeVerificator()
    verifyAccelrator<double>(generic); 
    verifyAccelrator<int32_t>(generic); 
    verifyAccelrator<int64_t>(generic); 
+   verifyPopulationCount(generic);
+   verifyInt8DotProduct(generic);
 
    IAccelrated::UP thisCpu(IAccelrated::getAccelrator());
    verifyAccelrator<float>(*thisCpu); 
    verifyAccelrator<double>(*thisCpu); 
    verifyAccelrator<int32_t>(*thisCpu); 
    verifyAccelrator<int64_t>(*thisCpu); 
+   verifyPopulationCount(*thisCpu);
+   verifyInt8DotProduct(*thisCpu);
    
 }
 
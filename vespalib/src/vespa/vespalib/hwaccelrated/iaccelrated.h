@@ -24,6 +24,20 @@ public:
     virtual void andBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void andNotBit(void * a, const void * b, size_t bytes) const = 0;
     virtual void notBit(void * a, size_t bytes) const = 0;
+    virtual size_t populationCount(const uint64_t * a, size_t sz) const = 0;
+    // Number of bits set in (a & b), without writing the result anywhere.
+    virtual size_t andPopulationCount(const uint64_t * a, const uint64_t * b, size_t sz) const = 0;
+    virtual int64_t dotProduct(const int8_t * a, const int8_t * b, size_t sz) const = 0;
+    // bfloat16 values are given by their raw bits, i.e. the upper 16 bits of the corresponding float.
+    virtual float dotProductBFloat16(const uint16_t * a, const uint16_t * b, size_t sz) const = 0;
+    virtual float squaredEuclideanDistance(const float * a, const float * b, size_t sz) const = 0;
+    virtual double squaredEuclideanDistance(const double * a, const double * b, size_t sz) const = 0;
+    /**
+     * Dot product between a sparse vector given as (index, value) pairs and a dense vector.
+     * All indexes must be less than 2^31 and within the dense vector.
+     */
+    virtual float sparseDotProduct(const uint32_t * indexes, const float * values, size_t sz,
+                                   const float * dense) const = 0;
 
     static IAccelrated::UP getAccelrator() __attribute__((noinline));
 };
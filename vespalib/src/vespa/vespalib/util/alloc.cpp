@@ -152,6 +152,13 @@ private:
     static size_t shrink_inplace(PtrAndSize current, size_t newSize);
 };
 
+class FileMMapAllocator : public MMapAllocator {
+public:
+    size_t resize_inplace(PtrAndSize, size_t) const override { return 0; }
+    static PtrAndSize salloc(int fd, size_t offset, size_t sz);
+    static MemoryAllocator & getDefault();
+};
+
 class AutoAllocator : public MemoryAllocator {
 public:
     AutoAllocator(size_t mmapLimit, size_t alignment) : _mmapLimit(mmapLimit), _alignment(alignment) { }
@@ -213,6 +220,7 @@ alloc::AlignedHeapAllocator _G_4KalignedHeapAllocator(1024);
 alloc::AlignedHeapAllocator _G_1KalignedHeapAllocator(4096);
 alloc::AlignedHeapAllocator _G_512BalignedHeapAllocator(512);
 alloc::MMapAllocator _G_mmapAllocatorDefault;
+alloc::FileMMapAllocator _G_fileMMapAllocatorDefault;
 
 }
 
@@ -236,6 +244,10 @@ MemoryAllocator & MMapAllocator::getDefault() {
     return _G_mmapAllocatorDefault;
 }
 
+MemoryAllocator & FileMMapAllocator::getDefault() {
+    return _G_fileMMapAllocatorDefault;
+}
+
 MemoryAllocator & AutoAllocator::getDefault() {
     return getAllocator(1 * MemoryAllocator::HUGEPAGE_SIZE, 0);
 }
@@ -341,6 +353,38 @@ MMapAllocator::salloc(size_t sz, void * wantedAddress)
     return PtrAndSize(buf, sz);
 }
 
+MemoryAllocator::PtrAndSize
+FileMMapAllocator::salloc(int fd, size_t offset, size_t sz)
+{
+    if ((offset % _G_pageSize) != 0) {
+        throw IllegalArgumentException(make_string("File offset %zu is not aligned to page size %zu", offset, _G_pageSize));
+    }
+    if (sz == 0) {
+        return PtrAndSize(nullptr, 0);
+    }
+    size_t mmapId = std::atomic_fetch_add(&_G_mmapCount, 1ul);
+    string stackTrace;
+    if (sz >= _G_MMapLogLimit) {
+        stackTrace = getStackTrace(1);
+        LOG(info, "mmap %ld of file size %ld from %s", mmapId, sz, stackTrace.c_str());
+    }
+    void * buf = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, offset);
+    if (buf == MAP_FAILED) {
+        throw IllegalArgumentException(make_string("Failed mmaping fd %d at offset %zu of size %zu errno(%d)", fd, offset, sz, errno));
+    }
+    if (sz >= _G_MMapNoCoreLimit) {
+        if (madvise(buf, sz, MADV_DONTDUMP) != 0) {
+            LOG(warning, "Failed madvise(%p, %ld, MADV_DONTDUMP) = '%s'", buf, sz, FastOS_FileInterface::getLastErrorString().c_str());
+        }
+    }
+    if (sz >= _G_MMapLogLimit) {
+        LockGuard guard(_G_lock);
+        _G_HugeMappings[buf] = MMapInfo(mmapId, sz, stackTrace);
+        LOG(info, "%ld mappings of accumulated size %ld", _G_HugeMappings.size(), sum(_G_HugeMappings));
+    }
+    return PtrAndSize(buf, sz);
+}
+
 size_t
 MMapAllocator::sresize_inplace(PtrAndSize current, size_t newSize) {
     newSize = roundUp2PageSize(newSize);
@@ -465,6 +509,12 @@ Alloc::allocMMap(size_t sz)
     return Alloc(&MMapAllocator::getDefault(), sz);
 }
 
+Alloc
+Alloc::allocMMapFile(int fd, size_t offset, size_t sz)
+{
+    return Alloc(&FileMMapAllocator::getDefault(), FileMMapAllocator::salloc(fd, offset, sz));
+}
+
 Alloc
 Alloc::alloc(size_t sz, size_t mmapLimit, size_t alignment)
 {
@@ -94,6 +94,13 @@ public:
     static Alloc allocAlignedHeap(size_t sz, size_t alignment);
     static Alloc allocHeap(size_t sz=0);
     static Alloc allocMMap(size_t sz=0);
+    /**
+     * Map sz bytes of the open file fd starting at offset, which must be page aligned.
+     * The mapping is private, pages are read from the file on demand and get an
+     * anonymous copy when first written to. The file itself is never modified.
+     * The mapping can not be resized in place, and it stays valid after fd is closed.
+     */
+    static Alloc allocMMapFile(int fd, size_t offset, size_t sz);
     /**
      * Optional alignment is assumed to be <= system page size, since mmap
      * is always used when size is above limit.
@@ -101,6 +108,7 @@ public:
     static Alloc alloc(size_t sz=0, size_t mmapLimit = MemoryAllocator::HUGEPAGE_SIZE, size_t alignment=0);
 private:
     Alloc(const MemoryAllocator * allocator, size_t sz) : _alloc(allocator->alloc(sz)), _allocator(allocator) { }
+    Alloc(const MemoryAllocator * allocator, PtrAndSize alloc) : _alloc(alloc), _allocator(allocator) { }
     void clear() {
         _alloc.first = nullptr;
         _alloc.second = 0;